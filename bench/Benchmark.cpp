@@ -0,0 +1,279 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // A sample should run at least this long to swamp timer overhead
+    const double MIN_SAMPLE_NS = 5e6;
+
+    // Calibration stops doubling iterations here
+    const std::size_t MAX_ITERATIONS = std::size_t(1) << 30;
+
+    const int DEFAULT_SAMPLES = 15;
+
+    struct BenchmarkCase {
+        std::string name;
+        void (*function)(Bench&);
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        std::size_t iterations;
+        std::vector<double> samplesNs;   // Nanoseconds per iteration
+        std::string skipReason;
+    };
+
+    /*
+        Registered benchmarks (filled by static BenchmarkRegistrar objects).
+    */
+    std::vector<BenchmarkCase>& registry() {
+        static std::vector<BenchmarkCase> cases;
+        return cases;
+    }
+
+    /*
+        Run one benchmark body with a given iteration count.
+    */
+    Bench runOnce(const BenchmarkCase& benchmark, std::size_t iterations) {
+        Bench bench(iterations);
+        benchmark.function(bench);
+        return bench;
+    }
+
+    /*
+        Sample statistics (nanoseconds per iteration).
+    */
+    double mean(const std::vector<double>& v) {
+        double sum = 0.0;
+        for (double x : v)
+            sum += x;
+        return v.empty() ? 0.0 : sum / v.size();
+    }
+
+    double median(std::vector<double> v) {
+        if (v.empty())
+            return 0.0;
+        std::sort(v.begin(), v.end());
+        std::size_t mid = v.size() / 2;
+        return v.size() % 2 ? v[mid] : (v[mid - 1] + v[mid]) / 2.0;
+    }
+
+    double stddev(const std::vector<double>& v) {
+        if (v.size() < 2)
+            return 0.0;
+        double m = mean(v);
+        double sum = 0.0;
+        for (double x : v)
+            sum += (x - m) * (x - m);
+        return std::sqrt(sum / (v.size() - 1));
+    }
+
+    /*
+        Escape a string for a JSON string literal.
+    */
+    std::string jsonString(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    /*
+        Write all results as JSON (the format bench/compare.py reads).
+    */
+    bool writeJson(const std::string& path, const std::vector<BenchmarkResult>& results) {
+        std::ofstream out(path);
+        if (!out)
+            return false;
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": " << jsonString(date) << ",\n"
+            << "    \"threads\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"compiler\": " << jsonString(__VERSION__) << "\n"
+            << "  },\n  \"benchmarks\": [";
+
+        bool first = true;
+        for (const BenchmarkResult& r : results) {
+            if (!r.skipReason.empty())
+                continue;
+
+            out << (first ? "\n" : ",\n") << "    {\"name\": " << jsonString(r.name)
+                << ", \"iterations\": " << r.iterations << ", \"samples_ns\": [";
+            for (std::size_t i = 0; i < r.samplesNs.size(); ++i)
+                out << (i ? ", " : "") << r.samplesNs[i];
+            out << "], \"mean_ns\": " << mean(r.samplesNs)
+                << ", \"median_ns\": " << median(r.samplesNs)
+                << ", \"stddev_ns\": " << stddev(r.samplesNs)
+                << ", \"min_ns\": " << *std::min_element(r.samplesNs.begin(), r.samplesNs.end())
+                << "}";
+            first = false;
+        }
+
+        out << "\n  ]\n}\n";
+        return bool(out);
+    }
+
+    void printUsage() {
+        std::cout << "Usage: pong-bench [--filter TEXT] [--samples N] [--json FILE] [--list]\n";
+    }
+}
+
+
+/*
+    Bench members
+
+    Objective:
+        Iteration bookkeeping for one sample of one benchmark.
+*/
+Bench::Bench(std::size_t iterations)
+    : iterations(iterations),
+      remaining(iterations),
+      started(false),
+      elapsedNs(0.0)
+{
+}
+
+void Bench::skip(const std::string& reason) {
+    skipReason = reason;
+    remaining = 0;
+}
+
+std::size_t Bench::getIterations() const {
+    return iterations;
+}
+
+double Bench::getElapsedNs() const {
+    return elapsedNs;
+}
+
+const std::string& Bench::getSkipReason() const {
+    return skipReason;
+}
+
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* name, void (*function)(Bench&)) {
+    registry().push_back({name, function});
+}
+
+
+/*
+    Function: int main(int argc, char** argv)
+
+    Objective:
+        Run every registered benchmark (or those matching --filter) and
+        report per-iteration times.
+
+    Input Parameters:
+        - --filter TEXT: Only run benchmarks whose name contains TEXT.
+        - --samples N:   Timed samples per benchmark (default 15).
+        - --json FILE:   Also write results as JSON.
+        - --list:        Print benchmark names and exit.
+
+    Return Value:
+        - 0 on success, 1 on bad arguments or when the JSON cannot be written.
+
+    Side Effects:
+        - Prints a results table; optionally writes a JSON file.
+
+    Approach:
+        - Calibrate: double the iteration count until one sample takes
+          at least 5 ms.
+        - One untimed warm-up sample, then N timed samples; each sample
+          re-runs setup so state (e.g. particle pools) starts fresh.
+*/
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    int samples = DEFAULT_SAMPLES;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--samples" && i + 1 < argc)
+            samples = std::max(2, std::atoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--list") {
+            for (const BenchmarkCase& benchmark : registry())
+                std::cout << benchmark.name << "\n";
+            return 0;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    std::printf("%-24s %12s %12s %12s %10s\n",
+                "benchmark", "iterations", "median", "mean", "stddev");
+
+    for (const BenchmarkCase& benchmark : registry()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        BenchmarkResult result;
+        result.name = benchmark.name;
+
+        // ---------- Calibration ----------
+        std::size_t iterations = 1;
+        for (;;) {
+            Bench probe = runOnce(benchmark, iterations);
+            if (!probe.getSkipReason().empty()) {
+                result.skipReason = probe.getSkipReason();
+                break;
+            }
+            if (probe.getElapsedNs() >= MIN_SAMPLE_NS || iterations >= MAX_ITERATIONS)
+                break;
+            iterations *= 2;
+        }
+
+        if (!result.skipReason.empty()) {
+            std::printf("%-24s skipped: %s\n", benchmark.name.c_str(), result.skipReason.c_str());
+            results.push_back(result);
+            continue;
+        }
+
+        // ---------- Warm-up + timed samples ----------
+        runOnce(benchmark, iterations);
+
+        result.iterations = iterations;
+        for (int s = 0; s < samples; ++s) {
+            Bench bench = runOnce(benchmark, iterations);
+            result.samplesNs.push_back(bench.getElapsedNs() / iterations);
+        }
+
+        std::printf("%-24s %12zu %9.1f ns %9.1f ns %9.1f%%\n",
+                    benchmark.name.c_str(), iterations,
+                    median(result.samplesNs), mean(result.samplesNs),
+                    100.0 * stddev(result.samplesNs) / mean(result.samplesNs));
+        results.push_back(result);
+    }
+
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, results)) {
+            std::cout << "Failed to write " << jsonPath << "\n";
+            return 1;
+        }
+        std::cout << "Results written to " << jsonPath << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+//////////////////////////////////////////////////////////////
+/// Class: Bench
+/// ---------------------------------------------------------
+/// Objective:
+///     Handed to every benchmark body; times the measured loop.
+///
+/// Description:
+///     A benchmark does its setup, then loops on
+///     keepRunning(). The first call starts the timer and the
+///     call that ends the loop stops it, so only the loop body
+///     is measured:
+///
+///         void benchMatchStep(Bench& bench) {
+///             Match match;                      // not timed
+///             while (bench.keepRunning())
+///                 match.step(1.f / 60.f, idle); // timed
+///         }
+///
+/// Used By:
+///     All benchmarks run by pong-bench.
+//////////////////////////////////////////////////////////////
+class Bench {
+private:
+    std::size_t iterations;      // Loop iterations requested by the runner
+    std::size_t remaining;       // Iterations left in this sample
+    bool started;
+    std::chrono::steady_clock::time_point startTime;
+    double elapsedNs;            // Measured loop time
+    std::string skipReason;      // Set when the benchmark cannot run here
+
+public:
+    explicit Bench(std::size_t iterations);
+
+    //////////////////////////////////////////////////////////////
+    /// Function: keepRunning()
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Loop condition of the measured loop.
+    ///
+    /// Return:
+    ///     bool – true while iterations remain.
+    //////////////////////////////////////////////////////////////
+    bool keepRunning() {
+        if (remaining > 0) {
+            if (!started) {
+                started = true;
+                startTime = std::chrono::steady_clock::now();
+            }
+            --remaining;
+            return true;
+        }
+        elapsedNs = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - startTime).count();
+        return false;
+    }
+
+    //////////////////////////////////////////////////////////////
+    /// Function: skip(const std::string& reason)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Marks the benchmark as unavailable (e.g. no OpenGL)
+    ///     instead of measuring it.
+    //////////////////////////////////////////////////////////////
+    void skip(const std::string& reason);
+
+    std::size_t getIterations() const;
+    double getElapsedNs() const;
+    const std::string& getSkipReason() const;
+};
+
+//////////////////////////////////////////////////////////////
+/// Function: keepAlive(const T& value)
+/// ---------------------------------------------------------
+/// Objective:
+///     Stops the optimizer from discarding a computed value
+///     (and the work that produced it).
+//////////////////////////////////////////////////////////////
+template <typename T>
+inline void keepAlive(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//////////////////////////////////////////////////////////////
+/// Struct: BenchmarkRegistrar
+/// ---------------------------------------------------------
+/// Objective:
+///     Registers a benchmark when a file-scope instance is
+///     constructed:
+///
+///         static BenchmarkRegistrar reg("ball/update", &benchBallUpdate);
+//////////////////////////////////////////////////////////////
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, void (*function)(Bench&));
+};
+
+#endif
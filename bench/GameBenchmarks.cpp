@@ -0,0 +1,737 @@
+#include "Benchmark.h"
+#include "AudioEngine.h"
+#include "BotController.h"
+#include "EntityStore.h"
+#include "Game.h"
+#include "Match.h"
+#include "MatchHistory.h"
+#include "MatchStats.h"
+#include "Metrics.h"
+#include "NeuralController.h"
+#include "Observatory.h"
+#include "PaddleController.h"
+#include "ParticleSystem.h"
+#include "PolicyNetwork.h"
+#include "ScoreReplay.h"
+#include "SearchController.h"
+#include "SdfFont.h"
+#include "SessionFile.h"
+#include "SimState.h"
+#include "Snapshot.h"
+#include "StatsQuery.h"
+#include "VideoExport.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // All simulation benchmarks advance at the game's 60 Hz frame rate
+    const float FRAME_DT = 1.f / 60.f;
+
+    const std::uint64_t BENCH_SEED = 42;
+
+    // Crowded arena: balls spread over the classic field, two paddles
+    // and a grid of obstacles in the middle
+    const std::size_t CROWD_BALLS     = 1000;
+    const std::size_t CROWD_OBSTACLES = 16;
+
+    /*
+        A crowded EntityStore (deterministic layout and velocities).
+    */
+    EntityStore crowdedArena() {
+        EntityStore entities;
+        entities.addBox(BoxKind::PADDLE, 30.f, 250.f, 20.f, 100.f);
+        entities.addBox(BoxKind::PADDLE, 590.f, 250.f, 20.f, 100.f);
+        for (std::size_t i = 0; i < CROWD_OBSTACLES; ++i)
+            entities.addBox(BoxKind::OBSTACLE, 200.f + 60.f * (i % 4), 120.f + 100.f * (i / 4), 30.f, 30.f);
+
+        for (std::size_t i = 0; i < CROWD_BALLS; ++i) {
+            float x = 60.f + float((i * 37) % 520);
+            float y = 10.f + float((i * 53) % 570);
+            entities.addBall(x, y, 20.f, (i % 2 ? 1.f : -1.f) * (300.f + i % 100), 200.f - float(i % 400));
+        }
+        return entities;
+    }
+
+    /*
+        EntityStore::moveBalls(): one ball's movement plus top/bottom
+        wall bounce (the ball of a match).
+    */
+    void benchBallUpdate(Bench& bench) {
+        EntityStore entities;
+        entities.addBall(320.f, 300.f, 20.f, -300.f, 300.f);
+        while (bench.keepRunning())
+            keepAlive(entities.moveBalls(FRAME_DT, 600.f));
+        keepAlive(entities.getBallBounds(0));
+    }
+
+    /*
+        EntityStore::moveBox(): paddle movement plus screen clamping,
+        sweeping the paddle between both edges.
+    */
+    void benchPaddleMove(Bench& bench) {
+        EntityStore entities;
+        entities.addBox(BoxKind::PADDLE, 30.f, 250.f, 20.f, 100.f);
+        unsigned frame = 0;
+        while (bench.keepRunning()) {
+            PaddleAction action = (frame++ / 64) % 2 ? PaddleAction::UP : PaddleAction::DOWN;
+            entities.moveBox(0, action, 300.f, FRAME_DT, 600.f);
+        }
+        keepAlive(entities.getBoxBounds(0));
+    }
+
+    /*
+        One step of a crowded arena: move every ball, then every
+        ball/box contact (1000 balls x 18 boxes).
+    */
+    void benchEntitiesStep(Bench& bench) {
+        EntityStore entities = crowdedArena();
+        keepAlive(entities.getMemoryBytes());
+        while (bench.keepRunning()) {
+            keepAlive(entities.moveBalls(FRAME_DT, 600.f));
+            keepAlive(entities.collideAll());
+        }
+    }
+
+    /*
+        EntityRenderer::draw() of the crowded arena into an offscreen
+        texture: vertex generation for every entity plus one draw call.
+    */
+    void benchEntitiesDraw(Bench& bench) {
+        sf::RenderTexture texture;
+        if (!texture.create(640, 600)) {
+            bench.skip("no OpenGL context for offscreen rendering");
+            return;
+        }
+        EntityStore entities = crowdedArena();
+        EntityRenderer renderer;
+        while (bench.keepRunning())
+            renderer.draw(entities, texture);
+    }
+
+    /*
+        Match::step(): paddles, ball, paddle collisions and scoring
+        (the simulation block of Game::update) with idle paddles.
+    */
+    void benchMatchStep(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        MatchInput idle = {PaddleAction::STAY, PaddleAction::STAY};
+        while (bench.keepRunning()) {
+            if (match.isFinished())
+                match = Match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+            keepAlive(match.step(FRAME_DT, idle));
+        }
+    }
+
+    /*
+        Match::step() with both paddles driven by the default AI.
+    */
+    void benchMatchStepChase(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        std::unique_ptr<PaddleController> left = createController("chase");
+        std::unique_ptr<PaddleController> right = createController("chase");
+        while (bench.keepRunning()) {
+            if (match.isFinished())
+                match = Match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+            MatchInput input;
+            input.left = left->decide(match, Side::LEFT, FRAME_DT);
+            input.right = right->decide(match, Side::RIGHT, FRAME_DT);
+            keepAlive(match.step(FRAME_DT, input));
+        }
+    }
+
+    /*
+        stepSimState(): the copyable rules kernel used by search, as
+        compiled for the classic arena (geometry folded into constants).
+    */
+    void benchSimStep(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        SimState state = captureState(match);
+        const SimState start = state;
+        MatchInput idle = {PaddleAction::STAY, PaddleAction::STAY};
+        while (bench.keepRunning()) {
+            if (stepSimState(state, idle, FRAME_DT) & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED))
+                state = start;
+        }
+        keepAlive(state);
+    }
+
+    /*
+        The same steps through the runtime kernel, which reads the
+        classic arena's geometry from memory (custom arenas).
+    */
+    void benchSimStepRuntime(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        SimState state = captureState(match);
+        const SimState start = state;
+        const Arena arena = CLASSIC_ARENA;
+        MatchInput idle = {PaddleAction::STAY, PaddleAction::STAY};
+        while (bench.keepRunning()) {
+            if (stepSimState(state, idle, FRAME_DT, arena) & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED))
+                state = start;
+        }
+        keepAlive(state);
+    }
+
+    /*
+        SearchController::decide(): one full lookahead search
+        (per-decision time; nodes/s is printed by --tournament).
+    */
+    void benchSearchDecide(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        SearchController search;
+        std::unique_ptr<PaddleController> left = createController("chase");
+        while (bench.keepRunning()) {
+            if (match.isFinished())
+                match = Match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+            MatchInput input;
+            input.left = left->decide(match, Side::LEFT, FRAME_DT);
+            input.right = search.decide(match, Side::RIGHT, FRAME_DT);
+            keepAlive(match.step(FRAME_DT, input));
+        }
+    }
+
+    /*
+        PolicyNetwork::infer() with the best kernel of this CPU on 'batch'
+        decisions per iteration, taken from a chase vs chase rally.
+    */
+    void benchPolicyInfer(Bench& bench, std::size_t batch) {
+        const PolicyModel* model = sharedPolicyModel();
+        if (!model) {
+            bench.skip("no policy weights (run pong --train-policy)");
+            return;
+        }
+
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        std::unique_ptr<PaddleController> chase = createController("chase");
+        std::vector<float> features(batch * POLICY_INPUTS);
+        for (std::size_t b = 0; b < batch; ++b) {
+            if (match.isFinished())
+                match = Match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+            policyFeatures(captureState(match), Side::RIGHT, &features[b * POLICY_INPUTS]);
+            MatchInput input;
+            input.left = chase->decide(match, Side::LEFT, FRAME_DT);
+            input.right = chase->decide(match, Side::RIGHT, FRAME_DT);
+            match.step(FRAME_DT, input);
+        }
+
+        PolicyNetwork network(*model);
+        std::vector<PaddleAction> actions(batch);
+        while (bench.keepRunning())
+            network.infer(features.data(), batch, actions.data());
+        keepAlive(actions[0]);
+    }
+
+    void benchPolicyInfer1(Bench& bench) {
+        benchPolicyInfer(bench, 1);
+    }
+
+    void benchPolicyInfer256(Bench& bench) {
+        benchPolicyInfer(bench, 256);
+    }
+
+    /*
+        Network snapshots of a chase-vs-chase match, each paired with the
+        snapshot 6 ticks earlier (an acknowledged baseline at ~100 ms
+        round trip): 'pairs' holds snapshot, baseline, snapshot, ...
+    */
+    std::vector<Snapshot> snapshotPairs(std::size_t count) {
+        const std::uint32_t AGE = 6;
+        SimMatch match = startSimMatch(BENCH_SEED);
+        SnapshotHistory history;
+        std::vector<Snapshot> pairs;
+        while (pairs.size() < 2 * count) {
+            if (match.finished)
+                match = startSimMatch(BENCH_SEED + pairs.size());
+            MatchInput input;
+            input.left = paddleCenterY(match.state, Side::LEFT, CLASSIC_ARENA) < match.state.ballY + CLASSIC_ARENA.ballSize / 2.f ? PaddleAction::DOWN : PaddleAction::UP;
+            input.right = paddleCenterY(match.state, Side::RIGHT, CLASSIC_ARENA) < match.state.ballY + CLASSIC_ARENA.ballSize / 2.f ? PaddleAction::DOWN : PaddleAction::UP;
+            stepSimMatch(match, input, FRAME_DT);
+
+            Snapshot snapshot = makeSnapshot(match.tick, match.state, input, match.leftScore, match.rightScore, 0,
+                                             match.finished ? GameState::GAME_OVER : GameState::PLAYING);
+            history.store(snapshot);
+            const Snapshot* baseline = history.find(match.tick - AGE);
+            if (baseline) {
+                pairs.push_back(snapshot);
+                pairs.push_back(*baseline);
+            }
+        }
+        return pairs;
+    }
+
+    /*
+        encodeSnapshot() of one delta update (1e9 / ns = snapshots/s).
+    */
+    void benchSnapshotEncode(Bench& bench) {
+        const std::size_t COUNT = 1024;
+        std::vector<Snapshot> pairs = snapshotPairs(COUNT);
+        std::uint8_t buffer[SNAPSHOT_MAX_BYTES];
+        std::size_t index = 0;
+        while (bench.keepRunning()) {
+            keepAlive(encodeSnapshot(pairs[2 * index], &pairs[2 * index + 1], buffer));
+            index = (index + 1) % COUNT;
+        }
+        keepAlive(buffer[0]);
+    }
+
+    /*
+        decodeSnapshot() of one delta update, baseline stored first as a
+        client does.
+    */
+    void benchSnapshotDecode(Bench& bench) {
+        const std::size_t COUNT = 1024;
+        std::vector<Snapshot> pairs = snapshotPairs(COUNT);
+        std::vector<std::uint8_t> encoded(COUNT * SNAPSHOT_MAX_BYTES);
+        std::vector<std::size_t> sizes(COUNT);
+        for (std::size_t i = 0; i < COUNT; ++i)
+            sizes[i] = encodeSnapshot(pairs[2 * i], &pairs[2 * i + 1], &encoded[i * SNAPSHOT_MAX_BYTES]);
+
+        SnapshotHistory history;
+        Snapshot decoded;
+        std::size_t index = 0;
+        while (bench.keepRunning()) {
+            history.store(pairs[2 * index + 1]);
+            keepAlive(decodeSnapshot(&encoded[index * SNAPSHOT_MAX_BYTES], sizes[index], history, decoded));
+            index = (index + 1) % COUNT;
+        }
+        keepAlive(decoded);
+    }
+
+    /*
+        SessionFile::save(): the per-frame session mirror (record, CRC-32
+        and a store into the mapped page) of a match in progress.
+    */
+    void benchSessionSave(Bench& bench) {
+        const char* path = "bench-session.dat";
+        {
+            SessionFile session(path);
+            if (!session.isOpen()) {
+                bench.skip("session file could not be mapped");
+                return;
+            }
+            Match match(GameMode::PLAYER_VS_AI, BENCH_SEED);
+            while (bench.keepRunning())
+                session.save(match);
+        }
+        std::remove(path);
+    }
+
+    /*
+        A minute of recorded AI-vs-AI updates (the time-travel history
+        the game keeps).
+    */
+    std::vector<HistoryFrame> recordedMinute() {
+        std::unique_ptr<PaddleController> left = createController("chase");
+        std::unique_ptr<PaddleController> right = createController("chase");
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+
+        std::vector<HistoryFrame> frames;
+        for (std::size_t i = 0; i < 3600; ++i) {
+            MatchInput input;
+            input.left = left->decide(match, Side::LEFT, FRAME_DT);
+            input.right = right->decide(match, Side::RIGHT, FRAME_DT);
+            match.step(FRAME_DT, input);
+
+            HistoryFrame frame = { captureState(match), match.getProgress(), match.getSeed(),
+                                   GameMode::PLAYER_VS_PLAYER, GameState::PLAYING, FRAME_DT };
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+
+    /*
+        MatchHistory::record(): the per-update cost of the always-on
+        history (pack + XOR delta against the previous frame).
+    */
+    void benchHistoryRecord(Bench& bench) {
+        std::vector<HistoryFrame> frames = recordedMinute();
+        MatchHistory history;
+        std::size_t index = 0;
+        while (bench.keepRunning()) {
+            history.record(frames[index]);
+            index = (index + 1) % frames.size();
+        }
+        keepAlive(history.getEncodedBytes());
+    }
+
+    /*
+        MatchHistory::getFrame(): scrubbing to a frame (keyframe plus up
+        to 59 deltas), over a full minute of history.
+    */
+    void benchHistorySeek(Bench& bench) {
+        std::vector<HistoryFrame> frames = recordedMinute();
+        MatchHistory history;
+        for (const HistoryFrame& frame : frames)
+            history.record(frame);
+
+        HistoryFrame frame;
+        std::size_t index = 0;
+        while (bench.keepRunning()) {
+            history.getFrame(index, frame);
+            index = (index + 37) % history.getFrameCount();
+        }
+        keepAlive(frame.rally.ballX);
+    }
+
+    /*
+        countMetric(): one counter increment in this thread's shard.
+    */
+    void benchMetricsCount(Bench& bench) {
+        while (bench.keepRunning())
+            countMetric(MetricCounter::POINTS);
+        keepAlive(readMetric(MetricCounter::POINTS));
+    }
+
+    /*
+        observeMetric(): a frame-time observation (bucket scan + sum),
+        values cycling over typical 60 Hz frame times.
+    */
+    void benchMetricsObserve(Bench& bench) {
+        const double frames[4] = { 0.0162, 0.0167, 0.0171, 0.0334 };
+        unsigned index = 0;
+        while (bench.keepRunning())
+            observeMetric(MetricHistogram::FRAME_SECONDS, frames[index++ & 3]);
+    }
+
+    /*
+        The stats query's inner loop for "rally by hour": one column of a
+        full segment summed for each of 24 hour keys (rows in time order,
+        so each hour is a run of rows).
+    */
+    void benchStatsScan(Bench& bench) {
+        std::vector<std::uint32_t> keys(STATS_SEGMENT_ROWS), values(STATS_SEGMENT_ROWS);
+        for (std::size_t i = 0; i < STATS_SEGMENT_ROWS; ++i) {
+            keys[i] = static_cast<std::uint32_t>(i * 24 / STATS_SEGMENT_ROWS);
+            values[i] = static_cast<std::uint32_t>(i % 61);
+        }
+        std::uint64_t total = 0, matches = 0;
+        while (bench.keepRunning()) {
+            for (std::uint32_t hour = 0; hour < 24; ++hour)
+                total += sumWhereEqual(keys.data(), values.data(), keys.size(), hour, matches);
+        }
+        keepAlive(total + matches);
+    }
+
+    /*
+        AudioMixer::mix() of one 512-frame device buffer with every voice
+        busy (a sound posted per buffer keeps all 16 playing): the worst
+        case of the audio thread's callback.
+    */
+    void benchAudioMix(Bench& bench) {
+        AudioMixer mixer;
+        std::vector<std::int16_t> out(AudioEngine::BUFFER_FRAMES * AudioMixer::CHANNELS);
+        for (std::size_t i = 0; i < AudioMixer::MAX_VOICES; ++i)
+            mixer.post(SoundEffect::POINT_LOST, 0.f);
+
+        float pan = -1.f;
+        while (bench.keepRunning()) {
+            mixer.post(SoundEffect::POINT_LOST, pan);
+            pan = pan < 1.f ? pan + 0.125f : -1.f;
+            mixer.mix(out.data(), AudioEngine::BUFFER_FRAMES);
+        }
+        keepAlive(out[0]);
+    }
+
+    /*
+        ParticleSystem::emit() + update() of a full 100k-particle burst
+        (the F4 stress test), refilled every frame.
+    */
+    void benchParticlesBurst(Bench& bench) {
+        ParticleSystem particles(100000);
+        while (bench.keepRunning()) {
+            particles.emit(320.f, 300.f, particles.getCapacity(), sf::Color::White, 400.f);
+            particles.update(FRAME_DT);
+        }
+        keepAlive(particles.getAliveCount());
+    }
+
+    /*
+        Game::updateHud(): score/lives string formatting and text layout.
+    */
+    void benchHudUpdate(Bench& bench) {
+        Game game(true);
+        game.startMatch(GameMode::PLAYER_VS_AI);
+        while (bench.keepRunning())
+            game.updateHud();
+    }
+
+    /*
+        SdfText::setString() of the four-line F3 stats overlay: glyph
+        lookup and quad layout (alternating strings, so every call
+        lays out).
+    */
+    void benchTextLayout(Bench& bench) {
+        SdfFont font;
+        if (!font.loadFromFile("assets/font.sdf")) {
+            bench.skip("no font atlas (run make)");
+            return;
+        }
+
+        const std::string strings[2] = {
+            "FPS 60  Frame 16.67 ms\nParticles 1024/4096  Update 12.5 us\n"
+            "Sim 60 ticks/s  x1\nHistory 3600 frames  71.2 KB",
+            "FPS 59  Frame 16.95 ms\nParticles 1031/4096  Update 12.7 us\n"
+            "Sim 60 ticks/s  x1\nHistory 3600 frames  71.3 KB"
+        };
+        SdfText text;
+        text.setFont(font);
+        text.setCharacterSize(14);
+        std::size_t i = 0;
+        while (bench.keepRunning())
+            text.setString(strings[i++ & 1]);
+        keepAlive(text.getLocalBounds().width);
+    }
+
+    /*
+        Game::update(): AI, simulation, effects and HUD for one frame.
+        A finished match is restarted inside the loop (rare: a few
+        restarts per thousand frames).
+    */
+    void benchGameUpdate(Bench& bench) {
+        Game game(true);
+        game.startMatch(GameMode::PLAYER_VS_AI);
+        while (bench.keepRunning()) {
+            if (game.getState() != GameState::PLAYING)
+                game.startMatch(GameMode::PLAYER_VS_AI);
+            game.update(FRAME_DT);
+        }
+    }
+
+    /*
+        Game::advance() of one displayed frame at 64x on the menu: 64
+        attract-mode demo ticks, the soak-test loop without rendering.
+    */
+    void benchAttract64x(Bench& bench) {
+        Game game(true);
+        game.setTimeScale(64.f);
+        while (bench.keepRunning())
+            keepAlive(game.advance(FRAME_DT));
+    }
+
+    /*
+        Game::render() of a match in progress into the offscreen texture.
+    */
+    void benchRenderPlaying(Bench& bench) {
+        Game game(true);
+        if (!game.isRenderable()) {
+            bench.skip("no OpenGL context for offscreen rendering");
+            return;
+        }
+        game.startMatch(GameMode::PLAYER_VS_AI);
+        for (int i = 0; i < 30; ++i)
+            game.update(FRAME_DT);
+        while (bench.keepRunning())
+            game.render();
+    }
+
+    /*
+        Observatory::step() of a full grid: one tick of 256 chase-vs-chase
+        matches (controllers included).
+    */
+    void benchObservatoryStep(Bench& bench) {
+        Observatory observatory(CLASSIC_ARENA, "chase", "chase");
+        observatory.start(OBSERVATORY_MAX_MATCHES, BENCH_SEED);
+        while (bench.keepRunning())
+            keepAlive(observatory.step(FRAME_DT));
+    }
+
+    /*
+        Game::render() of the observatory with 256 matches: the grid is
+        one batch, so this should cost vertices, not draw calls.
+    */
+    void benchRenderObservatory(Bench& bench) {
+        Game game(true);
+        if (!game.isRenderable()) {
+            bench.skip("no OpenGL context for offscreen rendering");
+            return;
+        }
+        game.openObservatory(OBSERVATORY_MAX_MATCHES);
+        for (int i = 0; i < 30; ++i)
+            game.update(FRAME_DT);
+        while (bench.keepRunning())
+            game.render();
+    }
+
+    /*
+        Game::render() of the main menu into the offscreen texture.
+    */
+    void benchRenderMenu(Bench& bench) {
+        Game game(true);
+        if (!game.isRenderable()) {
+            bench.skip("no OpenGL context for offscreen rendering");
+            return;
+        }
+        while (bench.keepRunning())
+            game.render();
+    }
+
+    /*
+        One exported video frame on the CPU: a match's entities, a burst
+        of particles and the score into a 640x600 canvas, then the YUV
+        conversion – the per-frame cost --render-video spreads over
+        its threads.
+    */
+    void benchVideoFrame(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+        ParticleSystem particles(1024);
+        particles.emit(320.f, 300.f, 400, sf::Color::White, 300.f);
+        particles.update(0.25f);
+
+        std::vector<ParticleSprite> sprites;
+        particles.getSprites(sprites);
+
+        SdfFont font;
+        bool text = font.loadFromFile("assets/font.sdf", false);
+        SdfText score;
+        score.setFont(font);
+        score.setCharacterSize(28);
+        score.setPosition(280.f, 20.f);
+        score.setString("3 : 2");
+
+        EntityRenderer entities;
+        SoftwareCanvas canvas(640, 600);
+        std::vector<std::uint8_t> yuv(640 * 600 * 3 / 2);
+        sf::FloatRect frame(0.f, 0.f, 640.f, 600.f);
+
+        while (bench.keepRunning()) {
+            canvas.clear(sf::Color::Black);
+            canvas.setMapping(frame, frame);
+            entities.begin();
+            entities.add(match.getEntities(), sf::Vector2f(0.f, 0.f), 1.f);
+            canvas.fillTriangles(entities.getVertices(), entities.getVertexCount());
+            canvas.fillParticles(sprites.data(), sprites.size());
+            if (text)
+                canvas.drawText(score, font);
+            canvas.toYuv420(yuv.data());
+            keepAlive(yuv[0]);
+        }
+    }
+
+    /*
+        One bot decision end to end: BotController publishes the match
+        into shared memory and polls for the answer, which a bot thread
+        (its own mapping of the link, as another process would have)
+        reads and answers at once. Measures the round trip, not a
+        strategy. On a single core both sides have to yield to each
+        other, so expect scheduler latency rather than cache latency.
+    */
+    void benchBotRoundTrip(Bench& bench) {
+        const char* name = "/pong-bench-bot";
+        std::unique_ptr<BotLink> link(new BotLink(name, BotLinkMode::CREATE));
+        if (!link->isOpen()) {
+            bench.skip("no POSIX shared memory");
+            return;
+        }
+        const BotLink* gameEnd = link.get();
+
+        std::atomic<bool> stop(false);
+        std::thread bot([&]() {
+            BotLink peer(name, BotLinkMode::ATTACH);
+            std::uint64_t seen = 0;
+            unsigned spins = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::uint64_t published = peer.getStatesPublished();
+                BotState state;
+                if (published == seen || !peer.readState(state)) {
+                    spinPause(spins);
+                    continue;
+                }
+                seen = published;
+                spins = 0;
+
+                BotCommand command = {};
+                command.query = state.query;
+                peer.publishCommand(command);
+            }
+        });
+
+        BotController controller(std::move(link), std::chrono::milliseconds(100));
+        Match match(GameMode::PLAYER_VS_PLAYER, BENCH_SEED);
+
+        // The controller waits only for a bot that has answered before
+        keepAlive(controller.decide(match, Side::LEFT, FRAME_DT));
+        unsigned spins = 0;
+        while (gameEnd->getCommandsPublished() == 0)
+            spinPause(spins);
+
+        while (bench.keepRunning())
+            keepAlive(controller.decide(match, Side::LEFT, FRAME_DT));
+
+        stop = true;
+        bot.join();
+    }
+
+    /*
+        Verifying one score submission: a whole recorded AI-mode game
+        (lazy player against chase, 60 Hz frames with +-25% jitter: at
+        exactly 1/60 s these two rally forever) replayed headlessly with
+        its opponent, as the verifier's workers do per file. Per-core
+        throughput of --verify-scores is the inverse of this.
+    */
+    void benchVerifySubmission(Bench& bench) {
+        Match match(GameMode::PLAYER_VS_AI, BENCH_SEED);
+        std::unique_ptr<PaddleController> player = createController("lazy");
+        std::unique_ptr<PaddleController> opponent = createController("chase");
+        player->reset(mixSeed(BENCH_SEED, 2));
+        opponent->reset(mixSeed(BENCH_SEED, 1));
+
+        ScoreRecorder recorder;
+        recorder.start(match, "chase");
+        while (!match.isFinished() && recorder.isValid()) {
+            std::uint64_t noise = mixSeed(BENCH_SEED, 3 + static_cast<std::uint64_t>(match.getTick()));
+            float dt = FRAME_DT * (0.75f + 0.5f * static_cast<float>(noise >> 40) / 16777216.f);
+
+            MatchInput input;
+            input.left = player->decide(match, Side::LEFT, dt);
+            input.right = opponent->decide(match, Side::RIGHT, dt);
+            recorder.record(match, dt, input);
+            match.step(dt, input);
+        }
+
+        ScoreSubmission submission;
+        if (!recorder.finish(match, "bench", 0, submission)) {
+            bench.skip("game longer than a replay");
+            return;
+        }
+
+        std::string error;
+        while (bench.keepRunning())
+            keepAlive(verifySubmission(submission, error));
+    }
+
+    BenchmarkRegistrar ballUpdate("ball/update", &benchBallUpdate);
+    BenchmarkRegistrar paddleMove("paddle/move", &benchPaddleMove);
+    BenchmarkRegistrar entitiesStep("entities/step_1k", &benchEntitiesStep);
+    BenchmarkRegistrar entitiesDraw("entities/draw_1k", &benchEntitiesDraw);
+    BenchmarkRegistrar matchStep("match/step", &benchMatchStep);
+    BenchmarkRegistrar matchStepChase("match/step_chase", &benchMatchStepChase);
+    BenchmarkRegistrar simStep("sim/step", &benchSimStep);
+    BenchmarkRegistrar simStepRuntime("sim/step_runtime", &benchSimStepRuntime);
+    BenchmarkRegistrar searchDecide("search/decide", &benchSearchDecide);
+    BenchmarkRegistrar policyInfer1("policy/infer_batch1", &benchPolicyInfer1);
+    BenchmarkRegistrar policyInfer256("policy/infer_batch256", &benchPolicyInfer256);
+    BenchmarkRegistrar snapshotEncode("snapshot/encode_delta", &benchSnapshotEncode);
+    BenchmarkRegistrar snapshotDecode("snapshot/decode_delta", &benchSnapshotDecode);
+    BenchmarkRegistrar sessionSave("session/save", &benchSessionSave);
+    BenchmarkRegistrar historyRecord("history/record", &benchHistoryRecord);
+    BenchmarkRegistrar historySeek("history/seek", &benchHistorySeek);
+    BenchmarkRegistrar metricsCount("metrics/count", &benchMetricsCount);
+    BenchmarkRegistrar metricsObserve("metrics/observe", &benchMetricsObserve);
+    BenchmarkRegistrar statsScan("stats/scan_segment", &benchStatsScan);
+    BenchmarkRegistrar audioMix("audio/mix_buffer", &benchAudioMix);
+    BenchmarkRegistrar particlesBurst("particles/burst_100k", &benchParticlesBurst);
+    BenchmarkRegistrar hudUpdate("hud/update", &benchHudUpdate);
+    BenchmarkRegistrar textLayout("hud/text_layout", &benchTextLayout);
+    BenchmarkRegistrar gameUpdate("game/update", &benchGameUpdate);
+    BenchmarkRegistrar attract64x("game/attract_64x", &benchAttract64x);
+    BenchmarkRegistrar renderPlaying("game/render_playing", &benchRenderPlaying);
+    BenchmarkRegistrar renderMenu("game/render_menu", &benchRenderMenu);
+    BenchmarkRegistrar observatoryStep("observatory/step_256", &benchObservatoryStep);
+    BenchmarkRegistrar renderObservatory("game/render_observatory_256", &benchRenderObservatory);
+    BenchmarkRegistrar videoFrame("video/raster_frame", &benchVideoFrame);
+    BenchmarkRegistrar botRoundTrip("bot/round_trip", &benchBotRoundTrip);
+    BenchmarkRegistrar scoresVerify("scores/verify_submission", &benchVerifySubmission);
+}
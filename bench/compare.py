@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+compare.py - flag benchmark regressions between two pong-bench JSON files.
+
+Usage:
+    python3 bench/compare.py BASELINE.json CURRENT.json [--alpha 0.01] [--threshold 0.05]
+
+For every benchmark present in both files, the per-iteration samples are
+compared with a two-sided Mann-Whitney U test (normal approximation with
+tie correction). A benchmark is reported as a REGRESSION only when both
+    - the difference is significant (p < alpha), and
+    - the median slowed down by more than the threshold (default 5%),
+so noise alone and tiny-but-real changes do not fail the gate.
+
+Exit status: 0 = no regressions, 1 = at least one regression, 2 = bad input
+(including a missing baseline: baselines are per machine and not committed).
+"""
+
+import json
+import math
+import os
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {b["name"]: b["samples_ns"] for b in data["benchmarks"]}
+
+
+def median(values):
+    s = sorted(values)
+    mid = len(s) // 2
+    return s[mid] if len(s) % 2 else (s[mid - 1] + s[mid]) / 2.0
+
+
+def mann_whitney_p(a, b):
+    """Two-sided p-value of the Mann-Whitney U test (normal approximation)."""
+    n1, n2 = len(a), len(b)
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+
+    # Average ranks over ties; collect tie sizes for the variance correction
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+
+    rank_sum_a = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u = rank_sum_a - n1 * (n1 + 1) / 2.0
+
+    n = n1 + n2
+    mean_u = n1 * n2 / 2.0
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+
+    # Continuity correction
+    z = (abs(u - mean_u) - 0.5) / math.sqrt(var_u)
+    return math.erfc(max(z, 0.0) / math.sqrt(2.0))
+
+
+def main(argv):
+    args = []
+    alpha = 0.01
+    threshold = 0.05
+    i = 1
+    while i < len(argv):
+        if argv[i] == "--alpha" and i + 1 < len(argv):
+            alpha = float(argv[i + 1])
+            i += 2
+        elif argv[i] == "--threshold" and i + 1 < len(argv):
+            threshold = float(argv[i + 1])
+            i += 2
+        else:
+            args.append(argv[i])
+            i += 1
+
+    if len(args) != 2:
+        print(__doc__.strip())
+        return 2
+
+    if not os.path.exists(args[0]):
+        print("compare.py: no baseline at %s; record one on this machine with:\n"
+              "    ./pong-bench --json %s" % (args[0], args[0]))
+        return 2
+
+    try:
+        baseline = load(args[0])
+        current = load(args[1])
+    except (OSError, ValueError, KeyError) as error:
+        print("compare.py: cannot read results: %s" % error)
+        return 2
+
+    regressions = 0
+    print("%-24s %12s %12s %8s %9s  %s" % ("benchmark", "baseline", "current", "change", "p", "verdict"))
+
+    for name in sorted(set(baseline) & set(current)):
+        old, new = baseline[name], current[name]
+        old_median, new_median = median(old), median(new)
+        change = (new_median - old_median) / old_median if old_median > 0 else 0.0
+        p = mann_whitney_p(old, new)
+
+        if p < alpha and change > threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif p < alpha and change < -threshold:
+            verdict = "improved"
+        else:
+            verdict = "ok"
+
+        print("%-24s %9.1f ns %9.1f ns %+7.1f%% %9.2g  %s"
+              % (name, old_median, new_median, 100.0 * change, p, verdict))
+
+    for name in sorted(set(baseline) - set(current)):
+        print("%-24s missing from current results" % name)
+    for name in sorted(set(current) - set(baseline)):
+        print("%-24s new (no baseline)" % name)
+
+    if regressions:
+        print("\n%d regression(s) detected" % regressions)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,148 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <string>
+
+///////////////////////////////////////////////////////////////
+/// Struct: Arena
+/// ----------------------------------------------------------
+/// Objective:
+///     The one description of an arena and its rules: field
+///     size, ball and paddle geometry, paddle speed, serves
+///     and match length. Every size, bounce line and start
+///     position used by the game is derived from it.
+///
+/// Description:
+///     Presets are constexpr objects (ARENA_PRESETS). The
+///     simulation kernels are templates on a preset
+///     (stepSimState<CLASSIC_ARENA>, ...), so each preset is
+///     compiled with its geometry folded into the code; any
+///     other Arena, e.g. one parsed from "800x500" at run
+///     time, goes through the runtime kernels, which read the
+///     same fields from memory.
+///
+///     All positions are top-left corners, in pixels, with y
+///     growing downwards (SFML convention).
+///
+/// Fields:
+///     name            – preset name ("custom" otherwise)
+///     width, height   – playing field
+///     ballSize        – ball bounding box (diameter)
+///     paddleWidth,
+///     paddleHeight    – paddle box
+///     paddleSpeed     – pixels/second
+///     paddleMargin    – gap between a side wall and its paddle
+///     serveMinSpeed,
+///     serveSpeedRange – serve speed range (pixels/second)
+///     serveMinAngle,
+///     serveAngleRange – serve angle above/below horizontal
+///                       (degrees)
+///     startLives      – PLAYER_VS_AI lives
+///     targetScore     – PLAYER_VS_PLAYER: first to this wins
+///////////////////////////////////////////////////////////////
+struct Arena {
+    const char* name;
+    float width;
+    float height;
+    float ballSize;
+    float paddleWidth;
+    float paddleHeight;
+    float paddleSpeed;
+    float paddleMargin;
+    float serveMinSpeed;
+    float serveSpeedRange;
+    float serveMinAngle;
+    float serveAngleRange;
+    int startLives;
+    int targetScore;
+
+    // Highest ball top before the bottom wall bounces it
+    constexpr float ballMaxY() const { return height - ballSize; }
+
+    // Paddle columns and start height (top-left corners)
+    constexpr float leftPaddleX() const { return paddleMargin; }
+    constexpr float rightPaddleX() const { return width - paddleMargin - paddleWidth; }
+    constexpr float paddleStartY() const { return (height - paddleHeight) / 2.f; }
+
+    // Ball top-left at a serve
+    constexpr float serveX() const { return width / 2.f; }
+    constexpr float serveY() const { return height / 2.f; }
+};
+
+///////////////////////////////////////////////////////////////
+/// Constants: arena presets
+/// ----------------------------------------------------------
+/// CLASSIC_ARENA    – the original game (640x600, 3 lives,
+///                    first to 10); network snapshots and the
+///                    neural policy assume it
+/// WIDE_ARENA       – 16:10 field, faster serves: longer
+///                    flights, more time to react
+/// TINY_ARENA       – quarter-size field with everything
+///                    scaled down (small cabinet screens)
+/// TOURNAMENT_ARENA – classic field, shorter and faster
+///                    paddles, faster serves, first to 11
+///
+/// inline: one object program-wide, so stepSimState<A> is
+/// the same specialization in every translation unit.
+///////////////////////////////////////////////////////////////
+inline constexpr Arena CLASSIC_ARENA = {
+    "classic", 640.f, 600.f, 20.f, 20.f, 100.f, 300.f, 30.f,
+    360.f, 120.f, 25.f, 30.f, 3, 10
+};
+
+inline constexpr Arena WIDE_ARENA = {
+    "wide", 960.f, 600.f, 20.f, 20.f, 100.f, 300.f, 40.f,
+    420.f, 140.f, 20.f, 30.f, 3, 10
+};
+
+inline constexpr Arena TINY_ARENA = {
+    "tiny", 320.f, 240.f, 10.f, 10.f, 48.f, 180.f, 15.f,
+    180.f, 60.f, 25.f, 30.f, 3, 5
+};
+
+inline constexpr Arena TOURNAMENT_ARENA = {
+    "tournament", 640.f, 600.f, 20.f, 20.f, 80.f, 360.f, 30.f,
+    420.f, 120.f, 25.f, 30.f, 3, 11
+};
+
+// Every preset, CLASSIC_ARENA first (its index is 0)
+inline constexpr const Arena* ARENA_PRESETS[] = {
+    &CLASSIC_ARENA, &WIDE_ARENA, &TINY_ARENA, &TOURNAMENT_ARENA
+};
+
+inline constexpr std::size_t ARENA_PRESET_COUNT = sizeof(ARENA_PRESETS) / sizeof(ARENA_PRESETS[0]);
+
+///////////////////////////////////////////////////////////////
+/// Function: arenaPresetIndex(const Arena& arena)
+/// ----------------------------------------------------------
+/// Objective:
+///     Index of a preset in ARENA_PRESETS.
+///
+/// Return:
+///     int – index, or -1 if 'arena' is not one of the preset
+///           objects (copies of a preset compare by value)
+///////////////////////////////////////////////////////////////
+int arenaPresetIndex(const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Function: parseArena(const std::string& text,
+///                      Arena& arena, std::string& error)
+/// ----------------------------------------------------------
+/// Objective:
+///     Arena from a command-line value.
+///
+/// Input:
+///     text – a preset name, or WIDTHxHEIGHT for a custom
+///            field with classic paddles, ball and rules
+///
+/// Return:
+///     bool – false (error set) for an unknown name or a field
+///            too small to play on
+///////////////////////////////////////////////////////////////
+bool parseArena(const std::string& text, Arena& arena, std::string& error);
+
+// "classic, wide, tiny, tournament" (usage messages)
+std::string arenaPresetNames();
+
+#endif
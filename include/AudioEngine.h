@@ -0,0 +1,274 @@
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SpscQueue.h"
+
+///////////////////////////////////////////////////////////////
+/// Enum: SoundEffect
+/// ----------------------------------------------------------
+/// Objective:
+///     Sounds the game can play (synthesized at start-up, no
+///     asset files).
+///
+/// Values:
+///     PADDLE_HIT  – ball off a paddle (short square blip)
+///     WALL_BOUNCE – ball off the top/bottom wall (lower blip)
+///     POINT_WON   – left player scores (rising two-note chime)
+///     POINT_LOST  – right player scores (falling sweep)
+///////////////////////////////////////////////////////////////
+enum class SoundEffect : std::uint8_t {
+    PADDLE_HIT,
+    WALL_BOUNCE,
+    POINT_WON,
+    POINT_LOST,
+    COUNT
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: AudioTiming
+/// ----------------------------------------------------------
+/// Objective:
+///     Cost of the mixer's buffers so far.
+///
+/// Fields:
+///     buffers    – buffers mixed
+///     meanMicros – mean time to mix one buffer
+///     maxMicros  – slowest buffer
+///     late       – buffers that took longer than the audio
+///                  they produced (would have glitched live)
+///////////////////////////////////////////////////////////////
+struct AudioTiming {
+    std::uint64_t buffers;
+    double meanMicros;
+    double maxMicros;
+    std::uint64_t late;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: AudioMixer
+/// ----------------------------------------------------------
+/// Objective:
+///     Mixes the game's sound effects into 16-bit stereo
+///     PCM at 44.1 kHz.
+///
+/// Description:
+///     Two threads use a mixer: the game thread post()s
+///     commands, the audio thread mix()es buffers. They share
+///     nothing but a wait-free SPSC command queue and the
+///     timing counters (written by the audio thread only).
+///
+///     Everything mix() touches is allocated in the
+///     constructor – the sample bank, MAX_VOICES voices and a
+///     float accumulator – so a buffer never allocates, locks
+///     or makes a system call; its cost is one pass per
+///     playing voice plus one clamp pass.
+///
+///     When every voice is busy a new sound steals the voice
+///     that has played longest (the least audible one in a
+///     decaying effect). A full command queue drops the
+///     command: a lost blip is better than a stalled frame.
+///
+///     The output depends only on the commands and the buffer
+///     sizes, never on timing, so rendering the same commands
+///     offline twice gives identical samples.
+///
+/// Side Effects:
+///     - Allocates the sample bank and buffers up front
+///       (~100 KB).
+///
+/// Used By:
+///     AudioEngine (live), runAudioCommand (offline WAV),
+///     benchmarks.
+///////////////////////////////////////////////////////////////
+class AudioMixer {
+public:
+    static constexpr unsigned SAMPLE_RATE = 44100;
+    static constexpr unsigned CHANNELS = 2;
+    static constexpr std::size_t MAX_VOICES = 16;
+
+    // Largest buffer mixed in one pass (larger requests are split)
+    static constexpr std::size_t MAX_FRAMES = 1024;
+
+private:
+    struct Command {
+        SoundEffect effect;
+        float pan;                    // -1 = left, 0 = center, 1 = right
+    };
+
+    struct Voice {
+        const float* samples;         // Mono sample bank entry (nullptr = idle)
+        std::size_t length;           // Samples in the entry
+        std::size_t position;         // Next sample to play
+        float leftGain;
+        float rightGain;
+    };
+
+    std::vector<float> bank[static_cast<std::size_t>(SoundEffect::COUNT)];
+    Voice voices[MAX_VOICES];
+    std::vector<float> accumulator;   // MAX_FRAMES interleaved stereo frames
+
+    SpscQueue<Command, 64> commands;
+
+    // Written by the mixing thread only, read by anyone
+    std::atomic<std::uint64_t> bufferCount;
+    std::atomic<std::uint64_t> totalNanos;
+    std::atomic<std::uint64_t> maxNanos;
+    std::atomic<std::uint64_t> lateCount;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: AudioMixer()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Synthesizes the sample bank; every voice idle.
+    ///////////////////////////////////////////////////////////
+    AudioMixer();
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: post(SoundEffect effect, float pan)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Asks the mixer to start a sound (producer thread
+    ///     only – the game thread).
+    ///
+    /// Input:
+    ///     effect – sound to play
+    ///     pan    – stereo position, -1 (left) to 1 (right)
+    ///
+    /// Return:
+    ///     bool – false if the command queue was full
+    ///
+    /// Approach:
+    ///     One push into the SPSC queue; the sound starts at
+    ///     the beginning of the next mixed buffer.
+    ///////////////////////////////////////////////////////////
+    bool post(SoundEffect effect, float pan = 0.f);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: mix(std::int16_t* out, std::size_t frames)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Produces the next 'frames' stereo frames (consumer
+    ///     thread only – the audio thread).
+    ///
+    /// Input:
+    ///     out    – 2 * frames interleaved samples (L, R)
+    ///     frames – frames to produce
+    ///
+    /// Side Effects:
+    ///     - Starts the posted sounds, advances the voices.
+    ///     - Records the buffer's cost in the timing counters.
+    ///////////////////////////////////////////////////////////
+    void mix(std::int16_t* out, std::size_t frames);
+
+
+    // Mixing cost so far (any thread)
+    AudioTiming getTiming() const;
+
+private:
+    void startVoice(const Command& command);
+    void mixSlice(std::int16_t* out, std::size_t frames);
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: AudioEngine
+/// ----------------------------------------------------------
+/// Objective:
+///     Plays an AudioMixer on the sound card.
+///
+/// Description:
+///     An sf::SoundStream whose thread (SFML's streaming
+///     thread, dedicated to this stream) pulls BUFFER_FRAMES
+///     frames at a time from the mixer. Small buffers keep
+///     the delay between a hit and its sound to a few of them
+///     (SFML keeps three queued: about 35 ms).
+///
+///     Until start() the engine is silent and posted sounds
+///     only queue (the queue fills and then drops), so a
+///     headless game can own one without an audio device.
+///
+/// Side Effects:
+///     - Opens the default audio device on start().
+///     - Owns SFML's streaming thread while started (stopped
+///       in the destructor).
+///
+/// Used By:
+///     Game class (hit, wall and score sounds).
+///////////////////////////////////////////////////////////////
+class AudioEngine : private sf::SoundStream {
+public:
+    static constexpr std::size_t BUFFER_FRAMES = 512;
+
+private:
+    AudioMixer mixer;
+    std::vector<std::int16_t> buffer;      // Last chunk handed to SFML
+    bool started;
+
+public:
+    AudioEngine();
+    ~AudioEngine();
+
+    // Start streaming to the audio device
+    void start();
+
+    // The mixer fed to the device (post() from the game thread)
+    AudioMixer& getMixer();
+
+private:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: postMatchSounds(AudioMixer& mixer, unsigned events,
+///                           float ballX, float fieldWidth)
+/// ----------------------------------------------------------
+/// Objective:
+///     Posts the sounds of one Match::step().
+///
+/// Input:
+///     events     – MatchEvent flags returned by the step
+///     ballX      – ball center after the step (pans hits and
+///                  bounces to where they happened)
+///     fieldWidth – arena width
+///
+/// Approach:
+///     WALL_BOUNCE → WALL_BOUNCE, LEFT_HIT/RIGHT_HIT →
+///     PADDLE_HIT, LEFT_SCORED → POINT_WON (panned left),
+///     RIGHT_SCORED → POINT_LOST (panned right).
+///////////////////////////////////////////////////////////////
+void postMatchSounds(AudioMixer& mixer, unsigned events, float ballX, float fieldWidth);
+
+///////////////////////////////////////////////////////////////
+/// Function: runAudioCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the offline renderer:
+///       --render-audio LEFT RIGHT SEED OUT.wav
+///
+/// Description:
+///     Replays an AI match exactly as "--match" does and mixes
+///     its sounds into a WAV file: each 1/60 s step posts the
+///     step's events to a mixer, which then mixes the step's
+///     735 frames. No audio device or thread is involved, so
+///     the file is byte-identical on every run. Prints the
+///     mixing time per buffer against its real-time budget.
+///
+/// Return:
+///     int – process exit code (1 = bad arguments or the file
+///           could not be written)
+///////////////////////////////////////////////////////////////
+int runAudioCommand(int argc, char** argv);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef BOT_CONTROLLER_H
+#define BOT_CONTROLLER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "BotLink.h"
+#include "PaddleController.h"
+
+///////////////////////////////////////////////////////////////
+/// Function: makeBotState(const Match& match, Side side,
+///                        std::uint64_t query)
+/// ----------------------------------------------------------
+/// Objective:
+///     The BotState a bot on 'side' is sent for the match's
+///     current position.
+///////////////////////////////////////////////////////////////
+BotState makeBotState(const Match& match, Side side, std::uint64_t query);
+
+///////////////////////////////////////////////////////////////
+/// Class: BotController
+/// ----------------------------------------------------------
+/// Objective:
+///     A paddle played by an external process through a
+///     BotLink: the game's side of the bot interface.
+///
+/// Description:
+///     decide() publishes the match as a BotState and polls the
+///     command ring for the answer to that very query, for at
+///     most the wait budget. A bot that keeps up is therefore
+///     played in lockstep, one fresh answer per step; the loop
+///     is loads, stores and pause hints, no system calls.
+///
+///     The game never stalls on a bot that is slow or absent:
+///     the wait is bounded, an answer up to STALE_QUERIES old
+///     is still used, and a bot that has not answered for
+///     longer (or never attached) is not waited for at all –
+///     the paddle stays put until it answers again.
+///
+/// Side Effects:
+///     - Owns the link (created by the game).
+///
+/// Used By:
+///     Game (--bot LEFT|RIGHT), benchmarks.
+///////////////////////////////////////////////////////////////
+class BotController : public PaddleController {
+private:
+    std::unique_ptr<BotLink> link;
+    std::chrono::microseconds waitBudget;
+
+    std::uint64_t queries;           // Queries published so far
+    std::uint64_t lastAnswered;      // Newest query answered (0 = none)
+
+    // Statistics for getReport()
+    std::uint64_t onTime;            // Answered within the budget
+    std::uint64_t late;              // An older (not stale) answer used
+    std::uint64_t missed;            // No usable answer: paddle stayed
+    std::uint64_t waitNanos;         // Spent polling for on-time answers
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: BotController(std::unique_ptr<BotLink> link,
+    ///                            std::chrono::microseconds wait)
+    /// ------------------------------------------------------
+    /// Input:
+    ///     link – an open link (BotLinkMode::CREATE)
+    ///     wait – longest poll for an answer per decision
+    ///////////////////////////////////////////////////////////
+    explicit BotController(std::unique_ptr<BotLink> link,
+                           std::chrono::microseconds wait = std::chrono::microseconds(2000));
+
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+
+    // "N on time (mean wait), N late, N missed"
+    std::string getReport() const override;
+};
+
+#endif
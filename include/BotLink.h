@@ -0,0 +1,163 @@
+#ifndef BOT_LINK_H
+#define BOT_LINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SeqlockRing.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: bot link
+/// ----------------------------------------------------------
+/// Objective:
+///     Shared-memory object the game creates for an external
+///     bot (shm_open name), and the depth of its two rings.
+///////////////////////////////////////////////////////////////
+const char* const BOT_LINK_DEFAULT_NAME = "/pong-bot";
+const std::size_t BOT_RING_CAPACITY = 16;
+
+///////////////////////////////////////////////////////////////
+/// Struct: BotState
+/// ----------------------------------------------------------
+/// Objective:
+///     What the game tells the bot before each step of its
+///     paddle (64 bytes, native byte order). Positions are
+///     field coordinates (y down); "paddle" is the bot's own.
+///////////////////////////////////////////////////////////////
+struct BotState {
+    std::uint64_t query;         // Increases by one per decision asked for
+    std::uint32_t tick;          // Match steps so far
+    std::uint32_t side;          // 0 = left paddle, 1 = right paddle
+    float ballX, ballY;          // Ball center
+    float ballVX, ballVY;        // Pixels per second
+    float paddleY;               // Center height of the bot's paddle
+    float opponentY;             // ... and of the other one
+    float arenaWidth, arenaHeight;
+    float paddleHeight;
+    float paddleSpeed;           // Pixels per second while moving
+    std::int32_t score;
+    std::int32_t opponentScore;
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: BotCommand
+/// ----------------------------------------------------------
+/// Objective:
+///     The bot's answer to one BotState (16 bytes).
+///////////////////////////////////////////////////////////////
+struct BotCommand {
+    std::uint64_t query;         // BotState::query answered
+    std::int32_t action;         // PaddleAction: 0 = stay, 1 = up, 2 = down
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(BotState) == 64, "bot state layout is part of the protocol");
+static_assert(sizeof(BotCommand) == 16, "bot command layout is part of the protocol");
+
+///////////////////////////////////////////////////////////////
+/// Enum: BotLinkMode
+/// ----------------------------------------------------------
+/// Objective:
+///     Which end of the link a BotLink is.
+///
+/// Values:
+///     CREATE – the game: creates (or resets) the object and
+///              removes its name when closed
+///     ATTACH – a bot: maps an object the game created
+///////////////////////////////////////////////////////////////
+enum class BotLinkMode {
+    CREATE,
+    ATTACH
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: BotLink
+/// ----------------------------------------------------------
+/// Objective:
+///     Shared-memory channel between the game and a bot in
+///     another process: states one way, commands the other,
+///     with no system call once mapped.
+///
+/// Description:
+///     The object holds a small header (magic, version, record
+///     sizes) and two SeqlockRing's: the game publishes a
+///     BotState per decision into one, the bot publishes
+///     BotCommand's into the other. Each ring has exactly one
+///     writer, so neither side ever waits for the other inside
+///     publish(); a reader that races the writer simply copies
+///     the slot again. Waiting for news is the reader's choice
+///     (spinPause() between polls of getStatesPublished() or
+///     getCommandsPublished()).
+///
+///     The layout is plain fixed-size integers and floats, so
+///     a bot in any language that can map a file and do
+///     atomic 32/64-bit loads and stores can speak it.
+///
+///     POSIX (shm_open) only; elsewhere the link never opens.
+///
+/// Side Effects:
+///     - Creates/maps /dev/shm/<name> (CREATE removes it again
+///       in the destructor).
+///
+/// Used By:
+///     BotController (game side), the example bot
+///     (tools/ExampleBot.cpp), benchmarks.
+///////////////////////////////////////////////////////////////
+class BotLink {
+public:
+    struct Shared;               // Mapped layout (BotLink.cpp)
+
+private:
+    std::string name;
+    BotLinkMode mode;
+    int fd;                      // -1 if not open
+    Shared* shared;              // nullptr if not open
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: BotLink(const std::string& name,
+    ///                      BotLinkMode mode)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Creates or attaches to the shared-memory object
+    ///     (see isOpen() for the outcome; failures are
+    ///     printed).
+    ///
+    /// Input:
+    ///     name – shm_open name, e.g. "/pong-bot"
+    ///     mode – CREATE (game) or ATTACH (bot)
+    ///////////////////////////////////////////////////////////
+    BotLink(const std::string& name, BotLinkMode mode);
+    ~BotLink();
+
+    BotLink(const BotLink&) = delete;
+    BotLink& operator=(const BotLink&) = delete;
+
+    bool isOpen() const;
+
+    // Game side
+    void publishState(const BotState& state);
+    bool readCommand(BotCommand& command) const;         // Newest, false if none yet
+    std::uint64_t getCommandsPublished() const;
+
+    // Bot side
+    void publishCommand(const BotCommand& command);
+    bool readState(BotState& state) const;               // Newest, false if none yet
+    std::uint64_t getStatesPublished() const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: spinPause(unsigned& spins)
+/// ----------------------------------------------------------
+/// Objective:
+///     One step of a polling loop: a CPU pause hint while the
+///     wait is short, yielding the core once it is not (so two
+///     spinning processes on one core still make progress).
+///
+/// Input:
+///     spins – polls so far (start at 0; incremented)
+///////////////////////////////////////////////////////////////
+void spinPause(unsigned& spins);
+
+#endif
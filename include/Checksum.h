@@ -0,0 +1,28 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////
+/// Function: crc32(const void* data, std::size_t size,
+///                 std::uint32_t crc = 0)
+/// ---------------------------------------------------------
+/// Objective:
+///     Computes the standard CRC-32 (IEEE 802.3) of a buffer.
+///
+/// Input:
+///     data – Bytes to checksum
+///     size – Number of bytes
+///     crc  – Previous CRC when checksumming in pieces
+///
+/// Return:
+///     std::uint32_t – CRC-32 of the bytes
+///
+/// Used By:
+///     Detecting torn or corrupted records in files written
+///     by the game (leaderboard journal, saved state).
+//////////////////////////////////////////////////////////////
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+#endif
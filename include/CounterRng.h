@@ -0,0 +1,113 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <array>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////
+/// Namespace: RngStream
+/// ----------------------------------------------------------
+/// Objective:
+///     Independent random streams drawn from one match seed.
+///     Each consumer uses its own stream so adding draws to
+///     one never shifts the numbers seen by another.
+///
+/// Values:
+///     SERVE  – serve angle/speed/direction, indexed by point
+///     SCRIPT – scripted paddle inputs of the golden
+///              regression corpus (GoldenCheck)
+///////////////////////////////////////////////////////////////
+namespace RngStream {
+    const std::uint32_t SERVE  = 1;
+    const std::uint32_t SCRIPT = 2;
+}
+
+///////////////////////////////////////////////////////////////
+/// Class: CounterRng
+/// ----------------------------------------------------------
+/// Objective:
+///     Stateless, counter-based random numbers (Philox4x32-10)
+///     keyed by a match seed.
+///
+/// Description:
+///     A counter-based generator is a keyed hash: the output
+///     for (seed, stream, index) is computed directly, without
+///     any state that advances between calls. The random
+///     numbers used for point N of a match therefore depend
+///     only on the match seed and N:
+///       - any match of a parallel batch can be reproduced on
+///         its own, from its seed alone;
+///       - threads never share or lock generator state;
+///       - draws can be made in any order.
+///
+///     Each call returns a block of four independent 32-bit
+///     words; uniform() converts one of them to [0, 1).
+///
+/// Side Effects:
+///     None (all functions are const).
+///
+/// Used By:
+///     Match (serves), GoldenCheck (scripted inputs).
+///////////////////////////////////////////////////////////////
+class CounterRng {
+public:
+    typedef std::array<std::uint32_t, 4> Block;
+
+private:
+    std::uint32_t key[2];        // Philox key: the 64-bit seed
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: CounterRng(std::uint64_t seed)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Keys the generator with a (match) seed.
+    ///////////////////////////////////////////////////////////
+    explicit CounterRng(std::uint64_t seed);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: block(std::uint32_t stream, std::uint64_t index)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Returns the four random words at a counter position.
+    ///
+    /// Input:
+    ///     stream – RngStream value (consumer)
+    ///     index  – position within the stream (e.g. point)
+    ///
+    /// Return:
+    ///     Block – four uniformly distributed 32-bit words
+    ///
+    /// Approach:
+    ///     10 Philox rounds over the 128-bit counter
+    ///     (index, stream, 0), keyed by the seed.
+    ///////////////////////////////////////////////////////////
+    Block block(std::uint32_t stream, std::uint64_t index) const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: uniform(std::uint32_t word)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Maps one random word to a float in [0, 1).
+    ///////////////////////////////////////////////////////////
+    static float uniform(std::uint32_t word);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: philox4x32(Block counter, std::uint32_t k0,
+    ///                      std::uint32_t k1)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     The raw Philox4x32-10 bijection (Salmon et al.,
+    ///     "Parallel Random Numbers: As Easy as 1, 2, 3").
+    ///
+    /// Return:
+    ///     Block – encrypted counter
+    ///////////////////////////////////////////////////////////
+    static Block philox4x32(Block counter, std::uint32_t k0, std::uint32_t k1);
+};
+
+#endif
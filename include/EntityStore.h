@@ -0,0 +1,270 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameTypes.h"
+
+// Triangles of a drawn ball (sf::CircleShape's default point count)
+const std::size_t BALL_SEGMENTS = 30;
+
+///////////////////////////////////////////////////////////////
+/// Enum: BoxKind
+/// ----------------------------------------------------------
+/// Objective:
+///     What a box entity is.
+///
+/// Values:
+///     PADDLE   – moved by a player or AI; a ball touching it
+///                reverses its horizontal direction
+///     OBSTACLE – fixed; a ball bounces off the side it hits
+///////////////////////////////////////////////////////////////
+enum class BoxKind : std::uint8_t {
+    PADDLE,
+    OBSTACLE
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: EntityStore
+/// ----------------------------------------------------------
+/// Objective:
+///     Simulation state of every ball, paddle and obstacle of
+///     an arena, with the systems that move and collide them.
+///
+/// Description:
+///     Entities are rows of two Structure-of-Arrays tables,
+///     addressed by their index in the table:
+///       - balls: top-left corner, velocity and size
+///         (20 bytes per ball)
+///       - boxes: top-left corner, extents and kind – paddles
+///         and obstacles (17 bytes per box)
+///     Nothing here is drawable: EntityRenderer turns the
+///     tables into vertices when a frame is drawn. A store is
+///     plain data, so copying a Match copies a few vectors of
+///     floats and no SFML objects.
+///
+///     The systems step whole tables at once: balls move and
+///     bounce off the top/bottom walls (moveBalls), paddles
+///     move while inside the field (moveBox), and a ball
+///     overlapping a paddle reverses its X velocity, one
+///     overlapping an obstacle bounces off its nearest side
+///     (collide, collideAll). Match does not use them: it
+///     steps its one ball and two paddles with the SimState
+///     kernel (stepSimState), where the match rules live.
+///
+/// Side Effects:
+///     - Allocates as entities are added (never while stepping).
+///
+/// Used By:
+///     Match (storage of one ball, two paddles),
+///     EntityRenderer, benchmarks (arenas with thousands of
+///     entities).
+///////////////////////////////////////////////////////////////
+class EntityStore {
+private:
+
+    //////////////////////////////////////////////////////////
+    // Balls (Structure of Arrays)
+    //////////////////////////////////////////////////////////
+    std::vector<float> ballX;        // Top-left X
+    std::vector<float> ballY;        // Top-left Y
+    std::vector<float> ballVX;       // X velocity (pixels/second)
+    std::vector<float> ballVY;       // Y velocity (pixels/second)
+    std::vector<float> ballSize;     // Diameter (bounding box side)
+
+    //////////////////////////////////////////////////////////
+    // Boxes: paddles and obstacles (Structure of Arrays)
+    //////////////////////////////////////////////////////////
+    std::vector<float> boxX;         // Top-left X
+    std::vector<float> boxY;         // Top-left Y
+    std::vector<float> boxWidth;
+    std::vector<float> boxHeight;
+    std::vector<BoxKind> boxKind;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Functions: addBall / addBox
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Append an entity.
+    ///
+    /// Input:
+    ///     x, y          – top-left corner
+    ///     size          – ball diameter
+    ///     vx, vy        – ball velocity (pixels/second)
+    ///     width, height – box extents
+    ///
+    /// Return:
+    ///     std::size_t – index of the new ball / box
+    ///////////////////////////////////////////////////////////
+    std::size_t addBall(float x, float y, float size, float vx, float vy);
+    std::size_t addBox(BoxKind kind, float x, float y, float width, float height);
+
+    // Remove every entity (capacity is kept)
+    void clear();
+
+    std::size_t getBallCount() const;
+    std::size_t getBoxCount() const;
+
+    // Simulation memory in use (bytes of component data)
+    std::size_t getMemoryBytes() const;
+
+
+    ///////////////////////////////////////////////////////////
+    // Component access
+    ///////////////////////////////////////////////////////////
+    sf::FloatRect getBallBounds(std::size_t ball) const;
+    sf::Vector2f getBallVelocity(std::size_t ball) const;
+    sf::FloatRect getBoxBounds(std::size_t box) const;
+    BoxKind getBoxKind(std::size_t box) const;
+
+    // Teleport a ball with a new velocity (serve, restore)
+    void placeBall(std::size_t ball, float x, float y, float vx, float vy);
+
+    // Move a box's top-left corner (restore)
+    void placeBox(std::size_t box, float x, float y);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: moveBalls(float dt, float floor)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Moves every ball by its velocity and bounces the
+    ///     ones touching the top wall or the floor.
+    ///
+    /// Input:
+    ///     dt    – time step in seconds
+    ///     floor – field height (bottom wall)
+    ///
+    /// Return:
+    ///     std::size_t – number of balls that bounced
+    ///////////////////////////////////////////////////////////
+    std::size_t moveBalls(float dt, float floor);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: moveBox(std::size_t box, PaddleAction action,
+    ///                   float speed, float dt, float floor)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Moves a paddle up or down by speed * dt.
+    ///
+    /// Approach:
+    ///     As the original paddle: it only starts a move while
+    ///     its top is below the top wall (UP) or its bottom
+    ///     above the floor (DOWN).
+    ///////////////////////////////////////////////////////////
+    void moveBox(std::size_t box, PaddleAction action, float speed, float dt, float floor);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: collide(std::size_t ball, std::size_t box)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Bounces a ball off a box it overlaps.
+    ///
+    /// Return:
+    ///     bool – true if they overlapped (strict overlap of
+    ///            the boxes, as sf::FloatRect::intersects)
+    ///
+    /// Approach:
+    ///     Paddle: reverse X velocity. Obstacle: reverse the
+    ///     velocity along the axis of least overlap, if the
+    ///     ball is moving into the obstacle on that axis.
+    ///////////////////////////////////////////////////////////
+    bool collide(std::size_t ball, std::size_t box);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: collideAll()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     collide() for every ball against every box, in
+    ///     table order.
+    ///
+    /// Return:
+    ///     std::size_t – number of ball/box contacts
+    ///////////////////////////////////////////////////////////
+    std::size_t collideAll();
+
+private:
+    void bounce(std::size_t ball, std::size_t box);
+
+    friend class EntityRenderer;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: EntityRenderer
+/// ----------------------------------------------------------
+/// Objective:
+///     Draws the entities of a store: the only place where
+///     simulation data becomes SFML geometry.
+///
+/// Description:
+///     Every frame the tables are written into one vertex
+///     buffer (two triangles per box, a 30-segment fan per
+///     ball, as sf::CircleShape draws it) and submitted in a
+///     single draw call. The buffer keeps its capacity, so
+///     steady-state frames do not allocate.
+///
+///     Several stores can share that draw call: begin(), then
+///     add() each one with its own placement (and addRect()
+///     for backgrounds), then submit(). Vertices are placed on
+///     the CPU as they are written, so the cost of a batch is
+///     its vertex count, not the number of stores in it.
+///
+/// Used By:
+///     Game class (render of a match), Observatory (a grid of
+///     miniature matches in one batch).
+///////////////////////////////////////////////////////////////
+class EntityRenderer {
+private:
+    std::vector<sf::Vector2f> circle;  // Unit circle, one point per segment
+    std::vector<sf::Vertex> vertices;  // Rebuilt every draw()
+
+public:
+    EntityRenderer();
+
+    ///////////////////////////////////////////////////////////
+    /// Function: draw(const EntityStore& entities,
+    ///                sf::RenderTarget& target)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Draws every ball and box of 'entities'.
+    ///////////////////////////////////////////////////////////
+    void draw(const EntityStore& entities, sf::RenderTarget& target);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: add(const EntityStore& entities,
+    ///               sf::Vector2f offset, float scale,
+    ///               std::size_t ballSegments)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Appends the geometry of 'entities' to the batch,
+    ///     every point mapped to offset + point * scale.
+    ///
+    /// Input:
+    ///     ballSegments – triangles per ball; a divisor of
+    ///                    BALL_SEGMENTS (miniatures use fewer)
+    ///////////////////////////////////////////////////////////
+    void add(const EntityStore& entities, sf::Vector2f offset, float scale,
+             std::size_t ballSegments = BALL_SEGMENTS);
+
+    // Appends a filled rectangle (backgrounds, markers) to the batch
+    void addRect(const sf::FloatRect& rect, sf::Color color);
+
+    // Empties the batch (capacity is kept)
+    void begin();
+
+    // Draws the batch in one call
+    void submit(sf::RenderTarget& target);
+
+    std::size_t getVertexCount() const;   // Of the current batch
+    const sf::Vertex* getVertices() const; // The batch (CPU renderers)
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+/// Class: FrameArena
+/// ----------------------------------------------------------
+/// Objective:
+///     Memory for the short-lived allocations of one frame
+///     (HUD and message strings, scratch lists), handed out
+///     as a std::pmr::memory_resource:
+///
+///         std::pmr::string text(&frameArena);
+///         text += "Score: ";
+///
+/// Description:
+///     A bump allocator over one buffer allocated in the
+///     constructor: allocating moves a pointer, freeing is a
+///     no-op except for the most recent allocation, which is
+///     rolled back (so a string built and dropped inside one
+///     function leaves the arena as it found it). reset(),
+///     called once at the end of every frame, releases
+///     everything at once.
+///
+///     A frame that needs more than the buffer gets overflow
+///     blocks from the upstream resource; reset() frees them
+///     and grows the buffer to the frame's peak, so only the
+///     first such frame allocates.
+///
+///     Debug builds (NDEBUG not defined) overwrite released
+///     memory with 0xCD, so a pointer kept past its frame
+///     reads obvious garbage instead of stale text.
+///
+/// Side Effects:
+///     - Allocates 'capacity' bytes up front.
+///
+/// Used By:
+///     Game class (reset at the end of every run() iteration).
+///////////////////////////////////////////////////////////////
+class FrameArena : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::vector<unsigned char> buffer;
+    std::size_t used;                     // Bytes of 'buffer' handed out
+    void* overflow;                       // Upstream blocks (linked), freed by reset()
+    std::size_t overflowBytes;            // Bytes in 'overflow' this frame
+    std::size_t peakBytes;                // Most bytes used by one frame
+    std::uint64_t overflowFrames;         // Frames that needed upstream memory
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: FrameArena(std::size_t capacity,
+    ///                         std::pmr::memory_resource* upstream)
+    /// ------------------------------------------------------
+    /// Input:
+    ///     capacity – initial buffer size in bytes
+    ///     upstream – source of the buffer and overflow blocks
+    ///////////////////////////////////////////////////////////
+    explicit FrameArena(std::size_t capacity,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: reset()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Ends the frame: everything allocated since the last
+    ///     reset is released (and poisoned in debug builds).
+    ///////////////////////////////////////////////////////////
+    void reset();
+
+    std::size_t getUsedBytes() const;         // This frame so far
+    std::size_t getCapacity() const;
+    std::size_t getPeakBytes() const;
+    std::uint64_t getOverflowFrames() const;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: getThreadAllocationCount()
+/// ----------------------------------------------------------
+/// Objective:
+///     Heap allocations made so far by the calling thread.
+///
+/// Description:
+///     The program's global operator new (every form) is
+///     replaced by a counting wrapper around malloc, so the
+///     difference between two calls is the number of heap
+///     allocations in between – the evidence that a frame
+///     allocates nothing. Counting is per thread (one
+///     thread-local increment per allocation); the audio,
+///     metrics and leaderboard threads do not disturb the
+///     game thread's count.
+///
+/// Used By:
+///     Game (F3 overlay), runAllocationCommand.
+///////////////////////////////////////////////////////////////
+std::uint64_t getThreadAllocationCount();
+
+///////////////////////////////////////////////////////////////
+/// Function: runAllocationCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the allocation check:
+///       --alloc-check [--frames N]
+///
+/// Description:
+///     Runs a headless Game through the menu (attract demo)
+///     and AI-mode matches, N frames each after a warm-up,
+///     counting the heap allocations of every frame. Frames
+///     that change the game state (a match starting or
+///     ending, a new demo) are reported separately; every
+///     other frame must allocate nothing.
+///
+/// Return:
+///     int – process exit code (0 = steady-state frames
+///           allocated nothing, 1 = they did or bad arguments)
+///////////////////////////////////////////////////////////////
+int runAllocationCommand(int argc, char** argv);
+
+#endif
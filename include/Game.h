@@ -2,41 +2,36 @@
 #define GAME_H
 
 #include <SFML/Graphics.hpp>
+#include "AudioEngine.h"
+#include "FrameArena.h"
+#include "GameTypes.h"
 #include "Menu.h"
-#include "Paddle.h"
-#include "Ball.h"
+#include "MatchHistory.h"
+#include "Match.h"
+#include "Observatory.h"
+#include "PaddleController.h"
+#include "ParticleSystem.h"
+#include "SdfFont.h"
+#include "Leaderboard.h"
+#include "MatchStats.h"
+#include "ScoreReplay.h"
+#include "SessionFile.h"
 
 ///////////////////////////////////////////////////////////////
-/// Enum: GameState
+/// Functions: gameWindowSize(const Arena& arena),
+///            gameUiRect(sf::Vector2u size)
 /// ----------------------------------------------------------
 /// Objective:
-///     Represents the different screens/stages of the game.
+///     Layout of the game window: its size for an arena (the
+///     arena scaled up until the 640x600 UI fits; the field
+///     view covers all of it) and where the UI lands in it,
+///     in pixels (letterboxed).
 ///
-/// Values:
-///     MENU       – Main menu interface
-///     PLAYING    – Actual gameplay running
-///     GAME_OVER  – End screen after game finishes
-///////////////////////////////////////////////////////////////
-enum class GameState {
-    MENU,
-    PLAYING,
-    GAME_OVER
-};
-
-///////////////////////////////////////////////////////////////
-/// Enum: GameMode
-/// ----------------------------------------------------------
-/// Objective:
-///     Defines which type of game is being played.
-///
-/// Values:
-///     PLAYER_VS_AI      – Player vs computer
-///     PLAYER_VS_PLAYER  – Two human players using keyboard
+/// Used By:
+///     Game, the video exporter (same frames without a window).
 ///////////////////////////////////////////////////////////////
-enum class GameMode {
-    PLAYER_VS_AI,
-    PLAYER_VS_PLAYER
-};
+sf::Vector2u gameWindowSize(const Arena& arena);
+sf::FloatRect gameUiRect(sf::Vector2u size);
 
 ///////////////////////////////////////////////////////////////
 /// Class: Game
@@ -49,40 +44,102 @@ enum class GameMode {
 ///
 /// Side Effects:
 ///     - Creates a graphical window.
-///     - Loads files from the system (font, highscore).
+///     - Loads files from the system (font, leaderboard).
 ///     - Updates global game state.
-///     - Writes to a text file for high score.
+///     - Records finished games in the leaderboard journal
+///       (written by a background thread).
+///     - Writes finished AI-mode games with their replays into
+///       submissions/ for the score verifier (--verify-scores).
+///     - Mirrors the match in progress into a memory-mapped
+///       session file and resumes it after a restart.
+///     - Records frame/update times and match events in the
+///       metrics registry (see Metrics.h).
+///     - Plays hit, wall and score sounds on an audio thread
+///       (see AudioEngine.h).
+///     - Records every update of the last minute for rewinding
+///       (F6 time travel, see MatchHistory.h).
+///     - Plays an AI-vs-AI demo behind the menu.
+///     - Runs and draws a grid of AI-vs-AI matches in the
+///       observatory (O on the menu, --observatory).
 ///
 /// Used By:
 ///     main() to start the game loop.
 ///////////////////////////////////////////////////////////////
 class Game {
 private:
-    sf::RenderWindow window;     // Main game window
+    bool headless;               // No window: render offscreen, no keyboard
+    sf::RenderWindow window;     // Main game window (unused when headless)
+    sf::RenderTexture offscreen; // Render target when headless
+    sf::RenderTarget* target;    // Where render() draws
+    bool targetReady;            // Window/offscreen texture was created
     GameState state;             // Current state of the game
     GameMode mode;               // Selected game mode (AI or PVP)
+    Arena arena;                 // Field and rules of every match
+    sf::View fieldView;          // Arena coordinates (matches, particles)
+    sf::View uiView;             // 640x600 UI coordinates, letterboxed
 
+    SdfFont font;                // UI font: one SDF atlas for all text
     Menu menu;                   // Menu UI object
-    Paddle leftPaddle;           // Player 1 paddle
-    Paddle rightPaddle;          // AI or Player 2 paddle
-    Ball ball;                   // Ball object controlling gameplay
-    
-    int leftScore;               // Player 1 score
-    int rightScore;              // Player 2 / AI score
+    Match match;                 // Paddles, ball, scores and lives
+    EntityRenderer entityRenderer; // Draws the match's entities
+    std::unique_ptr<PaddleController> aiController; // Right paddle in AI mode (reproducible)
+    std::string aiName;          // Its registered name (recorded in score submissions)
+    std::unique_ptr<PaddleController> botController; // External bot (--bot), nullptr if none
+    Side botSide;                // Paddle the bot plays instead of keys or AI
+
     int highScore;               // Highest score achieved in AI mode
-    int lives;                   // Lives remaining (only in AI mode)
+    Leaderboard leaderboard;     // Persistent top-N results per mode
+    SessionFile session;         // Match in progress, mirrored for resume
+    MatchStatsRecorder statsRecorder; // Statistics of the match being played
+    MatchStatsStore statsStore;  // Every finished match's statistics (on disk)
+    std::string playerName;      // Name recorded for AI-mode results
+    ScoreRecorder scoreRecorder; // Replay of the AI-mode game being played
+    SubmissionOutbox outbox;     // Writes finished games' replays for verification
     
-    sf::Font font;               // Loaded game font
-    sf::Text scoreText;          // Score display text
+    SdfText scoreText;           // Score display text
+
+    SdfText gameOverText;            // “Game Over” message
+    SdfText gameOverHighScoreText;   // High-score text for AI mode
+    SdfText continueText;            // “Press Enter to continue”
+
+    ParticleSystem particles;        // Hit/score impact effects
+    AudioEngine audio;               // Hit/score sounds (silent when headless)
 
-    sf::Text gameOverText;           // “Game Over” message
-    sf::Text gameOverHighScoreText;  // High-score text for AI mode
-    sf::Text continueText;           // “Press Enter to continue”
+    bool showStats;                  // Stats overlay toggled with F3
+    SdfText statsText;               // Stats overlay (FPS, particle pool)
+    float statsTimer;                // Time since stats text refresh
+    int statsFrames;                 // Frames counted since refresh
+
+    int rallyHits;                   // Paddle hits since the last serve (metrics)
+
+    MatchHistory history;            // Last minute of updates (time travel)
+    bool timeTravel;                 // F6: paused on a recorded frame
+    std::size_t historyCursor;       // Frame shown while time travelling
+    bool rewritten;                  // Time travel changed this match's past (not ranked)
+    SdfText historyText;             // Time-travel banner and keys
+
+    Match demo;                      // Attract mode: AI vs AI behind the menu
+    std::unique_ptr<PaddleController> demoLeft;
+    std::unique_ptr<PaddleController> demoRight;
+    std::uint64_t demoSeed;          // Seed of the demo match
+    sf::RectangleShape menuShade;    // Dims the demo under the menu
+
+    Observatory observatory;         // Grid of AI-vs-AI matches (OBSERVATORY state)
+    SdfText observatoryText;         // Controllers and win tallies
+
+    float timeScale;                 // F7/F8: simulated seconds per real second
+    float tickBacklog;               // Scaled time not yet simulated
+    long statsTicks;                 // Ticks since the stats refresh
+    SdfText timeScaleText;           // "x64" while the scale is not 1
+
+    FrameArena frameArena;           // This frame's temporary strings (reset by runFrame)
+    std::uint64_t statsAllocations;  // Heap allocation count at the stats refresh
     
 public:
 
     ///////////////////////////////////////////////////////////
-    /// Constructor: Game()
+    /// Constructor: Game(bool headless, const std::string& aiName,
+    ///                  const Arena& arena)
     /// ------------------------------------------------------
     /// Objective:
     ///     Initializes game objects, loads fonts,
@@ -90,21 +147,33 @@ public:
     ///     and loads previous high score.
     ///
     /// Input:
-    ///     None
+    ///     headless – true to render into an offscreen texture
+    ///                instead of opening a window (benchmarks);
+    ///                human paddles then receive no input
+    ///     aiName   – registered controller driving the AI
+    ///                paddle ("chase" = original AI, "search"
+    ///                = hard); must exist in the registry
+    ///     arena    – field and rules; the window is the arena
+    ///                scaled up to at least 640x600
     ///
     /// Return:
     ///     No return value (constructor)
     ///
     /// Side Effects:
-    ///     - Creates a window.
-    ///     - Loads font from file system.
-    ///     - Reads highscore.txt.
+    ///     - Creates a window (or an offscreen texture).
+    ///     - Loads the font atlas from the file system.
+    ///     - Reads the leaderboard journal.
+    ///     - Maps the session file and resumes an interrupted
+    ///       match (not when headless).
+    ///     - Starts the audio stream (not when headless).
     ///
     /// Approach:
-    ///     Initialize SFML window → configure paddles →
-    ///     center ball → set initial game state → load assets.
+    ///     Initialize SFML window → create match + AI
+    ///     controller → set initial game state → load assets
+    ///     → resume a saved session.
     ///////////////////////////////////////////////////////////
-    Game();
+    explicit Game(bool headless = false, const std::string& aiName = "chase",
+                  const Arena& arena = CLASSIC_ARENA);
 
 
     ///////////////////////////////////////////////////////////
@@ -130,30 +199,128 @@ public:
     ///////////////////////////////////////////////////////////
     void run();
 
-private:
 
     ///////////////////////////////////////////////////////////
-    /// Function: processEvents()
+    /// Function: runFrame(float frameSeconds)
     /// ------------------------------------------------------
     /// Objective:
-    ///     Handles all input events such as keyboard presses,
-    ///     mouse clicks, and window closing.
+    ///     Everything one run() iteration does after polling
+    ///     events: advance(), the stats overlay, render() and
+    ///     the end of the frame's temporary memory.
     ///
     /// Input:
-    ///     None
+    ///     frameSeconds – real time since the previous frame
+    ///
+    /// Side Effects:
+    ///     Updates and draws the game; resets frameArena, so
+    ///     nothing allocated from it may outlive the call.
+    ///////////////////////////////////////////////////////////
+    void runFrame(float frameSeconds);
+
+
+    //////////////////////////////////////////////////////////
+    // Frame steps below are public so benchmarks can drive a
+    // headless Game frame by frame.
+    //////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////
+    /// Function: startMatch(GameMode newMode)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Starts a fresh match in the selected mode.
+    ///
+    /// Input:
+    ///     newMode – mode chosen in the menu
     ///
     /// Return:
     ///     void
     ///
     /// Side Effects:
-    ///     - Changes game state based on menu selection.
-    ///     - Moves paddles based on keyboard.
-    ///     - Can close the game window.
+    ///     Replaces the match, resets AI and effects, and
+    ///     switches to PLAYING.
     ///
     /// Approach:
-    ///     Poll SFML events → check type → act accordingly.
+    ///     match = Match(mode, seed) → reset AI → HUD text.
     ///////////////////////////////////////////////////////////
-    void processEvents();
+    void startMatch(GameMode newMode);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: openObservatory(std::size_t count,
+    ///                           const std::string& left,
+    ///                           const std::string& right)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Shows 'count' AI-vs-AI matches at once (16..256),
+    ///     as a dashboard for tuning controllers and a render
+    ///     stress test. Escape returns to the menu.
+    ///
+    /// Input:
+    ///     count       – matches in the grid
+    ///     left, right – controllers of every left / right
+    ///                   paddle; empty keeps the previous ones
+    ///                   (at first the game's AI on both sides)
+    ///
+    /// Side Effects:
+    ///     Starts new matches and switches to OBSERVATORY.
+    ///////////////////////////////////////////////////////////
+    void openObservatory(std::size_t count, const std::string& left = "",
+                         const std::string& right = "");
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: attachBot(Side side,
+    ///                     std::unique_ptr<PaddleController> bot)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Hands one paddle to a controller for every match
+    ///     from now on – an external bot (BotController) in
+    ///     place of that side's keys, or of the AI on the
+    ///     right in AI mode.
+    ///////////////////////////////////////////////////////////
+    void attachBot(Side side, std::unique_ptr<PaddleController> bot);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: advance(float frameSeconds)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Runs the simulation for one displayed frame. Above
+    ///     1x: as many fixed 1/60 s update() ticks as the time
+    ///     scale asks for, and only the last tick's state is
+    ///     ever rendered. At 1x and below: one update() of the
+    ///     scaled frame time (the original loop at 1x).
+    ///
+    /// Input:
+    ///     frameSeconds – real time since the previous frame
+    ///
+    /// Return:
+    ///     int – ticks run (0 when the scaled time has not yet
+    ///           reached a tick)
+    ///
+    /// Side Effects:
+    ///     Calls update() repeatedly; keeps the leftover time.
+    ///
+    /// Approach:
+    ///     backlog += frameSeconds * timeScale → one update per
+    ///     whole tick, at most MAX_TICKS_PER_FRAME (the rest is
+    ///     dropped, so a slow machine runs slower instead of
+    ///     falling further behind).
+    ///////////////////////////////////////////////////////////
+    int advance(float frameSeconds);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: setTimeScale(float scale)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Sets the simulation speed (developer control).
+    ///
+    /// Input:
+    ///     scale – simulated seconds per real second, clamped
+    ///             to 0.25 .. 64
+    ///////////////////////////////////////////////////////////
+    void setTimeScale(float scale);
 
 
     ///////////////////////////////////////////////////////////
@@ -173,20 +340,46 @@ private:
     ///     - Moves paddles and ball.
     ///     - Modifies scores & lives.
     ///     - Triggers GAME_OVER state.
+    ///     - Appends the resulting state to the history.
+    ///     - On the menu: steps the attract-mode demo instead.
+    ///     - In the observatory: steps its matches instead.
     ///
     /// Approach:
-    ///     Paddle movement → AI logic → ball update →
-    ///     collision detection → scoring → UI update.
+    ///     Keyboard / AI controller → Match::step() →
+    ///     effects and sounds for reported events → UI update
+    ///     → history record.
     ///////////////////////////////////////////////////////////
     void update(float dt);
 
 
+    ///////////////////////////////////////////////////////////
+    /// Function: updateHud()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Refreshes the in-game score/lives text.
+    ///
+    /// Input:
+    ///     None
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     Rebuilds scoreText.
+    ///
+    /// Approach:
+    ///     AI mode → "Score / Lives"; PvP → "left : right".
+    ///////////////////////////////////////////////////////////
+    void updateHud();
+
+
     ///////////////////////////////////////////////////////////
     /// Function: render()
     /// ------------------------------------------------------
     /// Objective:
-    ///     Draws game objects onto the window depending
-    ///     on the current state (menu, game, game over).
+    ///     Draws game objects onto the window (or the
+    ///     offscreen texture) depending on the current state
+    ///     (menu, game, game over).
     ///
     /// Input:
     ///     None
@@ -203,11 +396,46 @@ private:
     void render();
 
 
+    ///////////////////////////////////////////////////////////
+    // Read-only accessors
+    ///////////////////////////////////////////////////////////
+    GameState getState() const;
+    std::uint64_t getDemoSeed() const;  // Changes when a new attract demo starts
+    bool isRenderable() const;       // Window or offscreen target available
+
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: processEvents()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Handles all input events such as keyboard presses,
+    ///     mouse clicks, and window closing.
+    ///
+    /// Input:
+    ///     None
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     - Changes game state based on menu selection.
+    ///     - Moves paddles based on keyboard.
+    ///     - Can close the game window.
+    ///
+    /// Approach:
+    ///     Poll SFML events → check type → act accordingly.
+    ///////////////////////////////////////////////////////////
+    void processEvents();
+
+
     ///////////////////////////////////////////////////////////
     /// Function: loadHighScore()
     /// ------------------------------------------------------
     /// Objective:
-    ///     Reads the high score from "highscore.txt".
+    ///     Takes the AI-mode high score from the leaderboard,
+    ///     importing a legacy "highscore.txt" the first time.
     ///
     /// Input:
     ///     None
@@ -216,55 +444,181 @@ private:
     ///     void
     ///
     /// Side Effects:
-    ///     Reads from disk.
+    ///     May read highscore.txt and submit it once.
     ///
     /// Approach:
-    ///     Open file → read integer → store in highScore.
+    ///     Empty AI table + legacy file → submit its value →
+    ///     highScore = leaderboard best.
     ///////////////////////////////////////////////////////////
     void loadHighScore();
 
 
     ///////////////////////////////////////////////////////////
-    /// Function: saveHighScore()
+    /// Function: submitResult()
     /// ------------------------------------------------------
     /// Objective:
-    ///     Saves the highest score obtained in AI mode.
+    ///     Records the finished game in the leaderboard and
+    ///     updates the high score shown on screen.
     ///
     /// Input:
     ///     None
     ///
     /// Return:
-    ///     void
+    ///     int – leaderboard rank of the result (0 = unranked)
     ///
     /// Side Effects:
-    ///     Writes to disk (highscore.txt).
+    ///     Queues a journal write (never blocks on disk).
     ///
     /// Approach:
-    ///     Open file → write integer → close file.
+    ///     AI mode → player's score; PvP → winner's margin.
     ///////////////////////////////////////////////////////////
-    void saveHighScore();
+    int submitResult();
 
 
     ///////////////////////////////////////////////////////////
-    /// Function: resetRound()
+    /// Function: resumeSession()
     /// ------------------------------------------------------
     /// Objective:
-    ///     Resets the ball to the center and alternates
-    ///     the direction after each point/life loss.
+    ///     Continues the match that was in progress when the
+    ///     game last stopped (crash, power cut or quit).
     ///
     /// Input:
     ///     None
     ///
     /// Return:
+    ///     bool – true if a match was resumed (only a match
+    ///            saved in the same preset arena is)
+    ///
+    /// Side Effects:
+    ///     Replaces the match and switches to PLAYING.
+    ///
+    /// Approach:
+    ///     SessionFile::load() → Match(mode, seed, arena) →
+    ///     Match::restore() → reset AI as startMatch() does.
+    ///////////////////////////////////////////////////////////
+    bool resumeSession();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: updateDemo(float dt)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Steps the attract-mode match shown behind the menu.
+    ///
+    /// Input:
+    ///     dt – tick length
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     Advances the demo; starts a new one (next seed) when
+    ///     it ends or after DEMO_TICKS.
+    ///
+    /// Approach:
+    ///     Both paddles by the game's AI controller type
+    ///     (chase by default), as Tournament::playMatch() does.
+    ///     The demo touches no score, metric, session or
+    ///     history.
+    ///////////////////////////////////////////////////////////
+    void updateDemo(float dt);
+
+    // New demo match with the next seed
+    void restartDemo();
+
+    // Rebuilds the observatory's controller/tally line
+    void updateObservatoryText();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: handleTimeTravelKey(sf::Keyboard::Key key,
+    ///                               bool shift)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Debug time travel: F6 pauses on the newest recorded
+    ///     frame; Left/Right scrub one update (Shift: one
+    ///     second); Period single-steps update() from the
+    ///     frame shown; F6 again resumes play from there.
+    ///
+    /// Input:
+    ///     key   – key pressed
+    ///     shift – a Shift key is held
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     Replaces the match state with recorded frames;
+    ///     stepping or resuming drops the frames after the one
+    ///     shown (play continues from it).
+    ///
+    /// Approach:
+    ///     Move the cursor → showHistoryFrame(); step =
+    ///     truncateHistory() → update(frame dt).
+    ///////////////////////////////////////////////////////////
+    void handleTimeTravelKey(sf::Keyboard::Key key, bool shift);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: truncateHistory()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Drops the frames after the one shown, so play
+    ///     continues from it.
+    ///
+    /// Side Effects:
+    ///     If frames were dropped, the match being played is
+    ///     marked rewritten: its result is kept out of the
+    ///     leaderboard and the statistics, its score replay is
+    ///     cancelled and it is no longer saved for resume.
+    ///////////////////////////////////////////////////////////
+    void truncateHistory();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: showHistoryFrame(std::size_t index)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Puts the game into a recorded frame.
+    ///
+    /// Input:
+    ///     index – frame of the history
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     Rebuilds the match if the frame belongs to another
+    ///     one, restores it, sets mode/state, HUD and banner.
+    ///
+    /// Approach:
+    ///     MatchHistory::getFrame() → Match(mode, seed, arena)
+    ///     if needed → Match::restore(). The AI controller
+    ///     keeps its own state (as after resumeSession()).
+    ///////////////////////////////////////////////////////////
+    void showHistoryFrame(std::size_t index);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: updateStats(float dt)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Refreshes the stats overlay (FPS, particle pool
+    ///     size and per-frame particle cost).
+    ///
+    /// Input:
+    ///     dt – Time elapsed since last frame
+    ///
+    /// Return:
     ///     void
     ///
     /// Side Effects:
-    ///     Resets ball physics.
+    ///     Rebuilds statsText a few times per second.
     ///
     /// Approach:
-    ///     Ball.reset(centerX, centerY).
+    ///     Accumulate frames → every 0.25 s format the text.
     ///////////////////////////////////////////////////////////
-    void resetRound();
+    void updateStats(float dt);
 };
 
 #endif
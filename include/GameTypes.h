@@ -0,0 +1,71 @@
+#ifndef GAME_TYPES_H
+#define GAME_TYPES_H
+
+///////////////////////////////////////////////////////////////
+/// Enum: GameState
+/// ----------------------------------------------------------
+/// Objective:
+///     Represents the different screens/stages of the game.
+///
+/// Values:
+///     MENU       – Main menu interface
+///     PLAYING    – Actual gameplay running
+///     GAME_OVER  – End screen after game finishes
+///     OBSERVATORY – Grid of AI-vs-AI matches (see Observatory.h)
+///////////////////////////////////////////////////////////////
+enum class GameState {
+    MENU,
+    PLAYING,
+    GAME_OVER,
+    OBSERVATORY
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: GameMode
+/// ----------------------------------------------------------
+/// Objective:
+///     Defines which type of game is being played.
+///
+/// Values:
+///     PLAYER_VS_AI      – Player vs computer
+///     PLAYER_VS_PLAYER  – Two human players using keyboard
+///////////////////////////////////////////////////////////////
+enum class GameMode {
+    PLAYER_VS_AI,
+    PLAYER_VS_PLAYER
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: Side
+/// ----------------------------------------------------------
+/// Objective:
+///     Identifies one of the two paddles.
+///
+/// Values:
+///     LEFT   – Player 1 paddle
+///     RIGHT  – Player 2 / AI paddle
+///////////////////////////////////////////////////////////////
+enum class Side {
+    LEFT,
+    RIGHT
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: PaddleAction
+/// ----------------------------------------------------------
+/// Objective:
+///     What a paddle does during one simulation step, whether
+///     decided by keyboard input or by an AI controller.
+///
+/// Values:
+///     STAY  – Paddle does not move
+///     UP    – Paddle moves up
+///     DOWN  – Paddle moves down
+///////////////////////////////////////////////////////////////
+enum class PaddleAction {
+    STAY,
+    UP,
+    DOWN
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef GOLDEN_CHECK_H
+#define GOLDEN_CHECK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////
+/// Struct: GoldenOutcome
+/// ----------------------------------------------------------
+/// Objective:
+///     What one corpus match must reproduce exactly (stored
+///     as-is, 12 bytes, in the golden file).
+///
+/// Fields:
+///     digest     – CRC-32 chained over the rally state
+///                  (SimState) after every tick
+///     ticks      – steps until the match ended (or the limit)
+///     hits       – paddle hits (rally length, summed)
+///     leftScore,
+///     rightScore – final score
+///     lives      – lives left (AI-mode matches)
+///////////////////////////////////////////////////////////////
+struct GoldenOutcome {
+    std::uint32_t digest;
+    std::uint16_t ticks;
+    std::uint16_t hits;
+    std::uint8_t leftScore;
+    std::uint8_t rightScore;
+    std::uint8_t lives;
+    std::uint8_t reserved;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: describeGoldenMatch(std::size_t index)
+/// ----------------------------------------------------------
+/// Objective:
+///     Human-readable setup of corpus match 'index', e.g.
+///     "predict vs script, wide arena, PvP, seed 0x…".
+///////////////////////////////////////////////////////////////
+std::string describeGoldenMatch(std::size_t index);
+
+///////////////////////////////////////////////////////////////
+/// Function: playGoldenMatch(std::size_t index, bool trace,
+///                           long* kernelDivergence)
+/// ----------------------------------------------------------
+/// Objective:
+///     Plays corpus match 'index' and returns its outcome.
+///
+/// Description:
+///     The corpus is a pure function of the index: the seed
+///     is mixSeed(GOLDEN_SEED, index), and the seed picks the
+///     arena preset, the rules (PvP or AI mode) and what
+///     drives each paddle – a registered controller (chase,
+///     lazy, predict, neural; not search, which stops on wall
+///     time) or a scripted input: random actions held for
+///     1-45 ticks, drawn from the seed's SCRIPT stream. A
+///     match runs at fixed 1/60 s steps until it ends or
+///     GOLDEN_MAX_TICKS.
+///
+/// Input:
+///     index – corpus position
+///     trace – print tick, events and rally state every tick
+///             (diff two builds' traces to find the first
+///             diverging tick)
+///     kernelDivergence – PvP matches also run the server's
+///             SimMatch kernel (preset-specialized and runtime)
+///             on the same inputs: receives the first tick it
+///             differs from Match, -1 if it never does
+///////////////////////////////////////////////////////////////
+GoldenOutcome playGoldenMatch(std::size_t index, bool trace = false, long* kernelDivergence = nullptr);
+
+///////////////////////////////////////////////////////////////
+/// Function: runGoldenCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the gameplay regression
+///     suite:
+///       --golden-check  [--matches N] [--threads N] [--file F]
+///       --golden-update [--matches N] [--threads N] [--file F]
+///       --golden-trace INDEX
+///
+/// Description:
+///     Check plays the first N corpus matches (default: all
+///     100 000) on all cores and compares every outcome with
+///     the golden file (default bench/golden.dat); update
+///     rewrites the file from the current build. Mismatches
+///     are listed with the match setup and the command that
+///     traces it.
+///
+///     Both also check that the server's match kernel
+///     (SimMatch) stays in lockstep with Match in every PvP
+///     match of the corpus, on every arena preset: a
+///     divergence fails the command. Both step the same rally
+///     kernel, so this guards the scoring, serve and
+///     game-over code each keeps around it.
+///
+/// Return:
+///     int – process exit code (0 = every outcome identical,
+///           1 = a mismatch, a bad golden file or bad
+///           arguments)
+///////////////////////////////////////////////////////////////
+int runGoldenCommand(int argc, char** argv);
+
+#endif
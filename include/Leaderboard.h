@@ -0,0 +1,194 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "GameTypes.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+/// Struct: LeaderboardEntry
+/// ----------------------------------------------------------
+/// Objective:
+///     One finished game kept on the leaderboard.
+///
+/// Fields:
+///     name      – Player name
+///     score     – Score (AI mode) or winning margin (PvP mode)
+///     timestamp – Unix time (seconds) when the game ended
+///////////////////////////////////////////////////////////////
+struct LeaderboardEntry {
+    std::string name;
+    int score;
+    std::int64_t timestamp;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: Leaderboard
+/// ----------------------------------------------------------
+/// Objective:
+///     Persistent top-N leaderboard per game mode, written by
+///     a background I/O thread so the game loop never waits
+///     for the disk.
+///
+/// Description:
+///     Results are stored in an append-only journal of fixed
+///     64-byte binary records, each protected by a CRC-32.
+///       - Loading reads the file in one go and walks the
+///         records; the first invalid record (a write torn by
+///         a crash) ends the journal and is truncated away.
+///       - submit() updates the in-memory table immediately and
+///         queues the record; the writer thread appends every
+///         queued record with one write() and one fsync().
+///       - When the journal grows past a threshold it is
+///         compacted: the current top-N tables are written to a
+///         temporary file which atomically replaces the journal.
+///
+/// Side Effects:
+///     - Reads/writes the journal file.
+///     - Owns a background thread (joined in the destructor
+///       after flushing every queued record).
+///
+/// Used By:
+///     Game class (high score + end-of-game results).
+///////////////////////////////////////////////////////////////
+class Leaderboard {
+private:
+    static constexpr int MODE_COUNT = 2;
+
+    std::string path;            // Journal file path
+    std::size_t topN;            // Entries kept per mode
+
+    // Game-thread view: updated synchronously by submit()
+    std::vector<LeaderboardEntry> tables[MODE_COUNT];
+
+    // Writer-thread state (guarded by 'mutex')
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<unsigned char> pending;   // Encoded records waiting to be written
+    bool stopping;
+
+    // Writer-thread only
+    std::vector<LeaderboardEntry> writerTables[MODE_COUNT];
+    int fd;                      // Journal file descriptor (-1 if unavailable)
+    std::size_t journalRecords;  // Records currently in the journal file
+    std::thread writer;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: Leaderboard(const std::string& path,
+    ///                          std::size_t topN)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Loads the journal and starts the writer thread.
+    ///
+    /// Input:
+    ///     path – journal file path
+    ///     topN – entries kept per game mode
+    ///
+    /// Side Effects:
+    ///     - Reads (and possibly truncates) the journal.
+    ///     - Starts a background thread.
+    ///
+    /// Approach:
+    ///     Read whole file → validate fixed records → build
+    ///     tables → open for append → start writer.
+    ///////////////////////////////////////////////////////////
+    Leaderboard(const std::string& path, std::size_t topN);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Destructor: ~Leaderboard()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Flushes queued records and stops the writer thread.
+    ///////////////////////////////////////////////////////////
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: submit(GameMode mode, int score,
+    ///                  const std::string& name)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Records a finished game.
+    ///
+    /// Input:
+    ///     mode  – mode the game was played in
+    ///     score – score to rank by
+    ///     name  – player name (truncated to 39 bytes)
+    ///
+    /// Return:
+    ///     int – 1-based rank of the entry, or 0 if it did
+    ///           not make the top N (it is still journaled)
+    ///
+    /// Side Effects:
+    ///     - Updates the in-memory table.
+    ///     - Queues the record for the writer thread.
+    ///
+    /// Approach:
+    ///     Never touches the disk: encode → push under a short
+    ///     lock → notify the writer.
+    ///////////////////////////////////////////////////////////
+    int submit(GameMode mode, int score, const std::string& name);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getEntries(GameMode mode) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Returns the top-N table for a mode, best first.
+    ///////////////////////////////////////////////////////////
+    const std::vector<LeaderboardEntry>& getEntries(GameMode mode) const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getBest(GameMode mode) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Returns the best score for a mode (0 if none).
+    ///////////////////////////////////////////////////////////
+    int getBest(GameMode mode) const;
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: load()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Reads the journal into the tables and truncates any
+    ///     torn tail record.
+    ///////////////////////////////////////////////////////////
+    void load();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: writerLoop()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Body of the writer thread: appends queued records in
+    ///     batches (one fsync per batch) and compacts the
+    ///     journal when it grows too large.
+    ///////////////////////////////////////////////////////////
+    void writerLoop();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: compact()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Rewrites the journal so it only holds the current
+    ///     top-N entries (write temp file → fsync → rename).
+    ///////////////////////////////////////////////////////////
+    void compact();
+};
+
+#endif
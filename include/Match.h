@@ -0,0 +1,231 @@
+#ifndef MATCH_H
+#define MATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include "Arena.h"
+#include "EntityStore.h"
+#include "GameTypes.h"
+
+///////////////////////////////////////////////////////////////
+/// Namespace: MatchEvent
+/// ----------------------------------------------------------
+/// Objective:
+///     Bit flags returned by Match::step() describing what
+///     happened during the step (several may be set at once).
+///
+/// Values:
+///     WALL_BOUNCE  – Ball bounced off the top/bottom wall
+///     LEFT_HIT     – Ball bounced off the left paddle
+///     RIGHT_HIT    – Ball bounced off the right paddle
+///     LEFT_SCORED  – Ball left the arena on the right side
+///     RIGHT_SCORED – Ball left the arena on the left side
+///                    (costs a life in AI mode)
+///     GAME_OVER    – The match has just finished
+///////////////////////////////////////////////////////////////
+namespace MatchEvent {
+    const unsigned WALL_BOUNCE  = 1u << 0;
+    const unsigned LEFT_HIT     = 1u << 1;
+    const unsigned RIGHT_HIT    = 1u << 2;
+    const unsigned LEFT_SCORED  = 1u << 3;
+    const unsigned RIGHT_SCORED = 1u << 4;
+    const unsigned GAME_OVER    = 1u << 5;
+}
+
+///////////////////////////////////////////////////////////////
+/// Struct: MatchInput
+/// ----------------------------------------------------------
+/// Objective:
+///     The action of each paddle for one simulation step.
+///////////////////////////////////////////////////////////////
+struct MatchInput {
+    PaddleAction left;
+    PaddleAction right;
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: MatchProgress
+/// ----------------------------------------------------------
+/// Objective:
+///     Everything about a match in progress besides its mode,
+///     seed and rally state (SimState): together they are
+///     enough to continue it exactly (Match::restore()).
+///////////////////////////////////////////////////////////////
+struct MatchProgress {
+    int leftScore;
+    int rightScore;
+    int lives;                   // AI mode only
+    long tick;                   // Steps simulated so far
+    std::uint64_t point;         // Serves so far (RNG counter)
+};
+
+struct SimState;
+
+///////////////////////////////////////////////////////////////
+/// Function: serveVelocity(std::uint64_t seed,
+///                         std::uint64_t point,
+///                         const Arena& arena)
+/// ----------------------------------------------------------
+/// Objective:
+///     Ball velocity of serve number 'point' of the match
+///     with this seed, within the arena's serve speed and
+///     angle ranges (see Match::resetRound()).
+///////////////////////////////////////////////////////////////
+sf::Vector2f serveVelocity(std::uint64_t seed, std::uint64_t point, const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Class: Match
+/// ----------------------------------------------------------
+/// Objective:
+///     Headless simulation of one Pong match: paddles, ball,
+///     collisions, scoring, lives and game-over rules.
+///
+/// Description:
+///     Match contains no window or input handling; paddle
+///     actions are passed in for every step. The same rules
+///     therefore drive interactive play (Game), AI-vs-AI
+///     tournaments and any other headless simulation.
+///
+///     Rules by mode:
+///       - PLAYER_VS_AI: left player scores when the ball
+///         leaves on the right, loses a life when it leaves
+///         on the left; the match ends with no lives left.
+///       - PLAYER_VS_PLAYER: each side scores when the ball
+///         leaves on the opposite side; first to the target
+///         score wins.
+///
+///     Sizes, speeds, lives and the target score come from
+///     the match's Arena (CLASSIC_ARENA by default).
+///
+///     The ball and paddles are rows of an EntityStore (plain
+///     arrays, no drawables); Game draws them through an
+///     EntityRenderer. A step moves them with the SimState
+///     kernel (stepSimState) that search, the server and
+///     SimMatch use too, so the rally rules exist once;
+///     Match adds lives, scores and serves around it.
+///
+/// Side Effects:
+///     None outside the object.
+///
+/// Used By:
+///     Game (interactive play), Tournament (AI vs AI).
+///////////////////////////////////////////////////////////////
+class Match {
+private:
+    GameMode mode;               // Rules in effect
+    std::uint64_t seed;          // Match seed (serves, AI; reproducibility)
+    Arena arena;                 // Geometry and rules
+
+    EntityStore entities;        // Ball 0; boxes: left paddle 0, right paddle 1
+    unsigned (*rallyStep)(SimState&, const MatchInput&, float);  // Preset kernel, or nullptr
+
+    int leftScore;               // Player 1 score
+    int rightScore;              // Player 2 / AI score
+    int lives;                   // Lives remaining (AI mode only)
+    bool finished;               // Game-over reached
+    long tick;                   // Steps simulated so far
+    std::uint64_t point;         // Serves so far (RNG counter)
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: Match(GameMode mode, std::uint64_t seed,
+    ///                   const Arena& arena)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Sets up a fresh match and serves the first ball.
+    ///
+    /// Input:
+    ///     mode  – rules to play by
+    ///     seed  – match seed: keys the serve RNG and is passed
+    ///             on to AI controllers
+    ///     arena – field, entity geometry and rule constants
+    ///             (copied)
+    ///////////////////////////////////////////////////////////
+    explicit Match(GameMode mode = GameMode::PLAYER_VS_AI, std::uint64_t seed = 0,
+                   const Arena& arena = CLASSIC_ARENA);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: step(float dt, const MatchInput& input)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Advances the match by one step.
+    ///
+    /// Input:
+    ///     dt    – time step in seconds
+    ///     input – action of each paddle
+    ///
+    /// Return:
+    ///     unsigned – MatchEvent flags raised during the step
+    ///
+    /// Side Effects:
+    ///     - Moves paddles and ball, updates scores/lives.
+    ///
+    /// Approach:
+    ///     Rally step (stepSimState: paddle movement → ball
+    ///     update → paddle collisions → scoring test) →
+    ///     score/lives and re-serve → game-over check. Does
+    ///     nothing once the match is finished.
+    ///////////////////////////////////////////////////////////
+    unsigned step(float dt, const MatchInput& input);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: restore(const SimState& rally,
+    ///                   const MatchProgress& progress)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Puts a match back where a saved one was: paddles,
+    ///     ball, scores, lives and counters. Constructed with
+    ///     the saved mode and seed, the match then continues
+    ///     bit-identically to the original (future serves
+    ///     depend only on the seed and the point counter).
+    ///
+    /// Side Effects:
+    ///     Replaces the paddle and ball state.
+    ///////////////////////////////////////////////////////////
+    void restore(const SimState& rally, const MatchProgress& progress);
+
+
+    ///////////////////////////////////////////////////////////
+    // Read-only accessors
+    ///////////////////////////////////////////////////////////
+    GameMode getMode() const;
+    std::uint64_t getSeed() const;
+    const Arena& getArena() const;
+    const EntityStore& getEntities() const;
+    sf::FloatRect getPaddleBounds(Side side) const;
+    sf::FloatRect getBallBounds() const;
+    sf::Vector2f getBallVelocity() const;
+    int getLeftScore() const;
+    int getRightScore() const;
+    int getLives() const;
+    bool isFinished() const;
+    long getTick() const;
+    MatchProgress getProgress() const;
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: resetRound()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Re-serves the ball from the center after a point,
+    ///     alternating its direction. Serve speed and angle
+    ///     come from a counter-based RNG keyed by the match
+    ///     seed and the point number (see CounterRng).
+    ///////////////////////////////////////////////////////////
+    void resetRound();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: placeRally(const SimState& rally)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Writes a rally state back into the entity tables.
+    ///////////////////////////////////////////////////////////
+    void placeRally(const SimState& rally);
+};
+
+#endif
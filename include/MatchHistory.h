@@ -0,0 +1,155 @@
+#ifndef MATCH_HISTORY_H
+#define MATCH_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameTypes.h"
+#include "Match.h"
+#include "SimState.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: HistoryFrame
+/// ----------------------------------------------------------
+/// Objective:
+///     Everything needed to put the game back into the state
+///     one Game::update() left it in.
+///
+/// Fields:
+///     rally    – ball and paddles
+///     progress – scores, lives, tick and serve counter
+///     seed     – match seed (a frame may belong to an
+///                earlier match than the current one)
+///     mode     – match mode
+///     state    – PLAYING, or GAME_OVER on a match's last frame
+///     dt       – frame time the update used
+///////////////////////////////////////////////////////////////
+struct HistoryFrame {
+    SimState rally;
+    MatchProgress progress;
+    std::uint64_t seed;
+    GameMode mode;
+    GameState state;
+    float dt;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: MatchHistory
+/// ----------------------------------------------------------
+/// Objective:
+///     Always-on recording of the last minute of play, for
+///     rewinding and stepping through it (time-travel
+///     debugging).
+///
+/// Description:
+///     A frame is 17 32-bit words. Frames are grouped in
+///     blocks of KEYFRAME_INTERVAL: the first frame of a block
+///     is stored whole (keyframe), every other one as the XOR
+///     with the frame before it. Between consecutive updates
+///     most words do not change and the changed ones (ball and
+///     paddle positions, tick, dt) keep their high bytes, so a
+///     delta stores a 17-bit mask of the changed words, a
+///     2-bit length per changed word and only the non-zero
+///     low bytes of each XOR: typically about 20 bytes
+///     instead of 68.
+///
+///     Blocks are written one after another into a fixed
+///     BUFFER_BYTES ring (a block never wraps; it starts over
+///     at offset 0 instead). Starting a block evicts the
+///     oldest blocks it would overwrite, and the oldest block
+///     once HISTORY_BLOCKS complete blocks (a minute at 60
+///     updates per second) are kept. Nothing is allocated
+///     after the constructor, so recording costs one encode of
+///     68 bytes per update.
+///
+///     Reading frame i decodes its block's keyframe and at
+///     most KEYFRAME_INTERVAL - 1 deltas.
+///
+/// Side Effects:
+///     - Allocates BUFFER_BYTES up front.
+///
+/// Used By:
+///     Game class (F6 time-travel mode), benchmarks.
+///////////////////////////////////////////////////////////////
+class MatchHistory {
+public:
+    static constexpr std::size_t WORDS = 17;                 // 32-bit words per frame
+    static constexpr std::size_t KEYFRAME_INTERVAL = 60;     // Frames per block
+    static constexpr std::size_t HISTORY_BLOCKS = 60;        // Complete blocks kept: 60 s at 60 Hz
+    static constexpr std::size_t BUFFER_BYTES = 192 * 1024;  // Encoded frames (ring)
+
+private:
+    struct Block {
+        std::size_t offset;          // First byte in 'bytes'
+        std::size_t size;            // Encoded bytes
+        std::size_t frames;          // Frames (KEYFRAME_INTERVAL unless newest)
+    };
+
+    static constexpr std::size_t MAX_BLOCKS = HISTORY_BLOCKS + 1;
+
+    std::vector<unsigned char> bytes;
+    Block blocks[MAX_BLOCKS];        // Ring, oldest at firstBlock
+    std::size_t firstBlock;
+    std::size_t blockCount;
+    std::uint32_t previous[WORDS];   // Last recorded frame (delta reference)
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: MatchHistory()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Empty history with its buffer allocated.
+    ///////////////////////////////////////////////////////////
+    MatchHistory();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: record(const HistoryFrame& frame)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Appends the newest frame (evicting the oldest ones
+    ///     as needed).
+    ///////////////////////////////////////////////////////////
+    void record(const HistoryFrame& frame);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getFrame(std::size_t index,
+    ///                    HistoryFrame& frame) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Decodes a recorded frame.
+    ///
+    /// Input:
+    ///     index – 0 = oldest kept, getFrameCount() - 1 = newest
+    ///
+    /// Return:
+    ///     bool – false if 'index' is out of range
+    ///////////////////////////////////////////////////////////
+    bool getFrame(std::size_t index, HistoryFrame& frame) const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: truncate(std::size_t count)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Keeps the oldest 'count' frames and forgets the rest,
+    ///     so play resumed from a rewound frame records a new
+    ///     future.
+    ///////////////////////////////////////////////////////////
+    void truncate(std::size_t count);
+
+    // Forget everything
+    void clear();
+
+    std::size_t getFrameCount() const;
+    std::size_t getEncodedBytes() const;     // Bytes of the kept frames
+    std::size_t getMemoryBytes() const;      // Total footprint
+
+private:
+    std::size_t decode(const Block& block, std::size_t last, std::uint32_t* words) const;
+    void startBlock();
+};
+
+#endif
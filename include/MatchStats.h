@@ -0,0 +1,338 @@
+#ifndef MATCH_STATS_H
+#define MATCH_STATS_H
+
+#include "GameTypes.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Match;
+
+///////////////////////////////////////////////////////////////
+/// Constant: MATCH_STATS_PATH
+/// ----------------------------------------------------------
+/// Objective:
+///     Base path of the game's stats store (".log" and ".col"
+///     are appended; see MatchStatsStore).
+///////////////////////////////////////////////////////////////
+extern const char* const MATCH_STATS_PATH;
+
+///////////////////////////////////////////////////////////////
+/// Constant: STATS_HIT_ZONES
+/// ----------------------------------------------------------
+/// Objective:
+///     Paddle hits are counted by where the ball's center met
+///     the paddle: zone 0 is the top fifth, zone 4 the bottom.
+///////////////////////////////////////////////////////////////
+const std::size_t STATS_HIT_ZONES = 5;
+
+///////////////////////////////////////////////////////////////
+/// Struct: MatchStatsRow
+/// ----------------------------------------------------------
+/// Objective:
+///     Statistics of one finished match (one row of the
+///     stats store).
+///
+/// Fields:
+///     timestamp    – Unix time (seconds) the match ended
+///     ticks        – simulation steps played
+///     hits         – paddle hits, both sides
+///     hitZones     – hits by paddle zone (see STATS_HIT_ZONES)
+///     leftTravel,
+///     rightTravel  – distance each paddle moved (pixels)
+///     points       – points played (serves that ended)
+///     longestRally – most hits in one point
+///     mode         – GameMode
+///     arena        – ARENA_PRESETS index, 255 for a custom arena
+///     leftScore,
+///     rightScore   – final score
+///////////////////////////////////////////////////////////////
+struct MatchStatsRow {
+    std::int64_t timestamp;
+    std::uint32_t ticks;
+    std::uint32_t hits;
+    std::uint32_t hitZones[STATS_HIT_ZONES];
+    std::uint32_t leftTravel;
+    std::uint32_t rightTravel;
+    std::uint16_t points;
+    std::uint16_t longestRally;
+    std::uint8_t mode;
+    std::uint8_t arena;
+    std::uint8_t leftScore;
+    std::uint8_t rightScore;
+    std::uint32_t reserved;
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: StatsColumn
+/// ----------------------------------------------------------
+/// Objective:
+///     The columns of the stats store, one per row field
+///     (hit zones are one column each). Stored in this order.
+///////////////////////////////////////////////////////////////
+enum class StatsColumn : std::uint8_t {
+    TIMESTAMP, MODE, ARENA, TICKS, LEFT_SCORE, RIGHT_SCORE, POINTS, HITS, LONGEST_RALLY,
+    ZONE_0, ZONE_1, ZONE_2, ZONE_3, ZONE_4, LEFT_TRAVEL, RIGHT_TRAVEL
+};
+
+const std::size_t STATS_COLUMN_COUNT = 16;
+
+const char* statsColumnName(StatsColumn column);
+
+// A row's value in a column, widened
+std::uint64_t statsColumnValue(const MatchStatsRow& row, StatsColumn column);
+
+///////////////////////////////////////////////////////////////
+/// Structs: StatsChunk, StatsSegmentHeader
+/// ----------------------------------------------------------
+/// Objective:
+///     On-disk layout of the columnar store ("<base>.col").
+///
+/// Description:
+///     The file is a sequence of segments of up to
+///     STATS_SEGMENT_ROWS rows. A segment is its header
+///     followed by one chunk per column, in StatsColumn order.
+///
+///     A chunk stores its column frame-of-reference coded:
+///     every value minus the chunk minimum ('base') in the
+///     narrowest of 1, 2, 4 or 8 bytes that holds the range.
+///     Most columns of a segment fit in one or two bytes
+///     (scores, modes, zones, even timestamps relative to
+///     the segment's first match need four), so a match costs
+///     about 22 bytes instead of the row's 56, and the values
+///     stay fixed-width arrays a scan can run over directly.
+///
+///     Queries use the header to read only the chunks of the
+///     columns they need (column pruning) and skip segments
+///     whose min/max cannot match a filter (zone maps).
+///
+///     Every header and chunk carries a CRC-32. 'sourceCrc' is
+///     the CRC of the journal rows the segment was built from
+///     (see MatchStatsStore).
+///////////////////////////////////////////////////////////////
+const std::size_t STATS_SEGMENT_ROWS = 4096;
+
+struct StatsChunk {
+    std::uint64_t base;          // Minimum value
+    std::uint64_t max;
+    std::uint32_t crc;           // Of the stored bytes
+    std::uint8_t width;          // Bytes per value: 1, 2, 4 or 8
+    std::uint8_t reserved[3];
+};
+
+struct StatsSegmentHeader {
+    char magic[4];               // "MSC1"
+    std::uint32_t rows;
+    std::uint32_t sourceCrc;
+    std::uint32_t headerCrc;     // Of the header with this field zero
+    StatsChunk chunks[STATS_COLUMN_COUNT];
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: encodeStatsSegment(const MatchStatsRow* rows,
+///                              std::size_t count,
+///                              std::uint32_t sourceCrc,
+///                              std::vector<unsigned char>& out)
+/// ----------------------------------------------------------
+/// Objective:
+///     Appends one segment (header and chunks) holding
+///     'count' rows (1..STATS_SEGMENT_ROWS) to 'out'.
+///////////////////////////////////////////////////////////////
+void encodeStatsSegment(const MatchStatsRow* rows, std::size_t count, std::uint32_t sourceCrc,
+                        std::vector<unsigned char>& out);
+
+///////////////////////////////////////////////////////////////
+/// Function: readStatsJournal(const std::string& path,
+///                            std::vector<MatchStatsRow>& rows)
+/// ----------------------------------------------------------
+/// Objective:
+///     Appends the rows of a stats journal ("<base>.log") that
+///     have not been moved to segments yet.
+///
+/// Return:
+///     long – bytes of torn data after the last valid record
+///////////////////////////////////////////////////////////////
+long readStatsJournal(const std::string& path, std::vector<MatchStatsRow>& rows);
+
+///////////////////////////////////////////////////////////////
+/// Class: StatsFileReader
+/// ----------------------------------------------------------
+/// Objective:
+///     Walks the segments of a columnar stats file, reading
+///     only the chunks asked for.
+///
+/// Description:
+///     next() reads a segment header and checks it; the
+///     chunks are read on demand by readColumn(), which
+///     seeks to them, checks their CRC and decodes them into
+///     plain arrays. Columns never asked for are never read.
+///
+/// Used By:
+///     MatchStatsStore (recovery), the stats query.
+///////////////////////////////////////////////////////////////
+class StatsFileReader {
+private:
+    std::FILE* file;
+    StatsSegmentHeader segment;
+    long segmentStart;           // File offset of the header
+    long validEnd;               // End of the last valid segment
+    std::uint64_t bytesRead;
+    std::vector<unsigned char> scratch;
+
+public:
+    StatsFileReader();
+    ~StatsFileReader();
+
+    StatsFileReader(const StatsFileReader&) = delete;
+    StatsFileReader& operator=(const StatsFileReader&) = delete;
+
+    bool open(const std::string& path);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: next()
+    /// ------------------------------------------------------
+    /// Return:
+    ///     bool – false at the end of the file or at the first
+    ///            invalid or truncated segment
+    ///////////////////////////////////////////////////////////
+    bool next();
+
+    const StatsSegmentHeader& getSegment() const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: readColumn(StatsColumn column,
+    ///                      std::uint32_t* out)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Decodes one column of the current segment into
+    ///     'out' (getSegment().rows values).
+    ///
+    /// Return:
+    ///     bool – false on a read or CRC error, or if a value
+    ///            does not fit 32 bits (use the 64-bit form)
+    ///////////////////////////////////////////////////////////
+    bool readColumn(StatsColumn column, std::uint32_t* out);
+    bool readColumn(StatsColumn column, std::uint64_t* out);
+
+    long getValidEnd() const;             // Bytes of whole, valid segments so far
+    std::uint64_t getBytesRead() const;
+
+private:
+    const unsigned char* readChunk(StatsColumn column);
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: MatchStatsRecorder
+/// ----------------------------------------------------------
+/// Objective:
+///     Collects a match's statistics while it is played.
+///
+/// Description:
+///     Fed the match and the events of every step. It counts
+///     points, hits (by paddle zone), the longest rally and
+///     how far each paddle moved. A rewind with the F6 time
+///     travel does not take back what was already counted.
+///
+/// Used By:
+///     Game class (interactive matches).
+///////////////////////////////////////////////////////////////
+class MatchStatsRecorder {
+private:
+    MatchStatsRow row;
+    float leftY, rightY;         // Paddle tops after the last step
+    double leftTravel, rightTravel;
+    unsigned rally;              // Hits in the current point
+
+public:
+    MatchStatsRecorder();
+
+    // Starts counting a (new or resumed) match
+    void start(const Match& match);
+
+    // After each Match::step(): the step's MatchEvent flags
+    void record(const Match& match, unsigned events);
+
+    // The finished match's row
+    MatchStatsRow finish(const Match& match, std::int64_t timestamp) const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: MatchStatsStore
+/// ----------------------------------------------------------
+/// Objective:
+///     Appends finished matches to the on-disk stats store on
+///     a background thread.
+///
+/// Description:
+///     Two files share a base path:
+///       - "<base>.log": journal of 64-byte row records with a
+///         CRC-32 each (the Leaderboard's scheme), where new
+///         matches are appended;
+///       - "<base>.col": the columnar segments.
+///     Whenever the journal reaches STATS_SEGMENT_ROWS rows
+///     they are encoded as one segment, appended and fsynced
+///     to the columnar file, and the journal is emptied. A
+///     crash between the two leaves the rows in both; the
+///     segment's sourceCrc identifies them so they are dropped
+///     from the journal the next time it is opened. Torn
+///     journal records and segments are cut off.
+///
+///     append() never touches the disk; the writer thread
+///     does all I/O, starting with the recovery, so nothing is
+///     opened or created before the first match is stored.
+///
+/// Side Effects:
+///     - Writes both files.
+///     - Owns a background thread (joined in the destructor
+///       after writing every queued row).
+///
+/// Used By:
+///     Game class (at game over).
+///////////////////////////////////////////////////////////////
+class MatchStatsStore {
+private:
+    std::string basePath;
+
+    // Guarded by 'mutex'
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<MatchStatsRow> pending;
+    bool stopping;
+
+    // Writer thread only
+    bool opened;
+    int fd;                                  // Journal, -1 if unavailable
+    std::vector<MatchStatsRow> journalRows;
+    std::thread writer;
+
+public:
+    explicit MatchStatsStore(const std::string& basePath);
+    ~MatchStatsStore();
+
+    MatchStatsStore(const MatchStatsStore&) = delete;
+    MatchStatsStore& operator=(const MatchStatsStore&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: append(const MatchStatsRow& row)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Queues a finished match for the writer thread.
+    ///////////////////////////////////////////////////////////
+    void append(const MatchStatsRow& row);
+
+private:
+    void writerLoop();
+    void open();
+    void writeRows(const std::vector<MatchStatsRow>& rows);
+    bool flushSegment();
+};
+
+#endif
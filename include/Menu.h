@@ -2,6 +2,9 @@
 #define MENU_H
 
 #include <SFML/Graphics.hpp>
+#include <vector>
+#include "Leaderboard.h"
+#include "SdfFont.h"
 
 ////////////////////////////////////////////////////////////////
 /// Class: Menu
@@ -20,7 +23,6 @@
 ///     Game class to render and control menu interactions.
 ///
 /// Side Effects:
-///     - Loads font from disk
 ///     - Draws graphical UI on the window
 ////////////////////////////////////////////////////////////////
 class Menu {
@@ -29,48 +31,48 @@ private:
     //////////////////////////////////////////////////////////////
     // Visual + Text Resources
     //////////////////////////////////////////////////////////////
-    sf::Font font;                // Loaded font used by all menu text
-    sf::Text titleText;           // Title text (“PONG”)
-    sf::Text highScoreText;       // High score display for AI mode
+    SdfText titleText;            // Title text (“PONG”)
+    SdfText highScoreText;        // High score display for AI mode
+    SdfText topScoresText;        // Top AI-mode leaderboard entries
 
     //////////////////////////////////////////////////////////////
     // AI Button UI elements
     //////////////////////////////////////////////////////////////
     sf::RectangleShape aiButton;  // Button background rectangle
-    sf::Text aiButtonText;        // “Play vs AI” label text
+    SdfText aiButtonText;         // “Play vs AI” label text
 
     //////////////////////////////////////////////////////////////
     // PVP Button UI elements
     //////////////////////////////////////////////////////////////
     sf::RectangleShape pvpButton; // Button background rectangle
-    sf::Text pvpButtonText;       // “Player vs Player” label text
+    SdfText pvpButtonText;        // “Player vs Player” label text
 
 
 public:
 
     //////////////////////////////////////////////////////////////
-    /// Constructor: Menu()
+    /// Constructor: Menu(const SdfFont& font)
     /// ---------------------------------------------------------
     /// Objective:
     ///     Initializes all menu UI elements including buttons,
-    ///     text styles, layout, positioning, and font loading.
+    ///     text styles and layout.
     ///
     /// Input:
-    ///     None
+    ///     font – loaded UI font (owned by the caller, must
+    ///            outlive the menu)
     ///
     /// Return:
     ///     No return value (constructor)
     ///
     /// Side Effects:
-    ///     - Loads font from file
     ///     - Positions all menu UI elements on screen
     ///
     /// Approach:
-    ///     Load font → configure title text → setup buttons →
-    ///     center UI elements on the window → initialize default
+    ///     Configure title text → setup buttons → center UI
+    ///     elements on the window → initialize default
     ///     high-score text.
     //////////////////////////////////////////////////////////////
-    Menu();
+    explicit Menu(const SdfFont& font);
 
 
     //////////////////////////////////////////////////////////////
@@ -94,6 +96,28 @@ public:
     void setHighScore(int score);
 
 
+    //////////////////////////////////////////////////////////////
+    /// Function: setTopScores(const std::vector<LeaderboardEntry>& entries)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Updates the short leaderboard listing under the
+    ///     mode buttons.
+    ///
+    /// Input:
+    ///     entries – AI-mode leaderboard table, best first
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     - Rebuilds topScoresText (first few entries only)
+    ///
+    /// Approach:
+    ///     One "rank. name  score" line per entry.
+    //////////////////////////////////////////////////////////////
+    void setTopScores(const std::vector<LeaderboardEntry>& entries);
+
+
     //////////////////////////////////////////////////////////////
     /// Function: isAISelected(const sf::Vector2i& mousePos) const
     /// ---------------------------------------------------------
@@ -133,7 +157,7 @@ public:
 
 
     //////////////////////////////////////////////////////////////
-    /// Function: draw(sf::RenderWindow& window)
+    /// Function: draw(sf::RenderTarget& target)
     /// ---------------------------------------------------------
     /// Objective:
     ///     Draws the complete menu interface including the
@@ -141,7 +165,7 @@ public:
     ///     buttons.
     ///
     /// Input:
-    ///     window – reference to SFML RenderWindow
+    ///     target – window (or texture) to draw on
     ///
     /// Return:
     ///     void
@@ -150,10 +174,10 @@ public:
     ///     - Renders UI elements to screen
     ///
     /// Approach:
-    ///     window.draw(title) → draw(highScore) →
-    ///     draw(AI button) → draw(PVP button).
+    ///     target.draw(title) → draw(highScore) →
+    ///     draw(AI button) → draw(PVP button) → draw(top scores).
     //////////////////////////////////////////////////////////////
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderTarget& target);
 
 };
 
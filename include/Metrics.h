@@ -0,0 +1,170 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+///////////////////////////////////////////////////////////////
+/// Enum: MetricCounter
+/// ----------------------------------------------------------
+/// Objective:
+///     Monotonic counters recorded by the game.
+///
+/// Values:
+///     POINTS            – points scored (either side)
+///     AI_MISSES         – points the AI paddle conceded
+///                         (AI mode only)
+///     GAMES             – matches finished
+///     HIGH_SCORE_WRITES – results made durable in the
+///                         leaderboard journal
+///////////////////////////////////////////////////////////////
+enum class MetricCounter {
+    POINTS,
+    AI_MISSES,
+    GAMES,
+    HIGH_SCORE_WRITES,
+    COUNT
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: MetricHistogram
+/// ----------------------------------------------------------
+/// Objective:
+///     Distributions recorded by the game (fixed buckets,
+///     see Metrics.cpp).
+///
+/// Values:
+///     FRAME_SECONDS  – time between frames of Game::run()
+///     UPDATE_SECONDS – time spent in Game::update()
+///     RALLY_HITS     – paddle hits of each finished rally
+///////////////////////////////////////////////////////////////
+enum class MetricHistogram {
+    FRAME_SECONDS,
+    UPDATE_SECONDS,
+    RALLY_HITS,
+    COUNT
+};
+
+///////////////////////////////////////////////////////////////
+/// Functions: countMetric / observeMetric
+/// ----------------------------------------------------------
+/// Objective:
+///     Record into the calling thread's shard of the metrics
+///     registry (any thread, a few nanoseconds each).
+///
+/// Description:
+///     Every thread that records gets a shard of its own on
+///     its first call (the only time a lock is taken). From
+///     then on a record is a relaxed load and store of the
+///     thread's own cells: no atomic read-modify-write, no
+///     shared cache line, nothing a reader could block.
+///
+/// Input:
+///     counter / histogram – metric to record into
+///     amount              – counter increment
+///     value               – observed value (seconds for the
+///                           *_SECONDS histograms)
+///////////////////////////////////////////////////////////////
+void countMetric(MetricCounter counter, std::uint64_t amount = 1);
+void observeMetric(MetricHistogram histogram, double value);
+
+///////////////////////////////////////////////////////////////
+/// Function: formatMetrics(std::string& out)
+/// ----------------------------------------------------------
+/// Objective:
+///     Appends every counter and histogram, summed over all
+///     shards, in the Prometheus text exposition format.
+///
+/// Description:
+///     Reads the shards with relaxed loads while their
+///     threads keep recording: a scrape never waits for a
+///     recording thread, and a sample may miss records made
+///     while it was taken (the next scrape includes them).
+///////////////////////////////////////////////////////////////
+void formatMetrics(std::string& out);
+
+// Current total of a counter over all shards (any thread)
+std::uint64_t readMetric(MetricCounter counter);
+
+///////////////////////////////////////////////////////////////
+/// Class: MetricsExporter
+/// ----------------------------------------------------------
+/// Objective:
+///     Tiny HTTP endpoint serving the metrics registry to a
+///     Prometheus scraper: GET /metrics on 127.0.0.1.
+///
+/// Description:
+///     Runs on a thread of its own, one short connection at a
+///     time (every response is built from a fresh
+///     formatMetrics() and the connection is closed). A
+///     client that stalls is dropped after a second; the game
+///     thread is never involved.
+///
+///     Besides the registry it exports
+///     pong_points_per_minute: points scored over the last
+///     minute, from a once-per-second sample of
+///     pong_points_total kept by the exporter thread.
+///
+///     POSIX sockets only; on Windows start() fails.
+///
+/// Side Effects:
+///     - Listens on a loopback TCP port.
+///     - Owns a background thread (joined in the destructor).
+///
+/// Used By:
+///     main() (pong --metrics-port PORT).
+///////////////////////////////////////////////////////////////
+class MetricsExporter {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct PointSample {
+        Clock::time_point time;
+        std::uint64_t points;
+    };
+
+    static constexpr std::size_t RATE_SAMPLES = 61;   // One minute of 1 s samples
+
+    std::uint16_t port;
+    int listenFd;
+    std::thread thread;
+    std::atomic<bool> stopping;
+
+    // Exporter thread: pong_points_total once per second (ring)
+    PointSample samples[RATE_SAMPLES];
+    std::size_t sampleCount;
+    std::size_t sampleNext;
+
+public:
+    explicit MetricsExporter(std::uint16_t port);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: start(std::string& error)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Binds 127.0.0.1:port and starts the exporter
+    ///     thread.
+    ///
+    /// Return:
+    ///     bool – false (with error set) if the port could not
+    ///            be bound
+    ///////////////////////////////////////////////////////////
+    bool start(std::string& error);
+
+private:
+    void serveLoop();
+    void serveClient(int fd);
+    void samplePoints();
+    double pointsPerMinute() const;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef NEURAL_CONTROLLER_H
+#define NEURAL_CONTROLLER_H
+
+#include <memory>
+#include "PaddleController.h"
+#include "PolicyNetwork.h"
+
+///////////////////////////////////////////////////////////////
+/// Constant: POLICY_WEIGHTS_PATH
+/// ----------------------------------------------------------
+/// Objective:
+///     Weights loaded by NeuralController (written by
+///     pong --train-policy).
+///////////////////////////////////////////////////////////////
+extern const char* const POLICY_WEIGHTS_PATH;
+
+///////////////////////////////////////////////////////////////
+/// Function: sharedPolicyModel()
+/// ----------------------------------------------------------
+/// Objective:
+///     The model at POLICY_WEIGHTS_PATH, loaded once per
+///     process (thread-safe).
+///
+/// Return:
+///     const PolicyModel* – nullptr if the file is missing or
+///                          invalid
+///////////////////////////////////////////////////////////////
+const PolicyModel* sharedPolicyModel();
+
+///////////////////////////////////////////////////////////////
+/// Class: NeuralController
+/// ----------------------------------------------------------
+/// Objective:
+///     Plays with the trained MLP policy (int8 inference).
+///
+/// Description:
+///     Each decision encodes the match with policyFeatures()
+///     and runs a batch of one through its own PolicyNetwork.
+///     Batched use (many matches per call) goes through
+///     PolicyNetwork::infer() directly.
+///
+///     Without a weights file the controller falls back to
+///     the chase AI and says so in its report.
+///////////////////////////////////////////////////////////////
+class NeuralController : public PaddleController {
+private:
+    std::unique_ptr<PolicyNetwork> network;   // nullptr without weights
+    ChaseController fallback;
+
+public:
+    NeuralController();
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+    std::string getReport() const override;
+};
+
+#endif
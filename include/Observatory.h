@@ -0,0 +1,159 @@
+#ifndef OBSERVATORY_H
+#define OBSERVATORY_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "EntityStore.h"
+#include "Match.h"
+#include "PaddleController.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: observatory size
+/// ----------------------------------------------------------
+/// Objective:
+///     Matches an observatory runs (start() clamps to this
+///     range) and how many the menu's O key opens.
+///////////////////////////////////////////////////////////////
+const std::size_t OBSERVATORY_MIN_MATCHES     = 16;
+const std::size_t OBSERVATORY_MAX_MATCHES     = 256;
+const std::size_t OBSERVATORY_DEFAULT_MATCHES = 64;
+
+///////////////////////////////////////////////////////////////
+/// Class: Observatory
+/// ----------------------------------------------------------
+/// Objective:
+///     Runs a grid of AI-vs-AI matches side by side and draws
+///     them all as miniatures of the playfield: a live view of
+///     how two controllers play each other, and a load test of
+///     the render path.
+///
+/// Description:
+///     The matches are one array stepped together every tick,
+///     each with its own pair of controllers deciding from the
+///     pre-step state (as Tournament::playMatch() does). A
+///     match that ends – or runs MAX_TICKS without a winner,
+///     counted as a draw – is replaced by a new one with the
+///     next seed, so the grid never goes still.
+///
+///     draw() builds one EntityRenderer batch for the whole
+///     grid: a background per cell, every match's entities
+///     scaled into its cell, and score pips. However many
+///     matches are shown, it is a single draw call; the cost
+///     is the vertex count (36 per cell, plus 6 per point
+///     scored).
+///
+/// Side Effects:
+///     - Allocates when started (never while stepping or
+///       drawing at a constant size).
+///
+/// Used By:
+///     Game class (OBSERVATORY state), benchmarks.
+///////////////////////////////////////////////////////////////
+class Observatory {
+private:
+    Arena arena;
+    std::string leftName;        // Controller of every left paddle
+    std::string rightName;       // ... and of every right paddle
+
+    std::vector<Match> matches;
+    std::vector<std::unique_ptr<PaddleController>> leftControllers;
+    std::vector<std::unique_ptr<PaddleController>> rightControllers;
+    std::uint64_t nextSeed;      // Seed of the next match started
+
+    long leftWins;
+    long rightWins;
+    long draws;
+
+    // Grid layout (field coordinates), set by layout()
+    sf::FloatRect bounds;
+    std::size_t columns;
+    sf::Vector2f cellSize;
+    float fieldScale;            // Arena → miniature
+    sf::Vector2f fieldOffset;    // Miniature's corner inside its cell
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: Observatory(const Arena& arena,
+    ///                          const std::string& left,
+    ///                          const std::string& right)
+    /// ------------------------------------------------------
+    /// Input:
+    ///     arena       – field and rules of every match
+    ///     left, right – registered controller names; an
+    ///                   unknown name falls back to "chase"
+    ///////////////////////////////////////////////////////////
+    Observatory(const Arena& arena, const std::string& left, const std::string& right);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: start(std::size_t count, std::uint64_t seed)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Replaces the grid with 'count' new matches
+    ///     (clamped to OBSERVATORY_MIN/MAX_MATCHES) seeded
+    ///     seed, seed + 1, ... and clears the tallies.
+    ///////////////////////////////////////////////////////////
+    void start(std::size_t count, std::uint64_t seed);
+
+    // Controllers of the matches started from now on (start() applies them to all)
+    void setControllers(const std::string& left, const std::string& right);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: step(float dt)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Advances every match by one tick.
+    ///
+    /// Return:
+    ///     std::size_t – matches that ended (and were
+    ///                   replaced) this tick
+    ///////////////////////////////////////////////////////////
+    std::size_t step(float dt);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: layout(const sf::FloatRect& area)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Fits the grid into 'area' (field coordinates):
+    ///     columns and rows as close to the area's shape as
+    ///     the match count allows, each miniature keeping the
+    ///     arena's aspect ratio.
+    ///////////////////////////////////////////////////////////
+    void layout(const sf::FloatRect& area);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: draw(EntityRenderer& renderer,
+    ///                sf::RenderTarget& target)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Draws the whole grid in one batch (the target's
+    ///     view must be the field view layout() used).
+    ///////////////////////////////////////////////////////////
+    void draw(EntityRenderer& renderer, sf::RenderTarget& target) const;
+
+
+    ///////////////////////////////////////////////////////////
+    // Read-only accessors
+    ///////////////////////////////////////////////////////////
+    std::size_t getMatchCount() const;
+    const Match& getMatch(std::size_t index) const;
+    const std::string& getLeftName() const;
+    const std::string& getRightName() const;
+    long getLeftWins() const;
+    long getRightWins() const;
+    long getDraws() const;
+
+private:
+    void restart(std::size_t index);
+};
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef PADDLE_CONTROLLER_H
+#define PADDLE_CONTROLLER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameTypes.h"
+#include "Match.h"
+
+///////////////////////////////////////////////////////////////
+/// Class: PaddleController
+/// ----------------------------------------------------------
+/// Objective:
+///     Interface for automated paddle players (AI opponents).
+///
+/// Description:
+///     A controller looks at the match and picks the action of
+///     one paddle for the next step. Controllers must be fully
+///     deterministic given the seed passed to reset(), so any
+///     AI-vs-AI match can be replayed from its seed (the search
+///     AI only when created reproducible, see
+///     createController()).
+///
+/// Used By:
+///     Game (AI opponent), Tournament (all entrants).
+///////////////////////////////////////////////////////////////
+class PaddleController {
+public:
+    virtual ~PaddleController() = default;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: reset(std::uint64_t seed)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Prepares the controller for a new match.
+    ///
+    /// Input:
+    ///     seed – per-match seed for any randomness
+    ///////////////////////////////////////////////////////////
+    virtual void reset(std::uint64_t seed);
+
+    ///////////////////////////////////////////////////////////
+    /// Function: decide(const Match& match, Side side, float dt)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Chooses the paddle action for the next step.
+    ///
+    /// Input:
+    ///     match – current match state
+    ///     side  – paddle being controlled
+    ///     dt    – length of the coming step (seconds)
+    ///
+    /// Return:
+    ///     PaddleAction – UP, DOWN or STAY
+    ///////////////////////////////////////////////////////////
+    virtual PaddleAction decide(const Match& match, Side side, float dt) = 0;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getReport() const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Optional one-line performance report (e.g. search
+    ///     statistics) of this controller's decisions so far,
+    ///     shown by the tournament runner.
+    ///////////////////////////////////////////////////////////
+    virtual std::string getReport() const;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: addStatistics(const PaddleController& other)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Adds the statistics behind another controller's
+    ///     report (same kind, e.g. one that just played a
+    ///     match) to this one's, so one report can cover many
+    ///     matches. Default: nothing to add.
+    ///////////////////////////////////////////////////////////
+    virtual void addStatistics(const PaddleController& other);
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: ChaseController
+/// ----------------------------------------------------------
+/// Objective:
+///     The original AI: moves the paddle toward the ball's
+///     current height every step. Baseline tournament entrant.
+///////////////////////////////////////////////////////////////
+class ChaseController : public PaddleController {
+public:
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: LazyChaseController
+/// ----------------------------------------------------------
+/// Objective:
+///     Chase with human-like reaction time: the target height
+///     is only refreshed every 80–160 ms (seeded) and small
+///     offsets inside a dead zone are ignored.
+///////////////////////////////////////////////////////////////
+class LazyChaseController : public PaddleController {
+private:
+    std::uint64_t rngState;      // splitmix64 state
+    float reactionTime;          // Seconds between target refreshes
+    float sinceRefresh;          // Seconds since last refresh
+    float targetY;               // Height currently chased
+
+public:
+    LazyChaseController();
+    void reset(std::uint64_t seed) override;
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: PredictController
+/// ----------------------------------------------------------
+/// Objective:
+///     Predicts where the incoming ball will cross the
+///     paddle's line (unfolding wall bounces) and waits there,
+///     with a seeded aiming error per approach; returns to the
+///     center while the ball moves away.
+///////////////////////////////////////////////////////////////
+class PredictController : public PaddleController {
+private:
+    std::uint64_t rngState;      // splitmix64 state
+    float aimError;              // Offset applied to the current prediction
+    bool approaching;            // Ball was moving toward us last step
+
+public:
+    PredictController();
+    void reset(std::uint64_t seed) override;
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: ControllerInfo
+/// ----------------------------------------------------------
+/// Objective:
+///     Registry entry describing one available controller.
+///////////////////////////////////////////////////////////////
+struct ControllerInfo {
+    const char* name;                               // Name used on the command line
+    const char* description;                        // One-line description
+    std::unique_ptr<PaddleController> (*create)(bool reproducible);  // Factory
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: getControllerRegistry()
+/// ----------------------------------------------------------
+/// Objective:
+///     Lists every registered controller ("chase" first).
+///////////////////////////////////////////////////////////////
+const std::vector<ControllerInfo>& getControllerRegistry();
+
+///////////////////////////////////////////////////////////////
+/// Function: createController(const std::string& name,
+///                            bool reproducible = false)
+/// ----------------------------------------------------------
+/// Objective:
+///     Instantiates a registered controller by name.
+///
+/// Input:
+///     reproducible – decisions must depend on the match and
+///                    seed only, never on timing: the search
+///                    AI then drops its wall-clock budget and
+///                    always searches to full depth (bounded
+///                    by its node arena). Used where a match
+///                    has to be replayable (the opponent of a
+///                    recorded game and its verifier,
+///                    tournaments, --match, renders); the menu
+///                    demo and the observatory keep the
+///                    real-time budget.
+///
+/// Return:
+///     std::unique_ptr<PaddleController> – nullptr if unknown
+///////////////////////////////////////////////////////////////
+std::unique_ptr<PaddleController> createController(const std::string& name, bool reproducible = false);
+
+///////////////////////////////////////////////////////////////
+/// Function: mixSeed(std::uint64_t seed, std::uint64_t stream)
+/// ----------------------------------------------------------
+/// Objective:
+///     Derives an independent 64-bit seed from a base seed and
+///     a stream number (splitmix64 finalizer).
+///////////////////////////////////////////////////////////////
+std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream);
+
+#endif
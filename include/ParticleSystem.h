@@ -0,0 +1,220 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Half edge length of a drawn particle (a square, in pixels)
+const float PARTICLE_HALF_SIZE = 1.5f;
+
+////////////////////////////////////////////////////////////////
+/// Struct: ParticleSprite
+/// ------------------------------------------------------------
+/// Objective:
+///     One live particle as it is drawn: a square of
+///     PARTICLE_HALF_SIZE around its center, colour with the
+///     alpha of its remaining life.
+////////////////////////////////////////////////////////////////
+struct ParticleSprite {
+    float x;
+    float y;
+    sf::Color color;
+};
+
+////////////////////////////////////////////////////////////////
+/// Class: ParticleSystem
+/// ------------------------------------------------------------
+/// Objective:
+///     Fixed-capacity pool of short-lived particles used for
+///     impact effects (paddle hits, wall bounces, scoring).
+///
+/// Description:
+///     Particle data is kept in Structure-of-Arrays layout:
+///     one contiguous float array per attribute (position,
+///     velocity, remaining life, fade rate) plus one colour
+///     array. All storage, including the vertex buffer used
+///     for drawing, is allocated once in the constructor, so
+///     emitting, updating and drawing never allocate memory.
+///
+///     Live particles are always packed in [0, alive), which
+///     lets the integration loop run over plain arrays that
+///     the compiler auto-vectorizes, and lets the whole pool
+///     be drawn with one batched vertex-array draw call.
+///
+/// Side Effects:
+///     - Allocates all memory up front (~110 bytes/particle)
+///
+/// Used By:
+///     Game class (hit and score effects)
+////////////////////////////////////////////////////////////////
+class ParticleSystem {
+private:
+
+    //////////////////////////////////////////////////////////////
+    // Pool bookkeeping
+    //////////////////////////////////////////////////////////////
+    std::size_t capacity;         // Maximum number of live particles
+    std::size_t alive;            // Live particles, packed at the front
+
+    //////////////////////////////////////////////////////////////
+    // Particle attributes (Structure of Arrays)
+    //////////////////////////////////////////////////////////////
+    std::vector<float> posX;      // X positions
+    std::vector<float> posY;      // Y positions
+    std::vector<float> velX;      // X velocities (pixels/second)
+    std::vector<float> velY;      // Y velocities (pixels/second)
+    std::vector<float> life;      // Remaining life in [0, 1]
+    std::vector<float> fade;      // Life lost per second
+    std::vector<sf::Color> color; // Base colour (alpha follows life)
+
+    //////////////////////////////////////////////////////////////
+    // Rendering + statistics
+    //////////////////////////////////////////////////////////////
+    std::vector<sf::Vertex> vertices; // 4 vertices per particle (quads)
+    std::uint32_t rngState;           // xorshift32 state for emission
+    float updateMicros;               // Cost of the last update()
+    float drawMicros;                 // Cost of the last draw()
+
+public:
+
+    //////////////////////////////////////////////////////////////
+    /// Constructor: ParticleSystem(std::size_t capacity)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Creates an empty pool able to hold 'capacity'
+    ///     particles at once.
+    ///
+    /// Input:
+    ///     capacity – maximum number of live particles
+    ///
+    /// Side Effects:
+    ///     - Allocates every attribute array and the vertex
+    ///       buffer for the full capacity.
+    //////////////////////////////////////////////////////////////
+    explicit ParticleSystem(std::size_t capacity);
+
+
+    //////////////////////////////////////////////////////////////
+    /// Function: emit(x, y, count, color, speed)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Spawns a radial burst of particles at a point.
+    ///
+    /// Input:
+    ///     x, y  – burst origin in window coordinates
+    ///     count – number of particles requested
+    ///     color – base particle colour
+    ///     speed – maximum initial speed (pixels/second)
+    ///
+    /// Return:
+    ///     void
+    ///
+    /// Side Effects:
+    ///     - Particles beyond the free capacity are dropped.
+    //////////////////////////////////////////////////////////////
+    void emit(float x, float y, std::size_t count,
+              const sf::Color& color, float speed);
+
+
+    //////////////////////////////////////////////////////////////
+    /// Function: update(float dt)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Integrates all live particles and retires dead ones.
+    ///
+    /// Input:
+    ///     dt – delta time in seconds
+    ///
+    /// Approach:
+    ///     One branch-free pass per attribute array (vectorized),
+    ///     then a compaction pass that swaps dead particles with
+    ///     the last live one.
+    //////////////////////////////////////////////////////////////
+    void update(float dt);
+
+
+    //////////////////////////////////////////////////////////////
+    /// Function: draw(sf::RenderTarget& target)
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Draws every live particle with a single draw call.
+    ///
+    /// Input:
+    ///     target – window (or texture) to draw on
+    ///
+    /// Approach:
+    ///     Fill the preallocated quad buffer → one target.draw().
+    //////////////////////////////////////////////////////////////
+    void draw(sf::RenderTarget& target);
+
+
+    //////////////////////////////////////////////////////////////
+    /// Function: getSprites(std::vector<ParticleSprite>& out) const
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Appends every live particle as draw() would show it
+    ///     (for renderers without a render target, such as the
+    ///     video exporter).
+    //////////////////////////////////////////////////////////////
+    void getSprites(std::vector<ParticleSprite>& out) const;
+
+    //////////////////////////////////////////////////////////////
+    /// Function: clear()
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Retires all particles immediately (no deallocation).
+    //////////////////////////////////////////////////////////////
+    void clear();
+
+
+    //////////////////////////////////////////////////////////////
+    // Statistics accessors (shown in the Game stats overlay)
+    //////////////////////////////////////////////////////////////
+    std::size_t getAliveCount() const;   // Live particles
+    std::size_t getCapacity() const;     // Pool size
+    std::size_t getMemoryBytes() const;  // Bytes reserved by the pool
+    float getUpdateMicros() const;       // Last update() cost (µs)
+    float getDrawMicros() const;         // Last draw() cost (µs)
+
+private:
+
+    //////////////////////////////////////////////////////////////
+    /// Function: nextRandom()
+    /// ---------------------------------------------------------
+    /// Objective:
+    ///     Returns a uniform float in [0, 1) from xorshift32.
+    //////////////////////////////////////////////////////////////
+    float nextRandom();
+};
+
+////////////////////////////////////////////////////////////////
+/// Function: emitMatchEffects(ParticleSystem& particles,
+///                            unsigned events, float exitY,
+///                            const sf::FloatRect& ball,
+///                            float fieldWidth)
+/// ------------------------------------------------------------
+/// Objective:
+///     Emits the impact effects of one Match::step().
+///
+/// Input:
+///     events     – MatchEvent flags returned by the step
+///     exitY      – ball center height before the step (where
+///                  a scoring burst is shown)
+///     ball       – ball bounds after the step
+///     fieldWidth – arena width
+///
+/// Approach:
+///     WALL_BOUNCE → small blue burst at the ball; LEFT_HIT /
+///     RIGHT_HIT → white burst at the hit side of the ball;
+///     a point → red burst where it was lost (left edge) or
+///     green where it was won (right edge).
+///
+/// Used By:
+///     Game::update(), the video exporter.
+////////////////////////////////////////////////////////////////
+void emitMatchEffects(ParticleSystem& particles, unsigned events, float exitY,
+                      const sf::FloatRect& ball, float fieldWidth);
+
+#endif
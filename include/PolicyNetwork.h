@@ -0,0 +1,215 @@
+#ifndef POLICY_NETWORK_H
+#define POLICY_NETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameTypes.h"
+#include "SimState.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: policy network shape
+/// ----------------------------------------------------------
+/// POLICY_INPUTS  – features per decision (policyFeatures)
+/// POLICY_HIDDEN  – width of both hidden layers
+/// POLICY_OUTPUTS – one logit per PaddleAction (STAY/UP/DOWN)
+///////////////////////////////////////////////////////////////
+const std::size_t POLICY_INPUTS  = 8;
+const std::size_t POLICY_HIDDEN  = 32;
+const std::size_t POLICY_OUTPUTS = 3;
+
+///////////////////////////////////////////////////////////////
+/// Function: policyFeatures(const SimState& state, Side side,
+///                          float* features)
+/// ----------------------------------------------------------
+/// Objective:
+///     Encodes a rally as POLICY_INPUTS floats (roughly in
+///     [-2, 2]) from the point of view of 'side'.
+///
+/// Description:
+///     The arena is mirrored for the left paddle so that the
+///     controlled paddle is always on the right; one network
+///     therefore plays either side.
+///////////////////////////////////////////////////////////////
+void policyFeatures(const SimState& state, Side side, float* features);
+
+///////////////////////////////////////////////////////////////
+/// Struct: PolicyLayer
+/// ----------------------------------------------------------
+/// Objective:
+///     One fully connected float layer (row-major weights:
+///     outputs × inputs).
+///////////////////////////////////////////////////////////////
+struct PolicyLayer {
+    std::size_t inputs;
+    std::size_t outputs;
+    std::vector<float> weights;
+    std::vector<float> bias;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: PolicyModel
+/// ----------------------------------------------------------
+/// Objective:
+///     The trained MLP in float: the reference implementation
+///     and the on-disk format.
+///
+/// Description:
+///     Layers: POLICY_INPUTS → POLICY_HIDDEN (ReLU) →
+///     POLICY_HIDDEN (ReLU) → POLICY_OUTPUTS. Besides the
+///     weights, the file stores the largest activation seen
+///     in each hidden layer on the training set; the int8
+///     network uses them as quantization ranges.
+///
+///     File layout (little endian): "PNN1", u32 layer count,
+///     per layer u32 inputs, u32 outputs, f32 weights[],
+///     f32 bias[], f32 activation range.
+///////////////////////////////////////////////////////////////
+class PolicyModel {
+public:
+    std::vector<PolicyLayer> layers;
+    std::vector<float> activationMax;    // Per hidden layer (quantization range)
+
+    ///////////////////////////////////////////////////////////
+    /// Function: forward(const float* features, float* logits)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Float reference inference for one decision.
+    ///////////////////////////////////////////////////////////
+    void forward(const float* features, float* logits) const;
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Enum: PolicyKernel
+/// ----------------------------------------------------------
+/// Objective:
+///     Implementations of the int8 dot-product kernel.
+///
+/// Values:
+///     AUTO   – best kernel supported by this CPU
+///     SCALAR – portable C++
+///     AVX2   – vpmaddubsw + vpmaddwd (x86 AVX2)
+///     VNNI   – vpdpbusd (AVX-VNNI or AVX-512 VNNI)
+///////////////////////////////////////////////////////////////
+enum class PolicyKernel {
+    AUTO,
+    SCALAR,
+    AVX2,
+    VNNI
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: PolicyNetwork
+/// ----------------------------------------------------------
+/// Objective:
+///     Batched int8 inference of a PolicyModel.
+///
+/// Description:
+///     Weights are quantized per output row to int8 and
+///     activations to unsigned 7-bit values (0..127, so the
+///     u8 × s8 pair sums of vpmaddubsw cannot saturate).
+///     Inputs are padded to 32 bytes and outputs to 8 rows
+///     so one AVX2 register holds a whole input vector and
+///     eight rows reduce into one register.
+///
+///     Each layer is one kernel call: int32 dot products,
+///     then one multiply-add per output (in registers) that
+///     folds dequantization, bias and requantization for the
+///     next layer.
+///
+///     infer() evaluates a whole batch (e.g. the same paddle
+///     in many simulated matches) per call. Scratch buffers
+///     grow to the largest batch seen and are then reused,
+///     so one network must not be shared between threads.
+///////////////////////////////////////////////////////////////
+class PolicyNetwork {
+private:
+    struct QuantizedLayer {
+        std::size_t inputs;              // Padded to a multiple of 32
+        std::size_t outputs;             // Padded to a multiple of 8
+        std::size_t realOutputs;
+        std::vector<std::int8_t> weights;
+        std::vector<float> scale;        // Accumulator → next layer's units
+        std::vector<float> offset;       // Bias (+ input zero point) in those units
+    };
+
+    std::vector<QuantizedLayer> layers;
+    PolicyKernel kernel;                 // Kernel in use (never AUTO)
+
+    // Scratch, reused across calls (batch × width)
+    std::vector<std::uint8_t> activations[2];
+    std::vector<float> logitBuffer;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: PolicyNetwork(const PolicyModel& model,
+    ///                            PolicyKernel kernel)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Quantizes a float model for int8 inference.
+    ///
+    /// Input:
+    ///     model  – trained float model
+    ///     kernel – AUTO, or a specific kernel (falls back to
+    ///              SCALAR if the CPU lacks it)
+    ///////////////////////////////////////////////////////////
+    explicit PolicyNetwork(const PolicyModel& model, PolicyKernel kernel = PolicyKernel::AUTO);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: infer(const float* features, std::size_t batch,
+    ///                 PaddleAction* actions)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Chooses the action of 'batch' paddles at once.
+    ///
+    /// Input:
+    ///     features – batch × POLICY_INPUTS floats
+    ///     batch    – number of decisions
+    ///
+    /// Return:
+    ///     actions  – batch actions (argmax of the logits)
+    ///////////////////////////////////////////////////////////
+    void infer(const float* features, std::size_t batch, PaddleAction* actions);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: logits(const float* features, std::size_t batch)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Runs the int8 network and returns dequantized
+    ///     logits (batch × POLICY_OUTPUTS), for accuracy checks.
+    ///////////////////////////////////////////////////////////
+    const float* logits(const float* features, std::size_t batch);
+
+
+    PolicyKernel getKernel() const;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: isKernelSupported(PolicyKernel kernel)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     True if this build and CPU can run the kernel.
+    ///////////////////////////////////////////////////////////
+    static bool isKernelSupported(PolicyKernel kernel);
+
+    static const char* kernelName(PolicyKernel kernel);
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: run(const float* features, std::size_t batch)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Quantize inputs, evaluate every layer; leaves the
+    ///     logits in logitBuffer.
+    ///////////////////////////////////////////////////////////
+    void run(const float* features, std::size_t batch);
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef POLICY_TRAINING_H
+#define POLICY_TRAINING_H
+
+///////////////////////////////////////////////////////////////
+/// Function: runPolicyCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point for the neural policy tools.
+///
+/// Input:
+///     argv[1] selects the command:
+///       --train-policy [--out FILE] [--teacher NAME]
+///                      [--samples N] [--epochs N] [--seed S]
+///           Records the teacher controller's decisions
+///           (default "predict") in headless matches (behaviour
+///           cloning), trains the float MLP with Adam and writes
+///           the weights (default assets/policy.bin).
+///       --policy-check [--weights FILE] [--batch N] [--seed S]
+///           Accuracy of every int8 kernel against the float
+///           reference, kernel throughput at batch 1 and N, and
+///           N matches vs the chase AI run in lockstep with one
+///           batched inference per step.
+///
+/// Return:
+///     int – process exit code (0 = success, 1 = failure or
+///           int8 accuracy below the 98% agreement gate)
+///////////////////////////////////////////////////////////////
+int runPolicyCommand(int argc, char** argv);
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef SCORE_REPLAY_H
+#define SCORE_REPLAY_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Match.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: score submissions
+/// ----------------------------------------------------------
+/// Objective:
+///     Intake directory the game writes AI-mode results to
+///     (and the verifier reads), and the limits of a replay:
+///     the longest game and the longest single step accepted.
+///////////////////////////////////////////////////////////////
+extern const char* const SUBMISSIONS_DIR;
+const std::size_t MAX_REPLAY_STEPS = 60 * 60 * 60;      // An hour at 60 Hz
+const float MAX_REPLAY_DT = 1.f;
+
+///////////////////////////////////////////////////////////////
+/// Struct: ScoreSubmission
+/// ----------------------------------------------------------
+/// Objective:
+///     A finished AI-mode game claimed for the leaderboard,
+///     with everything needed to play it again: the match's
+///     seed and arena, the opponent, and every step's length
+///     and paddle actions.
+///
+/// Description:
+///     actions[i] packs step i's inputs: bits 0-1 the player's
+///     (left) PaddleAction, bits 2-3 the opponent's. The
+///     opponent's are recomputed when verifying; they are kept
+///     to tell where a replay diverges.
+///
+///     outcome is the CRC-32 of the final rally state and
+///     progress (matchOutcomeCrc()): the checksum a verifier
+///     must reach at the last step.
+///////////////////////////////////////////////////////////////
+struct ScoreSubmission {
+    std::uint64_t seed;
+    std::int64_t timestamp;      // Unix time the game ended
+    int arena;                   // ARENA_PRESETS index
+    std::string ai;              // Registered controller of the right paddle
+    std::string name;            // Player
+    std::int32_t score;          // Claimed: the player's points
+    std::int32_t opponentScore;
+    std::uint32_t outcome;       // matchOutcomeCrc() after the last step
+    std::vector<float> dts;
+    std::vector<std::uint8_t> actions;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: matchOutcomeCrc(const Match& match)
+/// ----------------------------------------------------------
+/// Objective:
+///     CRC-32 of the rally state and progress (scores, lives,
+///     tick, serves), field by field: the checksum of a
+///     replayed game's end.
+///////////////////////////////////////////////////////////////
+std::uint32_t matchOutcomeCrc(const Match& match);
+
+///////////////////////////////////////////////////////////////
+/// Function: encodeSubmission(const ScoreSubmission& submission,
+///                            std::vector<std::uint8_t>& out)
+/// ----------------------------------------------------------
+/// Objective:
+///     Serializes a submission (the .psub file format).
+///
+/// Description:
+///     A 128-byte header – magic "PSB1", version, a CRC-32 of
+///     every byte after the CRC field, step count, seed, time,
+///     claimed scores, outcome CRC, arena, opponent and player
+///     names – then the step lengths (float32) and the packed
+///     actions (one byte per step). Native byte order.
+///////////////////////////////////////////////////////////////
+void encodeSubmission(const ScoreSubmission& submission, std::vector<std::uint8_t>& out);
+
+///////////////////////////////////////////////////////////////
+/// Function: decodeSubmission(const std::uint8_t* data,
+///                            std::size_t size,
+///                            ScoreSubmission& submission,
+///                            std::string& error)
+/// ----------------------------------------------------------
+/// Objective:
+///     Parses a .psub file.
+///
+/// Return:
+///     bool – false (with the reason in 'error') for a wrong
+///            magic, version or size, or a CRC mismatch
+///////////////////////////////////////////////////////////////
+bool decodeSubmission(const std::uint8_t* data, std::size_t size, ScoreSubmission& submission,
+                      std::string& error);
+
+///////////////////////////////////////////////////////////////
+/// Function: verifySubmission(const ScoreSubmission& submission,
+///                            std::string& error,
+///                            long* steps = nullptr)
+/// ----------------------------------------------------------
+/// Objective:
+///     Plays a submission again and decides whether its score
+///     is genuine.
+///
+/// Return:
+///     bool – true if the replay, from the submission's seed
+///            and arena against a freshly reset opponent,
+///            makes the same opponent moves at every step,
+///            ends the game exactly at its last step with the
+///            claimed scores, and reaches the outcome CRC;
+///            false with the first failure in 'error'
+///
+/// Side Effects:
+///     - Adds the steps simulated to *steps if given.
+///
+/// Approach:
+///     Headless Match + createController(ai), reset as
+///     Game::startMatch() does; no rendering, no allocation
+///     per step.
+///////////////////////////////////////////////////////////////
+bool verifySubmission(const ScoreSubmission& submission, std::string& error, long* steps = nullptr);
+
+///////////////////////////////////////////////////////////////
+/// Class: ScoreRecorder
+/// ----------------------------------------------------------
+/// Objective:
+///     Records the replay of the AI-mode game being played,
+///     for submission when it ends.
+///
+/// Description:
+///     record() is called before every step with the step's
+///     length and inputs. The replay stays valid only while it
+///     covers the match from its first step without a gap: a
+///     match restored from anywhere else (time travel back, a
+///     resumed session) or a step outside the accepted limits
+///     makes the game unsubmittable, since its earlier inputs
+///     (and the opponent's internal state) are unknown.
+///
+/// Side Effects:
+///     - Reserves MAX_REPLAY_STEPS steps once (about 1 MB), so
+///       recording never allocates during play.
+///
+/// Used By:
+///     Game class, the submission generator.
+///////////////////////////////////////////////////////////////
+class ScoreRecorder {
+private:
+    bool valid;
+    std::uint64_t seed;
+    int arena;
+    std::string ai;
+    std::vector<float> dts;
+    std::vector<std::uint8_t> actions;
+
+public:
+    ScoreRecorder();
+
+    ///////////////////////////////////////////////////////////
+    /// Function: start(const Match& match, const std::string& ai)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Begins the replay of a new match (valid only for an
+    ///     AI-mode match on a preset arena that has not
+    ///     stepped yet).
+    ///////////////////////////////////////////////////////////
+    void start(const Match& match, const std::string& ai);
+
+    // The match about to step with these inputs (before Match::step)
+    void record(const Match& match, float dt, const MatchInput& input);
+
+    void cancel();               // The current game cannot be submitted
+    bool isValid() const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: finish(const Match& match,
+    ///                  const std::string& name,
+    ///                  std::int64_t timestamp,
+    ///                  ScoreSubmission& submission) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Builds the submission of the ended match.
+    ///
+    /// Return:
+    ///     bool – false if the replay is not valid or the match
+    ///            is not the one recorded, or has not ended
+    ///////////////////////////////////////////////////////////
+    bool finish(const Match& match, const std::string& name, std::int64_t timestamp,
+                ScoreSubmission& submission) const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SubmissionOutbox
+/// ----------------------------------------------------------
+/// Objective:
+///     Writes submissions into the intake directory from a
+///     background thread, so the frame that ends a game never
+///     waits for the disk.
+///
+/// Description:
+///     Each submission becomes <seed>-<time>.psub, written as
+///     a .tmp file and renamed into place: a verifier scanning
+///     the directory only ever sees complete files.
+///
+/// Side Effects:
+///     - Creates the directory on the first submission.
+///     - Owns a writer thread (joined in the destructor after
+///       writing everything queued).
+///
+/// Used By:
+///     Game class (AI-mode game over), the submission
+///     generator.
+///////////////////////////////////////////////////////////////
+class SubmissionOutbox {
+private:
+    std::string directory;
+
+    // Guarded by 'mutex'
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<ScoreSubmission> pending;
+    bool stopping;
+
+    std::thread writer;
+
+public:
+    explicit SubmissionOutbox(const std::string& directory);
+    ~SubmissionOutbox();
+
+    SubmissionOutbox(const SubmissionOutbox&) = delete;
+    SubmissionOutbox& operator=(const SubmissionOutbox&) = delete;
+
+    // Queues a submission for the writer thread
+    void submit(ScoreSubmission submission);
+
+private:
+    void writerLoop();
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: writeSubmissionFile(const std::string& directory,
+///                               const ScoreSubmission& submission)
+/// ----------------------------------------------------------
+/// Objective:
+///     Writes one submission into a directory (temporary file
+///     + rename), creating the directory if needed.
+///
+/// Return:
+///     bool – false if the file could not be written
+///////////////////////////////////////////////////////////////
+bool writeSubmissionFile(const std::string& directory, const ScoreSubmission& submission);
+
+#endif
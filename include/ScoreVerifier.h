@@ -0,0 +1,43 @@
+#ifndef SCORE_VERIFIER_H
+#define SCORE_VERIFIER_H
+
+///////////////////////////////////////////////////////////////
+/// Function: runScoreCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the score verification
+///     service:
+///       --verify-scores [DIR] [--threads N] [--watch]
+///                       [--dry-run] [--leaderboard FILE]
+///       --submissions-generate N [DIR] [--ai NAME]
+///                       [--player NAME] [--tampered K]
+///                       [--seed S] [--threads N]
+///
+/// Description:
+///     Verify replays every .psub file in DIR (default: the
+///     game's "submissions") on N threads (default: every
+///     core). Genuine scores enter the verified leaderboard
+///     (default "verified_leaderboard.dat", a Leaderboard
+///     journal) and their files move to DIR/verified as
+///     <seed>-<outcome>.psub, which also rejects a genuine
+///     replay submitted twice (e.g. under another name).
+///     Other files move to DIR/rejected, their reasons
+///     appended to DIR/rejected/reasons.log. --dry-run only
+///     reports, and fails if any file would be rejected;
+///     --watch keeps polling DIR for new files until
+///     interrupted.
+///
+///     Generate plays N AI-mode games (controller --player,
+///     default lazy, against --ai, default chase, with
+///     jittered 60 Hz steps) and writes them into DIR; the
+///     first K are tampered with (raised score, edited
+///     inputs, a corrupted byte) to exercise rejection.
+///
+/// Return:
+///     int – process exit code (0 = success, 1 = bad
+///           arguments, an unreadable directory or, with
+///           --dry-run, a rejected file)
+///////////////////////////////////////////////////////////////
+int runScoreCommand(int argc, char** argv);
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef SDF_FONT_H
+#define SDF_FONT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+/// Constants: SDF atlas file (SDF1)
+/// ----------------------------------------------------------
+/// Objective:
+///     Shape of the glyph atlas written by the font-atlas
+///     build tool (tools/FontAtlas.cpp) and read by SdfFont.
+///
+/// Description:
+///     Glyphs are rasterized SDF_RENDER_SCALE times larger
+///     than SDF_EM_SIZE and reduced to a signed distance
+///     field at SDF_EM_SIZE pixels per em. Distances are
+///     stored as one byte per texel: 128 on the outline,
+///     255 at SDF_SPREAD pixels inside it, 0 at SDF_SPREAD
+///     pixels outside. Every glyph cell has SDF_SPREAD pixels
+///     of margin so the field fades out before the cell ends.
+///
+///     File layout (native byte order, like the policy
+///     weights):
+///         "SDF1"
+///         u32 em size, u32 spread, u32 atlas width,
+///         u32 atlas height, u32 glyph count, f32 line spacing
+///         SdfGlyph × glyph count (SDF_FIRST_CHAR upwards)
+///         u8 distance × atlas width × atlas height
+///////////////////////////////////////////////////////////////
+const unsigned SDF_EM_SIZE      = 32;     // Atlas pixels per em
+const unsigned SDF_SPREAD       = 4;      // Distance range (and cell margin), atlas pixels
+const unsigned SDF_RENDER_SCALE = 8;      // Rasterization size / SDF_EM_SIZE
+const unsigned SDF_ATLAS_WIDTH  = 512;
+const char32_t SDF_FIRST_CHAR   = 32;     // ' '
+const char32_t SDF_LAST_CHAR    = 126;    // '~'
+
+const char SDF_FILE_MAGIC[4] = { 'S', 'D', 'F', '1' };
+
+///////////////////////////////////////////////////////////////
+/// Struct: SdfGlyph
+/// ----------------------------------------------------------
+/// Objective:
+///     One character of the atlas, in atlas pixels (scale by
+///     characterSize / SDF_EM_SIZE to draw).
+///
+/// Fields:
+///     advance – pen advance to the next character
+///     left,
+///     top     – cell corner relative to the pen on the
+///               baseline (y down); includes the margin
+///     width,
+///     height  – cell size (0 for blank glyphs such as ' ')
+///     x, y    – cell corner in the atlas
+///////////////////////////////////////////////////////////////
+struct SdfGlyph {
+    float advance;
+    std::int16_t left;
+    std::int16_t top;
+    std::uint16_t width;
+    std::uint16_t height;
+    std::uint16_t x;
+    std::uint16_t y;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SdfFont
+/// ----------------------------------------------------------
+/// Objective:
+///     The UI font as one signed-distance-field texture that
+///     draws text of any size.
+///
+/// Description:
+///     An sf::Font rasterizes every character size it is asked
+///     for into its own glyph pages, on first use – a hitch
+///     the first time a size or character appears, and one
+///     texture per size. The SDF atlas is generated at build
+///     time instead and loaded once: texels hold distances to
+///     the outline, so a fragment shader finds a sharp,
+///     anti-aliased edge at any scale by thresholding the
+///     bilinearly filtered distance at 128.
+///
+///     Without shader support the distances are converted to
+///     plain coverage at load time; text still draws from the
+///     same single texture, only softer when scaled up.
+///
+/// Side Effects:
+///     - Creates one texture (SDF_ATLAS_WIDTH wide) and, when
+///       shaders are available, one fragment shader.
+///
+/// Used By:
+///     SdfText (all menu and in-game text).
+///////////////////////////////////////////////////////////////
+class SdfFont {
+private:
+    std::vector<SdfGlyph> glyphs;   // SDF_FIRST_CHAR..SDF_LAST_CHAR
+    float lineSpacing;              // Baseline to baseline, atlas pixels
+    std::vector<std::uint8_t> distances; // The atlas, SDF_ATLAS_WIDTH per row
+    sf::Texture texture;            // White, distance (or coverage) in alpha
+    sf::Shader shader;
+    bool useShader;
+
+public:
+    SdfFont();
+
+    SdfFont(const SdfFont&) = delete;
+    SdfFont& operator=(const SdfFont&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: loadFromFile(const std::string& path,
+    ///                        bool upload)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Reads an SDF1 atlas and uploads it.
+    ///
+    /// Input:
+    ///     upload – false to keep the atlas in memory only, for
+    ///              CPU rendering without a graphics context
+    ///              (no texture or shader is created)
+    ///
+    /// Return:
+    ///     bool – false if the file is missing, truncated or
+    ///            was built with other SDF_* constants
+    ///////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& path, bool upload = true);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getGlyph(char32_t character) const
+    /// ------------------------------------------------------
+    /// Return:
+    ///     const SdfGlyph& – the character's glyph; '?' for
+    ///                       characters outside the atlas, an
+    ///                       empty glyph if nothing is loaded
+    ///////////////////////////////////////////////////////////
+    const SdfGlyph& getGlyph(char32_t character) const;
+
+    float getLineSpacing() const;
+
+    // Distance bytes of the atlas (SDF_ATLAS_WIDTH x getAtlasHeight()), nullptr if not loaded
+    const std::uint8_t* getDistances() const;
+    unsigned getAtlasHeight() const;
+    const sf::Texture& getTexture() const;
+
+    // Distance-threshold shader, nullptr if the texture holds coverage
+    const sf::Shader* getShader() const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SdfText
+/// ----------------------------------------------------------
+/// Objective:
+///     A block of text drawn from an SdfFont (replaces
+///     sf::Text for the UI).
+///
+/// Description:
+///     Lays the string out once per change into one quad per
+///     visible character, so drawing is a single draw call
+///     with the font's texture and shader whatever the
+///     length, line count or character size. Layout follows
+///     sf::Text: the first baseline is characterSize below
+///     the origin, '\n' starts a new line, and the bounds
+///     cover the glyph outlines (not their margins).
+///
+/// Used By:
+///     Menu, Game.
+///////////////////////////////////////////////////////////////
+class SdfText : public sf::Drawable, public sf::Transformable {
+private:
+    const SdfFont* font;
+    std::string string;
+    unsigned characterSize;
+    sf::Color fillColor;
+    std::vector<sf::Vertex> vertices;   // 6 per visible character
+    sf::FloatRect bounds;               // Outline bounds, local coordinates
+
+public:
+    SdfText();
+
+    void setFont(const SdfFont& newFont);
+    void setString(std::string_view newString);
+    void setCharacterSize(unsigned size);
+    void setFillColor(const sf::Color& color);
+
+    const std::string& getString() const;
+
+    // Laid-out quads (6 vertices per character, local coordinates, texture coordinates in atlas pixels)
+    const std::vector<sf::Vertex>& getVertices() const;
+    sf::FloatRect getLocalBounds() const;
+    sf::FloatRect getGlobalBounds() const;
+
+private:
+    void rebuild();
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef SEARCH_CONTROLLER_H
+#define SEARCH_CONTROLLER_H
+
+#include <cstddef>
+#include <vector>
+#include "PaddleController.h"
+#include "SimState.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: SearchNode
+/// ----------------------------------------------------------
+/// Objective:
+///     One candidate action sequence in the search tree: the
+///     state it leads to, the first action of the sequence
+///     (what would be played now) and its evaluation.
+///////////////////////////////////////////////////////////////
+struct SearchNode {
+    SimState state;              // State after the sequence
+    float score;                 // Evaluation (higher is better)
+    PaddleAction firstAction;    // Action to play this step
+    bool terminal;               // A point was scored: not expanded
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: NodeArena
+/// ----------------------------------------------------------
+/// Objective:
+///     Fixed-capacity bump allocator for search nodes.
+///
+/// Description:
+///     All nodes live in one array allocated when the
+///     controller is created. allocate() hands out the next
+///     slot and reset() frees every node at once, so a search
+///     never calls the heap allocator and its nodes are
+///     contiguous in memory.
+///////////////////////////////////////////////////////////////
+class NodeArena {
+private:
+    std::vector<SearchNode> nodes;   // Storage (fixed size)
+    std::size_t used;                // Slots handed out since reset()
+
+public:
+    explicit NodeArena(std::size_t capacity);
+
+    ///////////////////////////////////////////////////////////
+    /// Function: allocate()
+    /// ------------------------------------------------------
+    /// Return:
+    ///     SearchNode* – next free node, nullptr when full
+    ///////////////////////////////////////////////////////////
+    SearchNode* allocate();
+
+    void reset();                    // Release all nodes
+    SearchNode* at(std::size_t index);
+    std::size_t size() const;        // Nodes in use
+    std::size_t capacity() const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: SearchStatistics
+/// ----------------------------------------------------------
+/// Objective:
+///     Totals over a controller's decisions (plus any added
+///     with addStatistics()).
+///////////////////////////////////////////////////////////////
+struct SearchStatistics {
+    unsigned long long nodes = 0;
+    unsigned long long nanos = 0;
+    unsigned long long decisions = 0;
+    unsigned long long depth = 0;            // Summed over decisions
+    unsigned long long timeCutoffs = 0;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SearchController
+/// ----------------------------------------------------------
+/// Objective:
+///     Hard AI opponent that plans by forward simulation.
+///
+/// Description:
+///     Every step the controller copies the rally into a
+///     SimState and runs a beam search over its own action
+///     sequences. Actions are held for a few steps at a time
+///     ("macro actions"), so depth 10 looks 500 ms ahead at
+///     60 Hz. The opponent is modelled as the baseline chase
+///     AI. Leaves are scored by whether the paddle can still
+///     reach the predicted intercept (wall bounces unfolded),
+///     with conceded/won points as terminal scores.
+///
+///     The search is anytime: layers are expanded one at a
+///     time and the best first action of the deepest finished
+///     layer is played. It stops at the maximum depth, when
+///     the node arena is full, or when the per-step time
+///     budget (default 1 ms) runs out. Stopping on time is the
+///     only non-deterministic cutoff and is counted; without a
+///     budget (reproducible controllers, see createController())
+///     every decision depends on the match alone.
+///
+///     Each controller counts its own search statistics, shown
+///     by getReport() (nodes/s, depth, time cutoffs); a
+///     tournament adds up those of every controller that
+///     played through addStatistics().
+///
+/// Side Effects:
+///     Allocates the node arena once, in the constructor.
+///////////////////////////////////////////////////////////////
+class SearchController : public PaddleController {
+private:
+    NodeArena arena;             // Search nodes, reset every decision
+    double budgetSeconds;        // Wall-clock budget per decide(), 0 = none
+    SearchStatistics statistics;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: SearchController(double budgetSeconds)
+    /// ------------------------------------------------------
+    /// Input:
+    ///     budgetSeconds – time allowed per decision; 0 = no
+    ///                     limit (deterministic: full depth,
+    ///                     bounded by the node arena)
+    ///////////////////////////////////////////////////////////
+    explicit SearchController(double budgetSeconds = 0.001);
+
+    PaddleAction decide(const Match& match, Side side, float dt) override;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getReport() const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     This controller's search mode and statistics, e.g.
+    ///     "rated at full depth (no time budget); 2.1 M nodes/s, 1272
+    ///      nodes/decision, depth 10.0, 0 time cutoffs".
+    ///////////////////////////////////////////////////////////
+    std::string getReport() const override;
+
+    // Adds another SearchController's statistics (others are ignored)
+    void addStatistics(const PaddleController& other) override;
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: evaluate(const SimState& state, Side side,
+    ///                    const Arena& arena)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Heuristic value of a non-terminal leaf for 'side'.
+    ///////////////////////////////////////////////////////////
+    static float evaluate(const SimState& state, Side side, const Arena& arena);
+};
+
+#endif
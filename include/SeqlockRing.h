@@ -0,0 +1,129 @@
+#ifndef SEQLOCK_RING_H
+#define SEQLOCK_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////
+/// Class: SeqlockRing<T, CAPACITY>
+/// ----------------------------------------------------------
+/// Objective:
+///     Ring of the latest CAPACITY records from one writer,
+///     readable by any number of readers – in other threads
+///     or in other processes when the ring is placed in shared
+///     memory – without locks or system calls.
+///
+/// Description:
+///     Each slot is a seqlock: a sequence number that is odd
+///     while the writer is filling the slot, and the record
+///     stored as 32-bit atomic words. publish() never waits:
+///     it marks the slot odd, stores the words, marks it even
+///     and then advances 'published'. A reader copies the
+///     newest slot and accepts the copy only if the slot's
+///     sequence was even and unchanged across the copy;
+///     otherwise the writer got there first and it retries on
+///     the (newer) newest slot. The record words are relaxed
+///     atomics, so a torn read is a discarded copy, never a
+///     data race.
+///
+///     The ring only holds plain words and atomics, all
+///     lock-free and address-free, so it works in place in a
+///     zero-filled shared mapping: a zero-filled ring is an
+///     empty one. Keeping CAPACITY records rather than one
+///     lets a slow reader still find the record it was
+///     about to read while the writer moves on.
+///
+/// Used By:
+///     BotLink (states to the bot, commands back).
+///////////////////////////////////////////////////////////////
+template<typename T, std::size_t CAPACITY>
+class SeqlockRing {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "ring capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) % 4 == 0,
+                  "records must be trivially copyable 32-bit words");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                  std::atomic<std::uint64_t>::is_always_lock_free,
+                  "shared-memory rings need lock-free atomics");
+
+private:
+    static constexpr std::size_t WORDS = sizeof(T) / 4;
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint32_t> sequence;    // Odd while being written
+        std::atomic<std::uint32_t> words[WORDS];
+    };
+
+    alignas(64) std::atomic<std::uint64_t> published{0};   // Records ever published
+    Slot slots[CAPACITY];
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: publish(const T& record)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Stores a record as the newest (the single writer
+    ///     only); overwrites the oldest slot.
+    ///////////////////////////////////////////////////////////
+    void publish(const T& record) {
+        std::uint32_t words[WORDS];
+        std::memcpy(words, &record, sizeof(T));
+
+        std::uint64_t count = published.load(std::memory_order_relaxed);
+        Slot& slot = slots[count & (CAPACITY - 1)];
+        std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i)
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+
+        published.store(count + 1, std::memory_order_release);
+    }
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: readLatest(T& record) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Copies the newest record (any reader).
+    ///
+    /// Return:
+    ///     bool – false if nothing was ever published
+    ///////////////////////////////////////////////////////////
+    bool readLatest(T& record) const {
+        std::uint32_t words[WORDS];
+
+        for (;;) {
+            std::uint64_t count = published.load(std::memory_order_acquire);
+            if (count == 0)
+                return false;
+
+            const Slot& slot = slots[(count - 1) & (CAPACITY - 1)];
+            std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1u)
+                continue;
+
+            for (std::size_t i = 0; i < WORDS; ++i)
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&record, words, sizeof(T));
+                return true;
+            }
+        }
+    }
+
+    // Records published so far (changes when a new one is readable)
+    std::uint64_t getPublished() const {
+        return published.load(std::memory_order_acquire);
+    }
+};
+
+#endif
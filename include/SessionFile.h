@@ -0,0 +1,151 @@
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "GameTypes.h"
+#include "Match.h"
+#include "SimState.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: SavedSession
+/// ----------------------------------------------------------
+/// Objective:
+///     A match in progress as read back from the session file:
+///     enough to construct it again and continue it exactly
+///     (Match(mode, seed, arena) + Match::restore()).
+///////////////////////////////////////////////////////////////
+struct SavedSession {
+    GameMode mode;
+    std::uint64_t seed;
+    int arena;                   // ARENA_PRESETS index, -1 = custom
+    SimState rally;
+    MatchProgress progress;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SessionFile
+/// ----------------------------------------------------------
+/// Objective:
+///     Mirrors the match in progress into a small memory-mapped
+///     file, so a game killed by a crash or a power cut can be
+///     resumed where it stopped.
+///
+/// Description:
+///     The file holds two fixed 80-byte records (layout
+///     version SESSION_VERSION), each with a sequence number
+///     and a CRC-32. save() writes the next record into the
+///     older slot of the mapping: plain stores into the page
+///     cache, no system call. A torn write can therefore only
+///     hit one slot; the other still holds the previous frame.
+///
+///     Resuming is an mmap and a check of both slots (magic,
+///     version, size, CRC): the newest valid record is the
+///     session, used in place with no parsing.
+///
+///     The kernel writes the page back on its own; a flusher
+///     thread additionally msync()s it once a second while it
+///     changes, so a power cut loses at most about a second.
+///
+///     POSIX (mmap) only; elsewhere, or with an empty path, the
+///     object does nothing and load() finds no session.
+///
+/// Side Effects:
+///     - Creates/maps the session file.
+///     - Owns a background thread while the file is open
+///       (joined in the destructor after a last msync).
+///
+/// Used By:
+///     Game class (every frame of a match, and at start-up).
+///////////////////////////////////////////////////////////////
+class SessionFile {
+private:
+    int fd;                          // -1 if unavailable
+    unsigned char* map;              // Both slots, nullptr if unavailable
+    std::uint32_t sequence;          // Of the newest record (game thread)
+
+    // Flusher thread (stopping guarded by 'mutex')
+    std::atomic<std::uint32_t> written;  // Sequence of the newest complete record
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping;
+    std::thread flusher;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: SessionFile(const std::string& path)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Opens (creating it if needed) and maps the session
+    ///     file, and starts the flusher.
+    ///
+    /// Input:
+    ///     path – session file path ("" = no session file)
+    ///
+    /// Side Effects:
+    ///     - A file of the wrong size is reset to empty slots.
+    ///////////////////////////////////////////////////////////
+    explicit SessionFile(const std::string& path);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Destructor: ~SessionFile()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Stops the flusher, syncs and unmaps the file.
+    ///////////////////////////////////////////////////////////
+    ~SessionFile();
+
+    SessionFile(const SessionFile&) = delete;
+    SessionFile& operator=(const SessionFile&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: load(SavedSession& session)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Finds the match that was in progress.
+    ///
+    /// Return:
+    ///     bool – true if the newest valid record holds a match
+    ///            in progress (copied to 'session')
+    ///////////////////////////////////////////////////////////
+    bool load(SavedSession& session);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: save(const Match& match)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Mirrors the match in progress (once per frame).
+    ///
+    /// Approach:
+    ///     Fill an 80-byte record → CRC-32 → copy it into the
+    ///     older slot → publish its sequence to the flusher.
+    ///////////////////////////////////////////////////////////
+    void save(const Match& match);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: clear()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Records that no match is in progress (the match
+    ///     ended or was abandoned).
+    ///////////////////////////////////////////////////////////
+    void clear();
+
+    bool isOpen() const;
+
+private:
+    void write(const Match* match);
+    void flushLoop();
+};
+
+#endif
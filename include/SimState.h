@@ -0,0 +1,167 @@
+#ifndef SIM_STATE_H
+#define SIM_STATE_H
+
+#include <cstdint>
+#include "Arena.h"
+#include "GameTypes.h"
+#include "Match.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: SimState
+/// ----------------------------------------------------------
+/// Objective:
+///     The physical state of a rally as plain floats: ball
+///     position/velocity and both paddle heights.
+///
+/// Description:
+///     A Match keeps its entities in heap-allocated tables,
+///     so copying one allocates. SimState is 24 bytes of POD:
+///     it is copied by value thousands of times per frame by
+///     search-based controllers without touching the heap.
+///
+///     stepSimState() is the rally step of Match::step()
+///     (paddle movement, ball movement, wall bounce, paddle
+///     bounce, scoring test): Match runs this kernel on its
+///     own state, so a SimState advanced in lockstep with a
+///     Match stays bit-identical until a point is scored.
+///     Serving is not modelled: a scored point ends the
+///     simulated rally.
+///
+/// Used By:
+///     Match (every step), SearchController (forward
+///     simulation).
+///////////////////////////////////////////////////////////////
+struct SimState {
+    float ballX, ballY;          // Ball top-left corner
+    float ballVX, ballVY;        // Ball velocity (pixels/second)
+    float leftY, rightY;         // Paddle top edges
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: captureState(const Match& match)
+/// ----------------------------------------------------------
+/// Objective:
+///     Copies the current rally state out of a match.
+///////////////////////////////////////////////////////////////
+SimState captureState(const Match& match);
+
+///////////////////////////////////////////////////////////////
+/// Function: stepSimState(SimState& state,
+///                        const MatchInput& input, float dt)
+/// ----------------------------------------------------------
+/// Objective:
+///     Advances a SimState by one step with Match rules.
+///
+/// Description:
+///     Two forms of the same kernel:
+///       - stepSimState<A>(state, input, dt): compiled for the
+///         preset A, with its geometry folded into constants.
+///         Instantiated for every entry of ARENA_PRESETS (and
+///         only those); A defaults to CLASSIC_ARENA.
+///       - stepSimState(state, input, dt, arena): any arena,
+///         geometry read from 'arena' at run time.
+///     Both give bit-identical results for the same arena.
+///
+/// Input:
+///     state – state to advance (in place)
+///     input – action of each paddle
+///     dt    – time step in seconds
+///     arena – geometry (runtime form)
+///
+/// Return:
+///     unsigned – MatchEvent flags (WALL_BOUNCE, LEFT_HIT,
+///                RIGHT_HIT, LEFT_SCORED, RIGHT_SCORED)
+///////////////////////////////////////////////////////////////
+template <const Arena& A = CLASSIC_ARENA>
+unsigned stepSimState(SimState& state, const MatchInput& input, float dt);
+
+unsigned stepSimState(SimState& state, const MatchInput& input, float dt, const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Function: presetSimStep(const Arena& arena)
+/// ----------------------------------------------------------
+/// Objective:
+///     Picks the specialized kernel for an arena once, for
+///     callers that step the same arena many times (search).
+///
+/// Return:
+///     SimStepFunction – stepSimState<preset> if 'arena'
+///                       equals a preset, nullptr otherwise
+///                       (use the runtime form)
+///////////////////////////////////////////////////////////////
+typedef unsigned (*SimStepFunction)(SimState& state, const MatchInput& input, float dt);
+
+SimStepFunction presetSimStep(const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Function: paddleCenterY(const SimState& state, Side side,
+///                         const Arena& arena)
+/// ----------------------------------------------------------
+/// Objective:
+///     Vertical center of one paddle.
+///////////////////////////////////////////////////////////////
+float paddleCenterY(const SimState& state, Side side, const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Struct: SimMatch
+/// ----------------------------------------------------------
+/// Objective:
+///     A whole PLAYER_VS_PLAYER match as plain data: rally
+///     state, scores and serve counter (48 bytes, no heap).
+///
+/// Description:
+///     stepSimMatch() adds scoring, re-serving and the
+///     first-to-targetScore rule to stepSimState(), so a
+///     SimMatch stays bit-identical to a PLAYER_VS_PLAYER
+///     Match with the same seed, arena and inputs for the
+///     whole match. Servers keep thousands of them in one
+///     array.
+///
+///     Like stepSimState(), both functions come as templates
+///     on a preset (default CLASSIC_ARENA) and in a runtime
+///     form taking the arena.
+///
+/// Used By:
+///     GameServer (match pool), the golden check (lockstep
+///     against Match).
+///////////////////////////////////////////////////////////////
+struct SimMatch {
+    SimState state;
+    std::uint64_t seed;          // Match seed (serves)
+    std::uint64_t point;         // Serves so far (RNG counter)
+    std::uint32_t tick;          // Steps simulated so far
+    std::uint8_t leftScore;
+    std::uint8_t rightScore;
+    bool finished;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: startSimMatch(std::uint64_t seed)
+/// ----------------------------------------------------------
+/// Objective:
+///     A fresh PLAYER_VS_PLAYER match with its first serve,
+///     as Match(GameMode::PLAYER_VS_PLAYER, seed, arena)
+///     starts.
+///////////////////////////////////////////////////////////////
+template <const Arena& A = CLASSIC_ARENA>
+SimMatch startSimMatch(std::uint64_t seed);
+
+SimMatch startSimMatch(std::uint64_t seed, const Arena& arena);
+
+///////////////////////////////////////////////////////////////
+/// Function: stepSimMatch(SimMatch& match,
+///                        const MatchInput& input, float dt)
+/// ----------------------------------------------------------
+/// Objective:
+///     Match::step() for a SimMatch.
+///
+/// Return:
+///     unsigned – MatchEvent flags, including GAME_OVER;
+///                0 once the match is finished
+///////////////////////////////////////////////////////////////
+template <const Arena& A = CLASSIC_ARENA>
+unsigned stepSimMatch(SimMatch& match, const MatchInput& input, float dt);
+
+unsigned stepSimMatch(SimMatch& match, const MatchInput& input, float dt, const Arena& arena);
+
+#endif
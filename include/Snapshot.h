@@ -0,0 +1,168 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "GameTypes.h"
+#include "SimState.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: snapshot format
+/// ----------------------------------------------------------
+/// SNAPSHOT_HISTORY   – baselines a receiver keeps (ring
+///                      indexed by tick); a delta can only
+///                      refer to a snapshot less than this many
+///                      ticks old
+/// SNAPSHOT_TICK_RATE – ticks per second assumed when
+///                      predicting the ball from a baseline
+///                      (other rates still decode exactly,
+///                      they just compress worse)
+/// SNAPSHOT_MAX_BYTES – largest encoding (a delta changing
+///                      every field; a keyframe takes 16)
+///////////////////////////////////////////////////////////////
+const std::uint32_t SNAPSHOT_HISTORY = 32;
+const int SNAPSHOT_TICK_RATE = 60;
+const std::size_t SNAPSHOT_MAX_BYTES = 17;
+
+///////////////////////////////////////////////////////////////
+/// Struct: Snapshot
+/// ----------------------------------------------------------
+/// Objective:
+///     Match state as sent over the network: quantized to
+///     whole pixels (positions) and pixels/second (velocity).
+///
+/// Description:
+///     The fields hold the quantized values themselves, so a
+///     decoded snapshot compares equal to the one encoded.
+///     Positions are stored with SNAPSHOT_POSITION_BIAS added
+///     so a ball slightly outside the arena stays positive.
+///
+///     Field       Keyframe bits   Range
+///     ballX/Y     10              -192 .. 831 px
+///     ballVX/VY   12 (signed)     -2048 .. 2047 px/s
+///     leftY/Y     10              -192 .. 831 px
+///     actions     2 each          PaddleAction of the step
+///     scores      8 each          0 .. 255
+///     lives       3               0 .. 7
+///     gameState   2               GameState
+///////////////////////////////////////////////////////////////
+const int SNAPSHOT_POSITION_BIAS = 192;
+
+struct Snapshot {
+    std::uint32_t tick;
+    std::uint16_t ballX, ballY;      // Ball top-left corner + bias
+    std::int16_t ballVX, ballVY;     // Ball velocity (pixels/second)
+    std::uint16_t leftY, rightY;     // Paddle top edges + bias
+    std::uint8_t leftAction;         // PaddleAction that produced the state
+    std::uint8_t rightAction;
+    std::uint8_t leftScore;
+    std::uint8_t rightScore;
+    std::uint8_t lives;
+    std::uint8_t gameState;          // GameState
+};
+
+bool operator==(const Snapshot& a, const Snapshot& b);
+bool operator!=(const Snapshot& a, const Snapshot& b);
+
+///////////////////////////////////////////////////////////////
+/// Function: makeSnapshot(std::uint32_t tick,
+///                        const SimState& state,
+///                        const MatchInput& input,
+///                        int leftScore, int rightScore,
+///                        int lives, GameState gameState)
+/// ----------------------------------------------------------
+/// Objective:
+///     Quantizes a match state (values out of range are
+///     clamped). 'input' is the step's paddle actions: they
+///     let the receiver predict where the paddles go next.
+///////////////////////////////////////////////////////////////
+Snapshot makeSnapshot(std::uint32_t tick, const SimState& state, const MatchInput& input,
+                      int leftScore, int rightScore, int lives, GameState gameState);
+
+///////////////////////////////////////////////////////////////
+/// Function: snapshotState(const Snapshot& snapshot)
+/// ----------------------------------------------------------
+/// Objective:
+///     The rally state a snapshot describes, back in floats.
+///////////////////////////////////////////////////////////////
+SimState snapshotState(const Snapshot& snapshot);
+
+///////////////////////////////////////////////////////////////
+/// Class: SnapshotHistory
+/// ----------------------------------------------------------
+/// Objective:
+///     The last SNAPSHOT_HISTORY snapshots by tick: the
+///     baselines a delta may refer to.
+///
+/// Description:
+///     Slot = tick % SNAPSHOT_HISTORY. The sender keeps one
+///     of every snapshot it produced and deltas against the
+///     newest tick the receiver acknowledged; the receiver
+///     keeps one of every snapshot it decoded.
+///////////////////////////////////////////////////////////////
+class SnapshotHistory {
+private:
+    Snapshot slots[SNAPSHOT_HISTORY];
+    bool used[SNAPSHOT_HISTORY];
+
+public:
+    SnapshotHistory();
+
+    void clear();
+    void store(const Snapshot& snapshot);
+
+    // Snapshot of exactly this tick, or nullptr if not kept
+    const Snapshot* find(std::uint32_t tick) const;
+
+    // Whatever is in the slot of 'tick' (the decoder checks its tick)
+    const Snapshot* slot(std::uint32_t tick) const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: encodeSnapshot(const Snapshot& snapshot,
+///                          const Snapshot* baseline,
+///                          std::uint8_t* out)
+/// ----------------------------------------------------------
+/// Objective:
+///     Bit-packs a snapshot, as a delta against 'baseline'
+///     when one is given and at most SNAPSHOT_HISTORY - 1
+///     ticks older, as a keyframe otherwise.
+///
+/// Description:
+///     A delta names the baseline by its low tick bits and age,
+///     then codes each field as the difference from a
+///     prediction: the ball keeps moving at its baseline
+///     velocity, the paddles keep doing their baseline
+///     action, a velocity is unchanged or negated (a
+///     bounce), everything else stays put. Position errors
+///     use a prefix code (0 → 1 bit, ±2 → 4 bits, ±16 → 8
+///     bits, ±128 → 12 bits, else the full value), so an
+///     ordinary update of a rally takes 3 to 7 bytes.
+///
+/// Input:
+///     out – at least SNAPSHOT_MAX_BYTES bytes
+///
+/// Return:
+///     std::size_t – bytes written
+///////////////////////////////////////////////////////////////
+std::size_t encodeSnapshot(const Snapshot& snapshot, const Snapshot* baseline, std::uint8_t* out);
+
+///////////////////////////////////////////////////////////////
+/// Function: decodeSnapshot(const std::uint8_t* data,
+///                          std::size_t size,
+///                          const SnapshotHistory& history,
+///                          Snapshot& snapshot)
+/// ----------------------------------------------------------
+/// Objective:
+///     Decodes an encodeSnapshot() result, taking the
+///     baseline of a delta from 'history'.
+///
+/// Return:
+///     bool – false if the data is truncated, out of range or
+///            refers to a baseline not in 'history' (never
+///            received, or replaced by a tick 32 ticks newer)
+///////////////////////////////////////////////////////////////
+bool decodeSnapshot(const std::uint8_t* data, std::size_t size,
+                    const SnapshotHistory& history, Snapshot& snapshot);
+
+#endif
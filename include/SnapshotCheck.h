@@ -0,0 +1,29 @@
+#ifndef SNAPSHOT_CHECK_H
+#define SNAPSHOT_CHECK_H
+
+///////////////////////////////////////////////////////////////
+/// Function: runSnapshotCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the snapshot format check:
+///       --snapshot-check [--count N] [--seed S]
+///
+/// Description:
+///     - Fuzz: N random snapshot/baseline pairs (random fields,
+///       small perturbations and every baseline age) must
+///       decode to exactly the encoded snapshot; every
+///       truncated encoding and random garbage must be
+///       rejected or decoded without reading out of bounds.
+///     - Stream: headless PvP matches sent over a simulated
+///       link (latency, 5% loss, acknowledged baselines); every
+///       received snapshot must match the sent one. Prints the
+///       update size distribution.
+///     - Throughput: encoded and decoded snapshots per second.
+///
+/// Return:
+///     int – process exit code (0 = all round trips exact,
+///           1 = a mismatch or bad arguments)
+///////////////////////////////////////////////////////////////
+int runSnapshotCommand(int argc, char** argv);
+
+#endif
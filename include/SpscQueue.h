@@ -0,0 +1,83 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////
+/// Class: SpscQueue<T, CAPACITY>
+/// ----------------------------------------------------------
+/// Objective:
+///     Fixed-size queue between exactly one producer thread
+///     and one consumer thread, wait-free on both sides.
+///
+/// Description:
+///     A ring of CAPACITY slots (a power of two) with two free
+///     running indices: 'tail' is written only by the
+///     producer, 'head' only by the consumer. push() and pop()
+///     each do one relaxed load of their own index, one
+///     acquire load of the other side's index and one release
+///     store – no locks, no read-modify-write, no allocation,
+///     and a bounded number of steps whatever the other thread
+///     is doing. The indices live on separate cache lines so
+///     the two threads do not invalidate each other's line on
+///     every operation.
+///
+///     A full queue rejects the push (the caller decides what
+///     to drop) rather than waiting for the consumer.
+///
+/// Used By:
+///     AudioMixer (game thread → audio thread commands).
+///////////////////////////////////////////////////////////////
+template<typename T, std::size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "queue capacity must be a power of two");
+
+private:
+    T slots[CAPACITY];
+    alignas(64) std::atomic<std::size_t> head{0};   // Next slot to pop (consumer)
+    alignas(64) std::atomic<std::size_t> tail{0};   // Next slot to push (producer)
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: push(const T& item)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Appends an item (producer thread only).
+    ///
+    /// Return:
+    ///     bool – false if the queue was full (item dropped)
+    ///////////////////////////////////////////////////////////
+    bool push(const T& item) {
+        std::size_t back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) == CAPACITY)
+            return false;
+
+        slots[back & (CAPACITY - 1)] = item;
+        tail.store(back + 1, std::memory_order_release);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////
+    /// Function: pop(T& item)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Removes the oldest item (consumer thread only).
+    ///
+    /// Return:
+    ///     bool – false if the queue was empty
+    ///////////////////////////////////////////////////////////
+    bool pop(T& item) {
+        std::size_t front = head.load(std::memory_order_relaxed);
+        if (front == tail.load(std::memory_order_acquire))
+            return false;
+
+        item = slots[front & (CAPACITY - 1)];
+        head.store(front + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif
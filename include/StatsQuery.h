@@ -0,0 +1,62 @@
+#ifndef STATS_QUERY_H
+#define STATS_QUERY_H
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////
+/// Function: sumWhereEqual(const std::uint32_t* keys,
+///                         const std::uint32_t* values,
+///                         std::size_t count,
+///                         std::uint32_t key,
+///                         std::uint64_t& matches)
+/// ----------------------------------------------------------
+/// Objective:
+///     The scan kernel of stats queries: sums values[i] over
+///     the rows whose keys[i] equals 'key' and counts those
+///     rows.
+///
+/// Description:
+///     Uses AVX2 (eight rows per compare) when the CPU has
+///     it, scalar code otherwise; both give the same result.
+///     'values' may be nullptr to only count.
+///
+/// Return:
+///     std::uint64_t – the sum (matches receives the count)
+///////////////////////////////////////////////////////////////
+std::uint64_t sumWhereEqual(const std::uint32_t* keys, const std::uint32_t* values,
+                            std::size_t count, std::uint32_t key, std::uint64_t& matches);
+
+///////////////////////////////////////////////////////////////
+/// Function: runStatsCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the match stats tools:
+///       --stats-query METRIC [--by KEY] [--mode ai|pvp]
+///                     [--arena NAME] [--file BASE]
+///       --stats-generate N [--seed S] [--file BASE]
+///
+/// Description:
+///     The query aggregates every stored match (columnar
+///     segments and the journal tail): METRIC is one of
+///     matches, duration, points, rally, longest, hits,
+///     travel, score or zones; KEY groups the result by
+///     hour, weekday or day (UTC), mode or arena (default:
+///     all matches in one group). Only the columns the query
+///     needs are read, segments the filters exclude are
+///     skipped by their min/max, and the time taken and
+///     bytes read are printed.
+///
+///     Generate appends N synthetic matches (a month of
+///     play per ~10 000 matches) as full segments, to try
+///     queries on millions of rows.
+///
+///     BASE defaults to the game's store, "match_stats".
+///
+/// Return:
+///     int – process exit code (0 = success, 1 = bad
+///           arguments or an unreadable store)
+///////////////////////////////////////////////////////////////
+int runStatsCommand(int argc, char** argv);
+
+#endif
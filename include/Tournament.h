@@ -0,0 +1,213 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "PaddleController.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: TournamentConfig
+/// ----------------------------------------------------------
+/// Objective:
+///     Settings of a tournament run.
+///
+/// Fields:
+///     swiss          – Swiss bracket instead of round-robin
+///     entrants       – registered controller names
+///     rounds         – Swiss rounds (round-robin plays one)
+///     gamesPerPair   – matches per pairing (sides alternate)
+///     seed           – base seed; every match seed derives
+///                      from it and the match index
+///     threads        – worker threads (0 = all cores)
+///     maxMatchTicks  – step limit after which a match is drawn
+///     logPath        – optional CSV with one line per match
+///////////////////////////////////////////////////////////////
+struct TournamentConfig {
+    bool swiss = false;
+    std::vector<std::string> entrants;
+    int rounds = 5;
+    int gamesPerPair = 50;
+    std::uint64_t seed = 1;
+    unsigned threads = 0;
+    long maxMatchTicks = 60L * 60 * 5;
+    std::string logPath;
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: MatchResult
+/// ----------------------------------------------------------
+/// Objective:
+///     Outcome of one headless AI-vs-AI match.
+///////////////////////////////////////////////////////////////
+struct MatchResult {
+    int left;                    // Entrant index on the left
+    int right;                   // Entrant index on the right
+    std::uint64_t seed;          // Match seed (replays the match)
+    int leftScore;
+    int rightScore;
+    long ticks;                  // Steps simulated
+    int round;                   // Round the match belongs to
+};
+
+///////////////////////////////////////////////////////////////
+/// Struct: EntrantStanding
+/// ----------------------------------------------------------
+/// Objective:
+///     Ratings and record of one entrant.
+///////////////////////////////////////////////////////////////
+struct EntrantStanding {
+    std::string name;
+    double glicko;               // Glicko rating
+    double deviation;            // Glicko rating deviation (RD)
+    double elo;                  // Sequential Elo rating
+    int wins;
+    int draws;
+    int losses;
+    double points;               // Win = 1, draw = 0.5 (Swiss pairing)
+    std::string report;          // Statistics of its controllers in all matches
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: Tournament
+/// ----------------------------------------------------------
+/// Objective:
+///     Plays round-robin or Swiss brackets between registered
+///     paddle controllers as headless matches on all cores, and
+///     rates the entrants (Glicko with 95% intervals + Elo).
+///
+/// Description:
+///     Matches use PLAYER_VS_PLAYER rules (first to 10) with a
+///     controller on each side; sides alternate within a
+///     pairing. A match's seed is mixSeed(config.seed, index),
+///     so its result does not depend on thread scheduling and
+///     can be replayed alone with playMatch(). Controllers are
+///     created reproducible (the search AI searches to full
+///     depth instead of stopping on a time budget), so results
+///     do not depend on machine speed or load either.
+///
+///     The statistics of the controllers that played each
+///     match are added up per entrant and become its report.
+///
+///     Each round is one Glicko rating period; Elo is updated
+///     match by match in index order after the round.
+///
+/// Used By:
+///     main() for "pong --tournament" and "pong --match".
+///////////////////////////////////////////////////////////////
+class Tournament {
+private:
+    TournamentConfig config;
+    std::vector<EntrantStanding> standings;
+    std::vector<MatchResult> results;
+    double elapsedSeconds;       // Wall time spent simulating
+    long long totalTicks;        // Steps simulated in all matches
+    unsigned threadsUsed;
+    std::vector<std::unique_ptr<PaddleController>> tallies;  // Per entrant: statistics of all its matches
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: Tournament(const TournamentConfig& config)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Prepares standings for the configured entrants.
+    ///////////////////////////////////////////////////////////
+    explicit Tournament(const TournamentConfig& config);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: run()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Plays every round and updates the ratings.
+    ///
+    /// Side Effects:
+    ///     - Uses config.threads worker threads.
+    ///     - Writes config.logPath if set.
+    ///////////////////////////////////////////////////////////
+    void run();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: printReport(std::ostream& out) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Prints the rating table and throughput.
+    ///////////////////////////////////////////////////////////
+    void printReport(std::ostream& out) const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: playMatch(left, right, seed, maxTicks, log,
+    ///                     leftTally, rightTally)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Plays one seeded AI-vs-AI match headlessly, with
+    ///     reproducible controllers.
+    ///
+    /// Input:
+    ///     left, right – controller names
+    ///     seed        – match seed
+    ///     maxTicks    – step limit (draw when reached)
+    ///     log         – optional stream for a point-by-point
+    ///                   log (replay output)
+    ///     leftTally,  – optional controllers of the same kind
+    ///     rightTally    that receive the players' statistics
+    ///                   (addStatistics()) after the match
+    ///
+    /// Return:
+    ///     MatchResult – final score and length
+    ///////////////////////////////////////////////////////////
+    static MatchResult playMatch(const std::string& left, const std::string& right,
+                                 std::uint64_t seed, long maxTicks,
+                                 std::ostream* log = nullptr,
+                                 PaddleController* leftTally = nullptr,
+                                 PaddleController* rightTally = nullptr);
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: makePairings(int round)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Entrant pairs for a round: all pairs (round-robin),
+    ///     or neighbours by points avoiding rematches (Swiss).
+    ///////////////////////////////////////////////////////////
+    std::vector<std::pair<int, int>> makePairings(int round) const;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: playRound(const std::vector<MatchResult>& slots)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Plays the given matches in parallel, filling scores
+    ///     and adding the players' statistics to the tallies.
+    ///////////////////////////////////////////////////////////
+    void playRound(std::vector<MatchResult>& slots);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: rateRound(const std::vector<MatchResult>& round)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Applies one Glicko rating period and the Elo updates.
+    ///////////////////////////////////////////////////////////
+    void rateRound(const std::vector<MatchResult>& round);
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: runTournamentCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line front end for "--tournament", "--match"
+///     and "--list-controllers".
+///
+/// Return:
+///     int – process exit code
+///////////////////////////////////////////////////////////////
+int runTournamentCommand(int argc, char** argv);
+
+#endif
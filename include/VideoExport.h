@@ -0,0 +1,143 @@
+#ifndef VIDEO_EXPORT_H
+#define VIDEO_EXPORT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ParticleSystem.h"
+#include "SdfFont.h"
+
+///////////////////////////////////////////////////////////////
+/// Class: SoftwareCanvas
+/// ----------------------------------------------------------
+/// Objective:
+///     An RGB frame drawn on the CPU with the primitives the
+///     game draws with, so frames can be produced without a
+///     window or graphics context.
+///
+/// Description:
+///     Draws what Game::render() submits to SFML: solid
+///     triangles (EntityRenderer batches), particle squares
+///     and SDF text quads, thresholded as the font's shader
+///     does. Coordinates go through a mapping from a source
+///     rectangle (a view: the field or the 640x600 UI) to a
+///     pixel rectangle, as an sf::View with a viewport.
+///
+///     Rasterization follows OpenGL's rules: a pixel is
+///     covered when its center is inside a triangle, with
+///     the top-left rule on shared edges, so adjacent
+///     triangles never overlap or leave gaps. Colours are
+///     blended by their alpha, like SFML's default blending.
+///
+/// Side Effects:
+///     - Allocates the frame (3 bytes per pixel) once.
+///
+/// Used By:
+///     runVideoCommand (one canvas per worker thread),
+///     benchmarks.
+///////////////////////////////////////////////////////////////
+class SoftwareCanvas {
+private:
+    unsigned width;
+    unsigned height;
+    std::vector<std::uint8_t> rgb;
+
+    // Mapping of the current view: pixel = offset + point * scale
+    sf::Vector2f scale;
+    sf::Vector2f offset;
+
+public:
+    SoftwareCanvas(unsigned width, unsigned height);
+
+    void clear(sf::Color color);
+
+    // Draw 'source' (view coordinates) onto 'pixels' (frame pixels)
+    void setMapping(const sf::FloatRect& source, const sf::FloatRect& pixels);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: fillTriangles(const sf::Vertex* vertices,
+    ///                         std::size_t count)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Draws sf::Triangles geometry, each triangle in the
+    ///     colour of its first vertex (the game never shades).
+    ///////////////////////////////////////////////////////////
+    void fillTriangles(const sf::Vertex* vertices, std::size_t count);
+
+    // Draws particles as ParticleSystem::draw() does
+    void fillParticles(const ParticleSprite* sprites, std::size_t count);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: drawText(const SdfText& text,
+    ///                    const SdfFont& font)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Draws a laid-out text from the font's distance
+    ///     atlas (loaded with or without upload).
+    ///
+    /// Approach:
+    ///     Per pixel: bilinear distance at the interpolated
+    ///     texture coordinate → smoothstep around 0.5 over
+    ///     about one pixel, as the SDF shader.
+    ///////////////////////////////////////////////////////////
+    void drawText(const SdfText& text, const SdfFont& font);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: toYuv420(std::uint8_t* out) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Converts the frame to planar YUV 4:2:0 (BT.601,
+    ///     video range): width x height luma bytes, then two
+    ///     quarter-size chroma planes. Width and height must
+    ///     be even.
+    ///////////////////////////////////////////////////////////
+    void toYuv420(std::uint8_t* out) const;
+
+    unsigned getWidth() const;
+    unsigned getHeight() const;
+    const std::uint8_t* getPixels() const;   // RGB, row by row
+
+private:
+    template <bool Textured>
+    void rasterize(const sf::Vertex* vertices, std::size_t count, const sf::Transform& transform,
+                   const SdfFont* font);
+    void blend(std::uint8_t* pixel, sf::Color color, unsigned alpha);
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: runVideoCommand(int argc, char** argv)
+/// ----------------------------------------------------------
+/// Objective:
+///     Command-line entry point of the video exporter:
+///       --render-video LEFT RIGHT SEED OUT.y4m
+///                      [--fps N] [--scale S] [--threads N]
+///
+/// Description:
+///     Replays the AI match "--match LEFT RIGHT SEED" plays
+///     (the match --render-audio sonifies) and writes it as a
+///     raw Y4M video, frame for frame what Game::render()
+///     shows during that match: field, particles and score.
+///     Needs no display and no encoder.
+///
+///     The match is simulated once, on one thread, recording
+///     each frame's state (rally, score and live particles).
+///     The frames are then rasterized on every core in any
+///     order and written in sequence through a small reorder
+///     window, so memory stays bounded whatever the length.
+///
+///     --fps keeps every (60 / N)-th frame (N divides 60);
+///     --scale resizes the 640x600 window (even sizes). A
+///     CRC of the frames is printed so renders with different
+///     thread counts can be compared.
+///
+/// Return:
+///     int – process exit code (0 = success, 1 = bad
+///           arguments or a write error)
+///////////////////////////////////////////////////////////////
+int runVideoCommand(int argc, char** argv);
+
+#endif
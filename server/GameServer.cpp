@@ -0,0 +1,1115 @@
+#include "GameServer.h"
+#include "PaddleController.h"
+#include "SimState.h"
+#include "Snapshot.h"
+#include "SpectatorHub.h"
+#include "UdpIo.h"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <unordered_map>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    // Spectator match id: shard << MATCH_SLOT_BITS | slot
+    const unsigned MATCH_SLOT_BITS = 24;
+    const std::uint32_t MATCH_SLOT_MASK = (1u << MATCH_SLOT_BITS) - 1;
+
+    // Missed ticks simulated in one go after a stall (more are skipped)
+    const std::uint64_t MAX_CATCH_UP_STEPS = 4;
+
+    // Final state of a finished match is resent this long before the slot is freed
+    const double LINGER_SECONDS = 1.0;
+
+    // Upper bound on the epoll wait so stop() is noticed
+    const int EPOLL_TIMEOUT_MS = 100;
+
+    // recvmmsg batches handled per wakeup before the tick gets a chance to run
+    const int MAX_RECEIVE_BATCHES = 32;
+
+    // Shard pools get twice an even share: address hashing is not perfectly even
+    const std::size_t POOL_SLACK_FACTOR = 2;
+    const std::size_t POOL_SLACK_SLOTS  = 64;
+
+    enum class SlotStatus : std::uint8_t {
+        FREE,
+        WAITING,                 // One player, waiting for an opponent
+        PLAYING,
+        ENDED                    // Final state being resent (LINGER_SECONDS)
+    };
+
+    /*
+        Identity of a JOIN: sender address and the client's own id.
+    */
+    struct JoinKey {
+        std::uint32_t ip;
+        std::uint16_t port;
+        std::uint32_t clientId;
+
+        bool operator==(const JoinKey& other) const {
+            return ip == other.ip && port == other.port && clientId == other.clientId;
+        }
+    };
+
+    struct JoinKeyHash {
+        std::size_t operator()(const JoinKey& key) const {
+            return static_cast<std::size_t>(mixSeed(std::uint64_t(key.ip) << 16 | key.port, key.clientId));
+        }
+    };
+
+    struct ServerPlayer {
+        sockaddr_in address;     // Latest sender address (follows NAT rebinding)
+        JoinKey joinKey;
+        std::uint32_t key;       // Secret sent in WELCOME, required in INPUT/LEAVE
+        std::uint32_t lastSequence;
+        std::uint32_t stateAck;  // Newest snapshot tick the client decoded
+        std::uint32_t lastSeen;  // Shard tick of the last packet
+        PaddleAction action;     // Held until the next INPUT
+        bool joined;
+        bool present;            // Not left / timed out
+    };
+
+    /*
+        One entry of a shard's match pool.
+    */
+    struct MatchSlot {
+        SimMatch match;
+        MatchInput lastInput;    // Actions of the latest step (snapshots)
+        ServerPlayer players[2];
+        std::uint32_t endTick;
+        SlotStatus status;
+        bool abandoned;
+    };
+
+    /*
+        Spectator keyframe of a slot: the baseline of its frames' deltas.
+    */
+    struct SpectatorKey {
+        Snapshot keyframe;
+        std::uint32_t feed;      // Hub feed it was sent to (0 = none yet)
+    };
+
+    bool isNewer(std::uint32_t sequence, std::uint32_t last) {
+        return static_cast<std::int32_t>(sequence - last) > 0;
+    }
+
+    std::uint32_t sessionOf(std::uint32_t slot, Side side) {
+        return slot << 1 | (side == Side::LEFT ? 0u : 1u);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////
+/// Class: ServerShard
+/// ----------------------------------------------------------
+/// Objective:
+///     One thread's share of the server: socket, tick timer,
+///     epoll loop and match pool (see GameServer).
+///
+/// Description:
+///     Only the shard thread touches the pool. Statistics are
+///     published to atomics once per tick for getStats().
+///////////////////////////////////////////////////////////////
+class ServerShard {
+private:
+    GameServer& server;
+    unsigned index;
+    int socketFd;
+    int timerFd;
+    int epollFd;
+
+    std::vector<MatchSlot> slots;            // The match pool (contiguous)
+    std::vector<SnapshotHistory> histories;  // Snapshots sent, per slot (kept apart: cold)
+    std::vector<SpectatorKey> spectatorKeys; // Per slot, as cold
+    std::vector<std::atomic<std::uint32_t>> watched;   // Per slot: hub feed number, 0 = unwatched
+    std::vector<std::uint32_t> freeSlots;    // Stack of free slot indices
+    std::uint32_t highWater;                 // Slots at or above are free
+    std::uint32_t waitingSlot;               // Match waiting for a second player
+    std::uint32_t featuredSlot;              // Oldest running match (spectators)
+    std::unordered_map<JoinKey, std::uint32_t, JoinKeyHash> joins;   // → session
+
+    SendBatch sender;
+    ReceiveBatch receiver;
+    std::shared_ptr<FrameBlock> frames;      // Spectator frames of the current tick
+    std::uint64_t publishNanos;
+
+    std::uint64_t matchCounter;
+    std::uint64_t keySeed;
+    std::uint64_t keyCounter;
+    std::uint32_t now;                       // Ticks run by this shard
+    std::uint32_t timeoutTicks;
+    std::uint32_t lingerTicks;
+    float dt;
+    Clock::duration period;
+
+    // Shard-local counters
+    std::uint64_t ticks;
+    std::uint64_t overruns;
+    std::uint64_t tickNanos;
+    std::uint64_t tickMaxNanos;
+    std::uint32_t liveSlots;
+    std::uint32_t players;
+
+    // Published once per tick
+    std::atomic<std::uint64_t> sharedTicks;
+    std::atomic<std::uint64_t> sharedOverruns;
+    std::atomic<std::uint64_t> sharedTickNanos;
+    std::atomic<std::uint64_t> sharedTickMaxNanos;
+    std::atomic<std::uint64_t> sharedPacketsIn;
+    std::atomic<std::uint64_t> sharedPacketsOut;
+    std::atomic<std::uint64_t> sharedDropped;
+    std::atomic<std::uint64_t> sharedBytesIn;
+    std::atomic<std::uint64_t> sharedBytesOut;
+    std::atomic<std::uint32_t> sharedMatches;
+    std::atomic<std::uint32_t> sharedPlayers;
+    std::atomic<std::uint32_t> sharedFeatured;
+
+public:
+    ServerShard(GameServer& server, unsigned index, std::size_t capacity);
+    ~ServerShard();
+
+    bool open(std::string& error);
+    void run();
+    void addStats(StatsMessage& total, std::uint64_t& totalTickNanos) const;
+    bool watch(std::uint32_t slot, std::uint32_t feed);
+    std::uint32_t getFeatured() const;
+
+private:
+    void receiveAll();
+    void handleDatagram(const std::uint8_t* data, std::size_t size, const sockaddr_in& from);
+    void handleJoin(const JoinMessage& message, const sockaddr_in& from);
+    void handleInput(const InputMessage& message, const sockaddr_in& from);
+    void handleLeave(const LeaveMessage& message);
+    ServerPlayer* findPlayer(std::uint32_t session, std::uint32_t key);
+
+    void tick(std::uint64_t expirations);
+    std::uint32_t allocateSlot();
+    void freeSlot(std::uint32_t slot);
+    void endMatch(std::uint32_t slot, bool abandoned);
+    void dropPlayer(ServerPlayer& player);
+
+    void sendWelcome(std::uint32_t session, const sockaddr_in& to);
+    std::uint8_t stateFlags(const MatchSlot& entry) const;
+    void sendState(std::uint32_t slot, Side side, const Snapshot& snapshot, std::uint8_t flags);
+    void addFrame(std::uint32_t slot, std::uint32_t feed, const Snapshot& snapshot, std::uint8_t flags);
+    void publish();
+};
+
+
+/*
+    Constructor: ServerShard::ServerShard(GameServer& server, unsigned index, std::size_t capacity)
+
+    Objective:
+        Allocate the match pool of one shard.
+
+    Input Parameters:
+        - GameServer& server: Owner (configuration, global match count).
+        - unsigned index: Shard number (seeds).
+        - std::size_t capacity: Pool slots.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Allocates capacity slots up front; open() creates the descriptors.
+*/
+ServerShard::ServerShard(GameServer& server, unsigned index, std::size_t capacity)
+    : server(server),
+      index(index),
+      socketFd(-1),
+      timerFd(-1),
+      epollFd(-1),
+      slots(capacity),
+      histories(capacity),
+      spectatorKeys(capacity),
+      watched(capacity),
+      highWater(0),
+      waitingSlot(NO_SLOT),
+      featuredSlot(NO_SLOT),
+      publishNanos(0),
+      matchCounter(0),
+      keySeed(0),
+      keyCounter(0),
+      now(0),
+      ticks(0),
+      overruns(0),
+      tickNanos(0),
+      tickMaxNanos(0),
+      liveSlots(0),
+      players(0),
+      sharedTicks(0),
+      sharedOverruns(0),
+      sharedTickNanos(0),
+      sharedTickMaxNanos(0),
+      sharedPacketsIn(0),
+      sharedPacketsOut(0),
+      sharedDropped(0),
+      sharedBytesIn(0),
+      sharedBytesOut(0),
+      sharedMatches(0),
+      sharedPlayers(0),
+      sharedFeatured(NO_SLOT)
+{
+    const ServerConfig& config = server.config;
+
+    // Pop order: lowest slot first, keeping the live part of the pool dense
+    freeSlots.reserve(capacity);
+    for (std::size_t i = capacity; i > 0; --i)
+        freeSlots.push_back(static_cast<std::uint32_t>(i - 1));
+    joins.reserve(capacity * 2);
+
+    std::random_device entropy;
+    keySeed = std::uint64_t(entropy()) << 32 | entropy();
+
+    dt = 1.f / config.tickRate;
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000LL / config.tickRate));
+    timeoutTicks = static_cast<std::uint32_t>(config.idleTimeout * config.tickRate);
+    lingerTicks = static_cast<std::uint32_t>(LINGER_SECONDS * config.tickRate);
+}
+
+ServerShard::~ServerShard() {
+    if (epollFd >= 0) ::close(epollFd);
+    if (timerFd >= 0) ::close(timerFd);
+    if (socketFd >= 0) ::close(socketFd);
+}
+
+
+/*
+    Function: bool ServerShard::open(std::string& error)
+
+    Objective:
+        Create the shard's socket, tick timer and epoll set.
+
+    Input Parameters:
+        - std::string& error: Set on failure.
+
+    Return Value:
+        - bool: true on success.
+
+    Side Effects:
+        - Creates descriptors (closed by the destructor).
+
+    Approach:
+        - SO_REUSEPORT socket on the server's host and port.
+        - Periodic CLOCK_MONOTONIC timerfd at the tick rate; its
+          expiration count tells how many ticks are due.
+*/
+bool ServerShard::open(std::string& error) {
+    socketFd = openUdpSocket(server.config.host, server.config.port, true, error);
+    if (socketFd < 0)
+        return false;
+    sender.setSocket(socketFd);
+
+    timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    itimerspec spec;
+    long periodNanos = 1000000000L / server.config.tickRate;
+    spec.it_interval.tv_sec = periodNanos / 1000000000L;
+    spec.it_interval.tv_nsec = periodNanos % 1000000000L;
+    spec.it_value = spec.it_interval;
+    if (timerFd < 0 || ::timerfd_settime(timerFd, 0, &spec, nullptr) != 0) {
+        error = std::string("timerfd: ") + std::strerror(errno);
+        return false;
+    }
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    std::memset(&event, 0, sizeof event);
+    event.events = EPOLLIN;
+    event.data.fd = socketFd;
+    bool ok = epollFd >= 0 && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event) == 0;
+    event.data.fd = timerFd;
+    ok = ok && ::epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event) == 0;
+    if (!ok) {
+        error = std::string("epoll: ") + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+
+/*
+    Function: void ServerShard::run()
+
+    Objective:
+        The shard's event loop.
+
+    Side Effects:
+        - Runs until the server is stopping.
+
+    Approach:
+        - Wait for the socket and/or the timer; drain the socket first so
+          the tick applies the freshest inputs, then run the due ticks.
+*/
+void ServerShard::run() {
+    epoll_event events[2];
+
+    while (!server.stopping.load(std::memory_order_relaxed)) {
+        int ready = ::epoll_wait(epollFd, events, 2, EPOLL_TIMEOUT_MS);
+        bool timerDue = false;
+
+        for (int i = 0; i < ready; ++i) {
+            if (events[i].data.fd == socketFd)
+                receiveAll();
+            else
+                timerDue = true;
+        }
+
+        if (timerDue) {
+            std::uint64_t expirations = 0;
+            if (::read(timerFd, &expirations, sizeof expirations) == sizeof expirations && expirations > 0)
+                tick(expirations);
+        }
+    }
+}
+
+
+/*
+    Function: void ServerShard::receiveAll()
+
+    Objective:
+        Handle the datagrams waiting on the socket.
+
+    Approach:
+        - recvmmsg batches until the socket is empty, at most
+          MAX_RECEIVE_BATCHES per wakeup (epoll reports the rest again).
+*/
+void ServerShard::receiveAll() {
+    for (int batch = 0; batch < MAX_RECEIVE_BATCHES; ++batch) {
+        std::size_t count = receiver.receive(socketFd);
+        if (count == 0)
+            break;
+        for (std::size_t i = 0; i < count; ++i)
+            handleDatagram(receiver.datagram(i), receiver.size(i), receiver.sender(i));
+    }
+    sender.flush();
+}
+
+
+/*
+    Function: void ServerShard::handleDatagram(const std::uint8_t* data, std::size_t size,
+                                               const sockaddr_in& from)
+
+    Objective:
+        Dispatch one client message; malformed datagrams are ignored.
+*/
+void ServerShard::handleDatagram(const std::uint8_t* data, std::size_t size, const sockaddr_in& from) {
+    switch (messageType(data, size)) {
+    case MessageType::JOIN: {
+        JoinMessage message;
+        if (decodeMessage(data, size, message))
+            handleJoin(message, from);
+        break;
+    }
+    case MessageType::INPUT: {
+        InputMessage message;
+        if (decodeMessage(data, size, message))
+            handleInput(message, from);
+        break;
+    }
+    case MessageType::LEAVE: {
+        LeaveMessage message;
+        if (decodeMessage(data, size, message))
+            handleLeave(message);
+        break;
+    }
+    case MessageType::STATS_REQUEST: {
+        // Only full-size requests: the reply is never larger than the request
+        if (decodeStatsRequest(data, size)) {
+            std::size_t length = encodeMessage(server.getStats(), sender.buffer());
+            sender.push(from, length);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+
+/*
+    Function: void ServerShard::handleJoin(const JoinMessage& message, const sockaddr_in& from)
+
+    Objective:
+        Seat a client in a match.
+
+    Input Parameters:
+        - const JoinMessage& message: The request.
+        - const sockaddr_in& from: Sender.
+
+    Side Effects:
+        - May allocate a slot; sends WELCOME or FULL.
+
+    Approach:
+        - A repeated JOIN (lost WELCOME) gets the same WELCOME again.
+        - Otherwise take the right side of the waiting match, which then
+          starts, or open a new waiting match on the left side.
+*/
+void ServerShard::handleJoin(const JoinMessage& message, const sockaddr_in& from) {
+    JoinKey joinKey = { from.sin_addr.s_addr, from.sin_port, message.clientId };
+
+    auto existing = joins.find(joinKey);
+    if (existing != joins.end()) {
+        sendWelcome(existing->second, from);
+        return;
+    }
+
+    std::uint32_t slot;
+    Side side;
+    if (waitingSlot != NO_SLOT) {
+        slot = waitingSlot;
+        side = Side::RIGHT;
+        waitingSlot = NO_SLOT;
+        slots[slot].status = SlotStatus::PLAYING;
+    }
+    else {
+        slot = allocateSlot();
+        if (slot == NO_SLOT) {
+            FullMessage full = { message.clientId };
+            sender.push(from, encodeMessage(full, sender.buffer()));
+            return;
+        }
+        side = Side::LEFT;
+        waitingSlot = slot;
+    }
+
+    ServerPlayer& player = slots[slot].players[side == Side::LEFT ? 0 : 1];
+    player.address = from;
+    player.joinKey = joinKey;
+    player.key = static_cast<std::uint32_t>(mixSeed(keySeed, keyCounter++));
+    player.lastSequence = 0;
+    player.stateAck = NO_STATE_ACK;
+    player.lastSeen = now;
+    player.action = PaddleAction::STAY;
+    player.joined = true;
+    player.present = true;
+    players++;
+
+    std::uint32_t session = sessionOf(slot, side);
+    joins.emplace(joinKey, session);
+    sendWelcome(session, from);
+}
+
+
+/*
+    Function: void ServerShard::handleInput(const InputMessage& message, const sockaddr_in& from)
+
+    Objective:
+        Record a player's latest action.
+
+    Side Effects:
+        - Updates the player's action, snapshot acknowledgement, address
+          and last-seen tick.
+
+    Approach:
+        - Sequence numbers older than the last one applied are stale
+          (reordered) and only count as a sign of life.
+*/
+void ServerShard::handleInput(const InputMessage& message, const sockaddr_in& from) {
+    ServerPlayer* player = findPlayer(message.session, message.key);
+    if (!player)
+        return;
+
+    player->address = from;
+    player->lastSeen = now;
+    if (isNewer(message.sequence, player->lastSequence)) {
+        player->lastSequence = message.sequence;
+        player->action = message.action;
+        player->stateAck = message.stateAck;
+    }
+}
+
+
+/*
+    Function: void ServerShard::handleLeave(const LeaveMessage& message)
+
+    Objective:
+        A player quits: a waiting match is closed, a running one ends
+        as abandoned (the opponent gets the final state).
+*/
+void ServerShard::handleLeave(const LeaveMessage& message) {
+    ServerPlayer* player = findPlayer(message.session, message.key);
+    if (!player)
+        return;
+
+    std::uint32_t slot = message.session >> 1;
+    dropPlayer(*player);
+    if (slots[slot].status == SlotStatus::WAITING)
+        freeSlot(slot);
+    else if (slots[slot].status == SlotStatus::PLAYING)
+        endMatch(slot, true);
+}
+
+
+/*
+    Function: ServerPlayer* ServerShard::findPlayer(std::uint32_t session, std::uint32_t key)
+
+    Objective:
+        Validate a session and key.
+
+    Return Value:
+        - ServerPlayer*: The player, nullptr if the session is unknown, the
+          key wrong or the player already gone.
+*/
+ServerPlayer* ServerShard::findPlayer(std::uint32_t session, std::uint32_t key) {
+    std::uint32_t slot = session >> 1;
+    if (slot >= slots.size() || slots[slot].status == SlotStatus::FREE)
+        return nullptr;
+
+    ServerPlayer& player = slots[slot].players[session & 1];
+    if (!player.joined || !player.present || player.key != key)
+        return nullptr;
+    return &player;
+}
+
+
+/*
+    Function: void ServerShard::tick(std::uint64_t expirations)
+
+    Objective:
+        Run the due simulation steps and send every player the state.
+
+    Input Parameters:
+        - std::uint64_t expirations: Timer periods elapsed since the last
+          tick (more than 1 means the loop fell behind).
+
+    Side Effects:
+        - Steps matches, ends/frees slots, sends STATE datagrams, updates
+          the statistics.
+
+    Approach:
+        - Catch up at most MAX_CATCH_UP_STEPS steps.
+        - One pass over the live part of the pool: time out silent players,
+          free lingering finished matches, queue STATE for present players
+          and a spectator frame for watched matches.
+        - Then update the featured match and hand the frames to the hub.
+        - The tick overruns if it started late or took longer than a period.
+*/
+void ServerShard::tick(std::uint64_t expirations) {
+    Clock::time_point start = Clock::now();
+    std::uint64_t steps = std::min(expirations, MAX_CATCH_UP_STEPS);
+
+    // ---------- Simulation ----------
+    for (std::uint64_t step = 0; step < steps; ++step) {
+        now++;
+        for (std::uint32_t slot = 0; slot < highWater; ++slot) {
+            MatchSlot& entry = slots[slot];
+            if (entry.status != SlotStatus::PLAYING)
+                continue;
+            entry.lastInput = { entry.players[0].action, entry.players[1].action };
+            if (stepSimMatch(entry.match, entry.lastInput, dt) & MatchEvent::GAME_OVER)
+                endMatch(slot, false);
+        }
+    }
+
+    // ---------- Timeouts and state updates ----------
+    std::uint32_t firstPlaying = NO_SLOT;
+    for (std::uint32_t slot = 0; slot < highWater; ++slot) {
+        MatchSlot& entry = slots[slot];
+        if (entry.status == SlotStatus::FREE)
+            continue;
+
+        if (entry.status == SlotStatus::ENDED && now - entry.endTick >= lingerTicks) {
+            freeSlot(slot);
+            continue;
+        }
+
+        bool lost = false;
+        for (ServerPlayer& player : entry.players) {
+            if (player.present && now - player.lastSeen > timeoutTicks) {
+                dropPlayer(player);
+                lost = true;
+            }
+        }
+        if (lost && entry.status == SlotStatus::WAITING) {
+            freeSlot(slot);
+            continue;
+        }
+        if (lost && entry.status == SlotStatus::PLAYING)
+            endMatch(slot, true);
+
+        // A function of match and lastInput, which only change with the tick,
+        // so a stored tick never changes under a client's baseline
+        const SimMatch& match = entry.match;
+        Snapshot snapshot = makeSnapshot(match.tick, match.state, entry.lastInput, match.leftScore,
+                                         match.rightScore, 0, match.finished ? GameState::GAME_OVER : GameState::PLAYING);
+        histories[slot].store(snapshot);
+
+        std::uint8_t flags = stateFlags(entry);
+        if (entry.players[0].present)
+            sendState(slot, Side::LEFT, snapshot, flags);
+        if (entry.players[1].present)
+            sendState(slot, Side::RIGHT, snapshot, flags);
+
+        std::uint32_t feed = watched[slot].load(std::memory_order_relaxed);
+        if (feed != 0)
+            addFrame(slot, feed, snapshot, flags);
+        if (entry.status == SlotStatus::PLAYING && firstPlaying == NO_SLOT)
+            firstPlaying = slot;
+    }
+    sender.flush();
+
+    // ---------- Spectators ----------
+    // The featured match changes before the final frame of the old one
+    // reaches the hub, which then moves its ANY_MATCH subscribers on
+    if (featuredSlot == NO_SLOT || slots[featuredSlot].status != SlotStatus::PLAYING) {
+        featuredSlot = firstPlaying;
+        sharedFeatured.store(featuredSlot, std::memory_order_relaxed);
+    }
+    if (frames) {
+        server.hub->publish(std::move(frames));
+        frames.reset();
+    }
+
+    while (highWater > 0 && slots[highWater - 1].status == SlotStatus::FREE)
+        highWater--;
+
+    // ---------- Statistics ----------
+    Clock::duration elapsed = Clock::now() - start;
+    std::uint64_t nanos = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    ticks++;
+    tickNanos += nanos;
+    tickMaxNanos = std::max(tickMaxNanos, nanos);
+    if (expirations > 1 || elapsed > period)
+        overruns++;
+    publish();
+}
+
+
+/*
+    Function: std::uint32_t ServerShard::allocateSlot()
+
+    Objective:
+        Take a free slot for a new (waiting) match.
+
+    Return Value:
+        - std::uint32_t: Slot index, NO_SLOT if the shard pool is full or
+          the server already hosts maxMatches matches.
+
+    Side Effects:
+        - Starts a fresh SimMatch with a new seed in the slot.
+*/
+std::uint32_t ServerShard::allocateSlot() {
+    if (freeSlots.empty())
+        return NO_SLOT;
+    if (server.liveMatches.fetch_add(1, std::memory_order_relaxed) >= server.config.maxMatches) {
+        server.liveMatches.fetch_sub(1, std::memory_order_relaxed);
+        return NO_SLOT;
+    }
+
+    std::uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    MatchSlot& entry = slots[slot];
+    entry = MatchSlot();
+    entry.match = startSimMatch(mixSeed(server.config.seed, std::uint64_t(index) << 40 | matchCounter++));
+    entry.lastInput = { PaddleAction::STAY, PaddleAction::STAY };
+    histories[slot].clear();
+    spectatorKeys[slot].feed = 0;
+    entry.status = SlotStatus::WAITING;
+
+    highWater = std::max(highWater, slot + 1);
+    liveSlots++;
+    return slot;
+}
+
+
+/*
+    Function: void ServerShard::freeSlot(std::uint32_t slot)
+
+    Objective:
+        Return a slot to the pool and forget its players' joins.
+*/
+void ServerShard::freeSlot(std::uint32_t slot) {
+    MatchSlot& entry = slots[slot];
+    for (ServerPlayer& player : entry.players) {
+        if (player.joined)
+            joins.erase(player.joinKey);
+        if (player.present)
+            dropPlayer(player);
+    }
+
+    if (waitingSlot == slot)
+        waitingSlot = NO_SLOT;
+    entry.status = SlotStatus::FREE;
+    freeSlots.push_back(slot);
+    liveSlots--;
+    server.liveMatches.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+/*
+    Function: void ServerShard::endMatch(std::uint32_t slot, bool abandoned)
+
+    Objective:
+        Stop simulating a match; its final state is resent for
+        LINGER_SECONDS so it reaches the players despite packet loss.
+*/
+void ServerShard::endMatch(std::uint32_t slot, bool abandoned) {
+    MatchSlot& entry = slots[slot];
+    entry.status = SlotStatus::ENDED;
+    entry.endTick = now;
+    entry.abandoned = abandoned;
+}
+
+
+void ServerShard::dropPlayer(ServerPlayer& player) {
+    player.present = false;
+    players--;
+}
+
+
+/*
+    Function: void ServerShard::sendWelcome(std::uint32_t session, const sockaddr_in& to)
+
+    Objective:
+        Tell a client its session, key and side.
+*/
+void ServerShard::sendWelcome(std::uint32_t session, const sockaddr_in& to) {
+    const ServerPlayer& player = slots[session >> 1].players[session & 1];
+
+    WelcomeMessage welcome;
+    welcome.clientId = player.joinKey.clientId;
+    welcome.session = session;
+    welcome.key = player.key;
+    welcome.side = (session & 1) ? Side::RIGHT : Side::LEFT;
+    sender.push(to, encodeMessage(welcome, sender.buffer()));
+}
+
+
+/*
+    Function: std::uint8_t ServerShard::stateFlags(const MatchSlot& entry) const
+
+    Objective:
+        StateFlag bits describing a slot's match.
+*/
+std::uint8_t ServerShard::stateFlags(const MatchSlot& entry) const {
+    std::uint8_t flags = 0;
+    if (entry.status == SlotStatus::WAITING)
+        flags |= StateFlag::WAITING;
+    if (entry.status == SlotStatus::ENDED)
+        flags |= StateFlag::FINISHED;
+    if (entry.abandoned)
+        flags |= StateFlag::ABANDONED;
+    return flags;
+}
+
+
+/*
+    Function: void ServerShard::sendState(std::uint32_t slot, Side side,
+                                          const Snapshot& snapshot, std::uint8_t flags)
+
+    Objective:
+        Queue the current match state for one player, delta-coded against
+        the snapshot the player acknowledged (a keyframe if it is no
+        longer in the history).
+*/
+void ServerShard::sendState(std::uint32_t slot, Side side, const Snapshot& snapshot, std::uint8_t flags) {
+    const ServerPlayer& player = slots[slot].players[side == Side::LEFT ? 0 : 1];
+    const Snapshot* baseline = player.stateAck == NO_STATE_ACK ? nullptr : histories[slot].find(player.stateAck);
+
+    StateMessage state;
+    state.session = sessionOf(slot, side);
+    state.inputAck = player.lastSequence;
+    state.snapshotSize = static_cast<std::uint8_t>(encodeSnapshot(snapshot, baseline, state.snapshot));
+    state.flags = flags;
+
+    sender.push(player.address, encodeMessage(state, sender.buffer()));
+}
+
+
+/*
+    Function: void ServerShard::addFrame(std::uint32_t slot, std::uint32_t feed,
+                                         const Snapshot& snapshot, std::uint8_t flags)
+
+    Objective:
+        Serialize a watched match's spectator frame into this tick's
+        FrameBlock (created by the first frame of the tick).
+
+    Input Parameters:
+        - std::uint32_t slot: The match.
+        - std::uint32_t feed: The hub's feed number for it.
+        - const Snapshot& snapshot: Its state this tick.
+        - std::uint8_t flags: StateFlag bits.
+
+    Approach:
+        - A keyframe for a new feed or match and every
+          SPECTATOR_KEYFRAME_TICKS match ticks; otherwise a delta against
+          the last keyframe, so any frame after a keyframe decodes on its
+          own (spectators need no acknowledgements, and every spectator
+          can share the same bytes).
+        - The TCP length prefix is written in front of the message.
+*/
+void ServerShard::addFrame(std::uint32_t slot, std::uint32_t feed, const Snapshot& snapshot, std::uint8_t flags) {
+    if (!frames) {
+        frames = std::make_shared<FrameBlock>();
+        publishNanos = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    SpectatorKey& key = spectatorKeys[slot];
+    bool keyframe = key.feed != feed || snapshot.tick - key.keyframe.tick >= SPECTATOR_KEYFRAME_TICKS;
+    if (keyframe) {
+        key.keyframe = snapshot;
+        key.feed = feed;
+    }
+
+    FrameMessage message;
+    message.matchId = std::uint32_t(index) << MATCH_SLOT_BITS | slot;
+    message.publishNanos = publishNanos;
+    message.flags = flags;
+    message.snapshotSize = static_cast<std::uint8_t>(encodeSnapshot(snapshot, keyframe ? nullptr : &key.keyframe,
+                                                                    message.snapshot));
+
+    std::vector<std::uint8_t>& bytes = frames->bytes;
+    std::size_t offset = bytes.size();
+    bytes.resize(offset + SPECTATOR_FRAME_BYTES);
+    std::size_t size = encodeMessage(message, &bytes[offset + STREAM_PREFIX_BYTES]);
+    bytes[offset] = static_cast<std::uint8_t>(size);
+    bytes[offset + 1] = static_cast<std::uint8_t>(size >> 8);
+    bytes.resize(offset + STREAM_PREFIX_BYTES + size);
+
+    SpectatorFrame frame;
+    frame.matchId = message.matchId;
+    frame.offset = static_cast<std::uint32_t>(offset);
+    frame.size = static_cast<std::uint16_t>(STREAM_PREFIX_BYTES + size);
+    frame.keyframe = keyframe;
+    frame.finished = (flags & StateFlag::FINISHED) != 0;
+    frames->frames.push_back(frame);
+}
+
+
+/*
+    Function: void ServerShard::publish()
+
+    Objective:
+        Copy the shard-local counters to the atomics read by getStats().
+*/
+void ServerShard::publish() {
+    sharedTicks.store(ticks, std::memory_order_relaxed);
+    sharedOverruns.store(overruns, std::memory_order_relaxed);
+    sharedTickNanos.store(tickNanos, std::memory_order_relaxed);
+    sharedTickMaxNanos.store(tickMaxNanos, std::memory_order_relaxed);
+    sharedPacketsIn.store(receiver.getPackets(), std::memory_order_relaxed);
+    sharedPacketsOut.store(sender.getPackets(), std::memory_order_relaxed);
+    sharedDropped.store(sender.getDropped(), std::memory_order_relaxed);
+    sharedBytesIn.store(receiver.getBytes(), std::memory_order_relaxed);
+    sharedBytesOut.store(sender.getBytes(), std::memory_order_relaxed);
+    sharedMatches.store(liveSlots, std::memory_order_relaxed);
+    sharedPlayers.store(players, std::memory_order_relaxed);
+}
+
+
+/*
+    Function: void ServerShard::addStats(StatsMessage& total, std::uint64_t& totalTickNanos) const
+
+    Objective:
+        Add this shard's published counters to a total (any thread).
+        tickMaxMicros becomes a maximum; the tick time is summed into
+        totalTickNanos (the caller computes the mean).
+*/
+void ServerShard::addStats(StatsMessage& total, std::uint64_t& totalTickNanos) const {
+    total.ticks += sharedTicks.load(std::memory_order_relaxed);
+    total.overruns += sharedOverruns.load(std::memory_order_relaxed);
+    total.tickMaxMicros = std::max<std::uint32_t>(total.tickMaxMicros,
+        static_cast<std::uint32_t>(sharedTickMaxNanos.load(std::memory_order_relaxed) / 1000));
+    total.matches += sharedMatches.load(std::memory_order_relaxed);
+    total.players += sharedPlayers.load(std::memory_order_relaxed);
+    total.packetsIn += sharedPacketsIn.load(std::memory_order_relaxed);
+    total.packetsOut += sharedPacketsOut.load(std::memory_order_relaxed);
+    total.packetsDropped += sharedDropped.load(std::memory_order_relaxed);
+    total.bytesIn += sharedBytesIn.load(std::memory_order_relaxed);
+    total.bytesOut += sharedBytesOut.load(std::memory_order_relaxed);
+    totalTickNanos += sharedTickNanos.load(std::memory_order_relaxed);
+}
+
+
+/*
+    Functions: ServerShard::watch / ServerShard::getFeatured
+
+    Objective:
+        The spectator hub's view of the shard (hub thread): mark a slot
+        watched, and read the featured slot.
+*/
+bool ServerShard::watch(std::uint32_t slot, std::uint32_t feed) {
+    if (slot >= slots.size())
+        return false;
+    watched[slot].store(feed, std::memory_order_relaxed);
+    return true;
+}
+
+std::uint32_t ServerShard::getFeatured() const {
+    return sharedFeatured.load(std::memory_order_relaxed);
+}
+
+
+/*
+    Constructor: GameServer::GameServer(const ServerConfig& config)
+
+    Objective:
+        Store the configuration.
+*/
+GameServer::GameServer(const ServerConfig& config)
+    : config(config),
+      stopping(false),
+      liveMatches(0)
+{
+}
+
+GameServer::~GameServer() {
+    stop();
+}
+
+
+/*
+    Function: bool GameServer::start()
+
+    Objective:
+        Open every shard, then start their threads.
+
+    Return Value:
+        - bool: false (nothing started) if any shard fails to open.
+
+    Side Effects:
+        - Allocates the pools; binds config.port (and the spectator port);
+          starts one thread per shard and one for the spectator hub.
+
+    Approach:
+        - Each shard's pool holds twice an even share of maxMatches (+64),
+          capped at maxMatches; the global limit is enforced separately.
+*/
+bool GameServer::start() {
+    unsigned count = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (count == 0)
+        count = 1;
+    if (config.tickRate <= 0) {
+        error = "tick rate must be positive";
+        return false;
+    }
+
+    std::size_t capacity = std::min(config.maxMatches,
+                                    config.maxMatches / count * POOL_SLACK_FACTOR + POOL_SLACK_SLOTS);
+
+    for (unsigned i = 0; i < count; ++i) {
+        shards.emplace_back(new ServerShard(*this, i, capacity));
+        if (!shards.back()->open(error)) {
+            shards.clear();
+            return false;
+        }
+    }
+
+    if (config.spectatorPort != 0) {
+        hub.reset(new SpectatorHub(*this, config.spectatorHost, config.spectatorPort,
+                                  config.maxSpectators, config.idleTimeout));
+        if (!hub->open(error)) {
+            hub.reset();
+            shards.clear();
+            return false;
+        }
+    }
+
+    stopping = false;
+    for (std::unique_ptr<ServerShard>& shard : shards)
+        threads.emplace_back(&ServerShard::run, shard.get());
+    if (hub)
+        threads.emplace_back(&SpectatorHub::run, hub.get());
+    return true;
+}
+
+
+/*
+    Function: void GameServer::stop()
+
+    Objective:
+        Stop the shards and release their resources.
+*/
+void GameServer::stop() {
+    stopping = true;
+    for (std::thread& thread : threads)
+        thread.join();
+    threads.clear();
+    shards.clear();
+    hub.reset();
+}
+
+
+/*
+    Function: StatsMessage GameServer::getStats() const
+
+    Objective:
+        Server-wide statistics.
+
+    Return Value:
+        - StatsMessage: Sums over shards; tick time mean over all ticks of
+          all shards, maximum over all of them; spectator counters of the
+          hub; CPU time of the whole process.
+*/
+StatsMessage GameServer::getStats() const {
+    StatsMessage total = StatsMessage();
+    std::uint64_t tickNanos = 0;
+    for (const std::unique_ptr<ServerShard>& shard : shards)
+        shard->addStats(total, tickNanos);
+    if (total.ticks > 0)
+        total.tickMeanMicros = static_cast<std::uint32_t>(tickNanos / total.ticks / 1000);
+    if (hub)
+        hub->addStats(total);
+
+    timespec cpu;
+    if (::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu) == 0)
+        total.cpuMicros = std::uint64_t(cpu.tv_sec) * 1000000 + std::uint64_t(cpu.tv_nsec) / 1000;
+    return total;
+}
+
+
+/*
+    Function: bool GameServer::watchMatch(std::uint32_t matchId, std::uint32_t feed)
+
+    Objective:
+        Forward a spectator hub request to the match's shard.
+*/
+bool GameServer::watchMatch(std::uint32_t matchId, std::uint32_t feed) {
+    std::uint32_t shard = matchId >> MATCH_SLOT_BITS;
+    if (matchId == SpectatorHub::NO_MATCH || shard >= shards.size())
+        return false;
+    return shards[shard]->watch(matchId & MATCH_SLOT_MASK, feed);
+}
+
+
+/*
+    Function: std::uint32_t GameServer::featuredMatch(unsigned& cursor) const
+
+    Objective:
+        Pick a featured match for an ANY_MATCH spectator, round robin over
+        the shards.
+*/
+std::uint32_t GameServer::featuredMatch(unsigned& cursor) const {
+    std::size_t count = shards.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t shard = (cursor + i) % count;
+        std::uint32_t slot = shards[shard]->getFeatured();
+        if (slot != NO_SLOT) {
+            cursor = static_cast<unsigned>(shard + 1);
+            return std::uint32_t(shard) << MATCH_SLOT_BITS | slot;
+        }
+    }
+    return SpectatorHub::NO_MATCH;
+}
+
+const ServerConfig& GameServer::getConfig() const {
+    return config;
+}
+
+unsigned GameServer::getShardCount() const {
+    return static_cast<unsigned>(shards.size());
+}
+
+const std::string& GameServer::getError() const {
+    return error;
+}
@@ -0,0 +1,185 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetProtocol.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: ServerConfig
+/// ----------------------------------------------------------
+/// Objective:
+///     Settings of a pong-server run.
+///
+/// Fields:
+///     host        – IPv4 address to listen on (loopback by
+///                   default; ANY_HOST for every interface)
+///     port        – UDP port
+///     threads     – shards (one thread + socket each; 0 =
+///                   all cores)
+///     maxMatches  – concurrent matches (waiting or playing)
+///     tickRate    – simulation steps per second
+///     seed        – base seed; match seeds derive from it
+///     idleTimeout – seconds without a packet before a player
+///                   is dropped (the match ends, abandoned);
+///                   also the spectator keep-alive and slow
+///                   consumer limit
+///     spectatorHost – IPv4 address of the spectator feed
+///                   (loopback by default: local spectators)
+///     spectatorPort – UDP and TCP port of the spectator feed
+///                   (0 = no spectators)
+///     maxSpectators – concurrent spectator subscriptions
+///////////////////////////////////////////////////////////////
+struct ServerConfig {
+    std::string host = DEFAULT_SERVER_HOST;
+    std::uint16_t port = DEFAULT_SERVER_PORT;
+    unsigned threads = 0;
+    std::size_t maxMatches = 10000;
+    int tickRate = SERVER_TICK_RATE;
+    std::uint64_t seed = 1;
+    double idleTimeout = 5.0;
+    std::string spectatorHost = DEFAULT_SERVER_HOST;
+    std::uint16_t spectatorPort = DEFAULT_SPECTATOR_PORT;
+    std::size_t maxSpectators = 10000;
+};
+
+class ServerShard;
+class SpectatorHub;
+
+///////////////////////////////////////////////////////////////
+/// Class: GameServer
+/// ----------------------------------------------------------
+/// Objective:
+///     Authoritative headless server for PLAYER_VS_PLAYER
+///     matches between network clients.
+///
+/// Description:
+///     The server is split into shards, one per thread. Each
+///     shard owns a UDP socket bound to the shared port with
+///     SO_REUSEPORT (the kernel keeps a client on the socket
+///     its address hashes to), a timerfd for the fixed tick
+///     and an epoll loop over both. A shard's matches live in
+///     one contiguous array of SimMatch-based slots, so no
+///     state is shared between shards and nothing is locked
+///     on the hot path.
+///
+///     Per tick a shard applies the latest input of every
+///     player, steps its matches with the rules of Match
+///     (stepSimMatch) and sends each player the new state as
+///     a snapshot delta against the last one the player
+///     acknowledged (kept in a SnapshotHistory per match,
+///     beside the pool), batching datagrams with
+///     recvmmsg/sendmmsg. A tick
+///     whose work exceeds the period, or that starts late
+///     (missed timer expirations, which are then caught up),
+///     counts as an overrun.
+///
+///     Players are paired in join order within a shard.
+///
+///     Spectators are served by a SpectatorHub thread: a
+///     match is named shard << 24 | slot, and a shard
+///     serializes frames only for the matches the hub marks
+///     as watched (see SpectatorHub). Each shard features its
+///     oldest running match for ANY_MATCH subscribers.
+///
+/// Used By:
+///     pong-server (server/main.cpp).
+///////////////////////////////////////////////////////////////
+class GameServer {
+private:
+    friend class ServerShard;
+    friend class SpectatorHub;
+
+    ServerConfig config;
+    std::vector<std::unique_ptr<ServerShard>> shards;
+    std::unique_ptr<SpectatorHub> hub;       // Null without a spectator port
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping;
+    std::atomic<std::size_t> liveMatches;    // Pool slots in use, all shards
+    std::string error;
+
+public:
+
+    ///////////////////////////////////////////////////////////
+    /// Constructor: GameServer(const ServerConfig& config)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Stores the configuration; start() opens sockets.
+    ///////////////////////////////////////////////////////////
+    explicit GameServer(const ServerConfig& config);
+
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: start()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Allocates the match pools, opens one socket per
+    ///     shard and starts the shard threads.
+    ///
+    /// Return:
+    ///     bool – false if a socket or timer could not be set
+    ///            up (see getError())
+    ///////////////////////////////////////////////////////////
+    bool start();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: stop()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Stops and joins the shard threads (within ~100 ms).
+    ///////////////////////////////////////////////////////////
+    void stop();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: getStats()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Totals over all shards (thread-safe, approximate
+    ///     while running: shards publish once per tick).
+    ///////////////////////////////////////////////////////////
+    StatsMessage getStats() const;
+
+    const ServerConfig& getConfig() const;
+    unsigned getShardCount() const;
+    const std::string& getError() const;
+
+private:
+
+    ///////////////////////////////////////////////////////////
+    /// Function: watchMatch(std::uint32_t matchId,
+    ///                      std::uint32_t feed)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Tells a shard to produce spectator frames for a
+    ///     match (feed = the hub's non-zero feed number; a new
+    ///     number starts with a keyframe) or to stop (0).
+    ///
+    /// Return:
+    ///     bool – false if no shard has such a slot
+    ///////////////////////////////////////////////////////////
+    bool watchMatch(std::uint32_t matchId, std::uint32_t feed);
+
+    ///////////////////////////////////////////////////////////
+    /// Function: featuredMatch(unsigned& cursor) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     The featured match of the first shard from 'cursor'
+    ///     on that has one (the cursor moves past it), or
+    ///     SpectatorHub::NO_MATCH.
+    ///////////////////////////////////////////////////////////
+    std::uint32_t featuredMatch(unsigned& cursor) const;
+};
+
+#endif
@@ -0,0 +1,531 @@
+#include "LoadBot.h"
+#include "UdpIo.h"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    // clientId = generation << CLIENT_INDEX_BITS | index within the thread
+    const unsigned CLIENT_INDEX_BITS = 20;
+    const std::uint32_t CLIENT_INDEX_MASK = (1u << CLIENT_INDEX_BITS) - 1;
+
+    // Ticks between JOIN retransmissions, and after a FULL reply
+    const int JOIN_RETRY_TICKS = 30;
+    const int FULL_RETRY_TICKS = 60;
+
+    // A state arriving later than this many tick periods after the previous one is late
+    const double LATE_PERIODS = 1.5;
+
+    const int EPOLL_TIMEOUT_MS = 100;
+
+    // The paddle follows the ball (the baseline chase AI)
+    PaddleAction chase(const SimState& state, Side side) {
+        float ballCenterY = state.ballY + CLASSIC_ARENA.ballSize / 2.f;
+        float center = paddleCenterY(state, side, CLASSIC_ARENA);
+        if (ballCenterY > center)
+            return PaddleAction::DOWN;
+        if (ballCenterY < center)
+            return PaddleAction::UP;
+        return PaddleAction::STAY;
+    }
+
+    struct BotClient {
+        std::uint32_t clientId;
+        std::uint32_t session;
+        std::uint32_t key;
+        std::uint32_t sequence;
+        std::uint32_t lastTick;          // Match tick of the newest state
+        Clock::time_point lastArrival;
+        SimState state;
+        SnapshotHistory snapshots;       // Baselines of the server's deltas
+        Side side;
+        bool playing;
+        bool haveState;
+        int joinCooldown;
+    };
+
+    /*
+        Counters of one bot thread over the measured window.
+    */
+    struct BotCounters {
+        std::uint64_t statesReceived = 0;
+        std::uint64_t statesLost = 0;
+        std::uint64_t statesLate = 0;
+        std::uint64_t matchesFinished = 0;
+        std::uint64_t fullReplies = 0;
+        std::uint64_t overruns = 0;
+    };
+
+    /*
+        One bot thread: its sockets, its clients (client c uses socket
+        c % sockets) and an epoll loop with a tick timer.
+    */
+    class BotThread {
+    private:
+        const BotConfig& config;
+        const sockaddr_in server;
+        const std::atomic<bool>& measuring;
+        const std::atomic<bool>& stopping;
+
+        std::vector<int> sockets;
+        std::vector<SendBatch> senders;
+        std::vector<std::unordered_map<std::uint32_t, std::uint32_t>> sessions;  // session → client
+        std::vector<BotClient> clients;
+        ReceiveBatch receiver;
+        int timerFd;
+        int epollFd;
+        Clock::duration period;
+
+        bool counting;
+        std::uint64_t bytesInAtStart;
+        std::uint64_t bytesOutAtStart;
+
+    public:
+        BotCounters counters;
+        std::uint64_t bytesIn;
+        std::uint64_t bytesOut;
+
+        BotThread(const BotConfig& config, const sockaddr_in& server, std::size_t clientCount,
+                  unsigned socketCount, const std::atomic<bool>& measuring, const std::atomic<bool>& stopping)
+            : config(config),
+              server(server),
+              measuring(measuring),
+              stopping(stopping),
+              sockets(socketCount, -1),
+              senders(socketCount),
+              sessions(socketCount),
+              clients(clientCount),
+              timerFd(-1),
+              epollFd(-1),
+              period(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000LL / config.tickRate))),
+              counting(false),
+              bytesInAtStart(0),
+              bytesOutAtStart(0),
+              bytesIn(0),
+              bytesOut(0)
+        {
+            for (std::size_t c = 0; c < clients.size(); ++c) {
+                BotClient& client = clients[c];
+                client = BotClient();
+                client.clientId = static_cast<std::uint32_t>(c);
+                // Spread the first JOINs over one retry period
+                client.joinCooldown = static_cast<int>(c % JOIN_RETRY_TICKS);
+            }
+        }
+
+        ~BotThread() {
+            for (int fd : sockets)
+                if (fd >= 0) ::close(fd);
+            if (timerFd >= 0) ::close(timerFd);
+            if (epollFd >= 0) ::close(epollFd);
+        }
+
+        bool open(std::string& error) {
+            epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (epollFd < 0 || timerFd < 0) {
+                error = std::string("epoll/timerfd: ") + std::strerror(errno);
+                return false;
+            }
+
+            long periodNanos = 1000000000L / config.tickRate;
+            itimerspec spec;
+            spec.it_interval.tv_sec = periodNanos / 1000000000L;
+            spec.it_interval.tv_nsec = periodNanos % 1000000000L;
+            spec.it_value = spec.it_interval;
+            ::timerfd_settime(timerFd, 0, &spec, nullptr);
+
+            epoll_event event;
+            std::memset(&event, 0, sizeof event);
+            event.events = EPOLLIN;
+            event.data.u32 = static_cast<std::uint32_t>(sockets.size());   // The timer
+            ::epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+
+            for (std::size_t s = 0; s < sockets.size(); ++s) {
+                sockets[s] = openUdpSocket(ANY_HOST, 0, false, error);
+                if (sockets[s] < 0)
+                    return false;
+                senders[s].setSocket(sockets[s]);
+                event.data.u32 = static_cast<std::uint32_t>(s);
+                ::epoll_ctl(epollFd, EPOLL_CTL_ADD, sockets[s], &event);
+            }
+            return true;
+        }
+
+        /*
+            Event loop; on stop, every playing client sends LEAVE.
+        */
+        void run() {
+            epoll_event events[64];
+            while (!stopping.load(std::memory_order_relaxed)) {
+                int ready = ::epoll_wait(epollFd, events, 64, EPOLL_TIMEOUT_MS);
+                bool timerDue = false;
+                for (int i = 0; i < ready; ++i) {
+                    if (events[i].data.u32 == sockets.size())
+                        timerDue = true;
+                    else
+                        receive(events[i].data.u32);
+                }
+
+                if (timerDue) {
+                    std::uint64_t expirations = 0;
+                    if (::read(timerFd, &expirations, sizeof expirations) == sizeof expirations && expirations > 0)
+                        tick(expirations);
+                }
+            }
+
+            for (std::size_t c = 0; c < clients.size(); ++c) {
+                if (!clients[c].playing)
+                    continue;
+                std::size_t s = c % sockets.size();
+                LeaveMessage leave = { clients[c].session, clients[c].key };
+                senders[s].push(server, encodeMessage(leave, senders[s].buffer()));
+            }
+            for (SendBatch& sender : senders)
+                sender.flush();
+            updateBytes();
+        }
+
+        std::size_t countPlaying() const {
+            std::size_t playing = 0;
+            for (const BotClient& client : clients)
+                playing += client.playing ? 1 : 0;
+            return playing;
+        }
+
+    private:
+        std::uint64_t totalBytesOut() const {
+            std::uint64_t total = 0;
+            for (const SendBatch& sender : senders)
+                total += sender.getBytes();
+            return total;
+        }
+
+        void updateBytes() {
+            if (!counting)
+                return;
+            bytesIn = receiver.getBytes() - bytesInAtStart;
+            bytesOut = totalBytesOut() - bytesOutAtStart;
+        }
+
+        /*
+            One tick: JOIN (with retries) or INPUT for every client.
+        */
+        void tick(std::uint64_t expirations) {
+            if (!counting && measuring.load(std::memory_order_relaxed)) {
+                counting = true;
+                bytesInAtStart = receiver.getBytes();
+                bytesOutAtStart = totalBytesOut();
+            }
+            if (counting && expirations > 1)
+                counters.overruns++;
+
+            for (std::size_t c = 0; c < clients.size(); ++c) {
+                BotClient& client = clients[c];
+                SendBatch& sender = senders[c % sockets.size()];
+
+                if (client.playing) {
+                    InputMessage input;
+                    input.session = client.session;
+                    input.key = client.key;
+                    input.sequence = ++client.sequence;
+                    input.stateAck = client.haveState ? client.lastTick : NO_STATE_ACK;
+                    input.action = client.haveState ? chase(client.state, client.side) : PaddleAction::STAY;
+                    sender.push(server, encodeMessage(input, sender.buffer()));
+                }
+                else if (client.joinCooldown-- <= 0) {
+                    JoinMessage join = { client.clientId };
+                    sender.push(server, encodeMessage(join, sender.buffer()));
+                    client.joinCooldown = JOIN_RETRY_TICKS;
+                }
+            }
+            for (SendBatch& sender : senders)
+                sender.flush();
+            updateBytes();
+        }
+
+        void receive(std::size_t s) {
+            std::size_t count;
+            while ((count = receiver.receive(sockets[s])) > 0) {
+                Clock::time_point now = Clock::now();
+                for (std::size_t i = 0; i < count; ++i)
+                    handle(s, receiver.datagram(i), receiver.size(i), now);
+            }
+        }
+
+        void handle(std::size_t s, const std::uint8_t* data, std::size_t size, Clock::time_point now) {
+            switch (messageType(data, size)) {
+            case MessageType::WELCOME: {
+                WelcomeMessage welcome;
+                if (!decodeMessage(data, size, welcome))
+                    break;
+                std::uint32_t index = welcome.clientId & CLIENT_INDEX_MASK;
+                if (index >= clients.size() || clients[index].clientId != welcome.clientId || clients[index].playing)
+                    break;
+                BotClient& client = clients[index];
+                client.playing = true;
+                client.haveState = false;
+                client.snapshots.clear();
+                client.session = welcome.session;
+                client.key = welcome.key;
+                client.side = welcome.side;
+                client.sequence = 0;
+                sessions[s][welcome.session] = index;
+                break;
+            }
+            case MessageType::FULL: {
+                FullMessage full;
+                if (!decodeMessage(data, size, full))
+                    break;
+                std::uint32_t index = full.clientId & CLIENT_INDEX_MASK;
+                if (index < clients.size() && clients[index].clientId == full.clientId) {
+                    clients[index].joinCooldown = FULL_RETRY_TICKS;
+                    if (counting)
+                        counters.fullReplies++;
+                }
+                break;
+            }
+            case MessageType::STATE: {
+                StateMessage state;
+                if (!decodeMessage(data, size, state))
+                    break;
+                auto found = sessions[s].find(state.session);
+                if (found == sessions[s].end())
+                    break;
+                handleState(s, found->second, state, now);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        /*
+            Track gaps and arrival times; rejoin after the final state.
+        */
+        void handleState(std::size_t s, std::uint32_t index, const StateMessage& message, Clock::time_point now) {
+            BotClient& client = clients[index];
+            Snapshot snapshot;
+            if (!decodeSnapshot(message.snapshot, message.snapshotSize, client.snapshots, snapshot))
+                return;
+            if (client.haveState && snapshot.tick < client.lastTick)
+                return;                                  // Reordered: older than what we have
+            client.snapshots.store(snapshot);
+
+            if (counting) {
+                counters.statesReceived++;
+                if (client.haveState) {
+                    if (snapshot.tick > client.lastTick + 1)
+                        counters.statesLost += snapshot.tick - client.lastTick - 1;
+                    if (now - client.lastArrival > period * LATE_PERIODS)
+                        counters.statesLate++;
+                }
+            }
+
+            client.haveState = true;
+            client.lastTick = snapshot.tick;
+            client.lastArrival = now;
+            client.state = snapshotState(snapshot);
+
+            if (message.flags & StateFlag::FINISHED) {
+                if (counting)
+                    counters.matchesFinished++;
+                sessions[s].erase(message.session);
+                client.playing = false;
+                client.haveState = false;
+                client.joinCooldown = 0;
+                std::uint32_t generation = (client.clientId >> CLIENT_INDEX_BITS) + 1;
+                client.clientId = generation << CLIENT_INDEX_BITS | index;
+            }
+        }
+    };
+}
+
+
+/*
+    Constructor: LoadBot::LoadBot(const BotConfig& config)
+
+    Objective:
+        Store the configuration.
+*/
+LoadBot::LoadBot(const BotConfig& config)
+    : config(config),
+      threadsUsed(0),
+      statesReceived(0),
+      statesLost(0),
+      statesLate(0),
+      matchesFinished(0),
+      fullReplies(0),
+      bytesIn(0),
+      bytesOut(0),
+      botOverruns(0),
+      clientsPlaying(0),
+      haveServerStats(false),
+      serverBefore(),
+      serverAfter()
+{
+}
+
+
+/*
+    Function: bool LoadBot::run()
+
+    Objective:
+        Run the load test.
+
+    Return Value:
+        - bool: false if it could not start.
+
+    Side Effects:
+        - Starts config.threads threads; network traffic.
+
+    Approach:
+        - Split clients and sockets evenly over the threads.
+        - Sleep through the warm-up, take server statistics, switch the
+          threads to counting, sleep through the measured window, take
+          server statistics again, stop the threads (clients LEAVE).
+*/
+bool LoadBot::run() {
+    sockaddr_in server;
+    if (!parseAddress(config.host, config.port, server)) {
+        error = "invalid IPv4 address '" + config.host + "'";
+        return false;
+    }
+    if (config.clients == 0 || config.clients > (std::size_t(1) << CLIENT_INDEX_BITS) || config.tickRate <= 0) {
+        error = "invalid client count or tick rate";
+        return false;
+    }
+
+    threadsUsed = config.threads ? config.threads : std::thread::hardware_concurrency();
+    threadsUsed = std::max(1u, std::min<unsigned>(threadsUsed, static_cast<unsigned>(config.clients)));
+    unsigned socketsUsed = std::max(config.sockets, threadsUsed);
+
+    std::atomic<bool> measuring(false);
+    std::atomic<bool> stopping(false);
+
+    std::vector<std::unique_ptr<BotThread>> bots;
+    for (unsigned t = 0; t < threadsUsed; ++t) {
+        std::size_t clients = config.clients / threadsUsed + (t < config.clients % threadsUsed ? 1 : 0);
+        unsigned sockets = socketsUsed / threadsUsed + (t < socketsUsed % threadsUsed ? 1 : 0);
+        bots.emplace_back(new BotThread(config, server, clients, sockets, measuring, stopping));
+        if (!bots.back()->open(error))
+            return false;
+    }
+
+    std::vector<std::thread> threads;
+    for (std::unique_ptr<BotThread>& bot : bots)
+        threads.emplace_back(&BotThread::run, bot.get());
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.warmup));
+    haveServerStats = requestServerStats(config.host, config.port, serverBefore);
+    measuring = true;
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.seconds));
+    haveServerStats = requestServerStats(config.host, config.port, serverAfter) && haveServerStats;
+
+    stopping = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const std::unique_ptr<BotThread>& bot : bots) {
+        statesReceived += bot->counters.statesReceived;
+        statesLost += bot->counters.statesLost;
+        statesLate += bot->counters.statesLate;
+        matchesFinished += bot->counters.matchesFinished;
+        fullReplies += bot->counters.fullReplies;
+        botOverruns += bot->counters.overruns;
+        bytesIn += bot->bytesIn;
+        bytesOut += bot->bytesOut;
+        clientsPlaying += bot->countPlaying();
+    }
+    return true;
+}
+
+
+/*
+    Function: void LoadBot::printReport(std::ostream& out) const
+
+    Objective:
+        Print the results of run().
+
+    Approach:
+        - Rates are per measured second; server figures are differences of
+          the two STATS replies, except the tick time maximum (server
+          lifetime).
+*/
+void LoadBot::printReport(std::ostream& out) const {
+    char line[256];
+    double seconds = config.seconds > 0 ? config.seconds : 1.0;
+    double clients = double(config.clients);
+    double tickMicros = 1e6 / config.tickRate;
+
+    std::snprintf(line, sizeof line,
+                  "Load test: %zu clients on %u threads against %s:%u, %.1f s measured after %.1f s warm-up\n",
+                  config.clients, threadsUsed, config.host.c_str(), unsigned(config.port), config.seconds, config.warmup);
+    out << line;
+    std::snprintf(line, sizeof line, "  clients in a match   %zu of %zu (FULL replies: %llu)\n",
+                  clientsPlaying, config.clients, static_cast<unsigned long long>(fullReplies));
+    out << line;
+    std::snprintf(line, sizeof line, "  matches finished     %llu\n",
+                  static_cast<unsigned long long>(matchesFinished / 2));
+    out << line;
+    std::snprintf(line, sizeof line, "  states received      %llu (%.1f per client per second)\n",
+                  static_cast<unsigned long long>(statesReceived), statesReceived / clients / seconds);
+    out << line;
+    double expected = double(statesReceived + statesLost);
+    std::snprintf(line, sizeof line, "  states lost          %.3f%%   late (> %.1f ticks apart) %.3f%%\n",
+                  expected > 0 ? 100.0 * statesLost / expected : 0.0, LATE_PERIODS,
+                  statesReceived > 0 ? 100.0 * statesLate / statesReceived : 0.0);
+    out << line;
+    std::snprintf(line, sizeof line, "  bandwidth in         %.2f MB/s (%.1f kbit/s per client)\n",
+                  bytesIn / seconds / 1e6, bytesIn * 8.0 / clients / seconds / 1e3);
+    out << line;
+    std::snprintf(line, sizeof line, "  bandwidth out        %.2f MB/s (%.1f kbit/s per client)\n",
+                  bytesOut / seconds / 1e6, bytesOut * 8.0 / clients / seconds / 1e3);
+    out << line;
+    std::snprintf(line, sizeof line, "  bot tick overruns    %llu%s\n", static_cast<unsigned long long>(botOverruns),
+                  botOverruns ? "  (bot overloaded: use more --threads or another machine)" : "");
+    out << line;
+
+    if (!haveServerStats) {
+        out << "Server: no reply to STATS requests\n";
+        return;
+    }
+
+    std::uint64_t ticks = serverAfter.ticks - serverBefore.ticks;
+    std::uint64_t overruns = serverAfter.overruns - serverBefore.overruns;
+    out << "Server (same window, all shards):\n";
+    std::snprintf(line, sizeof line, "  tick overruns        %llu of %llu shard ticks (%.3f%%)\n",
+                  static_cast<unsigned long long>(overruns), static_cast<unsigned long long>(ticks),
+                  ticks ? 100.0 * overruns / ticks : 0.0);
+    out << line;
+    std::snprintf(line, sizeof line, "  tick time            mean %u us, max %u us (lifetime), budget %.0f us\n",
+                  serverAfter.tickMeanMicros, serverAfter.tickMaxMicros, tickMicros);
+    out << line;
+    std::snprintf(line, sizeof line, "  matches / players    %u / %u\n", serverAfter.matches, serverAfter.players);
+    out << line;
+    std::snprintf(line, sizeof line, "  packets/s            in %.0f, out %.0f, dropped %llu\n",
+                  (serverAfter.packetsIn - serverBefore.packetsIn) / seconds,
+                  (serverAfter.packetsOut - serverBefore.packetsOut) / seconds,
+                  static_cast<unsigned long long>(serverAfter.packetsDropped - serverBefore.packetsDropped));
+    out << line;
+    std::snprintf(line, sizeof line, "  bandwidth            in %.2f MB/s, out %.2f MB/s (UDP payload)\n",
+                  (serverAfter.bytesIn - serverBefore.bytesIn) / seconds / 1e6,
+                  (serverAfter.bytesOut - serverBefore.bytesOut) / seconds / 1e6);
+    out << line;
+}
+
+const std::string& LoadBot::getError() const {
+    return error;
+}
@@ -0,0 +1,113 @@
+#ifndef LOAD_BOT_H
+#define LOAD_BOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "NetProtocol.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: BotConfig
+/// ----------------------------------------------------------
+/// Objective:
+///     Settings of a load test.
+///
+/// Fields:
+///     host, port – server address (dotted IPv4)
+///     clients    – simulated players (2 per match)
+///     threads    – bot threads (0 = all cores)
+///     sockets    – UDP sockets the clients are spread over;
+///                  the server shards by socket address, so
+///                  use several per server thread
+///     warmup     – seconds before measuring (joins settle)
+///     seconds    – measured duration
+///     tickRate   – inputs per second per client
+///////////////////////////////////////////////////////////////
+struct BotConfig {
+    std::string host = "127.0.0.1";
+    std::uint16_t port = DEFAULT_SERVER_PORT;
+    std::size_t clients = 2000;
+    unsigned threads = 0;
+    unsigned sockets = 64;
+    double warmup = 2.0;
+    double seconds = 10.0;
+    int tickRate = SERVER_TICK_RATE;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: LoadBot
+/// ----------------------------------------------------------
+/// Objective:
+///     Load generator for pong-server: many bot clients that
+///     join matches, send a chase-AI input every tick and
+///     track the state stream.
+///
+/// Description:
+///     Clients share a few sockets (they are told apart by
+///     session), each bot thread running its own epoll loop
+///     with a tick timer like the server. Finished matches
+///     are rejoined so the load stays constant.
+///
+///     Measured after the warm-up: state updates received,
+///     lost (gaps in the match tick) and late (more than 1.5
+///     tick periods after the previous one), bandwidth both
+///     ways, and the bot's own tick overruns (if the bot is
+///     overloaded, its numbers describe the bot). The
+///     server's tick overruns, tick time and traffic over
+///     the same window come from two STATS requests.
+///
+/// Used By:
+///     pong-server --bot (server/main.cpp).
+///////////////////////////////////////////////////////////////
+class LoadBot {
+private:
+    BotConfig config;
+    std::string error;
+    unsigned threadsUsed;
+
+    // Totals over the measured window
+    std::uint64_t statesReceived;
+    std::uint64_t statesLost;
+    std::uint64_t statesLate;
+    std::uint64_t matchesFinished;
+    std::uint64_t fullReplies;
+    std::uint64_t bytesIn;
+    std::uint64_t bytesOut;
+    std::uint64_t botOverruns;
+    std::size_t clientsPlaying;
+
+    bool haveServerStats;
+    StatsMessage serverBefore;
+    StatsMessage serverAfter;
+
+public:
+    explicit LoadBot(const BotConfig& config);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: run()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Runs the load test (warm-up + measured seconds),
+    ///     then makes every client leave its match.
+    ///
+    /// Return:
+    ///     bool – false if the address is invalid or sockets
+    ///            could not be opened (see getError())
+    ///////////////////////////////////////////////////////////
+    bool run();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: printReport(std::ostream& out) const
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Prints the client-side and server-side results.
+    ///////////////////////////////////////////////////////////
+    void printReport(std::ostream& out) const;
+
+    const std::string& getError() const;
+};
+
+#endif
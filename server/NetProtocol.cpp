@@ -0,0 +1,366 @@
+#include "NetProtocol.h"
+#include <cstring>
+
+namespace {
+    const std::uint8_t PROTOCOL_MAGIC   = 'P';
+    const std::uint8_t PROTOCOL_VERSION = 5;
+    const std::size_t HEADER_SIZE = 3;
+
+    /*
+        Appends little-endian fields to a datagram.
+    */
+    class Writer {
+    private:
+        std::uint8_t* out;
+        std::size_t used;
+
+    public:
+        Writer(std::uint8_t* out, MessageType type)
+            : out(out),
+              used(0)
+        {
+            u8(PROTOCOL_MAGIC);
+            u8(PROTOCOL_VERSION);
+            u8(static_cast<std::uint8_t>(type));
+        }
+
+        void u8(std::uint8_t value) {
+            out[used++] = value;
+        }
+
+        void u32(std::uint32_t value) {
+            for (int i = 0; i < 4; ++i)
+                out[used++] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+
+        void u64(std::uint64_t value) {
+            u32(static_cast<std::uint32_t>(value));
+            u32(static_cast<std::uint32_t>(value >> 32));
+        }
+
+        void bytes(const std::uint8_t* data, std::size_t count) {
+            std::memcpy(out + used, data, count);
+            used += count;
+        }
+
+        std::size_t size() const {
+            return used;
+        }
+    };
+
+    /*
+        Reads little-endian fields; every read is bounds-checked and a
+        failed read makes ok() false (the remaining reads return 0).
+    */
+    class Reader {
+    private:
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t position;
+        bool valid;
+
+    public:
+        Reader(const std::uint8_t* data, std::size_t size, MessageType type)
+            : data(data),
+              size(size),
+              position(HEADER_SIZE),
+              valid(messageType(data, size) == type)
+        {
+        }
+
+        std::uint8_t u8() {
+            if (!valid || position + 1 > size) {
+                valid = false;
+                return 0;
+            }
+            return data[position++];
+        }
+
+        std::uint32_t u32() {
+            if (!valid || position + 4 > size) {
+                valid = false;
+                return 0;
+            }
+            std::uint32_t value = 0;
+            for (int i = 0; i < 4; ++i)
+                value |= std::uint32_t(data[position++]) << (8 * i);
+            return value;
+        }
+
+        std::uint64_t u64() {
+            std::uint64_t low = u32();
+            return low | std::uint64_t(u32()) << 32;
+        }
+
+        // Everything up to the end of the datagram, at most 'capacity' bytes
+        std::size_t rest(std::uint8_t* out, std::size_t capacity) {
+            std::size_t count = valid && position < size ? size - position : 0;
+            if (count > capacity) {
+                valid = false;
+                return 0;
+            }
+            std::memcpy(out, data + position, count);
+            position += count;
+            return count;
+        }
+
+        // True if every field was present and nothing is left over
+        bool ok() const {
+            return valid && position == size;
+        }
+    };
+
+    bool toSide(std::uint8_t value, Side& side) {
+        if (value > 1)
+            return false;
+        side = value == 0 ? Side::LEFT : Side::RIGHT;
+        return true;
+    }
+
+    bool toAction(std::uint8_t value, PaddleAction& action) {
+        if (value > static_cast<std::uint8_t>(PaddleAction::DOWN))
+            return false;
+        action = static_cast<PaddleAction>(value);
+        return true;
+    }
+}
+
+
+/*
+    Function: MessageType messageType(const std::uint8_t* data, std::size_t size)
+
+    Objective:
+        Identify a datagram.
+
+    Input Parameters:
+        - const std::uint8_t* data: Received bytes.
+        - std::size_t size: Their number.
+
+    Return Value:
+        - MessageType: Type byte, or INVALID if the magic, version or type
+          is wrong.
+
+    Side Effects:
+        - None.
+*/
+MessageType messageType(const std::uint8_t* data, std::size_t size) {
+    if (size < HEADER_SIZE || data[0] != PROTOCOL_MAGIC || data[1] != PROTOCOL_VERSION)
+        return MessageType::INVALID;
+    if (data[2] == 0 || data[2] > static_cast<std::uint8_t>(MessageType::COOKIE))
+        return MessageType::INVALID;
+    return static_cast<MessageType>(data[2]);
+}
+
+
+/*
+    encodeMessage() overloads
+
+    Objective:
+        Serialize each message: header, then fields in declaration order.
+*/
+std::size_t encodeMessage(const JoinMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::JOIN);
+    writer.u32(message.clientId);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const WelcomeMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::WELCOME);
+    writer.u32(message.clientId);
+    writer.u32(message.session);
+    writer.u32(message.key);
+    writer.u8(message.side == Side::LEFT ? 0 : 1);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const FullMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::FULL);
+    writer.u32(message.clientId);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const InputMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::INPUT);
+    writer.u32(message.session);
+    writer.u32(message.key);
+    writer.u32(message.sequence);
+    writer.u32(message.stateAck);
+    writer.u8(static_cast<std::uint8_t>(message.action));
+    return writer.size();
+}
+
+std::size_t encodeMessage(const StateMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::STATE);
+    writer.u32(message.session);
+    writer.u32(message.inputAck);
+    writer.u8(message.flags);
+    writer.bytes(message.snapshot, message.snapshotSize);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const LeaveMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::LEAVE);
+    writer.u32(message.session);
+    writer.u32(message.key);
+    return writer.size();
+}
+
+std::size_t encodeStatsRequest(std::uint8_t* out) {
+    Writer writer(out, MessageType::STATS_REQUEST);
+    while (writer.size() < STATS_REQUEST_BYTES)
+        writer.u8(0);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const StatsMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::STATS);
+    writer.u64(message.ticks);
+    writer.u64(message.overruns);
+    writer.u32(message.tickMeanMicros);
+    writer.u32(message.tickMaxMicros);
+    writer.u32(message.matches);
+    writer.u32(message.players);
+    writer.u64(message.packetsIn);
+    writer.u64(message.packetsOut);
+    writer.u64(message.packetsDropped);
+    writer.u64(message.bytesIn);
+    writer.u64(message.bytesOut);
+    writer.u64(message.cpuMicros);
+    writer.u32(message.spectators);
+    writer.u32(message.spectatorKicks);
+    writer.u64(message.spectatorFrames);
+    writer.u64(message.spectatorBytes);
+    writer.u64(message.spectatorDrops);
+    writer.u64(message.spectatorCpuMicros);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const SubscribeMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::SUBSCRIBE);
+    writer.u32(message.matchId);
+    writer.u32(message.cookie);
+    return writer.size();
+}
+
+std::size_t encodeUnsubscribe(std::uint8_t* out) {
+    Writer writer(out, MessageType::UNSUBSCRIBE);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const FrameMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::FRAME);
+    writer.u32(message.matchId);
+    writer.u64(message.publishNanos);
+    writer.u8(message.flags);
+    writer.bytes(message.snapshot, message.snapshotSize);
+    return writer.size();
+}
+
+std::size_t encodeMessage(const CookieMessage& message, std::uint8_t* out) {
+    Writer writer(out, MessageType::COOKIE);
+    writer.u32(message.cookie);
+    return writer.size();
+}
+
+/*
+    decodeMessage() overloads
+
+    Objective:
+        Parse each message; false unless the type matches and the size is
+        exact (enum fields are range-checked).
+*/
+bool decodeMessage(const std::uint8_t* data, std::size_t size, JoinMessage& message) {
+    Reader reader(data, size, MessageType::JOIN);
+    message.clientId = reader.u32();
+    return reader.ok();
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, WelcomeMessage& message) {
+    Reader reader(data, size, MessageType::WELCOME);
+    message.clientId = reader.u32();
+    message.session = reader.u32();
+    message.key = reader.u32();
+    std::uint8_t side = reader.u8();
+    return reader.ok() && toSide(side, message.side);
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, FullMessage& message) {
+    Reader reader(data, size, MessageType::FULL);
+    message.clientId = reader.u32();
+    return reader.ok();
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, InputMessage& message) {
+    Reader reader(data, size, MessageType::INPUT);
+    message.session = reader.u32();
+    message.key = reader.u32();
+    message.sequence = reader.u32();
+    message.stateAck = reader.u32();
+    std::uint8_t action = reader.u8();
+    return reader.ok() && toAction(action, message.action);
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, StateMessage& message) {
+    Reader reader(data, size, MessageType::STATE);
+    message.session = reader.u32();
+    message.inputAck = reader.u32();
+    message.flags = reader.u8();
+    message.snapshotSize = static_cast<std::uint8_t>(reader.rest(message.snapshot, SNAPSHOT_MAX_BYTES));
+    return reader.ok() && message.snapshotSize > 0;
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, LeaveMessage& message) {
+    Reader reader(data, size, MessageType::LEAVE);
+    message.session = reader.u32();
+    message.key = reader.u32();
+    return reader.ok();
+}
+
+bool decodeStatsRequest(const std::uint8_t* data, std::size_t size) {
+    return messageType(data, size) == MessageType::STATS_REQUEST && size == STATS_REQUEST_BYTES;
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, StatsMessage& message) {
+    Reader reader(data, size, MessageType::STATS);
+    message.ticks = reader.u64();
+    message.overruns = reader.u64();
+    message.tickMeanMicros = reader.u32();
+    message.tickMaxMicros = reader.u32();
+    message.matches = reader.u32();
+    message.players = reader.u32();
+    message.packetsIn = reader.u64();
+    message.packetsOut = reader.u64();
+    message.packetsDropped = reader.u64();
+    message.bytesIn = reader.u64();
+    message.bytesOut = reader.u64();
+    message.cpuMicros = reader.u64();
+    message.spectators = reader.u32();
+    message.spectatorKicks = reader.u32();
+    message.spectatorFrames = reader.u64();
+    message.spectatorBytes = reader.u64();
+    message.spectatorDrops = reader.u64();
+    message.spectatorCpuMicros = reader.u64();
+    return reader.ok();
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, SubscribeMessage& message) {
+    Reader reader(data, size, MessageType::SUBSCRIBE);
+    message.matchId = reader.u32();
+    message.cookie = reader.u32();
+    return reader.ok();
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, FrameMessage& message) {
+    Reader reader(data, size, MessageType::FRAME);
+    message.matchId = reader.u32();
+    message.publishNanos = reader.u64();
+    message.flags = reader.u8();
+    message.snapshotSize = static_cast<std::uint8_t>(reader.rest(message.snapshot, SNAPSHOT_MAX_BYTES));
+    return reader.ok() && message.snapshotSize > 0;
+}
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, CookieMessage& message) {
+    Reader reader(data, size, MessageType::COOKIE);
+    message.cookie = reader.u32();
+    return reader.ok();
+}
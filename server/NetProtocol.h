@@ -0,0 +1,260 @@
+#ifndef NET_PROTOCOL_H
+#define NET_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "GameTypes.h"
+#include "Snapshot.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: network defaults
+/// ----------------------------------------------------------
+/// DEFAULT_SERVER_HOST    – address pong-server binds by
+///                          default (loopback: --host opens
+///                          it to other interfaces)
+/// ANY_HOST               – bind address of every interface
+///                          (clients' ephemeral sockets)
+/// DEFAULT_SERVER_PORT    – UDP port of pong-server
+/// DEFAULT_SPECTATOR_PORT – UDP and TCP port of its
+///                          spectator feed
+/// SERVER_TICK_RATE       – simulation steps (and state
+///                          updates) per second
+/// MAX_DATAGRAM           – largest message, in bytes
+/// STREAM_PREFIX_BYTES    – length prefix of a message sent
+///                          over TCP (little endian)
+/// STATS_REQUEST_BYTES    – size of a STATS_REQUEST: padded
+///                          to the size of the STATS reply, so
+///                          a spoofed request cannot make the
+///                          server send more than it received
+///////////////////////////////////////////////////////////////
+const char* const DEFAULT_SERVER_HOST = "127.0.0.1";
+const char* const ANY_HOST = "0.0.0.0";
+const std::uint16_t DEFAULT_SERVER_PORT = 7777;
+const std::uint16_t DEFAULT_SPECTATOR_PORT = 7778;
+const int SERVER_TICK_RATE = 60;
+const std::size_t MAX_DATAGRAM = 256;
+const std::size_t STREAM_PREFIX_BYTES = 2;
+const std::size_t STATS_REQUEST_BYTES = 123;   // Encoded StatsMessage size: keep in step
+
+// InputMessage::stateAck before the first state arrived
+const std::uint32_t NO_STATE_ACK = 0xFFFFFFFFu;
+
+// SubscribeMessage::matchId: follow whichever match the server features
+const std::uint32_t ANY_MATCH = 0xFFFFFFFFu;
+
+///////////////////////////////////////////////////////////////
+/// Enum: MessageType
+/// ----------------------------------------------------------
+/// Objective:
+///     Kind of a datagram (third byte of every message).
+///
+/// Values:
+///     JOIN          – client → server: find me a match
+///     WELCOME       – server → client: session and side
+///     FULL          – server → client: no free match slot
+///     INPUT         – client → server: paddle action
+///     STATE         – server → client: match state, every tick
+///     LEAVE         – client → server: quit the match
+///     STATS_REQUEST – any → server: ask for server statistics
+///                     (zero-padded to STATS_REQUEST_BYTES)
+///     STATS         – server → requester: statistics
+///     SUBSCRIBE     – spectator → server: watch a match
+///                     (over UDP: repeat as a keep-alive)
+///     UNSUBSCRIBE   – spectator → server: stop watching
+///     FRAME         – server → spectator: match state
+///     COOKIE        – server → UDP spectator: proof of
+///                     address to echo in SUBSCRIBE
+///////////////////////////////////////////////////////////////
+enum class MessageType : std::uint8_t {
+    INVALID = 0,
+    JOIN,
+    WELCOME,
+    FULL,
+    INPUT,
+    STATE,
+    LEAVE,
+    STATS_REQUEST,
+    STATS,
+    SUBSCRIBE,
+    UNSUBSCRIBE,
+    FRAME,
+    COOKIE
+};
+
+///////////////////////////////////////////////////////////////
+/// Namespace: StateFlag
+/// ----------------------------------------------------------
+/// Objective:
+///     Bit flags of StateMessage::flags.
+///
+/// Values:
+///     WAITING   – no opponent yet, the match has not started
+///     FINISHED  – the match is over (final state)
+///     ABANDONED – it ended because a player left or timed out
+///////////////////////////////////////////////////////////////
+namespace StateFlag {
+    const std::uint8_t WAITING   = 1u << 0;
+    const std::uint8_t FINISHED  = 1u << 1;
+    const std::uint8_t ABANDONED = 1u << 2;
+}
+
+///////////////////////////////////////////////////////////////
+/// Structs: messages
+/// ----------------------------------------------------------
+/// Objective:
+///     Decoded form of each message type.
+///
+/// Description:
+///     A client names itself with a clientId of its choice in
+///     JOIN (so many clients can share one UDP socket). The
+///     server answers with a session (match slot × 2 + side)
+///     and a random key; INPUT and LEAVE must carry both.
+///     INPUT sequence numbers let the server drop reordered
+///     packets; STATE acknowledges the last one applied.
+///
+///     STATE carries the match as an encodeSnapshot() delta
+///     against the newest snapshot tick the client reported
+///     in INPUT.stateAck (a keyframe until it has reported
+///     one), so a client keeps a SnapshotHistory per session.
+///
+///     FRAME is the spectator form of STATE: one encoding per
+///     match and tick shared by every spectator, so its delta
+///     refers to the match's latest keyframe (a keyframe is
+///     sent every SPECTATOR_KEYFRAME_TICKS, SpectatorHub.h) rather than to an
+///     acknowledgement. publishNanos is the server's
+///     steady_clock when the frame was made: a spectator on
+///     the same host measures delivery latency with it.
+///
+///     A UDP SUBSCRIBE from a new address is answered with a
+///     COOKIE (smaller than the request) instead of frames;
+///     the subscription starts when SUBSCRIBE comes back with
+///     that cookie, which proves the sender receives at the
+///     address it claims. Over TCP the cookie is ignored.
+///////////////////////////////////////////////////////////////
+struct JoinMessage {
+    std::uint32_t clientId;
+};
+
+struct WelcomeMessage {
+    std::uint32_t clientId;
+    std::uint32_t session;
+    std::uint32_t key;
+    Side side;
+};
+
+struct FullMessage {
+    std::uint32_t clientId;
+};
+
+struct InputMessage {
+    std::uint32_t session;
+    std::uint32_t key;
+    std::uint32_t sequence;
+    std::uint32_t stateAck;      // Tick of the newest snapshot decoded
+    PaddleAction action;
+};
+
+struct StateMessage {
+    std::uint32_t session;
+    std::uint32_t inputAck;      // Last INPUT sequence applied
+    std::uint8_t flags;          // StateFlag bits
+    std::uint8_t snapshotSize;
+    std::uint8_t snapshot[SNAPSHOT_MAX_BYTES];  // encodeSnapshot() output
+};
+
+struct LeaveMessage {
+    std::uint32_t session;
+    std::uint32_t key;
+};
+
+struct SubscribeMessage {
+    std::uint32_t matchId;       // shard << 24 | slot, or ANY_MATCH
+    std::uint32_t cookie;        // Last COOKIE received (UDP), else 0
+};
+
+struct CookieMessage {
+    std::uint32_t cookie;
+};
+
+struct FrameMessage {
+    std::uint32_t matchId;
+    std::uint64_t publishNanos;  // Server steady_clock, nanoseconds
+    std::uint8_t flags;          // StateFlag bits
+    std::uint8_t snapshotSize;
+    std::uint8_t snapshot[SNAPSHOT_MAX_BYTES];
+};
+
+struct StatsMessage {
+    std::uint64_t ticks;         // Ticks run (per shard, summed)
+    std::uint64_t overruns;      // Ticks late or longer than the period
+    std::uint32_t tickMeanMicros;
+    std::uint32_t tickMaxMicros;
+    std::uint32_t matches;       // Matches in the pool (waiting or playing)
+    std::uint32_t players;
+    std::uint64_t packetsIn;
+    std::uint64_t packetsOut;
+    std::uint64_t packetsDropped; // Sends refused by a full socket buffer
+    std::uint64_t bytesIn;       // UDP payload bytes
+    std::uint64_t bytesOut;
+    std::uint64_t cpuMicros;     // Process CPU time (all threads)
+    std::uint32_t spectators;    // Subscribed spectators, UDP and TCP
+    std::uint32_t spectatorKicks; // Slow TCP spectators disconnected
+    std::uint64_t spectatorFrames; // Frames handed to spectator sockets
+    std::uint64_t spectatorBytes;
+    std::uint64_t spectatorDrops;  // Frames skipped for slow consumers
+    std::uint64_t spectatorCpuMicros; // CPU time of the fan-out thread
+};
+
+///////////////////////////////////////////////////////////////
+/// Function: messageType(const std::uint8_t* data,
+///                       std::size_t size)
+/// ----------------------------------------------------------
+/// Objective:
+///     Checks the header of a received datagram.
+///
+/// Return:
+///     MessageType – INVALID for foreign or truncated data
+///////////////////////////////////////////////////////////////
+MessageType messageType(const std::uint8_t* data, std::size_t size);
+
+///////////////////////////////////////////////////////////////
+/// Functions: encodeMessage / decodeMessage
+/// ----------------------------------------------------------
+/// Objective:
+///     Convert a message to and from its datagram.
+///
+/// Description:
+///     Layout: 'P', protocol version, MessageType, then the
+///     fields in declaration order, little endian, without
+///     padding; the snapshot of a STATE or FRAME takes the
+///     rest of the datagram. encodeMessage() writes at most
+///     MAX_DATAGRAM bytes and returns the size; decodeMessage()
+///     returns false for a wrong type or size. Over TCP every
+///     message is preceded by its size (STREAM_PREFIX_BYTES).
+///////////////////////////////////////////////////////////////
+std::size_t encodeMessage(const JoinMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const WelcomeMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const FullMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const InputMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const StateMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const LeaveMessage& message, std::uint8_t* out);
+std::size_t encodeStatsRequest(std::uint8_t* out);
+std::size_t encodeMessage(const StatsMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const SubscribeMessage& message, std::uint8_t* out);
+std::size_t encodeUnsubscribe(std::uint8_t* out);
+std::size_t encodeMessage(const FrameMessage& message, std::uint8_t* out);
+std::size_t encodeMessage(const CookieMessage& message, std::uint8_t* out);
+
+bool decodeMessage(const std::uint8_t* data, std::size_t size, JoinMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, WelcomeMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, FullMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, InputMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, StateMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, LeaveMessage& message);
+bool decodeStatsRequest(const std::uint8_t* data, std::size_t size);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, StatsMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, SubscribeMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, FrameMessage& message);
+bool decodeMessage(const std::uint8_t* data, std::size_t size, CookieMessage& message);
+
+#endif
@@ -0,0 +1,508 @@
+#include "SpectatorBot.h"
+#include "UdpIo.h"
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    const std::uint32_t NO_MATCH = 0xFFFFFFFFu;
+
+    // UDP subscribers repeat SUBSCRIBE this often (the server forgets them
+    // after its idle timeout)
+    const std::chrono::seconds KEEP_ALIVE(1);
+
+    const int EPOLL_TIMEOUT_MS = 100;
+    const int EVENTS_PER_WAIT = 64;
+
+    // Receive buffer of a subscriber that never reads: fills in seconds
+    const int SLOW_RECEIVE_BUFFER_BYTES = 4096;
+
+    std::uint64_t nowNanos() {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    struct Spectator {
+        int fd;
+        bool slow;                       // Never reads
+        std::uint32_t matchId;           // Match of the latest frame
+        std::uint32_t lastTick;
+        std::uint32_t framesInMatch;
+        std::uint32_t cookie;            // From the hub's COOKIE (UDP)
+        SnapshotHistory history;         // Keyframes (and deltas) decoded
+        Clock::time_point lastSubscribe;
+        std::uint64_t frames;            // Measured window
+        std::uint64_t latencyMicros;
+        std::uint64_t latencyCount;
+        std::uint8_t input[512];         // TCP stream buffer
+        std::size_t inputSize;
+    };
+
+    /*
+        Counters of one bot thread over the measured window.
+    */
+    struct SpectatorCounters {
+        std::uint64_t framesReceived = 0;
+        std::uint64_t framesUndecodable = 0;
+        std::uint64_t ticksSkipped = 0;
+        std::uint64_t matchesFinished = 0;
+        std::vector<std::uint32_t> latencies;
+    };
+
+    /*
+        One bot thread: its subscribers, each with its own socket, and an
+        epoll loop over them.
+    */
+    class SpectatorThread {
+    private:
+        const SpectatorConfig& config;
+        const sockaddr_in hub;
+        const std::atomic<bool>& measuring;
+        const std::atomic<bool>& stopping;
+
+        std::vector<Spectator> spectators;
+        ReceiveBatch receiver;
+        int epollFd;
+        bool counting;
+
+    public:
+        SpectatorCounters counters;
+
+        SpectatorThread(const SpectatorConfig& config, const sockaddr_in& hub, std::size_t count, std::size_t slow,
+                        const std::atomic<bool>& measuring, const std::atomic<bool>& stopping)
+            : config(config),
+              hub(hub),
+              measuring(measuring),
+              stopping(stopping),
+              spectators(count),
+              epollFd(-1),
+              counting(false)
+        {
+            for (std::size_t i = 0; i < spectators.size(); ++i) {
+                Spectator& spectator = spectators[i];
+                spectator.fd = -1;
+                spectator.slow = i < slow;
+                spectator.matchId = NO_MATCH;
+                spectator.lastTick = 0;
+                spectator.framesInMatch = 0;
+                spectator.cookie = 0;
+                spectator.frames = 0;
+                spectator.latencyMicros = 0;
+                spectator.latencyCount = 0;
+                spectator.inputSize = 0;
+            }
+        }
+
+        ~SpectatorThread() {
+            for (const Spectator& spectator : spectators)
+                if (spectator.fd >= 0) ::close(spectator.fd);
+            if (epollFd >= 0) ::close(epollFd);
+        }
+
+        /*
+            Open (and for TCP connect) every subscriber's socket and send
+            its SUBSCRIBE.
+        */
+        bool open(std::string& error) {
+            epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            if (epollFd < 0) {
+                error = std::string("epoll: ") + std::strerror(errno);
+                return false;
+            }
+
+            for (std::size_t i = 0; i < spectators.size(); ++i) {
+                Spectator& spectator = spectators[i];
+                if (config.tcp) {
+                    spectator.fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                    if (spectator.fd >= 0 && spectator.slow)
+                        ::setsockopt(spectator.fd, SOL_SOCKET, SO_RCVBUF, &SLOW_RECEIVE_BUFFER_BYTES,
+                                     sizeof SLOW_RECEIVE_BUFFER_BYTES);
+                }
+                else
+                    spectator.fd = openUdpSocket(ANY_HOST, 0, false, error);
+
+                if (spectator.fd < 0
+                    || ::connect(spectator.fd, reinterpret_cast<const sockaddr*>(&hub), sizeof hub) != 0) {
+                    error = std::string("connect to spectator port: ") + std::strerror(errno);
+                    return false;
+                }
+                if (config.tcp) {
+                    int one = 1;
+                    ::setsockopt(spectator.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+                }
+
+                sendSubscribe(spectator);
+                if (config.tcp)
+                    ::fcntl(spectator.fd, F_SETFL, ::fcntl(spectator.fd, F_GETFL) | O_NONBLOCK);
+                if (spectator.slow)
+                    continue;
+
+                epoll_event event;
+                std::memset(&event, 0, sizeof event);
+                event.events = EPOLLIN;
+                event.data.u32 = static_cast<std::uint32_t>(i);
+                ::epoll_ctl(epollFd, EPOLL_CTL_ADD, spectator.fd, &event);
+            }
+            return true;
+        }
+
+        /*
+            Event loop; UDP subscribers send keep-alives and, on stop,
+            UNSUBSCRIBE (TCP ones just close).
+        */
+        void run() {
+            epoll_event events[EVENTS_PER_WAIT];
+            Clock::time_point lastKeepAlive = Clock::now();
+
+            while (!stopping.load(std::memory_order_relaxed)) {
+                int ready = ::epoll_wait(epollFd, events, EVENTS_PER_WAIT, EPOLL_TIMEOUT_MS);
+                if (!counting && measuring.load(std::memory_order_relaxed))
+                    counting = true;
+
+                for (int i = 0; i < ready; ++i) {
+                    std::uint32_t index = events[i].data.u32;
+                    if (config.tcp)
+                        receiveTcp(index);
+                    else
+                        receiveUdp(index);
+                }
+
+                Clock::time_point now = Clock::now();
+                if (!config.tcp && now - lastKeepAlive >= std::chrono::milliseconds(EPOLL_TIMEOUT_MS)) {
+                    for (Spectator& spectator : spectators)
+                        if (now - spectator.lastSubscribe >= KEEP_ALIVE)
+                            sendSubscribe(spectator);
+                    lastKeepAlive = now;
+                }
+            }
+
+            if (!config.tcp) {
+                std::uint8_t buffer[MAX_DATAGRAM];
+                std::size_t length = encodeUnsubscribe(buffer);
+                for (const Spectator& spectator : spectators)
+                    ::send(spectator.fd, buffer, length, 0);
+            }
+        }
+
+        // Per-subscriber results: mean latency and frame rate, if fed
+        void summarize(double seconds, std::vector<double>& latencies, std::vector<double>& rates) const {
+            for (const Spectator& spectator : spectators) {
+                if (spectator.slow || spectator.frames == 0)
+                    continue;
+                rates.push_back(spectator.frames / seconds);
+                if (spectator.latencyCount > 0)
+                    latencies.push_back(double(spectator.latencyMicros) / spectator.latencyCount);
+            }
+        }
+
+    private:
+        void sendSubscribe(Spectator& spectator) {
+            std::uint8_t buffer[STREAM_PREFIX_BYTES + MAX_DATAGRAM];
+            SubscribeMessage subscribe = { config.matchId, spectator.cookie };
+            std::size_t length = encodeMessage(subscribe, buffer + STREAM_PREFIX_BYTES);
+            if (config.tcp) {
+                buffer[0] = static_cast<std::uint8_t>(length);
+                buffer[1] = static_cast<std::uint8_t>(length >> 8);
+                ::send(spectator.fd, buffer, STREAM_PREFIX_BYTES + length, MSG_NOSIGNAL);
+            }
+            else
+                ::send(spectator.fd, buffer + STREAM_PREFIX_BYTES, length, 0);
+            spectator.lastSubscribe = Clock::now();
+        }
+
+        // A COOKIE (first SUBSCRIBE, or a stale cookie) is answered at once
+        void receiveUdp(std::uint32_t index) {
+            Spectator& spectator = spectators[index];
+            std::size_t count;
+            while ((count = receiver.receive(spectator.fd)) > 0) {
+                std::uint64_t now = nowNanos();
+                for (std::size_t i = 0; i < count; ++i) {
+                    CookieMessage cookie;
+                    if (decodeMessage(receiver.datagram(i), receiver.size(i), cookie)) {
+                        spectator.cookie = cookie.cookie;
+                        sendSubscribe(spectator);
+                    }
+                    else
+                        handleFrame(spectator, receiver.datagram(i), receiver.size(i), now);
+                }
+            }
+        }
+
+        void receiveTcp(std::uint32_t index) {
+            Spectator& spectator = spectators[index];
+            for (;;) {
+                ssize_t received = ::recv(spectator.fd, spectator.input + spectator.inputSize,
+                                          sizeof spectator.input - spectator.inputSize, 0);
+                if (received <= 0) {
+                    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, spectator.fd, nullptr);
+                    return;
+                }
+                spectator.inputSize += static_cast<std::size_t>(received);
+
+                std::uint64_t now = nowNanos();
+                std::size_t position = 0;
+                while (spectator.inputSize - position >= STREAM_PREFIX_BYTES) {
+                    std::size_t length = spectator.input[position] | std::size_t(spectator.input[position + 1]) << 8;
+                    if (spectator.inputSize - position - STREAM_PREFIX_BYTES < length)
+                        break;
+                    handleFrame(spectator, spectator.input + position + STREAM_PREFIX_BYTES, length, now);
+                    position += STREAM_PREFIX_BYTES + length;
+                }
+                std::memmove(spectator.input, spectator.input + position, spectator.inputSize - position);
+                spectator.inputSize -= position;
+            }
+        }
+
+        /*
+            Decode one frame and account for it.
+
+            A new match id starts a new stream (the history is cleared);
+            its first frame may be the hub's cached keyframe, so latency
+            and skipped ticks are counted from the frames after it.
+        */
+        void handleFrame(Spectator& spectator, const std::uint8_t* data, std::size_t size, std::uint64_t now) {
+            FrameMessage frame;
+            if (!decodeMessage(data, size, frame))
+                return;
+
+            if (frame.matchId != spectator.matchId) {
+                spectator.matchId = frame.matchId;
+                spectator.framesInMatch = 0;
+                spectator.history.clear();
+            }
+
+            bool replayed = spectator.framesInMatch == 0;
+            if (counting) {
+                counters.framesReceived++;
+                spectator.frames++;
+                if (!replayed && now >= frame.publishNanos) {
+                    std::uint32_t micros = static_cast<std::uint32_t>((now - frame.publishNanos) / 1000);
+                    counters.latencies.push_back(micros);
+                    spectator.latencyMicros += micros;
+                    spectator.latencyCount++;
+                }
+            }
+
+            Snapshot snapshot;
+            if (!decodeSnapshot(frame.snapshot, frame.snapshotSize, spectator.history, snapshot)) {
+                if (counting)
+                    counters.framesUndecodable++;
+                return;
+            }
+            spectator.history.store(snapshot);
+
+            if (counting && spectator.framesInMatch >= 2 && snapshot.tick > spectator.lastTick + 1)
+                counters.ticksSkipped += snapshot.tick - spectator.lastTick - 1;
+            spectator.lastTick = snapshot.tick;
+            spectator.framesInMatch++;
+
+            if (frame.flags & StateFlag::FINISHED) {
+                if (counting)
+                    counters.matchesFinished++;
+                spectator.matchId = NO_MATCH;
+            }
+        }
+    };
+
+    double percentile(const std::vector<std::uint32_t>& sorted, double fraction) {
+        if (sorted.empty())
+            return 0.0;
+        std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+        return sorted[index];
+    }
+
+    double medianOf(std::vector<double>& values) {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+}
+
+
+/*
+    Constructor: SpectatorBot::SpectatorBot(const SpectatorConfig& config)
+
+    Objective:
+        Store the configuration.
+*/
+SpectatorBot::SpectatorBot(const SpectatorConfig& config)
+    : config(config),
+      threadsUsed(0),
+      framesReceived(0),
+      framesUndecodable(0),
+      ticksSkipped(0),
+      matchesFinished(0),
+      subscribersFed(0),
+      haveServerStats(false),
+      serverBefore(),
+      serverAfter()
+{
+}
+
+
+/*
+    Function: bool SpectatorBot::run()
+
+    Objective:
+        Run the spectator load test.
+
+    Return Value:
+        - bool: false if it could not start.
+
+    Side Effects:
+        - Opens config.spectators sockets; starts config.threads threads.
+
+    Approach:
+        - Split subscribers (and the slow ones) evenly over the threads.
+        - Sleep through the warm-up, take server statistics, switch the
+          threads to counting, sleep through the measured window, take
+          server statistics again, stop the threads.
+*/
+bool SpectatorBot::run() {
+    sockaddr_in hub;
+    if (!parseAddress(config.host, config.spectatorPort, hub)) {
+        error = "invalid IPv4 address '" + config.host + "'";
+        return false;
+    }
+    if (config.spectators == 0 || config.slow > config.spectators || (config.slow > 0 && !config.tcp)) {
+        error = "invalid spectator count (--slow needs --tcp and at most --spectators)";
+        return false;
+    }
+
+    threadsUsed = config.threads ? config.threads : std::thread::hardware_concurrency();
+    threadsUsed = std::max(1u, std::min<unsigned>(threadsUsed, static_cast<unsigned>(config.spectators)));
+
+    std::atomic<bool> measuring(false);
+    std::atomic<bool> stopping(false);
+
+    std::vector<std::unique_ptr<SpectatorThread>> bots;
+    for (unsigned t = 0; t < threadsUsed; ++t) {
+        std::size_t count = config.spectators / threadsUsed + (t < config.spectators % threadsUsed ? 1 : 0);
+        std::size_t slow = config.slow / threadsUsed + (t < config.slow % threadsUsed ? 1 : 0);
+        bots.emplace_back(new SpectatorThread(config, hub, count, slow, measuring, stopping));
+        if (!bots.back()->open(error))
+            return false;
+    }
+
+    std::vector<std::thread> threads;
+    for (std::unique_ptr<SpectatorThread>& bot : bots)
+        threads.emplace_back(&SpectatorThread::run, bot.get());
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.warmup));
+    haveServerStats = requestServerStats(config.host, config.port, serverBefore);
+    measuring = true;
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.seconds));
+    haveServerStats = requestServerStats(config.host, config.port, serverAfter) && haveServerStats;
+
+    stopping = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double seconds = config.seconds > 0 ? config.seconds : 1.0;
+    for (const std::unique_ptr<SpectatorThread>& bot : bots) {
+        framesReceived += bot->counters.framesReceived;
+        framesUndecodable += bot->counters.framesUndecodable;
+        ticksSkipped += bot->counters.ticksSkipped;
+        matchesFinished += bot->counters.matchesFinished;
+        latencies.insert(latencies.end(), bot->counters.latencies.begin(), bot->counters.latencies.end());
+        bot->summarize(seconds, subscriberLatencies, subscriberRates);
+    }
+    subscribersFed = subscriberRates.size();
+    return true;
+}
+
+
+/*
+    Function: void SpectatorBot::printReport(std::ostream& out)
+
+    Objective:
+        Print the results of run().
+
+    Approach:
+        - Rates are per measured second; server figures are differences of
+          the two STATS replies. CPU per subscriber is the fan-out
+          thread's CPU time over subscriber-seconds; the process figure
+          also includes the shards (players and frame serialization).
+*/
+void SpectatorBot::printReport(std::ostream& out) {
+    char line[256];
+    double seconds = config.seconds > 0 ? config.seconds : 1.0;
+    std::size_t readers = config.spectators - config.slow;
+
+    std::snprintf(line, sizeof line,
+                  "Spectator test: %zu %s subscribers (%zu never reading) on %u threads against %s:%u, "
+                  "%.1f s measured after %.1f s warm-up\n",
+                  config.spectators, config.tcp ? "TCP" : "UDP", config.slow, threadsUsed, config.host.c_str(),
+                  unsigned(config.spectatorPort), config.seconds, config.warmup);
+    out << line;
+    std::snprintf(line, sizeof line, "  subscribers fed      %zu of %zu reading\n", subscribersFed, readers);
+    out << line;
+    std::snprintf(line, sizeof line, "  frames received      %llu (%.1f per subscriber per second), undecodable %llu\n",
+                  static_cast<unsigned long long>(framesReceived), readers ? framesReceived / double(readers) / seconds : 0.0,
+                  static_cast<unsigned long long>(framesUndecodable));
+    out << line;
+    std::snprintf(line, sizeof line, "  match ticks skipped  %llu   matches finished %llu\n",
+                  static_cast<unsigned long long>(ticksSkipped), static_cast<unsigned long long>(matchesFinished));
+    out << line;
+
+    std::sort(latencies.begin(), latencies.end());
+    std::snprintf(line, sizeof line, "  latency per frame    p50 %.0f us, p90 %.0f us, p99 %.0f us, max %.0f us (%zu frames)\n",
+                  percentile(latencies, 0.50), percentile(latencies, 0.90), percentile(latencies, 0.99),
+                  latencies.empty() ? 0.0 : double(latencies.back()), latencies.size());
+    out << line;
+    if (!subscriberLatencies.empty()) {
+        double median = medianOf(subscriberLatencies);
+        std::snprintf(line, sizeof line, "  latency per subscriber (mean)  best %.0f us, median %.0f us, worst %.0f us\n",
+                      subscriberLatencies.front(), median, subscriberLatencies.back());
+        out << line;
+        double rate = medianOf(subscriberRates);
+        std::snprintf(line, sizeof line, "  frames/s per subscriber        lowest %.1f, median %.1f, highest %.1f\n",
+                      subscriberRates.front(), rate, subscriberRates.back());
+        out << line;
+    }
+
+    if (!haveServerStats) {
+        out << "Server: no reply to STATS requests\n";
+        return;
+    }
+
+    const StatsMessage& a = serverBefore;
+    const StatsMessage& b = serverAfter;
+    double hubCpu = (b.spectatorCpuMicros - a.spectatorCpuMicros) / seconds;     // us per second
+    double processCpu = (b.cpuMicros - a.cpuMicros) / seconds;
+    std::uint64_t frames = b.spectatorFrames - a.spectatorFrames;
+    out << "Server (same window):\n";
+    std::snprintf(line, sizeof line, "  spectators           %u (slow consumers disconnected: %u)\n",
+                  b.spectators, b.spectatorKicks - a.spectatorKicks);
+    out << line;
+    std::snprintf(line, sizeof line, "  frames out           %.0f/s, %.2f MB/s, dropped %llu\n",
+                  frames / seconds, (b.spectatorBytes - a.spectatorBytes) / seconds / 1e6,
+                  static_cast<unsigned long long>(b.spectatorDrops - a.spectatorDrops));
+    out << line;
+    std::snprintf(line, sizeof line, "  fan-out thread CPU   %.1f%% of a core, %.2f us per subscriber-second, %.0f ns per frame\n",
+                  hubCpu / 1e4, b.spectators ? hubCpu / b.spectators : 0.0,
+                  frames ? (b.spectatorCpuMicros - a.spectatorCpuMicros) * 1000.0 / frames : 0.0);
+    out << line;
+    std::snprintf(line, sizeof line, "  process CPU          %.1f%% of a core (players included), matches %u, players %u\n",
+                  processCpu / 1e4, b.matches, b.players);
+    out << line;
+}
+
+const std::string& SpectatorBot::getError() const {
+    return error;
+}
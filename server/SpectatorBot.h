@@ -0,0 +1,120 @@
+#ifndef SPECTATOR_BOT_H
+#define SPECTATOR_BOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "NetProtocol.h"
+
+///////////////////////////////////////////////////////////////
+/// Struct: SpectatorConfig
+/// ----------------------------------------------------------
+/// Objective:
+///     Settings of a spectator load test.
+///
+/// Fields:
+///     host          – server address (dotted IPv4)
+///     port          – game port (STATS requests)
+///     spectatorPort – spectator feed port
+///     spectators    – simulated subscribers
+///     tcp           – subscribe over TCP instead of UDP
+///     matchId       – match to watch (ANY_MATCH = featured)
+///     slow          – TCP subscribers among them that never
+///                     read (slow-consumer handling)
+///     threads       – bot threads (0 = all cores)
+///     warmup        – seconds before measuring
+///     seconds       – measured duration
+///////////////////////////////////////////////////////////////
+struct SpectatorConfig {
+    std::string host = "127.0.0.1";
+    std::uint16_t port = DEFAULT_SERVER_PORT;
+    std::uint16_t spectatorPort = DEFAULT_SPECTATOR_PORT;
+    std::size_t spectators = 1000;
+    bool tcp = false;
+    std::uint32_t matchId = ANY_MATCH;
+    std::size_t slow = 0;
+    unsigned threads = 0;
+    double warmup = 2.0;
+    double seconds = 10.0;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: SpectatorBot
+/// ----------------------------------------------------------
+/// Objective:
+///     Load generator for the spectator feed of pong-server:
+///     many subscribers, each with a socket of its own, that
+///     decode every frame they receive.
+///
+/// Description:
+///     Matches must be running (e.g. pong-server --bot in
+///     another terminal). Measured after the warm-up:
+///     frames received and undecodable, match ticks skipped,
+///     and the delivery latency of every frame (server
+///     publish time to arrival, both steady_clock: valid on
+///     the same host only; the late-join keyframe, replayed
+///     from the hub's cache, is left out). Per subscriber the
+///     frame rate and mean latency are summarized as well.
+///
+///     The server's spectator counters and CPU time over the
+///     same window come from two STATS requests: the CPU of
+///     the fan-out thread divided by subscribers is the
+///     server's cost per subscriber.
+///
+/// Used By:
+///     pong-server --spectators (server/main.cpp).
+///////////////////////////////////////////////////////////////
+class SpectatorBot {
+private:
+    SpectatorConfig config;
+    std::string error;
+    unsigned threadsUsed;
+
+    // Totals over the measured window
+    std::uint64_t framesReceived;
+    std::uint64_t framesUndecodable;
+    std::uint64_t ticksSkipped;
+    std::uint64_t matchesFinished;
+    std::size_t subscribersFed;              // Received a frame while measuring
+    std::vector<std::uint32_t> latencies;    // Microseconds, one per frame
+    std::vector<double> subscriberLatencies; // Mean per subscriber
+    std::vector<double> subscriberRates;     // Frames per second per subscriber
+
+    bool haveServerStats;
+    StatsMessage serverBefore;
+    StatsMessage serverAfter;
+
+public:
+    explicit SpectatorBot(const SpectatorConfig& config);
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: run()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Subscribes, runs warm-up and measured seconds, then
+    ///     unsubscribes.
+    ///
+    /// Return:
+    ///     bool – false if the address is invalid or a socket
+    ///            could not be opened or connected
+    ///            (see getError())
+    ///////////////////////////////////////////////////////////
+    bool run();
+
+
+    ///////////////////////////////////////////////////////////
+    /// Function: printReport(std::ostream& out)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Prints the subscriber-side and server-side results
+    ///     (sorts the latency samples).
+    ///////////////////////////////////////////////////////////
+    void printReport(std::ostream& out);
+
+    const std::string& getError() const;
+};
+
+#endif
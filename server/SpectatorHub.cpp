@@ -0,0 +1,901 @@
+#include "SpectatorHub.h"
+#include "GameServer.h"
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <random>
+
+namespace {
+    // epoll tags: the three hub descriptors, then FIRST_CONNECTION + subscriber id
+    const std::uint64_t UDP_TAG = 0;
+    const std::uint64_t LISTEN_TAG = 1;
+    const std::uint64_t WAKE_TAG = 2;
+    const std::uint64_t FIRST_CONNECTION = 3;
+
+    const int EPOLL_TIMEOUT_MS = 100;
+    const int EVENTS_PER_WAIT = 64;
+
+    // Keep-alive and featured-match checks
+    const std::chrono::milliseconds MAINTENANCE_PERIOD(100);
+
+    // recvmmsg batches per wakeup (as in the shards)
+    const int MAX_RECEIVE_BATCHES = 32;
+
+    // Frames gathered per sendmsg() on a TCP connection
+    const int WRITE_VECTORS = 64;
+
+    // Kernel send buffer of a TCP subscriber: small, so a stalled reader
+    // backs up into the hub's queue (where it is noticed) within seconds
+    const int TCP_SEND_BUFFER_BYTES = 8192;
+
+    // A UDP cookie is valid for the period it was made in and the next one
+    const std::chrono::seconds COOKIE_PERIOD(30);
+
+    std::uint64_t addressKey(const sockaddr_in& address) {
+        return std::uint64_t(address.sin_addr.s_addr) << 16 | address.sin_port;
+    }
+
+    std::uint64_t rotate(std::uint64_t value, int bits) {
+        return value << bits | value >> (64 - bits);
+    }
+
+    /*
+        SipHash-2-4 of one 64-bit word: a keyed hash whose outputs reveal
+        nothing usable about the key, so cookies cannot be forged.
+    */
+    std::uint64_t sipHash(const std::uint64_t key[2], std::uint64_t word) {
+        std::uint64_t v0 = key[0] ^ 0x736F6D6570736575ull;
+        std::uint64_t v1 = key[1] ^ 0x646F72616E646F6Dull;
+        std::uint64_t v2 = key[0] ^ 0x6C7967656E657261ull;
+        std::uint64_t v3 = key[1] ^ 0x7465646279746573ull;
+
+        auto rounds = [&](int count) {
+            for (int i = 0; i < count; ++i) {
+                v0 += v1; v1 = rotate(v1, 13); v1 ^= v0; v0 = rotate(v0, 32);
+                v2 += v3; v3 = rotate(v3, 16); v3 ^= v2;
+                v0 += v3; v3 = rotate(v3, 21); v3 ^= v0;
+                v2 += v1; v1 = rotate(v1, 17); v1 ^= v2; v2 = rotate(v2, 32);
+            }
+        };
+
+        const std::uint64_t last = 8ull << 56;       // Message length, no tail bytes
+        v3 ^= word; rounds(2); v0 ^= word;
+        v3 ^= last; rounds(2); v0 ^= last;
+        v2 ^= 0xFF; rounds(4);
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+
+    std::uint64_t threadCpuNanos() {
+        timespec now;
+        if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0)
+            return 0;
+        return std::uint64_t(now.tv_sec) * 1000000000ull + std::uint64_t(now.tv_nsec);
+    }
+}
+
+
+/*
+    Constructor: SpectatorHub::SpectatorHub(GameServer& server, const std::string& host,
+                                            std::uint16_t port, std::size_t maxSubscribers,
+                                            double idleTimeout)
+
+    Objective:
+        Store the settings and draw the cookie key; open() creates the
+        descriptors.
+*/
+SpectatorHub::SpectatorHub(GameServer& server, const std::string& host, std::uint16_t port,
+                           std::size_t maxSubscribers, double idleTimeout)
+    : server(server),
+      host(host),
+      port(port),
+      maxSubscribers(maxSubscribers),
+      idleTimeout(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(idleTimeout))),
+      udpFd(-1),
+      listenFd(-1),
+      wakeFd(-1),
+      epollFd(-1),
+      featuredCursor(0),
+      feedCounter(0),
+      subscriberCount(0),
+      kicks(0),
+      frames(0),
+      tcpBytes(0),
+      drops(0),
+      sharedSubscribers(0),
+      sharedKicks(0),
+      sharedFrames(0),
+      sharedBytes(0),
+      sharedDrops(0),
+      sharedCpuNanos(0)
+{
+    std::random_device entropy;
+    for (std::uint64_t& word : cookieKey)
+        word = std::uint64_t(entropy()) << 32 | entropy();
+}
+
+SpectatorHub::~SpectatorHub() {
+    for (const Subscriber& subscriber : subscribers)
+        if (subscriber.active && subscriber.fd >= 0) ::close(subscriber.fd);
+    if (epollFd >= 0) ::close(epollFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (listenFd >= 0) ::close(listenFd);
+    if (udpFd >= 0) ::close(udpFd);
+}
+
+
+/*
+    Function: bool SpectatorHub::open(std::string& error)
+
+    Objective:
+        Create the hub's sockets, eventfd and epoll set.
+
+    Input Parameters:
+        - std::string& error: Set on failure.
+
+    Return Value:
+        - bool: true on success.
+
+    Side Effects:
+        - Binds UDP and TCP host:port; creates descriptors (closed by the
+          destructor).
+*/
+bool SpectatorHub::open(std::string& error) {
+    udpFd = openUdpSocket(host, port, false, error);
+    if (udpFd < 0)
+        return false;
+    sender.setSocket(udpFd);
+
+    listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    sockaddr_in address;
+    parseAddress(host, port, address);
+    if (listenFd < 0
+        || ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one) != 0
+        || ::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0
+        || ::listen(listenFd, SOMAXCONN) != 0) {
+        error = "TCP port " + std::to_string(port) + ": " + std::strerror(errno);
+        return false;
+    }
+
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (wakeFd < 0 || epollFd < 0) {
+        error = std::string("eventfd/epoll: ") + std::strerror(errno);
+        return false;
+    }
+
+    const int fds[] = { udpFd, listenFd, wakeFd };
+    const std::uint64_t tags[] = { UDP_TAG, LISTEN_TAG, WAKE_TAG };
+    for (int i = 0; i < 3; ++i) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof event);
+        event.events = EPOLLIN;
+        event.data.u64 = tags[i];
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fds[i], &event) != 0) {
+            error = std::string("epoll: ") + std::strerror(errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+    Function: void SpectatorHub::run()
+
+    Objective:
+        The hub's event loop.
+
+    Side Effects:
+        - Runs until the server is stopping.
+
+    Approach:
+        - Handle subscriber traffic first, then fan out the blocks the
+          shards published, then (every MAINTENANCE_PERIOD) expire and
+          reassign subscribers.
+        - Ids freed while handling a batch of events are recycled only
+          after it, so a stale event cannot reach a new subscriber.
+*/
+void SpectatorHub::run() {
+    epoll_event events[EVENTS_PER_WAIT];
+    lastMaintenance = Clock::now();
+
+    while (!server.stopping.load(std::memory_order_relaxed)) {
+        int ready = ::epoll_wait(epollFd, events, EVENTS_PER_WAIT, EPOLL_TIMEOUT_MS);
+
+        for (int i = 0; i < ready; ++i) {
+            std::uint64_t tag = events[i].data.u64;
+            if (tag == UDP_TAG)
+                receiveUdp();
+            else if (tag == LISTEN_TAG)
+                acceptAll();
+            else if (tag == WAKE_TAG) {
+                std::uint64_t count;
+                ssize_t ignored = ::read(wakeFd, &count, sizeof count);
+                (void)ignored;
+            }
+            else {
+                std::uint32_t id = static_cast<std::uint32_t>(tag - FIRST_CONNECTION);
+                if (id >= subscribers.size() || !subscribers[id].active)
+                    continue;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    removeSubscriber(id);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN)
+                    readTcp(id);
+                if ((events[i].events & EPOLLOUT) && subscribers[id].active)
+                    flushTcp(id);
+            }
+        }
+
+        drainOutbox();
+
+        Clock::time_point now = Clock::now();
+        if (now - lastMaintenance >= MAINTENANCE_PERIOD) {
+            maintain(now);
+            lastMaintenance = now;
+        }
+
+        freeIds.insert(freeIds.end(), released.begin(), released.end());
+        released.clear();
+        publishStats();
+    }
+}
+
+
+/*
+    Function: void SpectatorHub::publish(std::shared_ptr<const FrameBlock> block)
+
+    Objective:
+        Queue a shard's frames for the hub thread and wake it.
+*/
+void SpectatorHub::publish(std::shared_ptr<const FrameBlock> block) {
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        outbox.push_back(std::move(block));
+    }
+    std::uint64_t one = 1;
+    ssize_t ignored = ::write(wakeFd, &one, sizeof one);
+    (void)ignored;
+}
+
+
+/*
+    Function: void SpectatorHub::drainOutbox()
+
+    Objective:
+        Fan out every published block, then send.
+
+    Approach:
+        - Take the whole outbox under the lock, fan out without it.
+        - UDP frames go out in one sendmmsg() series; TCP subscribers that
+          got frames are written once each.
+*/
+void SpectatorHub::drainOutbox() {
+    std::vector<std::shared_ptr<const FrameBlock>> blocks;
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        blocks.swap(outbox);
+    }
+
+    for (const std::shared_ptr<const FrameBlock>& block : blocks)
+        fanOut(block);
+    flushUdp();
+
+    for (std::uint32_t id : dirty)
+        if (subscribers[id].active)
+            flushTcp(id);
+    dirty.clear();
+}
+
+
+/*
+    Function: void SpectatorHub::fanOut(const std::shared_ptr<const FrameBlock>& block)
+
+    Objective:
+        Hand each frame of a block to the subscribers of its match.
+
+    Side Effects:
+        - Remembers keyframes for late joiners; ends the feed of a
+          finished match after its final frame.
+*/
+void SpectatorHub::fanOut(const std::shared_ptr<const FrameBlock>& block) {
+    for (std::size_t i = 0; i < block->frames.size(); ++i) {
+        const SpectatorFrame& frame = block->frames[i];
+        auto found = feeds.find(frame.matchId);
+        if (found == feeds.end())
+            continue;
+
+        MatchFeed& feed = found->second;
+        if (frame.keyframe) {
+            feed.keyBlock = block;
+            feed.keyIndex = static_cast<std::uint32_t>(i);
+        }
+        for (std::uint32_t id : feed.subscribers)
+            deliver(id, block, frame);
+        if (frame.finished)
+            endFeed(frame.matchId);
+    }
+}
+
+
+/*
+    Function: void SpectatorHub::deliver(std::uint32_t id,
+                                         const std::shared_ptr<const FrameBlock>& block,
+                                         const SpectatorFrame& frame)
+
+    Objective:
+        Send one frame to one subscriber, or drop it if the subscriber is
+        behind.
+
+    Approach:
+        - UDP: queue the message bytes in the send batch (no copy).
+        - TCP: queue a reference; a full queue drops the frame, and a
+          dropped keyframe makes the following deltas worthless until the
+          next keyframe.
+*/
+void SpectatorHub::deliver(std::uint32_t id, const std::shared_ptr<const FrameBlock>& block,
+                           const SpectatorFrame& frame) {
+    Subscriber& subscriber = subscribers[id];
+    if (subscriber.fd < 0) {
+        sendShared(subscriber.address, block, frame.offset + STREAM_PREFIX_BYTES, frame.size - STREAM_PREFIX_BYTES);
+        frames++;
+        return;
+    }
+
+    if (subscriber.needKeyframe && !frame.keyframe) {
+        drops++;
+        return;
+    }
+    if (subscriber.queue.size() >= SPECTATOR_QUEUE_FRAMES) {
+        drops++;
+        if (frame.keyframe)
+            subscriber.needKeyframe = true;
+        if (!subscriber.behind) {
+            subscriber.behind = true;
+            subscriber.behindSince = Clock::now();
+        }
+        return;
+    }
+
+    subscriber.needKeyframe = false;
+    if (subscriber.queue.empty())
+        dirty.push_back(id);
+    subscriber.queue.push_back({ block, frame.offset, frame.size });
+    frames++;
+}
+
+
+/*
+    Function: void SpectatorHub::endFeed(std::uint32_t matchId)
+
+    Objective:
+        Close the feed of a finished match: its subscribers are
+        unsubscribed, those following ANY_MATCH move on.
+*/
+void SpectatorHub::endFeed(std::uint32_t matchId) {
+    auto found = feeds.find(matchId);
+    if (found == feeds.end())
+        return;
+
+    std::vector<std::uint32_t> watchers;
+    watchers.swap(found->second.subscribers);
+    feeds.erase(found);
+    server.watchMatch(matchId, 0);
+
+    for (std::uint32_t id : watchers) {
+        subscribers[id].matchId = NO_MATCH;
+        if (subscribers[id].any)
+            subscribe(id, ANY_MATCH);
+    }
+}
+
+
+/*
+    Functions: sendShared / flushUdp
+
+    Objective:
+        Queue a datagram that points into a frame block, keeping the block
+        alive until the batch is sent.
+*/
+void SpectatorHub::sendShared(const sockaddr_in& to, const std::shared_ptr<const FrameBlock>& block,
+                              std::size_t offset, std::size_t size) {
+    if (inFlight.empty() || inFlight.back() != block)
+        inFlight.push_back(block);
+    sender.pushShared(to, block->bytes.data() + offset, size);
+}
+
+void SpectatorHub::flushUdp() {
+    sender.flush();
+    inFlight.clear();
+}
+
+
+/*
+    Function: void SpectatorHub::receiveUdp()
+
+    Objective:
+        Handle SUBSCRIBE / UNSUBSCRIBE datagrams.
+
+    Approach:
+        - A subscriber is its address; the first SUBSCRIBE carrying a
+          valid cookie creates it, every later datagram counts as a
+          keep-alive.
+        - SUBSCRIBE from an unknown address without one is answered with
+          a COOKIE only: 7 bytes for 11, so nothing is amplified and
+          frames go only to addresses that proved they receive.
+*/
+void SpectatorHub::receiveUdp() {
+    for (int batch = 0; batch < MAX_RECEIVE_BATCHES; ++batch) {
+        std::size_t count = receiver.receive(udpFd);
+        if (count == 0)
+            break;
+
+        Clock::time_point now = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint8_t* data = receiver.datagram(i);
+            std::size_t size = receiver.size(i);
+            MessageType type = messageType(data, size);
+            if (type != MessageType::SUBSCRIBE && type != MessageType::UNSUBSCRIBE)
+                continue;
+
+            const sockaddr_in& from = receiver.sender(i);
+            std::uint32_t id;
+            auto found = udpIds.find(addressKey(from));
+            if (found != udpIds.end())
+                id = found->second;
+            else {
+                SubscribeMessage subscribe;
+                if (type != MessageType::SUBSCRIBE || !decodeMessage(data, size, subscribe))
+                    continue;
+                if (!checkCookie(from, subscribe.cookie, now)) {
+                    std::uint64_t period = static_cast<std::uint64_t>(now.time_since_epoch() / COOKIE_PERIOD);
+                    CookieMessage cookie = { makeCookie(from, period) };
+                    sender.push(from, encodeMessage(cookie, sender.buffer()));
+                    continue;
+                }
+                id = addSubscriber(-1, from);
+                if (id == NO_MATCH)
+                    continue;
+                udpIds.emplace(addressKey(from), id);
+            }
+
+            subscribers[id].lastSeen = now;
+            handleMessage(id, data, size);
+        }
+    }
+    flushUdp();
+}
+
+
+/*
+    Function: std::uint32_t SpectatorHub::makeCookie(const sockaddr_in& address,
+                                                     std::uint64_t period) const
+
+    Objective:
+        The cookie of an address in a COOKIE_PERIOD time slot.
+*/
+std::uint32_t SpectatorHub::makeCookie(const sockaddr_in& address, std::uint64_t period) const {
+    return static_cast<std::uint32_t>(sipHash(cookieKey, addressKey(address) | period << 48));
+}
+
+
+/*
+    Function: bool SpectatorHub::checkCookie(const sockaddr_in& address, std::uint32_t cookie,
+                                             Clock::time_point now) const
+
+    Objective:
+        Whether a SUBSCRIBE's cookie was issued to its sender recently.
+
+    Approach:
+        - Made in the current period or the one before, so a cookie
+          stays good for COOKIE_PERIOD to 2 * COOKIE_PERIOD.
+*/
+bool SpectatorHub::checkCookie(const sockaddr_in& address, std::uint32_t cookie, Clock::time_point now) const {
+    std::uint64_t period = static_cast<std::uint64_t>(now.time_since_epoch() / COOKIE_PERIOD);
+    return cookie == makeCookie(address, period) || cookie == makeCookie(address, period - 1);
+}
+
+
+/*
+    Function: void SpectatorHub::acceptAll()
+
+    Objective:
+        Accept waiting TCP connections (beyond maxSubscribers they are
+        closed at once).
+*/
+void SpectatorHub::acceptAll() {
+    for (;;) {
+        sockaddr_in address;
+        socklen_t length = sizeof address;
+        int fd = ::accept4(listenFd, reinterpret_cast<sockaddr*>(&address), &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &TCP_SEND_BUFFER_BYTES, sizeof TCP_SEND_BUFFER_BYTES);
+
+        std::uint32_t id = addSubscriber(fd, address);
+        if (id == NO_MATCH) {
+            ::close(fd);
+            continue;
+        }
+
+        epoll_event event;
+        std::memset(&event, 0, sizeof event);
+        event.events = EPOLLIN;
+        event.data.u64 = FIRST_CONNECTION + id;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+            removeSubscriber(id);
+    }
+}
+
+
+/*
+    Function: void SpectatorHub::readTcp(std::uint32_t id)
+
+    Objective:
+        Read a TCP subscriber's messages (length-prefixed).
+
+    Side Effects:
+        - Disconnects on end of stream, error or a bad length.
+*/
+void SpectatorHub::readTcp(std::uint32_t id) {
+    Subscriber& subscriber = subscribers[id];
+
+    for (;;) {
+        ssize_t received = ::recv(subscriber.fd, subscriber.input + subscriber.inputSize,
+                                  sizeof subscriber.input - subscriber.inputSize, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        if (received <= 0) {
+            removeSubscriber(id);
+            return;
+        }
+        subscriber.inputSize += static_cast<std::size_t>(received);
+
+        std::size_t position = 0;
+        while (subscriber.inputSize - position >= STREAM_PREFIX_BYTES) {
+            std::size_t length = subscriber.input[position] | std::size_t(subscriber.input[position + 1]) << 8;
+            if (length == 0 || length > MAX_DATAGRAM) {
+                removeSubscriber(id);
+                return;
+            }
+            if (subscriber.inputSize - position - STREAM_PREFIX_BYTES < length)
+                break;
+            handleMessage(id, subscriber.input + position + STREAM_PREFIX_BYTES, length);
+            position += STREAM_PREFIX_BYTES + length;
+        }
+        std::memmove(subscriber.input, subscriber.input + position, subscriber.inputSize - position);
+        subscriber.inputSize -= position;
+    }
+}
+
+
+/*
+    Function: bool SpectatorHub::flushTcp(std::uint32_t id)
+
+    Objective:
+        Write as much of a TCP subscriber's queue as the socket takes.
+
+    Return Value:
+        - bool: false if the subscriber was disconnected.
+
+    Approach:
+        - sendmsg() with one iovec per queued frame (straight from the
+          shared blocks); a partial write leaves the rest of a frame at
+          the front of the queue.
+        - EPOLLOUT is watched only while data is waiting.
+*/
+bool SpectatorHub::flushTcp(std::uint32_t id) {
+    Subscriber& subscriber = subscribers[id];
+
+    while (!subscriber.queue.empty()) {
+        iovec vectors[WRITE_VECTORS];
+        int count = 0;
+        for (auto it = subscriber.queue.begin(); it != subscriber.queue.end() && count < WRITE_VECTORS; ++it, ++count) {
+            vectors[count].iov_base = const_cast<std::uint8_t*>(it->block->bytes.data() + it->offset);
+            vectors[count].iov_len = it->size;
+        }
+
+        msghdr message;
+        std::memset(&message, 0, sizeof message);
+        message.msg_iov = vectors;
+        message.msg_iovlen = static_cast<std::size_t>(count);
+        ssize_t written = ::sendmsg(subscriber.fd, &message, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!subscriber.writeWait) {
+                epoll_event event;
+                std::memset(&event, 0, sizeof event);
+                event.events = EPOLLIN | EPOLLOUT;
+                event.data.u64 = FIRST_CONNECTION + id;
+                ::epoll_ctl(epollFd, EPOLL_CTL_MOD, subscriber.fd, &event);
+                subscriber.writeWait = true;
+            }
+            return true;
+        }
+        if (written < 0) {
+            removeSubscriber(id);
+            return false;
+        }
+
+        tcpBytes += static_cast<std::uint64_t>(written);
+        std::size_t left = static_cast<std::size_t>(written);
+        while (left > 0) {
+            PendingFrame& front = subscriber.queue.front();
+            if (left >= front.size) {
+                left -= front.size;
+                subscriber.queue.pop_front();
+            }
+            else {
+                front.offset += static_cast<std::uint32_t>(left);
+                front.size -= static_cast<std::uint32_t>(left);
+                left = 0;
+            }
+        }
+    }
+
+    if (subscriber.writeWait) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof event);
+        event.events = EPOLLIN;
+        event.data.u64 = FIRST_CONNECTION + id;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, subscriber.fd, &event);
+        subscriber.writeWait = false;
+    }
+    subscriber.behind = false;
+    return true;
+}
+
+
+/*
+    Function: void SpectatorHub::handleMessage(std::uint32_t id, const std::uint8_t* data,
+                                               std::size_t size)
+
+    Objective:
+        Apply a subscriber's request; malformed messages are ignored.
+*/
+void SpectatorHub::handleMessage(std::uint32_t id, const std::uint8_t* data, std::size_t size) {
+    switch (messageType(data, size)) {
+    case MessageType::SUBSCRIBE: {
+        SubscribeMessage message;
+        if (decodeMessage(data, size, message))
+            subscribe(id, message.matchId);
+        break;
+    }
+    case MessageType::UNSUBSCRIBE:
+        if (subscribers[id].fd < 0)
+            removeSubscriber(id);
+        else {
+            leaveFeed(id);
+            subscribers[id].any = false;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+
+/*
+    Function: std::uint32_t SpectatorHub::addSubscriber(int fd, const sockaddr_in& address)
+
+    Objective:
+        Take an id for a new subscriber.
+
+    Return Value:
+        - std::uint32_t: The id, NO_MATCH if maxSubscribers are connected.
+*/
+std::uint32_t SpectatorHub::addSubscriber(int fd, const sockaddr_in& address) {
+    if (subscriberCount >= maxSubscribers)
+        return NO_MATCH;
+
+    std::uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else {
+        id = static_cast<std::uint32_t>(subscribers.size());
+        subscribers.emplace_back();
+    }
+
+    Subscriber& subscriber = subscribers[id];
+    subscriber.fd = fd;
+    subscriber.address = address;
+    subscriber.matchId = NO_MATCH;
+    subscriber.active = true;
+    subscriber.any = false;
+    subscriber.needKeyframe = false;
+    subscriber.writeWait = false;
+    subscriber.behind = false;
+    subscriber.lastSeen = Clock::now();
+    subscriber.queue.clear();
+    subscriber.inputSize = 0;
+    subscriberCount++;
+    return id;
+}
+
+
+/*
+    Function: void SpectatorHub::removeSubscriber(std::uint32_t id)
+
+    Objective:
+        Forget a subscriber: leave its feed, close its connection.
+*/
+void SpectatorHub::removeSubscriber(std::uint32_t id) {
+    Subscriber& subscriber = subscribers[id];
+    leaveFeed(id);
+    if (subscriber.fd >= 0) {
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, subscriber.fd, nullptr);
+        ::close(subscriber.fd);
+        subscriber.fd = -1;
+    }
+    else
+        udpIds.erase(addressKey(subscriber.address));
+
+    subscriber.active = false;
+    subscriber.queue.clear();
+    released.push_back(id);
+    subscriberCount--;
+}
+
+
+/*
+    Function: void SpectatorHub::subscribe(std::uint32_t id, std::uint32_t matchId)
+
+    Objective:
+        Move a subscriber to a match's feed.
+
+    Side Effects:
+        - A new feed tells the shard to start producing frames; an
+          existing one sends its latest keyframe to the newcomer.
+
+    Approach:
+        - ANY_MATCH keeps the current match if there is one (a repeated
+          SUBSCRIBE is a keep-alive), else takes a featured match, round
+          robin over the shards; with none live it stays unassigned and
+          maintain() retries.
+        - An unknown match id leaves the subscriber without a feed.
+*/
+void SpectatorHub::subscribe(std::uint32_t id, std::uint32_t matchId) {
+    Subscriber& subscriber = subscribers[id];
+    subscriber.any = matchId == ANY_MATCH;
+
+    std::uint32_t target = matchId;
+    if (subscriber.any) {
+        if (subscriber.matchId != NO_MATCH)
+            return;
+        target = server.featuredMatch(featuredCursor);
+    }
+    if (target == subscriber.matchId)
+        return;
+
+    leaveFeed(id);
+    if (target == NO_MATCH)
+        return;
+
+    auto found = feeds.find(target);
+    if (found == feeds.end()) {
+        if (++feedCounter == 0)
+            ++feedCounter;
+        if (!server.watchMatch(target, feedCounter))
+            return;
+        MatchFeed feed;
+        feed.keyIndex = 0;
+        found = feeds.emplace(target, std::move(feed)).first;
+    }
+
+    MatchFeed& feed = found->second;
+    feed.subscribers.push_back(id);
+    subscriber.matchId = target;
+    subscriber.needKeyframe = false;
+    if (feed.keyBlock)
+        deliver(id, feed.keyBlock, feed.keyBlock->frames[feed.keyIndex]);
+}
+
+
+/*
+    Function: void SpectatorHub::leaveFeed(std::uint32_t id)
+
+    Objective:
+        Take a subscriber off its feed; the last one out closes the feed
+        and the shard stops producing frames for the match.
+*/
+void SpectatorHub::leaveFeed(std::uint32_t id) {
+    Subscriber& subscriber = subscribers[id];
+    if (subscriber.matchId == NO_MATCH)
+        return;
+
+    auto found = feeds.find(subscriber.matchId);
+    if (found != feeds.end()) {
+        std::vector<std::uint32_t>& list = found->second.subscribers;
+        auto position = std::find(list.begin(), list.end(), id);
+        if (position != list.end()) {
+            *position = list.back();
+            list.pop_back();
+        }
+        if (list.empty()) {
+            server.watchMatch(subscriber.matchId, 0);
+            feeds.erase(found);
+        }
+    }
+    subscriber.matchId = NO_MATCH;
+}
+
+
+/*
+    Function: void SpectatorHub::maintain(Clock::time_point now)
+
+    Objective:
+        Periodic pass over the subscribers.
+
+    Side Effects:
+        - Forgets UDP subscribers silent for the idle timeout.
+        - Disconnects TCP subscribers behind for the idle timeout.
+        - Gives unassigned ANY_MATCH subscribers a featured match.
+*/
+void SpectatorHub::maintain(Clock::time_point now) {
+    for (std::uint32_t id = 0; id < subscribers.size(); ++id) {
+        Subscriber& subscriber = subscribers[id];
+        if (!subscriber.active)
+            continue;
+
+        if (subscriber.fd < 0 && now - subscriber.lastSeen > idleTimeout) {
+            removeSubscriber(id);
+            continue;
+        }
+        if (subscriber.fd >= 0 && subscriber.behind && now - subscriber.behindSince > idleTimeout) {
+            kicks++;
+            removeSubscriber(id);
+            continue;
+        }
+        if (subscriber.any && subscriber.matchId == NO_MATCH)
+            subscribe(id, ANY_MATCH);
+    }
+    flushUdp();
+}
+
+
+/*
+    Function: void SpectatorHub::publishStats()
+
+    Objective:
+        Copy the hub counters to the atomics read by addStats().
+*/
+void SpectatorHub::publishStats() {
+    sharedSubscribers.store(subscriberCount, std::memory_order_relaxed);
+    sharedKicks.store(kicks, std::memory_order_relaxed);
+    sharedFrames.store(frames, std::memory_order_relaxed);
+    sharedBytes.store(tcpBytes + sender.getBytes(), std::memory_order_relaxed);
+    sharedDrops.store(drops + sender.getDropped(), std::memory_order_relaxed);
+    sharedCpuNanos.store(threadCpuNanos(), std::memory_order_relaxed);
+}
+
+
+/*
+    Function: void SpectatorHub::addStats(StatsMessage& total) const
+
+    Objective:
+        Add the published spectator counters to server statistics.
+*/
+void SpectatorHub::addStats(StatsMessage& total) const {
+    total.spectators += sharedSubscribers.load(std::memory_order_relaxed);
+    total.spectatorKicks += sharedKicks.load(std::memory_order_relaxed);
+    total.spectatorFrames += sharedFrames.load(std::memory_order_relaxed);
+    total.spectatorBytes += sharedBytes.load(std::memory_order_relaxed);
+    total.spectatorDrops += sharedDrops.load(std::memory_order_relaxed);
+    total.spectatorCpuMicros += sharedCpuNanos.load(std::memory_order_relaxed) / 1000;
+}
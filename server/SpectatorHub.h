@@ -0,0 +1,253 @@
+#ifndef SPECTATOR_HUB_H
+#define SPECTATOR_HUB_H
+
+#include <netinet/in.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "NetProtocol.h"
+#include "UdpIo.h"
+
+///////////////////////////////////////////////////////////////
+/// Constants: spectator feed
+/// ----------------------------------------------------------
+/// SPECTATOR_KEYFRAME_TICKS – a watched match sends a
+///                            keyframe at least this often;
+///                            the frames between are deltas
+///                            against it (must stay below
+///                            SNAPSHOT_HISTORY)
+/// SPECTATOR_FRAME_BYTES    – largest frame, TCP prefix
+///                            included
+///////////////////////////////////////////////////////////////
+const std::uint32_t SPECTATOR_KEYFRAME_TICKS = 30;
+const std::size_t SPECTATOR_FRAME_BYTES = STREAM_PREFIX_BYTES + 16 + SNAPSHOT_MAX_BYTES;
+
+///////////////////////////////////////////////////////////////
+/// Struct: FrameBlock
+/// ----------------------------------------------------------
+/// Objective:
+///     The spectator frames one shard produced in one tick,
+///     serialized once and shared (read-only) by every
+///     subscriber they are sent to.
+///
+/// Description:
+///     Each frame is a FRAME message preceded by its TCP
+///     length prefix: TCP subscribers are sent the whole
+///     range, UDP subscribers the message after the prefix.
+///     The block lives as long as a socket queue or a send
+///     batch still refers to it.
+///////////////////////////////////////////////////////////////
+struct SpectatorFrame {
+    std::uint32_t matchId;
+    std::uint32_t offset;        // Of the length prefix in FrameBlock::bytes
+    std::uint16_t size;          // Prefix included
+    bool keyframe;
+    bool finished;               // StateFlag::FINISHED: the match is over
+};
+
+struct FrameBlock {
+    std::vector<std::uint8_t> bytes;
+    std::vector<SpectatorFrame> frames;
+};
+
+class GameServer;
+
+///////////////////////////////////////////////////////////////
+/// Class: SpectatorHub
+/// ----------------------------------------------------------
+/// Objective:
+///     Fans the state of live matches out to spectators over
+///     UDP and TCP, on a thread of its own beside the shards.
+///
+/// Description:
+///     A spectator sends SUBSCRIBE with a match id, or
+///     ANY_MATCH to follow the match the server features.
+///     While a match has subscribers, its shard serializes
+///     one FRAME per tick into the tick's FrameBlock and
+///     hands the block over with publish(); the hub then
+///     only queues references to the shared bytes: iovecs
+///     into the block for sendmmsg (UDP) and writev (TCP).
+///     Serialization cost is per watched match, not per
+///     subscriber.
+///
+///     Late join: the hub keeps each match's latest keyframe
+///     block and sends that first, so a new subscriber can
+///     decode the next delta.
+///
+///     Slow consumers (TCP): a subscriber whose queue holds
+///     SPECTATOR_QUEUE_FRAMES misses frames; if it misses a
+///     keyframe, the deltas until the next one are skipped
+///     too (it could not decode them). One that stays behind
+///     for the idle timeout is disconnected. UDP subscribers
+///     are never queued: the socket buffer drops instead.
+///
+///     When a FINISHED frame is forwarded the subscription
+///     ends; ANY_MATCH subscribers move to the next featured
+///     match. UDP subscribers repeat SUBSCRIBE at least every
+///     idle timeout or are forgotten.
+///
+///     Spoofing: the hub listens on loopback unless given
+///     another host, and a UDP SUBSCRIBE from an unknown
+///     address only gets a COOKIE back (a keyed hash of the
+///     address and the time, smaller than the request).
+///     Frames start once SUBSCRIBE returns with a current
+///     cookie, so a forged sender address cannot be made the
+///     target of a stream.
+///
+/// Used By:
+///     GameServer (ServerConfig::spectatorPort).
+///////////////////////////////////////////////////////////////
+class SpectatorHub {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /*
+        A reference to one frame (or the unsent rest of it) in a
+        TCP subscriber's queue.
+    */
+    struct PendingFrame {
+        std::shared_ptr<const FrameBlock> block;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    struct Subscriber {
+        int fd;                              // TCP connection, -1 for UDP
+        sockaddr_in address;
+        std::uint32_t matchId;               // Current feed, NO_MATCH if none
+        bool active;
+        bool any;                            // Subscribed to ANY_MATCH
+        bool needKeyframe;                   // Missed a keyframe: skip deltas
+        bool writeWait;                      // EPOLLOUT registered
+        bool behind;                         // Dropped frames since the queue last drained
+        Clock::time_point lastSeen;          // UDP keep-alive
+        Clock::time_point behindSince;
+        std::deque<PendingFrame> queue;      // TCP only
+        std::uint8_t input[2 * MAX_DATAGRAM];  // TCP receive buffer
+        std::size_t inputSize;
+    };
+
+    struct MatchFeed {
+        std::vector<std::uint32_t> subscribers;
+        std::shared_ptr<const FrameBlock> keyBlock;  // Latest keyframe
+        std::uint32_t keyIndex;
+    };
+
+    GameServer& server;
+    std::string host;
+    std::uint16_t port;
+    std::size_t maxSubscribers;
+    Clock::duration idleTimeout;
+    std::uint64_t cookieKey[2];              // Random per process
+
+    int udpFd;
+    int listenFd;
+    int wakeFd;                              // eventfd written by publish()
+    int epollFd;
+
+    std::vector<Subscriber> subscribers;     // Index = subscriber id
+    std::vector<std::uint32_t> freeIds;
+    std::vector<std::uint32_t> released;     // Freed during this event batch
+    std::unordered_map<std::uint64_t, std::uint32_t> udpIds;   // Address → id
+    std::unordered_map<std::uint32_t, MatchFeed> feeds;        // Match id → feed
+    std::vector<std::uint32_t> dirty;        // TCP subscribers with new frames
+    SendBatch sender;
+    ReceiveBatch receiver;
+    unsigned featuredCursor;
+    std::uint32_t feedCounter;
+    std::vector<std::shared_ptr<const FrameBlock>> inFlight;   // Referenced by sender
+    Clock::time_point lastMaintenance;
+
+    std::mutex outboxMutex;
+    std::vector<std::shared_ptr<const FrameBlock>> outbox;
+
+    // Hub-thread counters, published once per loop
+    std::uint32_t subscriberCount;
+    std::uint32_t kicks;
+    std::uint64_t frames;
+    std::uint64_t tcpBytes;
+    std::uint64_t drops;
+
+    std::atomic<std::uint32_t> sharedSubscribers;
+    std::atomic<std::uint32_t> sharedKicks;
+    std::atomic<std::uint64_t> sharedFrames;
+    std::atomic<std::uint64_t> sharedBytes;
+    std::atomic<std::uint64_t> sharedDrops;
+    std::atomic<std::uint64_t> sharedCpuNanos;
+
+public:
+    static constexpr std::uint32_t NO_MATCH = 0xFFFFFFFFu;
+    static constexpr std::size_t SPECTATOR_QUEUE_FRAMES = 60;
+
+    SpectatorHub(GameServer& server, const std::string& host, std::uint16_t port,
+                 std::size_t maxSubscribers, double idleTimeout);
+    ~SpectatorHub();
+
+    SpectatorHub(const SpectatorHub&) = delete;
+    SpectatorHub& operator=(const SpectatorHub&) = delete;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: open(std::string& error)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Binds the UDP socket and the TCP listener (same
+    ///     host and port number) and creates the wake-up
+    ///     eventfd.
+    ///////////////////////////////////////////////////////////
+    bool open(std::string& error);
+
+    ///////////////////////////////////////////////////////////
+    /// Function: run()
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     The hub thread: serves subscribers until the server
+    ///     is stopping.
+    ///////////////////////////////////////////////////////////
+    void run();
+
+    ///////////////////////////////////////////////////////////
+    /// Function: publish(std::shared_ptr<const FrameBlock> block)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Hands a tick's frames to the hub (shard threads;
+    ///     one short lock and an eventfd write per call).
+    ///////////////////////////////////////////////////////////
+    void publish(std::shared_ptr<const FrameBlock> block);
+
+    // Adds the spectator counters to server statistics (any thread)
+    void addStats(StatsMessage& total) const;
+
+private:
+    void drainOutbox();
+    void fanOut(const std::shared_ptr<const FrameBlock>& block);
+    void deliver(std::uint32_t id, const std::shared_ptr<const FrameBlock>& block, const SpectatorFrame& frame);
+    void endFeed(std::uint32_t matchId);
+
+    void sendShared(const sockaddr_in& to, const std::shared_ptr<const FrameBlock>& block,
+                    std::size_t offset, std::size_t size);
+    void flushUdp();
+
+    void receiveUdp();
+    std::uint32_t makeCookie(const sockaddr_in& address, std::uint64_t period) const;
+    bool checkCookie(const sockaddr_in& address, std::uint32_t cookie, Clock::time_point now) const;
+    void acceptAll();
+    void readTcp(std::uint32_t id);
+    bool flushTcp(std::uint32_t id);
+    void handleMessage(std::uint32_t id, const std::uint8_t* data, std::size_t size);
+
+    std::uint32_t addSubscriber(int fd, const sockaddr_in& address);
+    void removeSubscriber(std::uint32_t id);
+    void subscribe(std::uint32_t id, std::uint32_t matchId);
+    void leaveFeed(std::uint32_t id);
+    void maintain(Clock::time_point now);
+    void publishStats();
+};
+
+#endif
@@ -0,0 +1,279 @@
+#include "UdpIo.h"
+#include "NetProtocol.h"
+#include <arpa/inet.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+    // Kernel socket buffers: several ticks of traffic for a full shard
+    const int SOCKET_BUFFER_BYTES = 8 << 20;
+}
+
+
+/*
+    Function: int openUdpSocket(const std::string& host, std::uint16_t port, bool reusePort,
+                                std::string& error)
+
+    Objective:
+        Open and bind a non-blocking UDP socket.
+
+    Input Parameters:
+        - const std::string& host: Local IPv4 address (ANY_HOST = all interfaces).
+        - std::uint16_t port: Local port (0 = ephemeral).
+        - bool reusePort: Share the port with other sockets (SO_REUSEPORT).
+        - std::string& error: Set on failure.
+
+    Return Value:
+        - int: Socket descriptor, -1 on failure.
+
+    Side Effects:
+        - Creates a socket.
+
+    Approach:
+        - Buffer sizes are a request; the kernel caps them at
+          net.core.rmem_max / wmem_max.
+*/
+int openUdpSocket(const std::string& host, std::uint16_t port, bool reusePort, std::string& error) {
+    sockaddr_in address;
+    if (!parseAddress(host, port, address)) {
+        error = "invalid IPv4 address '" + host + "'";
+        return -1;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return -1;
+    }
+
+    int one = 1;
+    if (reusePort && ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof one) != 0) {
+        error = std::string("SO_REUSEPORT: ") + std::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_BYTES, sizeof SOCKET_BUFFER_BYTES);
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER_BYTES, sizeof SOCKET_BUFFER_BYTES);
+
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof address) != 0) {
+        error = "bind " + host + ":" + std::to_string(port) + ": " + std::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+
+/*
+    Function: bool parseAddress(const std::string& host, std::uint16_t port, sockaddr_in& out)
+
+    Objective:
+        Build an IPv4 socket address.
+
+    Return Value:
+        - bool: false if host is not a dotted IPv4 address.
+*/
+bool parseAddress(const std::string& host, std::uint16_t port, sockaddr_in& out) {
+    std::memset(&out, 0, sizeof out);
+    out.sin_family = AF_INET;
+    out.sin_port = htons(port);
+    return ::inet_pton(AF_INET, host.c_str(), &out.sin_addr) == 1;
+}
+
+
+/*
+    Function: bool requestServerStats(const std::string& host, std::uint16_t port, StatsMessage& stats)
+
+    Objective:
+        Query a server's statistics.
+
+    Return Value:
+        - bool: false if the server did not answer.
+
+    Approach:
+        - Own socket, STATS_REQUEST, poll() for the reply; 3 attempts.
+*/
+bool requestServerStats(const std::string& host, std::uint16_t port, StatsMessage& stats) {
+    sockaddr_in server;
+    std::string ignored;
+    int fd = openUdpSocket(ANY_HOST, 0, false, ignored);
+    if (fd < 0 || !parseAddress(host, port, server)) {
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    bool ok = false;
+    std::uint8_t buffer[MAX_DATAGRAM];
+    for (int attempt = 0; attempt < 3 && !ok; ++attempt) {
+        std::size_t length = encodeStatsRequest(buffer);
+        ::sendto(fd, buffer, length, 0, reinterpret_cast<const sockaddr*>(&server), sizeof server);
+
+        pollfd waiting = { fd, POLLIN, 0 };
+        if (::poll(&waiting, 1, 300) <= 0)
+            continue;
+        ssize_t received = ::recv(fd, buffer, sizeof buffer, 0);
+        ok = received > 0 && decodeMessage(buffer, static_cast<std::size_t>(received), stats);
+    }
+    ::close(fd);
+    return ok;
+}
+
+
+/*
+    SendBatch members
+
+    Objective:
+        Batch outgoing datagrams into sendmmsg() calls.
+*/
+SendBatch::SendBatch(int socket)
+    : socket(socket),
+      count(0),
+      data(SEND_BATCH * MAX_DATAGRAM),
+      addresses(SEND_BATCH),
+      vectors(SEND_BATCH),
+      headers(SEND_BATCH),
+      packets(0),
+      bytes(0),
+      dropped(0)
+{
+    std::memset(headers.data(), 0, headers.size() * sizeof(mmsghdr));
+    for (std::size_t i = 0; i < SEND_BATCH; ++i) {
+        vectors[i].iov_base = &data[i * MAX_DATAGRAM];
+        headers[i].msg_hdr.msg_iov = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = &addresses[i];
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+}
+
+void SendBatch::setSocket(int socket) {
+    this->socket = socket;
+}
+
+std::uint8_t* SendBatch::buffer() {
+    return &data[count * MAX_DATAGRAM];
+}
+
+void SendBatch::push(const sockaddr_in& to, std::size_t size) {
+    addresses[count] = to;
+    vectors[count].iov_base = &data[count * MAX_DATAGRAM];
+    vectors[count].iov_len = size;
+    if (++count == SEND_BATCH)
+        flush();
+}
+
+void SendBatch::pushShared(const sockaddr_in& to, const std::uint8_t* data, std::size_t size) {
+    addresses[count] = to;
+    vectors[count].iov_base = const_cast<std::uint8_t*>(data);
+    vectors[count].iov_len = size;
+    if (++count == SEND_BATCH)
+        flush();
+}
+
+/*
+    Function: void SendBatch::flush()
+
+    Objective:
+        Send all queued datagrams.
+
+    Side Effects:
+        - System calls; updates the counters.
+
+    Approach:
+        - sendmmsg() may send part of the batch: continue after the sent
+          ones; EINTR retries, any other error (EAGAIN: socket buffer full)
+          drops the remainder.
+*/
+void SendBatch::flush() {
+    std::size_t sent = 0;
+    while (sent < count) {
+        int result = ::sendmmsg(socket, &headers[sent], static_cast<unsigned>(count - sent), 0);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            dropped += count - sent;
+            break;
+        }
+        for (int i = 0; i < result; ++i)
+            bytes += vectors[sent + i].iov_len;
+        packets += static_cast<std::uint64_t>(result);
+        sent += static_cast<std::size_t>(result);
+    }
+    count = 0;
+}
+
+std::uint64_t SendBatch::getPackets() const {
+    return packets;
+}
+
+std::uint64_t SendBatch::getBytes() const {
+    return bytes;
+}
+
+std::uint64_t SendBatch::getDropped() const {
+    return dropped;
+}
+
+
+/*
+    ReceiveBatch members
+
+    Objective:
+        Drain a socket with recvmmsg() calls.
+*/
+ReceiveBatch::ReceiveBatch()
+    : data(RECEIVE_BATCH * MAX_DATAGRAM),
+      addresses(RECEIVE_BATCH),
+      vectors(RECEIVE_BATCH),
+      headers(RECEIVE_BATCH),
+      count(0),
+      packets(0),
+      bytes(0)
+{
+    std::memset(headers.data(), 0, headers.size() * sizeof(mmsghdr));
+    for (std::size_t i = 0; i < RECEIVE_BATCH; ++i) {
+        vectors[i].iov_base = &data[i * MAX_DATAGRAM];
+        vectors[i].iov_len = MAX_DATAGRAM;
+        headers[i].msg_hdr.msg_iov = &vectors[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = &addresses[i];
+    }
+}
+
+std::size_t ReceiveBatch::receive(int socket) {
+    for (std::size_t i = 0; i < RECEIVE_BATCH; ++i)
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+
+    int result;
+    do {
+        result = ::recvmmsg(socket, headers.data(), RECEIVE_BATCH, MSG_DONTWAIT, nullptr);
+    } while (result < 0 && errno == EINTR);
+
+    count = result > 0 ? static_cast<std::size_t>(result) : 0;
+    for (std::size_t i = 0; i < count; ++i)
+        bytes += headers[i].msg_len;
+    packets += count;
+    return count;
+}
+
+const std::uint8_t* ReceiveBatch::datagram(std::size_t index) const {
+    return &data[index * MAX_DATAGRAM];
+}
+
+std::size_t ReceiveBatch::size(std::size_t index) const {
+    return headers[index].msg_len;
+}
+
+const sockaddr_in& ReceiveBatch::sender(std::size_t index) const {
+    return addresses[index];
+}
+
+std::uint64_t ReceiveBatch::getPackets() const {
+    return packets;
+}
+
+std::uint64_t ReceiveBatch::getBytes() const {
+    return bytes;
+}
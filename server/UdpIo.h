@@ -0,0 +1,159 @@
+#ifndef UDP_IO_H
+#define UDP_IO_H
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NetProtocol.h"
+
+///////////////////////////////////////////////////////////////
+/// Function: openUdpSocket(const std::string& host,
+///                         std::uint16_t port, bool reusePort,
+///                         std::string& error)
+/// ----------------------------------------------------------
+/// Objective:
+///     Creates a non-blocking IPv4 UDP socket bound to
+///     host:port (0 = any free port) with large kernel
+///     buffers.
+///
+/// Input:
+///     host      – dotted IPv4 address of the interface to
+///                 listen on (ANY_HOST = all of them)
+///     reusePort – set SO_REUSEPORT so several sockets share
+///                 the port; the kernel then spreads clients
+///                 over them by address hash
+///
+/// Return:
+///     int – the descriptor, or -1 with 'error' set
+///////////////////////////////////////////////////////////////
+int openUdpSocket(const std::string& host, std::uint16_t port, bool reusePort, std::string& error);
+
+///////////////////////////////////////////////////////////////
+/// Function: parseAddress(const std::string& host,
+///                        std::uint16_t port, sockaddr_in& out)
+/// ----------------------------------------------------------
+/// Objective:
+///     Dotted IPv4 address + port to a socket address.
+///////////////////////////////////////////////////////////////
+bool parseAddress(const std::string& host, std::uint16_t port, sockaddr_in& out);
+
+///////////////////////////////////////////////////////////////
+/// Function: requestServerStats(const std::string& host,
+///                              std::uint16_t port,
+///                              StatsMessage& stats)
+/// ----------------------------------------------------------
+/// Objective:
+///     Asks a pong-server for its statistics (up to 3 tries
+///     of 300 ms each, from a socket of its own).
+///
+/// Return:
+///     bool – false if the server did not answer
+///////////////////////////////////////////////////////////////
+bool requestServerStats(const std::string& host, std::uint16_t port, StatsMessage& stats);
+
+///////////////////////////////////////////////////////////////
+/// Class: SendBatch
+/// ----------------------------------------------------------
+/// Objective:
+///     Queues outgoing datagrams and sends them with one
+///     sendmmsg() system call per SEND_BATCH datagrams.
+///
+/// Description:
+///     Write a datagram into buffer(), then push() it with
+///     its destination, or pushShared() bytes that live
+///     elsewhere (sent in place, without a copy). A full socket buffer drops the rest
+///     of the batch (counted in getDropped()): game state is
+///     resent every tick, so a lost update is superseded.
+///////////////////////////////////////////////////////////////
+class SendBatch {
+public:
+    static constexpr std::size_t SEND_BATCH = 64;
+
+private:
+    int socket;
+    std::size_t count;
+    std::vector<std::uint8_t> data;          // SEND_BATCH × MAX_DATAGRAM
+    std::vector<sockaddr_in> addresses;
+    std::vector<iovec> vectors;
+    std::vector<mmsghdr> headers;
+
+    std::uint64_t packets;
+    std::uint64_t bytes;
+    std::uint64_t dropped;
+
+public:
+    explicit SendBatch(int socket = -1);
+
+    // Holds pointers into its own buffers
+    SendBatch(const SendBatch&) = delete;
+    SendBatch& operator=(const SendBatch&) = delete;
+
+    void setSocket(int socket);
+
+    // Space for the next datagram (MAX_DATAGRAM bytes)
+    std::uint8_t* buffer();
+
+    // Queue the datagram written to buffer(); sends when the batch is full
+    void push(const sockaddr_in& to, std::size_t size);
+
+    // Queue a datagram sent straight from 'data', which must stay valid until flush()
+    void pushShared(const sockaddr_in& to, const std::uint8_t* data, std::size_t size);
+
+    // Send everything queued
+    void flush();
+
+    std::uint64_t getPackets() const;
+    std::uint64_t getBytes() const;
+    std::uint64_t getDropped() const;
+};
+
+///////////////////////////////////////////////////////////////
+/// Class: ReceiveBatch
+/// ----------------------------------------------------------
+/// Objective:
+///     Receives up to RECEIVE_BATCH datagrams per recvmmsg()
+///     system call.
+///////////////////////////////////////////////////////////////
+class ReceiveBatch {
+public:
+    static constexpr std::size_t RECEIVE_BATCH = 64;
+
+private:
+    std::vector<std::uint8_t> data;          // RECEIVE_BATCH × MAX_DATAGRAM
+    std::vector<sockaddr_in> addresses;
+    std::vector<iovec> vectors;
+    std::vector<mmsghdr> headers;
+    std::size_t count;
+
+    std::uint64_t packets;
+    std::uint64_t bytes;
+
+public:
+    ReceiveBatch();
+
+    ReceiveBatch(const ReceiveBatch&) = delete;
+    ReceiveBatch& operator=(const ReceiveBatch&) = delete;
+
+    ///////////////////////////////////////////////////////////
+    /// Function: receive(int socket)
+    /// ------------------------------------------------------
+    /// Objective:
+    ///     Reads the datagrams waiting on a non-blocking socket.
+    ///
+    /// Return:
+    ///     std::size_t – datagrams received (0 = none waiting)
+    ///////////////////////////////////////////////////////////
+    std::size_t receive(int socket);
+
+    const std::uint8_t* datagram(std::size_t index) const;
+    std::size_t size(std::size_t index) const;
+    const sockaddr_in& sender(std::size_t index) const;
+
+    std::uint64_t getPackets() const;
+    std::uint64_t getBytes() const;
+};
+
+#endif
@@ -0,0 +1,257 @@
+//////////////////////////////////////////////////////////////
+/// File: server/main.cpp
+/// ---------------------------------------------------------
+/// Objective:
+///     Entry point of pong-server, the authoritative headless
+///     game server, and of its bundled load generators.
+///
+/// Input Parameters:
+///     argc, argv -> pong-server [--host IP] [--port P]
+///                       [--threads N]
+///                       [--max-matches N] [--tick-rate HZ]
+///                       [--seed S] [--timeout SECONDS]
+///                       [--spectator-host IP]
+///                       [--spectator-port P]
+///                       [--max-spectators N] [--seconds S]
+///                   pong-server --bot [--host IP] [--port P]
+///                       [--clients N] [--threads N]
+///                       [--sockets N] [--warmup S]
+///                       [--seconds S]
+///                   pong-server --spectators N [--tcp]
+///                       [--slow N] [--match ID] [--host IP]
+///                       [--port P] [--spectator-port P]
+///                       [--threads N] [--warmup S]
+///                       [--seconds S]
+///
+/// Return Values:
+///     int -> 0 on success, 1 on bad arguments or if the
+///            server could not start.
+///
+/// Side Effects:
+///     - Server: binds the UDP port on --host (loopback by
+///       default) and the spectator UDP/TCP port (0 disables
+///       it), and prints one status line per second until
+///       SIGINT/SIGTERM (or --seconds).
+///     - Bot / spectators: runs the load test and prints its
+///       report.
+///
+/// Approach:
+///     - Parse options into ServerConfig, BotConfig or
+///       SpectatorConfig.
+///     - Server: start the shards, then report once a second
+///       from the main thread (counter differences).
+///
+//////////////////////////////////////////////////////////////
+
+#include "GameServer.h"
+#include "LoadBot.h"
+#include "SpectatorBot.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    std::atomic<bool> interrupted(false);
+
+    void onSignal(int) {
+        interrupted = true;
+    }
+
+    void printUsage() {
+        std::cout <<
+            "Usage:\n"
+            "  pong-server [--host IP] [--port P] [--threads N] [--max-matches N] [--tick-rate HZ]\n"
+            "              [--seed S] [--timeout SECONDS] [--spectator-host IP] [--spectator-port P]\n"
+            "              [--max-spectators N] [--seconds S]\n"
+            "  pong-server --bot [--host IP] [--port P] [--clients N] [--threads N]\n"
+            "              [--sockets N] [--warmup S] [--seconds S]\n"
+            "  pong-server --spectators N [--tcp] [--slow N] [--match ID] [--host IP] [--port P]\n"
+            "              [--spectator-port P] [--threads N] [--warmup S] [--seconds S]\n";
+    }
+
+    /*
+        Load generator command line.
+    */
+    int runBot(int argc, char** argv) {
+        BotConfig config;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--host" && hasValue)
+                config.host = argv[++i];
+            else if (arg == "--port" && hasValue)
+                config.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+            else if (arg == "--clients" && hasValue)
+                config.clients = std::strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--threads" && hasValue)
+                config.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+            else if (arg == "--sockets" && hasValue)
+                config.sockets = static_cast<unsigned>(std::atoi(argv[++i]));
+            else if (arg == "--warmup" && hasValue)
+                config.warmup = std::atof(argv[++i]);
+            else if (arg == "--seconds" && hasValue)
+                config.seconds = std::atof(argv[++i]);
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        LoadBot bot(config);
+        if (!bot.run()) {
+            std::cout << "Load test failed: " << bot.getError() << "\n";
+            return 1;
+        }
+        bot.printReport(std::cout);
+        return 0;
+    }
+
+    /*
+        Spectator load generator command line (matches must be running).
+    */
+    int runSpectators(int argc, char** argv) {
+        SpectatorConfig config;
+        config.spectators = std::strtoul(argv[2], nullptr, 10);
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--tcp")
+                config.tcp = true;
+            else if (arg == "--slow" && hasValue)
+                config.slow = std::strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--match" && hasValue)
+                config.matchId = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+            else if (arg == "--host" && hasValue)
+                config.host = argv[++i];
+            else if (arg == "--port" && hasValue)
+                config.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+            else if (arg == "--spectator-port" && hasValue)
+                config.spectatorPort = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+            else if (arg == "--threads" && hasValue)
+                config.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+            else if (arg == "--warmup" && hasValue)
+                config.warmup = std::atof(argv[++i]);
+            else if (arg == "--seconds" && hasValue)
+                config.seconds = std::atof(argv[++i]);
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        SpectatorBot bot(config);
+        if (!bot.run()) {
+            std::cout << "Spectator test failed: " << bot.getError() << "\n";
+            return 1;
+        }
+        bot.printReport(std::cout);
+        return 0;
+    }
+
+    /*
+        One status line: rates are differences from the previous line.
+    */
+    void printStatus(double elapsed, const StatsMessage& now, const StatsMessage& before, double interval) {
+        std::printf("%6.0fs  matches %6u  players %6u | ticks/s %5.0f  overruns %llu | "
+                    "tick mean %5u us  max %6u us | in %7.0f pkt/s %6.2f MB/s  out %7.0f pkt/s %6.2f MB/s  dropped %llu | "
+                    "spectators %5u  %6.2f MB/s\n",
+                    elapsed, now.matches, now.players,
+                    (now.ticks - before.ticks) / interval,
+                    static_cast<unsigned long long>(now.overruns),
+                    now.tickMeanMicros, now.tickMaxMicros,
+                    (now.packetsIn - before.packetsIn) / interval,
+                    (now.bytesIn - before.bytesIn) / interval / 1e6,
+                    (now.packetsOut - before.packetsOut) / interval,
+                    (now.bytesOut - before.bytesOut) / interval / 1e6,
+                    static_cast<unsigned long long>(now.packetsDropped),
+                    now.spectators, (now.spectatorBytes - before.spectatorBytes) / interval / 1e6);
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--bot")
+        return runBot(argc, argv);
+    if (argc > 2 && std::string(argv[1]) == "--spectators")
+        return runSpectators(argc, argv);
+
+    ServerConfig config;
+    double runSeconds = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--host" && hasValue)
+            config.host = argv[++i];
+        else if (arg == "--port" && hasValue)
+            config.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue)
+            config.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--max-matches" && hasValue)
+            config.maxMatches = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--tick-rate" && hasValue)
+            config.tickRate = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--timeout" && hasValue)
+            config.idleTimeout = std::atof(argv[++i]);
+        else if (arg == "--spectator-host" && hasValue)
+            config.spectatorHost = argv[++i];
+        else if (arg == "--spectator-port" && hasValue)
+            config.spectatorPort = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        else if (arg == "--max-spectators" && hasValue)
+            config.maxSpectators = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--seconds" && hasValue)
+            runSeconds = std::atof(argv[++i]);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    GameServer server(config);
+    if (!server.start()) {
+        std::cout << "pong-server: " << server.getError() << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::printf("pong-server on UDP %s:%u: %u shards, up to %zu matches at %d Hz\n",
+                config.host.c_str(), unsigned(config.port), server.getShardCount(),
+                config.maxMatches, config.tickRate);
+    if (config.spectatorPort != 0)
+        std::printf("spectator feed on UDP and TCP %s:%u, up to %zu subscribers\n",
+                    config.spectatorHost.c_str(), unsigned(config.spectatorPort), config.maxSpectators);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point last = start;
+    StatsMessage previous = server.getStats();
+
+    while (!interrupted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        Clock::time_point now = Clock::now();
+        double elapsed = std::chrono::duration<double>(now - start).count();
+        double interval = std::chrono::duration<double>(now - last).count();
+
+        if (interval >= 1.0) {
+            StatsMessage stats = server.getStats();
+            printStatus(elapsed, stats, previous, interval);
+            previous = stats;
+            last = now;
+        }
+        if (runSeconds > 0 && elapsed >= runSeconds)
+            break;
+    }
+
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "Arena.h"
+#include <cstdlib>
+
+namespace {
+    // Smallest custom field: room for both paddles and a serve between them
+    const float MIN_WIDTH  = 4.f * (CLASSIC_ARENA.paddleMargin + CLASSIC_ARENA.paddleWidth);
+    const float MIN_HEIGHT = 2.f * CLASSIC_ARENA.paddleHeight;
+    const float MAX_SIDE   = 4096.f;
+
+    bool sameArena(const Arena& a, const Arena& b) {
+        return a.width == b.width && a.height == b.height && a.ballSize == b.ballSize &&
+               a.paddleWidth == b.paddleWidth && a.paddleHeight == b.paddleHeight &&
+               a.paddleSpeed == b.paddleSpeed && a.paddleMargin == b.paddleMargin &&
+               a.serveMinSpeed == b.serveMinSpeed && a.serveSpeedRange == b.serveSpeedRange &&
+               a.serveMinAngle == b.serveMinAngle && a.serveAngleRange == b.serveAngleRange &&
+               a.startLives == b.startLives && a.targetScore == b.targetScore;
+    }
+}
+
+
+/*
+    Function: int arenaPresetIndex(const Arena& arena)
+
+    Objective:
+        Identify a preset (session files store the index).
+
+    Input Parameters:
+        - const Arena& arena: Arena to look up.
+
+    Return Value:
+        - int: Index in ARENA_PRESETS, -1 for a custom arena.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Field-by-field comparison, so a copy of a preset (e.g. the one
+          a Match holds) is still recognized.
+*/
+int arenaPresetIndex(const Arena& arena) {
+    for (std::size_t i = 0; i < ARENA_PRESET_COUNT; ++i) {
+        if (sameArena(arena, *ARENA_PRESETS[i]))
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+
+/*
+    Function: bool parseArena(const std::string& text, Arena& arena, std::string& error)
+
+    Objective:
+        Turn a command-line value into an arena.
+
+    Input Parameters:
+        - const std::string& text: Preset name or WIDTHxHEIGHT.
+        - Arena& arena: Result.
+        - std::string& error: Reason on failure.
+
+    Return Value:
+        - bool: true if 'arena' was set.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Preset names first; otherwise two integers around an 'x',
+          applied to a copy of the classic arena and range-checked.
+*/
+bool parseArena(const std::string& text, Arena& arena, std::string& error) {
+    for (const Arena* preset : ARENA_PRESETS) {
+        if (text == preset->name) {
+            arena = *preset;
+            return true;
+        }
+    }
+
+    char* end = nullptr;
+    long width = std::strtol(text.c_str(), &end, 10);
+    if (end == text.c_str() || (*end != 'x' && *end != 'X')) {
+        error = "unknown arena '" + text + "' (" + arenaPresetNames() + " or WIDTHxHEIGHT)";
+        return false;
+    }
+
+    const char* heightText = end + 1;
+    long height = std::strtol(heightText, &end, 10);
+    if (end == heightText || *end != '\0') {
+        error = "bad arena size '" + text + "'";
+        return false;
+    }
+
+    if (width < MIN_WIDTH || height < MIN_HEIGHT || width > MAX_SIDE || height > MAX_SIDE) {
+        error = "arena must be between " + std::to_string(int(MIN_WIDTH)) + "x" +
+                std::to_string(int(MIN_HEIGHT)) + " and " + std::to_string(int(MAX_SIDE)) + "x" +
+                std::to_string(int(MAX_SIDE));
+        return false;
+    }
+
+    arena = CLASSIC_ARENA;
+    arena.name = "custom";
+    arena.width = float(width);
+    arena.height = float(height);
+    return true;
+}
+
+
+/*
+    Function: std::string arenaPresetNames()
+
+    Objective:
+        Comma-separated preset names for usage and error messages.
+*/
+std::string arenaPresetNames() {
+    std::string names;
+    for (const Arena* preset : ARENA_PRESETS) {
+        if (!names.empty())
+            names += ", ";
+        names += preset->name;
+    }
+    return names;
+}
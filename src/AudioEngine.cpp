@@ -0,0 +1,514 @@
+#include "AudioEngine.h"
+#include "Checksum.h"
+#include "Match.h"
+#include "PaddleController.h"
+#include "Tournament.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    const float TWO_PI = 6.28318531f;
+
+    // Headroom: several full-scale voices may overlap
+    const float MASTER_GAIN = 0.5f;
+
+    // Fade-in of every sound (avoids a click at its first sample)
+    const float ATTACK_SECONDS = 0.002f;
+
+    // Offline rendering: fixed 1/60 s steps, 735 frames each
+    const float MATCH_DT = 1.f / 60.f;
+    const std::size_t STEP_FRAMES = AudioMixer::SAMPLE_RATE / 60;
+
+    std::size_t effectIndex(SoundEffect effect) {
+        return static_cast<std::size_t>(effect);
+    }
+
+    /*
+        Decaying square-wave blip: 'seconds' long, amplitude falling by
+        e every 'decay' seconds.
+    */
+    std::vector<float> blip(float frequency, float seconds, float decay, float amplitude) {
+        std::vector<float> samples(static_cast<std::size_t>(seconds * AudioMixer::SAMPLE_RATE));
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            float t = float(i) / AudioMixer::SAMPLE_RATE;
+            float square = std::sin(TWO_PI * frequency * t) >= 0.f ? 1.f : -1.f;
+            samples[i] = amplitude * square * std::exp(-t / decay);
+        }
+        return samples;
+    }
+
+    /*
+        Sine from 'from' to 'to' Hz (a jump halfway when 'steps', a
+        glide otherwise), fading out linearly.
+    */
+    std::vector<float> tone(float from, float to, bool steps, float seconds, float amplitude) {
+        std::vector<float> samples(static_cast<std::size_t>(seconds * AudioMixer::SAMPLE_RATE));
+        float phase = 0.f;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            float progress = float(i) / samples.size();
+            float frequency = steps ? (progress < 0.4f ? from : to)
+                                    : from + (to - from) * progress;
+            phase += TWO_PI * frequency / AudioMixer::SAMPLE_RATE;
+            if (phase > TWO_PI)
+                phase -= TWO_PI;
+            samples[i] = amplitude * std::sin(phase) * (1.f - progress);
+        }
+        return samples;
+    }
+
+    void applyAttack(std::vector<float>& samples) {
+        std::size_t attack = std::min(samples.size(),
+                                      std::size_t(ATTACK_SECONDS * AudioMixer::SAMPLE_RATE));
+        for (std::size_t i = 0; i < attack; ++i)
+            samples[i] *= float(i) / attack;
+    }
+
+    // Single-writer counter update (relaxed, like the metrics shards)
+    void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    void putLE(std::ofstream& file, std::uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    /*
+        Write 16-bit stereo PCM as a canonical 44-byte-header WAV file.
+    */
+    bool writeWav(const std::string& path, const std::vector<std::int16_t>& pcm) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        const std::uint32_t dataBytes = static_cast<std::uint32_t>(pcm.size() * sizeof(std::int16_t));
+        const std::uint32_t blockAlign = AudioMixer::CHANNELS * sizeof(std::int16_t);
+
+        file.write("RIFF", 4);
+        putLE(file, 36 + dataBytes, 4);
+        file.write("WAVEfmt ", 8);
+        putLE(file, 16, 4);                                   // fmt chunk size
+        putLE(file, 1, 2);                                    // PCM
+        putLE(file, AudioMixer::CHANNELS, 2);
+        putLE(file, AudioMixer::SAMPLE_RATE, 4);
+        putLE(file, AudioMixer::SAMPLE_RATE * blockAlign, 4); // Bytes per second
+        putLE(file, blockAlign, 2);
+        putLE(file, 16, 2);                                   // Bits per sample
+        file.write("data", 4);
+        putLE(file, dataBytes, 4);
+
+        for (std::int16_t sample : pcm)
+            putLE(file, static_cast<std::uint16_t>(sample), 2);
+
+        return bool(file);
+    }
+}
+
+
+/*
+    Constructor: AudioMixer::AudioMixer()
+
+    Objective:
+        Build the sample bank and the mixing buffers.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Allocates every buffer the mixer will ever use.
+
+    Approach:
+        - Synthesize each effect into a mono float array (a few thousand
+          samples each), with a 2 ms fade-in.
+*/
+AudioMixer::AudioMixer()
+    : accumulator(MAX_FRAMES * CHANNELS),
+      bufferCount(0),
+      totalNanos(0),
+      maxNanos(0),
+      lateCount(0)
+{
+    bank[effectIndex(SoundEffect::PADDLE_HIT)]  = blip(480.f, 0.08f, 0.025f, 0.5f);
+    bank[effectIndex(SoundEffect::WALL_BOUNCE)] = blip(240.f, 0.06f, 0.020f, 0.4f);
+    bank[effectIndex(SoundEffect::POINT_WON)]   = tone(660.f, 880.f, true, 0.30f, 0.6f);
+    bank[effectIndex(SoundEffect::POINT_LOST)]  = tone(440.f, 110.f, false, 0.45f, 0.6f);
+
+    for (std::vector<float>& samples : bank)
+        applyAttack(samples);
+
+    for (Voice& voice : voices)
+        voice = Voice{ nullptr, 0, 0, 0.f, 0.f };
+}
+
+
+/*
+    Function: bool AudioMixer::post(SoundEffect effect, float pan)
+
+    Objective:
+        Queue a sound for the mixing thread (game thread side).
+
+    Input Parameters:
+        - SoundEffect effect: Sound to start.
+        - float pan: -1 (left) to 1 (right).
+
+    Return Value:
+        - bool: false if the queue was full (the sound is dropped).
+
+    Side Effects:
+        - One wait-free push.
+*/
+bool AudioMixer::post(SoundEffect effect, float pan) {
+    return commands.push(Command{ effect, pan });
+}
+
+
+/*
+    Function: void AudioMixer::mix(std::int16_t* out, std::size_t frames)
+
+    Objective:
+        Produce one buffer of audio (mixing thread side).
+
+    Input Parameters:
+        - std::int16_t* out: 2 * frames interleaved samples.
+        - std::size_t frames: Frames to produce.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Starts queued sounds, advances voices, updates the timing.
+
+    Approach:
+        - Drain the command queue, then mix in slices of at most
+          MAX_FRAMES (the accumulator's size).
+        - Time the whole call; a buffer is late when mixing it took
+          longer than playing it will.
+*/
+void AudioMixer::mix(std::int16_t* out, std::size_t frames) {
+    Clock::time_point start = Clock::now();
+    const std::uint64_t budget = std::uint64_t(frames) * 1000000000ull / SAMPLE_RATE;
+
+    Command command;
+    while (commands.pop(command))
+        startVoice(command);
+
+    while (frames > 0) {
+        std::size_t slice = std::min(frames, MAX_FRAMES);
+        mixSlice(out, slice);
+        out += slice * CHANNELS;
+        frames -= slice;
+    }
+
+    std::uint64_t nanos = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+    bump(bufferCount, 1);
+    bump(totalNanos, nanos);
+    if (nanos > maxNanos.load(std::memory_order_relaxed))
+        maxNanos.store(nanos, std::memory_order_relaxed);
+    if (nanos > budget)
+        bump(lateCount, 1);
+}
+
+
+/*
+    Function: void AudioMixer::startVoice(const Command& command)
+
+    Objective:
+        Start a sound on a free voice, or on the oldest one.
+
+    Input Parameters:
+        - const Command& command: Effect and pan.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Replaces a voice.
+
+    Approach:
+        - First idle voice; otherwise the voice furthest into its
+          sound. Equal-power pan: gains cos/sin of (pan + 1) * pi / 4.
+*/
+void AudioMixer::startVoice(const Command& command) {
+    const std::vector<float>& samples = bank[effectIndex(command.effect)];
+
+    Voice* chosen = &voices[0];
+    for (Voice& voice : voices) {
+        if (!voice.samples) {
+            chosen = &voice;
+            break;
+        }
+        if (voice.position > chosen->position)
+            chosen = &voice;
+    }
+
+    float pan = std::max(-1.f, std::min(1.f, command.pan));
+    float angle = (pan + 1.f) * TWO_PI / 8.f;
+
+    chosen->samples = samples.data();
+    chosen->length = samples.size();
+    chosen->position = 0;
+    chosen->leftGain = MASTER_GAIN * std::cos(angle);
+    chosen->rightGain = MASTER_GAIN * std::sin(angle);
+}
+
+
+/*
+    Function: void AudioMixer::mixSlice(std::int16_t* out, std::size_t frames)
+
+    Objective:
+        Mix at most MAX_FRAMES frames.
+
+    Input Parameters:
+        - std::int16_t* out: Destination.
+        - std::size_t frames: Frames to mix (<= MAX_FRAMES).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Advances the voices; idles the ones that finished.
+
+    Approach:
+        - Clear the float accumulator, add each playing voice with its
+          two gains, then scale, clamp and convert to 16 bits.
+*/
+void AudioMixer::mixSlice(std::int16_t* out, std::size_t frames) {
+    float* mixed = accumulator.data();
+    std::fill(mixed, mixed + frames * CHANNELS, 0.f);
+
+    for (Voice& voice : voices) {
+        if (!voice.samples)
+            continue;
+
+        std::size_t count = std::min(frames, voice.length - voice.position);
+        const float* source = voice.samples + voice.position;
+        for (std::size_t i = 0; i < count; ++i) {
+            mixed[2 * i]     += source[i] * voice.leftGain;
+            mixed[2 * i + 1] += source[i] * voice.rightGain;
+        }
+
+        voice.position += count;
+        if (voice.position == voice.length)
+            voice.samples = nullptr;
+    }
+
+    for (std::size_t i = 0; i < frames * CHANNELS; ++i) {
+        float sample = std::max(-1.f, std::min(1.f, mixed[i])) * 32767.f;
+        out[i] = static_cast<std::int16_t>(sample);
+    }
+}
+
+
+/*
+    Function: AudioTiming AudioMixer::getTiming() const
+
+    Objective:
+        Summarize the buffers mixed so far (any thread).
+*/
+AudioTiming AudioMixer::getTiming() const {
+    AudioTiming timing;
+    timing.buffers = bufferCount.load(std::memory_order_relaxed);
+    timing.meanMicros = timing.buffers
+        ? totalNanos.load(std::memory_order_relaxed) / 1000.0 / timing.buffers : 0.0;
+    timing.maxMicros = maxNanos.load(std::memory_order_relaxed) / 1000.0;
+    timing.late = lateCount.load(std::memory_order_relaxed);
+    return timing;
+}
+
+
+/*
+    Constructor / Destructor: AudioEngine
+
+    Objective:
+        Own a mixer and its output buffer; stop SFML's thread before
+        the mixer it reads from is destroyed.
+*/
+AudioEngine::AudioEngine()
+    : buffer(BUFFER_FRAMES * AudioMixer::CHANNELS),
+      started(false)
+{
+}
+
+AudioEngine::~AudioEngine() {
+    stop();
+}
+
+
+/*
+    Function: void AudioEngine::start()
+
+    Objective:
+        Start playing the mixer on the default audio device.
+
+    Side Effects:
+        - SFML opens the device and starts its streaming thread.
+*/
+void AudioEngine::start() {
+    if (started)
+        return;
+
+    initialize(AudioMixer::CHANNELS, AudioMixer::SAMPLE_RATE);
+    play();
+    started = true;
+}
+
+
+AudioMixer& AudioEngine::getMixer() {
+    return mixer;
+}
+
+
+/*
+    Function: bool AudioEngine::onGetData(Chunk& data)
+
+    Objective:
+        SFML's request for the next chunk (streaming thread).
+
+    Input Parameters:
+        - Chunk& data: Set to the freshly mixed buffer.
+
+    Return Value:
+        - bool: Always true (the stream never ends).
+
+    Side Effects:
+        - Overwrites the output buffer: SFML has copied the previous
+          chunk into its own audio buffer by the time it asks again.
+*/
+bool AudioEngine::onGetData(Chunk& data) {
+    mixer.mix(buffer.data(), BUFFER_FRAMES);
+    data.samples = buffer.data();
+    data.sampleCount = buffer.size();
+    return true;
+}
+
+void AudioEngine::onSeek(sf::Time) {
+    // A live mix has no position to seek to
+}
+
+
+/*
+    Function: void postMatchSounds(AudioMixer& mixer, unsigned events, float ballX, float fieldWidth)
+
+    Objective:
+        Map the events of one Match::step() to sounds.
+
+    Input Parameters:
+        - AudioMixer& mixer: Where to post.
+        - unsigned events: MatchEvent flags.
+        - float ballX: Ball center after the step.
+        - float fieldWidth: Arena width.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Posts up to four commands.
+*/
+void postMatchSounds(AudioMixer& mixer, unsigned events, float ballX, float fieldWidth) {
+    float pan = 2.f * ballX / fieldWidth - 1.f;
+
+    if (events & MatchEvent::WALL_BOUNCE)
+        mixer.post(SoundEffect::WALL_BOUNCE, pan);
+    if (events & (MatchEvent::LEFT_HIT | MatchEvent::RIGHT_HIT))
+        mixer.post(SoundEffect::PADDLE_HIT, pan);
+    if (events & MatchEvent::LEFT_SCORED)
+        mixer.post(SoundEffect::POINT_WON, -0.5f);
+    if (events & MatchEvent::RIGHT_SCORED)
+        mixer.post(SoundEffect::POINT_LOST, 0.5f);
+}
+
+
+/*
+    Function: int runAudioCommand(int argc, char** argv)
+
+    Objective:
+        Render the sound of a replayed AI match into a WAV file.
+
+    Input Parameters:
+        - int argc, char** argv: --render-audio LEFT RIGHT SEED OUT.wav
+
+    Return Value:
+        - int: Exit code.
+
+    Side Effects:
+        - Writes the WAV file; prints the mixing cost.
+
+    Approach:
+        - Same loop as Tournament::playMatch() (reproducible controllers
+          seeded with mixSeed(seed, 1/2), fixed steps, same step limit), so the audio
+          follows exactly the match "--match" prints.
+        - After each step post its sounds and mix STEP_FRAMES frames:
+          mixing in step-sized buffers is what makes the output a pure
+          function of the match. A CRC of the samples is printed so two
+          renders can be compared without diffing the files.
+*/
+int runAudioCommand(int argc, char** argv) {
+    if (argc != 6 || !createController(argv[2]) || !createController(argv[3])) {
+        std::cout << "Usage:\n  pong --render-audio LEFT RIGHT SEED OUT.wav\n"
+                     "  (controllers: see --list-controllers)\n";
+        return 1;
+    }
+
+    std::string left = argv[2], right = argv[3], path = argv[5];
+    std::uint64_t seed = std::strtoull(argv[4], nullptr, 10);
+
+    std::unique_ptr<PaddleController> leftController = createController(left, true);
+    std::unique_ptr<PaddleController> rightController = createController(right, true);
+    leftController->reset(mixSeed(seed, 1));
+    rightController->reset(mixSeed(seed, 2));
+
+    Match match(GameMode::PLAYER_VS_PLAYER, seed);
+    AudioMixer mixer;
+    std::vector<std::int16_t> pcm;
+    const long maxTicks = TournamentConfig().maxMatchTicks;
+
+    while (!match.isFinished() && match.getTick() < maxTicks) {
+        MatchInput input;
+        input.left  = leftController->decide(match, Side::LEFT, MATCH_DT);
+        input.right = rightController->decide(match, Side::RIGHT, MATCH_DT);
+
+        unsigned events = match.step(MATCH_DT, input);
+        sf::FloatRect ball = match.getBallBounds();
+        postMatchSounds(mixer, events, ball.left + ball.width / 2.f, match.getArena().width);
+
+        std::size_t offset = pcm.size();
+        pcm.resize(offset + STEP_FRAMES * AudioMixer::CHANNELS);
+        mixer.mix(pcm.data() + offset, STEP_FRAMES);
+    }
+
+    if (!writeWav(path, pcm)) {
+        std::cout << "Failed to write " << path << "\n";
+        return 1;
+    }
+
+    AudioTiming timing = mixer.getTiming();
+    char line[200];
+    std::cout << left << " vs " << right << ", seed " << seed << ": " << match.getLeftScore()
+              << " : " << match.getRightScore() << " after " << match.getTick() << " steps\n";
+    std::snprintf(line, sizeof(line), "Wrote %s: %.1f s of audio, PCM crc32 %08x\n",
+                  path.c_str(), double(pcm.size() / AudioMixer::CHANNELS) / AudioMixer::SAMPLE_RATE,
+                  crc32(pcm.data(), pcm.size() * sizeof(std::int16_t)));
+    std::cout << line;
+    std::snprintf(line, sizeof(line),
+                  "Mixed %llu buffers of %zu frames: mean %.2f us, max %.2f us "
+                  "(budget %.0f us), %llu late\n",
+                  static_cast<unsigned long long>(timing.buffers), STEP_FRAMES,
+                  timing.meanMicros, timing.maxMicros, 1e6 * STEP_FRAMES / AudioMixer::SAMPLE_RATE,
+                  static_cast<unsigned long long>(timing.late));
+    std::cout << line;
+    return 0;
+}
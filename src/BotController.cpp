@@ -0,0 +1,171 @@
+#include "BotController.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    // Answers this many queries old still steer; an older one means the
+    // bot is gone (or stalled) and is no longer waited for
+    const std::uint64_t STALE_QUERIES = 30;
+
+    // Polls between two reads of the clock while waiting
+    const unsigned CLOCK_CHECK_INTERVAL = 64;
+
+    PaddleAction toAction(std::int32_t action) {
+        if (action == static_cast<std::int32_t>(PaddleAction::UP))
+            return PaddleAction::UP;
+        if (action == static_cast<std::int32_t>(PaddleAction::DOWN))
+            return PaddleAction::DOWN;
+        return PaddleAction::STAY;
+    }
+}
+
+
+/*
+    Function: BotState makeBotState(const Match& match, Side side, std::uint64_t query)
+
+    Objective:
+        Describe the match to a bot playing 'side'.
+
+    Input Parameters:
+        - const Match& match: Current position.
+        - Side side: The bot's paddle.
+        - std::uint64_t query: Number of this decision.
+
+    Return Value:
+        - BotState: Centers, velocity, geometry and scores, from the
+          bot's side (its paddle and score first).
+*/
+BotState makeBotState(const Match& match, Side side, std::uint64_t query) {
+    const Arena& arena = match.getArena();
+    Side other = side == Side::LEFT ? Side::RIGHT : Side::LEFT;
+    sf::FloatRect ball = match.getBallBounds();
+    sf::FloatRect paddle = match.getPaddleBounds(side);
+    sf::FloatRect opponent = match.getPaddleBounds(other);
+    sf::Vector2f velocity = match.getBallVelocity();
+
+    BotState state;
+    state.query = query;
+    state.tick = static_cast<std::uint32_t>(match.getTick());
+    state.side = side == Side::LEFT ? 0 : 1;
+    state.ballX = ball.left + ball.width / 2.f;
+    state.ballY = ball.top + ball.height / 2.f;
+    state.ballVX = velocity.x;
+    state.ballVY = velocity.y;
+    state.paddleY = paddle.top + paddle.height / 2.f;
+    state.opponentY = opponent.top + opponent.height / 2.f;
+    state.arenaWidth = arena.width;
+    state.arenaHeight = arena.height;
+    state.paddleHeight = arena.paddleHeight;
+    state.paddleSpeed = arena.paddleSpeed;
+    state.score = side == Side::LEFT ? match.getLeftScore() : match.getRightScore();
+    state.opponentScore = side == Side::LEFT ? match.getRightScore() : match.getLeftScore();
+    return state;
+}
+
+
+/*
+    Constructor: BotController::BotController(std::unique_ptr<BotLink> link,
+                                              std::chrono::microseconds wait)
+
+    Objective:
+        Play a paddle through an open bot link.
+*/
+BotController::BotController(std::unique_ptr<BotLink> link, std::chrono::microseconds wait)
+    : link(std::move(link)),
+      waitBudget(wait),
+      queries(0),
+      lastAnswered(0),
+      onTime(0),
+      late(0),
+      missed(0),
+      waitNanos(0)
+{
+}
+
+
+/*
+    Function: PaddleAction BotController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        Ask the bot for this step's action.
+
+    Input Parameters:
+        - const Match& match: Current position.
+        - Side side: Paddle being controlled.
+        - float dt: Unused (the bot sees velocities and speeds).
+
+    Return Value:
+        - PaddleAction: The bot's answer, or STAY without a usable one.
+
+    Side Effects:
+        - Publishes a state; may spin for up to the wait budget.
+
+    Approach:
+        - Publish the query, then poll the newest command until it
+          answers this query. Only a bot that answered recently is
+          waited for, and the clock is read every CLOCK_CHECK_INTERVAL
+          polls only.
+        - Out of budget: use the newest answer if it is not stale
+          (the bot is a step or two behind), else stay.
+*/
+PaddleAction BotController::decide(const Match& match, Side side, float dt) {
+    (void)dt;
+
+    ++queries;
+    link->publishState(makeBotState(match, side, queries));
+
+    bool waiting = lastAnswered != 0 && queries - lastAnswered <= STALE_QUERIES;
+    Clock::time_point start = Clock::now();
+    BotCommand command;
+    bool answered = false;
+    unsigned spins = 0;
+
+    for (;;) {
+        answered = link->readCommand(command);
+        if (answered && command.query == queries) {
+            ++onTime;
+            waitNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            lastAnswered = queries;
+            return toAction(command.action);
+        }
+        if (!waiting || (spins % CLOCK_CHECK_INTERVAL == 0 && Clock::now() - start >= waitBudget))
+            break;
+        spinPause(spins);
+    }
+
+    if (answered && command.query != 0 && command.query < queries &&
+        queries - command.query <= STALE_QUERIES) {
+        ++late;
+        lastAnswered = std::max(lastAnswered, command.query);
+        return toAction(command.action);
+    }
+
+    ++missed;
+    return PaddleAction::STAY;
+}
+
+
+/*
+    Function: std::string BotController::getReport() const
+
+    Objective:
+        Summarize how well the bot kept up.
+
+    Return Value:
+        - std::string: Decisions on time (mean wait), late and missed;
+          empty before the first decision.
+*/
+std::string BotController::getReport() const {
+    if (queries == 0)
+        return "";
+
+    char line[160];
+    std::snprintf(line, sizeof line, "%llu on time (mean wait %.1f us), %llu late, %llu missed",
+                  static_cast<unsigned long long>(onTime),
+                  onTime > 0 ? waitNanos / 1e3 / onTime : 0.0,
+                  static_cast<unsigned long long>(late),
+                  static_cast<unsigned long long>(missed));
+    return line;
+}
@@ -0,0 +1,208 @@
+#include "BotLink.h"
+#include <atomic>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace {
+    // "PBOT" – set last by the game, once the object is ready
+    const std::uint32_t BOT_LINK_MAGIC = 0x544F4250u;
+
+    // Bump whenever the layout or the records change
+    const std::uint32_t BOT_LINK_VERSION = 1;
+
+    // Polls spent on CPU pause hints before yielding the core
+    const unsigned SPINS_BEFORE_YIELD = 256;
+}
+
+///////////////////////////////////////////////////////////////
+/// Struct: BotLink::Shared
+/// ----------------------------------------------------------
+/// The mapped object. A zero-filled object is two empty rings
+/// with no magic, so creating one is truncating the object to
+/// this size and publishing the magic.
+///////////////////////////////////////////////////////////////
+struct BotLink::Shared {
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::uint32_t stateSize;
+    std::uint32_t commandSize;
+    SeqlockRing<BotState, BOT_RING_CAPACITY> states;        // Game → bot
+    SeqlockRing<BotCommand, BOT_RING_CAPACITY> commands;    // Bot → game
+};
+
+
+/*
+    Constructor: BotLink::BotLink(const std::string& name, BotLinkMode mode)
+
+    Objective:
+        Map the shared-memory object of the link.
+
+    Input Parameters:
+        - const std::string& name: shm_open name ("/pong-bot").
+        - BotLinkMode mode: CREATE (game) or ATTACH (bot).
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - CREATE: creates the object, or empties an existing one.
+        - Prints why the link could not be opened.
+
+    Approach:
+        - CREATE: truncate to zero and back to the layout's size (all
+          zeros: empty rings), map, fill the header and publish the
+          magic last.
+        - ATTACH: map an object of exactly the layout's size and accept
+          it only with the magic, version and record sizes of this
+          build.
+*/
+BotLink::BotLink(const std::string& name, BotLinkMode mode)
+    : name(name),
+      mode(mode),
+      fd(-1),
+      shared(nullptr)
+{
+#ifndef _WIN32
+    int flags = mode == BotLinkMode::CREATE ? O_RDWR | O_CREAT : O_RDWR;
+    fd = shm_open(name.c_str(), flags | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::cout << "Failed to open bot link " << name
+                  << (mode == BotLinkMode::ATTACH ? " (is the game running with --bot?)\n" : "\n");
+        return;
+    }
+
+    bool sized;
+    if (mode == BotLinkMode::CREATE) {
+        sized = ftruncate(fd, 0) == 0 && ftruncate(fd, sizeof(Shared)) == 0;
+    }
+    else {
+        struct stat info;
+        sized = fstat(fd, &info) == 0 && std::size_t(info.st_size) == sizeof(Shared);
+    }
+
+    void* mapping = sized ? mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+    if (mapping == MAP_FAILED) {
+        std::cout << "Failed to map bot link " << name << "\n";
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    if (mode == BotLinkMode::CREATE) {
+        shared = new (mapping) Shared();
+        shared->version = BOT_LINK_VERSION;
+        shared->stateSize = sizeof(BotState);
+        shared->commandSize = sizeof(BotCommand);
+        shared->magic.store(BOT_LINK_MAGIC, std::memory_order_release);
+        return;
+    }
+
+    shared = static_cast<Shared*>(mapping);
+    if (shared->magic.load(std::memory_order_acquire) != BOT_LINK_MAGIC ||
+        shared->version != BOT_LINK_VERSION ||
+        shared->stateSize != sizeof(BotState) ||
+        shared->commandSize != sizeof(BotCommand)) {
+        std::cout << "Bot link " << name << " has an unknown layout (game and bot from different versions?)\n";
+        munmap(mapping, sizeof(Shared));
+        ::close(fd);
+        fd = -1;
+        shared = nullptr;
+    }
+#else
+    std::cout << "Bot links need POSIX shared memory\n";
+#endif
+}
+
+
+/*
+    Destructor: BotLink::~BotLink()
+
+    Objective:
+        Unmap the link; the game's end also removes the name, so the
+        next game starts from a fresh object.
+*/
+BotLink::~BotLink() {
+#ifndef _WIN32
+    if (!shared)
+        return;
+
+    munmap(shared, sizeof(Shared));
+    ::close(fd);
+    if (mode == BotLinkMode::CREATE)
+        shm_unlink(name.c_str());
+#endif
+}
+
+
+bool BotLink::isOpen() const {
+    return shared != nullptr;
+}
+
+
+/*
+    Functions: publishState / readCommand / publishCommand / readState
+
+    Objective:
+        The two rings, each written by one end only.
+*/
+void BotLink::publishState(const BotState& state) {
+    shared->states.publish(state);
+}
+
+bool BotLink::readCommand(BotCommand& command) const {
+    return shared->commands.readLatest(command);
+}
+
+std::uint64_t BotLink::getCommandsPublished() const {
+    return shared->commands.getPublished();
+}
+
+void BotLink::publishCommand(const BotCommand& command) {
+    shared->commands.publish(command);
+}
+
+bool BotLink::readState(BotState& state) const {
+    return shared->states.readLatest(state);
+}
+
+std::uint64_t BotLink::getStatesPublished() const {
+    return shared->states.getPublished();
+}
+
+
+/*
+    Function: void spinPause(unsigned& spins)
+
+    Objective:
+        Wait a little between two polls of a ring.
+
+    Approach:
+        - The first SPINS_BEFORE_YIELD polls only hint the CPU (pause /
+          yield instructions: no system call, the answer is typically
+          microseconds away); after that the wait is long enough that
+          giving the core to another thread costs nothing.
+*/
+void spinPause(unsigned& spins) {
+    if (spins++ < SPINS_BEFORE_YIELD) {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+        return;
+    }
+    std::this_thread::yield();
+}
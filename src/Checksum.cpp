@@ -0,0 +1,52 @@
+#include "Checksum.h"
+
+namespace {
+    /*
+        Table for the reflected CRC-32 polynomial 0xEDB88320,
+        built once on first use.
+    */
+    struct Crc32Table {
+        std::uint32_t entries[256];
+
+        Crc32Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                entries[i] = c;
+            }
+        }
+    };
+}
+
+/*
+    Function: std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc)
+
+    Objective:
+        Compute the CRC-32 of a byte buffer.
+
+    Input Parameters:
+        - const void* data: Bytes to checksum.
+        - std::size_t size: Number of bytes.
+        - std::uint32_t crc: CRC of preceding data (0 to start).
+
+    Return Value:
+        - std::uint32_t: The updated CRC-32.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Classic byte-at-a-time table lookup.
+*/
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc) {
+    static const Crc32Table table;
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+
+    for (std::size_t i = 0; i < size; ++i)
+        crc = table.entries[(crc ^ bytes[i]) & 0xFFu] ^ (crc >> 8);
+
+    return ~crc;
+}
@@ -0,0 +1,141 @@
+#include "CounterRng.h"
+
+namespace {
+    // Philox4x32 round multipliers and Weyl key increments
+    const std::uint32_t PHILOX_M0 = 0xD2511F53u;
+    const std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+    const std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+    const std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+    const int PHILOX_ROUNDS = 10;
+
+    /*
+        32x32 -> 64-bit multiply split into high and low halves.
+    */
+    inline void mulhilo(std::uint32_t a, std::uint32_t b,
+                        std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+        hi = static_cast<std::uint32_t>(product >> 32);
+        lo = static_cast<std::uint32_t>(product);
+    }
+}
+
+/*
+    Constructor: CounterRng::CounterRng(std::uint64_t seed)
+
+    Objective:
+        Use the 64-bit seed as the Philox key.
+
+    Input Parameters:
+        - std::uint64_t seed: Match seed.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Split the seed into two 32-bit key words.
+*/
+CounterRng::CounterRng(std::uint64_t seed) {
+    key[0] = static_cast<std::uint32_t>(seed);
+    key[1] = static_cast<std::uint32_t>(seed >> 32);
+}
+
+
+/*
+    Function: CounterRng::Block CounterRng::block(std::uint32_t stream,
+                                                  std::uint64_t index) const
+
+    Objective:
+        Random words for one (stream, index) position.
+
+    Input Parameters:
+        - std::uint32_t stream: Consumer stream (RngStream).
+        - std::uint64_t index: Position within the stream.
+
+    Return Value:
+        - Block: Four random 32-bit words.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Counter = (index low, index high, stream, 0) → Philox4x32-10.
+*/
+CounterRng::Block CounterRng::block(std::uint32_t stream, std::uint64_t index) const {
+    Block counter = {
+        static_cast<std::uint32_t>(index),
+        static_cast<std::uint32_t>(index >> 32),
+        stream,
+        0u
+    };
+    return philox4x32(counter, key[0], key[1]);
+}
+
+
+/*
+    Function: float CounterRng::uniform(std::uint32_t word)
+
+    Objective:
+        Convert a random word to a float in [0, 1).
+
+    Input Parameters:
+        - std::uint32_t word: Random bits.
+
+    Return Value:
+        - float in [0, 1)
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Use the top 24 bits (a float mantissa's worth) so 1.0 is never produced.
+*/
+float CounterRng::uniform(std::uint32_t word) {
+    return (word >> 8) * (1.f / 16777216.f);
+}
+
+
+/*
+    Function: CounterRng::Block CounterRng::philox4x32(Block counter,
+                                                       std::uint32_t k0,
+                                                       std::uint32_t k1)
+
+    Objective:
+        Apply the Philox4x32-10 bijection to a counter.
+
+    Input Parameters:
+        - Block counter: 128-bit counter.
+        - std::uint32_t k0, k1: 64-bit key.
+
+    Return Value:
+        - Block: Encrypted counter (the random output).
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Each round: two 32x32 multiplies, XOR the high halves with the
+          other words and the round key, permute; bump the key by the
+          Weyl constants between rounds.
+*/
+CounterRng::Block CounterRng::philox4x32(Block counter, std::uint32_t k0, std::uint32_t k1) {
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, counter[0], hi0, lo0);
+        mulhilo(PHILOX_M1, counter[2], hi1, lo1);
+
+        counter = {
+            hi1 ^ counter[1] ^ k0,
+            lo1,
+            hi0 ^ counter[3] ^ k1,
+            lo0
+        };
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return counter;
+}
@@ -0,0 +1,458 @@
+#include "EntityStore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const sf::Color BALL_COLOR     = sf::Color::White;
+    const sf::Color PADDLE_COLOR   = sf::Color::White;
+    const sf::Color OBSTACLE_COLOR = sf::Color(120, 120, 140);
+
+    /*
+        sf::FloatRect::intersects() of two boxes with positive extents
+        (strict overlap).
+    */
+    inline bool overlaps(float ax, float ay, float aw, float ah,
+                         float bx, float by, float bw, float bh) {
+        return ax < bx + bw && bx < ax + aw && ay < by + bh && by < ay + ah;
+    }
+}
+
+
+/*
+    Functions: addBall / addBox
+
+    Objective:
+        Append a ball or a box to its table.
+
+    Input Parameters:
+        - float x, y: Top-left corner.
+        - float size / width, height: Extents.
+        - float vx, vy: Ball velocity (pixels/second).
+        - BoxKind kind: Paddle or obstacle.
+
+    Return Value:
+        - std::size_t: Index of the new entity in its table.
+
+    Side Effects:
+        - Grows every component array of the table by one.
+*/
+std::size_t EntityStore::addBall(float x, float y, float size, float vx, float vy) {
+    ballX.push_back(x);
+    ballY.push_back(y);
+    ballVX.push_back(vx);
+    ballVY.push_back(vy);
+    ballSize.push_back(size);
+    return ballX.size() - 1;
+}
+
+std::size_t EntityStore::addBox(BoxKind kind, float x, float y, float width, float height) {
+    boxX.push_back(x);
+    boxY.push_back(y);
+    boxWidth.push_back(width);
+    boxHeight.push_back(height);
+    boxKind.push_back(kind);
+    return boxX.size() - 1;
+}
+
+
+/*
+    Function: void EntityStore::clear()
+
+    Objective:
+        Remove every entity, keeping the allocated capacity.
+*/
+void EntityStore::clear() {
+    ballX.clear();
+    ballY.clear();
+    ballVX.clear();
+    ballVY.clear();
+    ballSize.clear();
+
+    boxX.clear();
+    boxY.clear();
+    boxWidth.clear();
+    boxHeight.clear();
+    boxKind.clear();
+}
+
+
+/*
+    Table sizes and component access
+
+    Objective:
+        Read and place entities (match rules, AI controllers, tools).
+*/
+std::size_t EntityStore::getBallCount() const {
+    return ballX.size();
+}
+
+std::size_t EntityStore::getBoxCount() const {
+    return boxX.size();
+}
+
+std::size_t EntityStore::getMemoryBytes() const {
+    return getBallCount() * 5 * sizeof(float) +
+           getBoxCount() * (4 * sizeof(float) + sizeof(BoxKind));
+}
+
+sf::FloatRect EntityStore::getBallBounds(std::size_t ball) const {
+    return sf::FloatRect(ballX[ball], ballY[ball], ballSize[ball], ballSize[ball]);
+}
+
+sf::Vector2f EntityStore::getBallVelocity(std::size_t ball) const {
+    return sf::Vector2f(ballVX[ball], ballVY[ball]);
+}
+
+sf::FloatRect EntityStore::getBoxBounds(std::size_t box) const {
+    return sf::FloatRect(boxX[box], boxY[box], boxWidth[box], boxHeight[box]);
+}
+
+BoxKind EntityStore::getBoxKind(std::size_t box) const {
+    return boxKind[box];
+}
+
+void EntityStore::placeBall(std::size_t ball, float x, float y, float vx, float vy) {
+    ballX[ball] = x;
+    ballY[ball] = y;
+    ballVX[ball] = vx;
+    ballVY[ball] = vy;
+}
+
+void EntityStore::placeBox(std::size_t box, float x, float y) {
+    boxX[box] = x;
+    boxY[box] = y;
+}
+
+
+/*
+    Function: std::size_t EntityStore::moveBalls(float dt, float floor)
+
+    Objective:
+        Integrate every ball and bounce it off the top and bottom walls.
+
+    Input Parameters:
+        - float dt: Time step in seconds.
+        - float floor: Field height.
+
+    Return Value:
+        - std::size_t: Balls that bounced this step.
+
+    Side Effects:
+        - Moves every ball; flips the Y velocity of the bounced ones.
+
+    Approach:
+        - One pass over the ball arrays: position += velocity * dt, then
+          bounce when the top edge is at or above 0 or the bottom edge at
+          or below the floor (the ball's top at floor - size or lower).
+*/
+std::size_t EntityStore::moveBalls(float dt, float floor) {
+    std::size_t bounced = 0;
+
+    for (std::size_t i = 0; i < ballX.size(); ++i) {
+        ballX[i] += ballVX[i] * dt;
+        ballY[i] += ballVY[i] * dt;
+
+        if (ballY[i] <= 0 || ballY[i] >= floor - ballSize[i]) {
+            ballVY[i] = -ballVY[i];
+            ++bounced;
+        }
+    }
+
+    return bounced;
+}
+
+
+/*
+    Function: void EntityStore::moveBox(std::size_t box, PaddleAction action, float speed, float dt, float floor)
+
+    Objective:
+        Move a paddle for one step.
+
+    Input Parameters:
+        - std::size_t box: Paddle to move.
+        - PaddleAction action: UP, DOWN or STAY.
+        - float speed: Pixels/second.
+        - float dt: Time step in seconds.
+        - float floor: Field height.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Changes the box's Y position.
+
+    Approach:
+        - UP only while the top is below the top wall, DOWN only while the
+          bottom is above the floor; a step may overshoot slightly, as the
+          original paddle did.
+*/
+void EntityStore::moveBox(std::size_t box, PaddleAction action, float speed, float dt, float floor) {
+    if (action == PaddleAction::UP) {
+        if (boxY[box] > 0)
+            boxY[box] += -speed * dt;
+    }
+    else if (action == PaddleAction::DOWN) {
+        if (boxY[box] + boxHeight[box] < floor)
+            boxY[box] += speed * dt;
+    }
+}
+
+
+/*
+    Function: bool EntityStore::collide(std::size_t ball, std::size_t box)
+
+    Objective:
+        Bounce a ball off a box it overlaps.
+
+    Input Parameters:
+        - std::size_t ball: Ball index.
+        - std::size_t box: Box index.
+
+    Return Value:
+        - bool: true if the ball and the box overlap.
+
+    Side Effects:
+        - May flip one velocity component of the ball.
+
+    Approach:
+        - Paddles: flip X unconditionally (the original rule).
+        - Obstacles: the axis with the smaller overlap is the side that
+          was hit; flip that component only if the ball still moves
+          toward the obstacle's center, so a ball does not stick inside.
+*/
+bool EntityStore::collide(std::size_t ball, std::size_t box) {
+    if (!overlaps(ballX[ball], ballY[ball], ballSize[ball], ballSize[ball],
+                  boxX[box], boxY[box], boxWidth[box], boxHeight[box]))
+        return false;
+
+    bounce(ball, box);
+    return true;
+}
+
+
+/*
+    Function: void EntityStore::bounce(std::size_t ball, std::size_t box)
+
+    Objective:
+        Reflect a ball off a box it overlaps (see collide()).
+*/
+void EntityStore::bounce(std::size_t ball, std::size_t box) {
+    if (boxKind[box] == BoxKind::PADDLE) {
+        ballVX[ball] = -ballVX[ball];
+        return;
+    }
+
+    float x = ballX[ball], y = ballY[ball], size = ballSize[ball];
+    float left = boxX[box], top = boxY[box], width = boxWidth[box], height = boxHeight[box];
+
+    float overlapX = std::min(x + size, left + width) - std::max(x, left);
+    float overlapY = std::min(y + size, top + height) - std::max(y, top);
+    float towardX = (left + width / 2.f) - (x + size / 2.f);
+    float towardY = (top + height / 2.f) - (y + size / 2.f);
+
+    if (overlapX < overlapY) {
+        if (ballVX[ball] * towardX > 0.f)
+            ballVX[ball] = -ballVX[ball];
+    }
+    else if (ballVY[ball] * towardY > 0.f) {
+        ballVY[ball] = -ballVY[ball];
+    }
+}
+
+
+/*
+    Function: std::size_t EntityStore::collideAll()
+
+    Objective:
+        Resolve every ball/box contact of the step.
+
+    Return Value:
+        - std::size_t: Contacts found.
+
+    Side Effects:
+        - Bounces balls.
+
+    Approach:
+        - Balls outer, boxes inner: each ball's box stays in registers
+          while the box arrays stream through the cache.
+        - The overlap test combines its four comparisons without
+          branches; only contacts (rare) take the bounce path. Positions
+          do not change while bouncing, so the ball's box is loaded once.
+*/
+std::size_t EntityStore::collideAll() {
+    std::size_t contacts = 0;
+    const std::size_t boxes = boxX.size();
+
+    for (std::size_t ball = 0; ball < ballX.size(); ++ball) {
+        const float left = ballX[ball], top = ballY[ball];
+        const float right = left + ballSize[ball], bottom = top + ballSize[ball];
+
+        for (std::size_t box = 0; box < boxes; ++box) {
+            bool touching = (left < boxX[box] + boxWidth[box]) & (boxX[box] < right) &
+                            (top < boxY[box] + boxHeight[box]) & (boxY[box] < bottom);
+            if (touching) {
+                bounce(ball, box);
+                ++contacts;
+            }
+        }
+    }
+    return contacts;
+}
+
+
+/*
+    Constructor: EntityRenderer::EntityRenderer()
+
+    Objective:
+        Precompute the unit circle used for balls.
+*/
+EntityRenderer::EntityRenderer() {
+    const float TWO_PI = 6.28318531f;
+
+    circle.reserve(BALL_SEGMENTS);
+    for (std::size_t i = 0; i < BALL_SEGMENTS; ++i) {
+        // As sf::CircleShape: point 0 at the top, clockwise on screen
+        float angle = TWO_PI * i / BALL_SEGMENTS - TWO_PI / 4.f;
+        circle.push_back(sf::Vector2f(std::cos(angle), std::sin(angle)));
+    }
+}
+
+
+/*
+    Function: void EntityRenderer::draw(const EntityStore& entities, sf::RenderTarget& target)
+
+    Objective:
+        Generate and submit the geometry of every entity.
+
+    Input Parameters:
+        - const EntityStore& entities: Entities to draw.
+        - sf::RenderTarget& target: Window (or texture) to draw on.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Rewrites the vertex buffer (grows it only when the store grew).
+
+    Approach:
+        - A batch of one store at its own coordinates.
+*/
+void EntityRenderer::draw(const EntityStore& entities, sf::RenderTarget& target) {
+    begin();
+    add(entities, sf::Vector2f(0.f, 0.f), 1.f);
+    submit(target);
+}
+
+
+/*
+    Function: void EntityRenderer::add(const EntityStore& entities, sf::Vector2f offset, float scale,
+                                       std::size_t ballSegments)
+
+    Objective:
+        Append the geometry of every entity of a store to the batch.
+
+    Input Parameters:
+        - const EntityStore& entities: Entities to draw.
+        - sf::Vector2f offset, float scale: Placement (point * scale + offset).
+        - std::size_t ballSegments: Triangles per ball (divides BALL_SEGMENTS).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Grows the vertex buffer by the store's vertices (reallocating
+          only beyond the largest batch so far).
+
+    Approach:
+        - Boxes: two triangles each. Balls: one triangle per circle
+          segment, from the center, stepping over the unit circle for
+          coarser balls.
+        - The placement is applied as each vertex is written: no
+          per-store transform or draw call.
+*/
+void EntityRenderer::add(const EntityStore& entities, sf::Vector2f offset, float scale,
+                         std::size_t ballSegments) {
+    std::size_t boxes = entities.getBoxCount();
+    std::size_t balls = entities.getBallCount();
+    std::size_t stride = BALL_SEGMENTS / std::max<std::size_t>(1, std::min(ballSegments, BALL_SEGMENTS));
+    std::size_t segments = BALL_SEGMENTS / stride;
+
+    std::size_t first = vertices.size();
+    vertices.resize(first + boxes * 6 + balls * segments * 3);
+
+    sf::Vertex* out = vertices.data() + first;
+
+    for (std::size_t i = 0; i < boxes; ++i) {
+        float left = offset.x + entities.boxX[i] * scale;
+        float top = offset.y + entities.boxY[i] * scale;
+        float right = left + entities.boxWidth[i] * scale;
+        float bottom = top + entities.boxHeight[i] * scale;
+        sf::Color color = entities.boxKind[i] == BoxKind::PADDLE ? PADDLE_COLOR : OBSTACLE_COLOR;
+
+        out[0] = sf::Vertex(sf::Vector2f(left, top), color);
+        out[1] = sf::Vertex(sf::Vector2f(right, top), color);
+        out[2] = sf::Vertex(sf::Vector2f(right, bottom), color);
+        out[3] = out[0];
+        out[4] = out[2];
+        out[5] = sf::Vertex(sf::Vector2f(left, bottom), color);
+        out += 6;
+    }
+
+    for (std::size_t i = 0; i < balls; ++i) {
+        float radius = entities.ballSize[i] / 2.f * scale;
+        sf::Vector2f center(offset.x + entities.ballX[i] * scale + radius,
+                            offset.y + entities.ballY[i] * scale + radius);
+
+        for (std::size_t s = 0; s < BALL_SEGMENTS; s += stride) {
+            const sf::Vector2f& a = circle[s];
+            const sf::Vector2f& b = circle[(s + stride) % BALL_SEGMENTS];
+            out[0] = sf::Vertex(center, BALL_COLOR);
+            out[1] = sf::Vertex(center + a * radius, BALL_COLOR);
+            out[2] = sf::Vertex(center + b * radius, BALL_COLOR);
+            out += 3;
+        }
+    }
+}
+
+
+/*
+    Functions: EntityRenderer batch control
+
+    Objective:
+        Start, extend and submit a batch of geometry.
+
+    Approach:
+        - addRect(): two triangles, like a box.
+        - submit(): one sf::Triangles draw call for everything added.
+*/
+void EntityRenderer::addRect(const sf::FloatRect& rect, sf::Color color) {
+    sf::Vertex corners[4] = {
+        sf::Vertex(sf::Vector2f(rect.left, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color),
+        sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color),
+        sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color)
+    };
+    vertices.push_back(corners[0]);
+    vertices.push_back(corners[1]);
+    vertices.push_back(corners[2]);
+    vertices.push_back(corners[0]);
+    vertices.push_back(corners[2]);
+    vertices.push_back(corners[3]);
+}
+
+void EntityRenderer::begin() {
+    vertices.clear();
+}
+
+void EntityRenderer::submit(sf::RenderTarget& target) {
+    if (!vertices.empty())
+        target.draw(vertices.data(), vertices.size(), sf::Triangles);
+}
+
+std::size_t EntityRenderer::getVertexCount() const {
+    return vertices.size();
+}
+
+const sf::Vertex* EntityRenderer::getVertices() const {
+    return vertices.data();
+}
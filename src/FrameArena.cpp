@@ -0,0 +1,444 @@
+#include "FrameArena.h"
+#include "Game.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    // Debug fill of released arena memory
+    const unsigned char POISON = 0xCD;
+
+    // Overflow block header (the block's memory follows it)
+    struct OverflowBlock {
+        OverflowBlock* next;
+        std::size_t bytes;         // Whole block, header included
+        std::size_t alignment;
+    };
+
+    // Allocation check: frames per phase, warm-up frames before them
+    const int CHECK_FRAMES = 20000;
+    const int CHECK_WARMUP = 120;
+    const float CHECK_DT = 1.f / 60.f;
+
+    thread_local std::uint64_t threadAllocations = 0;
+
+    void poison(void* p, std::size_t bytes) {
+#ifndef NDEBUG
+        std::memset(p, POISON, bytes);
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+
+    std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /*
+        The replaced operator new family: count, then malloc (or an
+        aligned allocation for over-aligned types).
+    */
+    void* countedAlloc(std::size_t size) noexcept {
+        ++threadAllocations;
+        return std::malloc(size ? size : 1);
+    }
+
+    void* countedAlignedAlloc(std::size_t size, std::size_t alignment) noexcept {
+        ++threadAllocations;
+        if (size == 0)
+            size = 1;
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        void* p = nullptr;
+        if (alignment < sizeof(void*))
+            alignment = sizeof(void*);
+        return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+#endif
+    }
+
+    /*
+        Like the standard forms: on failure call the installed new_handler
+        and retry; throw std::bad_alloc when none is installed. The nothrow
+        forms run the same loop and return nullptr instead of throwing.
+    */
+    void* allocOrThrow(std::size_t size) {
+        for (;;) {
+            if (void* p = countedAlloc(size))
+                return p;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* alignedAllocOrThrow(std::size_t size, std::size_t alignment) {
+        for (;;) {
+            if (void* p = countedAlignedAlloc(size, alignment))
+                return p;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void alignedFree(void* p) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    /*
+        One frame of the allocation check: advance, stats, render, arena
+        reset – Game::runFrame() – with the allocations it made.
+    */
+    struct FrameCount {
+        std::uint64_t allocations;
+        bool transition;               // Game state changed or a new demo began
+    };
+
+    FrameCount countFrame(Game& game) {
+        GameState state = game.getState();
+        std::uint64_t demo = game.getDemoSeed();
+        std::uint64_t start = getThreadAllocationCount();
+        game.runFrame(CHECK_DT);
+        return { getThreadAllocationCount() - start,
+                 game.getState() != state || game.getDemoSeed() != demo };
+    }
+
+    /*
+        Run 'frames' frames after the warm-up; print the phase's line.
+        Returns the allocations made by steady (non-transition) frames.
+    */
+    std::uint64_t checkPhase(Game& game, const char* name, int frames, bool playing) {
+        std::uint64_t steadyAllocations = 0, transitionAllocations = 0;
+        int steadyFrames = 0, transitions = 0, allocatingFrames = 0;
+
+        for (int i = -CHECK_WARMUP; i < frames; ++i) {
+            if (playing && game.getState() != GameState::PLAYING)
+                game.startMatch(GameMode::PLAYER_VS_AI);
+
+            FrameCount count = countFrame(game);
+            if (i < 0)
+                continue;
+
+            if (count.transition) {
+                ++transitions;
+                transitionAllocations += count.allocations;
+            }
+            else {
+                ++steadyFrames;
+                steadyAllocations += count.allocations;
+                allocatingFrames += count.allocations > 0;
+            }
+        }
+
+        std::printf("%-8s %6d steady frames: %llu allocations (%d frames allocating)   "
+                    "%d transitions: %llu allocations\n",
+                    name, steadyFrames, static_cast<unsigned long long>(steadyAllocations),
+                    allocatingFrames, transitions,
+                    static_cast<unsigned long long>(transitionAllocations));
+        return steadyAllocations;
+    }
+}
+
+
+/*
+    Replaceable global allocation functions (every form), counted per
+    thread. Deallocation is not counted.
+*/
+void* operator new(std::size_t size) {
+    return allocOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocOrThrow(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return alignedAllocOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return alignedAllocOrThrow(size, static_cast<std::size_t>(alignment));
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, alignment, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+
+
+std::uint64_t getThreadAllocationCount() {
+    return threadAllocations;
+}
+
+
+/*
+    Constructor: FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+
+    Objective:
+        Empty arena with its buffer allocated.
+
+    Input Parameters:
+        - std::size_t capacity: Initial buffer size in bytes.
+        - std::pmr::memory_resource* upstream: Overflow blocks come from here.
+
+    Return Value:
+        - None (constructor)
+
+    Side Effects:
+        - Allocates the buffer.
+*/
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+    : upstream(upstream),
+      buffer(capacity),
+      used(0),
+      overflow(nullptr),
+      overflowBytes(0),
+      peakBytes(0),
+      overflowFrames(0)
+{
+}
+
+
+FrameArena::~FrameArena() {
+    while (overflow) {
+        OverflowBlock* block = static_cast<OverflowBlock*>(overflow);
+        overflow = block->next;
+        upstream->deallocate(block, block->bytes, block->alignment);
+    }
+}
+
+
+/*
+    Function: void FrameArena::reset()
+
+    Objective:
+        Release the frame's allocations.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Poisons the used part of the buffer (debug builds).
+        - Frees overflow blocks; after an overflowing frame, replaces
+          the buffer with one large enough for it.
+
+    Approach:
+        - Everything allocated this frame is dead by contract, so the
+          buffer is simply rewound.
+*/
+void FrameArena::reset() {
+    peakBytes = std::max(peakBytes, used + overflowBytes);
+    poison(buffer.data(), used);
+    used = 0;
+
+    if (!overflow)
+        return;
+
+    while (overflow) {
+        OverflowBlock* block = static_cast<OverflowBlock*>(overflow);
+        overflow = block->next;
+        upstream->deallocate(block, block->bytes, block->alignment);
+    }
+    overflowBytes = 0;
+    ++overflowFrames;
+
+    // Grow so the next frame like this one fits
+    std::vector<unsigned char>(peakBytes + peakBytes / 2).swap(buffer);
+}
+
+
+std::size_t FrameArena::getUsedBytes() const {
+    return used + overflowBytes;
+}
+
+
+std::size_t FrameArena::getCapacity() const {
+    return buffer.size();
+}
+
+
+std::size_t FrameArena::getPeakBytes() const {
+    return std::max(peakBytes, used + overflowBytes);
+}
+
+
+std::uint64_t FrameArena::getOverflowFrames() const {
+    return overflowFrames;
+}
+
+
+/*
+    Function: void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+
+    Objective:
+        Hand out 'bytes' bytes for the rest of the frame.
+
+    Input Parameters:
+        - std::size_t bytes: Size.
+        - std::size_t alignment: Required alignment (a power of two).
+
+    Return Value:
+        - void*: The memory.
+
+    Side Effects:
+        - Advances the buffer, or links an upstream overflow block.
+
+    Approach:
+        - Align the bump offset; past the end of the buffer, take a
+          block from upstream big enough for the request.
+*/
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.data());
+    std::size_t start = alignUp(base + used, alignment) - base;
+    if (start + bytes <= buffer.size()) {
+        used = start + bytes;
+        return buffer.data() + start;
+    }
+
+    std::size_t blockAlignment = std::max(alignment, alignof(std::max_align_t));
+    std::size_t header = alignUp(sizeof(OverflowBlock), blockAlignment);
+    std::size_t size = header + bytes;
+    void* memory = upstream->allocate(size, blockAlignment);
+
+    OverflowBlock* block = static_cast<OverflowBlock*>(memory);
+    block->next = static_cast<OverflowBlock*>(overflow);
+    block->bytes = size;
+    block->alignment = blockAlignment;
+    overflow = block;
+    overflowBytes += size;
+    return static_cast<unsigned char*>(memory) + header;
+}
+
+
+/*
+    Function: void FrameArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+
+    Objective:
+        Release one allocation early.
+
+    Input Parameters:
+        - void* p: Memory from do_allocate().
+        - std::size_t bytes: Its size.
+        - std::size_t alignment: Its alignment (unused).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Rolls the buffer back if 'p' was the newest allocation.
+
+    Approach:
+        - Anything else waits for reset(): a bump allocator cannot
+          reuse holes, and does not need to within one frame.
+*/
+void FrameArena::do_deallocate(void* p, std::size_t bytes, std::size_t) {
+    unsigned char* memory = static_cast<unsigned char*>(p);
+    if (memory >= buffer.data() && memory + bytes == buffer.data() + used) {
+        poison(memory, bytes);
+        used = static_cast<std::size_t>(memory - buffer.data());
+    }
+}
+
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+
+/*
+    Function: int runAllocationCommand(int argc, char** argv)
+
+    Objective:
+        Show that the game's steady-state frames make no heap
+        allocation.
+
+    Input Parameters:
+        - int argc, char** argv: Process arguments (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code (1 if a steady frame allocated).
+
+    Side Effects:
+        - Prints one line per phase.
+
+    Approach:
+        - Headless Game (no window, keyboard, audio device or session
+          file); menu phase with the attract demo, then AI-mode matches
+          restarted whenever one ends.
+        - Each frame is Game::runFrame(), allocations counted around it.
+*/
+int runAllocationCommand(int argc, char** argv) {
+    int frames = CHECK_FRAMES;
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--frames" && i + 1 < argc)
+            frames = std::atoi(argv[++i]);
+        else {
+            std::printf("Usage: pong --alloc-check [--frames N]\n");
+            return 1;
+        }
+    }
+    if (frames <= 0) {
+        std::printf("--frames must be positive\n");
+        return 1;
+    }
+
+    Game game(true);
+    std::uint64_t steady = checkPhase(game, "menu", frames, false);
+    steady += checkPhase(game, "playing", frames, true);
+
+    std::printf("%s\n", steady == 0 ? "OK: steady-state frames allocate nothing"
+                                    : "FAIL: steady-state frames allocate");
+    return steady == 0 ? 0 : 1;
+}
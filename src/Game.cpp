@@ -1,61 +1,212 @@
 #include "Game.h"
+#include "Metrics.h"
+#include "PaddleController.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 #include <fstream>
 #include <iostream>
 
 namespace {
-    const int WINDOW_WIDTH  = 640;
-    const int WINDOW_HEIGHT = 600;
+    // UI layout size (menu, HUD, game over) and smallest window
+    const float UI_WIDTH  = 640.f;
+    const float UI_HEIGHT = 600.f;
 
-    // For PvP mode: first to this score wins
-    const int TARGET_SCORE  = 10;
+    // Particle pool size (F4 fills it for stress testing)
+    const std::size_t MAX_PARTICLES   = 100000;
 
-    // For AI mode: starting number of lives
-    const int START_LIVES   = 3;
+    // Stats overlay refresh interval (seconds)
+    const float STATS_REFRESH = 0.25f;
+
+    // Fast-forward: fixed ticks, at most this many per displayed frame
+    // (64x at 15 frames per second); the rest of the backlog is dropped
+    const float TICK_DT = 1.f / 60.f;
+    const int MAX_TICKS_PER_FRAME = 256;
+
+    // Developer time scale range (F7 halves, F8 doubles)
+    const float MIN_TIME_SCALE = 0.25f;
+    const float MAX_TIME_SCALE = 64.f;
+
+    // Attract mode: a demo longer than this (one minute) is replaced
+    const long DEMO_TICKS = 60L * 60;
+
+    // Observatory: the top of the field is left for its tally line
+    const float OBSERVATORY_HEADER = 0.06f;
+
+    // Leaderboard journal and entries kept per mode
+    const char* LEADERBOARD_PATH = "leaderboard.dat";
+    const std::size_t LEADERBOARD_SIZE = 10;
+
+    // Mirror of the match in progress (resumed at start-up)
+    const char* SESSION_PATH = "session.dat";
+
+    // Per-frame scratch memory (HUD and message strings); grows if a
+    // frame ever needs more
+    const std::size_t FRAME_ARENA_BYTES = 16 * 1024;
+
+    // Glyph atlas of assets/font.ttf, generated by the build (make)
+    const char* FONT_ATLAS_PATH = "assets/font.sdf";
+
+    // Loads the UI font; the menu lays its text out as it is constructed
+    const SdfFont& loadFont(SdfFont& font) {
+        if (!font.loadFromFile(FONT_ATLAS_PATH))
+            std::cout << "Failed to load font atlas " << FONT_ATLAS_PATH << "\n";
+        return font;
+    }
+
+    // Name recorded with AI-mode results: the OS user, if known
+    std::string defaultPlayerName() {
+        const char* user = std::getenv("USER");
+        if (!user || !*user)
+            user = std::getenv("USERNAME");
+        return (user && *user) ? user : "Player";
+    }
+
+    // UI view: 640x600 on the window's letterbox (see gameUiRect())
+    sf::View letterboxedUiView(sf::Vector2u size) {
+        sf::FloatRect pixels = gameUiRect(size);
+
+        sf::View view(sf::FloatRect(0.f, 0.f, UI_WIDTH, UI_HEIGHT));
+        view.setViewport(sf::FloatRect(pixels.left / size.x, pixels.top / size.y,
+                                       pixels.width / size.x, pixels.height / size.y));
+        return view;
+    }
+
+    // Appends a decimal integer without a temporary std::string
+    void appendNumber(std::pmr::string& text, long value) {
+        char digits[24];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        text.append(digits, result.ptr);
+    }
+
+    // Keyboard state → paddle action (both keys held cancel out)
+    PaddleAction readPaddleKeys(sf::Keyboard::Key upKey, sf::Keyboard::Key downKey) {
+        bool up   = sf::Keyboard::isKeyPressed(upKey);
+        bool down = sf::Keyboard::isKeyPressed(downKey);
+
+        if (up && !down)
+            return PaddleAction::UP;
+        if (down && !up)
+            return PaddleAction::DOWN;
+        return PaddleAction::STAY;
+    }
+}
+
+/*
+    Functions: gameWindowSize / gameUiRect
+
+    Objective:
+        Window layout of a game, shared with renderers that reproduce
+        its frames (video export).
+
+    Approach:
+        - Window: the arena scaled up (uniformly) until the UI fits.
+        - UI: 640x600 at the largest uniform scale, centered.
+*/
+sf::Vector2u gameWindowSize(const Arena& arena) {
+    float scale = std::max({ 1.f, UI_WIDTH / arena.width, UI_HEIGHT / arena.height });
+    return sf::Vector2u(static_cast<unsigned>(arena.width * scale + 0.5f),
+                        static_cast<unsigned>(arena.height * scale + 0.5f));
+}
+
+sf::FloatRect gameUiRect(sf::Vector2u size) {
+    float scale = std::min(size.x / UI_WIDTH, size.y / UI_HEIGHT);
+    float width = UI_WIDTH * scale;
+    float height = UI_HEIGHT * scale;
+    return sf::FloatRect((size.x - width) / 2.f, (size.y - height) / 2.f, width, height);
 }
 
+
 /*
-    Constructor: Game::Game()
+    Constructor: Game::Game(bool headless, const std::string& aiName, const Arena& arena)
 
     Objective:
-        Set up the game window, initialize game objects (paddles, ball),
+        Set up the game window, initialize game objects (match, AI),
         load fonts, texts, high score, and prepare the menu.
 
     Input Parameters:
-        - None (constructor).
+        - bool headless: Render offscreen instead of opening a window.
+        - const std::string& aiName: Registered controller for the AI paddle.
+        - const Arena& arena: Field and rules of every match.
 
     Return Value:
         - None.
 
     Side Effects:
-        - Loads font from file.
-        - Reads high score from disk.
+        - Loads the font atlas from file.
+        - Reads the leaderboard journal from disk.
+        - Maps the session file; may resume an interrupted match.
         - Initializes SFML window and graphical objects.
+        - Starts the audio stream (windowed games only).
 
     Approach:
-        - Create window and set framerate.
-        - Initialize paddles, ball, and game state.
-        - Load resources (font).
+        - Create window and set framerate (or the offscreen texture), sized
+          from the arena: the field view maps the arena onto the whole
+          window, the UI view keeps the 640x600 layout letterboxed.
+        - Initialize the match, AI controller, and game state. The AI is
+          created reproducible: every AI-mode game is recorded for score
+          verification, which replays it with the same controller.
+        - Load the font atlas first: the menu lays its text out with it.
         - Initialize UI texts.
         - Load high score and pass it to menu.
+        - Resume the match in progress, if the session file holds one.
 */
-Game::Game()
-    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT),
-             "Pong",
-             sf::Style::Titlebar | sf::Style::Close),
+Game::Game(bool headless, const std::string& aiName, const Arena& arena)
+    : headless(headless),
+      target(&window),
+      targetReady(true),
       state(GameState::MENU),
       mode(GameMode::PLAYER_VS_AI),
-      leftPaddle(30.f, 250.f),
-      rightPaddle(590.f, 250.f),
-      ball(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f),
-      leftScore(0),
-      rightScore(0),
+      arena(arena),
+      fieldView(sf::FloatRect(0.f, 0.f, arena.width, arena.height)),
+      uiView(letterboxedUiView(gameWindowSize(arena))),
+      menu(loadFont(font)),
+      match(GameMode::PLAYER_VS_AI, 0, arena),
+      aiController(createController(aiName, true)),
+      aiName(aiName),
+      botSide(Side::LEFT),
       highScore(0),
-      lives(START_LIVES)
+      leaderboard(LEADERBOARD_PATH, LEADERBOARD_SIZE),
+      session(headless ? "" : SESSION_PATH),
+      statsStore(MATCH_STATS_PATH),
+      playerName(defaultPlayerName()),
+      outbox(SUBMISSIONS_DIR),
+      particles(MAX_PARTICLES),
+      showStats(false),
+      statsTimer(0.f),
+      statsFrames(0),
+      rallyHits(0),
+      timeTravel(false),
+      historyCursor(0),
+      rewritten(false),
+      demo(GameMode::PLAYER_VS_PLAYER, 0, arena),
+      demoLeft(createController(aiName)),
+      demoRight(createController(aiName)),
+      demoSeed(static_cast<std::uint64_t>(std::time(nullptr))),
+      observatory(arena, aiName, aiName),
+      timeScale(1.f),
+      tickBacklog(0.f),
+      statsTicks(0),
+      frameArena(FRAME_ARENA_BYTES),
+      statsAllocations(getThreadAllocationCount())
 {
-    window.setFramerateLimit(60);
-
-    if (!font.loadFromFile("assets/font.ttf")) {
-        std::cout << "Failed to load font\n";
+    sf::Vector2u size = gameWindowSize(arena);
+    if (headless) {
+        if (!offscreen.create(size.x, size.y)) {
+            std::cout << "Failed to create offscreen render texture\n";
+            targetReady = false;
+        }
+        target = &offscreen;
+    }
+    else {
+        window.create(sf::VideoMode(size.x, size.y),
+                      "Pong",
+                      sf::Style::Titlebar | sf::Style::Close);
+        window.setFramerateLimit(60);
+        audio.start();
     }
 
     // Score text during gameplay
@@ -82,8 +233,42 @@ Game::Game()
     continueText.setPosition(110.f, 330.f);
     continueText.setString("Press Enter to return to Menu");
 
+    // Stats overlay (F3)
+    statsText.setFont(font);
+    statsText.setCharacterSize(14);
+    statsText.setFillColor(sf::Color(160, 160, 160));
+    statsText.setPosition(8.f, UI_HEIGHT - 78.f);
+
+    // Time-travel banner (F6)
+    historyText.setFont(font);
+    historyText.setCharacterSize(14);
+    historyText.setFillColor(sf::Color(255, 200, 80));
+    historyText.setPosition(8.f, 60.f);
+
+    // Time scale indicator (F7/F8)
+    timeScaleText.setFont(font);
+    timeScaleText.setCharacterSize(18);
+    timeScaleText.setFillColor(sf::Color(255, 200, 80));
+    timeScaleText.setPosition(UI_WIDTH - 80.f, UI_HEIGHT - 30.f);
+
+    // Attract mode: the demo plays dimmed behind the menu
+    menuShade.setSize(sf::Vector2f(arena.width, arena.height));
+    menuShade.setFillColor(sf::Color(0, 0, 0, 170));
+    restartDemo();
+
+    // Observatory: grid below a one-line header
+    observatory.layout(sf::FloatRect(0.f, arena.height * OBSERVATORY_HEADER,
+                                     arena.width, arena.height * (1.f - OBSERVATORY_HEADER)));
+    observatoryText.setFont(font);
+    observatoryText.setCharacterSize(16);
+    observatoryText.setFillColor(sf::Color(200, 200, 200));
+    observatoryText.setPosition(8.f, 8.f);
+
     loadHighScore();
     menu.setHighScore(highScore);
+    menu.setTopScores(leaderboard.getEntries(GameMode::PLAYER_VS_AI));
+
+    resumeSession();
 }
 
 
@@ -102,21 +287,134 @@ Game::Game()
 
     Side Effects:
         - Opens and runs the game loop which continues until window closes.
+        - Records frame and update times in the metrics registry.
 
     Approach:
         - Use an SFML clock to calculate delta time.
-        - Continuously call event processing, updating, and rendering.
+        - Continuously call event processing and runFrame(): advance()
+          (the frame's update ticks at the current time scale), one
+          render and the frame arena reset.
 */
 void Game::run() {
     sf::Clock clock;
 
     while (window.isOpen()) {
         float dt = clock.restart().asSeconds();
+        observeMetric(MetricHistogram::FRAME_SECONDS, dt);
 
         processEvents();
-        update(dt);
+        runFrame(dt);
+    }
+}
+
+
+/*
+    Function: void Game::runFrame(float frameSeconds)
+
+    Objective:
+        Simulate and draw one frame.
+
+    Input Parameters:
+        - float frameSeconds: Real time since the previous frame.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Updates the game, rebuilds the stats text, draws.
+        - Releases everything allocated from frameArena this frame.
+
+    Approach:
+        - Time travel pauses the game on a recorded frame, so advance()
+          is skipped while it is on.
+        - The arena reset comes last: HUD strings built during the
+          update are gone by the next frame.
+*/
+void Game::runFrame(float frameSeconds) {
+    if (!timeTravel)
+        statsTicks += advance(frameSeconds);
+
+    updateStats(frameSeconds);
+    if (targetReady)
         render();
+
+    frameArena.reset();
+}
+
+
+/*
+    Function: int Game::advance(float frameSeconds)
+
+    Objective:
+        Simulate one displayed frame's worth of time.
+
+    Input Parameters:
+        - float frameSeconds: Real time since the previous frame.
+
+    Return Value:
+        - int: update() calls made.
+
+    Side Effects:
+        - Updates the game; records each update's duration in the
+          metrics registry.
+
+    Approach:
+        - Scale 1 or below: one update() with the scaled frame time,
+          exactly the original loop at 1x and smooth slow motion below.
+        - Above 1: fixed TICK_DT ticks from a backlog of scaled time, so
+          fast-forwarded play is the same simulation as normal play,
+          only more of it per frame. Intermediate states are never
+          drawn; render() shows the last one.
+        - At most MAX_TICKS_PER_FRAME ticks: a frame that cannot keep up
+          drops the rest of its backlog instead of snowballing.
+*/
+int Game::advance(float frameSeconds) {
+    typedef std::chrono::steady_clock Clock;
+
+    float scaled = frameSeconds * timeScale;
+    float dt = scaled;
+    int ticks = 1;
+
+    if (timeScale > 1.f) {
+        tickBacklog += scaled;
+        ticks = std::min(static_cast<int>(tickBacklog / TICK_DT), MAX_TICKS_PER_FRAME);
+        tickBacklog = ticks < MAX_TICKS_PER_FRAME ? tickBacklog - ticks * TICK_DT : 0.f;
+        dt = TICK_DT;
+    }
+
+    for (int i = 0; i < ticks; ++i) {
+        Clock::time_point updateStart = Clock::now();
+        update(dt);
+        observeMetric(MetricHistogram::UPDATE_SECONDS,
+                      std::chrono::duration<double>(Clock::now() - updateStart).count());
     }
+    return ticks;
+}
+
+
+/*
+    Function: void Game::setTimeScale(float scale)
+
+    Objective:
+        Change the simulation speed.
+
+    Input Parameters:
+        - float scale: Simulated seconds per real second.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Clamps to MIN_TIME_SCALE .. MAX_TIME_SCALE, clears the tick
+          backlog and updates the on-screen indicator.
+*/
+void Game::setTimeScale(float scale) {
+    timeScale = std::max(MIN_TIME_SCALE, std::min(MAX_TIME_SCALE, scale));
+    tickBacklog = 0.f;
+
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "x%g", timeScale);
+    timeScaleText.setString(buffer);
 }
 
 
@@ -142,6 +440,7 @@ void Game::run() {
         - Poll events from SFML.
         - Handle menu clicks for choosing game mode.
         - Handle enter key to return from game over.
+        - O / Escape open and close the observatory.
 */
 void Game::processEvents() {
     sf::Event event;
@@ -156,38 +455,50 @@ void Game::processEvents() {
             event.type == sf::Event::MouseButtonPressed &&
             event.mouseButton.button == sf::Mouse::Left) {
 
-            sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+            sf::Vector2f uiPos = window.mapPixelToCoords(sf::Mouse::getPosition(window), uiView);
+            sf::Vector2i mousePos(static_cast<int>(uiPos.x), static_cast<int>(uiPos.y));
 
             if (menu.isAISelected(mousePos)) {
-                mode = GameMode::PLAYER_VS_AI;
-
-                leftScore = 0;
-                rightScore = 0;
-                lives = START_LIVES;
-                scoreText.setString("Score: 0   Lives: " + std::to_string(lives));
-
-                resetRound();
-                state = GameState::PLAYING;
+                startMatch(GameMode::PLAYER_VS_AI);
             }
             else if (menu.isPVPSelected(mousePos)) {
-                mode = GameMode::PLAYER_VS_PLAYER;
-
-                leftScore = 0;
-                rightScore = 0;
-                scoreText.setPosition(WINDOW_WIDTH / 2.f - 40.f, 20.f);
-                scoreText.setString("0 : 0");
-
-                resetRound();
-                state = GameState::PLAYING;
+                startMatch(GameMode::PLAYER_VS_PLAYER);
             }
         }
 
+        // Observatory: O on the menu opens it, Escape closes it
+        if (event.type == sf::Event::KeyPressed) {
+            if (state == GameState::MENU && event.key.code == sf::Keyboard::O)
+                openObservatory(OBSERVATORY_DEFAULT_MATCHES);
+            else if (state == GameState::OBSERVATORY && event.key.code == sf::Keyboard::Escape)
+                state = GameState::MENU;
+        }
+
         // Game over → back to menu
         if (state == GameState::GAME_OVER &&
             event.type == sf::Event::KeyPressed &&
             event.key.code == sf::Keyboard::Enter) {
 
             state = GameState::MENU;
+            timeTravel = false;
+        }
+
+        // Debug: stats overlay + particle stress burst + time travel
+        if (event.type == sf::Event::KeyPressed) {
+            if (event.key.code == sf::Keyboard::F3)
+                showStats = !showStats;
+
+            if (event.key.code == sf::Keyboard::F6 || timeTravel)
+                handleTimeTravelKey(event.key.code, event.key.shift);
+
+            if (event.key.code == sf::Keyboard::F7)
+                setTimeScale(timeScale / 2.f);
+            if (event.key.code == sf::Keyboard::F8)
+                setTimeScale(timeScale * 2.f);
+
+            if (event.key.code == sf::Keyboard::F4 && state == GameState::PLAYING)
+                particles.emit(arena.width / 2.f, arena.height / 2.f,
+                               MAX_PARTICLES, sf::Color(255, 200, 80), 400.f);
         }
     }
 }
@@ -211,119 +522,127 @@ void Game::processEvents() {
         - Updates scores and lives.
         - Triggers game over.
         - Modifies text UI.
+        - Queues sounds for the audio thread (never blocks).
+        - Mirrors the match into the session file (cleared at game over).
+        - Records points, AI misses, rally lengths and finished games
+          in the metrics registry.
+        - Queues the finished match's statistics for the stats store.
 
     Approach:
-        - Process player or AI paddle movement.
-        - Update ball and check collisions.
-        - Apply scoring rules depending on game mode.
+        - Read player keys / ask the AI controller (or the attached bot,
+          for its side) for paddle actions.
+        - Step the match (movement, collisions, scoring, game over).
+        - Emit particles and post sounds for the events the step reported.
         - Update score display.
-        - Check for end-of-game conditions.
+        - Count the step's match statistics.
+        - Record the result (and statistics) when the match ends; an
+          AI-mode game recorded from its first step is also queued as a
+          score submission with its replay (see ScoreReplay.h).
 */
 void Game::update(float dt) {
-    if (state != GameState::PLAYING)
-        return;
+    // Let effects finish fading even after the match ends
+    particles.update(dt);
 
-    // ---------- Controls & AI ----------
-    if (mode == GameMode::PLAYER_VS_PLAYER) {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
-            leftPaddle.moveUp(dt);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
-            leftPaddle.moveDown(dt);
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
-            rightPaddle.moveUp(dt);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
-            rightPaddle.moveDown(dt);
-    }
-    else if (mode == GameMode::PLAYER_VS_AI) {
-        // Player controls left paddle
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
-            leftPaddle.moveUp(dt);
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
-            leftPaddle.moveDown(dt);
-
-        // AI moves right paddle to follow ball
-        float ballCenterY   = ball.getBounds().top + ball.getBounds().height / 2.f;
-        float paddleCenterY = rightPaddle.getBounds().top + 50.f;
-
-        if (ballCenterY > paddleCenterY)
-            rightPaddle.moveDown(dt);
-        else if (ballCenterY < paddleCenterY)
-            rightPaddle.moveUp(dt);
-    }
-
-    // ---------- Ball update ----------
-    ball.update(dt);
-
-    // ---------- Paddle collisions ----------
-    if (ball.getBounds().intersects(leftPaddle.getBounds())) {
-        ball.bounceX();
+    if (state == GameState::MENU) {
+        updateDemo(dt);
+        return;
     }
-    if (ball.getBounds().intersects(rightPaddle.getBounds())) {
-        ball.bounceX();
+    if (state == GameState::OBSERVATORY) {
+        if (observatory.step(dt) > 0)
+            updateObservatoryText();
+        return;
     }
+    if (state != GameState::PLAYING)
+        return;
 
-    // ---------- Scoring ----------
-    sf::FloatRect ballBounds = ball.getBounds();
-
-    if (mode == GameMode::PLAYER_VS_AI) {
-        if (ballBounds.left + ballBounds.width < 0) {
-            lives--;
-            resetRound();
-        }
-        if (ballBounds.left > WINDOW_WIDTH) {
-            leftScore++;
-            resetRound();
-        }
-    }
-    else {
-        if (ballBounds.left + ballBounds.width < 0) {
-            rightScore++;
-            resetRound();
-        }
-        if (ballBounds.left > WINDOW_WIDTH) {
-            leftScore++;
-            resetRound();
-        }
+    // ---------- Controls, AI & bot ----------
+    MatchInput input;
+    if (botController && botSide == Side::LEFT)
+        input.left = botController->decide(match, Side::LEFT, dt);
+    else
+        input.left = headless ? PaddleAction::STAY
+                              : readPaddleKeys(sf::Keyboard::W, sf::Keyboard::S);
+
+    if (botController && botSide == Side::RIGHT)
+        input.right = botController->decide(match, Side::RIGHT, dt);
+    else if (mode == GameMode::PLAYER_VS_AI)
+        input.right = aiController->decide(match, Side::RIGHT, dt);
+    else
+        input.right = headless ? PaddleAction::STAY
+                               : readPaddleKeys(sf::Keyboard::Up, sf::Keyboard::Down);
+
+    // Ball height before the step: where a scoring burst is shown
+    sf::FloatRect before = match.getBallBounds();
+    float exitY = before.top + before.height / 2.f;
+
+    // ---------- Simulation ----------
+    scoreRecorder.record(match, dt, input);
+    unsigned events = match.step(dt, input);
+    statsRecorder.record(match, events);
+
+    // ---------- Impact effects ----------
+    sf::FloatRect b = match.getBallBounds();
+    emitMatchEffects(particles, events, exitY, b, arena.width);
+
+    // ---------- Sounds (mixed on the audio thread; muted when fast-forwarding) ----------
+    if (timeScale <= 1.f)
+        postMatchSounds(audio.getMixer(), events, b.left + b.width / 2.f, arena.width);
+
+    // ---------- Metrics ----------
+    if (events & (MatchEvent::LEFT_HIT | MatchEvent::RIGHT_HIT))
+        ++rallyHits;
+
+    if (events & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED)) {
+        countMetric(MetricCounter::POINTS);
+        if (mode == GameMode::PLAYER_VS_AI && (events & MatchEvent::LEFT_SCORED))
+            countMetric(MetricCounter::AI_MISSES);
+
+        observeMetric(MetricHistogram::RALLY_HITS, rallyHits);
+        rallyHits = 0;
     }
 
     // ---------- Update score text ----------
-    if (mode == GameMode::PLAYER_VS_AI) {
-        scoreText.setPosition(150.f, 15.f);
-        scoreText.setString(
-            "Score: " + std::to_string(leftScore) +
-            "   Lives: " + std::to_string(lives)
-        );
-    }
-    else {
-        scoreText.setPosition(WINDOW_WIDTH / 2.f - 40.f, 20.f);
-        scoreText.setString(
-            std::to_string(leftScore) + " : " + std::to_string(rightScore)
-        );
-    }
+    updateHud();
 
     // ---------- Game Over ----------
-    if (mode == GameMode::PLAYER_VS_AI) {
-        if (lives <= 0) {
-            state = GameState::GAME_OVER;
+    if (events & MatchEvent::GAME_OVER) {
+        state = GameState::GAME_OVER;
+        countMetric(MetricCounter::GAMES);
+        session.clear();
+
+        // Headless games (benchmarks) never touch the real leaderboard or
+        // stats, nor does a game whose past was rewritten by time travel
+        bool counted = !headless && !rewritten;
+        int rank = counted ? submitResult() : 0;
+        if (counted) {
+            std::int64_t now = static_cast<std::int64_t>(std::time(nullptr));
+            statsStore.append(statsRecorder.finish(match, now));
+
+            ScoreSubmission submission;
+            if (scoreRecorder.finish(match, playerName, now, submission))
+                outbox.submit(std::move(submission));
+        }
 
-            if (leftScore > highScore) {
-                highScore = leftScore;
-                saveHighScore();
-            }
+        if (mode == GameMode::PLAYER_VS_AI) {
             menu.setHighScore(highScore);
-
-            gameOverText.setString("Your Score: " + std::to_string(leftScore));
-            gameOverHighScoreText.setString(
-                "High Score (vs AI): " + std::to_string(highScore)
-            );
+            menu.setTopScores(leaderboard.getEntries(GameMode::PLAYER_VS_AI));
+
+            std::pmr::string text(&frameArena);
+            text = "Your Score: ";
+            appendNumber(text, match.getLeftScore());
+            gameOverText.setString(text);
+
+            text = "High Score (vs AI): ";
+            appendNumber(text, highScore);
+            if (rank > 0) {
+                text += "   (#";
+                appendNumber(text, rank);
+                text += ")";
+            }
+            gameOverHighScoreText.setString(text);
         }
-    }
-    else {
-        if (leftScore >= TARGET_SCORE || rightScore >= TARGET_SCORE) {
-            state = GameState::GAME_OVER;
-
-            if (leftScore > rightScore)
+        else {
+            if (match.getLeftScore() > match.getRightScore())
                 gameOverText.setString("Player 1 Wins!!!");
             else
                 gameOverText.setString("Player 2 Wins!!!");
@@ -331,6 +650,54 @@ void Game::update(float dt) {
             gameOverHighScoreText.setString("");
         }
     }
+    else if (!rewritten) {
+        session.save(match);
+    }
+
+    // ---------- Time-travel history ----------
+    HistoryFrame frame = { captureState(match), match.getProgress(), match.getSeed(), mode, state, dt };
+    history.record(frame);
+}
+
+
+/*
+    Function: void Game::updateHud()
+
+    Objective:
+        Refresh the score (and lives) text shown during play.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Modifies scoreText.
+
+    Approach:
+        - AI mode: "Score: N   Lives: N" at the top left.
+        - PvP mode: "L : R" centered at the top.
+        - The string is built in the frame arena (no heap allocation);
+          the text keeps its own copy.
+*/
+void Game::updateHud() {
+    std::pmr::string text(&frameArena);
+
+    if (mode == GameMode::PLAYER_VS_AI) {
+        scoreText.setPosition(150.f, 15.f);
+        text = "Score: ";
+        appendNumber(text, match.getLeftScore());
+        text += "   Lives: ";
+        appendNumber(text, match.getLives());
+    }
+    else {
+        scoreText.setPosition(UI_WIDTH / 2.f - 40.f, 20.f);
+        appendNumber(text, match.getLeftScore());
+        text += " : ";
+        appendNumber(text, match.getRightScore());
+    }
+    scoreText.setString(text);
 }
 
 
@@ -347,33 +714,78 @@ void Game::update(float dt) {
         - void
 
     Side Effects:
-        - Clears and updates the contents of the window each frame.
+        - Clears and updates the contents of the window (or offscreen
+          texture) each frame.
 
     Approach:
         - Clear the screen.
-        - Draw appropriate objects depending on state.
+        - Draw appropriate objects depending on state: the match and its
+          particles in arena coordinates, text in UI coordinates.
+        - Observatory: every match of the grid in one batched draw call
+          (see Observatory::draw()), then its header line.
         - Display updated frame.
 */
 void Game::render() {
-    window.clear(sf::Color::Black);
+    target->clear(sf::Color::Black);
+    target->setView(uiView);
 
     if (state == GameState::MENU) {
-        menu.draw(window);
+        target->setView(fieldView);
+        entityRenderer.draw(demo.getEntities(), *target);
+        target->draw(menuShade);
+        target->setView(uiView);
+        menu.draw(*target);
     }
     else if (state == GameState::PLAYING) {
-        leftPaddle.draw(window);
-        rightPaddle.draw(window);
-        ball.draw(window);
-        window.draw(scoreText);
+        target->setView(fieldView);
+        entityRenderer.draw(match.getEntities(), *target);
+        particles.draw(*target);
+        target->setView(uiView);
+        target->draw(scoreText);
+    }
+    else if (state == GameState::OBSERVATORY) {
+        target->setView(fieldView);
+        observatory.draw(entityRenderer, *target);
+        target->setView(uiView);
+        target->draw(observatoryText);
     }
     else if (state == GameState::GAME_OVER) {
-        window.draw(gameOverText);
-        if (!gameOverHighScoreText.getString().isEmpty())
-            window.draw(gameOverHighScoreText);
-        window.draw(continueText);
+        target->draw(gameOverText);
+        if (!gameOverHighScoreText.getString().empty())
+            target->draw(gameOverHighScoreText);
+        target->draw(continueText);
     }
 
-    window.display();
+    if (showStats)
+        target->draw(statsText);
+    if (timeTravel)
+        target->draw(historyText);
+    if (timeScale != 1.f)
+        target->draw(timeScaleText);
+
+    if (headless)
+        offscreen.display();
+    else
+        window.display();
+}
+
+
+/*
+    Read-only accessors
+
+    Objective:
+        Let benchmarks check the state of a headless Game.
+*/
+std::uint64_t Game::getDemoSeed() const {
+    return demoSeed;
+}
+
+GameState Game::getState() const {
+    return state;
+}
+
+bool Game::isRenderable() const {
+    return targetReady;
 }
 
 
@@ -381,7 +793,7 @@ void Game::render() {
     Function: void Game::loadHighScore()
 
     Objective:
-        Load the high score from a text file.
+        Load the AI-mode high score from the leaderboard.
 
     Input Parameters:
         - None
@@ -390,55 +802,279 @@ void Game::render() {
         - void
 
     Side Effects:
-        - Reads from disk.
+        - May read the legacy "highscore.txt" and import it once.
         - Changes the highScore variable.
 
     Approach:
-        - Open "highscore.txt"
-        - Read integer value if file exists.
+        - If the AI table is empty and "highscore.txt" holds a positive
+          score, submit it so the old record carries over.
+        - Take the best AI-mode score from the leaderboard.
 */
 void Game::loadHighScore() {
-    std::ifstream file("highscore.txt");
-    highScore = 0;
+    if (leaderboard.getEntries(GameMode::PLAYER_VS_AI).empty()) {
+        std::ifstream file("highscore.txt");
+        int legacyScore = 0;
 
-    if (file) {
-        file >> highScore;
+        if (file && (file >> legacyScore) && legacyScore > 0)
+            leaderboard.submit(GameMode::PLAYER_VS_AI, legacyScore, playerName);
     }
+
+    highScore = leaderboard.getBest(GameMode::PLAYER_VS_AI);
 }
 
 
 /*
-    Function: void Game::saveHighScore()
+    Function: int Game::submitResult()
 
     Objective:
-        Save the current high score to disk.
+        Record the game that just ended in the leaderboard.
 
     Input Parameters:
         - None
 
+    Return Value:
+        - int: Rank of the result in its mode's table (0 if unranked).
+
+    Side Effects:
+        - Queues a journal record for the background writer thread.
+        - Updates highScore.
+
+    Approach:
+        - AI mode: the player's score under playerName.
+        - PvP mode: the winner's margin of victory under "Player 1/2".
+        - The disk write happens on the leaderboard thread, so the frame
+          that ends the game never waits for I/O.
+*/
+int Game::submitResult() {
+    int rank;
+
+    if (mode == GameMode::PLAYER_VS_AI) {
+        rank = leaderboard.submit(mode, match.getLeftScore(), playerName);
+    }
+    else {
+        int margin = match.getLeftScore() - match.getRightScore();
+        bool leftWon = margin > 0;
+        rank = leaderboard.submit(mode,
+                                  leftWon ? margin : -margin,
+                                  leftWon ? "Player 1" : "Player 2");
+    }
+
+    highScore = leaderboard.getBest(GameMode::PLAYER_VS_AI);
+    return rank;
+}
+
+
+/*
+    Function: bool Game::resumeSession()
+
+    Objective:
+        Continue the match recorded in the session file.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - bool: true if a match was resumed.
+
+    Side Effects:
+        - Replaces the match, resets the AI controller and effects.
+        - Switches to the PLAYING state.
+
+    Approach:
+        - Only a match saved in this game's preset arena is resumed
+          (positions mean nothing in another field; custom arenas are
+          not identified by the session file).
+        - Rebuild the match from its mode and seed, then restore the
+          saved rally and progress: it continues exactly where the last
+          mirrored frame left it.
+        - The AI is reset with the same seed startMatch() gave it.
+        - A resumed game cannot be submitted as a verified score: the
+          inputs before the save are unknown.
+*/
+bool Game::resumeSession() {
+    SavedSession saved;
+    if (!session.load(saved))
+        return false;
+
+    int preset = arenaPresetIndex(arena);
+    if (preset < 0 || saved.arena != preset)
+        return false;
+
+    mode = saved.mode;
+    match = Match(mode, saved.seed, arena);
+    match.restore(saved.rally, saved.progress);
+    aiController->reset(mixSeed(saved.seed, 1));
+    rallyHits = 0;
+    statsRecorder.start(match);
+    scoreRecorder.cancel();
+    rewritten = false;
+
+    updateHud();
+    particles.clear();
+    state = GameState::PLAYING;
+    return true;
+}
+
+
+/*
+    Function: void Game::startMatch(GameMode newMode)
+
+    Objective:
+        Start a new match in the given mode.
+
+    Input Parameters:
+        - GameMode newMode: Mode selected in the menu.
+
     Return Value:
         - void
 
     Side Effects:
-        - Writes to disk (overwrites existing file).
+        - Replaces the match, resets the AI controller and effects.
+        - Switches to the PLAYING state.
 
     Approach:
-        - Open "highscore.txt" for output.
-        - Write the highScore value.
+        - Fresh Match with a time-based seed, reset AI, set the initial HUD.
+        - Start recording the replay a score submission carries (not
+          with a bot attached: the score would not be the player's).
 */
-void Game::saveHighScore() {
-    std::ofstream file("highscore.txt");
-    if (file) {
-        file << highScore;
+void Game::startMatch(GameMode newMode) {
+    mode = newMode;
+
+    std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+    match = Match(mode, seed, arena);
+    aiController->reset(mixSeed(seed, 1));
+    rallyHits = 0;
+    statsRecorder.start(match);
+    scoreRecorder.start(match, aiName);
+    if (botController)
+        scoreRecorder.cancel();
+    rewritten = false;
+
+    updateHud();
+    particles.clear();
+    state = GameState::PLAYING;
+}
+
+
+/*
+    Function: void Game::updateStats(float dt)
+
+    Objective:
+        Refresh the F3 stats overlay with frame rate and particle pool usage.
+
+    Input Parameters:
+        - float dt: delta time of the current frame.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Rewrites statsText every STATS_REFRESH seconds.
+
+    Approach:
+        - Count frames; when the refresh interval elapses, format FPS,
+          time scale and simulated ticks per second, live/capacity
+          particles, pool memory, last update/draw cost, heap
+          allocations per frame and the frame arena's peak, the
+          size of the time-travel history and the vertices of the
+          last entity batch.
+*/
+void Game::updateStats(float dt) {
+    statsTimer += dt;
+    statsFrames++;
+
+    if (statsTimer < STATS_REFRESH)
+        return;
+
+    std::uint64_t allocations = getThreadAllocationCount();
+
+    char buffer[300];
+    std::snprintf(buffer, sizeof(buffer),
+                  "FPS: %.0f   Sim: x%g, %.0f ticks/s\nParticles: %zu / %zu (%.1f MB)\n"
+                  "Update: %.0f us   Draw: %.0f us   Allocs: %.1f/frame (arena %zu B)\n"
+                  "History: %zu frames (%zu KB)   Entities: %zu vertices",
+                  statsFrames / statsTimer, timeScale, statsTicks / statsTimer,
+                  particles.getAliveCount(), particles.getCapacity(),
+                  particles.getMemoryBytes() / (1024.f * 1024.f),
+                  particles.getUpdateMicros(), particles.getDrawMicros(),
+                  static_cast<double>(allocations - statsAllocations) / statsFrames,
+                  frameArena.getPeakBytes(),
+                  history.getFrameCount(), history.getEncodedBytes() / 1024,
+                  entityRenderer.getVertexCount());
+    statsText.setString(buffer);
+    statsAllocations = allocations;
+
+    statsTimer = 0.f;
+    statsFrames = 0;
+    statsTicks = 0;
+}
+
+
+/*
+    Function: void Game::handleTimeTravelKey(sf::Keyboard::Key key, bool shift)
+
+    Objective:
+        Drive the debug time-travel mode.
+
+    Input Parameters:
+        - sf::Keyboard::Key key: Key pressed.
+        - bool shift: Shift held (scrub a second at a time).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Pauses/resumes the game; restores recorded frames.
+        - Stepping and resuming forget the frames after the cursor (and
+          unrank the match if that rewrites its past).
+
+    Approach:
+        - F6: enter on the newest frame (only during or right after a
+          match), or leave, truncating the history to the cursor so
+          the next update records a new future.
+        - Left/Right: move the cursor, clamped to the history.
+        - Period: truncate, then run the real update() once with the
+          frame's dt; the cursor follows to the frame it recorded.
+*/
+void Game::handleTimeTravelKey(sf::Keyboard::Key key, bool shift) {
+    const std::size_t SECOND = 60;
+    std::size_t frames = history.getFrameCount();
+
+    if (key == sf::Keyboard::F6) {
+        if (timeTravel) {
+            truncateHistory();
+            timeTravel = false;
+        }
+        else if (frames > 0 && state != GameState::MENU && state != GameState::OBSERVATORY) {
+            timeTravel = true;
+            showHistoryFrame(frames - 1);
+        }
+        return;
+    }
+
+    std::size_t step = shift ? SECOND : 1;
+
+    if (key == sf::Keyboard::Left)
+        showHistoryFrame(historyCursor > step ? historyCursor - step : 0);
+    else if (key == sf::Keyboard::Right)
+        showHistoryFrame(std::min(historyCursor + step, frames - 1));
+    else if (key == sf::Keyboard::Period) {
+        HistoryFrame frame;
+        if (!history.getFrame(historyCursor, frame))
+            return;
+
+        truncateHistory();
+        update(frame.dt);
+        showHistoryFrame(history.getFrameCount() - 1);
     }
 }
 
 
 /*
-    Function: void Game::resetRound()
+    Function: void Game::truncateHistory()
 
     Objective:
-        Reset the ball to the center of the screen and alternate serve direction.
+        Continue play from the frame under the time-travel cursor.
 
     Input Parameters:
         - None
@@ -447,12 +1083,187 @@ void Game::saveHighScore() {
         - void
 
     Side Effects:
-        - Resets ball position.
-        - Reverses ball velocityX.
+        - Drops the history after the cursor.
+        - When that drops frames: marks the match rewritten, cancels its
+          score replay and clears the saved session.
+
+    Approach:
+        - Leaving or stepping on the newest frame rewrites nothing (the
+          game was only paused). Any earlier frame means the player can
+          replay a point they lost, or finish a finished match a second
+          time, so the result must not reach the leaderboard or the
+          statistics, whose recorder has also counted the dropped future.
+          The score replay would fail verification anyway (its tick
+          count no longer matches); cancelling it says so up front.
+*/
+void Game::truncateHistory() {
+    if (historyCursor + 1 < history.getFrameCount()) {
+        rewritten = true;
+        scoreRecorder.cancel();
+        session.clear();
+    }
+    history.truncate(historyCursor + 1);
+}
+
+
+/*
+    Function: void Game::showHistoryFrame(std::size_t index)
+
+    Objective:
+        Make a recorded frame the current game state.
+
+    Input Parameters:
+        - std::size_t index: History frame.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - May replace the match; restores its state, mode and game state.
+        - Rewrites the HUD and the time-travel banner.
+
+    Approach:
+        - A frame of another match (seed or mode differs) rebuilds the
+          match first; Match::restore() then sets the rally and progress
+          exactly. The banner shows how far back the frame is.
+*/
+void Game::showHistoryFrame(std::size_t index) {
+    HistoryFrame frame;
+    if (!history.getFrame(index, frame))
+        return;
+
+    if (match.getSeed() != frame.seed || match.getMode() != frame.mode)
+        match = Match(frame.mode, frame.seed, arena);
+    match.restore(frame.rally, frame.progress);
+
+    mode = frame.mode;
+    state = frame.state;
+    historyCursor = index;
+    updateHud();
+
+    std::size_t frames = history.getFrameCount();
+    char buffer[200];
+    std::snprintf(buffer, sizeof(buffer),
+                  "TIME TRAVEL  frame %zu / %zu  (%zu back, tick %ld, dt %.1f ms)\n"
+                  "Left/Right: scrub (Shift: 1 s)   Period: step   F6: resume",
+                  index + 1, frames, frames - 1 - index, frame.progress.tick, frame.dt * 1000.f);
+    historyText.setString(buffer);
+}
+
+
+/*
+    Function: void Game::updateDemo(float dt)
+
+    Objective:
+        Advance the attract-mode match shown behind the menu.
+
+    Input Parameters:
+        - float dt: Tick length.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Steps the demo match; replaces it when it ends or has run for
+          DEMO_TICKS.
+
+    Approach:
+        - Both controllers decide from the same pre-step state, as in
+          Tournament::playMatch(); nothing else in the game sees the demo.
+*/
+void Game::updateDemo(float dt) {
+    MatchInput input;
+    input.left = demoLeft->decide(demo, Side::LEFT, dt);
+    input.right = demoRight->decide(demo, Side::RIGHT, dt);
+    demo.step(dt, input);
+
+    if (demo.isFinished() || demo.getTick() >= DEMO_TICKS)
+        restartDemo();
+}
+
+
+/*
+    Function: void Game::restartDemo()
+
+    Objective:
+        Start the next demo match (new seed, so new serves).
+*/
+void Game::restartDemo() {
+    ++demoSeed;
+    demo = Match(GameMode::PLAYER_VS_PLAYER, demoSeed, arena);
+    demoLeft->reset(mixSeed(demoSeed, 1));
+    demoRight->reset(mixSeed(demoSeed, 2));
+}
+
+
+/*
+    Function: void Game::openObservatory(std::size_t count, const std::string& left,
+                                         const std::string& right)
+
+    Objective:
+        Switch to the grid of AI-vs-AI matches.
+
+    Input Parameters:
+        - std::size_t count: Matches (16..256).
+        - left, right: Controllers per side; empty keeps the current ones.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Starts new observatory matches (time-based seeds) and switches
+          to the OBSERVATORY state.
+*/
+void Game::openObservatory(std::size_t count, const std::string& left, const std::string& right) {
+    if (!left.empty() || !right.empty())
+        observatory.setControllers(left.empty() ? observatory.getLeftName() : left,
+                                   right.empty() ? observatory.getRightName() : right);
+
+    observatory.start(count, static_cast<std::uint64_t>(std::time(nullptr)));
+    updateObservatoryText();
+    timeTravel = false;
+    state = GameState::OBSERVATORY;
+}
+
+
+/*
+    Function: void Game::attachBot(Side side, std::unique_ptr<PaddleController> bot)
+
+    Objective:
+        Let a controller (an external bot) play one paddle.
+
+    Input Parameters:
+        - Side side: Paddle handed over.
+        - std::unique_ptr<PaddleController> bot: Its controller.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - update() asks the bot instead of reading that side's keys (or,
+          on the right in AI mode, instead of the AI).
+*/
+void Game::attachBot(Side side, std::unique_ptr<PaddleController> bot) {
+    botSide = side;
+    botController = std::move(bot);
+}
+
+
+/*
+    Function: void Game::updateObservatoryText()
+
+    Objective:
+        Rebuild the observatory header: controllers, wins and draws.
 
     Approach:
-        - Call ball.reset() with center coordinates.
+        - Only called when a match ends, so the text is rebuilt a few
+          times per second at most, not every tick.
 */
-void Game::resetRound() {
-    ball.reset(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f);
+void Game::updateObservatoryText() {
+    char buffer[200];
+    std::snprintf(buffer, sizeof(buffer), "%zu matches   %s %ld : %ld %s   (%ld drawn)   Esc: menu",
+                  observatory.getMatchCount(), observatory.getLeftName().c_str(),
+                  observatory.getLeftWins(), observatory.getRightWins(),
+                  observatory.getRightName().c_str(), observatory.getDraws());
+    observatoryText.setString(buffer);
 }
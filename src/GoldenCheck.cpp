@@ -0,0 +1,489 @@
+#include "GoldenCheck.h"
+#include "Checksum.h"
+#include "CounterRng.h"
+#include "Match.h"
+#include "NeuralController.h"
+#include "PaddleController.h"
+#include "SimState.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    const float MATCH_DT = 1.f / 60.f;
+
+    // The corpus: GOLDEN_MATCHES matches of at most GOLDEN_MAX_TICKS steps
+    const std::uint64_t GOLDEN_SEED = 0x60D1DE11ull;
+    const std::size_t GOLDEN_MATCHES = 100000;
+    const long GOLDEN_MAX_TICKS = 3600;                 // 60 s; fits the u16 tick field
+    const char* const GOLDEN_PATH = "bench/golden.dat";
+    const char GOLDEN_MAGIC[4] = { 'G', 'L', 'D', '1' };
+
+    // Deterministic controllers only (search stops on wall time)
+    const char* const GOLDEN_CONTROLLERS[] = { "chase", "lazy", "predict", "neural" };
+    const std::size_t GOLDEN_CONTROLLER_COUNT = sizeof(GOLDEN_CONTROLLERS) / sizeof(GOLDEN_CONTROLLERS[0]);
+    const int SCRIPTED = -1;
+
+    // Scripted input: each action is held for 1..SCRIPT_MAX_HOLD ticks
+    const std::uint32_t SCRIPT_MAX_HOLD = 45;
+
+    // Matches claimed by a worker at a time
+    const std::size_t CHUNK = 64;
+
+    // Mismatches listed before the rest are only counted
+    const std::size_t MAX_LISTED = 10;
+
+    // The server's match kernel (SimMatch), specialized per preset as
+    // GameServer instantiates it; checked against Match in PvP matches
+    typedef SimMatch (*SimMatchStart)(std::uint64_t seed);
+    typedef unsigned (*SimMatchStep)(SimMatch& match, const MatchInput& input, float dt);
+    const SimMatchStart SIM_MATCH_STARTS[] = {
+        &startSimMatch<CLASSIC_ARENA>, &startSimMatch<WIDE_ARENA>,
+        &startSimMatch<TINY_ARENA>, &startSimMatch<TOURNAMENT_ARENA>
+    };
+    const SimMatchStep SIM_MATCH_STEPS[] = {
+        &stepSimMatch<CLASSIC_ARENA>, &stepSimMatch<WIDE_ARENA>,
+        &stepSimMatch<TINY_ARENA>, &stepSimMatch<TOURNAMENT_ARENA>
+    };
+    static_assert(sizeof(SIM_MATCH_STEPS) / sizeof(SIM_MATCH_STEPS[0]) == ARENA_PRESET_COUNT,
+                  "one server kernel per arena preset");
+
+    static_assert(sizeof(GoldenOutcome) == 12, "GoldenOutcome is stored as-is in the golden file");
+    static_assert(sizeof(SimState) == 24, "the digest covers SimState as raw bytes");
+
+    /*
+        What corpus match 'index' is: derived from its seed alone.
+        Kinds (index % 4): AI vs AI, script vs AI in AI mode, script vs
+        script, AI vs script.
+    */
+    struct GoldenSetup {
+        std::uint64_t seed;
+        GameMode mode;
+        std::size_t arena;          // ARENA_PRESETS index
+        int left, right;            // GOLDEN_CONTROLLERS index or SCRIPTED
+    };
+
+    GoldenSetup goldenSetup(std::size_t index) {
+        GoldenSetup setup;
+        setup.seed = mixSeed(GOLDEN_SEED, index);
+        setup.arena = static_cast<std::size_t>((setup.seed >> 8) % ARENA_PRESET_COUNT);
+        setup.mode = index % 4 == 1 ? GameMode::PLAYER_VS_AI : GameMode::PLAYER_VS_PLAYER;
+
+        int leftAi = static_cast<int>((setup.seed >> 16) % GOLDEN_CONTROLLER_COUNT);
+        int rightAi = static_cast<int>((setup.seed >> 24) % GOLDEN_CONTROLLER_COUNT);
+        switch (index % 4) {
+            case 0:  setup.left = leftAi;   setup.right = rightAi;  break;
+            case 1:  setup.left = SCRIPTED; setup.right = rightAi;  break;
+            case 2:  setup.left = SCRIPTED; setup.right = SCRIPTED; break;
+            default: setup.left = leftAi;   setup.right = SCRIPTED; break;
+        }
+        return setup;
+    }
+
+    const char* driverName(int driver) {
+        return driver == SCRIPTED ? "script" : GOLDEN_CONTROLLERS[driver];
+    }
+
+    /*
+        One paddle of a corpus match: a controller, or random actions
+        from the seed's SCRIPT stream (left and right use separate
+        halves of it), each held for a random number of ticks.
+    */
+    class GoldenDriver {
+    private:
+        std::unique_ptr<PaddleController> controller;
+        CounterRng rng;
+        std::uint64_t draw;
+        PaddleAction action;
+        std::uint32_t hold;
+
+    public:
+        GoldenDriver(int driver, std::uint64_t seed, Side side)
+            : rng(seed),
+              draw(side == Side::LEFT ? 0 : 1ull << 32),
+              action(PaddleAction::STAY),
+              hold(0)
+        {
+            if (driver != SCRIPTED) {
+                controller = createController(GOLDEN_CONTROLLERS[driver]);
+                controller->reset(mixSeed(seed, side == Side::LEFT ? 1 : 2));
+            }
+        }
+
+        PaddleAction decide(const Match& match, Side side) {
+            if (controller)
+                return controller->decide(match, side, MATCH_DT);
+            if (hold == 0) {
+                CounterRng::Block b = rng.block(RngStream::SCRIPT, draw++);
+                action = static_cast<PaddleAction>(b[0] % 3);
+                hold = 1 + b[1] % SCRIPT_MAX_HOLD;
+            }
+            --hold;
+            return action;
+        }
+    };
+
+    // Whether a server-kernel match is exactly where Match is
+    bool sameAsMatch(const SimMatch& sim, unsigned simEvents, const Match& match, unsigned events) {
+        SimState state = captureState(match);
+        return std::memcmp(&sim.state, &state, sizeof state) == 0 && simEvents == events &&
+               sim.tick == static_cast<std::uint32_t>(match.getTick()) &&
+               sim.leftScore == match.getLeftScore() && sim.rightScore == match.getRightScore() &&
+               sim.finished == match.isFinished();
+    }
+
+    template <typename T>
+    bool readValue(std::FILE* file, T& value) {
+        return std::fread(&value, sizeof value, 1, file) == 1;
+    }
+
+    template <typename T>
+    bool writeValue(std::FILE* file, const T& value) {
+        return std::fwrite(&value, sizeof value, 1, file) == 1;
+    }
+
+    /*
+        Golden file: "GLD1", u32 count, GoldenOutcome × count, then the
+        CRC-32 of everything before it.
+    */
+    bool saveGolden(const std::string& path, const std::vector<GoldenOutcome>& outcomes) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+
+        std::uint32_t count = static_cast<std::uint32_t>(outcomes.size());
+        std::size_t bytes = outcomes.size() * sizeof(GoldenOutcome);
+        std::uint32_t crc = crc32(GOLDEN_MAGIC, 4);
+        crc = crc32(&count, sizeof count, crc);
+        crc = crc32(outcomes.data(), bytes, crc);
+
+        bool ok = std::fwrite(GOLDEN_MAGIC, 1, 4, file) == 4 &&
+                  writeValue(file, count) &&
+                  std::fwrite(outcomes.data(), 1, bytes, file) == bytes &&
+                  writeValue(file, crc);
+        return std::fclose(file) == 0 && ok;
+    }
+
+    bool loadGolden(const std::string& path, std::vector<GoldenOutcome>& outcomes) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+
+        char magic[4];
+        std::uint32_t count = 0, stored = 0;
+        bool ok = std::fread(magic, 1, 4, file) == 4 &&
+                  std::memcmp(magic, GOLDEN_MAGIC, 4) == 0 &&
+                  readValue(file, count) && count <= 16 * GOLDEN_MATCHES;
+        if (ok) {
+            outcomes.resize(count);
+            ok = std::fread(outcomes.data(), sizeof(GoldenOutcome), count, file) == count &&
+                 readValue(file, stored);
+        }
+        std::fclose(file);
+        if (!ok)
+            return false;
+
+        std::uint32_t crc = crc32(GOLDEN_MAGIC, 4);
+        crc = crc32(&count, sizeof count, crc);
+        crc = crc32(outcomes.data(), outcomes.size() * sizeof(GoldenOutcome), crc);
+        return crc == stored;
+    }
+
+    /*
+        Play corpus matches [0, outcomes.size()) on 'threads' threads;
+        divergences[i] receives match i's server-kernel divergence tick.
+    */
+    void playCorpus(std::vector<GoldenOutcome>& outcomes, std::vector<long>& divergences, unsigned threads) {
+        std::atomic<std::size_t> next(0);
+
+        auto worker = [&]() {
+            for (std::size_t start = next.fetch_add(CHUNK); start < outcomes.size();
+                 start = next.fetch_add(CHUNK)) {
+                std::size_t end = std::min(start + CHUNK, outcomes.size());
+                for (std::size_t i = start; i < end; ++i)
+                    outcomes[i] = playGoldenMatch(i, false, &divergences[i]);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    void printOutcome(const char* label, const GoldenOutcome& o) {
+        std::printf("    %-8s digest %08x  ticks %u  hits %u  score %u:%u  lives %u\n",
+                    label, o.digest, o.ticks, o.hits, o.leftScore, o.rightScore, o.lives);
+    }
+
+    bool sameOutcome(const GoldenOutcome& a, const GoldenOutcome& b) {
+        return std::memcmp(&a, &b, sizeof(GoldenOutcome)) == 0;
+    }
+
+    int usage() {
+        std::cout << "Usage:\n"
+                     "  pong --golden-check  [--matches N] [--threads N] [--file PATH]\n"
+                     "  pong --golden-update [--matches N] [--threads N] [--file PATH]\n"
+                     "  pong --golden-trace INDEX\n";
+        return 1;
+    }
+}
+
+
+/*
+    Function: std::string describeGoldenMatch(std::size_t index)
+
+    Objective:
+        Name the setup of a corpus match for mismatch reports.
+
+    Input Parameters:
+        - std::size_t index: Corpus position.
+
+    Return Value:
+        - std::string: Drivers, arena, rules and seed.
+
+    Side Effects:
+        - None
+*/
+std::string describeGoldenMatch(std::size_t index) {
+    GoldenSetup setup = goldenSetup(index);
+    char line[160];
+    std::snprintf(line, sizeof(line), "%s vs %s, %s arena, %s, seed 0x%016llx",
+                  driverName(setup.left), driverName(setup.right), ARENA_PRESETS[setup.arena]->name,
+                  setup.mode == GameMode::PLAYER_VS_AI ? "AI mode" : "PvP",
+                  static_cast<unsigned long long>(setup.seed));
+    return line;
+}
+
+
+/*
+    Function: GoldenOutcome playGoldenMatch(std::size_t index, bool trace, long* kernelDivergence)
+
+    Objective:
+        Play one corpus match and summarize everything it did.
+
+    Input Parameters:
+        - std::size_t index: Corpus position.
+        - bool trace: Print every tick to stdout.
+        - long* kernelDivergence: Receives the first tick at which the
+          server kernel left Match (-1 if never, or not a PvP match).
+
+    Return Value:
+        - GoldenOutcome: Digest, length, hits, scores and lives.
+
+    Side Effects:
+        - Prints when tracing.
+
+    Approach:
+        - Like Tournament::playMatch: fixed steps, both sides decide
+          from the same pre-step state.
+        - After every step the rally state's bytes are folded into a
+          running CRC-32, so the digest changes if any position or
+          velocity differs at any tick, even when the score does not.
+        - PvP matches also step the server's SimMatch, in its preset
+          specialization and its runtime form, with the same inputs;
+          both must equal Match (state, events, scores) after every
+          step.
+*/
+GoldenOutcome playGoldenMatch(std::size_t index, bool trace, long* kernelDivergence) {
+    GoldenSetup setup = goldenSetup(index);
+    const Arena& arena = *ARENA_PRESETS[setup.arena];
+    Match match(setup.mode, setup.seed, arena);
+    GoldenDriver left(setup.left, setup.seed, Side::LEFT);
+    GoldenDriver right(setup.right, setup.seed, Side::RIGHT);
+
+    bool lockstep = setup.mode == GameMode::PLAYER_VS_PLAYER;
+    SimMatch specialized = SIM_MATCH_STARTS[setup.arena](setup.seed);
+    SimMatch runtime = startSimMatch(setup.seed, arena);
+    long divergence = -1;
+    if (lockstep && !(sameAsMatch(specialized, 0, match, 0) && sameAsMatch(runtime, 0, match, 0)))
+        divergence = 0;
+
+    std::uint32_t digest = 0;
+    unsigned hits = 0;
+    while (!match.isFinished() && match.getTick() < GOLDEN_MAX_TICKS) {
+        MatchInput input;
+        input.left = left.decide(match, Side::LEFT);
+        input.right = right.decide(match, Side::RIGHT);
+
+        unsigned events = match.step(MATCH_DT, input);
+        hits += (events & MatchEvent::LEFT_HIT) != 0;
+        hits += (events & MatchEvent::RIGHT_HIT) != 0;
+
+        if (lockstep && divergence < 0) {
+            unsigned specializedEvents = SIM_MATCH_STEPS[setup.arena](specialized, input, MATCH_DT);
+            unsigned runtimeEvents = stepSimMatch(runtime, input, MATCH_DT, arena);
+            if (!sameAsMatch(specialized, specializedEvents, match, events) ||
+                !sameAsMatch(runtime, runtimeEvents, match, events))
+                divergence = match.getTick();
+        }
+
+        SimState state = captureState(match);
+        digest = crc32(&state, sizeof state, digest);
+
+        if (trace) {
+            std::printf("%5ld %d%d %02x  ball %.9g %.9g  v %.9g %.9g  paddles %.9g %.9g  %d:%d  %08x\n",
+                        match.getTick(), static_cast<int>(input.left), static_cast<int>(input.right),
+                        events, state.ballX, state.ballY, state.ballVX, state.ballVY,
+                        state.leftY, state.rightY, match.getLeftScore(), match.getRightScore(), digest);
+        }
+    }
+
+    if (kernelDivergence)
+        *kernelDivergence = divergence;
+    if (trace && divergence >= 0)
+        std::printf("server kernel (SimMatch) differs from Match from tick %ld\n", divergence);
+
+    GoldenOutcome outcome;
+    outcome.digest = digest;
+    outcome.ticks = static_cast<std::uint16_t>(match.getTick());
+    outcome.hits = static_cast<std::uint16_t>(hits);
+    outcome.leftScore = static_cast<std::uint8_t>(match.getLeftScore());
+    outcome.rightScore = static_cast<std::uint8_t>(match.getRightScore());
+    outcome.lives = static_cast<std::uint8_t>(match.getLives());
+    outcome.reserved = 0;
+    return outcome;
+}
+
+
+/*
+    Function: int runGoldenCommand(int argc, char** argv)
+
+    Objective:
+        Check (or regenerate) the gameplay golden file.
+
+    Input Parameters:
+        - int argc, char** argv: Process arguments (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code (1 on any mismatch or error).
+
+    Side Effects:
+        - Prints the result; --golden-update writes the golden file.
+
+    Approach:
+        - "--option value" pairs; refuse to run without the policy
+          weights (neural matches would silently play as chase).
+        - Play the corpus on all cores, then compare record by record.
+*/
+int runGoldenCommand(int argc, char** argv) {
+    std::string command = argv[1];
+
+    if (command == "--golden-trace") {
+        if (argc != 3)
+            return usage();
+        std::size_t index = std::strtoul(argv[2], nullptr, 10);
+        std::printf("Match %zu: %s\n", index, describeGoldenMatch(index).c_str());
+        std::printf(" tick LR ev  ball x y  v x y  paddles left right  score  digest\n");
+        GoldenOutcome outcome = playGoldenMatch(index, true);
+        printOutcome("result", outcome);
+        return 0;
+    }
+
+    std::size_t matches = GOLDEN_MATCHES;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string path = GOLDEN_PATH;
+
+    bool valid = (argc - 2) % 2 == 0;
+    for (int i = 2; valid && i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--matches") matches = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--threads") threads = static_cast<unsigned>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (arg == "--file") path = argv[i + 1];
+        else valid = false;
+    }
+    if (!valid || matches < 1 || threads < 1)
+        return usage();
+
+    if (!sharedPolicyModel()) {
+        std::printf("No policy weights at %s (run from the project directory)\n", POLICY_WEIGHTS_PATH);
+        return 1;
+    }
+
+    std::vector<GoldenOutcome> golden;
+    bool update = command == "--golden-update";
+    if (!update) {
+        if (!loadGolden(path, golden)) {
+            std::printf("Cannot read golden file %s (missing or corrupt)\n", path.c_str());
+            return 1;
+        }
+        if (matches > golden.size()) {
+            std::printf("%s holds %zu matches, %zu requested\n", path.c_str(), golden.size(), matches);
+            return 1;
+        }
+    }
+
+    std::vector<GoldenOutcome> outcomes(matches);
+    std::vector<long> divergences(matches);
+    auto start = std::chrono::steady_clock::now();
+    playCorpus(outcomes, divergences, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned long long ticks = 0, hits = 0;
+    for (const GoldenOutcome& o : outcomes) {
+        ticks += o.ticks;
+        hits += o.hits;
+    }
+    std::printf("Played %zu matches (%.1f M steps, %llu paddle hits) in %.2f s on %u threads "
+                "= %.0f matches/s\n",
+                matches, ticks / 1e6, hits, seconds, threads, matches / std::max(seconds, 1e-9));
+
+    // The server kernel is checked against Match itself, not the file
+    std::size_t lockstep[ARENA_PRESET_COUNT] = {};
+    std::size_t diverged = 0;
+    for (std::size_t i = 0; i < matches; ++i) {
+        GoldenSetup setup = goldenSetup(i);
+        if (setup.mode != GameMode::PLAYER_VS_PLAYER)
+            continue;
+        ++lockstep[setup.arena];
+        if (divergences[i] >= 0 && diverged++ < MAX_LISTED)
+            std::printf("  match %zu: %s\n    server kernel differs from Match from tick %ld\n",
+                        i, describeGoldenMatch(i).c_str(), divergences[i]);
+    }
+    std::printf("Server kernel in lockstep with Match:");
+    for (std::size_t a = 0; a < ARENA_PRESET_COUNT; ++a)
+        std::printf(" %s %zu", ARENA_PRESETS[a]->name, lockstep[a]);
+    std::printf(" PvP matches\n");
+    if (diverged) {
+        std::printf("FAIL: the server kernel (SimMatch) differs from Match in %zu matches\n", diverged);
+        return 1;
+    }
+
+    if (update) {
+        if (!saveGolden(path, outcomes)) {
+            std::printf("Cannot write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("Wrote %s\n", path.c_str());
+        return 0;
+    }
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < matches; ++i) {
+        if (sameOutcome(outcomes[i], golden[i]))
+            continue;
+        if (mismatches++ < MAX_LISTED) {
+            std::printf("  match %zu: %s\n", i, describeGoldenMatch(i).c_str());
+            printOutcome("golden", golden[i]);
+            printOutcome("now", outcomes[i]);
+        }
+    }
+
+    if (mismatches) {
+        std::printf("FAIL: %zu of %zu matches differ from %s\n"
+                    "Trace one with: pong --golden-trace INDEX (diff against a good build)\n",
+                    mismatches, matches, path.c_str());
+        return 1;
+    }
+    std::printf("OK: all %zu matches identical to %s\n", matches, path.c_str());
+    return 0;
+}
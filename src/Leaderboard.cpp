@@ -0,0 +1,474 @@
+#include "Leaderboard.h"
+#include "Checksum.h"
+#include "Metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define fsync _commit
+    #define ftruncate _chsize
+#else
+    #include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+    #define O_BINARY 0
+#endif
+
+namespace {
+    // "PLB1" – identifies a leaderboard journal record
+    const std::uint32_t RECORD_MAGIC = 0x31424C50u;
+
+    const std::size_t NAME_CAPACITY = 40;
+
+    // Queued records are given this long to accumulate before one fsync
+    const std::chrono::milliseconds BATCH_WINDOW(50);
+
+    // Compact once the journal holds this many times the live entries
+    const std::size_t COMPACT_FACTOR = 4;
+
+    ///////////////////////////////////////////////////////////
+    /// Struct: JournalRecord
+    /// ------------------------------------------------------
+    /// Fixed 64-byte on-disk record. The CRC covers every
+    /// byte after the crc field.
+    ///////////////////////////////////////////////////////////
+    struct JournalRecord {
+        std::uint32_t magic;
+        std::uint32_t crc;
+        std::int64_t  timestamp;
+        std::int32_t  score;
+        std::uint8_t  mode;
+        std::uint8_t  nameLength;
+        std::uint8_t  reserved[2];
+        char          name[NAME_CAPACITY];
+    };
+
+    static_assert(sizeof(JournalRecord) == 64, "journal record must stay 64 bytes");
+
+    const std::size_t CRC_OFFSET = offsetof(JournalRecord, timestamp);
+
+    /*
+        Encode one entry as a journal record.
+    */
+    JournalRecord encodeRecord(int mode, const LeaderboardEntry& entry) {
+        JournalRecord record;
+        std::memset(&record, 0, sizeof(record));
+
+        std::size_t length = entry.name.size();
+        if (length > NAME_CAPACITY - 1)
+            length = NAME_CAPACITY - 1;
+
+        record.magic      = RECORD_MAGIC;
+        record.timestamp  = entry.timestamp;
+        record.score      = entry.score;
+        record.mode       = static_cast<std::uint8_t>(mode);
+        record.nameLength = static_cast<std::uint8_t>(length);
+        std::memcpy(record.name, entry.name.data(), length);
+
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+        record.crc = crc32(bytes + CRC_OFFSET, sizeof(record) - CRC_OFFSET);
+        return record;
+    }
+
+    /*
+        Validate a record: magic, checksum and field ranges.
+    */
+    bool isValidRecord(const JournalRecord& record, int modeCount) {
+        if (record.magic != RECORD_MAGIC)
+            return false;
+
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+        if (record.crc != crc32(bytes + CRC_OFFSET, sizeof(record) - CRC_OFFSET))
+            return false;
+
+        return record.mode < modeCount && record.nameLength < NAME_CAPACITY;
+    }
+
+    /*
+        Insert an entry into a best-first table capped at topN.
+        Returns the 1-based rank, or 0 if the entry did not fit.
+        Equal scores keep their original (earlier) order.
+    */
+    int insertEntry(std::vector<LeaderboardEntry>& table,
+                    const LeaderboardEntry& entry, std::size_t topN) {
+        std::size_t position = 0;
+        while (position < table.size() && table[position].score >= entry.score)
+            ++position;
+
+        if (position >= topN)
+            return 0;
+
+        table.insert(table.begin() + position, entry);
+        if (table.size() > topN)
+            table.pop_back();
+
+        return static_cast<int>(position) + 1;
+    }
+
+    /*
+        Write a whole buffer, retrying on short writes.
+    */
+    bool writeAll(int fd, const unsigned char* data, std::size_t size) {
+        while (size > 0) {
+            auto written = ::write(fd, data, static_cast<unsigned>(size));
+            if (written <= 0)
+                return false;
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+}
+
+
+/*
+    Constructor: Leaderboard::Leaderboard(const std::string& path, std::size_t topN)
+
+    Objective:
+        Load the journal and start the background writer.
+
+    Input Parameters:
+        - const std::string& path: Journal file path.
+        - std::size_t topN: Entries kept per mode.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Reads and may truncate the journal file.
+        - Starts the writer thread.
+
+    Approach:
+        - load() fills both the game-thread and writer-thread tables.
+        - Open the journal for appending; on failure keep running in
+          memory only (results are then lost on exit).
+*/
+Leaderboard::Leaderboard(const std::string& path, std::size_t topN)
+    : path(path),
+      topN(topN),
+      stopping(false),
+      fd(-1),
+      journalRecords(0)
+{
+    load();
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_BINARY, 0644);
+    if (fd < 0) {
+        std::cout << "Failed to open leaderboard journal " << path << "\n";
+    }
+
+    pending.reserve(16 * sizeof(JournalRecord));
+    writer = std::thread(&Leaderboard::writerLoop, this);
+}
+
+
+/*
+    Destructor: Leaderboard::~Leaderboard()
+
+    Objective:
+        Flush queued records and join the writer thread.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - None
+
+    Side Effects:
+        - Blocks until pending records reach the disk.
+        - Closes the journal.
+
+    Approach:
+        - Set the stop flag, wake the writer, join it.
+*/
+Leaderboard::~Leaderboard() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+
+    if (fd >= 0)
+        ::close(fd);
+}
+
+
+/*
+    Function: int Leaderboard::submit(GameMode mode, int score, const std::string& name)
+
+    Objective:
+        Record a finished game without blocking on I/O.
+
+    Input Parameters:
+        - GameMode mode: Mode of the finished game.
+        - int score: Score to rank by.
+        - const std::string& name: Player name.
+
+    Return Value:
+        - int: 1-based rank in the top-N table, 0 if outside it.
+
+    Side Effects:
+        - Updates the in-memory table.
+        - Queues a record for the writer thread.
+
+    Approach:
+        - Encode the record on the game thread (no allocation beyond the
+          reserved queue), append under a short lock, notify the writer.
+*/
+int Leaderboard::submit(GameMode mode, int score, const std::string& name) {
+    int modeIndex = static_cast<int>(mode);
+
+    LeaderboardEntry entry;
+    entry.name = name.substr(0, NAME_CAPACITY - 1);
+    entry.score = score;
+    entry.timestamp = static_cast<std::int64_t>(std::time(nullptr));
+
+    int rank = insertEntry(tables[modeIndex], entry, topN);
+
+    JournalRecord record = encodeRecord(modeIndex, entry);
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.insert(pending.end(), bytes, bytes + sizeof(record));
+    }
+    wakeUp.notify_one();
+
+    return rank;
+}
+
+
+/*
+    Function: const std::vector<LeaderboardEntry>& Leaderboard::getEntries(GameMode mode) const
+
+    Objective:
+        Access the top-N table of a mode (best first).
+*/
+const std::vector<LeaderboardEntry>& Leaderboard::getEntries(GameMode mode) const {
+    return tables[static_cast<int>(mode)];
+}
+
+
+/*
+    Function: int Leaderboard::getBest(GameMode mode) const
+
+    Objective:
+        Best score recorded for a mode, or 0 when the table is empty.
+*/
+int Leaderboard::getBest(GameMode mode) const {
+    const std::vector<LeaderboardEntry>& table = tables[static_cast<int>(mode)];
+    return table.empty() ? 0 : table.front().score;
+}
+
+
+/*
+    Function: void Leaderboard::load()
+
+    Objective:
+        Rebuild the tables from the journal file.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Truncates the file after the last valid record.
+
+    Approach:
+        - Read the whole file with a single fread().
+        - Walk it in 64-byte steps; records are used in place (no parsing).
+        - Stop at the first invalid record: everything after it was torn
+          by a crash mid-append and is cut off so new appends stay aligned.
+*/
+void Leaderboard::load() {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return;
+
+    std::vector<unsigned char> data;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        long size = std::ftell(file);
+        if (size > 0) {
+            data.resize(static_cast<std::size_t>(size));
+            std::rewind(file);
+            data.resize(std::fread(data.data(), 1, data.size(), file));
+        }
+    }
+    std::fclose(file);
+
+    std::size_t validBytes = 0;
+    while (validBytes + sizeof(JournalRecord) <= data.size()) {
+        JournalRecord record;
+        std::memcpy(&record, data.data() + validBytes, sizeof(record));
+
+        if (!isValidRecord(record, MODE_COUNT))
+            break;
+
+        LeaderboardEntry entry;
+        entry.name.assign(record.name, record.nameLength);
+        entry.score = record.score;
+        entry.timestamp = record.timestamp;
+
+        insertEntry(tables[record.mode], entry, topN);
+        validBytes += sizeof(record);
+        journalRecords++;
+    }
+
+    if (validBytes < data.size()) {
+        std::cout << "Leaderboard: discarding " << (data.size() - validBytes)
+                  << " bytes of torn journal data\n";
+
+        int truncFd = ::open(path.c_str(), O_WRONLY | O_BINARY);
+        if (truncFd >= 0) {
+            if (ftruncate(truncFd, static_cast<long>(validBytes)) != 0)
+                std::cout << "Leaderboard: failed to truncate journal\n";
+            ::close(truncFd);
+        }
+    }
+
+    for (int mode = 0; mode < MODE_COUNT; ++mode)
+        writerTables[mode] = tables[mode];
+}
+
+
+/*
+    Function: void Leaderboard::writerLoop()
+
+    Objective:
+        Persist queued records in the background.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Appends to and fsyncs the journal; may compact it.
+        - Counts the records made durable (pong_high_score_writes_total).
+
+    Approach:
+        - Sleep until records arrive (or shutdown).
+        - Give further records a short window to join the batch.
+        - Swap the queue out under the lock, then write and fsync once.
+        - Compact when the journal exceeds COMPACT_FACTOR x live entries.
+*/
+void Leaderboard::writerLoop() {
+    std::vector<unsigned char> batch;
+    batch.reserve(16 * sizeof(JournalRecord));
+
+    while (true) {
+        bool exitAfterBatch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+
+            if (!stopping)
+                wakeUp.wait_for(lock, BATCH_WINDOW, [this] { return stopping; });
+
+            batch.swap(pending);
+            exitAfterBatch = stopping;
+        }
+
+        if (!batch.empty()) {
+            if (fd >= 0) {
+                if (!writeAll(fd, batch.data(), batch.size()) || fsync(fd) != 0)
+                    std::cout << "Leaderboard: failed to write journal\n";
+                else
+                    countMetric(MetricCounter::HIGH_SCORE_WRITES, batch.size() / sizeof(JournalRecord));
+            }
+
+            for (std::size_t offset = 0; offset < batch.size(); offset += sizeof(JournalRecord)) {
+                JournalRecord record;
+                std::memcpy(&record, batch.data() + offset, sizeof(record));
+
+                LeaderboardEntry entry;
+                entry.name.assign(record.name, record.nameLength);
+                entry.score = record.score;
+                entry.timestamp = record.timestamp;
+                insertEntry(writerTables[record.mode], entry, topN);
+            }
+
+            journalRecords += batch.size() / sizeof(JournalRecord);
+            batch.clear();
+
+            if (journalRecords > COMPACT_FACTOR * topN * MODE_COUNT)
+                compact();
+        }
+
+        if (exitAfterBatch)
+            return;
+    }
+}
+
+
+/*
+    Function: void Leaderboard::compact()
+
+    Objective:
+        Shrink the journal to the live top-N entries.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Replaces the journal file and reopens it for appending.
+
+    Approach:
+        - Write all live entries to "<path>.tmp", fsync it.
+        - rename() it over the journal (atomic on POSIX), so a crash leaves
+          either the old or the new journal, never a mix.
+*/
+void Leaderboard::compact() {
+    std::string tempPath = path + ".tmp";
+
+    int tempFd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (tempFd < 0)
+        return;
+
+    std::vector<unsigned char> data;
+    std::size_t records = 0;
+    for (int mode = 0; mode < MODE_COUNT; ++mode) {
+        for (const LeaderboardEntry& entry : writerTables[mode]) {
+            JournalRecord record = encodeRecord(mode, entry);
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+            data.insert(data.end(), bytes, bytes + sizeof(record));
+            records++;
+        }
+    }
+
+    bool ok = writeAll(tempFd, data.data(), data.size()) && fsync(tempFd) == 0;
+    ::close(tempFd);
+
+#ifdef _WIN32
+    if (ok) {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+        std::remove(path.c_str());
+    }
+#endif
+
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        std::cout << "Leaderboard: journal compaction failed\n";
+        return;
+    }
+
+    if (fd >= 0)
+        ::close(fd);
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_BINARY);
+    journalRecords = records;
+}
@@ -0,0 +1,313 @@
+#include "Match.h"
+#include "CounterRng.h"
+#include "SimState.h"
+#include <cmath>
+
+namespace {
+    const float DEG_TO_RAD = 3.14159265f / 180.f;
+
+    // Rows of the match's entities
+    const std::size_t BALL         = 0;
+    const std::size_t LEFT_PADDLE  = 0;
+    const std::size_t RIGHT_PADDLE = 1;
+}
+
+/*
+    Constructor: Match::Match(GameMode mode, std::uint64_t seed, const Arena& arena)
+
+    Objective:
+        Create a fresh match and serve the first ball.
+
+    Input Parameters:
+        - GameMode mode: Rules to play by.
+        - std::uint64_t seed: Match seed (serves and AI controllers).
+        - const Arena& arena: Geometry and rules.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - None outside the object.
+
+    Approach:
+        - Place paddles and ball at their start positions, zero scores,
+          then resetRound() to serve point 0 (towards the right).
+        - Pick the arena's specialized rally kernel once (nullptr for a
+          custom arena: step() then uses the runtime form).
+*/
+Match::Match(GameMode mode, std::uint64_t seed, const Arena& arena)
+    : mode(mode),
+      seed(seed),
+      arena(arena),
+      rallyStep(presetSimStep(arena)),
+      leftScore(0),
+      rightScore(0),
+      lives(arena.startLives),
+      finished(false),
+      tick(0),
+      point(0)
+{
+    entities.addBox(BoxKind::PADDLE, arena.leftPaddleX(), arena.paddleStartY(),
+                    arena.paddleWidth, arena.paddleHeight);
+    entities.addBox(BoxKind::PADDLE, arena.rightPaddleX(), arena.paddleStartY(),
+                    arena.paddleWidth, arena.paddleHeight);
+    entities.addBall(arena.serveX(), arena.serveY(), arena.ballSize, 0.f, 0.f);
+
+    resetRound();
+}
+
+
+/*
+    Function: unsigned Match::step(float dt, const MatchInput& input)
+
+    Objective:
+        Advance the match by one time step.
+
+    Input Parameters:
+        - float dt: Time step in seconds.
+        - const MatchInput& input: Action of each paddle.
+
+    Return Value:
+        - unsigned: MatchEvent flags raised during this step.
+
+    Side Effects:
+        - Moves paddles and ball.
+        - Updates scores, lives and the finished flag.
+
+    Approach:
+        - The rally step is stepSimState() on the captured SimState
+          (paddles, ball + wall bounce, paddle bounces, scoring test), the
+          same kernel SimMatch, search and the server run; the result is
+          written back to the entity tables.
+        - A scored point updates the score (or lives) and re-serves.
+        - Check the game-over condition for the current mode.
+*/
+unsigned Match::step(float dt, const MatchInput& input) {
+    if (finished)
+        return 0;
+
+    tick++;
+
+    // ---------- Rally (captureState() straight from the rows) ----------
+    sf::FloatRect ball = entities.getBallBounds(BALL);
+    sf::Vector2f velocity = entities.getBallVelocity(BALL);
+    SimState rally = { ball.left, ball.top, velocity.x, velocity.y,
+                       entities.getBoxBounds(LEFT_PADDLE).top, entities.getBoxBounds(RIGHT_PADDLE).top };
+    unsigned events = rallyStep ? rallyStep(rally, input, dt)
+                                : stepSimState(rally, input, dt, arena);
+    placeRally(rally);
+
+    // ---------- Scoring ----------
+    if (events & MatchEvent::RIGHT_SCORED) {
+        if (mode == GameMode::PLAYER_VS_AI)
+            lives--;
+        else
+            rightScore++;
+        resetRound();
+    }
+    else if (events & MatchEvent::LEFT_SCORED) {
+        leftScore++;
+        resetRound();
+    }
+
+    // ---------- Game Over ----------
+    if (mode == GameMode::PLAYER_VS_AI)
+        finished = lives <= 0;
+    else
+        finished = leftScore >= arena.targetScore || rightScore >= arena.targetScore;
+
+    if (finished)
+        events |= MatchEvent::GAME_OVER;
+
+    return events;
+}
+
+
+/*
+    Function: void Match::restore(const SimState& rally, const MatchProgress& progress)
+
+    Objective:
+        Continue a saved match (session resume).
+
+    Input Parameters:
+        - const SimState& rally: Ball and paddle state.
+        - const MatchProgress& progress: Scores, lives and counters.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Moves the paddles and ball; replaces scores and counters.
+
+    Approach:
+        - Positions are top-left corners, as captureState() reads them,
+          so the floats round-trip exactly.
+        - The finished flag is re-derived from the restored scores/lives.
+*/
+void Match::restore(const SimState& rally, const MatchProgress& progress) {
+    placeRally(rally);
+
+    leftScore = progress.leftScore;
+    rightScore = progress.rightScore;
+    lives = progress.lives;
+    tick = progress.tick;
+    point = progress.point;
+
+    if (mode == GameMode::PLAYER_VS_AI)
+        finished = lives <= 0;
+    else
+        finished = leftScore >= arena.targetScore || rightScore >= arena.targetScore;
+}
+
+
+/*
+    Read-only accessors
+
+    Objective:
+        Expose match state to the renderer, AI controllers and tools.
+*/
+GameMode Match::getMode() const {
+    return mode;
+}
+
+std::uint64_t Match::getSeed() const {
+    return seed;
+}
+
+const Arena& Match::getArena() const {
+    return arena;
+}
+
+const EntityStore& Match::getEntities() const {
+    return entities;
+}
+
+sf::FloatRect Match::getPaddleBounds(Side side) const {
+    return entities.getBoxBounds(side == Side::LEFT ? LEFT_PADDLE : RIGHT_PADDLE);
+}
+
+sf::FloatRect Match::getBallBounds() const {
+    return entities.getBallBounds(BALL);
+}
+
+sf::Vector2f Match::getBallVelocity() const {
+    return entities.getBallVelocity(BALL);
+}
+
+int Match::getLeftScore() const {
+    return leftScore;
+}
+
+int Match::getRightScore() const {
+    return rightScore;
+}
+
+int Match::getLives() const {
+    return lives;
+}
+
+bool Match::isFinished() const {
+    return finished;
+}
+
+long Match::getTick() const {
+    return tick;
+}
+
+MatchProgress Match::getProgress() const {
+    MatchProgress progress;
+    progress.leftScore = leftScore;
+    progress.rightScore = rightScore;
+    progress.lives = lives;
+    progress.tick = tick;
+    progress.point = point;
+    return progress;
+}
+
+
+/*
+    Function: sf::Vector2f serveVelocity(std::uint64_t seed, std::uint64_t point, const Arena& arena)
+
+    Objective:
+        Velocity of one serve of a match.
+
+    Input Parameters:
+        - std::uint64_t seed: Match seed.
+        - std::uint64_t point: Serve number (0 = first serve).
+        - const Arena& arena: Serve speed and angle ranges.
+
+    Return Value:
+        - sf::Vector2f: Ball velocity in pixels/second.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Draw the serve from the counter-based RNG at (seed, SERVE, point):
+          speed, angle and up/down come from three independent words, so
+          a serve depends only on the match seed and the point number.
+        - Horizontal direction alternates, first serve to the right.
+*/
+sf::Vector2f serveVelocity(std::uint64_t seed, std::uint64_t point, const Arena& arena) {
+    CounterRng::Block r = CounterRng(seed).block(RngStream::SERVE, point);
+
+    float speed = arena.serveMinSpeed + arena.serveSpeedRange * CounterRng::uniform(r[0]);
+    float angle = (arena.serveMinAngle + arena.serveAngleRange * CounterRng::uniform(r[1])) * DEG_TO_RAD;
+    float directionX = point % 2 == 0 ? 1.f : -1.f;
+    float directionY = (r[2] & 1u) ? 1.f : -1.f;
+
+    return sf::Vector2f(directionX * speed * std::cos(angle),
+                        directionY * speed * std::sin(angle));
+}
+
+
+/*
+    Function: void Match::resetRound()
+
+    Objective:
+        Serve the next point from the center of the arena.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Resets ball position and velocity.
+        - Advances the point counter.
+
+    Approach:
+        - serveVelocity() of the current point, from the center.
+*/
+void Match::resetRound() {
+    sf::Vector2f velocity = serveVelocity(seed, point, arena);
+    entities.placeBall(BALL, arena.serveX(), arena.serveY(), velocity.x, velocity.y);
+    point++;
+}
+
+
+/*
+    Function: void Match::placeRally(const SimState& rally)
+
+    Objective:
+        Move the paddles and ball to a rally state.
+
+    Input Parameters:
+        - const SimState& rally: Ball box corner and velocity, paddle tops.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Overwrites the ball row and the paddle rows.
+
+    Approach:
+        - Paddles keep their arena X; the floats are stored as given, so
+          captureState() reads back exactly what was placed.
+*/
+void Match::placeRally(const SimState& rally) {
+    entities.placeBox(LEFT_PADDLE, arena.leftPaddleX(), rally.leftY);
+    entities.placeBox(RIGHT_PADDLE, arena.rightPaddleX(), rally.rightY);
+    entities.placeBall(BALL, rally.ballX, rally.ballY, rally.ballVX, rally.ballVY);
+}
@@ -0,0 +1,377 @@
+#include "MatchHistory.h"
+#include <cstring>
+
+namespace {
+    const std::size_t WORDS = MatchHistory::WORDS;
+
+    // Keyframe: the words as they are
+    const std::size_t KEYFRAME_BYTES = WORDS * sizeof(std::uint32_t);
+
+    // Delta: 3-byte mask, 2-bit lengths, then up to 4 bytes per word
+    const std::size_t MASK_BYTES = 3;
+    const std::size_t MAX_DELTA_BYTES = MASK_BYTES + (WORDS + 3) / 4 + KEYFRAME_BYTES;
+
+    const std::size_t MAX_BLOCK_BYTES =
+        KEYFRAME_BYTES + (MatchHistory::KEYFRAME_INTERVAL - 1) * MAX_DELTA_BYTES;
+
+    static_assert(WORDS <= 8 * MASK_BYTES, "delta mask too small");
+    static_assert(MAX_BLOCK_BYTES * 2 <= MatchHistory::BUFFER_BYTES, "history buffer too small");
+
+    std::uint32_t floatBits(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsFloat(std::uint32_t bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /*
+        Frame → words. The fields that change every update (ball,
+        paddles, tick, dt) come first; 64-bit values are split low/high
+        so a tick increment only changes the low word.
+    */
+    void pack(const HistoryFrame& frame, std::uint32_t* words) {
+        words[0]  = floatBits(frame.rally.ballX);
+        words[1]  = floatBits(frame.rally.ballY);
+        words[2]  = floatBits(frame.rally.ballVX);
+        words[3]  = floatBits(frame.rally.ballVY);
+        words[4]  = floatBits(frame.rally.leftY);
+        words[5]  = floatBits(frame.rally.rightY);
+        words[6]  = static_cast<std::uint32_t>(frame.progress.tick);
+        words[7]  = static_cast<std::uint32_t>(static_cast<std::uint64_t>(frame.progress.tick) >> 32);
+        words[8]  = floatBits(frame.dt);
+        words[9]  = static_cast<std::uint32_t>(frame.progress.leftScore);
+        words[10] = static_cast<std::uint32_t>(frame.progress.rightScore);
+        words[11] = static_cast<std::uint32_t>(frame.progress.lives);
+        words[12] = static_cast<std::uint32_t>(frame.progress.point);
+        words[13] = static_cast<std::uint32_t>(frame.progress.point >> 32);
+        words[14] = static_cast<std::uint32_t>(frame.seed);
+        words[15] = static_cast<std::uint32_t>(frame.seed >> 32);
+        words[16] = static_cast<std::uint32_t>(frame.mode) |
+                    static_cast<std::uint32_t>(frame.state) << 8;
+    }
+
+    void unpack(const std::uint32_t* words, HistoryFrame& frame) {
+        frame.rally.ballX = bitsFloat(words[0]);
+        frame.rally.ballY = bitsFloat(words[1]);
+        frame.rally.ballVX = bitsFloat(words[2]);
+        frame.rally.ballVY = bitsFloat(words[3]);
+        frame.rally.leftY = bitsFloat(words[4]);
+        frame.rally.rightY = bitsFloat(words[5]);
+        frame.progress.tick = static_cast<long>(words[6] | std::uint64_t(words[7]) << 32);
+        frame.dt = bitsFloat(words[8]);
+        frame.progress.leftScore = static_cast<std::int32_t>(words[9]);
+        frame.progress.rightScore = static_cast<std::int32_t>(words[10]);
+        frame.progress.lives = static_cast<std::int32_t>(words[11]);
+        frame.progress.point = words[12] | std::uint64_t(words[13]) << 32;
+        frame.seed = words[14] | std::uint64_t(words[15]) << 32;
+        frame.mode = static_cast<GameMode>(words[16] & 0xFF);
+        frame.state = static_cast<GameState>(words[16] >> 8);
+    }
+
+    /*
+        Encode 'current' as its XOR with 'previous': mask of changed
+        words, 2-bit byte counts (1-4) of the changed words, then each
+        XOR's low bytes (its high zero bytes are implied).
+    */
+    std::size_t encodeDelta(const std::uint32_t* previous, const std::uint32_t* current,
+                            unsigned char* out) {
+        std::uint32_t mask = 0;
+        std::size_t changed = 0;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            if (previous[w] != current[w]) {
+                mask |= 1u << w;
+                ++changed;
+            }
+        }
+
+        out[0] = static_cast<unsigned char>(mask);
+        out[1] = static_cast<unsigned char>(mask >> 8);
+        out[2] = static_cast<unsigned char>(mask >> 16);
+
+        unsigned char* lengths = out + MASK_BYTES;
+        std::size_t lengthBytes = (changed + 3) / 4;
+        std::memset(lengths, 0, lengthBytes);
+
+        unsigned char* payload = lengths + lengthBytes;
+        std::size_t k = 0;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            std::uint32_t diff = previous[w] ^ current[w];
+            if (!diff)
+                continue;
+
+            std::size_t length = diff >> 24 ? 4 : diff >> 16 ? 3 : diff >> 8 ? 2 : 1;
+            lengths[k / 4] |= static_cast<unsigned char>((length - 1) << (2 * (k % 4)));
+            for (std::size_t b = 0; b < length; ++b)
+                *payload++ = static_cast<unsigned char>(diff >> (8 * b));
+            ++k;
+        }
+        return static_cast<std::size_t>(payload - out);
+    }
+
+    // Apply an encoded delta to 'words'; returns the bytes it used
+    std::size_t applyDelta(const unsigned char* in, std::uint32_t* words) {
+        std::uint32_t mask = in[0] | std::uint32_t(in[1]) << 8 | std::uint32_t(in[2]) << 16;
+
+        std::size_t changed = 0;
+        for (std::uint32_t bits = mask; bits; bits &= bits - 1)
+            ++changed;
+
+        const unsigned char* lengths = in + MASK_BYTES;
+        const unsigned char* payload = lengths + (changed + 3) / 4;
+        std::size_t k = 0;
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            if (!(mask & (1u << w)))
+                continue;
+
+            std::size_t length = ((lengths[k / 4] >> (2 * (k % 4))) & 3u) + 1;
+            std::uint32_t diff = 0;
+            for (std::size_t b = 0; b < length; ++b)
+                diff |= std::uint32_t(*payload++) << (8 * b);
+            words[w] ^= diff;
+            ++k;
+        }
+        return static_cast<std::size_t>(payload - in);
+    }
+}
+
+
+/*
+    Constructor: MatchHistory::MatchHistory()
+
+    Objective:
+        Allocate the ring; no frames yet.
+*/
+MatchHistory::MatchHistory()
+    : bytes(BUFFER_BYTES),
+      firstBlock(0),
+      blockCount(0)
+{
+    std::memset(previous, 0, sizeof(previous));
+}
+
+
+/*
+    Function: void MatchHistory::record(const HistoryFrame& frame)
+
+    Objective:
+        Append one frame.
+
+    Input Parameters:
+        - const HistoryFrame& frame: State after the latest update.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Writes into the ring; may evict the oldest blocks.
+
+    Approach:
+        - A full (or missing) newest block → start a block and store the
+          frame as its keyframe; otherwise append its delta against the
+          previous frame.
+*/
+void MatchHistory::record(const HistoryFrame& frame) {
+    std::uint32_t words[WORDS];
+    pack(frame, words);
+
+    if (blockCount == 0 || blocks[(firstBlock + blockCount - 1) % MAX_BLOCKS].frames == KEYFRAME_INTERVAL)
+        startBlock();
+
+    Block& block = blocks[(firstBlock + blockCount - 1) % MAX_BLOCKS];
+    unsigned char* out = &bytes[block.offset + block.size];
+
+    if (block.frames == 0) {
+        std::memcpy(out, words, KEYFRAME_BYTES);
+        block.size += KEYFRAME_BYTES;
+    }
+    else {
+        block.size += encodeDelta(previous, words, out);
+    }
+
+    ++block.frames;
+    std::memcpy(previous, words, sizeof(previous));
+}
+
+
+/*
+    Function: void MatchHistory::startBlock()
+
+    Objective:
+        Open a new, empty newest block.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Evicts the oldest blocks.
+
+    Approach:
+        - The block goes right after the newest one, or at offset 0 when
+          a worst-case block would not fit before the end of the ring.
+        - Evict oldest-first until no kept block overlaps the new block's
+          worst-case range and at most HISTORY_BLOCKS remain besides it.
+          Blocks that overlap are always among the oldest, so age order
+          evicts nothing newer than necessary.
+*/
+void MatchHistory::startBlock() {
+    std::size_t offset = 0;
+    if (blockCount > 0) {
+        const Block& newest = blocks[(firstBlock + blockCount - 1) % MAX_BLOCKS];
+        offset = newest.offset + newest.size;
+        if (offset + MAX_BLOCK_BYTES > BUFFER_BYTES)
+            offset = 0;
+    }
+
+    const std::size_t end = offset + MAX_BLOCK_BYTES;
+    for (;;) {
+        bool overlapping = false;
+        for (std::size_t i = 0; i < blockCount && !overlapping; ++i) {
+            const Block& kept = blocks[(firstBlock + i) % MAX_BLOCKS];
+            overlapping = kept.offset < end && offset < kept.offset + kept.size;
+        }
+
+        if (blockCount == 0 || (!overlapping && blockCount < MAX_BLOCKS))
+            break;
+
+        firstBlock = (firstBlock + 1) % MAX_BLOCKS;
+        --blockCount;
+    }
+
+    Block& block = blocks[(firstBlock + blockCount) % MAX_BLOCKS];
+    block.offset = offset;
+    block.size = 0;
+    block.frames = 0;
+    ++blockCount;
+}
+
+
+/*
+    Function: bool MatchHistory::getFrame(std::size_t index, HistoryFrame& frame) const
+
+    Objective:
+        Decode one recorded frame.
+
+    Input Parameters:
+        - std::size_t index: 0 = oldest.
+        - HistoryFrame& frame: Result.
+
+    Return Value:
+        - bool: false if there is no such frame.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Every block but the newest is full, so the block is
+          index / KEYFRAME_INTERVAL; decode up to the frame within it.
+*/
+bool MatchHistory::getFrame(std::size_t index, HistoryFrame& frame) const {
+    if (index >= getFrameCount())
+        return false;
+
+    std::uint32_t words[WORDS];
+    decode(blocks[(firstBlock + index / KEYFRAME_INTERVAL) % MAX_BLOCKS],
+           index % KEYFRAME_INTERVAL, words);
+    unpack(words, frame);
+    return true;
+}
+
+
+/*
+    Function: void MatchHistory::truncate(std::size_t count)
+
+    Objective:
+        Drop every frame after the first 'count'.
+
+    Input Parameters:
+        - std::size_t count: Frames to keep.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Shortens the newest kept block; the next record() continues
+          from the last kept frame.
+*/
+void MatchHistory::truncate(std::size_t count) {
+    if (count >= getFrameCount())
+        return;
+    if (count == 0) {
+        clear();
+        return;
+    }
+
+    std::size_t last = count - 1;
+    Block& block = blocks[(firstBlock + last / KEYFRAME_INTERVAL) % MAX_BLOCKS];
+    std::size_t end = decode(block, last % KEYFRAME_INTERVAL, previous);
+
+    block.size = end - block.offset;
+    block.frames = last % KEYFRAME_INTERVAL + 1;
+    blockCount = last / KEYFRAME_INTERVAL + 1;
+}
+
+void MatchHistory::clear() {
+    firstBlock = 0;
+    blockCount = 0;
+}
+
+
+/*
+    Sizes
+
+    Objective:
+        Frame count and memory use (stats overlay, benchmarks).
+*/
+std::size_t MatchHistory::getFrameCount() const {
+    if (blockCount == 0)
+        return 0;
+    return (blockCount - 1) * KEYFRAME_INTERVAL + blocks[(firstBlock + blockCount - 1) % MAX_BLOCKS].frames;
+}
+
+std::size_t MatchHistory::getEncodedBytes() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < blockCount; ++i)
+        total += blocks[(firstBlock + i) % MAX_BLOCKS].size;
+    return total;
+}
+
+std::size_t MatchHistory::getMemoryBytes() const {
+    return sizeof(*this) + bytes.size();
+}
+
+
+/*
+    Function: std::size_t MatchHistory::decode(const Block& block, std::size_t last, std::uint32_t* words) const
+
+    Objective:
+        Reconstruct frame 'last' of a block.
+
+    Input Parameters:
+        - const Block& block: Block to read.
+        - std::size_t last: Frame within the block.
+        - std::uint32_t* words: Result (WORDS words).
+
+    Return Value:
+        - std::size_t: Offset in 'bytes' just past that frame.
+
+    Side Effects:
+        - None.
+*/
+std::size_t MatchHistory::decode(const Block& block, std::size_t last, std::uint32_t* words) const {
+    const unsigned char* in = &bytes[block.offset];
+    std::memcpy(words, in, KEYFRAME_BYTES);
+    in += KEYFRAME_BYTES;
+
+    for (std::size_t i = 0; i < last; ++i)
+        in += applyDelta(in, words);
+
+    return static_cast<std::size_t>(in - bytes.data());
+}
@@ -0,0 +1,754 @@
+#include "MatchStats.h"
+#include "Arena.h"
+#include "Checksum.h"
+#include "Match.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define fsync _commit
+    #define ftruncate _chsize
+#else
+    #include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+    #define O_BINARY 0
+#endif
+
+const char* const MATCH_STATS_PATH = "match_stats";
+
+namespace {
+    // "PMS1" – identifies a stats journal record
+    const std::uint32_t RECORD_MAGIC = 0x31534D50u;
+
+    const char SEGMENT_MAGIC[4] = { 'M', 'S', 'C', '1' };
+
+    const char* const COLUMN_NAMES[STATS_COLUMN_COUNT] = {
+        "timestamp", "mode", "arena", "ticks", "left_score", "right_score", "points", "hits",
+        "longest_rally", "zone_0", "zone_1", "zone_2", "zone_3", "zone_4", "left_travel", "right_travel"
+    };
+
+    ///////////////////////////////////////////////////////////
+    /// Struct: JournalRecord
+    /// ------------------------------------------------------
+    /// Fixed 64-byte journal record; the CRC covers the row.
+    ///////////////////////////////////////////////////////////
+    struct JournalRecord {
+        std::uint32_t magic;
+        std::uint32_t crc;
+        MatchStatsRow row;
+    };
+
+    static_assert(sizeof(MatchStatsRow) == 56, "stats rows are stored as-is");
+    static_assert(sizeof(JournalRecord) == 64, "journal record must stay 64 bytes");
+    static_assert(sizeof(StatsChunk) == 24 && sizeof(StatsSegmentHeader) == 400,
+                  "segment headers are stored as-is");
+
+    std::size_t chunkBytes(const StatsSegmentHeader& segment, std::size_t column) {
+        return std::size_t(segment.rows) * segment.chunks[column].width;
+    }
+
+    std::size_t segmentBytes(const StatsSegmentHeader& segment) {
+        std::size_t bytes = sizeof(StatsSegmentHeader);
+        for (std::size_t c = 0; c < STATS_COLUMN_COUNT; ++c)
+            bytes += chunkBytes(segment, c);
+        return bytes;
+    }
+
+    std::uint32_t headerCrc(StatsSegmentHeader segment) {
+        segment.headerCrc = 0;
+        return crc32(&segment, sizeof segment);
+    }
+
+    std::uint32_t rowsCrc(const MatchStatsRow* rows, std::size_t count) {
+        return crc32(rows, count * sizeof(MatchStatsRow));
+    }
+
+    /*
+        Store the values of one chunk, 'width' bytes each.
+    */
+    template <typename T>
+    void packValues(const std::vector<std::uint64_t>& values, std::uint64_t base, unsigned char* out) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            T value = static_cast<T>(values[i] - base);
+            std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+        }
+    }
+
+    template <typename T, typename Out>
+    void unpackValues(const unsigned char* in, std::size_t count, std::uint64_t base, Out* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            T value;
+            std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+            out[i] = static_cast<Out>(base + value);
+        }
+    }
+
+    template <typename Out>
+    void unpackChunk(const unsigned char* in, const StatsChunk& chunk, std::size_t count, Out* out) {
+        switch (chunk.width) {
+            case 1:  unpackValues<std::uint8_t>(in, count, chunk.base, out); break;
+            case 2:  unpackValues<std::uint16_t>(in, count, chunk.base, out); break;
+            case 4:  unpackValues<std::uint32_t>(in, count, chunk.base, out); break;
+            default: unpackValues<std::uint64_t>(in, count, chunk.base, out); break;
+        }
+    }
+
+    /*
+        Write a whole buffer, retrying on short writes.
+    */
+    bool writeAll(int fd, const void* buffer, std::size_t size) {
+        const unsigned char* data = static_cast<const unsigned char*>(buffer);
+        while (size > 0) {
+            auto written = ::write(fd, data, static_cast<unsigned>(size));
+            if (written <= 0)
+                return false;
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    bool writeRecords(int fd, const MatchStatsRow* rows, std::size_t count) {
+        std::vector<JournalRecord> records(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            records[i].magic = RECORD_MAGIC;
+            records[i].row = rows[i];
+            records[i].crc = crc32(&rows[i], sizeof(MatchStatsRow));
+        }
+        return writeAll(fd, records.data(), records.size() * sizeof(JournalRecord));
+    }
+
+    /*
+        Cut a file back to 'size' bytes.
+    */
+    void truncateFile(const std::string& path, long size) {
+        int truncFd = ::open(path.c_str(), O_WRONLY | O_BINARY);
+        if (truncFd < 0 || ftruncate(truncFd, size) != 0)
+            std::cout << "Match stats: failed to truncate " << path << "\n";
+        if (truncFd >= 0)
+            ::close(truncFd);
+    }
+
+    int zoneOf(float ballCenterY, const sf::FloatRect& paddle) {
+        int zone = static_cast<int>((ballCenterY - paddle.top) / paddle.height * STATS_HIT_ZONES);
+        return std::min(std::max(zone, 0), static_cast<int>(STATS_HIT_ZONES) - 1);
+    }
+}
+
+
+const char* statsColumnName(StatsColumn column) {
+    return COLUMN_NAMES[static_cast<std::size_t>(column)];
+}
+
+
+std::uint64_t statsColumnValue(const MatchStatsRow& row, StatsColumn column) {
+    switch (column) {
+        case StatsColumn::TIMESTAMP:     return static_cast<std::uint64_t>(row.timestamp);
+        case StatsColumn::MODE:          return row.mode;
+        case StatsColumn::ARENA:         return row.arena;
+        case StatsColumn::TICKS:         return row.ticks;
+        case StatsColumn::LEFT_SCORE:    return row.leftScore;
+        case StatsColumn::RIGHT_SCORE:   return row.rightScore;
+        case StatsColumn::POINTS:        return row.points;
+        case StatsColumn::HITS:          return row.hits;
+        case StatsColumn::LONGEST_RALLY: return row.longestRally;
+        case StatsColumn::LEFT_TRAVEL:   return row.leftTravel;
+        case StatsColumn::RIGHT_TRAVEL:  return row.rightTravel;
+        default:
+            return row.hitZones[static_cast<std::size_t>(column) - static_cast<std::size_t>(StatsColumn::ZONE_0)];
+    }
+}
+
+
+/*
+    Function: void encodeStatsSegment(const MatchStatsRow* rows, std::size_t count,
+                                      std::uint32_t sourceCrc, std::vector<unsigned char>& out)
+
+    Objective:
+        Turn rows into one columnar segment.
+
+    Input Parameters:
+        - const MatchStatsRow* rows, std::size_t count: The rows.
+        - std::uint32_t sourceCrc: Recorded in the header.
+        - std::vector<unsigned char>& out: Appended to.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Grows 'out'.
+
+    Approach:
+        - Per column: min and max, then the narrowest width for the
+          range, values stored minus the minimum.
+        - Header last, once the chunks' widths and CRCs are known.
+*/
+void encodeStatsSegment(const MatchStatsRow* rows, std::size_t count, std::uint32_t sourceCrc,
+                        std::vector<unsigned char>& out) {
+    StatsSegmentHeader segment;
+    std::memset(&segment, 0, sizeof segment);
+    std::memcpy(segment.magic, SEGMENT_MAGIC, 4);
+    segment.rows = static_cast<std::uint32_t>(count);
+    segment.sourceCrc = sourceCrc;
+
+    std::size_t headerAt = out.size();
+    out.resize(out.size() + sizeof segment);
+
+    std::vector<std::uint64_t> values(count);
+    for (std::size_t c = 0; c < STATS_COLUMN_COUNT; ++c) {
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = statsColumnValue(rows[i], static_cast<StatsColumn>(c));
+
+        StatsChunk& chunk = segment.chunks[c];
+        chunk.base = *std::min_element(values.begin(), values.end());
+        chunk.max = *std::max_element(values.begin(), values.end());
+        std::uint64_t range = chunk.max - chunk.base;
+        chunk.width = range <= 0xFFu ? 1 : range <= 0xFFFFu ? 2 : range <= 0xFFFFFFFFu ? 4 : 8;
+
+        std::size_t at = out.size();
+        out.resize(at + count * chunk.width);
+        switch (chunk.width) {
+            case 1:  packValues<std::uint8_t>(values, chunk.base, &out[at]); break;
+            case 2:  packValues<std::uint16_t>(values, chunk.base, &out[at]); break;
+            case 4:  packValues<std::uint32_t>(values, chunk.base, &out[at]); break;
+            default: packValues<std::uint64_t>(values, chunk.base, &out[at]); break;
+        }
+        chunk.crc = crc32(&out[at], count * chunk.width);
+    }
+
+    segment.headerCrc = headerCrc(segment);
+    std::memcpy(&out[headerAt], &segment, sizeof segment);
+}
+
+
+/*
+    Function: long readStatsJournal(const std::string& path, std::vector<MatchStatsRow>& rows)
+
+    Objective:
+        Read the valid rows of a stats journal.
+
+    Input Parameters:
+        - const std::string& path: Journal file.
+        - std::vector<MatchStatsRow>& rows: Appended to.
+
+    Return Value:
+        - long: Bytes after the last valid record (a torn tail).
+
+    Side Effects:
+        - None (the file is only read).
+
+    Approach:
+        - Records in order until the first one with a wrong magic or
+          CRC, like the leaderboard journal.
+*/
+long readStatsJournal(const std::string& path, std::vector<MatchStatsRow>& rows) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return 0;
+
+    long validBytes = 0;
+    JournalRecord record;
+    while (std::fread(&record, sizeof record, 1, file) == 1 && record.magic == RECORD_MAGIC &&
+           record.crc == crc32(&record.row, sizeof record.row)) {
+        rows.push_back(record.row);
+        validBytes += static_cast<long>(sizeof record);
+    }
+    long size = std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : validBytes;
+    std::fclose(file);
+    return size - validBytes;
+}
+
+
+StatsFileReader::StatsFileReader()
+    : file(nullptr),
+      segmentStart(-1),
+      validEnd(0),
+      bytesRead(0)
+{
+    std::memset(&segment, 0, sizeof segment);
+}
+
+
+StatsFileReader::~StatsFileReader() {
+    if (file)
+        std::fclose(file);
+}
+
+
+bool StatsFileReader::open(const std::string& path) {
+    file = std::fopen(path.c_str(), "rb");
+    return file != nullptr;
+}
+
+
+/*
+    Function: bool StatsFileReader::next()
+
+    Objective:
+        Move to the next segment.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - bool: false at the end or at a damaged segment.
+
+    Side Effects:
+        - Reads the segment header.
+
+    Approach:
+        - The next header starts where the current segment's chunks
+          end; it must have the magic, a matching CRC, sane widths and
+          all its chunks inside the file.
+*/
+bool StatsFileReader::next() {
+    if (!file)
+        return false;
+
+    long start = segmentStart < 0 ? 0 : segmentStart + static_cast<long>(segmentBytes(segment));
+    if (std::fseek(file, 0, SEEK_END) != 0)
+        return false;
+    long size = std::ftell(file);
+
+    StatsSegmentHeader header;
+    if (std::fseek(file, start, SEEK_SET) != 0 || std::fread(&header, sizeof header, 1, file) != 1)
+        return false;
+    bytesRead += sizeof header;
+
+    bool ok = std::memcmp(header.magic, SEGMENT_MAGIC, 4) == 0 &&
+              header.headerCrc == headerCrc(header) &&
+              header.rows >= 1 && header.rows <= STATS_SEGMENT_ROWS;
+    for (std::size_t c = 0; ok && c < STATS_COLUMN_COUNT; ++c) {
+        std::uint8_t width = header.chunks[c].width;
+        ok = width == 1 || width == 2 || width == 4 || width == 8;
+    }
+    if (!ok || start + static_cast<long>(segmentBytes(header)) > size)
+        return false;
+
+    segment = header;
+    segmentStart = start;
+    validEnd = start + static_cast<long>(segmentBytes(header));
+    return true;
+}
+
+
+const StatsSegmentHeader& StatsFileReader::getSegment() const {
+    return segment;
+}
+
+
+/*
+    Function: const unsigned char* StatsFileReader::readChunk(StatsColumn column)
+
+    Objective:
+        Read one chunk of the current segment.
+
+    Input Parameters:
+        - StatsColumn column: Which chunk.
+
+    Return Value:
+        - const unsigned char*: The stored bytes (valid until the next
+          read), nullptr on a read or CRC error.
+
+    Side Effects:
+        - Seeks and reads; counts the bytes read.
+*/
+const unsigned char* StatsFileReader::readChunk(StatsColumn column) {
+    std::size_t index = static_cast<std::size_t>(column);
+    long offset = segmentStart + static_cast<long>(sizeof(StatsSegmentHeader));
+    for (std::size_t c = 0; c < index; ++c)
+        offset += static_cast<long>(chunkBytes(segment, c));
+
+    std::size_t bytes = chunkBytes(segment, index);
+    scratch.resize(bytes);
+    if (std::fseek(file, offset, SEEK_SET) != 0 || std::fread(scratch.data(), 1, bytes, file) != bytes)
+        return nullptr;
+    bytesRead += bytes;
+
+    if (crc32(scratch.data(), bytes) != segment.chunks[index].crc)
+        return nullptr;
+    return scratch.data();
+}
+
+
+bool StatsFileReader::readColumn(StatsColumn column, std::uint32_t* out) {
+    const StatsChunk& chunk = segment.chunks[static_cast<std::size_t>(column)];
+    if (chunk.max > std::numeric_limits<std::uint32_t>::max())
+        return false;
+    const unsigned char* data = readChunk(column);
+    if (!data)
+        return false;
+    unpackChunk(data, chunk, segment.rows, out);
+    return true;
+}
+
+
+bool StatsFileReader::readColumn(StatsColumn column, std::uint64_t* out) {
+    const unsigned char* data = readChunk(column);
+    if (!data)
+        return false;
+    unpackChunk(data, segment.chunks[static_cast<std::size_t>(column)], segment.rows, out);
+    return true;
+}
+
+
+long StatsFileReader::getValidEnd() const {
+    return validEnd;
+}
+
+
+std::uint64_t StatsFileReader::getBytesRead() const {
+    return bytesRead;
+}
+
+
+MatchStatsRecorder::MatchStatsRecorder()
+    : leftY(0.f),
+      rightY(0.f),
+      leftTravel(0.0),
+      rightTravel(0.0),
+      rally(0)
+{
+    std::memset(&row, 0, sizeof row);
+}
+
+
+/*
+    Function: void MatchStatsRecorder::start(const Match& match)
+
+    Objective:
+        Begin counting a match.
+
+    Input Parameters:
+        - const Match& match: The match about to be played (or resumed).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Clears every count.
+*/
+void MatchStatsRecorder::start(const Match& match) {
+    std::memset(&row, 0, sizeof row);
+    row.mode = static_cast<std::uint8_t>(match.getMode());
+    int preset = arenaPresetIndex(match.getArena());
+    row.arena = static_cast<std::uint8_t>(preset < 0 ? 255 : preset);
+
+    leftY = match.getPaddleBounds(Side::LEFT).top;
+    rightY = match.getPaddleBounds(Side::RIGHT).top;
+    leftTravel = rightTravel = 0.0;
+    rally = 0;
+}
+
+
+/*
+    Function: void MatchStatsRecorder::record(const Match& match, unsigned events)
+
+    Objective:
+        Count one step.
+
+    Input Parameters:
+        - const Match& match: The match after the step.
+        - unsigned events: MatchEvent flags of the step.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Updates the counts.
+
+    Approach:
+        - Travel: how far each paddle top moved.
+        - A hit's zone: the ball center's height on the paddle,
+          in fifths.
+        - A point ends the rally.
+*/
+void MatchStatsRecorder::record(const Match& match, unsigned events) {
+    sf::FloatRect left = match.getPaddleBounds(Side::LEFT);
+    sf::FloatRect right = match.getPaddleBounds(Side::RIGHT);
+    leftTravel += std::fabs(left.top - leftY);
+    rightTravel += std::fabs(right.top - rightY);
+    leftY = left.top;
+    rightY = right.top;
+
+    if (events & (MatchEvent::LEFT_HIT | MatchEvent::RIGHT_HIT)) {
+        sf::FloatRect ball = match.getBallBounds();
+        float centerY = ball.top + ball.height / 2.f;
+        if (events & MatchEvent::LEFT_HIT) {
+            ++row.hitZones[zoneOf(centerY, left)];
+            ++row.hits;
+            ++rally;
+        }
+        if (events & MatchEvent::RIGHT_HIT) {
+            ++row.hitZones[zoneOf(centerY, right)];
+            ++row.hits;
+            ++rally;
+        }
+    }
+
+    if (events & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED)) {
+        ++row.points;
+        row.longestRally = static_cast<std::uint16_t>(std::max<unsigned>(row.longestRally, rally));
+        rally = 0;
+    }
+}
+
+
+MatchStatsRow MatchStatsRecorder::finish(const Match& match, std::int64_t timestamp) const {
+    MatchStatsRow result = row;
+    result.timestamp = timestamp;
+    result.ticks = static_cast<std::uint32_t>(match.getTick());
+    result.leftScore = static_cast<std::uint8_t>(std::min(match.getLeftScore(), 255));
+    result.rightScore = static_cast<std::uint8_t>(std::min(match.getRightScore(), 255));
+    result.leftTravel = static_cast<std::uint32_t>(leftTravel + 0.5);
+    result.rightTravel = static_cast<std::uint32_t>(rightTravel + 0.5);
+    result.longestRally = static_cast<std::uint16_t>(std::max<unsigned>(row.longestRally, rally));
+    return result;
+}
+
+
+/*
+    Constructor: MatchStatsStore::MatchStatsStore(const std::string& basePath)
+
+    Objective:
+        Start the writer thread; the files are opened by it on the
+        first append.
+
+    Input Parameters:
+        - const std::string& basePath: Path of both files without
+          ".log" / ".col".
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Starts the writer thread.
+*/
+MatchStatsStore::MatchStatsStore(const std::string& basePath)
+    : basePath(basePath),
+      stopping(false),
+      opened(false),
+      fd(-1)
+{
+    writer = std::thread(&MatchStatsStore::writerLoop, this);
+}
+
+
+MatchStatsStore::~MatchStatsStore() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+
+    if (fd >= 0)
+        ::close(fd);
+}
+
+
+void MatchStatsStore::append(const MatchStatsRow& row) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(row);
+    }
+    wakeUp.notify_one();
+}
+
+
+/*
+    Function: void MatchStatsStore::writerLoop()
+
+    Objective:
+        Persist queued rows in the background.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Opens (and repairs) the files on the first batch; appends to
+          the journal and the columnar file.
+
+    Approach:
+        - Sleep until rows arrive (or shutdown), swap the queue out
+          under the lock, write it.
+*/
+void MatchStatsStore::writerLoop() {
+    std::vector<MatchStatsRow> batch;
+
+    while (true) {
+        bool exitAfterBatch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+            batch.swap(pending);
+            exitAfterBatch = stopping;
+        }
+
+        if (!batch.empty()) {
+            if (!opened)
+                open();
+            writeRows(batch);
+            batch.clear();
+        }
+
+        if (exitAfterBatch)
+            return;
+    }
+}
+
+
+/*
+    Function: void MatchStatsStore::open()
+
+    Objective:
+        Bring both files to a consistent state and open the journal.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - May truncate either file or rewrite the journal.
+
+    Approach:
+        - Walk the segments; cut off a torn last one.
+        - Read the journal's valid records; cut off a torn tail.
+        - If the journal starts with the rows of the last segment (a
+          crash between writing the segment and emptying the journal),
+          drop them.
+        - Compact if the journal is already a segment long.
+*/
+void MatchStatsStore::open() {
+    opened = true;
+    std::string columnPath = basePath + ".col";
+    std::string journalPath = basePath + ".log";
+
+    std::uint32_t lastSource = 0;
+    std::size_t lastRows = 0;
+    {
+        StatsFileReader reader;
+        if (reader.open(columnPath)) {
+            while (reader.next()) {
+                lastSource = reader.getSegment().sourceCrc;
+                lastRows = reader.getSegment().rows;
+            }
+            std::FILE* file = std::fopen(columnPath.c_str(), "rb");
+            long size = file && std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : 0;
+            if (file)
+                std::fclose(file);
+            if (size > reader.getValidEnd()) {
+                std::cout << "Match stats: discarding " << (size - reader.getValidEnd())
+                          << " bytes of torn segment data\n";
+                truncateFile(columnPath, reader.getValidEnd());
+            }
+        }
+    }
+
+    long torn = readStatsJournal(journalPath, journalRows);
+    if (torn > 0) {
+        std::cout << "Match stats: discarding " << torn << " bytes of torn journal data\n";
+        truncateFile(journalPath, static_cast<long>(journalRows.size() * sizeof(JournalRecord)));
+    }
+
+    bool compacted = lastRows > 0 && journalRows.size() >= lastRows &&
+                     rowsCrc(journalRows.data(), lastRows) == lastSource;
+    if (compacted)
+        journalRows.erase(journalRows.begin(), journalRows.begin() + static_cast<long>(lastRows));
+
+    fd = ::open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_BINARY, 0644);
+    if (fd < 0) {
+        std::cout << "Failed to open match stats journal " << journalPath << "\n";
+        return;
+    }
+    if (compacted && (ftruncate(fd, 0) != 0 || !writeRecords(fd, journalRows.data(), journalRows.size())))
+        std::cout << "Match stats: failed to rewrite journal\n";
+
+    while (journalRows.size() >= STATS_SEGMENT_ROWS && flushSegment()) {
+    }
+}
+
+
+/*
+    Function: void MatchStatsStore::writeRows(const std::vector<MatchStatsRow>& rows)
+
+    Objective:
+        Journal a batch of rows; compact full segments.
+
+    Input Parameters:
+        - const std::vector<MatchStatsRow>& rows: The batch.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Appends to and fsyncs the journal.
+*/
+void MatchStatsStore::writeRows(const std::vector<MatchStatsRow>& rows) {
+    if (fd < 0)
+        return;
+    if (!writeRecords(fd, rows.data(), rows.size()) || fsync(fd) != 0) {
+        std::cout << "Match stats: failed to write journal\n";
+        return;
+    }
+
+    journalRows.insert(journalRows.end(), rows.begin(), rows.end());
+    while (journalRows.size() >= STATS_SEGMENT_ROWS && flushSegment()) {
+    }
+}
+
+
+/*
+    Function: bool MatchStatsStore::flushSegment()
+
+    Objective:
+        Move the journal's first STATS_SEGMENT_ROWS rows into the
+        columnar file.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - bool: false if the columnar file could not be written (the
+          rows stay in the journal).
+
+    Side Effects:
+        - Appends and fsyncs a segment; rewrites the journal.
+
+    Approach:
+        - The segment is durable before the journal is emptied, so the
+          rows are never lost; open() removes the duplicates a crash in
+          between would leave.
+*/
+bool MatchStatsStore::flushSegment() {
+    std::vector<unsigned char> data;
+    encodeStatsSegment(journalRows.data(), STATS_SEGMENT_ROWS,
+                       rowsCrc(journalRows.data(), STATS_SEGMENT_ROWS), data);
+
+    std::string columnPath = basePath + ".col";
+    int columnFd = ::open(columnPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_BINARY, 0644);
+    bool ok = columnFd >= 0 && writeAll(columnFd, data.data(), data.size()) && fsync(columnFd) == 0;
+    if (columnFd >= 0)
+        ::close(columnFd);
+    if (!ok) {
+        std::cout << "Match stats: failed to write " << columnPath << "\n";
+        return false;
+    }
+
+    journalRows.erase(journalRows.begin(), journalRows.begin() + STATS_SEGMENT_ROWS);
+    if (ftruncate(fd, 0) != 0 || !writeRecords(fd, journalRows.data(), journalRows.size()) || fsync(fd) != 0)
+        std::cout << "Match stats: failed to rewrite journal\n";
+    return true;
+}
@@ -1,8 +1,12 @@
 #include "Menu.h"
-#include <iostream>
+
+namespace {
+    // Leaderboard lines listed on the menu
+    const std::size_t MENU_TOP_SCORES = 3;
+}
 
 /*
-    Constructor: Menu::Menu()
+    Constructor: Menu::Menu(const SdfFont& font)
 
     Objective:
         Initialize the entire game menu including:
@@ -10,31 +14,24 @@
         - High score text
         - AI mode button
         - PvP mode button
-        - Loading fonts and setting up visuals
+        - Setting up visuals
 
     Input Parameters:
-        - None
+        - const SdfFont& font: Loaded UI font (shared with the game).
 
     Return Value:
         - None (constructor)
 
     Side Effects:
-        - Loads font from file (could fail and print to console)
         - Initializes SFML shapes and text elements
 
     Approach:
-        - Load font from assets
         - Set up title and high score display
         - Configure two buttons: AI and PvP
         - Center text within buttons using bounding boxes
 */
-Menu::Menu()
+Menu::Menu(const SdfFont& font)
 {
-    if (!font.loadFromFile("assets/font.ttf"))
-    {
-        std::cout << "Failed to load font\n";
-    }
-
     // --- Title ---
     titleText.setFont(font);
     titleText.setString("PONG");
@@ -48,6 +45,12 @@ Menu::Menu()
     highScoreText.setFillColor(sf::Color::White);
     highScoreText.setPosition(200, 150);
 
+    // --- Top Scores ---
+    topScoresText.setFont(font);
+    topScoresText.setCharacterSize(20);
+    topScoresText.setFillColor(sf::Color(180, 180, 180));
+    topScoresText.setPosition(220, 440);
+
     // --- AI Button ---
     aiButton.setSize({200, 60});
     aiButton.setFillColor(sf::Color(80, 80, 80));
@@ -106,6 +109,37 @@ void Menu::setHighScore(int score)
 }
 
 
+/*
+    Function: void Menu::setTopScores(const std::vector<LeaderboardEntry>& entries)
+
+    Objective:
+        List the best AI-mode results below the buttons.
+
+    Input Parameters:
+        - const std::vector<LeaderboardEntry>& entries: Leaderboard table, best first.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Modifies the text shown on the menu.
+
+    Approach:
+        - Format up to MENU_TOP_SCORES lines as "rank. name  score".
+*/
+void Menu::setTopScores(const std::vector<LeaderboardEntry>& entries)
+{
+    std::string lines;
+
+    for (std::size_t i = 0; i < entries.size() && i < MENU_TOP_SCORES; ++i) {
+        lines += std::to_string(i + 1) + ". " + entries[i].name +
+                 "  " + std::to_string(entries[i].score) + "\n";
+    }
+
+    topScoresText.setString(lines);
+}
+
+
 /*
     Function: bool Menu::isAISelected(const sf::Vector2i& mousePos) const
 
@@ -159,13 +193,13 @@ bool Menu::isPVPSelected(const sf::Vector2i &mousePos) const
 
 
 /*
-    Function: void Menu::draw(sf::RenderWindow &window)
+    Function: void Menu::draw(sf::RenderTarget &target)
 
     Objective:
         Render the entire menu onto the game window.
 
     Input Parameters:
-        - sf::RenderWindow& window: The window to draw UI on.
+        - sf::RenderTarget& target: The window (or texture) to draw UI on.
 
     Return Value:
         - void
@@ -174,14 +208,15 @@ bool Menu::isPVPSelected(const sf::Vector2i &mousePos) const
         - Renders UI elements to the window (visible output).
 
     Approach:
-        - Draw title, high score, AI button, PvP button.
+        - Draw title, high score, AI button, PvP button, top scores.
 */
-void Menu::draw(sf::RenderWindow &window)
+void Menu::draw(sf::RenderTarget &target)
 {
-    window.draw(titleText);
-    window.draw(highScoreText);
-    window.draw(aiButton);
-    window.draw(aiButtonText);
-    window.draw(pvpButton);
-    window.draw(pvpButtonText);
+    target.draw(titleText);
+    target.draw(highScoreText);
+    target.draw(aiButton);
+    target.draw(aiButtonText);
+    target.draw(pvpButton);
+    target.draw(pvpButtonText);
+    target.draw(topScoresText);
 }
@@ -0,0 +1,539 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef _WIN32
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    const std::size_t COUNTERS   = static_cast<std::size_t>(MetricCounter::COUNT);
+    const std::size_t HISTOGRAMS = static_cast<std::size_t>(MetricHistogram::COUNT);
+    const std::size_t MAX_BOUNDS = 12;
+
+    struct CounterSpec {
+        const char* name;
+        const char* help;
+    };
+
+    // Indexed by MetricCounter
+    const CounterSpec COUNTER_SPECS[COUNTERS] = {
+        { "pong_points_total",           "Points scored by either side." },
+        { "pong_ai_misses_total",        "Points conceded by the AI paddle." },
+        { "pong_games_total",            "Matches finished." },
+        { "pong_high_score_writes_total", "Results written durably to the leaderboard journal." }
+    };
+
+    // Upper bounds ("le") of a histogram's buckets, ascending; +Inf is implicit
+    struct HistogramSpec {
+        const char* name;
+        const char* help;
+        std::size_t boundCount;
+        double bounds[MAX_BOUNDS];
+    };
+
+    // Indexed by MetricHistogram
+    const HistogramSpec HISTOGRAM_SPECS[HISTOGRAMS] = {
+        { "pong_frame_seconds", "Time between frames of the game loop.", 11,
+          { 0.004, 0.008, 0.012, 0.016, 0.0175, 0.020, 0.025, 0.0334, 0.050, 0.100, 0.250 } },
+        { "pong_update_seconds", "Time spent updating the game state per frame.", 10,
+          { 0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.010 } },
+        { "pong_rally_hits", "Paddle hits per rally.", 10,
+          { 0, 1, 2, 3, 4, 6, 8, 12, 16, 24 } }
+    };
+
+    // Served on the exporter thread only
+    const char* RATE_NAME = "pong_points_per_minute";
+    const char* RATE_HELP = "Points scored over the last minute.";
+
+    // Exporter timing
+    const int POLL_MILLISECONDS = 250;
+    const std::chrono::seconds SAMPLE_INTERVAL(1);
+    const std::chrono::seconds CLIENT_TIMEOUT(1);
+    const std::size_t REQUEST_BYTES = 4096;
+
+    ///////////////////////////////////////////////////////////
+    /// Struct: MetricShard
+    /// ------------------------------------------------------
+    /// One recording thread's cells. Only that thread writes
+    /// them (load + store, relaxed); scrapers only load. The
+    /// alignment keeps two shards off one cache line.
+    ///////////////////////////////////////////////////////////
+    struct alignas(64) MetricShard {
+        std::atomic<std::uint64_t> counters[COUNTERS];
+        std::atomic<std::uint64_t> buckets[HISTOGRAMS][MAX_BOUNDS + 1];
+        std::atomic<double> sums[HISTOGRAMS];
+
+        MetricShard() {
+            for (std::size_t i = 0; i < COUNTERS; ++i)
+                counters[i].store(0, std::memory_order_relaxed);
+            for (std::size_t h = 0; h < HISTOGRAMS; ++h) {
+                for (std::size_t b = 0; b <= MAX_BOUNDS; ++b)
+                    buckets[h][b].store(0, std::memory_order_relaxed);
+                sums[h].store(0.0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<MetricShard>> shards;
+    };
+
+    // Never destroyed: threads still recording during static
+    // destruction keep valid shards.
+    Registry& registry() {
+        static Registry* instance = new Registry;
+        return *instance;
+    }
+
+    thread_local MetricShard* localShard = nullptr;
+
+    MetricShard* registerShard() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.shards.emplace_back(new MetricShard);
+        localShard = shared.shards.back().get();
+        return localShard;
+    }
+
+    inline MetricShard& threadShard() {
+        MetricShard* shard = localShard;
+        return shard ? *shard : *registerShard();
+    }
+
+    // Single writer: a plain add, published atomically
+    inline void bump(std::atomic<std::uint64_t>& cell, std::uint64_t amount) {
+        cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    // Shard pointers at the time of the call (shards are never removed)
+    std::vector<const MetricShard*> shardList() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        std::vector<const MetricShard*> list;
+        list.reserve(shared.shards.size());
+        for (const auto& shard : shared.shards)
+            list.push_back(shard.get());
+        return list;
+    }
+
+    void appendLine(std::string& out, const char* format, ...) {
+        char line[256];
+        va_list args;
+        va_start(args, format);
+        int length = std::vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+
+        if (length > 0)
+            out.append(line, std::min<std::size_t>(std::size_t(length), sizeof(line) - 1));
+    }
+
+#ifndef _WIN32
+    // Whole buffer to a client (bounded by the socket's send timeout)
+    void sendAll(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+            if (sent <= 0)
+                return;
+            data += sent;
+            size -= std::size_t(sent);
+        }
+    }
+#endif
+}
+
+
+/*
+    Functions: countMetric / observeMetric
+
+    Objective:
+        Record a counter increment or a histogram observation.
+
+    Input Parameters:
+        - MetricCounter counter / MetricHistogram histogram: Metric to record.
+        - std::uint64_t amount: Counter increment.
+        - double value: Observation.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Updates the calling thread's shard (registers it on first use).
+
+    Approach:
+        - thread_local shard pointer; bucket = first bound >= value
+          (linear scan over at most MAX_BOUNDS doubles).
+        - Relaxed load + store: the thread is the cell's only writer.
+*/
+void countMetric(MetricCounter counter, std::uint64_t amount) {
+    bump(threadShard().counters[static_cast<std::size_t>(counter)], amount);
+}
+
+void observeMetric(MetricHistogram histogram, double value) {
+    std::size_t index = static_cast<std::size_t>(histogram);
+    const HistogramSpec& spec = HISTOGRAM_SPECS[index];
+    MetricShard& shard = threadShard();
+
+    std::size_t bucket = 0;
+    while (bucket < spec.boundCount && value > spec.bounds[bucket])
+        ++bucket;
+
+    bump(shard.buckets[index][bucket], 1);
+    std::atomic<double>& sum = shard.sums[index];
+    sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+
+/*
+    Function: std::uint64_t readMetric(MetricCounter counter)
+
+    Objective:
+        Total of one counter over every shard.
+
+    Input Parameters:
+        - MetricCounter counter: Counter to read.
+
+    Return Value:
+        - std::uint64_t: Sum of the shards' values.
+
+    Side Effects:
+        - Briefly locks the registry to list the shards.
+
+    Approach:
+        - Relaxed loads; concurrent records may or may not be included.
+*/
+std::uint64_t readMetric(MetricCounter counter) {
+    std::size_t index = static_cast<std::size_t>(counter);
+    std::uint64_t total = 0;
+    for (const MetricShard* shard : shardList())
+        total += shard->counters[index].load(std::memory_order_relaxed);
+    return total;
+}
+
+
+/*
+    Function: void formatMetrics(std::string& out)
+
+    Objective:
+        Render the registry in the Prometheus text exposition format.
+
+    Input Parameters:
+        - std::string& out: Text is appended here.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Briefly locks the registry to list the shards (never while a
+          recording thread holds it, except for its first record).
+
+    Approach:
+        - Sum each cell over the shards with relaxed loads.
+        - Counters: one sample each.
+        - Histograms: cumulative _bucket samples (le="+Inf" last),
+          _sum and _count, where _count is the +Inf bucket so the two
+          always agree.
+*/
+void formatMetrics(std::string& out) {
+    std::vector<const MetricShard*> shards = shardList();
+
+    for (std::size_t c = 0; c < COUNTERS; ++c) {
+        std::uint64_t total = 0;
+        for (const MetricShard* shard : shards)
+            total += shard->counters[c].load(std::memory_order_relaxed);
+
+        const CounterSpec& spec = COUNTER_SPECS[c];
+        appendLine(out, "# HELP %s %s\n# TYPE %s counter\n", spec.name, spec.help, spec.name);
+        appendLine(out, "%s %llu\n", spec.name, static_cast<unsigned long long>(total));
+    }
+
+    for (std::size_t h = 0; h < HISTOGRAMS; ++h) {
+        const HistogramSpec& spec = HISTOGRAM_SPECS[h];
+        std::uint64_t buckets[MAX_BOUNDS + 1] = {};
+        double sum = 0.0;
+
+        for (const MetricShard* shard : shards) {
+            for (std::size_t b = 0; b <= spec.boundCount; ++b)
+                buckets[b] += shard->buckets[h][b].load(std::memory_order_relaxed);
+            sum += shard->sums[h].load(std::memory_order_relaxed);
+        }
+
+        appendLine(out, "# HELP %s %s\n# TYPE %s histogram\n", spec.name, spec.help, spec.name);
+
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b < spec.boundCount; ++b) {
+            cumulative += buckets[b];
+            appendLine(out, "%s_bucket{le=\"%g\"} %llu\n", spec.name, spec.bounds[b],
+                       static_cast<unsigned long long>(cumulative));
+        }
+        cumulative += buckets[spec.boundCount];
+        appendLine(out, "%s_bucket{le=\"+Inf\"} %llu\n", spec.name, static_cast<unsigned long long>(cumulative));
+        appendLine(out, "%s_sum %.9g\n", spec.name, sum);
+        appendLine(out, "%s_count %llu\n", spec.name, static_cast<unsigned long long>(cumulative));
+    }
+}
+
+
+/*
+    Constructor / Destructor: MetricsExporter
+
+    Objective:
+        Hold the port until start(); stop and join the exporter thread.
+
+    Input Parameters:
+        - std::uint16_t port: Loopback TCP port to serve on.
+
+    Return Value:
+        - None.
+
+    Side Effects:
+        - The destructor closes the listening socket.
+
+    Approach:
+        - The thread polls with a short timeout and checks stopping, so
+          joining takes at most one poll interval.
+*/
+MetricsExporter::MetricsExporter(std::uint16_t port)
+    : port(port),
+      listenFd(-1),
+      stopping(false),
+      samples(),
+      sampleCount(0),
+      sampleNext(0)
+{
+}
+
+MetricsExporter::~MetricsExporter() {
+    stopping.store(true);
+    if (thread.joinable())
+        thread.join();
+
+#ifndef _WIN32
+    if (listenFd >= 0)
+        close(listenFd);
+#endif
+}
+
+
+/*
+    Function: bool MetricsExporter::start(std::string& error)
+
+    Objective:
+        Open the endpoint and start serving it.
+
+    Input Parameters:
+        - std::string& error: Reason on failure.
+
+    Return Value:
+        - bool: true once the socket listens and the thread runs.
+
+    Side Effects:
+        - Binds 127.0.0.1:port; starts the exporter thread.
+
+    Approach:
+        - SO_REUSEADDR so a restarted game can rebind at once.
+        - Loopback only: the endpoint is for a scraper on the cabinet.
+*/
+bool MetricsExporter::start(std::string& error) {
+#ifdef _WIN32
+    error = "metrics endpoint needs POSIX sockets";
+    return false;
+#else
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, 16) != 0) {
+        error = "port " + std::to_string(port) + ": " + std::strerror(errno);
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    samplePoints();
+    thread = std::thread(&MetricsExporter::serveLoop, this);
+    return true;
+#endif
+}
+
+
+/*
+    Function: void MetricsExporter::serveLoop()
+
+    Objective:
+        The exporter thread: sample the point rate and answer scrapes.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Accepts and serves connections until stopping.
+
+    Approach:
+        - poll() the listener with a short timeout; sample
+          pong_points_total whenever SAMPLE_INTERVAL has passed.
+*/
+void MetricsExporter::serveLoop() {
+#ifndef _WIN32
+    while (!stopping.load()) {
+        pollfd listener = { listenFd, POLLIN, 0 };
+        int ready = poll(&listener, 1, POLL_MILLISECONDS);
+
+        const PointSample& latest = samples[(sampleNext + RATE_SAMPLES - 1) % RATE_SAMPLES];
+        if (Clock::now() - latest.time >= SAMPLE_INTERVAL)
+            samplePoints();
+
+        if (ready <= 0 || !(listener.revents & POLLIN))
+            continue;
+
+        int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client >= 0) {
+            serveClient(client);
+            close(client);
+        }
+    }
+#endif
+}
+
+
+/*
+    Function: void MetricsExporter::serveClient(int fd)
+
+    Objective:
+        Answer one HTTP request.
+
+    Input Parameters:
+        - int fd: Accepted connection (closed by the caller).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Reads the request and writes the response.
+
+    Approach:
+        - Socket timeouts plus an overall deadline bound a stalled client
+          to CLIENT_TIMEOUT.
+        - Read until the blank line ending the headers (bodies are not
+          expected); "GET /metrics" gets the registry, anything else 404.
+        - HTTP/1.0 with Connection: close, so no keep-alive state.
+*/
+void MetricsExporter::serveClient(int fd) {
+#ifndef _WIN32
+    timeval timeout = { static_cast<time_t>(CLIENT_TIMEOUT.count()), 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    Clock::time_point deadline = Clock::now() + CLIENT_TIMEOUT;
+    std::string request;
+    char buffer[1024];
+
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < REQUEST_BYTES) {
+        if (Clock::now() > deadline)
+            return;
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+            return;
+        request.append(buffer, std::size_t(received));
+    }
+
+    std::string status;
+    std::string body;
+    const char* path = "GET /metrics";
+    std::size_t pathLength = std::strlen(path);
+    bool metrics = request.compare(0, pathLength, path) == 0 &&
+                   request.size() > pathLength &&
+                   (request[pathLength] == ' ' || request[pathLength] == '?');
+
+    if (metrics) {
+        status = "200 OK";
+        body.reserve(4096);
+        formatMetrics(body);
+        appendLine(body, "# HELP %s %s\n# TYPE %s gauge\n", RATE_NAME, RATE_HELP, RATE_NAME);
+        appendLine(body, "%s %.6g\n", RATE_NAME, pointsPerMinute());
+    }
+    else {
+        status = "404 Not Found";
+        body = "Metrics are served at /metrics\n";
+    }
+
+    std::string response = "HTTP/1.0 " + status + "\r\n"
+                           "Content-Type: text/plain; version=0.0.4\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n";
+    response += body;
+    sendAll(fd, response.data(), response.size());
+#else
+    (void)fd;
+#endif
+}
+
+
+/*
+    Functions: samplePoints / pointsPerMinute
+
+    Objective:
+        Keep a minute of pong_points_total samples and turn them into a
+        rate (exporter thread only).
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - pointsPerMinute: points since the oldest sample, per minute
+          (0 until a second has passed).
+
+    Side Effects:
+        - samplePoints overwrites the oldest ring entry.
+
+    Approach:
+        - Ring of RATE_SAMPLES (time, total); the rate uses the current
+          total against the oldest sample, so it spans up to a minute.
+*/
+void MetricsExporter::samplePoints() {
+    samples[sampleNext].time = Clock::now();
+    samples[sampleNext].points = readMetric(MetricCounter::POINTS);
+    sampleNext = (sampleNext + 1) % RATE_SAMPLES;
+    if (sampleCount < RATE_SAMPLES)
+        ++sampleCount;
+}
+
+double MetricsExporter::pointsPerMinute() const {
+    if (sampleCount == 0)
+        return 0.0;
+
+    const PointSample& oldest = samples[(sampleNext + RATE_SAMPLES - sampleCount) % RATE_SAMPLES];
+    double seconds = std::chrono::duration<double>(Clock::now() - oldest.time).count();
+    if (seconds < 1.0)
+        return 0.0;
+
+    return double(readMetric(MetricCounter::POINTS) - oldest.points) * 60.0 / seconds;
+}
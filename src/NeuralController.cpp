@@ -0,0 +1,89 @@
+#include "NeuralController.h"
+
+const char* const POLICY_WEIGHTS_PATH = "assets/policy.bin";
+
+/*
+    Function: const PolicyModel* sharedPolicyModel()
+
+    Objective:
+        Load the policy weights once and share them between controllers.
+
+    Return Value:
+        - const PolicyModel*: The model, or nullptr if it could not be loaded.
+
+    Side Effects:
+        - Reads POLICY_WEIGHTS_PATH on first call.
+
+    Approach:
+        - Function-local static (initialized once, thread-safe).
+*/
+const PolicyModel* sharedPolicyModel() {
+    static const std::unique_ptr<PolicyModel> model = [] {
+        std::unique_ptr<PolicyModel> loaded(new PolicyModel());
+        if (!loaded->load(POLICY_WEIGHTS_PATH))
+            loaded.reset();
+        return loaded;
+    }();
+    return model.get();
+}
+
+
+/*
+    Constructor: NeuralController::NeuralController()
+
+    Objective:
+        Quantize the shared model for this controller.
+
+    Side Effects:
+        - Allocates the int8 weights (~2.5 KB) and scratch buffers.
+*/
+NeuralController::NeuralController() {
+    if (const PolicyModel* model = sharedPolicyModel())
+        network.reset(new PolicyNetwork(*model));
+}
+
+
+/*
+    Function: PaddleAction NeuralController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        One policy decision.
+
+    Input Parameters:
+        - const Match& match: Current match.
+        - Side side: Paddle being controlled.
+        - float dt: Unused (passed to the fallback).
+
+    Return Value:
+        - PaddleAction: argmax of the network's logits.
+
+    Side Effects:
+        - Reuses the network's scratch buffers.
+
+    Approach:
+        - captureState → policyFeatures → infer (batch of 1).
+*/
+PaddleAction NeuralController::decide(const Match& match, Side side, float dt) {
+    if (!network)
+        return fallback.decide(match, side, dt);
+
+    float features[POLICY_INPUTS];
+    policyFeatures(captureState(match), side, features);
+
+    PaddleAction action;
+    network->infer(features, 1, &action);
+    return action;
+}
+
+
+/*
+    Function: std::string NeuralController::getReport() const
+
+    Objective:
+        Name the kernel in use, or warn that the weights are missing.
+*/
+std::string NeuralController::getReport() const {
+    if (!network)
+        return std::string("no weights at ") + POLICY_WEIGHTS_PATH + ", playing as chase";
+    return std::string("int8 ") + PolicyNetwork::kernelName(network->getKernel()) + " kernel";
+}
@@ -0,0 +1,307 @@
+#include "Observatory.h"
+#include <algorithm>
+
+namespace {
+    // A match still undecided after three minutes is drawn and replaced
+    const long MAX_TICKS = 60L * 60 * 3;
+
+    // Space between miniatures (fraction of a cell)
+    const float CELL_GAP = 0.06f;
+
+    // Triangles per miniature ball: a hexagon is a circle at this size
+    const std::size_t MINIATURE_BALL_SEGMENTS = 6;
+
+    const sf::Color FIELD_COLOR      = sf::Color(24, 24, 34);
+    const sf::Color LEFT_PIP_COLOR   = sf::Color(80, 200, 255);
+    const sf::Color RIGHT_PIP_COLOR  = sf::Color(255, 160, 80);
+
+    // Registered controller, or the default one for an unknown name
+    std::unique_ptr<PaddleController> createOrDefault(const std::string& name) {
+        std::unique_ptr<PaddleController> controller = createController(name);
+        return controller ? std::move(controller) : createController("chase");
+    }
+
+    std::string knownOrDefault(const std::string& name) {
+        return createController(name) ? name : "chase";
+    }
+}
+
+
+/*
+    Constructor: Observatory::Observatory(const Arena& arena, const std::string& left,
+                                          const std::string& right)
+
+    Objective:
+        Set up an empty observatory; start() creates the matches.
+
+    Input Parameters:
+        - const Arena& arena: Field and rules of every match.
+        - left, right: Controller names ("chase" if unknown).
+*/
+Observatory::Observatory(const Arena& arena, const std::string& left, const std::string& right)
+    : arena(arena),
+      leftName(knownOrDefault(left)),
+      rightName(knownOrDefault(right)),
+      nextSeed(0),
+      leftWins(0),
+      rightWins(0),
+      draws(0),
+      columns(1),
+      fieldScale(1.f)
+{
+    layout(sf::FloatRect(0.f, 0.f, arena.width, arena.height));
+}
+
+
+/*
+    Function: void Observatory::start(std::size_t count, std::uint64_t seed)
+
+    Objective:
+        Fill the grid with new matches.
+
+    Input Parameters:
+        - std::size_t count: Matches (clamped to 16..256).
+        - std::uint64_t seed: Seed of the first match.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Replaces every match and controller; clears the tallies.
+        - Keeps the layout's area and recomputes the grid for the new
+          count.
+*/
+void Observatory::start(std::size_t count, std::uint64_t seed) {
+    count = std::max(OBSERVATORY_MIN_MATCHES, std::min(OBSERVATORY_MAX_MATCHES, count));
+
+    matches.clear();
+    leftControllers.clear();
+    rightControllers.clear();
+    matches.reserve(count);
+    leftControllers.reserve(count);
+    rightControllers.reserve(count);
+
+    nextSeed = seed;
+    for (std::size_t i = 0; i < count; ++i) {
+        matches.push_back(Match(GameMode::PLAYER_VS_PLAYER, 0, arena));
+        leftControllers.push_back(createOrDefault(leftName));
+        rightControllers.push_back(createOrDefault(rightName));
+        restart(i);
+    }
+
+    leftWins = rightWins = draws = 0;
+    layout(bounds);
+}
+
+
+/*
+    Function: void Observatory::setControllers(const std::string& left, const std::string& right)
+
+    Objective:
+        Choose the controllers the next start() puts on each side.
+*/
+void Observatory::setControllers(const std::string& left, const std::string& right) {
+    leftName = knownOrDefault(left);
+    rightName = knownOrDefault(right);
+}
+
+
+/*
+    Function: void Observatory::restart(std::size_t index)
+
+    Objective:
+        Replace one match with a new one (next seed).
+
+    Approach:
+        - Controller seeds derive from the match seed as in
+          Tournament::playMatch(), so any match shown can be replayed
+          with --match LEFT RIGHT SEED (except those of the search AI,
+          which plays on its real-time budget here).
+*/
+void Observatory::restart(std::size_t index) {
+    std::uint64_t seed = nextSeed++;
+    matches[index] = Match(GameMode::PLAYER_VS_PLAYER, seed, arena);
+    leftControllers[index]->reset(mixSeed(seed, 1));
+    rightControllers[index]->reset(mixSeed(seed, 2));
+}
+
+
+/*
+    Function: std::size_t Observatory::step(float dt)
+
+    Objective:
+        Advance every match one tick.
+
+    Input Parameters:
+        - float dt: Tick length.
+
+    Return Value:
+        - std::size_t: Matches that ended this tick.
+
+    Side Effects:
+        - Steps the matches; counts and replaces the finished ones.
+
+    Approach:
+        - One pass over the match array: both controllers decide from
+          the pre-step state, then Match::step(). The matches are
+          independent, so the pass touches each one once per tick.
+        - A finished match is tallied as a win for the side with more
+          points, an overlong one as a draw.
+*/
+std::size_t Observatory::step(float dt) {
+    std::size_t ended = 0;
+
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        Match& match = matches[i];
+
+        MatchInput input;
+        input.left = leftControllers[i]->decide(match, Side::LEFT, dt);
+        input.right = rightControllers[i]->decide(match, Side::RIGHT, dt);
+        match.step(dt, input);
+
+        if (match.isFinished()) {
+            if (match.getLeftScore() > match.getRightScore())
+                ++leftWins;
+            else
+                ++rightWins;
+        }
+        else if (match.getTick() >= MAX_TICKS) {
+            ++draws;
+        }
+        else {
+            continue;
+        }
+
+        restart(i);
+        ++ended;
+    }
+    return ended;
+}
+
+
+/*
+    Function: void Observatory::layout(const sf::FloatRect& area)
+
+    Objective:
+        Arrange the grid of miniatures in an area of the field.
+
+    Input Parameters:
+        - const sf::FloatRect& area: Grid bounds (field coordinates).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Sets the column count, cell size and miniature scale.
+
+    Approach:
+        - Try every column count and keep the one giving the largest
+          miniature: the smaller of the cell's width and height ratios
+          to the arena decides a miniature's scale.
+        - The miniature is shrunk by CELL_GAP and centered in its cell.
+*/
+void Observatory::layout(const sf::FloatRect& area) {
+    bounds = area;
+    std::size_t count = std::max<std::size_t>(1, matches.size());
+
+    float best = 0.f;
+    for (std::size_t c = 1; c <= count; ++c) {
+        std::size_t rows = (count + c - 1) / c;
+        float scale = std::min(area.width / c / arena.width, area.height / rows / arena.height);
+        if (scale > best) {
+            best = scale;
+            columns = c;
+        }
+    }
+
+    std::size_t rows = (count + columns - 1) / columns;
+    cellSize = sf::Vector2f(area.width / columns, area.height / rows);
+    fieldScale = best * (1.f - CELL_GAP);
+    fieldOffset = sf::Vector2f((cellSize.x - arena.width * fieldScale) / 2.f,
+                               (cellSize.y - arena.height * fieldScale) / 2.f);
+}
+
+
+/*
+    Function: void Observatory::draw(EntityRenderer& renderer, sf::RenderTarget& target) const
+
+    Objective:
+        Draw every match of the grid.
+
+    Input Parameters:
+        - EntityRenderer& renderer: Batch the grid is built in.
+        - sf::RenderTarget& target: Window (or texture), field view set.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Rewrites the renderer's batch; one draw call.
+
+    Approach:
+        - Per cell, in drawing order: the field background, the match's
+          entities placed and scaled into it (hexagonal balls), then one
+          pip per point along the top, left score growing leftward from
+          the center line and right score rightward.
+*/
+void Observatory::draw(EntityRenderer& renderer, sf::RenderTarget& target) const {
+    float fieldWidth = arena.width * fieldScale;
+    float fieldHeight = arena.height * fieldScale;
+    float pip = fieldHeight * 0.04f;
+    float center = fieldWidth / 2.f;
+
+    renderer.begin();
+
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        const Match& match = matches[i];
+        sf::Vector2f corner(bounds.left + (i % columns) * cellSize.x + fieldOffset.x,
+                            bounds.top + (i / columns) * cellSize.y + fieldOffset.y);
+
+        renderer.addRect(sf::FloatRect(corner.x, corner.y, fieldWidth, fieldHeight), FIELD_COLOR);
+        renderer.add(match.getEntities(), corner, fieldScale, MINIATURE_BALL_SEGMENTS);
+
+        for (int p = 0; p < match.getLeftScore(); ++p)
+            renderer.addRect(sf::FloatRect(corner.x + center - (p + 1) * pip * 1.5f, corner.y + pip / 2.f,
+                                           pip, pip), LEFT_PIP_COLOR);
+        for (int p = 0; p < match.getRightScore(); ++p)
+            renderer.addRect(sf::FloatRect(corner.x + center + p * pip * 1.5f + pip / 2.f, corner.y + pip / 2.f,
+                                           pip, pip), RIGHT_PIP_COLOR);
+    }
+
+    renderer.submit(target);
+}
+
+
+/*
+    Read-only accessors
+
+    Objective:
+        Tallies for the HUD; matches for benchmarks and tools.
+*/
+std::size_t Observatory::getMatchCount() const {
+    return matches.size();
+}
+
+const Match& Observatory::getMatch(std::size_t index) const {
+    return matches[index];
+}
+
+const std::string& Observatory::getLeftName() const {
+    return leftName;
+}
+
+const std::string& Observatory::getRightName() const {
+    return rightName;
+}
+
+long Observatory::getLeftWins() const {
+    return leftWins;
+}
+
+long Observatory::getRightWins() const {
+    return rightWins;
+}
+
+long Observatory::getDraws() const {
+    return draws;
+}
@@ -0,0 +1,326 @@
+#include "PaddleController.h"
+#include "NeuralController.h"
+#include "SearchController.h"
+#include <cmath>
+
+namespace {
+    // Top of the ball range before stepSimState() bounces it (the bottom
+    // is the match arena's ballMaxY())
+    const float BALL_MIN_Y = 0.f;
+
+    // Lazy chase tuning
+    const float LAZY_MIN_REACTION   = 0.08f;
+    const float LAZY_REACTION_RANGE = 0.08f;
+    const float LAZY_DEAD_ZONE      = 10.f;
+
+    // Predictor tuning
+    const float PREDICT_MAX_AIM_ERROR = 25.f;
+    const float PREDICT_DEAD_ZONE     = 4.f;
+
+    /*
+        splitmix64 step: advances the state, returns 64 random bits.
+    */
+    std::uint64_t nextBits(std::uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /*
+        Uniform float in [0, 1).
+    */
+    float nextUnit(std::uint64_t& state) {
+        return (nextBits(state) >> 40) * (1.f / 16777216.f);
+    }
+
+    /*
+        Move toward a target height, ignoring offsets within deadZone.
+    */
+    PaddleAction steerTowards(float targetY, float paddleCenterY, float deadZone) {
+        if (targetY > paddleCenterY + deadZone)
+            return PaddleAction::DOWN;
+        if (targetY < paddleCenterY - deadZone)
+            return PaddleAction::UP;
+        return PaddleAction::STAY;
+    }
+
+    template <typename T>
+    std::unique_ptr<PaddleController> makeController(bool) {
+        return std::unique_ptr<PaddleController>(new T());
+    }
+
+    // No time budget when reproducible: every decision searches to full depth
+    std::unique_ptr<PaddleController> makeSearchController(bool reproducible) {
+        return std::unique_ptr<PaddleController>(
+            reproducible ? new SearchController(0.0) : new SearchController());
+    }
+}
+
+
+/*
+    Function: void PaddleController::reset(std::uint64_t seed)
+
+    Objective:
+        Default: stateless controllers ignore the seed.
+*/
+void PaddleController::reset(std::uint64_t) {
+}
+
+
+/*
+    Function: std::string PaddleController::getReport() const
+
+    Objective:
+        Default: no report.
+*/
+std::string PaddleController::getReport() const {
+    return "";
+}
+
+
+/*
+    Function: void PaddleController::addStatistics(const PaddleController& other)
+
+    Objective:
+        Default: no statistics to add.
+*/
+void PaddleController::addStatistics(const PaddleController&) {
+}
+
+
+/*
+    Function: PaddleAction ChaseController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        Follow the ball's current height (original AI behaviour).
+
+    Input Parameters:
+        - const Match& match: Current match.
+        - Side side: Paddle being controlled.
+        - float dt: Unused.
+
+    Return Value:
+        - PaddleAction: DOWN if the ball is lower than the paddle center,
+          UP if higher, STAY if level.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Compare ball center Y with paddle center Y.
+*/
+PaddleAction ChaseController::decide(const Match& match, Side side, float) {
+    sf::FloatRect ballBounds = match.getBallBounds();
+    float ballCenterY   = ballBounds.top + ballBounds.height / 2.f;
+    sf::FloatRect paddleBounds = match.getPaddleBounds(side);
+    float paddleCenterY = paddleBounds.top + paddleBounds.height / 2.f;
+
+    return steerTowards(ballCenterY, paddleCenterY, 0.f);
+}
+
+
+/*
+    Constructor: LazyChaseController::LazyChaseController()
+
+    Objective:
+        Create a lazy chaser with default (seed 0) reaction time.
+*/
+LazyChaseController::LazyChaseController()
+    : rngState(0),
+      reactionTime(LAZY_MIN_REACTION),
+      sinceRefresh(0.f),
+      targetY(CLASSIC_ARENA.height / 2.f)
+{
+    reset(0);
+}
+
+
+/*
+    Function: void LazyChaseController::reset(std::uint64_t seed)
+
+    Objective:
+        Pick this match's reaction time from the seed.
+*/
+void LazyChaseController::reset(std::uint64_t seed) {
+    rngState = seed;
+    reactionTime = LAZY_MIN_REACTION + LAZY_REACTION_RANGE * nextUnit(rngState);
+    sinceRefresh = reactionTime;
+    targetY = CLASSIC_ARENA.height / 2.f;
+}
+
+
+/*
+    Function: PaddleAction LazyChaseController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        Chase the ball height as last "seen" at the reaction interval.
+
+    Input Parameters:
+        - const Match& match: Current match.
+        - Side side: Paddle being controlled.
+        - float dt: Step length, accumulated toward the next refresh.
+
+    Return Value:
+        - PaddleAction toward the remembered target.
+
+    Side Effects:
+        - Updates the remembered target every reactionTime seconds.
+
+    Approach:
+        - Refresh targetY when the interval elapses, then steer with a dead zone.
+*/
+PaddleAction LazyChaseController::decide(const Match& match, Side side, float dt) {
+    sinceRefresh += dt;
+    if (sinceRefresh >= reactionTime) {
+        sf::FloatRect ballBounds = match.getBallBounds();
+        targetY = ballBounds.top + ballBounds.height / 2.f;
+        sinceRefresh = 0.f;
+    }
+
+    sf::FloatRect paddleBounds = match.getPaddleBounds(side);
+    float paddleCenterY = paddleBounds.top + paddleBounds.height / 2.f;
+    return steerTowards(targetY, paddleCenterY, LAZY_DEAD_ZONE);
+}
+
+
+/*
+    Constructor: PredictController::PredictController()
+
+    Objective:
+        Create a predictor with seed 0.
+*/
+PredictController::PredictController()
+    : rngState(0),
+      aimError(0.f),
+      approaching(false)
+{
+    reset(0);
+}
+
+
+/*
+    Function: void PredictController::reset(std::uint64_t seed)
+
+    Objective:
+        Restart the aiming-error sequence from the seed.
+*/
+void PredictController::reset(std::uint64_t seed) {
+    rngState = seed;
+    aimError = 0.f;
+    approaching = false;
+}
+
+
+/*
+    Function: PaddleAction PredictController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        Move to where the ball will arrive.
+
+    Input Parameters:
+        - const Match& match: Current match.
+        - Side side: Paddle being controlled.
+        - float dt: Unused.
+
+    Return Value:
+        - PaddleAction toward the predicted intercept (or the center).
+
+    Side Effects:
+        - Draws a new aiming error each time the ball turns toward us.
+
+    Approach:
+        - Time to reach the paddle face: t = distance / |vx|.
+        - Unfold wall bounces: reflect y + vy*t into [BALL_MIN_Y, arena.ballMaxY()]
+          using the triangle wave of period 2 * range.
+*/
+PaddleAction PredictController::decide(const Match& match, Side side, float) {
+    const Arena& arena = match.getArena();
+    sf::FloatRect ballBounds = match.getBallBounds();
+    sf::FloatRect paddleBounds = match.getPaddleBounds(side);
+    sf::Vector2f velocity = match.getBallVelocity();
+
+    float paddleCenterY = paddleBounds.top + paddleBounds.height / 2.f;
+    bool towardUs = (side == Side::RIGHT) ? velocity.x > 0.f : velocity.x < 0.f;
+
+    if (!towardUs) {
+        approaching = false;
+        return steerTowards(arena.height / 2.f, paddleCenterY, PREDICT_DEAD_ZONE);
+    }
+
+    if (!approaching) {
+        approaching = true;
+        aimError = (2.f * nextUnit(rngState) - 1.f) * PREDICT_MAX_AIM_ERROR;
+    }
+
+    float faceX = (side == Side::RIGHT) ? paddleBounds.left - ballBounds.width
+                                        : paddleBounds.left + paddleBounds.width;
+    float t = std::fabs((faceX - ballBounds.left) / velocity.x);
+
+    float range = arena.ballMaxY() - BALL_MIN_Y;
+    float y = std::fmod(ballBounds.top - BALL_MIN_Y + velocity.y * t, 2.f * range);
+    if (y < 0.f)
+        y += 2.f * range;
+    if (y > range)
+        y = 2.f * range - y;
+
+    float targetY = BALL_MIN_Y + y + ballBounds.height / 2.f + aimError;
+    return steerTowards(targetY, paddleCenterY, PREDICT_DEAD_ZONE);
+}
+
+
+/*
+    Function: const std::vector<ControllerInfo>& getControllerRegistry()
+
+    Objective:
+        List all AI controllers available to the game and tournaments.
+
+    Approach:
+        - Static table; new controllers are registered by adding a line.
+*/
+const std::vector<ControllerInfo>& getControllerRegistry() {
+    static const std::vector<ControllerInfo> registry = {
+        { "chase",   "Original AI: follows the ball height (baseline)", &makeController<ChaseController> },
+        { "lazy",    "Chase with 80-160 ms reaction time and dead zone", &makeController<LazyChaseController> },
+        { "predict", "Predicts the intercept point, with aiming error",  &makeController<PredictController> },
+        { "search",  "Hard: beam search at full depth (1 ms per step in "
+                     "the menu demo and observatory)",               &makeSearchController },
+        { "neural",  "Trained MLP policy, int8 SIMD inference",           &makeController<NeuralController> },
+    };
+    return registry;
+}
+
+
+/*
+    Function: std::unique_ptr<PaddleController> createController(const std::string& name, bool reproducible)
+
+    Objective:
+        Look up a controller by name and create an instance.
+
+    Input Parameters:
+        - const std::string& name: Registered name.
+        - bool reproducible: No timing-dependent decisions (see the header).
+
+    Return Value:
+        - The new controller, or nullptr if the name is not registered.
+*/
+std::unique_ptr<PaddleController> createController(const std::string& name, bool reproducible) {
+    for (const ControllerInfo& info : getControllerRegistry()) {
+        if (name == info.name)
+            return info.create(reproducible);
+    }
+    return nullptr;
+}
+
+
+/*
+    Function: std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream)
+
+    Objective:
+        Derive a well-mixed seed for an independent stream (match, side...).
+*/
+std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    return nextBits(state);
+}
@@ -0,0 +1,367 @@
+#include "ParticleSystem.h"
+#include "Match.h"
+#include <cmath>
+
+namespace {
+    // Particles emitted per effect
+    const std::size_t PADDLE_PARTICLES = 48;
+    const std::size_t WALL_PARTICLES   = 16;
+    const std::size_t SCORE_PARTICLES  = 400;
+
+    // Fraction of velocity kept after one second (air drag)
+    const float VELOCITY_RETAINED_PER_SECOND = 0.15f;
+
+    // Particle lifetimes are chosen in [MIN, MIN + RANGE] seconds
+    const float MIN_LIFETIME   = 0.35f;
+    const float LIFETIME_RANGE = 0.45f;
+
+    const float TWO_PI = 6.28318530718f;
+}
+
+/*
+    Constructor: ParticleSystem::ParticleSystem(std::size_t capacity)
+
+    Objective:
+        Allocate the complete particle pool up front.
+
+    Input Parameters:
+        - std::size_t capacity: Maximum number of live particles.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Allocates one array per attribute plus 4 vertices per particle.
+
+    Approach:
+        - Size every array to the full capacity once; nothing is resized later.
+*/
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : capacity(capacity),
+      alive(0),
+      posX(capacity),
+      posY(capacity),
+      velX(capacity),
+      velY(capacity),
+      life(capacity),
+      fade(capacity),
+      color(capacity),
+      vertices(capacity * 4),
+      rngState(0x9E3779B9u),
+      updateMicros(0.f),
+      drawMicros(0.f)
+{
+}
+
+
+/*
+    Function: void ParticleSystem::emit(float x, float y, std::size_t count,
+                                        const sf::Color& color, float speed)
+
+    Objective:
+        Spawn a radial burst of particles.
+
+    Input Parameters:
+        - float x, float y: Burst origin.
+        - std::size_t count: Requested particle count.
+        - const sf::Color& color: Base colour.
+        - float speed: Maximum initial speed.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Appends to the live range; requests beyond capacity are dropped.
+
+    Approach:
+        - Clamp count to free space.
+        - Pick a random direction, speed and lifetime for each new particle.
+*/
+void ParticleSystem::emit(float x, float y, std::size_t count,
+                          const sf::Color& color, float speed) {
+    std::size_t freeSlots = capacity - alive;
+    if (count > freeSlots)
+        count = freeSlots;
+
+    for (std::size_t n = 0; n < count; ++n) {
+        std::size_t i = alive + n;
+
+        float angle = nextRandom() * TWO_PI;
+        float magnitude = speed * (0.25f + 0.75f * nextRandom());
+
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = std::cos(angle) * magnitude;
+        velY[i] = std::sin(angle) * magnitude;
+        life[i] = 1.f;
+        fade[i] = 1.f / (MIN_LIFETIME + LIFETIME_RANGE * nextRandom());
+        this->color[i] = color;
+    }
+
+    alive += count;
+}
+
+
+/*
+    Function: void ParticleSystem::update(float dt)
+
+    Objective:
+        Move live particles, apply drag, age them and retire dead ones.
+
+    Input Parameters:
+        - float dt: Delta time in seconds.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Modifies particle attributes and the live count.
+
+    Approach:
+        - Integrate each attribute in its own tight loop over raw arrays
+          (restrict-qualified so the compiler emits SIMD code).
+        - Compact: swap every dead particle with the last live one.
+*/
+void ParticleSystem::update(float dt) {
+    sf::Clock timer;
+
+    const std::size_t n = alive;
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    float* __restrict vx = velX.data();
+    float* __restrict vy = velY.data();
+    float* __restrict lf = life.data();
+    const float* __restrict fd = fade.data();
+
+    const float drag = std::pow(VELOCITY_RETAINED_PER_SECOND, dt);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        vx[i] *= drag;
+        vy[i] *= drag;
+        lf[i] -= fd[i] * dt;
+    }
+
+    // Compact: keep live particles packed in [0, alive)
+    std::size_t i = 0;
+    while (i < alive) {
+        if (life[i] > 0.f) {
+            ++i;
+            continue;
+        }
+
+        std::size_t last = --alive;
+        posX[i]  = posX[last];
+        posY[i]  = posY[last];
+        velX[i]  = velX[last];
+        velY[i]  = velY[last];
+        life[i]  = life[last];
+        fade[i]  = fade[last];
+        color[i] = color[last];
+    }
+
+    updateMicros = static_cast<float>(timer.getElapsedTime().asMicroseconds());
+}
+
+
+/*
+    Function: void ParticleSystem::draw(sf::RenderTarget& target)
+
+    Objective:
+        Render all live particles in one batched draw call.
+
+    Input Parameters:
+        - sf::RenderTarget& target: Window (or texture) to draw on.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Overwrites the front of the preallocated vertex buffer.
+
+    Approach:
+        - Write 4 vertices per live particle (alpha = remaining life).
+        - Submit the buffer once as sf::Quads.
+*/
+void ParticleSystem::draw(sf::RenderTarget& target) {
+    if (alive == 0) {
+        drawMicros = 0.f;
+        return;
+    }
+
+    sf::Clock timer;
+
+    for (std::size_t i = 0; i < alive; ++i) {
+        sf::Color c = color[i];
+        c.a = static_cast<sf::Uint8>(life[i] * 255.f);
+
+        float left   = posX[i] - PARTICLE_HALF_SIZE;
+        float right  = posX[i] + PARTICLE_HALF_SIZE;
+        float top    = posY[i] - PARTICLE_HALF_SIZE;
+        float bottom = posY[i] + PARTICLE_HALF_SIZE;
+
+        sf::Vertex* quad = &vertices[i * 4];
+        quad[0].position = sf::Vector2f(left, top);
+        quad[1].position = sf::Vector2f(right, top);
+        quad[2].position = sf::Vector2f(right, bottom);
+        quad[3].position = sf::Vector2f(left, bottom);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = c;
+    }
+
+    target.draw(vertices.data(), alive * 4, sf::Quads);
+
+    drawMicros = static_cast<float>(timer.getElapsedTime().asMicroseconds());
+}
+
+
+/*
+    Function: void ParticleSystem::getSprites(std::vector<ParticleSprite>& out) const
+
+    Objective:
+        Copy out what draw() would draw.
+
+    Input Parameters:
+        - std::vector<ParticleSprite>& out: Receives one sprite per live
+          particle (appended).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Grows 'out'.
+
+    Approach:
+        - Same colour and alpha as draw(); the position is the center.
+*/
+void ParticleSystem::getSprites(std::vector<ParticleSprite>& out) const {
+    for (std::size_t i = 0; i < alive; ++i) {
+        sf::Color c = color[i];
+        c.a = static_cast<sf::Uint8>(life[i] * 255.f);
+
+        ParticleSprite sprite = { posX[i], posY[i], c };
+        out.push_back(sprite);
+    }
+}
+
+
+/*
+    Function: void ParticleSystem::clear()
+
+    Objective:
+        Retire every particle without releasing memory.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Live count becomes zero.
+
+    Approach:
+        - Reset the live counter.
+*/
+void ParticleSystem::clear() {
+    alive = 0;
+}
+
+
+/*
+    Statistics accessors
+
+    Objective:
+        Expose pool size and per-frame cost for the stats overlay.
+*/
+std::size_t ParticleSystem::getAliveCount() const {
+    return alive;
+}
+
+std::size_t ParticleSystem::getCapacity() const {
+    return capacity;
+}
+
+std::size_t ParticleSystem::getMemoryBytes() const {
+    return capacity * (6 * sizeof(float) + sizeof(sf::Color) + 4 * sizeof(sf::Vertex));
+}
+
+float ParticleSystem::getUpdateMicros() const {
+    return updateMicros;
+}
+
+float ParticleSystem::getDrawMicros() const {
+    return drawMicros;
+}
+
+
+/*
+    Function: float ParticleSystem::nextRandom()
+
+    Objective:
+        Produce a uniform random float in [0, 1).
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - float in [0, 1)
+
+    Side Effects:
+        - Advances the xorshift32 state.
+
+    Approach:
+        - xorshift32, then use the top 24 bits as the mantissa.
+*/
+float ParticleSystem::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.f / 16777216.f);
+}
+
+
+/*
+    Function: void emitMatchEffects(ParticleSystem& particles, unsigned events, float exitY,
+                                    const sf::FloatRect& ball, float fieldWidth)
+
+    Objective:
+        Emit the bursts of one simulation step's events.
+
+    Input Parameters:
+        - ParticleSystem& particles: Pool to emit into.
+        - unsigned events: MatchEvent flags of the step.
+        - float exitY: Ball center height before the step.
+        - const sf::FloatRect& ball: Ball bounds after the step.
+        - float fieldWidth: Arena width.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Spawns particles (consumes the pool's random numbers, so the
+          same events in the same order give the same particles).
+
+    Approach:
+        - Wall bounce, left hit, right hit, then the score bursts: red
+          where a point is lost, green where one is won.
+*/
+void emitMatchEffects(ParticleSystem& particles, unsigned events, float exitY,
+                      const sf::FloatRect& ball, float fieldWidth) {
+    float ballCenterY = ball.top + ball.height / 2.f;
+
+    if (events & MatchEvent::WALL_BOUNCE)
+        particles.emit(ball.left + ball.width / 2.f, ballCenterY,
+                       WALL_PARTICLES, sf::Color(140, 140, 255), 150.f);
+    if (events & MatchEvent::LEFT_HIT)
+        particles.emit(ball.left, ballCenterY,
+                       PADDLE_PARTICLES, sf::Color::White, 250.f);
+    if (events & MatchEvent::RIGHT_HIT)
+        particles.emit(ball.left + ball.width, ballCenterY,
+                       PADDLE_PARTICLES, sf::Color::White, 250.f);
+
+    if (events & MatchEvent::RIGHT_SCORED)
+        particles.emit(0.f, exitY, SCORE_PARTICLES, sf::Color(255, 80, 80), 450.f);
+    if (events & MatchEvent::LEFT_SCORED)
+        particles.emit(fieldWidth, exitY, SCORE_PARTICLES, sf::Color(80, 255, 120), 450.f);
+}
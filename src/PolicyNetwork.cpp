@@ -0,0 +1,646 @@
+#include "PolicyNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POLICY_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Arena geometry used by the features: the policy is trained on,
+    // and only meaningful in, the classic arena
+    const float ARENA_WIDTH     = CLASSIC_ARENA.width;
+    const float BALL_SIZE       = CLASSIC_ARENA.ballSize;
+    const float BALL_MAX_Y      = CLASSIC_ARENA.ballMaxY();
+    const float PADDLE_HALF     = CLASSIC_ARENA.paddleHeight / 2.f;
+    const float RIGHT_FACE_X    = CLASSIC_ARENA.rightPaddleX() - BALL_SIZE;   // Ball left edge touching the right paddle
+    const float FEATURE_SPEED   = 400.f;   // Velocity normalization
+    const float FEATURE_LENGTH  = 300.f;   // Position normalization
+    const float FEATURE_OFFSET  = 100.f;   // Normalization of offsets from own paddle
+    const float FEATURE_LIMIT   = 2.f;     // Offsets are clipped to ±2 (= ±200 px)
+
+    // Input quantization: features in [-2, 2] → [-63, 63], stored +64 as u8
+    const float INPUT_SCALE      = 63.f / 2.f;
+    const int   INPUT_ZERO_POINT = 64;
+
+    // Largest quantized activation (7 bits, see PolicyNetwork)
+    const float ACTIVATION_MAX_Q = 127.f;
+
+    const char FILE_MAGIC[4] = { 'P', 'N', 'N', '1' };
+
+    std::size_t roundUp(std::size_t value, std::size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    /*
+        One layer as seen by the kernels (pointers into a QuantizedLayer).
+    */
+    struct LayerView {
+        const std::int8_t* weights;     // outputs × inputs
+        const float* scale;
+        const float* offset;
+        std::size_t inputs;             // Multiple of 32
+        std::size_t outputs;            // Multiple of 8
+        std::size_t realOutputs;
+    };
+
+    /*
+        int8 layer kernels: for every batch row b and output r,
+            y = dot(in[b * inputs ...], weights[r * inputs ...]) * scale[r] + offset[r]
+        with u8 inputs and s8 weights. Hidden layers (activations != nullptr)
+        store y clamped to [0, 127] and rounded as u8 (batch × outputs); the
+        output layer stores the first realOutputs values of y as float logits
+        (batch × POLICY_OUTPUTS).
+
+        Every kernel rounds exactly like the scalar one (int32 → float,
+        multiply, then add), so all kernels give bit-identical results.
+    */
+    typedef void (*LayerKernel)(const LayerView& layer, const std::uint8_t* in, std::size_t batch,
+                                std::uint8_t* activations, float* logits);
+
+    void layerScalar(const LayerView& layer, const std::uint8_t* in, std::size_t batch,
+                     std::uint8_t* activations, float* logits) {
+        const std::size_t k = layer.inputs;
+        for (std::size_t b = 0; b < batch; ++b) {
+            const std::uint8_t* x = in + b * k;
+            for (std::size_t r = 0; r < layer.outputs; ++r) {
+                const std::int8_t* row = layer.weights + r * k;
+                std::int32_t sum = 0;
+                for (std::size_t i = 0; i < k; ++i)
+                    sum += std::int32_t(x[i]) * std::int32_t(row[i]);
+
+                float y = float(sum) * layer.scale[r] + layer.offset[r];
+                if (activations) {
+                    y = std::min(std::max(y, 0.f), ACTIVATION_MAX_Q);
+                    activations[b * layer.outputs + r] = static_cast<std::uint8_t>(y + 0.5f);
+                }
+                else if (r < layer.realOutputs) {
+                    logits[b * POLICY_OUTPUTS + r] = y;
+                }
+            }
+        }
+    }
+
+#ifdef POLICY_X86_KERNELS
+    /*
+        Sum each of 8 vectors of 8 int32 lanes; result lane r = sum of v[r].
+    */
+    __attribute__((target("avx2")))
+    inline __m256i reduce8(const __m256i* v) {
+        __m256i t0 = _mm256_hadd_epi32(v[0], v[1]);
+        __m256i t1 = _mm256_hadd_epi32(v[2], v[3]);
+        __m256i t2 = _mm256_hadd_epi32(v[4], v[5]);
+        __m256i t3 = _mm256_hadd_epi32(v[6], v[7]);
+        __m256i u0 = _mm256_hadd_epi32(t0, t1);
+        __m256i u1 = _mm256_hadd_epi32(t2, t3);
+        return _mm256_add_epi32(_mm256_permute2x128_si256(u0, u1, 0x20),
+                                _mm256_permute2x128_si256(u0, u1, 0x31));
+    }
+
+    /*
+        Requantize and store outputs r0..r0+7 of batch row b (see LayerKernel).
+    */
+    __attribute__((target("avx2")))
+    inline void storeRows(const LayerView& layer, std::size_t b, std::size_t r0, __m256i sums,
+                          std::uint8_t* activations, float* logits) {
+        __m256 y = _mm256_mul_ps(_mm256_cvtepi32_ps(sums), _mm256_loadu_ps(layer.scale + r0));
+        y = _mm256_add_ps(y, _mm256_loadu_ps(layer.offset + r0));
+
+        if (activations) {
+            y = _mm256_min_ps(_mm256_max_ps(y, _mm256_setzero_ps()), _mm256_set1_ps(ACTIVATION_MAX_Q));
+            __m256i q = _mm256_cvttps_epi32(_mm256_add_ps(y, _mm256_set1_ps(0.5f)));
+            __m128i q16 = _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(activations + b * layer.outputs + r0),
+                             _mm_packus_epi16(q16, q16));
+            return;
+        }
+
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, y);
+        for (std::size_t r = r0; r < layer.realOutputs && r < r0 + 8; ++r)
+            logits[b * POLICY_OUTPUTS + r] = lanes[r - r0];
+    }
+
+    __attribute__((target("avx2")))
+    void layerAvx2(const LayerView& layer, const std::uint8_t* in, std::size_t batch,
+                   std::uint8_t* activations, float* logits) {
+        const std::size_t k = layer.inputs;
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (std::size_t b = 0; b < batch; ++b) {
+            const std::uint8_t* x = in + b * k;
+            for (std::size_t r0 = 0; r0 < layer.outputs; r0 += 8) {
+                __m256i acc[8];
+                for (int r = 0; r < 8; ++r)
+                    acc[r] = _mm256_setzero_si256();
+
+                for (std::size_t i = 0; i < k; i += 32) {
+                    __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+                    for (int r = 0; r < 8; ++r) {
+                        __m256i wv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layer.weights + (r0 + r) * k + i));
+                        // u8 × s8 pairs → s16 (no saturation: inputs ≤ 127), pairs → s32
+                        acc[r] = _mm256_add_epi32(acc[r], _mm256_madd_epi16(_mm256_maddubs_epi16(xv, wv), ones));
+                    }
+                }
+                storeRows(layer, b, r0, reduce8(acc), activations, logits);
+            }
+        }
+    }
+
+    __attribute__((target("avx2,avxvnni")))
+    void layerAvxVnni(const LayerView& layer, const std::uint8_t* in, std::size_t batch,
+                      std::uint8_t* activations, float* logits) {
+        const std::size_t k = layer.inputs;
+        for (std::size_t b = 0; b < batch; ++b) {
+            const std::uint8_t* x = in + b * k;
+            for (std::size_t r0 = 0; r0 < layer.outputs; r0 += 8) {
+                __m256i acc[8];
+                for (int r = 0; r < 8; ++r)
+                    acc[r] = _mm256_setzero_si256();
+
+                for (std::size_t i = 0; i < k; i += 32) {
+                    __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+                    for (int r = 0; r < 8; ++r) {
+                        __m256i wv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layer.weights + (r0 + r) * k + i));
+                        acc[r] = _mm256_dpbusd_avx_epi32(acc[r], xv, wv);
+                    }
+                }
+                storeRows(layer, b, r0, reduce8(acc), activations, logits);
+            }
+        }
+    }
+
+    __attribute__((target("avx2,avx512vnni,avx512vl")))
+    void layerAvx512Vnni(const LayerView& layer, const std::uint8_t* in, std::size_t batch,
+                         std::uint8_t* activations, float* logits) {
+        const std::size_t k = layer.inputs;
+        for (std::size_t b = 0; b < batch; ++b) {
+            const std::uint8_t* x = in + b * k;
+            for (std::size_t r0 = 0; r0 < layer.outputs; r0 += 8) {
+                __m256i acc[8];
+                for (int r = 0; r < 8; ++r)
+                    acc[r] = _mm256_setzero_si256();
+
+                for (std::size_t i = 0; i < k; i += 32) {
+                    __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+                    for (int r = 0; r < 8; ++r) {
+                        __m256i wv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layer.weights + (r0 + r) * k + i));
+                        acc[r] = _mm256_dpbusd_epi32(acc[r], xv, wv);
+                    }
+                }
+                storeRows(layer, b, r0, reduce8(acc), activations, logits);
+            }
+        }
+    }
+#endif
+
+    /*
+        Function pointer for a (supported) kernel.
+    */
+    LayerKernel kernelFunction(PolicyKernel kernel) {
+#ifdef POLICY_X86_KERNELS
+        if (kernel == PolicyKernel::AVX2)
+            return &layerAvx2;
+        if (kernel == PolicyKernel::VNNI)
+            return __builtin_cpu_supports("avxvnni") ? &layerAvxVnni : &layerAvx512Vnni;
+#else
+        (void)kernel;
+#endif
+        return &layerScalar;
+    }
+
+    template <typename T>
+    bool writeValue(std::FILE* file, const T& value) {
+        return std::fwrite(&value, sizeof value, 1, file) == 1;
+    }
+
+    template <typename T>
+    bool readValue(std::FILE* file, T& value) {
+        return std::fread(&value, sizeof value, 1, file) == 1;
+    }
+}
+
+
+/*
+    Function: void policyFeatures(const SimState& state, Side side, float* features)
+
+    Objective:
+        Encode a rally for the policy network.
+
+    Input Parameters:
+        - const SimState& state: Rally state.
+        - Side side: Paddle the decision is for.
+        - float* features: Output, POLICY_INPUTS floats.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Writes features.
+
+    Approach:
+        - Mirror X for the left paddle so "own" paddle is always on the right.
+        - Normalized ball position/velocity, own and opponent paddle heights,
+          ball height relative to own paddle, and the predicted intercept
+          (wall bounces unfolded) relative to own paddle when approaching.
+        - The two offsets use a 100 px unit clipped to ±2: they drive the
+          decision and need the finer resolution after int8 quantization.
+*/
+void policyFeatures(const SimState& state, Side side, float* features) {
+    bool left = side == Side::LEFT;
+    float x  = left ? ARENA_WIDTH - BALL_SIZE - state.ballX : state.ballX;
+    float vx = left ? -state.ballVX : state.ballVX;
+    float own = (left ? state.leftY : state.rightY) + PADDLE_HALF;
+    float opponent = (left ? state.rightY : state.leftY) + PADDLE_HALF;
+    float ballCenterY = state.ballY + BALL_SIZE / 2.f;
+
+    float intercept = 0.f;
+    if (vx > 0.f) {
+        float t = std::fabs((RIGHT_FACE_X - x) / vx);
+        float y = std::fmod(state.ballY + state.ballVY * t, 2.f * BALL_MAX_Y);
+        if (y < 0.f)
+            y += 2.f * BALL_MAX_Y;
+        if (y > BALL_MAX_Y)
+            y = 2.f * BALL_MAX_Y - y;
+        intercept = (y + BALL_SIZE / 2.f - own) / FEATURE_OFFSET;
+    }
+
+    // Offsets from the own paddle decide the move: finer scale, clipped
+    float offset = (ballCenterY - own) / FEATURE_OFFSET;
+
+    features[0] = (x - 310.f) / FEATURE_LENGTH;
+    features[1] = (ballCenterY - 300.f) / FEATURE_LENGTH;
+    features[2] = vx / FEATURE_SPEED;
+    features[3] = state.ballVY / FEATURE_SPEED;
+    features[4] = (own - 300.f) / FEATURE_LENGTH;
+    features[5] = std::max(-FEATURE_LIMIT, std::min(FEATURE_LIMIT, offset));
+    features[6] = (opponent - 300.f) / FEATURE_LENGTH;
+    features[7] = std::max(-FEATURE_LIMIT, std::min(FEATURE_LIMIT, intercept));
+}
+
+
+/*
+    Function: void PolicyModel::forward(const float* features, float* logits) const
+
+    Objective:
+        Float reference inference for one decision.
+
+    Input Parameters:
+        - const float* features: POLICY_INPUTS features.
+        - float* logits: Output, one per action.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Writes logits.
+
+    Approach:
+        - Dense + ReLU per hidden layer, dense output layer.
+*/
+void PolicyModel::forward(const float* features, float* logits) const {
+    float buffers[2][POLICY_HIDDEN > POLICY_INPUTS ? POLICY_HIDDEN : POLICY_INPUTS];
+    const float* in = features;
+
+    for (std::size_t l = 0; l < layers.size(); ++l) {
+        const PolicyLayer& layer = layers[l];
+        bool last = l + 1 == layers.size();
+        float* out = last ? logits : buffers[l % 2];
+
+        for (std::size_t j = 0; j < layer.outputs; ++j) {
+            float sum = layer.bias[j];
+            for (std::size_t i = 0; i < layer.inputs; ++i)
+                sum += layer.weights[j * layer.inputs + i] * in[i];
+            out[j] = last ? sum : std::max(sum, 0.f);
+        }
+        in = out;
+    }
+}
+
+
+/*
+    Function: bool PolicyModel::load(const std::string& path)
+
+    Objective:
+        Read a model written by save().
+
+    Input Parameters:
+        - const std::string& path: Weights file.
+
+    Return Value:
+        - bool: false if the file is missing, truncated or has the wrong shape.
+
+    Side Effects:
+        - Replaces layers and activation ranges.
+
+    Approach:
+        - Check magic and layer shapes against the POLICY_* constants.
+*/
+bool PolicyModel::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    char magic[4];
+    std::uint32_t count = 0;
+    bool ok = std::fread(magic, 1, 4, file) == 4 &&
+              std::memcmp(magic, FILE_MAGIC, 4) == 0 &&
+              readValue(file, count) && count == 3;
+
+    const std::size_t shapes[3][2] = {
+        { POLICY_INPUTS, POLICY_HIDDEN },
+        { POLICY_HIDDEN, POLICY_HIDDEN },
+        { POLICY_HIDDEN, POLICY_OUTPUTS }
+    };
+
+    layers.clear();
+    activationMax.clear();
+    for (std::uint32_t l = 0; ok && l < count; ++l) {
+        std::uint32_t inputs = 0, outputs = 0;
+        ok = readValue(file, inputs) && readValue(file, outputs) &&
+             inputs == shapes[l][0] && outputs == shapes[l][1];
+        if (!ok)
+            break;
+
+        PolicyLayer layer;
+        layer.inputs = inputs;
+        layer.outputs = outputs;
+        layer.weights.resize(std::size_t(inputs) * outputs);
+        layer.bias.resize(outputs);
+        float range = 0.f;
+        ok = std::fread(layer.weights.data(), sizeof(float), layer.weights.size(), file) == layer.weights.size() &&
+             std::fread(layer.bias.data(), sizeof(float), layer.bias.size(), file) == layer.bias.size() &&
+             readValue(file, range);
+
+        layers.push_back(layer);
+        if (l + 1 < count)
+            activationMax.push_back(range > 0.f ? range : 1.f);
+    }
+
+    std::fclose(file);
+    return ok;
+}
+
+
+/*
+    Function: bool PolicyModel::save(const std::string& path) const
+
+    Objective:
+        Write the model in the PNN1 format.
+
+    Input Parameters:
+        - const std::string& path: Output file.
+
+    Return Value:
+        - bool: true if every byte was written.
+
+    Side Effects:
+        - Creates/overwrites the file.
+
+    Approach:
+        - Header, then per layer shape, weights, bias, activation range
+          (0 for the output layer).
+*/
+bool PolicyModel::save(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool ok = std::fwrite(FILE_MAGIC, 1, 4, file) == 4 &&
+              writeValue(file, std::uint32_t(layers.size()));
+
+    for (std::size_t l = 0; ok && l < layers.size(); ++l) {
+        const PolicyLayer& layer = layers[l];
+        float range = l < activationMax.size() ? activationMax[l] : 0.f;
+        ok = writeValue(file, std::uint32_t(layer.inputs)) &&
+             writeValue(file, std::uint32_t(layer.outputs)) &&
+             std::fwrite(layer.weights.data(), sizeof(float), layer.weights.size(), file) == layer.weights.size() &&
+             std::fwrite(layer.bias.data(), sizeof(float), layer.bias.size(), file) == layer.bias.size() &&
+             writeValue(file, range);
+    }
+
+    return std::fclose(file) == 0 && ok;
+}
+
+
+/*
+    Constructor: PolicyNetwork::PolicyNetwork(const PolicyModel& model, PolicyKernel kernel)
+
+    Objective:
+        Quantize a float model to int8.
+
+    Input Parameters:
+        - const PolicyModel& model: Trained model.
+        - PolicyKernel kernel: Requested kernel (AUTO = best available).
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Allocates the quantized weights.
+
+    Approach:
+        - Per output row: weight scale s_w = 127 / max|w|.
+        - Input scale s_x and zero point z: fixed for the features,
+          127 / activation range (z = 0) for hidden layers.
+        - Output scale s_y: 127 / activation range for hidden layers, 1 for
+          the logits. Then y = acc * s_y / (s_w s_x) + (b s_y - z Σw_q · that).
+        - Pad inputs to 32 and outputs to 8 (32 for hidden layers, which
+          are the next layer's inputs) with zero weights.
+*/
+PolicyNetwork::PolicyNetwork(const PolicyModel& model, PolicyKernel kernel)
+    : kernel(kernel)
+{
+    if (this->kernel == PolicyKernel::AUTO) {
+        this->kernel = isKernelSupported(PolicyKernel::VNNI) ? PolicyKernel::VNNI
+                     : isKernelSupported(PolicyKernel::AVX2) ? PolicyKernel::AVX2
+                     : PolicyKernel::SCALAR;
+    }
+    else if (!isKernelSupported(this->kernel)) {
+        this->kernel = PolicyKernel::SCALAR;
+    }
+
+    for (std::size_t l = 0; l < model.layers.size(); ++l) {
+        const PolicyLayer& source = model.layers[l];
+        bool last = l + 1 == model.layers.size();
+
+        float inputScale = l == 0 ? INPUT_SCALE : ACTIVATION_MAX_Q / model.activationMax[l - 1];
+        float zeroPoint  = l == 0 ? float(INPUT_ZERO_POINT) : 0.f;
+        float outputScale = last ? 1.f : ACTIVATION_MAX_Q / model.activationMax[l];
+
+        QuantizedLayer layer;
+        layer.inputs = roundUp(source.inputs, 32);
+        layer.outputs = roundUp(source.outputs, last ? 8 : 32);
+        layer.realOutputs = source.outputs;
+        layer.weights.assign(layer.inputs * layer.outputs, 0);
+        layer.scale.assign(layer.outputs, 0.f);
+        layer.offset.assign(layer.outputs, 0.f);
+
+        for (std::size_t j = 0; j < source.outputs; ++j) {
+            float maxAbs = 0.f;
+            for (std::size_t i = 0; i < source.inputs; ++i)
+                maxAbs = std::max(maxAbs, std::fabs(source.weights[j * source.inputs + i]));
+            float weightScale = maxAbs > 0.f ? 127.f / maxAbs : 1.f;
+
+            long weightSum = 0;
+            for (std::size_t i = 0; i < source.inputs; ++i) {
+                long q = std::lround(source.weights[j * source.inputs + i] * weightScale);
+                q = std::max(-127L, std::min(127L, q));
+                layer.weights[j * layer.inputs + i] = static_cast<std::int8_t>(q);
+                weightSum += q;
+            }
+
+            layer.scale[j] = outputScale / (weightScale * inputScale);
+            layer.offset[j] = source.bias[j] * outputScale - zeroPoint * weightSum * layer.scale[j];
+        }
+
+        layers.push_back(layer);
+    }
+}
+
+
+/*
+    Function: void PolicyNetwork::infer(const float* features, std::size_t batch,
+                                        PaddleAction* actions)
+
+    Objective:
+        Batched decisions.
+
+    Input Parameters:
+        - const float* features: batch × POLICY_INPUTS features.
+        - std::size_t batch: Number of decisions.
+        - PaddleAction* actions: Output.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Reuses the scratch buffers.
+
+    Approach:
+        - run(), then argmax of each row of logits (ties → STAY, UP, DOWN order).
+*/
+void PolicyNetwork::infer(const float* features, std::size_t batch, PaddleAction* actions) {
+    run(features, batch);
+
+    for (std::size_t b = 0; b < batch; ++b) {
+        const float* row = &logitBuffer[b * POLICY_OUTPUTS];
+        std::size_t best = 0;
+        for (std::size_t j = 1; j < POLICY_OUTPUTS; ++j) {
+            if (row[j] > row[best])
+                best = j;
+        }
+        actions[b] = static_cast<PaddleAction>(best);
+    }
+}
+
+
+/*
+    Function: const float* PolicyNetwork::logits(const float* features, std::size_t batch)
+
+    Objective:
+        Dequantized logits of the int8 network (accuracy checks).
+*/
+const float* PolicyNetwork::logits(const float* features, std::size_t batch) {
+    run(features, batch);
+    return logitBuffer.data();
+}
+
+
+PolicyKernel PolicyNetwork::getKernel() const {
+    return kernel;
+}
+
+
+/*
+    Function: bool PolicyNetwork::isKernelSupported(PolicyKernel kernel)
+
+    Objective:
+        Check build target and CPU features for a kernel.
+*/
+bool PolicyNetwork::isKernelSupported(PolicyKernel kernel) {
+    switch (kernel) {
+    case PolicyKernel::AUTO:
+    case PolicyKernel::SCALAR:
+        return true;
+#ifdef POLICY_X86_KERNELS
+    case PolicyKernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case PolicyKernel::VNNI:
+        return __builtin_cpu_supports("avx2") &&
+               (__builtin_cpu_supports("avxvnni") ||
+                (__builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512vl")));
+#endif
+    default:
+        return false;
+    }
+}
+
+
+const char* PolicyNetwork::kernelName(PolicyKernel kernel) {
+    switch (kernel) {
+    case PolicyKernel::SCALAR: return "scalar";
+    case PolicyKernel::AVX2:   return "avx2";
+    case PolicyKernel::VNNI:   return "vnni";
+    default:                   return "auto";
+    }
+}
+
+
+/*
+    Function: void PolicyNetwork::run(const float* features, std::size_t batch)
+
+    Objective:
+        Evaluate the quantized network for a batch.
+
+    Input Parameters:
+        - const float* features: batch × POLICY_INPUTS features.
+        - std::size_t batch: Number of rows.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Fills logitBuffer (batch × POLICY_OUTPUTS).
+
+    Approach:
+        - Quantize features to u8 (zero point 64), zero padding; the clamp
+          keeps values positive so truncating q + 64.5 rounds them.
+        - One kernel call per layer: dot products and requantization (ReLU
+          + next layer's scale) are fused, the last layer writes the logits.
+*/
+void PolicyNetwork::run(const float* features, std::size_t batch) {
+    const std::size_t width = layers.front().inputs;
+    if (activations[0].size() < batch * width) {
+        activations[0].resize(batch * width);
+        activations[1].resize(batch * width);
+        logitBuffer.resize(batch * POLICY_OUTPUTS);
+    }
+
+    // ---------- Input quantization ----------
+    std::uint8_t* in = activations[0].data();
+    std::memset(in, 0, batch * width);
+    for (std::size_t b = 0; b < batch; ++b) {
+        for (std::size_t i = 0; i < POLICY_INPUTS; ++i) {
+            float q = features[b * POLICY_INPUTS + i] * INPUT_SCALE;
+            q = std::min(std::max(q, -63.f), 63.f);
+            in[b * width + i] = static_cast<std::uint8_t>(q + (INPUT_ZERO_POINT + 0.5f));
+        }
+    }
+
+    LayerKernel layerKernel = kernelFunction(kernel);
+
+    // ---------- Layers ----------
+    for (std::size_t l = 0; l < layers.size(); ++l) {
+        const QuantizedLayer& layer = layers[l];
+        bool last = l + 1 == layers.size();
+
+        LayerView view = { layer.weights.data(), layer.scale.data(), layer.offset.data(),
+                           layer.inputs, layer.outputs, layer.realOutputs };
+        std::uint8_t* out = last ? nullptr : activations[(l + 1) % 2].data();
+        layerKernel(view, in, batch, out, logitBuffer.data());
+        in = out;
+    }
+}
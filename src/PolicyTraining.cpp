@@ -0,0 +1,551 @@
+#include "PolicyTraining.h"
+#include "NeuralController.h"
+#include "PaddleController.h"
+#include "PolicyNetwork.h"
+#include "SimState.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const float MATCH_DT = 1.f / 60.f;
+
+    // Data collection: step limit per match, share of random moves played
+    // (labels stay the teacher's choice, so the student learns to recover)
+    const long  COLLECT_MAX_TICKS  = 60L * 60;
+    const float COLLECT_EXPLORATION = 0.2f;
+
+    // Training
+    const std::size_t BATCH_SIZE = 128;
+    const float LEARNING_RATE = 2e-3f;
+    const float ADAM_BETA1 = 0.9f;
+    const float ADAM_BETA2 = 0.999f;
+    const float ADAM_EPSILON = 1e-8f;
+    const double VALIDATION_SHARE = 0.1;
+
+    // Accuracy gate for --policy-check (int8 vs float argmax agreement)
+    const double MIN_AGREEMENT = 0.98;
+
+    // Lockstep matches in --policy-check
+    const long CHECK_MAX_TICKS = 60L * 60 * 2;
+
+    const char* const OPPONENTS[3] = { "chase", "lazy", "predict" };
+
+    /*
+        Teacher decisions recorded in headless matches.
+    */
+    struct Dataset {
+        std::vector<float> features;         // size × POLICY_INPUTS
+        std::vector<std::uint8_t> labels;    // PaddleAction per sample
+
+        std::size_t size() const { return labels.size(); }
+    };
+
+    /*
+        splitmix64 helpers for shuffling, initialization and exploration.
+    */
+    std::uint64_t nextBits(std::uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float nextUnit(std::uint64_t& state) {
+        return (nextBits(state) >> 40) * (1.f / 16777216.f);
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /*
+        Play matches of the teacher against the scripted AIs (alternating
+        sides and opponents) and record (features, teacher action).
+    */
+    Dataset collectDataset(const std::string& teacherName, std::size_t samples,
+                           std::uint64_t seed, float exploration) {
+        Dataset data;
+        data.features.reserve(samples * POLICY_INPUTS);
+        data.labels.reserve(samples);
+        std::uint64_t rng = seed;
+
+        for (std::uint64_t index = 0; data.size() < samples; ++index) {
+            std::uint64_t matchSeed = mixSeed(seed, index);
+            Side teacherSide = index % 2 ? Side::LEFT : Side::RIGHT;
+            Side opponentSide = index % 2 ? Side::RIGHT : Side::LEFT;
+
+            Match match(GameMode::PLAYER_VS_PLAYER, matchSeed);
+            std::unique_ptr<PaddleController> teacher = createController(teacherName);
+            std::unique_ptr<PaddleController> opponent = createController(OPPONENTS[index % 3]);
+            teacher->reset(mixSeed(matchSeed, 1));
+            opponent->reset(mixSeed(matchSeed, 2));
+
+            for (long tick = 0; tick < COLLECT_MAX_TICKS && !match.isFinished() && data.size() < samples; ++tick) {
+                PaddleAction label = teacher->decide(match, teacherSide, MATCH_DT);
+                PaddleAction other = opponent->decide(match, opponentSide, MATCH_DT);
+
+                float features[POLICY_INPUTS];
+                policyFeatures(captureState(match), teacherSide, features);
+                data.features.insert(data.features.end(), features, features + POLICY_INPUTS);
+                data.labels.push_back(static_cast<std::uint8_t>(label));
+
+                PaddleAction played = label;
+                if (nextUnit(rng) < exploration)
+                    played = static_cast<PaddleAction>(nextBits(rng) % 3);
+
+                MatchInput input;
+                input.left  = teacherSide == Side::LEFT ? played : other;
+                input.right = teacherSide == Side::RIGHT ? played : other;
+                match.step(MATCH_DT, input);
+            }
+        }
+        return data;
+    }
+
+    /*
+        Fresh model: He-uniform weights, zero biases.
+    */
+    PolicyModel makeModel(std::uint64_t seed) {
+        const std::size_t shapes[3][2] = {
+            { POLICY_INPUTS, POLICY_HIDDEN },
+            { POLICY_HIDDEN, POLICY_HIDDEN },
+            { POLICY_HIDDEN, POLICY_OUTPUTS }
+        };
+
+        PolicyModel model;
+        std::uint64_t rng = seed;
+        for (const auto& shape : shapes) {
+            PolicyLayer layer;
+            layer.inputs = shape[0];
+            layer.outputs = shape[1];
+            layer.weights.resize(layer.inputs * layer.outputs);
+            layer.bias.assign(layer.outputs, 0.f);
+            float limit = std::sqrt(6.f / layer.inputs);
+            for (float& w : layer.weights)
+                w = (2.f * nextUnit(rng) - 1.f) * limit;
+            model.layers.push_back(layer);
+        }
+        model.activationMax.assign(2, 1.f);
+        return model;
+    }
+
+    std::size_t argmax(const float* values, std::size_t count) {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < count; ++i) {
+            if (values[i] > values[best])
+                best = i;
+        }
+        return best;
+    }
+
+    /*
+        Share of samples whose float-model argmax equals the label.
+    */
+    double modelAccuracy(const PolicyModel& model, const Dataset& data,
+                         std::size_t begin, std::size_t end) {
+        std::size_t correct = 0;
+        for (std::size_t s = begin; s < end; ++s) {
+            float logits[POLICY_OUTPUTS];
+            model.forward(&data.features[s * POLICY_INPUTS], logits);
+            correct += argmax(logits, POLICY_OUTPUTS) == data.labels[s];
+        }
+        return end > begin ? double(correct) / (end - begin) : 0.0;
+    }
+
+    /*
+        Minibatch Adam on softmax cross-entropy (backpropagation written
+        out for the dense ReLU layers). Samples [0, trainSize) are used.
+    */
+    void trainModel(PolicyModel& model, const Dataset& data, std::size_t trainSize,
+                    int epochs, std::uint64_t seed) {
+        const std::size_t layerCount = model.layers.size();
+
+        // Gradients and Adam moments, shaped like the parameters
+        std::vector<std::vector<float>> gradW(layerCount), gradB(layerCount);
+        std::vector<std::vector<float>> mW(layerCount), vW(layerCount), mB(layerCount), vB(layerCount);
+        for (std::size_t l = 0; l < layerCount; ++l) {
+            gradW[l].assign(model.layers[l].weights.size(), 0.f);
+            gradB[l].assign(model.layers[l].bias.size(), 0.f);
+            mW[l] = vW[l] = gradW[l];
+            mB[l] = vB[l] = gradB[l];
+        }
+
+        // Per-sample activations (layer outputs) and deltas
+        std::vector<std::vector<float>> act(layerCount + 1), delta(layerCount);
+        act[0].resize(POLICY_INPUTS);
+        for (std::size_t l = 0; l < layerCount; ++l) {
+            act[l + 1].resize(model.layers[l].outputs);
+            delta[l].resize(model.layers[l].outputs);
+        }
+
+        std::vector<std::size_t> order(trainSize);
+        for (std::size_t i = 0; i < trainSize; ++i)
+            order[i] = i;
+
+        std::uint64_t rng = seed;
+        long step = 0;
+
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            for (std::size_t i = trainSize; i > 1; --i)
+                std::swap(order[i - 1], order[nextBits(rng) % i]);
+
+            double lossSum = 0.0;
+
+            for (std::size_t start = 0; start < trainSize; start += BATCH_SIZE) {
+                std::size_t end = std::min(trainSize, start + BATCH_SIZE);
+                for (std::size_t l = 0; l < layerCount; ++l) {
+                    std::fill(gradW[l].begin(), gradW[l].end(), 0.f);
+                    std::fill(gradB[l].begin(), gradB[l].end(), 0.f);
+                }
+
+                for (std::size_t n = start; n < end; ++n) {
+                    std::size_t s = order[n];
+                    std::memcpy(act[0].data(), &data.features[s * POLICY_INPUTS], POLICY_INPUTS * sizeof(float));
+
+                    // ---------- Forward ----------
+                    for (std::size_t l = 0; l < layerCount; ++l) {
+                        const PolicyLayer& layer = model.layers[l];
+                        bool last = l + 1 == layerCount;
+                        for (std::size_t j = 0; j < layer.outputs; ++j) {
+                            float sum = layer.bias[j];
+                            for (std::size_t i = 0; i < layer.inputs; ++i)
+                                sum += layer.weights[j * layer.inputs + i] * act[l][i];
+                            act[l + 1][j] = last ? sum : std::max(sum, 0.f);
+                        }
+                    }
+
+                    // ---------- Softmax cross-entropy ----------
+                    std::vector<float>& logits = act[layerCount];
+                    float maxLogit = *std::max_element(logits.begin(), logits.end());
+                    float total = 0.f;
+                    for (float z : logits)
+                        total += std::exp(z - maxLogit);
+                    for (std::size_t j = 0; j < logits.size(); ++j) {
+                        float p = std::exp(logits[j] - maxLogit) / total;
+                        delta[layerCount - 1][j] = p - (j == data.labels[s] ? 1.f : 0.f);
+                        if (j == data.labels[s])
+                            lossSum -= std::log(std::max(p, 1e-12f));
+                    }
+
+                    // ---------- Backward ----------
+                    for (std::size_t l = layerCount; l-- > 0;) {
+                        const PolicyLayer& layer = model.layers[l];
+                        for (std::size_t j = 0; j < layer.outputs; ++j) {
+                            float d = delta[l][j];
+                            gradB[l][j] += d;
+                            for (std::size_t i = 0; i < layer.inputs; ++i)
+                                gradW[l][j * layer.inputs + i] += d * act[l][i];
+                        }
+                        if (l == 0)
+                            break;
+                        for (std::size_t i = 0; i < layer.inputs; ++i) {
+                            float sum = 0.f;
+                            for (std::size_t j = 0; j < layer.outputs; ++j)
+                                sum += layer.weights[j * layer.inputs + i] * delta[l][j];
+                            delta[l - 1][i] = act[l][i] > 0.f ? sum : 0.f;
+                        }
+                    }
+                }
+
+                // ---------- Adam update ----------
+                step++;
+                float scale = 1.f / (end - start);
+                float correction1 = 1.f - std::pow(ADAM_BETA1, float(step));
+                float correction2 = 1.f - std::pow(ADAM_BETA2, float(step));
+                auto adam = [&](std::vector<float>& param, const std::vector<float>& grad,
+                                std::vector<float>& m, std::vector<float>& v) {
+                    for (std::size_t k = 0; k < param.size(); ++k) {
+                        float g = grad[k] * scale;
+                        m[k] = ADAM_BETA1 * m[k] + (1.f - ADAM_BETA1) * g;
+                        v[k] = ADAM_BETA2 * v[k] + (1.f - ADAM_BETA2) * g * g;
+                        param[k] -= LEARNING_RATE * (m[k] / correction1) /
+                                    (std::sqrt(v[k] / correction2) + ADAM_EPSILON);
+                    }
+                };
+                for (std::size_t l = 0; l < layerCount; ++l) {
+                    adam(model.layers[l].weights, gradW[l], mW[l], vW[l]);
+                    adam(model.layers[l].bias, gradB[l], mB[l], vB[l]);
+                }
+            }
+
+            if (epoch % 5 == 4 || epoch + 1 == epochs) {
+                std::printf("  epoch %3d  loss %.4f  train accuracy %.1f%%\n",
+                            epoch + 1, lossSum / trainSize,
+                            100.0 * modelAccuracy(model, data, 0, trainSize));
+            }
+        }
+    }
+
+    /*
+        Quantization ranges: largest activation of each hidden layer
+        over the training samples.
+    */
+    void calibrate(PolicyModel& model, const Dataset& data, std::size_t trainSize) {
+        std::size_t hiddenLayers = model.layers.size() - 1;
+        model.activationMax.assign(hiddenLayers, 0.f);
+
+        for (std::size_t s = 0; s < trainSize; ++s) {
+            float buffers[2][POLICY_HIDDEN];
+            const float* in = &data.features[s * POLICY_INPUTS];
+            for (std::size_t l = 0; l < hiddenLayers; ++l) {
+                const PolicyLayer& layer = model.layers[l];
+                for (std::size_t j = 0; j < layer.outputs; ++j) {
+                    float sum = layer.bias[j];
+                    for (std::size_t i = 0; i < layer.inputs; ++i)
+                        sum += layer.weights[j * layer.inputs + i] * in[i];
+                    buffers[l % 2][j] = std::max(sum, 0.f);
+                    model.activationMax[l] = std::max(model.activationMax[l], buffers[l % 2][j]);
+                }
+                in = buffers[l % 2];
+            }
+        }
+
+        for (float& range : model.activationMax) {
+            if (range <= 0.f)
+                range = 1.f;
+        }
+    }
+
+    /*
+        Average nanoseconds per decision of one kernel at one batch size.
+    */
+    double measureKernel(const PolicyModel& model, PolicyKernel kernel,
+                         const Dataset& data, std::size_t batch) {
+        PolicyNetwork network(model, kernel);
+        std::vector<PaddleAction> actions(batch);
+        std::size_t rows = data.size() / batch;
+
+        long decisions = 0;
+        auto start = std::chrono::steady_clock::now();
+        do {
+            for (std::size_t r = 0; r < rows; ++r)
+                network.infer(&data.features[r * batch * POLICY_INPUTS], batch, actions.data());
+            decisions += long(rows * batch);
+        } while (secondsSince(start) < 0.25);
+
+        return secondsSince(start) * 1e9 / decisions;
+    }
+
+    /*
+        --train-policy
+    */
+    int trainCommand(int argc, char** argv) {
+        std::string out = POLICY_WEIGHTS_PATH;
+        std::string teacher = "predict";
+        std::size_t samples = 60000;
+        int epochs = 40;
+        std::uint64_t seed = 1;
+
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string arg = argv[i];
+            if (arg == "--out") out = argv[i + 1];
+            else if (arg == "--teacher") teacher = argv[i + 1];
+            else if (arg == "--samples") samples = std::strtoul(argv[i + 1], nullptr, 10);
+            else if (arg == "--epochs") epochs = std::atoi(argv[i + 1]);
+            else if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+            else return -1;
+        }
+        if ((argc - 2) % 2 != 0 || !createController(teacher) || samples < 1000 || epochs < 1)
+            return -1;
+
+        auto start = std::chrono::steady_clock::now();
+        std::printf("Recording %zu decisions of '%s'...\n", samples, teacher.c_str());
+        Dataset data = collectDataset(teacher, samples, seed, COLLECT_EXPLORATION);
+        std::printf("  done in %.1f s\n", secondsSince(start));
+
+        std::size_t trainSize = data.size() - std::size_t(data.size() * VALIDATION_SHARE);
+        PolicyModel model = makeModel(mixSeed(seed, 7));
+
+        start = std::chrono::steady_clock::now();
+        std::printf("Training %zu-%zu-%zu-%zu MLP on %zu samples...\n",
+                    POLICY_INPUTS, POLICY_HIDDEN, POLICY_HIDDEN, POLICY_OUTPUTS, trainSize);
+        trainModel(model, data, trainSize, epochs, mixSeed(seed, 8));
+        calibrate(model, data, trainSize);
+        std::printf("  done in %.1f s, validation accuracy %.1f%%\n",
+                    secondsSince(start), 100.0 * modelAccuracy(model, data, trainSize, data.size()));
+
+        if (!model.save(out)) {
+            std::printf("Failed to write %s\n", out.c_str());
+            return 1;
+        }
+        std::printf("Weights written to %s\n", out.c_str());
+        return 0;
+    }
+
+    /*
+        --policy-check
+    */
+    int checkCommand(int argc, char** argv) {
+        std::string path = POLICY_WEIGHTS_PATH;
+        std::size_t batch = 256;
+        std::uint64_t seed = 99;
+
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string arg = argv[i];
+            if (arg == "--weights") path = argv[i + 1];
+            else if (arg == "--batch") batch = std::strtoul(argv[i + 1], nullptr, 10);
+            else if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+            else return -1;
+        }
+        if ((argc - 2) % 2 != 0 || batch < 1)
+            return -1;
+
+        PolicyModel model;
+        if (!model.load(path)) {
+            std::printf("Cannot load %s (train it with: pong --train-policy)\n", path.c_str());
+            return 1;
+        }
+
+        // ---------- Accuracy: int8 kernels vs float reference ----------
+        Dataset data = collectDataset("predict", 20000, seed, COLLECT_EXPLORATION);
+        std::vector<float> reference(data.size() * POLICY_OUTPUTS);
+        for (std::size_t s = 0; s < data.size(); ++s)
+            model.forward(&data.features[s * POLICY_INPUTS], &reference[s * POLICY_OUTPUTS]);
+
+        const PolicyKernel kernels[3] = { PolicyKernel::SCALAR, PolicyKernel::AVX2, PolicyKernel::VNNI };
+        std::vector<float> scalarLogits;
+        bool pass = true;
+
+        std::printf("Accuracy on %zu decisions (int8 vs float reference):\n", data.size());
+        for (PolicyKernel kernel : kernels) {
+            if (!PolicyNetwork::isKernelSupported(kernel)) {
+                std::printf("  %-7s not supported on this CPU\n", PolicyNetwork::kernelName(kernel));
+                continue;
+            }
+
+            PolicyNetwork network(model, kernel);
+            const float* logits = network.logits(data.features.data(), data.size());
+
+            std::size_t agree = 0;
+            float maxError = 0.f;
+            for (std::size_t s = 0; s < data.size(); ++s) {
+                const float* q = logits + s * POLICY_OUTPUTS;
+                const float* f = &reference[s * POLICY_OUTPUTS];
+                agree += argmax(q, POLICY_OUTPUTS) == argmax(f, POLICY_OUTPUTS);
+                for (std::size_t j = 0; j < POLICY_OUTPUTS; ++j)
+                    maxError = std::max(maxError, std::fabs(q[j] - f[j]));
+            }
+
+            bool identical = true;
+            if (kernel == PolicyKernel::SCALAR)
+                scalarLogits.assign(logits, logits + data.size() * POLICY_OUTPUTS);
+            else
+                identical = std::memcmp(scalarLogits.data(), logits, scalarLogits.size() * sizeof(float)) == 0;
+
+            double agreement = double(agree) / data.size();
+            pass = pass && agreement >= MIN_AGREEMENT && identical;
+            std::printf("  %-7s argmax agreement %6.2f%%   max |logit error| %.4f   %s\n",
+                        PolicyNetwork::kernelName(kernel), 100.0 * agreement, maxError,
+                        identical ? "bit-identical to scalar" : "DIFFERS FROM SCALAR");
+        }
+
+        // ---------- Throughput ----------
+        std::printf("Throughput (ns per decision):\n");
+        for (PolicyKernel kernel : kernels) {
+            if (!PolicyNetwork::isKernelSupported(kernel))
+                continue;
+            std::printf("  %-7s batch 1: %7.1f ns   batch %zu: %7.1f ns\n",
+                        PolicyNetwork::kernelName(kernel),
+                        measureKernel(model, kernel, data, 1), batch,
+                        measureKernel(model, kernel, data, batch));
+        }
+
+        // ---------- Batched matches vs chase ----------
+        std::vector<Match> matches;
+        std::vector<std::unique_ptr<PaddleController>> opponents;
+        for (std::size_t m = 0; m < batch; ++m) {
+            matches.emplace_back(GameMode::PLAYER_VS_PLAYER, mixSeed(seed, 1000 + m));
+            opponents.push_back(createController("chase"));
+        }
+
+        PolicyNetwork network(model);
+        std::vector<float> features(batch * POLICY_INPUTS);
+        std::vector<PaddleAction> actions(batch);
+        long decisions = 0;
+        double inferSeconds = 0.0;
+
+        for (long tick = 0; tick < CHECK_MAX_TICKS; ++tick) {
+            std::size_t live = 0;
+            for (std::size_t m = 0; m < batch; ++m) {
+                if (!matches[m].isFinished())
+                    policyFeatures(captureState(matches[m]), Side::RIGHT, &features[m * POLICY_INPUTS]);
+                live += !matches[m].isFinished();
+            }
+            if (live == 0)
+                break;
+
+            auto start = std::chrono::steady_clock::now();
+            network.infer(features.data(), batch, actions.data());
+            inferSeconds += secondsSince(start);
+            decisions += long(batch);
+
+            for (std::size_t m = 0; m < batch; ++m) {
+                if (matches[m].isFinished())
+                    continue;
+                MatchInput input;
+                input.left = opponents[m]->decide(matches[m], Side::LEFT, MATCH_DT);
+                input.right = actions[m];
+                matches[m].step(MATCH_DT, input);
+            }
+        }
+
+        int wins = 0, draws = 0, losses = 0;
+        for (const Match& match : matches) {
+            int margin = match.getRightScore() - match.getLeftScore();
+            wins += margin > 0 && match.isFinished();
+            losses += margin < 0 && match.isFinished();
+            draws += !match.isFinished() || margin == 0;
+        }
+
+        std::printf("%zu lockstep matches vs chase (%s kernel, batch %zu): %.1f ns per decision\n",
+                    batch, PolicyNetwork::kernelName(network.getKernel()), batch,
+                    inferSeconds * 1e9 / std::max(1L, decisions));
+        std::printf("  neural W/D/L: %d / %d / %d  (win rate %.1f%%)\n",
+                    wins, draws, losses, 100.0 * wins / batch);
+
+        std::printf(pass ? "Accuracy gate passed\n" : "Accuracy gate FAILED\n");
+        return pass ? 0 : 1;
+    }
+}
+
+
+/*
+    Function: int runPolicyCommand(int argc, char** argv)
+
+    Objective:
+        Dispatch --train-policy / --policy-check.
+
+    Input Parameters:
+        - int argc, char** argv: Process arguments (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code.
+
+    Side Effects:
+        - Runs headless matches; --train-policy writes the weights file.
+
+    Approach:
+        - Each command parses "--option value" pairs; usage on bad input.
+*/
+int runPolicyCommand(int argc, char** argv) {
+    std::string command = argv[1];
+    int result = command == "--train-policy" ? trainCommand(argc, argv) : checkCommand(argc, argv);
+
+    if (result < 0) {
+        std::cout <<
+            "Usage:\n"
+            "  pong --train-policy [--out FILE] [--teacher NAME] [--samples N]\n"
+            "                      [--epochs N] [--seed S]\n"
+            "  pong --policy-check [--weights FILE] [--batch N] [--seed S]\n";
+        return 1;
+    }
+    return result;
+}
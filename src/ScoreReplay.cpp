@@ -0,0 +1,450 @@
+#include "ScoreReplay.h"
+#include "Arena.h"
+#include "Checksum.h"
+#include "PaddleController.h"
+#include "SimState.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+const char* const SUBMISSIONS_DIR = "submissions";
+
+namespace {
+    // "PSB1" – identifies a score submission
+    const std::uint32_t SUBMISSION_MAGIC = 0x31425350u;
+
+    // Bump whenever the format changes: older submissions are then rejected
+    const std::uint16_t SUBMISSION_VERSION = 1;
+
+    ///////////////////////////////////////////////////////////
+    /// Struct: SubmissionHeader
+    /// ------------------------------------------------------
+    /// Fixed 128-byte header of a .psub file; the CRC covers
+    /// every byte after the crc field, steps included.
+    ///////////////////////////////////////////////////////////
+    struct SubmissionHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t headerSize;
+        std::uint32_t crc;
+        std::uint32_t steps;
+        std::uint64_t seed;
+        std::int64_t  timestamp;
+        std::int32_t  score;
+        std::int32_t  opponentScore;
+        std::uint32_t outcome;
+        std::uint8_t  arena;
+        std::uint8_t  reserved[3];
+        char          ai[24];
+        char          name[40];
+        std::uint8_t  padding[16];
+    };
+
+    static_assert(sizeof(SubmissionHeader) == 128, "submission header must stay 128 bytes");
+    static_assert(sizeof(SimState) == 24, "outcome CRC covers the rally state's six floats");
+
+    const std::size_t CRC_OFFSET = offsetof(SubmissionHeader, steps);
+
+    // Bytes of the replay per step: its length and its packed actions
+    const std::size_t STEP_BYTES = sizeof(float) + 1;
+
+    // Text field from a fixed, possibly unterminated array
+    std::string fixedString(const char* field, std::size_t size) {
+        return std::string(field, std::find(field, field + size, '\0'));
+    }
+
+    void copyFixed(char* field, std::size_t size, const std::string& text) {
+        std::memcpy(field, text.data(), std::min(text.size(), size - 1));
+    }
+
+    bool fail(std::string& error, const char* format, long a = 0, long b = 0, long c = 0, long d = 0) {
+        char buffer[160];
+        std::snprintf(buffer, sizeof(buffer), format, a, b, c, d);
+        error = buffer;
+        return false;
+    }
+}
+
+
+/*
+    Function: std::uint32_t matchOutcomeCrc(const Match& match)
+
+    Objective:
+        Checksum where a match stands.
+
+    Approach:
+        - Rally state (six floats) then the progress fields at fixed
+          widths, so struct padding never enters the CRC.
+*/
+std::uint32_t matchOutcomeCrc(const Match& match) {
+    SimState rally = captureState(match);
+    MatchProgress progress = match.getProgress();
+
+    std::int32_t scores[3] = { progress.leftScore, progress.rightScore, progress.lives };
+    std::int64_t tick = progress.tick;
+    std::uint64_t point = progress.point;
+
+    std::uint32_t crc = crc32(&rally, sizeof(rally));
+    crc = crc32(scores, sizeof(scores), crc);
+    crc = crc32(&tick, sizeof(tick), crc);
+    return crc32(&point, sizeof(point), crc);
+}
+
+
+/*
+    Function: void encodeSubmission(const ScoreSubmission& submission, std::vector<std::uint8_t>& out)
+
+    Objective:
+        Serialize a submission as a .psub file.
+
+    Approach:
+        - Header (zero-filled, so unused bytes are deterministic), step
+          lengths, packed actions; then the CRC over everything after
+          the CRC field.
+*/
+void encodeSubmission(const ScoreSubmission& submission, std::vector<std::uint8_t>& out) {
+    std::size_t steps = submission.dts.size();
+
+    SubmissionHeader header = {};
+    header.magic = SUBMISSION_MAGIC;
+    header.version = SUBMISSION_VERSION;
+    header.headerSize = sizeof(SubmissionHeader);
+    header.steps = static_cast<std::uint32_t>(steps);
+    header.seed = submission.seed;
+    header.timestamp = submission.timestamp;
+    header.score = submission.score;
+    header.opponentScore = submission.opponentScore;
+    header.outcome = submission.outcome;
+    header.arena = static_cast<std::uint8_t>(submission.arena);
+    copyFixed(header.ai, sizeof(header.ai), submission.ai);
+    copyFixed(header.name, sizeof(header.name), submission.name);
+
+    out.resize(sizeof(header) + steps * STEP_BYTES);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), submission.dts.data(), steps * sizeof(float));
+    std::memcpy(out.data() + sizeof(header) + steps * sizeof(float), submission.actions.data(), steps);
+
+    std::uint32_t crc = crc32(out.data() + CRC_OFFSET, out.size() - CRC_OFFSET);
+    std::memcpy(out.data() + offsetof(SubmissionHeader, crc), &crc, sizeof(crc));
+}
+
+
+/*
+    Function: bool decodeSubmission(const std::uint8_t* data, std::size_t size,
+                                    ScoreSubmission& submission, std::string& error)
+
+    Objective:
+        Parse a .psub file.
+
+    Return Value:
+        - bool: false with a reason for anything but an intact file of
+          this version.
+*/
+bool decodeSubmission(const std::uint8_t* data, std::size_t size, ScoreSubmission& submission,
+                      std::string& error) {
+    SubmissionHeader header;
+    if (size < sizeof(header))
+        return fail(error, "truncated header (%ld bytes)", static_cast<long>(size));
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != SUBMISSION_MAGIC)
+        return fail(error, "not a score submission");
+    if (header.version != SUBMISSION_VERSION || header.headerSize != sizeof(header))
+        return fail(error, "unsupported version %ld", header.version);
+    if (header.steps > MAX_REPLAY_STEPS || size != sizeof(header) + header.steps * STEP_BYTES)
+        return fail(error, "size %ld does not match %ld steps", static_cast<long>(size),
+                    static_cast<long>(header.steps));
+    if (crc32(data + CRC_OFFSET, size - CRC_OFFSET) != header.crc)
+        return fail(error, "checksum mismatch (corrupted or edited file)");
+
+    std::size_t steps = header.steps;
+    submission.seed = header.seed;
+    submission.timestamp = header.timestamp;
+    submission.arena = header.arena;
+    submission.ai = fixedString(header.ai, sizeof(header.ai));
+    submission.name = fixedString(header.name, sizeof(header.name));
+    submission.score = header.score;
+    submission.opponentScore = header.opponentScore;
+    submission.outcome = header.outcome;
+    submission.dts.resize(steps);
+    submission.actions.resize(steps);
+    std::memcpy(submission.dts.data(), data + sizeof(header), steps * sizeof(float));
+    std::memcpy(submission.actions.data(), data + sizeof(header) + steps * sizeof(float), steps);
+    return true;
+}
+
+
+/*
+    Function: bool verifySubmission(const ScoreSubmission& submission, std::string& error, long* steps)
+
+    Objective:
+        Replay a submission and check every claim it makes.
+
+    Input Parameters:
+        - const ScoreSubmission& submission: Decoded submission.
+        - std::string& error: First failure, if any.
+        - long* steps: Accumulates the steps simulated (optional).
+
+    Return Value:
+        - bool: true if the score is genuine.
+
+    Approach:
+        - The match and opponent are set up as Game::startMatch() does:
+          Match(PLAYER_VS_AI, seed, arena) and reset(mixSeed(seed, 1)),
+          the opponent created reproducible like the game's.
+        - Per step: a sane length, the game not over yet, a valid player
+          action; the opponent decides from the same state with the same
+          length and must play the recorded move (a cheaper and more
+          precise check than waiting for the outcome to differ).
+        - At the end: game over, the claimed scores, the outcome CRC.
+*/
+bool verifySubmission(const ScoreSubmission& submission, std::string& error, long* steps) {
+    if (submission.arena < 0 || submission.arena >= static_cast<int>(ARENA_PRESET_COUNT))
+        return fail(error, "unknown arena %ld", submission.arena);
+
+    std::unique_ptr<PaddleController> opponent = createController(submission.ai, true);
+    if (!opponent) {
+        error = "unknown opponent '" + submission.ai + "'";
+        return false;
+    }
+
+    std::size_t count = submission.dts.size();
+    if (count == 0 || submission.actions.size() != count)
+        return fail(error, "empty replay");
+
+    Match match(GameMode::PLAYER_VS_AI, submission.seed, *ARENA_PRESETS[submission.arena]);
+    opponent->reset(mixSeed(submission.seed, 1));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        float dt = submission.dts[i];
+        std::uint8_t packed = submission.actions[i];
+        long step = static_cast<long>(i);
+
+        if (!(dt > 0.f && dt <= MAX_REPLAY_DT)) {
+            if (steps)
+                *steps += step;
+            return fail(error, "step %ld: invalid step length", step);
+        }
+        if (match.isFinished() || (packed & 3u) > 2u || (packed >> 2) > 2u) {
+            if (steps)
+                *steps += step;
+            return fail(error, match.isFinished() ? "step %ld: the game was already over"
+                                                  : "step %ld: invalid paddle action", step);
+        }
+
+        MatchInput input;
+        input.left = static_cast<PaddleAction>(packed & 3u);
+        input.right = opponent->decide(match, Side::RIGHT, dt);
+        if (static_cast<unsigned>(input.right) != (packed >> 2u)) {
+            if (steps)
+                *steps += step;
+            return fail(error, "step %ld: the opponent plays differently (edited inputs or another build)",
+                        step);
+        }
+
+        match.step(dt, input);
+    }
+
+    if (steps)
+        *steps += static_cast<long>(count);
+
+    if (!match.isFinished())
+        return fail(error, "the game is not over after the last step");
+    if (match.getLeftScore() != submission.score || match.getRightScore() != submission.opponentScore)
+        return fail(error, "claims %ld : %ld, the replay ends %ld : %ld", submission.score,
+                    submission.opponentScore, match.getLeftScore(), match.getRightScore());
+    if (matchOutcomeCrc(match) != submission.outcome)
+        return fail(error, "final state checksum differs");
+    return true;
+}
+
+
+/*
+    Constructor: ScoreRecorder::ScoreRecorder()
+
+    Objective:
+        Reserve the longest replay up front; nothing recorded yet.
+*/
+ScoreRecorder::ScoreRecorder()
+    : valid(false),
+      seed(0),
+      arena(-1)
+{
+    dts.reserve(MAX_REPLAY_STEPS);
+    actions.reserve(MAX_REPLAY_STEPS);
+}
+
+
+void ScoreRecorder::start(const Match& match, const std::string& ai) {
+    this->ai = ai;
+    seed = match.getSeed();
+    arena = arenaPresetIndex(match.getArena());
+    dts.clear();
+    actions.clear();
+    valid = match.getMode() == GameMode::PLAYER_VS_AI && arena >= 0 && match.getTick() == 0;
+}
+
+
+/*
+    Function: void ScoreRecorder::record(const Match& match, float dt, const MatchInput& input)
+
+    Objective:
+        Append the step the match is about to take.
+
+    Approach:
+        - The match must still be the recorded one and exactly where
+          the replay ends (tick == steps recorded): anything else means
+          it was restored from elsewhere, and the replay is abandoned.
+*/
+void ScoreRecorder::record(const Match& match, float dt, const MatchInput& input) {
+    if (!valid)
+        return;
+
+    if (match.getSeed() != seed || match.getTick() != static_cast<long>(dts.size()) ||
+        dts.size() >= MAX_REPLAY_STEPS || !(dt > 0.f && dt <= MAX_REPLAY_DT)) {
+        valid = false;
+        return;
+    }
+
+    dts.push_back(dt);
+    actions.push_back(static_cast<std::uint8_t>(static_cast<unsigned>(input.left) |
+                                                static_cast<unsigned>(input.right) << 2u));
+}
+
+
+void ScoreRecorder::cancel() {
+    valid = false;
+}
+
+bool ScoreRecorder::isValid() const {
+    return valid;
+}
+
+
+bool ScoreRecorder::finish(const Match& match, const std::string& name, std::int64_t timestamp,
+                           ScoreSubmission& submission) const {
+    if (!valid || !match.isFinished() || match.getSeed() != seed ||
+        match.getTick() != static_cast<long>(dts.size()))
+        return false;
+
+    submission.seed = seed;
+    submission.timestamp = timestamp;
+    submission.arena = arena;
+    submission.ai = ai;
+    submission.name = name;
+    submission.score = match.getLeftScore();
+    submission.opponentScore = match.getRightScore();
+    submission.outcome = matchOutcomeCrc(match);
+    submission.dts = dts;
+    submission.actions = actions;
+    return true;
+}
+
+
+/*
+    Function: bool writeSubmissionFile(const std::string& directory, const ScoreSubmission& submission)
+
+    Objective:
+        Put one submission into an intake directory.
+
+    Approach:
+        - Encode → write <seed>-<time>.psub.tmp → rename to .psub, so the
+          file appears complete or not at all.
+*/
+bool writeSubmissionFile(const std::string& directory, const ScoreSubmission& submission) {
+    std::error_code ignored;
+    std::filesystem::create_directories(directory, ignored);
+
+    std::vector<std::uint8_t> bytes;
+    encodeSubmission(submission, bytes);
+
+    char file[64];
+    std::snprintf(file, sizeof(file), "/%llu-%lld.psub", static_cast<unsigned long long>(submission.seed),
+                  static_cast<long long>(submission.timestamp));
+    std::string path = directory + file;
+    std::string temporary = path + ".tmp";
+
+    std::FILE* out = std::fopen(temporary.c_str(), "wb");
+    if (!out)
+        return false;
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    written = std::fclose(out) == 0 && written;
+
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+/*
+    Constructor: SubmissionOutbox::SubmissionOutbox(const std::string& directory)
+
+    Objective:
+        Start the writer thread for an intake directory.
+*/
+SubmissionOutbox::SubmissionOutbox(const std::string& directory)
+    : directory(directory),
+      stopping(false)
+{
+    writer = std::thread(&SubmissionOutbox::writerLoop, this);
+}
+
+
+/*
+    Destructor: SubmissionOutbox::~SubmissionOutbox()
+
+    Objective:
+        Write whatever is queued, then stop the writer.
+*/
+SubmissionOutbox::~SubmissionOutbox() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+
+void SubmissionOutbox::submit(ScoreSubmission submission) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(submission));
+    }
+    wakeUp.notify_one();
+}
+
+
+/*
+    Function: void SubmissionOutbox::writerLoop()
+
+    Objective:
+        Body of the writer thread.
+
+    Approach:
+        - Take the whole queue under the lock, write it without.
+*/
+void SubmissionOutbox::writerLoop() {
+    std::vector<ScoreSubmission> batch;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return stopping || !pending.empty(); });
+            if (pending.empty())
+                return;
+            batch.swap(pending);
+        }
+
+        for (const ScoreSubmission& submission : batch)
+            if (!writeSubmissionFile(directory, submission))
+                std::cout << "Failed to write a score submission into " << directory << "\n";
+        batch.clear();
+    }
+}
@@ -0,0 +1,459 @@
+#include "ScoreVerifier.h"
+#include "Arena.h"
+#include "Leaderboard.h"
+#include "PaddleController.h"
+#include "ScoreReplay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    const char* const VERIFIED_LEADERBOARD_PATH = "verified_leaderboard.dat";
+    const std::size_t VERIFIED_LEADERBOARD_SIZE = 10;
+
+    const char* const SUBMISSION_EXTENSION = ".psub";
+
+    // Pause between two scans of the intake directory in --watch mode
+    const std::chrono::milliseconds WATCH_INTERVAL(250);
+
+    // Rejections printed per pass (all of them go to reasons.log)
+    const std::size_t REJECTIONS_SHOWN = 10;
+
+    const float MATCH_DT = 1.f / 60.f;
+
+    // Generated games: the first one ends at 2026-01-01 00:00 UTC, a minute apart
+    const std::int64_t GENERATE_START = 1767225600;
+
+    std::atomic<bool> interrupted(false);
+
+    void onSignal(int) {
+        interrupted = true;
+    }
+
+    struct VerifyOptions {
+        std::string directory = SUBMISSIONS_DIR;
+        std::string leaderboard = VERIFIED_LEADERBOARD_PATH;
+        unsigned threads = 0;
+        bool watch = false;
+        bool dryRun = false;
+    };
+
+    struct GenerateOptions {
+        std::string directory = SUBMISSIONS_DIR;
+        std::string ai = "chase";
+        std::string player = "lazy";
+        std::size_t count = 0;
+        std::size_t tampered = 0;
+        std::uint64_t seed = 1;
+        unsigned threads = 0;
+    };
+
+    // Outcome of one file, filled by a worker
+    struct Verdict {
+        bool accepted;
+        std::string reason;
+        std::uint64_t seed;
+        std::uint32_t outcome;
+        std::int32_t score;
+        std::string name;
+    };
+
+    int usage() {
+        std::cout << "Usage:\n"
+                     "  pong --verify-scores [DIR] [--threads N] [--watch] [--dry-run] [--leaderboard FILE]\n"
+                     "  pong --submissions-generate N [DIR] [--ai NAME] [--player NAME] [--tampered K]\n"
+                     "                                [--seed S] [--threads N]\n"
+                     "DIR defaults to " << SUBMISSIONS_DIR << ", FILE to " << VERIFIED_LEADERBOARD_PATH << "\n";
+        return 1;
+    }
+
+    unsigned threadCount(unsigned requested) {
+        unsigned threads = requested ? requested : std::thread::hardware_concurrency();
+        return threads ? threads : 1;
+    }
+
+    // Runs work(index) for every index below count on 'threads' threads
+    template <typename Work>
+    void forEachIndex(std::size_t count, unsigned threads, Work work) {
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < count; i = next++)
+                work(i);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads && t < count; ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    bool readFile(const std::string& path, std::vector<std::uint8_t>& bytes) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+        std::streamoff size = in.tellg();
+        if (size < 0)
+            return false;
+        bytes.resize(static_cast<std::size_t>(size));
+        in.seekg(0);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(bytes.data()), size));
+    }
+
+    // File names (not paths) with the submission extension, sorted
+    std::vector<std::string> listSubmissions(const std::string& directory) {
+        std::vector<std::string> names;
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end;
+             it.increment(error)) {
+            if (it->is_regular_file(error) && it->path().extension() == SUBMISSION_EXTENSION)
+                names.push_back(it->path().filename().string());
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    // Name of an accepted game in DIR/verified: the same game has the same one
+    std::string verifiedName(std::uint64_t seed, std::uint32_t outcome) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "%llu-%08x%s", static_cast<unsigned long long>(seed),
+                      static_cast<unsigned>(outcome), SUBMISSION_EXTENSION);
+        return name;
+    }
+
+    void moveFile(const std::string& from, const std::string& directory, const std::string& name) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        std::filesystem::rename(from, directory + "/" + name, error);
+        if (error)
+            std::cout << "Failed to move " << from << " into " << directory << ": " << error.message() << "\n";
+    }
+
+
+    /*
+        One scan of the intake directory: verify every file in parallel,
+        then settle the verdicts in name order on this thread (duplicates,
+        leaderboard, moves). Returns the number of files seen and adds the
+        rejected ones to 'rejected'.
+    */
+    std::size_t verifyPass(const VerifyOptions& options, Leaderboard* board, std::set<std::string>& accepted,
+                           std::size_t& rejected) {
+        std::vector<std::string> names = listSubmissions(options.directory);
+        if (names.empty())
+            return 0;
+
+        unsigned threads = threadCount(options.threads);
+        std::vector<Verdict> verdicts(names.size());
+        std::atomic<long long> steps(0);
+        Clock::time_point start = Clock::now();
+
+        forEachIndex(names.size(), threads, [&](std::size_t i) {
+            thread_local std::vector<std::uint8_t> bytes;
+            thread_local ScoreSubmission submission;
+
+            Verdict& verdict = verdicts[i];
+            verdict.accepted = false;
+            if (!readFile(options.directory + "/" + names[i], bytes)) {
+                verdict.reason = "unreadable";
+                return;
+            }
+            if (!decodeSubmission(bytes.data(), bytes.size(), submission, verdict.reason))
+                return;
+
+            long simulated = 0;
+            verdict.accepted = verifySubmission(submission, verdict.reason, &simulated);
+            verdict.seed = submission.seed;
+            verdict.outcome = submission.outcome;
+            verdict.score = submission.score;
+            verdict.name = submission.name;
+            steps += simulated;
+        });
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::string verifiedDir = options.directory + "/verified";
+        std::string rejectedDir = options.directory + "/rejected";
+        std::size_t acceptedCount = 0;
+        std::vector<std::size_t> rejections;
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            Verdict& verdict = verdicts[i];
+            std::string verified;
+            if (verdict.accepted) {
+                verified = verifiedName(verdict.seed, verdict.outcome);
+                if (!accepted.insert(verified).second) {
+                    verdict.accepted = false;
+                    verdict.reason = "duplicate of the verified game " + verified;
+                }
+            }
+
+            if (!verdict.accepted) {
+                rejections.push_back(i);
+                if (!options.dryRun) {
+                    std::error_code error;
+                    std::filesystem::create_directories(rejectedDir, error);
+                    std::ofstream(rejectedDir + "/reasons.log", std::ios::app)
+                        << names[i] << ": " << verdict.reason << "\n";
+                    moveFile(options.directory + "/" + names[i], rejectedDir, names[i]);
+                }
+                continue;
+            }
+
+            ++acceptedCount;
+            if (board)
+                board->submit(GameMode::PLAYER_VS_AI, verdict.score, verdict.name);
+            if (!options.dryRun)
+                moveFile(options.directory + "/" + names[i], verifiedDir, verified);
+        }
+
+        std::printf("Verified %zu submissions in %.2f s (%.0f/s, %.1f M steps/s, %u threads): "
+                    "%zu accepted, %zu rejected\n",
+                    names.size(), seconds, names.size() / std::max(seconds, 1e-9),
+                    steps / std::max(seconds, 1e-9) / 1e6, threads, acceptedCount, rejections.size());
+        for (std::size_t r = 0; r < rejections.size() && r < REJECTIONS_SHOWN; ++r)
+            std::printf("  rejected %s: %s\n", names[rejections[r]].c_str(), verdicts[rejections[r]].reason.c_str());
+        if (rejections.size() > REJECTIONS_SHOWN)
+            std::printf("  ... and %zu more\n", rejections.size() - REJECTIONS_SHOWN);
+        rejected += rejections.size();
+        return names.size();
+    }
+
+
+    /*
+        Verify the intake directory once, or keep doing so (--watch)
+        until interrupted; then print the verified leaderboard. A dry
+        run fails if any file would be rejected (a check of the replay
+        round trip).
+    */
+    int verify(const VerifyOptions& options) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(options.directory, error)) {
+            std::cout << "No submissions directory " << options.directory << "\n";
+            return 1;
+        }
+
+        // Games already verified by earlier runs
+        std::set<std::string> accepted;
+        for (const std::string& name : listSubmissions(options.directory + "/verified"))
+            accepted.insert(name);
+
+        std::unique_ptr<Leaderboard> board;
+        if (!options.dryRun)
+            board.reset(new Leaderboard(options.leaderboard, VERIFIED_LEADERBOARD_SIZE));
+
+        std::size_t rejected = 0;
+        if (options.watch) {
+            std::signal(SIGINT, onSignal);
+            std::signal(SIGTERM, onSignal);
+            std::cout << "Watching " << options.directory << " (Ctrl+C to stop)\n";
+            while (!interrupted) {
+                verifyPass(options, board.get(), accepted, rejected);
+                std::this_thread::sleep_for(WATCH_INTERVAL);
+            }
+        }
+        else if (verifyPass(options, board.get(), accepted, rejected) == 0) {
+            std::cout << "No submissions in " << options.directory << "\n";
+        }
+
+        if (board && !board->getEntries(GameMode::PLAYER_VS_AI).empty()) {
+            std::cout << "Verified leaderboard (" << options.leaderboard << "):\n";
+            int rank = 0;
+            for (const LeaderboardEntry& entry : board->getEntries(GameMode::PLAYER_VS_AI))
+                std::printf("  %2d. %-24s %6d\n", ++rank, entry.name.c_str(), entry.score);
+        }
+        return options.dryRun && rejected > 0 ? 1 : 0;
+    }
+
+
+    /*
+        Play generated game 'index' with a recorder, as the game would
+        with a player at the keys (both controllers reproducible, as the
+        game's opponent is). Returns false if it outlasted the longest
+        replay.
+    */
+    bool playGame(const GenerateOptions& options, std::size_t index, ScoreRecorder& recorder,
+                  ScoreSubmission& submission) {
+        std::uint64_t seed = mixSeed(options.seed, index);
+        std::unique_ptr<PaddleController> player = createController(options.player, true);
+        std::unique_ptr<PaddleController> opponent = createController(options.ai, true);
+        Match match(GameMode::PLAYER_VS_AI, seed, *ARENA_PRESETS[index % ARENA_PRESET_COUNT]);
+        player->reset(mixSeed(seed, 2));
+        opponent->reset(mixSeed(seed, 1));
+        recorder.start(match, options.ai);
+
+        while (!match.isFinished()) {
+            // Frame times of a real display: 60 Hz, +-25%
+            std::uint64_t noise = mixSeed(seed, 3 + static_cast<std::uint64_t>(match.getTick()));
+            float dt = MATCH_DT * (0.75f + 0.5f * static_cast<float>(noise >> 40) / 16777216.f);
+
+            MatchInput input;
+            input.left = player->decide(match, Side::LEFT, dt);
+            input.right = opponent->decide(match, Side::RIGHT, dt);
+            recorder.record(match, dt, input);
+            if (!recorder.isValid())
+                return false;
+            match.step(dt, input);
+        }
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%s-%zu", options.player.c_str(), index);
+        return recorder.finish(match, name, GENERATE_START + static_cast<std::int64_t>(index) * 60, submission);
+    }
+
+
+    /*
+        Tamper with a genuine submission in one of three ways. The first
+        two re-encode it (a valid file CRC: only replaying finds them);
+        the third damages the file itself.
+    */
+    bool writeTampered(const std::string& directory, ScoreSubmission& submission, std::size_t kind) {
+        if (kind == 0) {
+            submission.score += 10;
+            return writeSubmissionFile(directory, submission);
+        }
+
+        if (kind == 1) {
+            // Mirror the player's moves over the second half of the game
+            for (std::size_t i = submission.actions.size() / 2; i < submission.actions.size(); ++i) {
+                unsigned left = submission.actions[i] & 3u;
+                unsigned mirrored = left == 1u ? 2u : left == 2u ? 1u : left;
+                submission.actions[i] = static_cast<std::uint8_t>((submission.actions[i] & ~3u) | mirrored);
+            }
+            return writeSubmissionFile(directory, submission);
+        }
+
+        std::vector<std::uint8_t> bytes;
+        encodeSubmission(submission, bytes);
+        bytes[bytes.size() / 2] ^= 0x40;
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "/%llu-%lld-damaged%s",
+                      static_cast<unsigned long long>(submission.seed),
+                      static_cast<long long>(submission.timestamp), SUBMISSION_EXTENSION);
+        std::ofstream out(directory + name, std::ios::binary);
+        return static_cast<bool>(out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    }
+
+
+    int generate(const GenerateOptions& options) {
+        if (!createController(options.player) || !createController(options.ai)) {
+            std::cout << "Unknown controller (see --list-controllers)\n";
+            return 1;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(options.directory, error);
+
+        unsigned threads = threadCount(options.threads);
+        std::atomic<std::size_t> written(0);
+        std::atomic<std::size_t> skipped(0);
+        std::atomic<std::size_t> failed(0);
+        Clock::time_point start = Clock::now();
+
+        forEachIndex(options.count, threads, [&](std::size_t i) {
+            thread_local ScoreRecorder recorder;
+            thread_local ScoreSubmission submission;
+
+            if (!playGame(options, i, recorder, submission)) {
+                ++skipped;
+                return;
+            }
+            bool ok = i < options.tampered ? writeTampered(options.directory, submission, i % 3)
+                                           : writeSubmissionFile(options.directory, submission);
+            ++(ok ? written : failed);
+        });
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("Wrote %zu submissions (%zu tampered) into %s in %.2f s, %u threads\n",
+                    written.load(), std::min(options.tampered, options.count), options.directory.c_str(),
+                    seconds, threads);
+        if (skipped > 0)
+            std::printf("  %zu games skipped (longer than %zu steps)\n", skipped.load(), MAX_REPLAY_STEPS);
+        if (failed > 0)
+            std::printf("  %zu files could not be written\n", failed.load());
+        return failed > 0 ? 1 : 0;
+    }
+}
+
+
+/*
+    Function: int runScoreCommand(int argc, char** argv)
+
+    Objective:
+        Parse the verification and generation commands and run them.
+
+    Input Parameters:
+        - argc, argv: Full command line (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code.
+
+    Side Effects:
+        - Moves submission files, appends to the verified leaderboard,
+          or writes generated submissions.
+
+    Approach:
+        - Positional arguments (count, directory) first, then options.
+*/
+int runScoreCommand(int argc, char** argv) {
+    std::string command = argv[1];
+    bool generating = command == "--submissions-generate";
+    VerifyOptions verifyOptions;
+    GenerateOptions generateOptions;
+
+    int i = 2;
+    if (generating) {
+        if (argc < 3)
+            return usage();
+        generateOptions.count = std::strtoul(argv[i++], nullptr, 10);
+        if (generateOptions.count == 0)
+            return usage();
+    }
+    if (i < argc && argv[i][0] != '-') {
+        verifyOptions.directory = argv[i];
+        generateOptions.directory = argv[i];
+        ++i;
+    }
+
+    for (; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--threads" && hasValue) {
+            verifyOptions.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+            generateOptions.threads = verifyOptions.threads;
+        }
+        else if (!generating && arg == "--watch")
+            verifyOptions.watch = true;
+        else if (!generating && arg == "--dry-run")
+            verifyOptions.dryRun = true;
+        else if (!generating && arg == "--leaderboard" && hasValue)
+            verifyOptions.leaderboard = argv[++i];
+        else if (generating && arg == "--ai" && hasValue)
+            generateOptions.ai = argv[++i];
+        else if (generating && arg == "--player" && hasValue)
+            generateOptions.player = argv[++i];
+        else if (generating && arg == "--tampered" && hasValue)
+            generateOptions.tampered = std::strtoul(argv[++i], nullptr, 10);
+        else if (generating && arg == "--seed" && hasValue)
+            generateOptions.seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            return usage();
+    }
+
+    return generating ? generate(generateOptions) : verify(verifyOptions);
+}
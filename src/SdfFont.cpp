@@ -0,0 +1,429 @@
+#include "SdfFont.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const std::size_t GLYPH_COUNT = SDF_LAST_CHAR - SDF_FIRST_CHAR + 1;
+
+    static_assert(sizeof(SdfGlyph) == 16, "SdfGlyph is stored as-is in the atlas file");
+
+    /*
+        Edge test on the filtered distance. fwidth() is how much the
+        distance changes across one screen pixel, so the edge is about
+        one pixel wide whatever the scale.
+    */
+    const char* const FRAGMENT_SHADER =
+        "uniform sampler2D texture;\n"
+        "void main() {\n"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;\n"
+        "    float width = max(fwidth(distance) * 0.7, 0.001);\n"
+        "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+
+    const SdfGlyph EMPTY_GLYPH = { 0.f, 0, 0, 0, 0, 0, 0 };
+
+    template <typename T>
+    bool readValue(std::FILE* file, T& value) {
+        return std::fread(&value, sizeof value, 1, file) == 1;
+    }
+
+    /*
+        Distance byte → coverage for drawing without the shader: a
+        one atlas-pixel ramp centered on the outline.
+    */
+    std::uint8_t coverage(std::uint8_t distance) {
+        float pixels = (distance - 128.f) * SDF_SPREAD / 127.f;
+        float alpha = std::min(std::max(pixels + 0.5f, 0.f), 1.f);
+        return static_cast<std::uint8_t>(alpha * 255.f + 0.5f);
+    }
+}
+
+
+/*
+    Constructor: SdfFont::SdfFont()
+
+    Objective:
+        Empty font (draws nothing until loadFromFile succeeds).
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - None (constructor)
+
+    Side Effects:
+        - None
+
+    Approach:
+        - Shader support is only checked when an atlas is loaded.
+*/
+SdfFont::SdfFont()
+    : lineSpacing(0.f),
+      useShader(false)
+{
+}
+
+
+/*
+    Function: bool SdfFont::loadFromFile(const std::string& path, bool upload)
+
+    Objective:
+        Load the build-time glyph atlas.
+
+    Input Parameters:
+        - const std::string& path: SDF1 atlas file.
+        - bool upload: Create the texture and shader (false: memory only).
+
+    Return Value:
+        - bool: false if the file is missing, truncated or does not
+          match the SDF_* constants.
+
+    Side Effects:
+        - Replaces the glyph table, the distances, texture and shader.
+
+    Approach:
+        - Check magic and header against the SDF_* constants, read
+          the glyph table and the distances (kept for CPU rendering).
+        - Upload the distances as the alpha of a white RGBA texture
+          (smooth, so the shader sees interpolated distances).
+        - Without shader support store coverage instead.
+*/
+bool SdfFont::loadFromFile(const std::string& path, bool upload) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    char magic[4];
+    std::uint32_t emSize = 0, spread = 0, width = 0, height = 0, count = 0;
+    float spacing = 0.f;
+    bool ok = std::fread(magic, 1, 4, file) == 4 &&
+              std::memcmp(magic, SDF_FILE_MAGIC, 4) == 0 &&
+              readValue(file, emSize) && emSize == SDF_EM_SIZE &&
+              readValue(file, spread) && spread == SDF_SPREAD &&
+              readValue(file, width) && width == SDF_ATLAS_WIDTH &&
+              readValue(file, height) && height > 0 && height <= 4096 &&
+              readValue(file, count) && count == GLYPH_COUNT &&
+              readValue(file, spacing);
+
+    std::vector<SdfGlyph> table(GLYPH_COUNT);
+    std::vector<std::uint8_t> distances;
+    if (ok) {
+        distances.resize(std::size_t(width) * height);
+        ok = std::fread(table.data(), sizeof(SdfGlyph), table.size(), file) == table.size() &&
+             std::fread(distances.data(), 1, distances.size(), file) == distances.size();
+    }
+    std::fclose(file);
+
+    for (std::size_t i = 0; ok && i < table.size(); ++i) {
+        const SdfGlyph& glyph = table[i];
+        ok = std::size_t(glyph.x) + glyph.width <= width &&
+             std::size_t(glyph.y) + glyph.height <= height;
+    }
+    if (!ok)
+        return false;
+
+    if (!upload) {
+        useShader = false;
+        glyphs.swap(table);
+        this->distances.swap(distances);
+        lineSpacing = spacing;
+        return true;
+    }
+
+    useShader = sf::Shader::isAvailable() &&
+                shader.loadFromMemory(FRAGMENT_SHADER, sf::Shader::Fragment);
+    if (useShader)
+        shader.setUniform("texture", sf::Shader::CurrentTexture);
+
+    std::vector<sf::Uint8> pixels(distances.size() * 4, 255);
+    for (std::size_t i = 0; i < distances.size(); ++i)
+        pixels[i * 4 + 3] = useShader ? distances[i] : coverage(distances[i]);
+
+    sf::Image image;
+    image.create(width, height, pixels.data());
+    if (!texture.loadFromImage(image))
+        return false;
+    texture.setSmooth(true);
+
+    glyphs.swap(table);
+    this->distances.swap(distances);
+    lineSpacing = spacing;
+    return true;
+}
+
+
+/*
+    Function: const SdfGlyph& SdfFont::getGlyph(char32_t character) const
+
+    Objective:
+        Look up a character's glyph.
+
+    Input Parameters:
+        - char32_t character: Character to draw.
+
+    Return Value:
+        - const SdfGlyph&: The glyph, '?' if the atlas has no such
+          character, an empty glyph if no atlas is loaded.
+
+    Side Effects:
+        - None
+
+    Approach:
+        - The table is indexed by character - SDF_FIRST_CHAR.
+*/
+const SdfGlyph& SdfFont::getGlyph(char32_t character) const {
+    if (glyphs.empty())
+        return EMPTY_GLYPH;
+    if (character < SDF_FIRST_CHAR || character > SDF_LAST_CHAR)
+        character = U'?';
+    return glyphs[character - SDF_FIRST_CHAR];
+}
+
+
+float SdfFont::getLineSpacing() const {
+    return lineSpacing;
+}
+
+
+const std::uint8_t* SdfFont::getDistances() const {
+    return distances.empty() ? nullptr : distances.data();
+}
+
+
+unsigned SdfFont::getAtlasHeight() const {
+    return static_cast<unsigned>(distances.size() / SDF_ATLAS_WIDTH);
+}
+
+
+const sf::Texture& SdfFont::getTexture() const {
+    return texture;
+}
+
+
+const sf::Shader* SdfFont::getShader() const {
+    return useShader ? &shader : nullptr;
+}
+
+
+/*
+    Constructor: SdfText::SdfText()
+
+    Objective:
+        Empty white text, 30 pixels, no font (sf::Text defaults).
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - None (constructor)
+
+    Side Effects:
+        - None
+*/
+SdfText::SdfText()
+    : font(nullptr),
+      characterSize(30),
+      fillColor(sf::Color::White)
+{
+}
+
+
+void SdfText::setFont(const SdfFont& newFont) {
+    font = &newFont;
+    rebuild();
+}
+
+
+/*
+    Function: void SdfText::setString(std::string_view newString)
+
+    Objective:
+        Change the text.
+
+    Input Parameters:
+        - std::string_view newString: New text (any string type, e.g. a
+          frame-arena std::pmr::string).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Copies the text and lays it out again, unless it is unchanged.
+
+    Approach:
+        - The copy and the vertices reuse their capacity, so once a text
+          has held its longest string, changing it allocates nothing.
+*/
+void SdfText::setString(std::string_view newString) {
+    if (newString == string)
+        return;
+    string.assign(newString.data(), newString.size());
+    rebuild();
+}
+
+
+void SdfText::setCharacterSize(unsigned size) {
+    characterSize = size;
+    rebuild();
+}
+
+
+/*
+    Function: void SdfText::setFillColor(const sf::Color& color)
+
+    Objective:
+        Change the text colour.
+
+    Input Parameters:
+        - const sf::Color& color: New colour.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Recolours the vertices.
+
+    Approach:
+        - The layout does not depend on the colour, so only the
+          vertex colours change.
+*/
+void SdfText::setFillColor(const sf::Color& color) {
+    fillColor = color;
+    for (sf::Vertex& vertex : vertices)
+        vertex.color = color;
+}
+
+
+const std::string& SdfText::getString() const {
+    return string;
+}
+
+
+const std::vector<sf::Vertex>& SdfText::getVertices() const {
+    return vertices;
+}
+
+
+sf::FloatRect SdfText::getLocalBounds() const {
+    return bounds;
+}
+
+
+sf::FloatRect SdfText::getGlobalBounds() const {
+    return getTransform().transformRect(bounds);
+}
+
+
+/*
+    Function: void SdfText::rebuild()
+
+    Objective:
+        Lay the string out as textured quads.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Replaces vertices and bounds.
+
+    Approach:
+        - Scale atlas pixels by characterSize / SDF_EM_SIZE.
+        - Pen starts at (0, characterSize) on the first baseline;
+          '\n' moves it down one line spacing.
+        - Two triangles per glyph with a cell; blank glyphs only
+          advance the pen.
+        - Bounds cover the cells minus their SDF_SPREAD margins.
+*/
+void SdfText::rebuild() {
+    vertices.clear();
+    bounds = sf::FloatRect();
+    if (!font)
+        return;
+
+    const float scale = static_cast<float>(characterSize) / SDF_EM_SIZE;
+    const float margin = SDF_SPREAD * scale;
+    float penX = 0.f;
+    float penY = static_cast<float>(characterSize);
+    float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+    bool empty = true;
+
+    for (char c : string) {
+        if (c == '\n') {
+            penX = 0.f;
+            penY += font->getLineSpacing() * scale;
+            continue;
+        }
+
+        const SdfGlyph& glyph = font->getGlyph(static_cast<unsigned char>(c));
+        if (glyph.width > 0 && glyph.height > 0) {
+            float left = penX + glyph.left * scale;
+            float top = penY + glyph.top * scale;
+            float right = left + glyph.width * scale;
+            float bottom = top + glyph.height * scale;
+
+            float u0 = glyph.x, v0 = glyph.y;
+            float u1 = u0 + glyph.width, v1 = v0 + glyph.height;
+
+            vertices.emplace_back(sf::Vector2f(left, top), fillColor, sf::Vector2f(u0, v0));
+            vertices.emplace_back(sf::Vector2f(right, top), fillColor, sf::Vector2f(u1, v0));
+            vertices.emplace_back(sf::Vector2f(left, bottom), fillColor, sf::Vector2f(u0, v1));
+            vertices.emplace_back(sf::Vector2f(left, bottom), fillColor, sf::Vector2f(u0, v1));
+            vertices.emplace_back(sf::Vector2f(right, top), fillColor, sf::Vector2f(u1, v0));
+            vertices.emplace_back(sf::Vector2f(right, bottom), fillColor, sf::Vector2f(u1, v1));
+
+            if (empty) {
+                minX = left + margin;
+                minY = top + margin;
+                maxX = right - margin;
+                maxY = bottom - margin;
+                empty = false;
+            }
+            else {
+                minX = std::min(minX, left + margin);
+                minY = std::min(minY, top + margin);
+                maxX = std::max(maxX, right - margin);
+                maxY = std::max(maxY, bottom - margin);
+            }
+        }
+        penX += glyph.advance * scale;
+    }
+
+    if (!empty)
+        bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+
+/*
+    Function: void SdfText::draw(sf::RenderTarget& target, sf::RenderStates states) const
+
+    Objective:
+        Draw the text.
+
+    Input Parameters:
+        - sf::RenderTarget& target: Window or render texture.
+        - sf::RenderStates states: Parent states.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - One draw call.
+
+    Approach:
+        - Apply the text's transform, bind the font's texture and
+          shader, draw every quad at once.
+*/
+void SdfText::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (vertices.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = &font->getTexture();
+    states.shader = font->getShader();
+    target.draw(vertices.data(), vertices.size(), sf::Triangles, states);
+}
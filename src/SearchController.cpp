@@ -0,0 +1,364 @@
+#include "SearchController.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    // Search shape: steps per macro action, maximum macro depth, beam width
+    const int MACRO_STEPS = 3;
+    const int MAX_DEPTH   = 10;
+    const std::size_t BEAM_WIDTH = 64;
+
+    const PaddleAction ACTIONS[3] = { PaddleAction::STAY, PaddleAction::UP, PaddleAction::DOWN };
+
+    // Offset from the paddle center that still hits, as a fraction of the
+    // paddle height (45 px on a 100 px paddle)
+    const float PADDLE_SAFE_REACH = 0.45f;
+
+    // Evaluation weights
+    const float TERMINAL_SCORE  = 1e6f;
+    const float TERMINAL_DEPTH  = 1e3f;      // Prefer conceding later / scoring sooner
+    const float MISS_WEIGHT     = 1e3f;
+    const float CENTER_WEIGHT   = 0.1f;
+
+    /*
+        Baseline chase AI applied to a SimState (opponent model).
+    */
+    PaddleAction chase(const SimState& state, Side side, const Arena& arena) {
+        float ballCenterY = state.ballY + arena.ballSize / 2.f;
+        float center = paddleCenterY(state, side, arena);
+        if (ballCenterY > center)
+            return PaddleAction::DOWN;
+        if (ballCenterY < center)
+            return PaddleAction::UP;
+        return PaddleAction::STAY;
+    }
+
+    /*
+        Hold one action for a macro step; the opponent chases.
+        'step' is the arena's specialized kernel, nullptr for the
+        runtime one. Returns the MatchEvent flags raised.
+    */
+    unsigned simulateMacro(SimState& state, PaddleAction action, Side side, float dt,
+                           const Arena& arena, SimStepFunction step) {
+        Side opponent = side == Side::LEFT ? Side::RIGHT : Side::LEFT;
+        unsigned events = 0;
+
+        for (int i = 0; i < MACRO_STEPS && !(events & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED)); ++i) {
+            MatchInput input;
+            if (side == Side::LEFT) {
+                input.left = action;
+                input.right = chase(state, opponent, arena);
+            }
+            else {
+                input.left = chase(state, opponent, arena);
+                input.right = action;
+            }
+            events |= step ? step(state, input, dt) : stepSimState(state, input, dt, arena);
+        }
+        return events;
+    }
+
+    bool betterNode(const SearchNode& a, const SearchNode& b) {
+        return a.score > b.score;
+    }
+}
+
+
+/*
+    NodeArena members
+
+    Objective:
+        Fixed pool of search nodes handed out by bumping an index.
+*/
+NodeArena::NodeArena(std::size_t capacity)
+    : nodes(capacity),
+      used(0)
+{
+}
+
+SearchNode* NodeArena::allocate() {
+    if (used == nodes.size())
+        return nullptr;
+    return &nodes[used++];
+}
+
+void NodeArena::reset() {
+    used = 0;
+}
+
+SearchNode* NodeArena::at(std::size_t index) {
+    return &nodes[index];
+}
+
+std::size_t NodeArena::size() const {
+    return used;
+}
+
+std::size_t NodeArena::capacity() const {
+    return nodes.size();
+}
+
+
+/*
+    Constructor: SearchController::SearchController(double budgetSeconds)
+
+    Objective:
+        Create the controller and its node arena.
+
+    Input Parameters:
+        - double budgetSeconds: Wall-clock time allowed per decision (0: none).
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Allocates room for a full-depth search (~80 KB).
+
+    Approach:
+        - Each layer holds at most 3 children per beam node.
+*/
+SearchController::SearchController(double budgetSeconds)
+    : arena(MAX_DEPTH * 3 * BEAM_WIDTH),
+      budgetSeconds(budgetSeconds)
+{
+}
+
+
+/*
+    Function: PaddleAction SearchController::decide(const Match& match, Side side, float dt)
+
+    Objective:
+        Pick the first action of the best action sequence found in time.
+
+    Input Parameters:
+        - const Match& match: Current match.
+        - Side side: Paddle being controlled.
+        - float dt: Step length used for the forward simulation.
+
+    Return Value:
+        - PaddleAction: First action of the best sequence.
+
+    Side Effects:
+        - Reuses the node arena; updates this controller's statistics.
+
+    Approach:
+        - Layer 1: the three actions from the current state.
+        - Each further layer: keep the BEAM_WIDTH best open nodes of the
+          previous layer, extend each by every action (terminal nodes are
+          carried over unchanged), score the children.
+        - After each layer, remember the first action of its best node;
+          stop at MAX_DEPTH, on a full arena or when the budget (if any)
+          is spent.
+        - Ties keep the earlier action (STAY first), avoiding jitter.
+        - The simulation kernel is chosen once: the one compiled for the
+          match's preset arena, else the runtime kernel.
+*/
+PaddleAction SearchController::decide(const Match& match, Side side, float dt) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+
+    const Arena& field = match.getArena();
+    const SimStepFunction step = presetSimStep(field);
+    const SimState root = captureState(match);
+    const unsigned conceded = side == Side::LEFT ? MatchEvent::RIGHT_SCORED : MatchEvent::LEFT_SCORED;
+    const unsigned won      = side == Side::LEFT ? MatchEvent::LEFT_SCORED : MatchEvent::RIGHT_SCORED;
+
+    arena.reset();
+
+    // ---------- Layer 1 ----------
+    std::size_t layerBegin = 0;
+    for (PaddleAction action : ACTIONS) {
+        SearchNode* node = arena.allocate();
+        node->state = root;
+        node->firstAction = action;
+        unsigned events = simulateMacro(node->state, action, side, dt, field, step);
+        node->terminal = (events & (conceded | won)) != 0;
+        if (events & conceded)
+            node->score = -TERMINAL_SCORE + TERMINAL_DEPTH;
+        else if (events & won)
+            node->score = TERMINAL_SCORE - TERMINAL_DEPTH;
+        else
+            node->score = evaluate(node->state, side, field);
+    }
+    std::size_t layerEnd = arena.size();
+
+    PaddleAction bestAction = std::min_element(arena.at(0), arena.at(0) + layerEnd, betterNode)->firstAction;
+    int depth = 1;
+    bool timedOut = false;
+
+    // ---------- Deeper layers (beam search, anytime) ----------
+    while (depth < MAX_DEPTH) {
+        if (budgetSeconds > 0.0 &&
+            std::chrono::duration<double>(Clock::now() - start).count() > budgetSeconds) {
+            timedOut = true;
+            break;
+        }
+
+        // Beam: best BEAM_WIDTH nodes of the layer move to its front
+        SearchNode* first = arena.at(layerBegin);
+        SearchNode* last = arena.at(0) + layerEnd;
+        std::size_t keep = std::min<std::size_t>(BEAM_WIDTH, layerEnd - layerBegin);
+        std::nth_element(first, first + (keep - 1), last, betterNode);
+
+        std::size_t childBegin = arena.size();
+        float depthPenalty = TERMINAL_DEPTH * (depth + 1);
+        bool full = false;
+
+        for (std::size_t p = 0; p < keep && !full; ++p) {
+            const SearchNode parent = first[p];
+
+            if (parent.terminal) {
+                SearchNode* copy = arena.allocate();
+                if (!copy) { full = true; break; }
+                *copy = parent;
+                continue;
+            }
+
+            for (PaddleAction action : ACTIONS) {
+                SearchNode* child = arena.allocate();
+                if (!child) { full = true; break; }
+
+                child->state = parent.state;
+                child->firstAction = parent.firstAction;
+                unsigned events = simulateMacro(child->state, action, side, dt, field, step);
+                child->terminal = (events & (conceded | won)) != 0;
+                if (events & conceded)
+                    child->score = -TERMINAL_SCORE + depthPenalty;
+                else if (events & won)
+                    child->score = TERMINAL_SCORE - depthPenalty;
+                else
+                    child->score = evaluate(child->state, side, field);
+            }
+        }
+
+        if (full)
+            break;
+
+        layerBegin = childBegin;
+        layerEnd = arena.size();
+        depth++;
+
+        // Best node of the finished layer; ties resolve to the earliest node
+        SearchNode* best = arena.at(layerBegin);
+        for (std::size_t i = layerBegin + 1; i < layerEnd; ++i) {
+            if (arena.at(i)->score > best->score)
+                best = arena.at(i);
+        }
+        bestAction = best->firstAction;
+    }
+
+    // ---------- Statistics ----------
+    unsigned long long nanos = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    statistics.nodes += arena.size();
+    statistics.nanos += nanos;
+    statistics.decisions += 1;
+    statistics.depth += depth;
+    if (timedOut)
+        statistics.timeCutoffs += 1;
+
+    return bestAction;
+}
+
+
+/*
+    Function: std::string SearchController::getReport() const
+
+    Objective:
+        Summarize this controller's search statistics.
+
+    Return Value:
+        - std::string: search mode (time budget or full depth), nodes/s,
+          nodes and depth per decision, time cutoffs; empty if no decision
+          was made yet.
+*/
+std::string SearchController::getReport() const {
+    const SearchStatistics& s = statistics;
+    if (s.decisions == 0)
+        return "";
+
+    char mode[64];
+    if (budgetSeconds > 0.0)
+        std::snprintf(mode, sizeof mode, "%.1f ms budget", budgetSeconds * 1e3);
+    else
+        std::snprintf(mode, sizeof mode, "rated at full depth (no time budget)");   // Stronger than live play
+
+    double seconds = s.nanos / 1e9;
+    char line[200];
+    std::snprintf(line, sizeof line,
+                  "%s; %.2f M nodes/s, %.0f nodes/decision, depth %.1f, %llu time cutoffs in %llu decisions",
+                  mode, seconds > 0 ? s.nodes / seconds / 1e6 : 0.0,
+                  double(s.nodes) / s.decisions,
+                  double(s.depth) / s.decisions,
+                  s.timeCutoffs, s.decisions);
+    return line;
+}
+
+
+/*
+    Function: void SearchController::addStatistics(const PaddleController& other)
+
+    Objective:
+        Fold another search controller's totals into this one's.
+*/
+void SearchController::addStatistics(const PaddleController& other) {
+    const SearchController* search = dynamic_cast<const SearchController*>(&other);
+    if (!search)
+        return;
+
+    statistics.nodes += search->statistics.nodes;
+    statistics.nanos += search->statistics.nanos;
+    statistics.decisions += search->statistics.decisions;
+    statistics.depth += search->statistics.depth;
+    statistics.timeCutoffs += search->statistics.timeCutoffs;
+}
+
+
+/*
+    Function: float SearchController::evaluate(const SimState& state, Side side, const Arena& arena)
+
+    Objective:
+        Score a leaf where no point has been scored yet.
+
+    Input Parameters:
+        - const SimState& state: Leaf state.
+        - Side side: Our paddle.
+        - const Arena& arena: Geometry of the match.
+
+    Return Value:
+        - float: Higher is better.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Ball moving away: drift back toward the arena center.
+        - Ball approaching: predict the intercept height at our paddle face
+          (wall bounces unfolded as a triangle wave), then penalize heavily
+          the distance the paddle cannot cover in time, lightly the rest.
+*/
+float SearchController::evaluate(const SimState& state, Side side, const Arena& arena) {
+    float center = paddleCenterY(state, side, arena);
+    bool towardUs = side == Side::RIGHT ? state.ballVX > 0.f : state.ballVX < 0.f;
+
+    if (!towardUs || state.ballVX == 0.f)
+        return -CENTER_WEIGHT * std::fabs(center - arena.height / 2.f);
+
+    // Ball left edge touching our paddle face
+    float faceX = side == Side::RIGHT ? arena.rightPaddleX() - arena.ballSize
+                                      : arena.leftPaddleX() + arena.paddleWidth;
+    float t = std::fabs((faceX - state.ballX) / state.ballVX);
+
+    float range = arena.ballMaxY();
+    float y = std::fmod(state.ballY + state.ballVY * t, 2.f * range);
+    if (y < 0.f)
+        y += 2.f * range;
+    if (y > range)
+        y = 2.f * range - y;
+
+    float gap = std::fabs(y + arena.ballSize / 2.f - center);
+    float miss = std::max(0.f, gap - PADDLE_SAFE_REACH * arena.paddleHeight - arena.paddleSpeed * t);
+    return -MISS_WEIGHT * miss - gap;
+}
@@ -0,0 +1,367 @@
+#include "SessionFile.h"
+#include "Checksum.h"
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    // "PSS1" – identifies a session record
+    const std::uint32_t SESSION_MAGIC = 0x31535350u;
+
+    // Bump whenever SessionRecord changes: older files are then ignored
+    const std::uint16_t SESSION_VERSION = 1;
+
+    // SessionRecord::arena of a custom (non-preset) arena
+    const std::uint8_t CUSTOM_ARENA = 0xFF;
+
+    const std::size_t SLOT_COUNT = 2;
+
+    // While the session changes, msync at most this often
+    const std::chrono::seconds FLUSH_INTERVAL(1);
+
+    ///////////////////////////////////////////////////////////
+    /// Struct: SessionRecord
+    /// ------------------------------------------------------
+    /// Fixed 80-byte record, one per slot. The CRC covers
+    /// every byte after the crc field; of two valid records
+    /// the higher sequence is the newer.
+    ///////////////////////////////////////////////////////////
+    struct SessionRecord {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t size;
+        std::uint32_t crc;
+        std::uint32_t sequence;
+        std::uint64_t seed;
+        std::uint64_t point;
+        std::int64_t  tick;
+        std::int32_t  leftScore;
+        std::int32_t  rightScore;
+        std::int32_t  lives;
+        std::uint8_t  mode;
+        std::uint8_t  active;        // 0 = no match in progress
+        std::uint8_t  arena;         // ARENA_PRESETS index (0 = classic)
+        std::uint8_t  reserved;
+        float         ballX, ballY;
+        float         ballVX, ballVY;
+        float         leftY, rightY;
+    };
+
+    static_assert(sizeof(SessionRecord) == 80, "session record must stay 80 bytes");
+
+    const std::size_t CRC_OFFSET = offsetof(SessionRecord, sequence);
+    const std::size_t FILE_BYTES = SLOT_COUNT * sizeof(SessionRecord);
+
+    bool isValid(const SessionRecord& record) {
+        return record.magic == SESSION_MAGIC &&
+               record.version == SESSION_VERSION &&
+               record.size == sizeof(SessionRecord) &&
+               record.mode <= static_cast<std::uint8_t>(GameMode::PLAYER_VS_PLAYER) &&
+               record.crc == crc32(reinterpret_cast<const unsigned char*>(&record) + CRC_OFFSET,
+                                   sizeof(SessionRecord) - CRC_OFFSET);
+    }
+}
+
+
+/*
+    Constructor: SessionFile::SessionFile(const std::string& path)
+
+    Objective:
+        Map the session file and start the flusher thread.
+
+    Input Parameters:
+        - const std::string& path: Session file ("" = none).
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Creates the file if needed; resets one of the wrong size.
+        - Starts the flusher thread when the file is mapped.
+
+    Approach:
+        - A file of exactly FILE_BYTES is mapped as is. Otherwise it is
+          truncated and rewritten with zeros (invalid slots): writing
+          the bytes allocates the disk blocks up front, so a store into
+          the mapping can never fault on a full disk.
+        - On any failure keep running without a session file.
+*/
+SessionFile::SessionFile(const std::string& path)
+    : fd(-1),
+      map(nullptr),
+      sequence(0),
+      written(0),
+      stopping(false)
+{
+#ifndef _WIN32
+    if (path.empty())
+        return;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cout << "Failed to open session file " << path << "\n";
+        return;
+    }
+
+    struct stat info;
+    bool sized = fstat(fd, &info) == 0 && std::size_t(info.st_size) == FILE_BYTES;
+    if (!sized) {
+        unsigned char zeros[FILE_BYTES] = {};
+        sized = ftruncate(fd, 0) == 0 &&
+                pwrite(fd, zeros, FILE_BYTES, 0) == static_cast<ssize_t>(FILE_BYTES);
+    }
+
+    void* mapping = sized ? mmap(nullptr, FILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+    if (mapping == MAP_FAILED) {
+        std::cout << "Failed to map session file " << path << "\n";
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    map = static_cast<unsigned char*>(mapping);
+    flusher = std::thread(&SessionFile::flushLoop, this);
+#else
+    (void)path;
+#endif
+}
+
+
+/*
+    Destructor: SessionFile::~SessionFile()
+
+    Objective:
+        Stop the flusher and release the mapping.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - None
+
+    Side Effects:
+        - Blocks for one msync of the (single-page) mapping.
+
+    Approach:
+        - Set the stop flag, wake the flusher, join it, then sync the
+          last record, unmap and close.
+*/
+SessionFile::~SessionFile() {
+    if (!map)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    flusher.join();
+
+#ifndef _WIN32
+    msync(map, FILE_BYTES, MS_SYNC);
+    munmap(map, FILE_BYTES);
+    ::close(fd);
+#endif
+}
+
+
+/*
+    Function: bool SessionFile::load(SavedSession& session)
+
+    Objective:
+        Read back the match that was in progress, if any.
+
+    Input Parameters:
+        - SavedSession& session: Filled on success.
+
+    Return Value:
+        - bool: true if a match was in progress.
+
+    Side Effects:
+        - Continues the sequence after the newest record, so the next
+          save() overwrites the older slot.
+
+    Approach:
+        - Validate both slots in place; keep the valid one with the
+          higher sequence (serial-number comparison, so wrap-around
+          after 2^32 frames is harmless).
+*/
+bool SessionFile::load(SavedSession& session) {
+    if (!map)
+        return false;
+
+    const SessionRecord* newest = nullptr;
+    for (std::size_t slot = 0; slot < SLOT_COUNT; ++slot) {
+        const SessionRecord* record = reinterpret_cast<const SessionRecord*>(map + slot * sizeof(SessionRecord));
+        if (!isValid(*record))
+            continue;
+        if (!newest || std::int32_t(record->sequence - newest->sequence) > 0)
+            newest = record;
+    }
+
+    if (!newest)
+        return false;
+
+    sequence = newest->sequence;
+    written.store(sequence);
+
+    if (!newest->active)
+        return false;
+
+    session.mode = static_cast<GameMode>(newest->mode);
+    session.seed = newest->seed;
+    session.arena = newest->arena == CUSTOM_ARENA ? -1 : newest->arena;
+    session.rally.ballX = newest->ballX;
+    session.rally.ballY = newest->ballY;
+    session.rally.ballVX = newest->ballVX;
+    session.rally.ballVY = newest->ballVY;
+    session.rally.leftY = newest->leftY;
+    session.rally.rightY = newest->rightY;
+    session.progress.leftScore = newest->leftScore;
+    session.progress.rightScore = newest->rightScore;
+    session.progress.lives = newest->lives;
+    session.progress.tick = static_cast<long>(newest->tick);
+    session.progress.point = newest->point;
+    return true;
+}
+
+
+/*
+    Functions: save / clear
+
+    Objective:
+        Mirror the match in progress, or record that there is none.
+
+    Input Parameters:
+        - const Match& match: Match to mirror (save only).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Overwrites the older slot of the mapping.
+*/
+void SessionFile::save(const Match& match) {
+    write(&match);
+}
+
+void SessionFile::clear() {
+    write(nullptr);
+}
+
+bool SessionFile::isOpen() const {
+    return map != nullptr;
+}
+
+
+/*
+    Function: void SessionFile::write(const Match* match)
+
+    Objective:
+        Write one record (the game thread's per-frame cost).
+
+    Input Parameters:
+        - const Match* match: Match in progress, nullptr for none.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Stores 80 bytes into the mapping; publishes the sequence.
+
+    Approach:
+        - Build the record on the stack, CRC it, copy it into slot
+          sequence % SLOT_COUNT (never the slot holding the newest
+          record), then publish the sequence with a release store.
+*/
+void SessionFile::write(const Match* match) {
+    if (!map)
+        return;
+
+    SessionRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.magic = SESSION_MAGIC;
+    record.version = SESSION_VERSION;
+    record.size = sizeof(SessionRecord);
+    record.sequence = ++sequence;
+
+    if (match) {
+        SimState rally = captureState(*match);
+        MatchProgress progress = match->getProgress();
+
+        record.seed = match->getSeed();
+        record.point = progress.point;
+        record.tick = progress.tick;
+        record.leftScore = progress.leftScore;
+        record.rightScore = progress.rightScore;
+        record.lives = progress.lives;
+        record.mode = static_cast<std::uint8_t>(match->getMode());
+        record.active = 1;
+        int preset = arenaPresetIndex(match->getArena());
+        record.arena = preset < 0 ? CUSTOM_ARENA : static_cast<std::uint8_t>(preset);
+        record.ballX = rally.ballX;
+        record.ballY = rally.ballY;
+        record.ballVX = rally.ballVX;
+        record.ballVY = rally.ballVY;
+        record.leftY = rally.leftY;
+        record.rightY = rally.rightY;
+    }
+
+    record.crc = crc32(reinterpret_cast<const unsigned char*>(&record) + CRC_OFFSET,
+                       sizeof(record) - CRC_OFFSET);
+
+    std::memcpy(map + (sequence % SLOT_COUNT) * sizeof(SessionRecord), &record, sizeof(record));
+    written.store(sequence, std::memory_order_release);
+}
+
+
+/*
+    Function: void SessionFile::flushLoop()
+
+    Objective:
+        Bound what a power cut can lose.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - msync()s the mapping at most once per FLUSH_INTERVAL.
+
+    Approach:
+        - Wake every interval (or on shutdown); sync only if a record was
+          written since the last sync. A record being written during the
+          sync may reach the disk torn, but the other slot was complete
+          and is synced in the same page, so the file always holds at
+          least one valid record.
+*/
+void SessionFile::flushLoop() {
+    std::uint32_t flushed = written.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopping) {
+        wakeUp.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping; });
+
+        std::uint32_t current = written.load(std::memory_order_acquire);
+        if (current == flushed || stopping)
+            continue;
+
+        lock.unlock();
+#ifndef _WIN32
+        msync(map, FILE_BYTES, MS_SYNC);
+#endif
+        flushed = current;
+        lock.lock();
+    }
+}
@@ -0,0 +1,318 @@
+#include "SimState.h"
+
+namespace {
+    static_assert(ARENA_PRESET_COUNT == 4, "instantiate the kernels below for every preset");
+
+    ///////////////////////////////////////////////////////////
+    /// Geometry sources of the kernels: a preset fixed at
+    /// compile time (every field a constant after inlining)
+    /// or any arena read through a reference at run time.
+    ///////////////////////////////////////////////////////////
+    template <const Arena& A>
+    struct FixedArena {
+        static constexpr const Arena& get() { return A; }
+    };
+
+    struct RuntimeArena {
+        const Arena& arena;
+        const Arena& get() const { return arena; }
+    };
+
+    /*
+        Match::resetRound(): serve 'point' from the arena center.
+    */
+    template <class Geometry>
+    void serve(SimMatch& match, const Geometry& geometry) {
+        const Arena& arena = geometry.get();
+        sf::Vector2f velocity = serveVelocity(match.seed, match.point, arena);
+        match.state.ballX  = arena.serveX();
+        match.state.ballY  = arena.serveY();
+        match.state.ballVX = velocity.x;
+        match.state.ballVY = velocity.y;
+        match.point++;
+    }
+
+    /*
+        Paddle movement on its top edge: UP only while the top is below
+        the top wall, DOWN only while the bottom is above the floor (a
+        step may overshoot slightly, as the original paddle did).
+    */
+    inline void applyAction(float& paddleY, PaddleAction action, float dt, const Arena& arena) {
+        if (action == PaddleAction::UP) {
+            if (paddleY > 0)
+                paddleY += -arena.paddleSpeed * dt;
+        }
+        else if (action == PaddleAction::DOWN) {
+            if (paddleY + arena.paddleHeight < arena.height)
+                paddleY += arena.paddleSpeed * dt;
+        }
+    }
+
+    /*
+        sf::FloatRect::intersects() of the ball box with a paddle box
+        (strict overlap, as SFML computes it).
+    */
+    inline bool ballTouchesPaddle(const SimState& s, float paddleX, float paddleY, const Arena& arena) {
+        return s.ballX < paddleX + arena.paddleWidth && paddleX < s.ballX + arena.ballSize &&
+               s.ballY < paddleY + arena.paddleHeight && paddleY < s.ballY + arena.ballSize;
+    }
+
+    /*
+        The rules kernel behind every form of stepSimState() (see there).
+    */
+    template <class Geometry>
+    inline unsigned stepRally(SimState& state, const MatchInput& input, float dt, const Geometry& geometry) {
+        const Arena& arena = geometry.get();
+        unsigned events = 0;
+
+        applyAction(state.leftY, input.left, dt, arena);
+        applyAction(state.rightY, input.right, dt, arena);
+
+        state.ballX += state.ballVX * dt;
+        state.ballY += state.ballVY * dt;
+        if (state.ballY <= 0 || state.ballY >= arena.ballMaxY()) {
+            state.ballVY = -state.ballVY;
+            events |= MatchEvent::WALL_BOUNCE;
+        }
+
+        if (ballTouchesPaddle(state, arena.leftPaddleX(), state.leftY, arena)) {
+            state.ballVX = -state.ballVX;
+            events |= MatchEvent::LEFT_HIT;
+        }
+        if (ballTouchesPaddle(state, arena.rightPaddleX(), state.rightY, arena)) {
+            state.ballVX = -state.ballVX;
+            events |= MatchEvent::RIGHT_HIT;
+        }
+
+        if (state.ballX + arena.ballSize < 0)
+            events |= MatchEvent::RIGHT_SCORED;
+        if (state.ballX > arena.width)
+            events |= MatchEvent::LEFT_SCORED;
+
+        return events;
+    }
+
+    /*
+        The match kernels behind startSimMatch() / stepSimMatch().
+    */
+    template <class Geometry>
+    SimMatch startMatch(std::uint64_t seed, const Geometry& geometry) {
+        SimMatch match = {};
+        match.seed = seed;
+        match.state.leftY = geometry.get().paddleStartY();
+        match.state.rightY = geometry.get().paddleStartY();
+        serve(match, geometry);
+        return match;
+    }
+
+    template <class Geometry>
+    unsigned stepMatch(SimMatch& match, const MatchInput& input, float dt, const Geometry& geometry) {
+        if (match.finished)
+            return 0;
+
+        match.tick++;
+        unsigned events = stepRally(match.state, input, dt, geometry);
+
+        if (events & MatchEvent::RIGHT_SCORED) {
+            match.rightScore++;
+            serve(match, geometry);
+        }
+        else if (events & MatchEvent::LEFT_SCORED) {
+            match.leftScore++;
+            serve(match, geometry);
+        }
+
+        int target = geometry.get().targetScore;
+        match.finished = match.leftScore >= target || match.rightScore >= target;
+        if (match.finished)
+            events |= MatchEvent::GAME_OVER;
+        return events;
+    }
+}
+
+
+/*
+    Function: SimState captureState(const Match& match)
+
+    Objective:
+        Extract the rally state of a match.
+
+    Input Parameters:
+        - const Match& match: Match to copy from.
+
+    Return Value:
+        - SimState: Ball box corner and velocity, paddle tops.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Read the bounds and velocity accessors.
+*/
+SimState captureState(const Match& match) {
+    sf::FloatRect ball = match.getBallBounds();
+    sf::Vector2f velocity = match.getBallVelocity();
+
+    SimState state;
+    state.ballX  = ball.left;
+    state.ballY  = ball.top;
+    state.ballVX = velocity.x;
+    state.ballVY = velocity.y;
+    state.leftY  = match.getPaddleBounds(Side::LEFT).top;
+    state.rightY = match.getPaddleBounds(Side::RIGHT).top;
+    return state;
+}
+
+
+/*
+    Function: unsigned stepSimState(SimState& state, const MatchInput& input, float dt[, const Arena& arena])
+
+    Objective:
+        One step of Match rules on a plain state.
+
+    Input Parameters:
+        - SimState& state: State to advance.
+        - const MatchInput& input: Paddle actions.
+        - float dt: Time step in seconds.
+        - const Arena& arena: Geometry (runtime form; the template
+          form takes it as the parameter A).
+
+    Return Value:
+        - unsigned: MatchEvent flags raised during the step.
+
+    Side Effects:
+        - Modifies state.
+
+    Approach:
+        - Match::step() runs this kernel for its rally: paddles → ball +
+          wall bounce → left then right paddle bounce → scoring test.
+          No re-serve.
+        - One kernel (stepRally) for both forms: FixedArena<A> makes every
+          geometry read a compile-time constant, RuntimeArena a load.
+*/
+template <const Arena& A>
+unsigned stepSimState(SimState& state, const MatchInput& input, float dt) {
+    return stepRally(state, input, dt, FixedArena<A>());
+}
+
+template unsigned stepSimState<CLASSIC_ARENA>(SimState&, const MatchInput&, float);
+template unsigned stepSimState<WIDE_ARENA>(SimState&, const MatchInput&, float);
+template unsigned stepSimState<TINY_ARENA>(SimState&, const MatchInput&, float);
+template unsigned stepSimState<TOURNAMENT_ARENA>(SimState&, const MatchInput&, float);
+
+unsigned stepSimState(SimState& state, const MatchInput& input, float dt, const Arena& arena) {
+    return stepRally(state, input, dt, RuntimeArena{ arena });
+}
+
+
+/*
+    Function: SimStepFunction presetSimStep(const Arena& arena)
+
+    Objective:
+        The specialized kernel of a preset arena.
+
+    Input Parameters:
+        - const Arena& arena: Arena about to be simulated.
+
+    Return Value:
+        - SimStepFunction: stepSimState<preset>, or nullptr for a custom arena.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Look the arena up among the presets (by value) and index a table
+          in ARENA_PRESETS order.
+*/
+SimStepFunction presetSimStep(const Arena& arena) {
+    static const SimStepFunction KERNELS[ARENA_PRESET_COUNT] = {
+        &stepSimState<CLASSIC_ARENA>, &stepSimState<WIDE_ARENA>,
+        &stepSimState<TINY_ARENA>, &stepSimState<TOURNAMENT_ARENA>
+    };
+
+    int index = arenaPresetIndex(arena);
+    return index < 0 ? nullptr : KERNELS[index];
+}
+
+
+/*
+    Function: float paddleCenterY(const SimState& state, Side side, const Arena& arena)
+
+    Objective:
+        Center height of a paddle.
+*/
+float paddleCenterY(const SimState& state, Side side, const Arena& arena) {
+    return (side == Side::LEFT ? state.leftY : state.rightY) + arena.paddleHeight / 2.f;
+}
+
+
+/*
+    Function: SimMatch startSimMatch(std::uint64_t seed[, const Arena& arena])
+
+    Objective:
+        Start a PLAYER_VS_PLAYER match.
+
+    Input Parameters:
+        - std::uint64_t seed: Match seed.
+        - const Arena& arena: Geometry and rules (runtime form).
+
+    Return Value:
+        - SimMatch: Paddles at their start, scores zero, first ball served.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Same start positions as the Match constructor, then serve point 0.
+*/
+template <const Arena& A>
+SimMatch startSimMatch(std::uint64_t seed) {
+    return startMatch(seed, FixedArena<A>());
+}
+
+template SimMatch startSimMatch<CLASSIC_ARENA>(std::uint64_t);
+template SimMatch startSimMatch<WIDE_ARENA>(std::uint64_t);
+template SimMatch startSimMatch<TINY_ARENA>(std::uint64_t);
+template SimMatch startSimMatch<TOURNAMENT_ARENA>(std::uint64_t);
+
+SimMatch startSimMatch(std::uint64_t seed, const Arena& arena) {
+    return startMatch(seed, RuntimeArena{ arena });
+}
+
+
+/*
+    Function: unsigned stepSimMatch(SimMatch& match, const MatchInput& input, float dt[, const Arena& arena])
+
+    Objective:
+        One step of PLAYER_VS_PLAYER rules.
+
+    Input Parameters:
+        - SimMatch& match: Match to advance.
+        - const MatchInput& input: Paddle actions.
+        - float dt: Time step in seconds.
+        - const Arena& arena: Geometry and rules (runtime form).
+
+    Return Value:
+        - unsigned: MatchEvent flags raised during the step.
+
+    Side Effects:
+        - Modifies the match.
+
+    Approach:
+        - stepSimState(), then as in Match::step(): a scored point raises
+          the scorer's score and re-serves; the match ends when either
+          side reaches the arena's targetScore.
+*/
+template <const Arena& A>
+unsigned stepSimMatch(SimMatch& match, const MatchInput& input, float dt) {
+    return stepMatch(match, input, dt, FixedArena<A>());
+}
+
+template unsigned stepSimMatch<CLASSIC_ARENA>(SimMatch&, const MatchInput&, float);
+template unsigned stepSimMatch<WIDE_ARENA>(SimMatch&, const MatchInput&, float);
+template unsigned stepSimMatch<TINY_ARENA>(SimMatch&, const MatchInput&, float);
+template unsigned stepSimMatch<TOURNAMENT_ARENA>(SimMatch&, const MatchInput&, float);
+
+unsigned stepSimMatch(SimMatch& match, const MatchInput& input, float dt, const Arena& arena) {
+    return stepMatch(match, input, dt, RuntimeArena{ arena });
+}
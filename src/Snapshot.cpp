@@ -0,0 +1,614 @@
+#include "Snapshot.h"
+#include <cmath>
+
+namespace {
+    // Field widths of the keyframe encoding
+    const int TICK_BITS     = 32;
+    const int POSITION_BITS = 10;
+    const int VELOCITY_BITS = 12;
+    const int SCORE_BITS    = 8;
+    const int LIVES_BITS    = 3;
+    const int STATE_BITS    = 2;
+    const int ACTION_BITS   = 2;
+    const int AGE_BITS      = 5;     // log2(SNAPSHOT_HISTORY)
+    const int BASELINE_BITS = 8;     // Low tick bits naming a delta's baseline
+
+    const int POSITION_MAX = (1 << POSITION_BITS) - 1;
+    const int VELOCITY_MIN = -(1 << (VELOCITY_BITS - 1));
+    const int VELOCITY_MAX = (1 << (VELOCITY_BITS - 1)) - 1;
+    const int LIVES_MAX    = (1 << LIVES_BITS) - 1;
+
+    // Residual classes of a delta field:
+    // '0' exact | '10' tiny | '110' small | '1110' medium | '1111' raw value
+    const int TINY_BITS   = 2;
+    const int SMALL_BITS  = 5;
+    const int MEDIUM_BITS = 8;
+
+    // stepSimState() bounce lines of the ball's top edge (pixels + bias)
+    const int BALL_MIN_Y = SNAPSHOT_POSITION_BIAS;
+    const int BALL_MAX_Y = SNAPSHOT_POSITION_BIAS + static_cast<int>(CLASSIC_ARENA.ballMaxY());
+
+    // Paddle travel per tick at SNAPSHOT_TICK_RATE (300 pixels/second)
+    const int PADDLE_STEP = static_cast<int>(CLASSIC_ARENA.paddleSpeed) / SNAPSHOT_TICK_RATE;
+
+    // Baseline age: '0' + 3 bits (0..7) | '1' + AGE_BITS (0..31)
+    const int SHORT_AGE_BITS = 3;
+
+    static_assert(SNAPSHOT_HISTORY == 1u << AGE_BITS, "age field must span the whole history");
+    static_assert(BASELINE_BITS >= AGE_BITS, "baseline field must include the slot");
+
+    /*
+        Appends bit fields, least significant bit first.
+    */
+    class BitWriter {
+    private:
+        std::uint8_t* out;
+        std::size_t size;
+        std::uint64_t pending;
+        int pendingBits;
+
+    public:
+        explicit BitWriter(std::uint8_t* out) : out(out), size(0), pending(0), pendingBits(0) {}
+
+        void write(std::uint32_t value, int bits) {
+            pending |= static_cast<std::uint64_t>(value & static_cast<std::uint32_t>((1ull << bits) - 1)) << pendingBits;
+            pendingBits += bits;
+            while (pendingBits >= 8) {
+                out[size++] = static_cast<std::uint8_t>(pending);
+                pending >>= 8;
+                pendingBits -= 8;
+            }
+        }
+
+        // Pads the last byte with zeros; returns the bytes written
+        std::size_t finish() {
+            if (pendingBits > 0)
+                out[size++] = static_cast<std::uint8_t>(pending);
+            pending = 0;
+            pendingBits = 0;
+            return size;
+        }
+    };
+
+    /*
+        Reads BitWriter fields; reading past the end sets failed() and
+        returns zeros.
+    */
+    class BitReader {
+    private:
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t next;
+        std::uint64_t pending;
+        int pendingBits;
+        bool overrun;
+
+    public:
+        BitReader(const std::uint8_t* data, std::size_t size)
+            : data(data), size(size), next(0), pending(0), pendingBits(0), overrun(false) {}
+
+        std::uint32_t read(int bits) {
+            while (pendingBits < bits) {
+                if (next == size) {
+                    overrun = true;
+                    return 0;
+                }
+                pending |= static_cast<std::uint64_t>(data[next++]) << pendingBits;
+                pendingBits += 8;
+            }
+            std::uint32_t value = static_cast<std::uint32_t>(pending & ((1ull << bits) - 1));
+            pending >>= bits;
+            pendingBits -= bits;
+            return value;
+        }
+
+        bool failed() const {
+            return overrun;
+        }
+    };
+
+    std::uint32_t zigzag(int value) {
+        return value >= 0 ? static_cast<std::uint32_t>(value) * 2u
+                          : static_cast<std::uint32_t>(-value) * 2u - 1u;
+    }
+
+    int unzigzag(std::uint32_t value) {
+        return (value & 1u) ? -static_cast<int>((value + 1u) / 2u) : static_cast<int>(value / 2u);
+    }
+
+    int signExtend(std::uint32_t raw, int bits) {
+        return (raw & (1u << (bits - 1))) ? static_cast<int>(raw) - (1 << bits) : static_cast<int>(raw);
+    }
+
+    int clampInt(long value, int low, int high) {
+        return static_cast<int>(value < low ? low : (value > high ? high : value));
+    }
+
+    std::uint16_t quantizePosition(float value) {
+        return static_cast<std::uint16_t>(clampInt(std::lround(value) + SNAPSHOT_POSITION_BIAS, 0, POSITION_MAX));
+    }
+
+    std::int16_t quantizeVelocity(float value) {
+        return static_cast<std::int16_t>(clampInt(std::lround(value), VELOCITY_MIN, VELOCITY_MAX));
+    }
+
+    /*
+        Where the ball should be 'age' ticks after the baseline:
+        velocity × age / SNAPSHOT_TICK_RATE, rounded half away from
+        zero in integers so both ends agree exactly.
+    */
+    int predictPosition(int position, int velocity, std::uint32_t age) {
+        int travel = velocity * static_cast<int>(age);
+        int half = SNAPSHOT_TICK_RATE / 2;
+        int offset = travel >= 0 ? (travel + half) / SNAPSHOT_TICK_RATE
+                                 : -((-travel + half) / SNAPSHOT_TICK_RATE);
+        return position + offset;
+    }
+
+    /*
+        predictPosition() for the ball's height, mirrored at the walls it
+        bounces off.
+    */
+    int predictBallY(int position, int velocity, std::uint32_t age) {
+        int predicted = predictPosition(position, velocity, age);
+        if (predicted < BALL_MIN_Y)
+            return 2 * BALL_MIN_Y - predicted;
+        if (predicted > BALL_MAX_Y)
+            return 2 * BALL_MAX_Y - predicted;
+        return predicted;
+    }
+
+    /*
+        Where a paddle should be 'age' ticks after the baseline if it
+        kept doing the same action.
+    */
+    int predictPaddle(int position, std::uint8_t action, std::uint32_t age) {
+        int step = static_cast<int>(age) * PADDLE_STEP;
+        if (action == static_cast<std::uint8_t>(PaddleAction::UP))
+            return position - step;
+        if (action == static_cast<std::uint8_t>(PaddleAction::DOWN))
+            return position + step;
+        return position;
+    }
+
+    /*
+        One delta position: the residual from 'predicted' in the
+        shortest class, or the raw value ('rawBits' wide).
+    */
+    void writeField(BitWriter& writer, int value, int predicted, int rawBits) {
+        int residual = value - predicted;
+        if (residual == 0) {
+            writer.write(0u, 1);
+        }
+        else if (residual >= -(1 << (TINY_BITS - 1)) && residual < (1 << (TINY_BITS - 1))) {
+            writer.write(1u, 2);                         // '10' (LSB first)
+            writer.write(zigzag(residual), TINY_BITS);
+        }
+        else if (residual >= -(1 << (SMALL_BITS - 1)) && residual < (1 << (SMALL_BITS - 1))) {
+            writer.write(3u, 3);                         // '110'
+            writer.write(zigzag(residual), SMALL_BITS);
+        }
+        else if (residual >= -(1 << (MEDIUM_BITS - 1)) && residual < (1 << (MEDIUM_BITS - 1))) {
+            writer.write(7u, 4);                         // '1110'
+            writer.write(zigzag(residual), MEDIUM_BITS);
+        }
+        else {
+            writer.write(15u, 4);                        // '1111'
+            writer.write(static_cast<std::uint32_t>(value), rawBits);
+        }
+    }
+
+    /*
+        Inverse of writeField(); the result is range-checked by the
+        caller.
+    */
+    int readField(BitReader& reader, int predicted, int rawBits) {
+        if (reader.read(1) == 0)
+            return predicted;
+        if (reader.read(1) == 0)
+            return predicted + unzigzag(reader.read(TINY_BITS));
+        if (reader.read(1) == 0)
+            return predicted + unzigzag(reader.read(SMALL_BITS));
+        if (reader.read(1) == 0)
+            return predicted + unzigzag(reader.read(MEDIUM_BITS));
+
+        return static_cast<int>(reader.read(rawBits));
+    }
+
+    /*
+        Velocity field: '0' unchanged | '10' negated (a bounce) | '11' raw.
+    */
+    void writeVelocity(BitWriter& writer, int value, int baseline) {
+        if (value == baseline) {
+            writer.write(0u, 1);
+        }
+        else if (value == -baseline) {
+            writer.write(1u, 2);                         // '10'
+        }
+        else {
+            writer.write(3u, 2);                         // '11'
+            writer.write(static_cast<std::uint32_t>(value), VELOCITY_BITS);
+        }
+    }
+
+    int readVelocity(BitReader& reader, int baseline) {
+        if (reader.read(1) == 0)
+            return baseline;
+        if (reader.read(1) == 0)
+            return -baseline;
+        return signExtend(reader.read(VELOCITY_BITS), VELOCITY_BITS);
+    }
+
+    void writeMeta(BitWriter& writer, const Snapshot& snapshot) {
+        writer.write(snapshot.leftScore, SCORE_BITS);
+        writer.write(snapshot.rightScore, SCORE_BITS);
+        writer.write(snapshot.lives, LIVES_BITS);
+        writer.write(snapshot.gameState, STATE_BITS);
+    }
+
+    void readMeta(BitReader& reader, Snapshot& snapshot) {
+        snapshot.leftScore  = static_cast<std::uint8_t>(reader.read(SCORE_BITS));
+        snapshot.rightScore = static_cast<std::uint8_t>(reader.read(SCORE_BITS));
+        snapshot.lives      = static_cast<std::uint8_t>(reader.read(LIVES_BITS));
+        snapshot.gameState  = static_cast<std::uint8_t>(reader.read(STATE_BITS));
+    }
+
+    bool validEnums(const Snapshot& snapshot) {
+        const std::uint8_t last = static_cast<std::uint8_t>(PaddleAction::DOWN);
+        return snapshot.leftAction <= last && snapshot.rightAction <= last &&
+               snapshot.gameState <= static_cast<std::uint8_t>(GameState::GAME_OVER);
+    }
+
+    /*
+        Changed scores/lives/state in a delta: scores '0' same | '10' +1 |
+        '11' raw, lives and state '0' same | '1' raw.
+    */
+    void writeMetaDelta(BitWriter& writer, const Snapshot& snapshot, const Snapshot& baseline) {
+        const std::uint8_t scores[2] = { snapshot.leftScore, snapshot.rightScore };
+        const std::uint8_t before[2] = { baseline.leftScore, baseline.rightScore };
+        for (int i = 0; i < 2; ++i) {
+            if (scores[i] == before[i]) {
+                writer.write(0u, 1);
+            }
+            else if (scores[i] == before[i] + 1) {
+                writer.write(1u, 2);                     // '10'
+            }
+            else {
+                writer.write(3u, 2);                     // '11'
+                writer.write(scores[i], SCORE_BITS);
+            }
+        }
+
+        writer.write(snapshot.lives != baseline.lives, 1);
+        if (snapshot.lives != baseline.lives)
+            writer.write(snapshot.lives, LIVES_BITS);
+        writer.write(snapshot.gameState != baseline.gameState, 1);
+        if (snapshot.gameState != baseline.gameState)
+            writer.write(snapshot.gameState, STATE_BITS);
+    }
+
+    void readMetaDelta(BitReader& reader, Snapshot& snapshot, const Snapshot& baseline) {
+        std::uint8_t* scores[2] = { &snapshot.leftScore, &snapshot.rightScore };
+        const std::uint8_t before[2] = { baseline.leftScore, baseline.rightScore };
+        for (int i = 0; i < 2; ++i) {
+            if (reader.read(1) == 0)
+                *scores[i] = before[i];
+            else if (reader.read(1) == 0)
+                *scores[i] = static_cast<std::uint8_t>(before[i] + 1);
+            else
+                *scores[i] = static_cast<std::uint8_t>(reader.read(SCORE_BITS));
+        }
+
+        snapshot.lives = reader.read(1) ? static_cast<std::uint8_t>(reader.read(LIVES_BITS)) : baseline.lives;
+        snapshot.gameState = reader.read(1) ? static_cast<std::uint8_t>(reader.read(STATE_BITS)) : baseline.gameState;
+    }
+
+    bool sameMeta(const Snapshot& a, const Snapshot& b) {
+        return a.leftScore == b.leftScore && a.rightScore == b.rightScore &&
+               a.lives == b.lives && a.gameState == b.gameState;
+    }
+
+    bool validPosition(int value) {
+        return value >= 0 && value <= POSITION_MAX;
+    }
+
+    bool validVelocity(int value) {
+        return value >= VELOCITY_MIN && value <= VELOCITY_MAX;
+    }
+}
+
+
+bool operator==(const Snapshot& a, const Snapshot& b) {
+    return a.tick == b.tick && a.ballX == b.ballX && a.ballY == b.ballY &&
+           a.ballVX == b.ballVX && a.ballVY == b.ballVY &&
+           a.leftY == b.leftY && a.rightY == b.rightY &&
+           a.leftAction == b.leftAction && a.rightAction == b.rightAction && sameMeta(a, b);
+}
+
+
+bool operator!=(const Snapshot& a, const Snapshot& b) {
+    return !(a == b);
+}
+
+
+/*
+    Function: Snapshot makeSnapshot(std::uint32_t tick, const SimState& state,
+                                    const MatchInput& input, int leftScore, int rightScore, int lives,
+                                    GameState gameState)
+
+    Objective:
+        Quantize a match state for the wire.
+
+    Input Parameters:
+        - std::uint32_t tick: Simulation step of the state.
+        - const SimState& state: Ball and paddles.
+        - const MatchInput& input: Actions of the step that led to state.
+        - int leftScore, int rightScore, int lives: Match counters.
+        - GameState gameState: Game phase.
+
+    Return Value:
+        - Snapshot: Rounded to whole pixels and pixels/second, clamped to
+          the field ranges.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Round to nearest, add the position bias, clamp.
+*/
+Snapshot makeSnapshot(std::uint32_t tick, const SimState& state, const MatchInput& input,
+                      int leftScore, int rightScore, int lives, GameState gameState) {
+    Snapshot snapshot;
+    snapshot.tick       = tick;
+    snapshot.ballX      = quantizePosition(state.ballX);
+    snapshot.ballY      = quantizePosition(state.ballY);
+    snapshot.ballVX     = quantizeVelocity(state.ballVX);
+    snapshot.ballVY     = quantizeVelocity(state.ballVY);
+    snapshot.leftY      = quantizePosition(state.leftY);
+    snapshot.rightY     = quantizePosition(state.rightY);
+    snapshot.leftAction = static_cast<std::uint8_t>(input.left);
+    snapshot.rightAction = static_cast<std::uint8_t>(input.right);
+    snapshot.leftScore  = static_cast<std::uint8_t>(clampInt(leftScore, 0, 255));
+    snapshot.rightScore = static_cast<std::uint8_t>(clampInt(rightScore, 0, 255));
+    snapshot.lives      = static_cast<std::uint8_t>(clampInt(lives, 0, LIVES_MAX));
+    snapshot.gameState  = static_cast<std::uint8_t>(gameState);
+    return snapshot;
+}
+
+
+/*
+    Function: SimState snapshotState(const Snapshot& snapshot)
+
+    Objective:
+        Dequantize the rally state.
+
+    Input Parameters:
+        - const Snapshot& snapshot: Received snapshot.
+
+    Return Value:
+        - SimState: Positions and velocity in floats.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Remove the position bias.
+*/
+SimState snapshotState(const Snapshot& snapshot) {
+    SimState state;
+    state.ballX  = static_cast<float>(snapshot.ballX - SNAPSHOT_POSITION_BIAS);
+    state.ballY  = static_cast<float>(snapshot.ballY - SNAPSHOT_POSITION_BIAS);
+    state.ballVX = static_cast<float>(snapshot.ballVX);
+    state.ballVY = static_cast<float>(snapshot.ballVY);
+    state.leftY  = static_cast<float>(snapshot.leftY - SNAPSHOT_POSITION_BIAS);
+    state.rightY = static_cast<float>(snapshot.rightY - SNAPSHOT_POSITION_BIAS);
+    return state;
+}
+
+
+SnapshotHistory::SnapshotHistory() {
+    clear();
+}
+
+
+void SnapshotHistory::clear() {
+    for (std::uint32_t i = 0; i < SNAPSHOT_HISTORY; ++i)
+        used[i] = false;
+}
+
+
+void SnapshotHistory::store(const Snapshot& snapshot) {
+    std::uint32_t index = snapshot.tick % SNAPSHOT_HISTORY;
+    slots[index] = snapshot;
+    used[index] = true;
+}
+
+
+const Snapshot* SnapshotHistory::find(std::uint32_t tick) const {
+    const Snapshot* found = slot(tick);
+    return found && found->tick == tick ? found : nullptr;
+}
+
+
+const Snapshot* SnapshotHistory::slot(std::uint32_t tick) const {
+    std::uint32_t index = tick % SNAPSHOT_HISTORY;
+    return used[index] ? &slots[index] : nullptr;
+}
+
+
+/*
+    Function: std::size_t encodeSnapshot(const Snapshot& snapshot,
+                                         const Snapshot* baseline,
+                                         std::uint8_t* out)
+
+    Objective:
+        Bit-pack a snapshot, delta-coded against an acknowledged one.
+
+    Input Parameters:
+        - const Snapshot& snapshot: Snapshot to send.
+        - const Snapshot* baseline: Newest snapshot the receiver has
+          acknowledged (nullptr = none).
+        - std::uint8_t* out: Output (SNAPSHOT_MAX_BYTES).
+
+    Return Value:
+        - std::size_t: Encoded size in bytes.
+
+    Side Effects:
+        - Writes to out.
+
+    Approach:
+        - Bit 0: 0 = keyframe (tick and every field at full width),
+          1 = delta.
+        - Delta: low 8 bits of the baseline tick (its history slot plus
+          a check that the slot still holds it, so a delta delayed past
+          the history is rejected rather than decoded against a newer
+          snapshot), age (ticks since the baseline), then the
+          ball predicted by dead reckoning from the baseline, the
+          paddles by repeating their baseline action, the velocity
+          unchanged or negated (a bounce); positions are coded as
+          their residual. The actions and the scores/lives/state group
+          take one bit each when unchanged.
+*/
+std::size_t encodeSnapshot(const Snapshot& snapshot, const Snapshot* baseline, std::uint8_t* out) {
+    BitWriter writer(out);
+    std::uint32_t age = baseline ? snapshot.tick - baseline->tick : 0;
+
+    if (!baseline || age >= SNAPSHOT_HISTORY) {
+        writer.write(0u, 1);
+        writer.write(snapshot.tick, TICK_BITS);
+        writer.write(snapshot.ballX, POSITION_BITS);
+        writer.write(snapshot.ballY, POSITION_BITS);
+        writer.write(static_cast<std::uint16_t>(snapshot.ballVX), VELOCITY_BITS);
+        writer.write(static_cast<std::uint16_t>(snapshot.ballVY), VELOCITY_BITS);
+        writer.write(snapshot.leftY, POSITION_BITS);
+        writer.write(snapshot.rightY, POSITION_BITS);
+        writer.write(snapshot.leftAction, ACTION_BITS);
+        writer.write(snapshot.rightAction, ACTION_BITS);
+        writeMeta(writer, snapshot);
+        return writer.finish();
+    }
+
+    writer.write(1u, 1);
+    writer.write(baseline->tick, BASELINE_BITS);
+    if (age < (1u << SHORT_AGE_BITS)) {
+        writer.write(0u, 1);
+        writer.write(age, SHORT_AGE_BITS);
+    }
+    else {
+        writer.write(1u, 1);
+        writer.write(age, AGE_BITS);
+    }
+
+    writeField(writer, snapshot.ballX, predictPosition(baseline->ballX, baseline->ballVX, age), POSITION_BITS);
+    writeField(writer, snapshot.ballY, predictBallY(baseline->ballY, baseline->ballVY, age), POSITION_BITS);
+    writeVelocity(writer, snapshot.ballVX, baseline->ballVX);
+    writeVelocity(writer, snapshot.ballVY, baseline->ballVY);
+    writeField(writer, snapshot.leftY, predictPaddle(baseline->leftY, baseline->leftAction, age), POSITION_BITS);
+    writeField(writer, snapshot.rightY, predictPaddle(baseline->rightY, baseline->rightAction, age), POSITION_BITS);
+
+    if (snapshot.leftAction == baseline->leftAction && snapshot.rightAction == baseline->rightAction) {
+        writer.write(0u, 1);
+    }
+    else {
+        writer.write(1u, 1);
+        writer.write(snapshot.leftAction, ACTION_BITS);
+        writer.write(snapshot.rightAction, ACTION_BITS);
+    }
+
+    if (sameMeta(snapshot, *baseline)) {
+        writer.write(0u, 1);
+    }
+    else {
+        writer.write(1u, 1);
+        writeMetaDelta(writer, snapshot, *baseline);
+    }
+    return writer.finish();
+}
+
+
+/*
+    Function: bool decodeSnapshot(const std::uint8_t* data, std::size_t size,
+                                  const SnapshotHistory& history,
+                                  Snapshot& snapshot)
+
+    Objective:
+        Decode a keyframe or a delta.
+
+    Input Parameters:
+        - const std::uint8_t* data, std::size_t size: Encoded snapshot.
+        - const SnapshotHistory& history: Snapshots decoded so far.
+        - Snapshot& snapshot: Output.
+
+    Return Value:
+        - bool: True if the encoding is complete and valid.
+
+    Side Effects:
+        - Writes to snapshot (also on failure).
+
+    Approach:
+        - Mirror encodeSnapshot() with the same predictions; reject
+          reads past the end, fields out of range and missing or
+          replaced baselines, so arbitrary bytes are safe to decode.
+*/
+bool decodeSnapshot(const std::uint8_t* data, std::size_t size,
+                    const SnapshotHistory& history, Snapshot& snapshot) {
+    BitReader reader(data, size);
+
+    if (reader.read(1) == 0) {
+        snapshot.tick   = reader.read(TICK_BITS);
+        snapshot.ballX  = static_cast<std::uint16_t>(reader.read(POSITION_BITS));
+        snapshot.ballY  = static_cast<std::uint16_t>(reader.read(POSITION_BITS));
+        snapshot.ballVX = static_cast<std::int16_t>(signExtend(reader.read(VELOCITY_BITS), VELOCITY_BITS));
+        snapshot.ballVY = static_cast<std::int16_t>(signExtend(reader.read(VELOCITY_BITS), VELOCITY_BITS));
+        snapshot.leftY  = static_cast<std::uint16_t>(reader.read(POSITION_BITS));
+        snapshot.rightY = static_cast<std::uint16_t>(reader.read(POSITION_BITS));
+        snapshot.leftAction  = static_cast<std::uint8_t>(reader.read(ACTION_BITS));
+        snapshot.rightAction = static_cast<std::uint8_t>(reader.read(ACTION_BITS));
+        readMeta(reader, snapshot);
+        return !reader.failed() && validEnums(snapshot);
+    }
+
+    std::uint32_t baselineTick = reader.read(BASELINE_BITS);
+    std::uint32_t age = reader.read(1) == 0 ? reader.read(SHORT_AGE_BITS) : reader.read(AGE_BITS);
+    const Snapshot* baseline = history.slot(baselineTick);
+    if (!baseline || (baseline->tick & ((1u << BASELINE_BITS) - 1)) != baselineTick || reader.failed())
+        return false;
+
+    int ballX  = readField(reader, predictPosition(baseline->ballX, baseline->ballVX, age), POSITION_BITS);
+    int ballY  = readField(reader, predictBallY(baseline->ballY, baseline->ballVY, age), POSITION_BITS);
+    int ballVX = readVelocity(reader, baseline->ballVX);
+    int ballVY = readVelocity(reader, baseline->ballVY);
+    int leftY  = readField(reader, predictPaddle(baseline->leftY, baseline->leftAction, age), POSITION_BITS);
+    int rightY = readField(reader, predictPaddle(baseline->rightY, baseline->rightAction, age), POSITION_BITS);
+    if (!validPosition(ballX) || !validPosition(ballY) || !validVelocity(ballVX) || !validVelocity(ballVY) ||
+        !validPosition(leftY) || !validPosition(rightY))
+        return false;
+
+    snapshot.tick   = baseline->tick + age;
+    snapshot.ballX  = static_cast<std::uint16_t>(ballX);
+    snapshot.ballY  = static_cast<std::uint16_t>(ballY);
+    snapshot.ballVX = static_cast<std::int16_t>(ballVX);
+    snapshot.ballVY = static_cast<std::int16_t>(ballVY);
+    snapshot.leftY  = static_cast<std::uint16_t>(leftY);
+    snapshot.rightY = static_cast<std::uint16_t>(rightY);
+
+    if (reader.read(1) == 0) {
+        snapshot.leftAction  = baseline->leftAction;
+        snapshot.rightAction = baseline->rightAction;
+    }
+    else {
+        snapshot.leftAction  = static_cast<std::uint8_t>(reader.read(ACTION_BITS));
+        snapshot.rightAction = static_cast<std::uint8_t>(reader.read(ACTION_BITS));
+    }
+
+    if (reader.read(1) == 0) {
+        snapshot.leftScore  = baseline->leftScore;
+        snapshot.rightScore = baseline->rightScore;
+        snapshot.lives      = baseline->lives;
+        snapshot.gameState  = baseline->gameState;
+    }
+    else {
+        readMetaDelta(reader, snapshot, *baseline);
+    }
+    return !reader.failed() && validEnums(snapshot);
+}
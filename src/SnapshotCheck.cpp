@@ -0,0 +1,364 @@
+#include "SnapshotCheck.h"
+#include "PaddleController.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const float MATCH_DT = 1.f / 60.f;
+
+    // Simulated link: one-way latency range (ticks) and loss rate
+    const std::uint32_t MAX_LATENCY_TICKS = 6;
+    const float LOSS_RATE = 0.05f;
+
+    // Stream players: chase the ball, deciding every 100 ms (a held key)
+    // with a share of random decisions
+    const std::uint32_t DECISION_TICKS = 6;
+    const float RANDOM_MOVES = 0.2f;
+
+    // Snapshot/baseline pairs kept for the throughput measurement
+    const std::size_t THROUGHPUT_PAIRS = 100000;
+    const double THROUGHPUT_SECONDS = 0.5;
+
+    /*
+        splitmix64 stream for the random cases.
+    */
+    std::uint64_t nextBits(std::uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    int nextInt(std::uint64_t& state, int low, int high) {
+        return low + static_cast<int>(nextBits(state) % static_cast<std::uint64_t>(high - low + 1));
+    }
+
+    float nextUnit(std::uint64_t& state) {
+        return (nextBits(state) >> 40) * (1.f / 16777216.f);
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /*
+        Any valid snapshot (every field over its whole range).
+    */
+    Snapshot randomSnapshot(std::uint64_t& rng) {
+        Snapshot s;
+        s.tick       = static_cast<std::uint32_t>(nextBits(rng));
+        s.ballX      = static_cast<std::uint16_t>(nextInt(rng, 0, 1023));
+        s.ballY      = static_cast<std::uint16_t>(nextInt(rng, 0, 1023));
+        s.ballVX     = static_cast<std::int16_t>(nextInt(rng, -2048, 2047));
+        s.ballVY     = static_cast<std::int16_t>(nextInt(rng, -2048, 2047));
+        s.leftY      = static_cast<std::uint16_t>(nextInt(rng, 0, 1023));
+        s.rightY     = static_cast<std::uint16_t>(nextInt(rng, 0, 1023));
+        s.leftAction = static_cast<std::uint8_t>(nextInt(rng, 0, 2));
+        s.rightAction = static_cast<std::uint8_t>(nextInt(rng, 0, 2));
+        s.leftScore  = static_cast<std::uint8_t>(nextInt(rng, 0, 255));
+        s.rightScore = static_cast<std::uint8_t>(nextInt(rng, 0, 255));
+        s.lives      = static_cast<std::uint8_t>(nextInt(rng, 0, 7));
+        s.gameState  = static_cast<std::uint8_t>(nextInt(rng, 0, 2));
+        return s;
+    }
+
+    /*
+        Moves a field by up to ±'range', staying inside [low, high].
+    */
+    template <typename T>
+    void nudge(std::uint64_t& rng, T& field, int range, int low, int high) {
+        int value = field + nextInt(rng, -range, range);
+        field = static_cast<T>(value < low ? low : (value > high ? high : value));
+    }
+
+    /*
+        A snapshot 0..40 ticks after 'base': mostly small changes (every
+        residual class), sometimes unrelated fields.
+    */
+    Snapshot randomSuccessor(std::uint64_t& rng, const Snapshot& base) {
+        Snapshot s = nextInt(rng, 0, 9) == 0 ? randomSnapshot(rng) : base;
+        int range = 1 << nextInt(rng, 0, 10);
+        s.tick = base.tick + static_cast<std::uint32_t>(nextInt(rng, 0, 40));
+        if (nextInt(rng, 0, 1)) nudge(rng, s.ballX, range, 0, 1023);
+        if (nextInt(rng, 0, 1)) nudge(rng, s.ballY, range, 0, 1023);
+        if (nextInt(rng, 0, 3) == 0) nudge(rng, s.ballVX, range, -2048, 2047);
+        if (nextInt(rng, 0, 3) == 0) nudge(rng, s.ballVY, range, -2048, 2047);
+        if (nextInt(rng, 0, 1)) nudge(rng, s.leftY, range, 0, 1023);
+        if (nextInt(rng, 0, 1)) nudge(rng, s.rightY, range, 0, 1023);
+        if (nextInt(rng, 0, 3) == 0) s.leftAction = static_cast<std::uint8_t>(nextInt(rng, 0, 2));
+        if (nextInt(rng, 0, 7) == 0) s.leftScore++;
+        if (nextInt(rng, 0, 15) == 0) s.gameState = static_cast<std::uint8_t>(nextInt(rng, 0, 2));
+        return s;
+    }
+
+    /*
+        Random pairs, truncations and garbage. Returns the failures.
+    */
+    std::size_t fuzz(std::size_t count, std::uint64_t seed) {
+        std::uint64_t rng = seed;
+        std::size_t failures = 0, keyframes = 0, garbageAccepted = 0;
+        std::uint8_t buffer[SNAPSHOT_MAX_BYTES];
+        SnapshotHistory history;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            Snapshot base = randomSnapshot(rng);
+            Snapshot sent = randomSuccessor(rng, base);
+            bool useBaseline = nextInt(rng, 0, 7) != 0;
+
+            history.clear();
+            history.store(base);
+            std::size_t size = encodeSnapshot(sent, useBaseline ? &base : nullptr, buffer);
+            keyframes += (buffer[0] & 1u) == 0;
+
+            Snapshot received;
+            if (size > SNAPSHOT_MAX_BYTES || !decodeSnapshot(buffer, size, history, received) || received != sent) {
+                if (failures++ < 5)
+                    std::printf("  round trip mismatch: case %zu (%zu bytes)\n", i, size);
+                continue;
+            }
+
+            // A truncated encoding is always missing bits
+            std::size_t cut = static_cast<std::size_t>(nextInt(rng, 0, static_cast<int>(size) - 1));
+            if (decodeSnapshot(buffer, cut, history, received)) {
+                if (failures++ < 5)
+                    std::printf("  truncation accepted: case %zu (%zu of %zu bytes)\n", i, cut, size);
+            }
+
+            // Garbage must not crash; it may happen to be valid
+            std::size_t junk = static_cast<std::size_t>(nextInt(rng, 0, static_cast<int>(SNAPSHOT_MAX_BYTES)));
+            for (std::size_t b = 0; b < junk; ++b)
+                buffer[b] = static_cast<std::uint8_t>(nextBits(rng));
+            garbageAccepted += decodeSnapshot(buffer, junk, history, received);
+        }
+
+        std::printf("Fuzz: %zu round trips (%zu keyframes), %zu truncations rejected, "
+                    "%zu of %zu garbage inputs decodable: %s\n",
+                    count, keyframes, count, garbageAccepted, count, failures ? "FAILED" : "ok");
+        return failures;
+    }
+
+    /*
+        What a sender produced for one tick, and its encoding.
+    */
+    struct Packet {
+        std::uint32_t arrival;           // Link tick it is delivered
+        Snapshot snapshot;
+        std::uint8_t bytes[SNAPSHOT_MAX_BYTES];
+        std::size_t size;
+    };
+
+    struct Ack {
+        std::uint32_t arrival;
+        std::uint32_t tick;
+    };
+
+    PaddleAction chaseOrWander(const SimState& state, Side side, std::uint64_t& rng) {
+        if (nextUnit(rng) < RANDOM_MOVES)
+            return static_cast<PaddleAction>(nextBits(rng) % 3);
+        float ballCenterY = state.ballY + CLASSIC_ARENA.ballSize / 2.f;
+        float center = paddleCenterY(state, side, CLASSIC_ARENA);
+        if (ballCenterY > center)
+            return PaddleAction::DOWN;
+        if (ballCenterY < center)
+            return PaddleAction::UP;
+        return PaddleAction::STAY;
+    }
+
+    /*
+        Size distribution of the stream.
+    */
+    struct StreamReport {
+        std::size_t sent = 0;
+        std::size_t delivered = 0;
+        std::size_t keyframes = 0;
+        std::size_t failures = 0;
+        std::size_t bytes = 0;
+        std::size_t histogram[SNAPSHOT_MAX_BYTES + 1] = {};
+    };
+
+    /*
+        Headless PvP matches streamed to one receiver over a lossy link,
+        the sender delta-coding against the newest acknowledged tick. The
+        (snapshot, baseline) pairs sent are appended to 'pairs'.
+    */
+    StreamReport stream(std::size_t count, std::uint64_t seed, std::vector<Snapshot>& pairs) {
+        StreamReport report;
+        std::uint64_t rng = seed;
+
+        for (std::uint64_t index = 0; report.sent < count; ++index) {
+            SimMatch match = startSimMatch(mixSeed(seed, index));
+            std::uint32_t latency = static_cast<std::uint32_t>(nextInt(rng, 0, MAX_LATENCY_TICKS));
+            SnapshotHistory sentHistory, receivedHistory;
+            std::deque<Packet> inFlight;
+            std::deque<Ack> acks;
+            bool haveAck = false;
+            std::uint32_t acked = 0;
+            MatchInput input = { PaddleAction::STAY, PaddleAction::STAY };
+
+            for (std::uint32_t now = 0; !match.finished && report.sent < count; ++now) {
+                if (now % DECISION_TICKS == 0)
+                    input.left = chaseOrWander(match.state, Side::LEFT, rng);
+                if (now % DECISION_TICKS == DECISION_TICKS / 2)
+                    input.right = chaseOrWander(match.state, Side::RIGHT, rng);
+                stepSimMatch(match, input, MATCH_DT);
+
+                // Sender
+                Packet packet;
+                packet.arrival = now + latency;
+                packet.snapshot = makeSnapshot(match.tick, match.state, input, match.leftScore, match.rightScore, 0,
+                                               match.finished ? GameState::GAME_OVER : GameState::PLAYING);
+                sentHistory.store(packet.snapshot);
+                while (!acks.empty() && acks.front().arrival <= now) {
+                    haveAck = true;
+                    acked = acks.front().tick;
+                    acks.pop_front();
+                }
+                const Snapshot* baseline = haveAck ? sentHistory.find(acked) : nullptr;
+                packet.size = encodeSnapshot(packet.snapshot, baseline, packet.bytes);
+                if (pairs.size() < 2 * THROUGHPUT_PAIRS && baseline) {
+                    pairs.push_back(packet.snapshot);
+                    pairs.push_back(*baseline);
+                }
+
+                report.sent++;
+                report.bytes += packet.size;
+                report.histogram[packet.size]++;
+                report.keyframes += (packet.bytes[0] & 1u) == 0;
+                if (nextUnit(rng) >= LOSS_RATE)
+                    inFlight.push_back(packet);
+
+                // Receiver
+                while (!inFlight.empty() && inFlight.front().arrival <= now) {
+                    const Packet& arrived = inFlight.front();
+                    Snapshot decoded;
+                    if (decodeSnapshot(arrived.bytes, arrived.size, receivedHistory, decoded) &&
+                        decoded == arrived.snapshot) {
+                        receivedHistory.store(decoded);
+                        report.delivered++;
+                        if (nextUnit(rng) >= LOSS_RATE)
+                            acks.push_back(Ack{ now + latency, decoded.tick });
+                    }
+                    else if (report.failures++ < 5) {
+                        std::printf("  stream mismatch: match %llu tick %u\n",
+                                    static_cast<unsigned long long>(index), arrived.snapshot.tick);
+                    }
+                    inFlight.pop_front();
+                }
+            }
+        }
+        return report;
+    }
+
+    void printStream(const StreamReport& report) {
+        std::size_t deltas = report.sent - report.keyframes;
+        std::size_t median = 0, p99 = 0, seen = 0;
+        for (std::size_t size = 0; size <= SNAPSHOT_MAX_BYTES; ++size) {
+            seen += report.histogram[size];
+            if (!median && seen * 2 >= report.sent) median = size;
+            if (!p99 && seen * 100 >= report.sent * 99) p99 = size;
+        }
+
+        std::printf("Stream: %zu snapshots (%zu delivered, %zu keyframes, %zu deltas): %s\n",
+                    report.sent, report.delivered, report.keyframes, deltas,
+                    report.failures ? "FAILED" : "ok");
+        std::printf("  size: mean %.2f bytes, median %zu, p99 %zu\n",
+                    double(report.bytes) / report.sent, median, p99);
+        std::printf("  bytes:");
+        for (std::size_t size = 1; size <= SNAPSHOT_MAX_BYTES; ++size)
+            if (report.histogram[size])
+                std::printf("  %zu:%.1f%%", size, 100.0 * report.histogram[size] / report.sent);
+        std::printf("\n");
+    }
+
+    /*
+        Encode and decode rates over the recorded delta pairs.
+    */
+    void printThroughput(const std::vector<Snapshot>& pairs) {
+        std::size_t count = pairs.size() / 2;
+        if (count == 0)
+            return;
+
+        std::vector<std::uint8_t> encoded(count * SNAPSHOT_MAX_BYTES);
+        std::vector<std::size_t> sizes(count);
+        std::size_t encodes = 0, decodes = 0, checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        double encodeSeconds = 0.0;
+        do {
+            for (std::size_t i = 0; i < count; ++i)
+                sizes[i] = encodeSnapshot(pairs[2 * i], &pairs[2 * i + 1], &encoded[i * SNAPSHOT_MAX_BYTES]);
+            encodes += count;
+            encodeSeconds = secondsSince(start);
+        } while (encodeSeconds < THROUGHPUT_SECONDS);
+
+        SnapshotHistory history;
+        start = std::chrono::steady_clock::now();
+        double decodeSeconds = 0.0;
+        do {
+            for (std::size_t i = 0; i < count; ++i) {
+                Snapshot decoded;
+                history.store(pairs[2 * i + 1]);
+                checksum += decodeSnapshot(&encoded[i * SNAPSHOT_MAX_BYTES], sizes[i], history, decoded);
+            }
+            decodes += count;
+            decodeSeconds = secondsSince(start);
+        } while (decodeSeconds < THROUGHPUT_SECONDS);
+
+        std::printf("Throughput (deltas, one core): encode %.1f M snapshots/s, decode %.1f M snapshots/s%s\n",
+                    encodes / encodeSeconds / 1e6, decodes / decodeSeconds / 1e6,
+                    checksum == decodes ? "" : "  (decode errors!)");
+    }
+}
+
+
+/*
+    Function: int runSnapshotCommand(int argc, char** argv)
+
+    Objective:
+        Verify the snapshot format and report its size and speed.
+
+    Input Parameters:
+        - int argc, char** argv: Process arguments (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code (1 on any round-trip failure).
+
+    Side Effects:
+        - Prints the results.
+
+    Approach:
+        - "--option value" pairs; fuzz, stream and throughput in turn.
+*/
+int runSnapshotCommand(int argc, char** argv) {
+    std::size_t count = 1000000;
+    std::uint64_t seed = 7;
+
+    bool valid = (argc - 2) % 2 == 0;
+    for (int i = 2; valid && i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--count") count = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+        else valid = false;
+    }
+    if (!valid || count < 1) {
+        std::cout << "Usage:\n  pong --snapshot-check [--count N] [--seed S]\n";
+        return 1;
+    }
+
+    std::size_t failures = fuzz(count, seed);
+
+    std::vector<Snapshot> pairs;
+    StreamReport report = stream(count, mixSeed(seed, 1), pairs);
+    printStream(report);
+    failures += report.failures;
+
+    printThroughput(pairs);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,651 @@
+#include "StatsQuery.h"
+#include "Arena.h"
+#include "MatchStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Key of rows a filter excludes (never a group)
+    const std::uint32_t EXCLUDED = 0xFFFFFFFFu;
+
+    // A column that stands for "number of matches" in a metric
+    const int MATCH_COUNT = -1;
+
+    const std::int64_t SECONDS_PER_HOUR = 3600;
+    const std::int64_t SECONDS_PER_DAY = 86400;
+
+    const float TICKS_PER_SECOND = 60.f;
+
+    // Synthetic matches: the first one ends at 2026-01-01 00:00 UTC
+    const std::int64_t GENERATE_START = 1767225600;
+
+    /*
+        One number a metric prints per group:
+        sum(numerators) / (sum(denominator) or matches) * scale.
+    */
+    struct MetricOutput {
+        const char* label;
+        StatsColumn numerators[2];
+        int numeratorCount;
+        int denominator;            // StatsColumn index or MATCH_COUNT
+        double scale;
+    };
+
+    struct Metric {
+        const char* name;
+        const char* description;
+        MetricOutput outputs[STATS_HIT_ZONES];
+        int outputCount;
+    };
+
+    const Metric METRICS[] = {
+        { "matches", "number of matches",
+          { { "matches", {}, 0, MATCH_COUNT, 1.0 } }, 1 },
+        { "duration", "average match length (seconds)",
+          { { "seconds", { StatsColumn::TICKS }, 1, MATCH_COUNT, 1.0 / TICKS_PER_SECOND } }, 1 },
+        { "points", "average points per match",
+          { { "points", { StatsColumn::POINTS }, 1, MATCH_COUNT, 1.0 } }, 1 },
+        { "rally", "average rally length (paddle hits per point)",
+          { { "rally length", { StatsColumn::HITS }, 1, static_cast<int>(StatsColumn::POINTS), 1.0 } }, 1 },
+        { "longest", "average longest rally per match",
+          { { "longest rally", { StatsColumn::LONGEST_RALLY }, 1, MATCH_COUNT, 1.0 } }, 1 },
+        { "hits", "average paddle hits per match",
+          { { "hits", { StatsColumn::HITS }, 1, MATCH_COUNT, 1.0 } }, 1 },
+        { "travel", "average paddle travel per match (pixels, both paddles)",
+          { { "travel", { StatsColumn::LEFT_TRAVEL, StatsColumn::RIGHT_TRAVEL }, 2, MATCH_COUNT, 1.0 } }, 1 },
+        { "score", "average final score",
+          { { "left", { StatsColumn::LEFT_SCORE }, 1, MATCH_COUNT, 1.0 },
+            { "right", { StatsColumn::RIGHT_SCORE }, 1, MATCH_COUNT, 1.0 } }, 2 },
+        { "zones", "share of hits by paddle zone, top to bottom (%)",
+          { { "top", { StatsColumn::ZONE_0 }, 1, static_cast<int>(StatsColumn::HITS), 100.0 },
+            { "upper", { StatsColumn::ZONE_1 }, 1, static_cast<int>(StatsColumn::HITS), 100.0 },
+            { "middle", { StatsColumn::ZONE_2 }, 1, static_cast<int>(StatsColumn::HITS), 100.0 },
+            { "lower", { StatsColumn::ZONE_3 }, 1, static_cast<int>(StatsColumn::HITS), 100.0 },
+            { "bottom", { StatsColumn::ZONE_4 }, 1, static_cast<int>(StatsColumn::HITS), 100.0 } }, 5 },
+    };
+
+    enum class GroupBy { ALL, HOUR, WEEKDAY, DAY, MODE, ARENA };
+
+    struct QueryOptions {
+        const Metric* metric = nullptr;
+        GroupBy by = GroupBy::ALL;
+        int mode = -1;              // GameMode filter, -1 = any
+        int arena = -1;             // ARENA_PRESETS filter, -1 = any
+        std::string base = MATCH_STATS_PATH;
+    };
+
+    struct GroupTotals {
+        std::uint64_t matches = 0;
+        std::uint64_t sums[STATS_COLUMN_COUNT] = {};
+    };
+
+    /*
+        The decoded columns of one segment (only those the query uses).
+    */
+    struct SegmentColumns {
+        std::size_t rows = 0;
+        std::vector<std::uint64_t> timestamps;
+        std::vector<std::uint32_t> columns[STATS_COLUMN_COUNT];
+        std::vector<std::uint32_t> keys;
+    };
+
+    std::uint64_t sumWhereEqualScalar(const std::uint32_t* keys, const std::uint32_t* values,
+                                      std::size_t count, std::uint32_t key, std::uint64_t& matches) {
+        std::uint64_t sum = 0, found = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (keys[i] == key) {
+                ++found;
+                sum += values ? values[i] : 0;
+            }
+        }
+        matches = found;
+        return sum;
+    }
+
+#ifdef STATS_X86_KERNELS
+    /*
+        Eight rows per step: compare the keys, mask the values, widen
+        them to 64-bit lanes and add; the masks (-1 per match) are
+        subtracted from a per-lane match count.
+    */
+    __attribute__((target("avx2")))
+    std::uint64_t sumWhereEqualAvx2(const std::uint32_t* keys, const std::uint32_t* values,
+                                    std::size_t count, std::uint32_t key, std::uint64_t& matches) {
+        const __m256i wanted = _mm256_set1_epi32(static_cast<int>(key));
+        __m256i sumLow = _mm256_setzero_si256();
+        __m256i sumHigh = _mm256_setzero_si256();
+        __m256i found = _mm256_setzero_si256();
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i mask = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)),
+                                              wanted);
+            found = _mm256_sub_epi32(found, mask);
+            if (values) {
+                __m256i v = _mm256_and_si256(mask,
+                                             _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+                sumLow = _mm256_add_epi64(sumLow, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+                sumHigh = _mm256_add_epi64(sumHigh, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+        }
+
+        alignas(32) std::uint64_t sums[4];
+        alignas(32) std::uint32_t counts[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums), _mm256_add_epi64(sumLow, sumHigh));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(counts), found);
+
+        std::uint64_t tailMatches;
+        std::uint64_t sum = sums[0] + sums[1] + sums[2] + sums[3] +
+                            sumWhereEqualScalar(keys + i, values ? values + i : nullptr, count - i, key,
+                                                tailMatches);
+        matches = tailMatches;
+        for (std::uint32_t c : counts)
+            matches += c;
+        return sum;
+    }
+#endif
+
+    bool hasAvx2() {
+#ifdef STATS_X86_KERNELS
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /*
+        Days since 1970-01-01 → "YYYY-MM-DD" (proleptic Gregorian,
+        Howard Hinnant's civil_from_days).
+    */
+    std::string formatDay(std::int64_t days) {
+        days += 719468;
+        std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        std::int64_t dayOfEra = days - era * 146097;
+        std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        std::int64_t mp = (5 * dayOfYear + 2) / 153;
+        std::int64_t day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        std::int64_t month = mp < 10 ? mp + 3 : mp - 9;
+        std::int64_t year = yearOfEra + era * 400 + (month <= 2);
+
+        char text[40];
+        std::snprintf(text, sizeof(text), "%04d-%02d-%02d", static_cast<int>(year), static_cast<int>(month),
+                      static_cast<int>(day));
+        return text;
+    }
+
+    std::string groupLabel(GroupBy by, std::uint32_t key) {
+        static const char* const WEEKDAYS[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+        char text[32];
+        switch (by) {
+            case GroupBy::HOUR:
+                std::snprintf(text, sizeof(text), "%02u:00", key);
+                return text;
+            case GroupBy::WEEKDAY:
+                return WEEKDAYS[key % 7];
+            case GroupBy::DAY:
+                return formatDay(key);
+            case GroupBy::MODE:
+                return key == static_cast<std::uint32_t>(GameMode::PLAYER_VS_AI) ? "vs AI" : "PvP";
+            case GroupBy::ARENA:
+                return key < ARENA_PRESET_COUNT ? ARENA_PRESETS[key]->name : "custom";
+            default:
+                return "all";
+        }
+    }
+
+    const char* groupName(GroupBy by) {
+        switch (by) {
+            case GroupBy::HOUR:    return "hour";
+            case GroupBy::WEEKDAY: return "weekday";
+            case GroupBy::DAY:     return "day";
+            case GroupBy::MODE:    return "mode";
+            case GroupBy::ARENA:   return "arena";
+            default:               return "";
+        }
+    }
+
+    /*
+        Which columns a query reads: the metric's, the group key's and
+        the filters'.
+    */
+    std::vector<StatsColumn> neededColumns(const QueryOptions& options) {
+        bool needed[STATS_COLUMN_COUNT] = {};
+        for (int o = 0; o < options.metric->outputCount; ++o) {
+            const MetricOutput& output = options.metric->outputs[o];
+            for (int n = 0; n < output.numeratorCount; ++n)
+                needed[static_cast<std::size_t>(output.numerators[n])] = true;
+            if (output.denominator != MATCH_COUNT)
+                needed[output.denominator] = true;
+        }
+        if (options.by == GroupBy::HOUR || options.by == GroupBy::WEEKDAY || options.by == GroupBy::DAY)
+            needed[static_cast<std::size_t>(StatsColumn::TIMESTAMP)] = true;
+        if (options.by == GroupBy::MODE || options.mode >= 0)
+            needed[static_cast<std::size_t>(StatsColumn::MODE)] = true;
+        if (options.by == GroupBy::ARENA || options.arena >= 0)
+            needed[static_cast<std::size_t>(StatsColumn::ARENA)] = true;
+
+        std::vector<StatsColumn> columns;
+        for (std::size_t c = 0; c < STATS_COLUMN_COUNT; ++c)
+            if (needed[c])
+                columns.push_back(static_cast<StatsColumn>(c));
+        return columns;
+    }
+
+    /*
+        A filter value outside a chunk's [min, max] excludes the whole
+        segment (zone map).
+    */
+    bool segmentCanMatch(const StatsSegmentHeader& segment, const QueryOptions& options) {
+        const StatsChunk& mode = segment.chunks[static_cast<std::size_t>(StatsColumn::MODE)];
+        const StatsChunk& arena = segment.chunks[static_cast<std::size_t>(StatsColumn::ARENA)];
+        if (options.mode >= 0 && (std::uint64_t(options.mode) < mode.base || std::uint64_t(options.mode) > mode.max))
+            return false;
+        if (options.arena >= 0 && (std::uint64_t(options.arena) < arena.base || std::uint64_t(options.arena) > arena.max))
+            return false;
+        return true;
+    }
+
+    std::uint32_t rowKey(const SegmentColumns& data, std::size_t i, GroupBy by) {
+        switch (by) {
+            case GroupBy::HOUR:
+                return static_cast<std::uint32_t>(data.timestamps[i] / SECONDS_PER_HOUR % 24);
+            case GroupBy::WEEKDAY:    // 1970-01-01 was a Thursday
+                return static_cast<std::uint32_t>((data.timestamps[i] / SECONDS_PER_DAY + 3) % 7);
+            case GroupBy::DAY:
+                return static_cast<std::uint32_t>(data.timestamps[i] / SECONDS_PER_DAY);
+            case GroupBy::MODE:
+                return data.columns[static_cast<std::size_t>(StatsColumn::MODE)][i];
+            case GroupBy::ARENA:
+                return data.columns[static_cast<std::size_t>(StatsColumn::ARENA)][i];
+            default:
+                return 0;
+        }
+    }
+
+    /*
+        Add one segment's rows to the group totals.
+
+        Every row gets a key (its group, or EXCLUDED); then, for each
+        group present in the segment, one kernel pass per column sums
+        the rows with that key. The arrays are at most a segment long,
+        so all passes run over data already in the L1/L2 cache.
+    */
+    void aggregate(SegmentColumns& data, const std::vector<StatsColumn>& columns, const QueryOptions& options,
+                   std::map<std::uint32_t, GroupTotals>& groups) {
+        const std::vector<std::uint32_t>& modes = data.columns[static_cast<std::size_t>(StatsColumn::MODE)];
+        const std::vector<std::uint32_t>& arenas = data.columns[static_cast<std::size_t>(StatsColumn::ARENA)];
+
+        data.keys.resize(data.rows);
+        std::vector<std::uint32_t> present;
+        for (std::size_t i = 0; i < data.rows; ++i) {
+            bool keep = (options.mode < 0 || modes[i] == std::uint32_t(options.mode)) &&
+                        (options.arena < 0 || arenas[i] == std::uint32_t(options.arena));
+            std::uint32_t key = keep ? rowKey(data, i, options.by) : EXCLUDED;
+            data.keys[i] = key;
+            if (keep && (present.empty() || present.back() != key) &&
+                std::find(present.begin(), present.end(), key) == present.end())
+                present.push_back(key);
+        }
+
+        for (std::uint32_t key : present) {
+            GroupTotals& totals = groups[key];
+            std::uint64_t matches = 0;
+            sumWhereEqual(data.keys.data(), nullptr, data.rows, key, matches);
+            totals.matches += matches;
+
+            for (StatsColumn column : columns) {
+                std::size_t c = static_cast<std::size_t>(column);
+                if (column == StatsColumn::TIMESTAMP)
+                    continue;
+                totals.sums[c] += sumWhereEqual(data.keys.data(), data.columns[c].data(), data.rows, key, matches);
+            }
+        }
+    }
+
+    double outputValue(const MetricOutput& output, const GroupTotals& totals) {
+        double numerator = 0.0;
+        for (int n = 0; n < output.numeratorCount; ++n)
+            numerator += static_cast<double>(totals.sums[static_cast<std::size_t>(output.numerators[n])]);
+        if (output.numeratorCount == 0)
+            numerator = static_cast<double>(totals.matches);
+
+        double denominator = output.denominator == MATCH_COUNT ? static_cast<double>(totals.matches)
+                                                               : static_cast<double>(totals.sums[output.denominator]);
+        if (output.numeratorCount == 0)
+            return numerator;
+        return denominator > 0.0 ? numerator / denominator * output.scale : 0.0;
+    }
+
+    /*
+        Run a query over the columnar file and the journal; print the
+        table and what it cost.
+    */
+    int runQuery(const QueryOptions& options) {
+        std::vector<StatsColumn> columns = neededColumns(options);
+        std::map<std::uint32_t, GroupTotals> groups;
+        std::size_t segments = 0, skipped = 0;
+        std::uint64_t rows = 0;
+        SegmentColumns data;
+
+        auto start = std::chrono::steady_clock::now();
+
+        StatsFileReader reader;
+        std::string columnPath = options.base + ".col";
+        bool haveColumns = reader.open(columnPath);
+        while (haveColumns && reader.next()) {
+            const StatsSegmentHeader& segment = reader.getSegment();
+            ++segments;
+            rows += segment.rows;
+            if (!segmentCanMatch(segment, options)) {
+                ++skipped;
+                continue;
+            }
+
+            data.rows = segment.rows;
+            for (StatsColumn column : columns) {
+                std::size_t c = static_cast<std::size_t>(column);
+                bool ok;
+                if (column == StatsColumn::TIMESTAMP) {
+                    data.timestamps.resize(data.rows);
+                    ok = reader.readColumn(column, data.timestamps.data());
+                }
+                else {
+                    data.columns[c].resize(data.rows);
+                    ok = reader.readColumn(column, data.columns[c].data());
+                }
+                if (!ok) {
+                    std::printf("%s: damaged segment %zu\n", columnPath.c_str(), segments);
+                    return 1;
+                }
+            }
+            aggregate(data, columns, options, groups);
+        }
+
+        // Matches not yet moved into a segment
+        std::vector<MatchStatsRow> journal;
+        readStatsJournal(options.base + ".log", journal);
+        for (std::size_t first = 0; first < journal.size(); first += STATS_SEGMENT_ROWS) {
+            data.rows = std::min(STATS_SEGMENT_ROWS, journal.size() - first);
+            for (StatsColumn column : columns) {
+                std::size_t c = static_cast<std::size_t>(column);
+                std::vector<std::uint64_t> values(data.rows);
+                for (std::size_t i = 0; i < data.rows; ++i)
+                    values[i] = statsColumnValue(journal[first + i], column);
+                if (column == StatsColumn::TIMESTAMP)
+                    data.timestamps = values;
+                else
+                    data.columns[c].assign(values.begin(), values.end());
+            }
+            aggregate(data, columns, options, groups);
+        }
+        rows += journal.size();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!haveColumns && journal.empty()) {
+            std::printf("No match stats at %s.col / .log\n", options.base.c_str());
+            return 1;
+        }
+
+        std::printf("%s by %s: %s\n", options.metric->name,
+                    options.by == GroupBy::ALL ? "all" : groupName(options.by), options.metric->description);
+        std::printf("%-12s %10s", options.by == GroupBy::ALL ? "" : groupName(options.by), "matches");
+        if (options.metric->outputs[0].numeratorCount > 0)
+            for (int o = 0; o < options.metric->outputCount; ++o)
+                std::printf(" %14s", options.metric->outputs[o].label);
+        std::printf("\n");
+
+        for (const auto& group : groups) {
+            std::printf("%-12s %10llu", groupLabel(options.by, group.first).c_str(),
+                        static_cast<unsigned long long>(group.second.matches));
+            if (options.metric->outputs[0].numeratorCount > 0)
+                for (int o = 0; o < options.metric->outputCount; ++o)
+                    std::printf(" %14.2f", outputValue(options.metric->outputs[o], group.second));
+            std::printf("\n");
+        }
+
+        std::printf("\n%llu matches (%zu segments, %zu skipped by filter, %zu journal rows); "
+                    "%zu of %zu columns read, %.2f MB, in %.1f ms (%s scan)\n",
+                    static_cast<unsigned long long>(rows), segments, skipped, journal.size(),
+                    columns.size(), STATS_COLUMN_COUNT, reader.getBytesRead() / 1e6, seconds * 1000.0,
+                    hasAvx2() ? "avx2" : "scalar");
+        return 0;
+    }
+
+    /*
+        splitmix64 stream for synthetic matches.
+    */
+    std::uint64_t nextBits(std::uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    double nextUnit(std::uint64_t& state) {
+        return (nextBits(state) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /*
+        A plausible finished match ending at 'timestamp'. Rallies are
+        longer in the evening, so grouped queries have something to show.
+    */
+    MatchStatsRow syntheticMatch(std::uint64_t& rng, std::int64_t timestamp) {
+        MatchStatsRow row = {};
+        row.timestamp = timestamp;
+        row.mode = static_cast<std::uint8_t>(nextUnit(rng) < 0.7 ? GameMode::PLAYER_VS_AI
+                                                                 : GameMode::PLAYER_VS_PLAYER);
+        double arena = nextUnit(rng);
+        row.arena = static_cast<std::uint8_t>(arena < 0.7 ? 0 : arena < 0.85 ? 1 : arena < 0.95 ? 2 : 3);
+
+        int hour = static_cast<int>(timestamp / SECONDS_PER_HOUR % 24);
+        double meanRally = 3.0 + 1.5 * std::cos((hour - 21) * 3.14159265 / 12.0);
+
+        if (row.mode == static_cast<std::uint8_t>(GameMode::PLAYER_VS_AI)) {
+            row.leftScore = static_cast<std::uint8_t>(nextBits(rng) % 15);
+            row.rightScore = 0;
+            row.points = static_cast<std::uint16_t>(row.leftScore + 3);
+        }
+        else {
+            int loser = static_cast<int>(nextBits(rng) % 10);
+            bool leftWins = nextBits(rng) & 1;
+            row.leftScore = static_cast<std::uint8_t>(leftWins ? 10 : loser);
+            row.rightScore = static_cast<std::uint8_t>(leftWins ? loser : 10);
+            row.points = static_cast<std::uint16_t>(10 + loser);
+        }
+
+        for (unsigned p = 0; p < row.points; ++p) {
+            unsigned rally = static_cast<unsigned>(-meanRally * std::log(1.0 - nextUnit(rng)));
+            row.hits += rally;
+            row.longestRally = static_cast<std::uint16_t>(std::max<unsigned>(row.longestRally, rally));
+            row.ticks += 60 + rally * 70;
+        }
+
+        // Hits lean towards the middle of the paddle
+        static const double ZONE_SHARE[STATS_HIT_ZONES] = { 0.12, 0.22, 0.32, 0.22, 0.12 };
+        std::uint32_t assigned = 0;
+        for (std::size_t z = 0; z < STATS_HIT_ZONES; ++z) {
+            if (z == STATS_HIT_ZONES / 2)
+                continue;
+            double share = ZONE_SHARE[z] * (0.8 + 0.4 * nextUnit(rng));
+            row.hitZones[z] = std::min(row.hits - assigned, static_cast<std::uint32_t>(row.hits * share + 0.5));
+            assigned += row.hitZones[z];
+        }
+        row.hitZones[STATS_HIT_ZONES / 2] = row.hits - assigned;
+
+        row.leftTravel = static_cast<std::uint32_t>(row.ticks * (1.0 + 2.0 * nextUnit(rng)));
+        row.rightTravel = static_cast<std::uint32_t>(row.ticks * (1.0 + 2.0 * nextUnit(rng)));
+        return row;
+    }
+
+    /*
+        Append 'count' synthetic matches to '<base>.col' as full segments.
+    */
+    int generate(const QueryOptions& options, std::size_t count, std::uint64_t seed) {
+        std::string path = options.base + ".col";
+        std::FILE* file = std::fopen(path.c_str(), "ab");
+        if (!file) {
+            std::printf("Cannot open %s\n", path.c_str());
+            return 1;
+        }
+
+        std::uint64_t rng = seed;
+        std::int64_t timestamp = GENERATE_START;
+        std::vector<MatchStatsRow> rows;
+        std::vector<unsigned char> data;
+        std::size_t bytes = 0;
+        bool ok = true;
+
+        for (std::size_t first = 0; ok && first < count; first += STATS_SEGMENT_ROWS) {
+            rows.resize(std::min(STATS_SEGMENT_ROWS, count - first));
+            for (MatchStatsRow& row : rows) {
+                timestamp += 60 + static_cast<std::int64_t>(nextBits(rng) % 420);
+                row = syntheticMatch(rng, timestamp);
+            }
+            data.clear();
+            encodeStatsSegment(rows.data(), rows.size(), 0, data);
+            ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+            bytes += data.size();
+        }
+
+        ok = std::fclose(file) == 0 && ok;
+        std::printf("%s %zu matches to %s: %.2f MB, %.1f bytes per match (%zu as rows)\n",
+                    ok ? "Appended" : "Failed to append", count, path.c_str(), bytes / 1e6,
+                    double(bytes) / count, sizeof(MatchStatsRow));
+        return ok ? 0 : 1;
+    }
+
+    int usage() {
+        std::cout << "Usage:\n"
+                     "  pong --stats-query METRIC [--by hour|weekday|day|mode|arena] [--mode ai|pvp]\n"
+                     "                            [--arena NAME] [--file BASE]\n"
+                     "  pong --stats-generate N [--seed S] [--file BASE]\n"
+                     "Metrics:\n";
+        for (const Metric& metric : METRICS)
+            std::printf("  %-10s %s\n", metric.name, metric.description);
+        return 1;
+    }
+}
+
+
+/*
+    Function: std::uint64_t sumWhereEqual(const std::uint32_t* keys, const std::uint32_t* values,
+                                          std::size_t count, std::uint32_t key, std::uint64_t& matches)
+
+    Objective:
+        Masked sum and count over one segment's rows.
+
+    Input Parameters:
+        - keys, values, count: Row keys and column values (values may be nullptr).
+        - key: Group to sum.
+        - matches: Receives the number of rows with that key.
+
+    Return Value:
+        - std::uint64_t: Sum of the values of those rows.
+
+    Side Effects:
+        - None
+
+    Approach:
+        - AVX2 kernel when the CPU supports it, scalar loop otherwise.
+*/
+std::uint64_t sumWhereEqual(const std::uint32_t* keys, const std::uint32_t* values,
+                            std::size_t count, std::uint32_t key, std::uint64_t& matches) {
+#ifdef STATS_X86_KERNELS
+    if (hasAvx2())
+        return sumWhereEqualAvx2(keys, values, count, key, matches);
+#endif
+    return sumWhereEqualScalar(keys, values, count, key, matches);
+}
+
+
+/*
+    Function: int runStatsCommand(int argc, char** argv)
+
+    Objective:
+        Query or populate the match stats store from the command line.
+
+    Input Parameters:
+        - int argc, char** argv: Process arguments (argv[1] is the command).
+
+    Return Value:
+        - int: Exit code.
+
+    Side Effects:
+        - Prints results; --stats-generate appends to the columnar file.
+
+    Approach:
+        - A positional argument (metric or count), then "--option value"
+          pairs.
+*/
+int runStatsCommand(int argc, char** argv) {
+    std::string command = argv[1];
+    if (argc < 3 || (argc - 3) % 2 != 0)
+        return usage();
+
+    QueryOptions options;
+    std::uint64_t seed = 1;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--file") {
+            options.base = value;
+        }
+        else if (arg == "--seed") {
+            seed = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--mode" && (value == "ai" || value == "pvp")) {
+            options.mode = static_cast<int>(value == "ai" ? GameMode::PLAYER_VS_AI : GameMode::PLAYER_VS_PLAYER);
+        }
+        else if (arg == "--arena") {
+            for (std::size_t a = 0; a < ARENA_PRESET_COUNT; ++a)
+                if (value == ARENA_PRESETS[a]->name)
+                    options.arena = static_cast<int>(a);
+            if (options.arena < 0)
+                return usage();
+        }
+        else if (arg == "--by") {
+            static const GroupBy KEYS[] = { GroupBy::HOUR, GroupBy::WEEKDAY, GroupBy::DAY,
+                                            GroupBy::MODE, GroupBy::ARENA };
+            bool found = false;
+            for (GroupBy key : KEYS) {
+                if (value == groupName(key)) {
+                    options.by = key;
+                    found = true;
+                }
+            }
+            if (!found)
+                return usage();
+        }
+        else {
+            return usage();
+        }
+    }
+
+    if (command == "--stats-generate") {
+        std::size_t count = std::strtoul(argv[2], nullptr, 10);
+        return count > 0 ? generate(options, count, seed) : usage();
+    }
+
+    for (const Metric& metric : METRICS)
+        if (argv[2] == std::string(metric.name))
+            options.metric = &metric;
+    if (!options.metric)
+        return usage();
+    return runQuery(options);
+}
@@ -0,0 +1,604 @@
+#include "Tournament.h"
+#include "Match.h"
+#include "PaddleController.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace {
+    // Headless matches run at the game's 60 Hz frame rate
+    const float MATCH_DT = 1.f / 60.f;
+
+    // Rating constants
+    const double INITIAL_RATING    = 1500.0;
+    const double INITIAL_DEVIATION = 350.0;
+    const double MIN_DEVIATION     = 10.0;
+    const double ELO_K             = 4.0;
+    const double PI                = 3.14159265358979323846;
+    const double GLICKO_Q          = std::log(10.0) / 400.0;
+
+    /*
+        Glicko g() factor: discounts opponents with uncertain ratings.
+    */
+    double glickoG(double deviation) {
+        return 1.0 / std::sqrt(1.0 + 3.0 * GLICKO_Q * GLICKO_Q * deviation * deviation / (PI * PI));
+    }
+
+    /*
+        Expected score against an opponent.
+    */
+    double expectedScore(double rating, double opponentRating, double g) {
+        return 1.0 / (1.0 + std::pow(10.0, -g * (rating - opponentRating) / 400.0));
+    }
+
+    /*
+        Match score from the left entrant's point of view: 1, 0.5 or 0.
+    */
+    double leftPoints(const MatchResult& result) {
+        if (result.leftScore > result.rightScore)
+            return 1.0;
+        if (result.leftScore < result.rightScore)
+            return 0.0;
+        return 0.5;
+    }
+
+    /*
+        Split "a,b,c" into names.
+    */
+    std::vector<std::string> splitList(const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+        return items;
+    }
+
+    void printUsage() {
+        std::cout <<
+            "Usage:\n"
+            "  pong --tournament [--swiss] [--rounds N] [--games N] [--seed S]\n"
+            "                    [--threads N] [--entrants a,b,...] [--max-seconds S]\n"
+            "                    [--log results.csv]\n"
+            "  pong --match LEFT RIGHT SEED      replay one match point by point\n"
+            "  pong --list-controllers\n";
+    }
+}
+
+
+/*
+    Constructor: Tournament::Tournament(const TournamentConfig& config)
+
+    Objective:
+        Initialise standings for every entrant.
+
+    Input Parameters:
+        - const TournamentConfig& config: Tournament settings.
+
+    Return Value:
+        - None (constructor).
+
+    Side Effects:
+        - Creates one statistics tally controller per entrant.
+
+    Approach:
+        - Every entrant starts at rating 1500, RD 350, Elo 1500.
+*/
+Tournament::Tournament(const TournamentConfig& config)
+    : config(config),
+      elapsedSeconds(0.0),
+      totalTicks(0),
+      threadsUsed(1)
+{
+    for (const std::string& name : config.entrants) {
+        EntrantStanding standing;
+        standing.name = name;
+        standing.glicko = INITIAL_RATING;
+        standing.deviation = INITIAL_DEVIATION;
+        standing.elo = INITIAL_RATING;
+        standing.wins = standing.draws = standing.losses = 0;
+        standing.points = 0.0;
+        standings.push_back(standing);
+        tallies.push_back(createController(name, true));
+    }
+}
+
+
+/*
+    Function: void Tournament::run()
+
+    Objective:
+        Play all rounds and rate the entrants.
+
+    Input Parameters:
+        - None
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Fills results and standings; writes the CSV log if configured.
+
+    Approach:
+        - For each round: build pairings, expand them into matches with
+          alternating sides and consecutive match indices (seeds), play
+          them in parallel, then rate the round.
+*/
+void Tournament::run() {
+    threadsUsed = config.threads ? config.threads : std::thread::hardware_concurrency();
+    if (threadsUsed == 0)
+        threadsUsed = 1;
+
+    std::uint64_t matchIndex = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < config.rounds; ++round) {
+        std::vector<MatchResult> slots;
+
+        for (const std::pair<int, int>& pair : makePairings(round)) {
+            for (int game = 0; game < config.gamesPerPair; ++game) {
+                MatchResult slot;
+                bool swapSides = (game % 2) == 1;
+                slot.left  = swapSides ? pair.second : pair.first;
+                slot.right = swapSides ? pair.first : pair.second;
+                slot.seed  = mixSeed(config.seed, matchIndex++);
+                slot.leftScore = slot.rightScore = 0;
+                slot.ticks = 0;
+                slot.round = round;
+                slots.push_back(slot);
+            }
+        }
+
+        playRound(slots);
+        rateRound(slots);
+        results.insert(results.end(), slots.begin(), slots.end());
+    }
+
+    elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (std::size_t i = 0; i < standings.size(); ++i)
+        standings[i].report = tallies[i]->getReport();
+
+    if (!config.logPath.empty()) {
+        std::ofstream log(config.logPath);
+        log << "round,left,right,seed,left_score,right_score,ticks\n";
+        for (const MatchResult& r : results) {
+            log << r.round << ',' << standings[r.left].name << ',' << standings[r.right].name
+                << ',' << r.seed << ',' << r.leftScore << ',' << r.rightScore
+                << ',' << r.ticks << '\n';
+        }
+    }
+}
+
+
+/*
+    Function: void Tournament::printReport(std::ostream& out) const
+
+    Objective:
+        Print standings (best Glicko first) and throughput.
+
+    Input Parameters:
+        - std::ostream& out: Destination stream.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Writes to the stream.
+
+    Approach:
+        - Sort a copy of the standings by Glicko rating.
+        - 95% interval = rating ± 1.96 * RD.
+*/
+void Tournament::printReport(std::ostream& out) const {
+    std::vector<EntrantStanding> table = standings;
+    std::sort(table.begin(), table.end(),
+              [](const EntrantStanding& a, const EntrantStanding& b) { return a.glicko > b.glicko; });
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "%s tournament: %zu entrants, %zu matches, seed %llu, %u threads\n\n",
+                  config.swiss ? "Swiss" : "Round-robin", standings.size(), results.size(),
+                  static_cast<unsigned long long>(config.seed), threadsUsed);
+    out << line;
+
+    std::snprintf(line, sizeof(line), "%-4s %-12s %7s %15s %7s %6s %6s %6s %7s\n",
+                  "Rank", "Controller", "Glicko", "95% interval", "Elo", "W", "D", "L", "Score");
+    out << line;
+
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const EntrantStanding& s = table[i];
+        int games = s.wins + s.draws + s.losses;
+        double score = games ? (s.wins + 0.5 * s.draws) / games : 0.0;
+        double margin = 1.96 * s.deviation;
+
+        std::snprintf(line, sizeof(line), "%-4zu %-12s %7.0f %7.0f..%-6.0f %7.0f %6d %6d %6d %6.1f%%\n",
+                      i + 1, s.name.c_str(), s.glicko, s.glicko - margin, s.glicko + margin,
+                      s.elo, s.wins, s.draws, s.losses, 100.0 * score);
+        out << line;
+    }
+
+    for (const EntrantStanding& s : table) {
+        if (!s.report.empty())
+            out << "  " << s.name << ": " << s.report << "\n";
+    }
+
+    double seconds = elapsedSeconds > 0.0 ? elapsedSeconds : 1e-9;
+    std::snprintf(line, sizeof(line),
+                  "\nThroughput: %zu matches in %.2f s = %.0f matches/s (%.2f M steps/s)\n",
+                  results.size(), elapsedSeconds, results.size() / seconds,
+                  totalTicks / seconds / 1e6);
+    out << line;
+    out << "Replay a match: pong --match <left> <right> <seed>  (seeds via --log)\n";
+}
+
+
+/*
+    Function: MatchResult Tournament::playMatch(const std::string& left, const std::string& right,
+                                                std::uint64_t seed, long maxTicks, std::ostream* log,
+                                                PaddleController* leftTally, PaddleController* rightTally)
+
+    Objective:
+        Play one deterministic headless match.
+
+    Input Parameters:
+        - left, right: Controller names.
+        - seed: Match seed; each controller gets its own derived seed.
+        - maxTicks: Step limit (the match is drawn if reached).
+        - log: Optional stream for a point-by-point log.
+        - leftTally, rightTally: Optional receivers of the players' statistics.
+
+    Return Value:
+        - MatchResult with scores and length (entrant indices unset).
+
+    Side Effects:
+        - Writes to log if given; adds to the tallies if given.
+
+    Approach:
+        - Fixed 1/60 s steps; both controllers decide from the same
+          pre-step state, exactly like the AI in interactive play.
+        - Controllers are created reproducible, so the result depends on
+          the seed alone, never on how fast the machine is.
+*/
+MatchResult Tournament::playMatch(const std::string& left, const std::string& right,
+                                  std::uint64_t seed, long maxTicks, std::ostream* log,
+                                  PaddleController* leftTally, PaddleController* rightTally) {
+    std::unique_ptr<PaddleController> leftController = createController(left, true);
+    std::unique_ptr<PaddleController> rightController = createController(right, true);
+
+    Match match(GameMode::PLAYER_VS_PLAYER, seed);
+    leftController->reset(mixSeed(seed, 1));
+    rightController->reset(mixSeed(seed, 2));
+
+    while (!match.isFinished() && match.getTick() < maxTicks) {
+        MatchInput input;
+        input.left  = leftController->decide(match, Side::LEFT, MATCH_DT);
+        input.right = rightController->decide(match, Side::RIGHT, MATCH_DT);
+
+        unsigned events = match.step(MATCH_DT, input);
+
+        if (log && (events & (MatchEvent::LEFT_SCORED | MatchEvent::RIGHT_SCORED))) {
+            *log << "  t=" << match.getTick() * MATCH_DT << "s  "
+                 << (events & MatchEvent::LEFT_SCORED ? left : right) << " scores  "
+                 << match.getLeftScore() << " : " << match.getRightScore() << "\n";
+        }
+    }
+
+    if (leftTally)
+        leftTally->addStatistics(*leftController);
+    if (rightTally)
+        rightTally->addStatistics(*rightController);
+
+    MatchResult result;
+    result.left = result.right = -1;
+    result.seed = seed;
+    result.leftScore = match.getLeftScore();
+    result.rightScore = match.getRightScore();
+    result.ticks = match.getTick();
+    result.round = 0;
+    return result;
+}
+
+
+/*
+    Function: std::vector<std::pair<int, int>> Tournament::makePairings(int round) const
+
+    Objective:
+        Decide who plays whom in a round.
+
+    Input Parameters:
+        - int round: Round number (unused by round-robin).
+
+    Return Value:
+        - List of (entrant, entrant) pairs.
+
+    Side Effects:
+        - None.
+
+    Approach:
+        - Round-robin: every unordered pair.
+        - Swiss: rank by points (then rating, then index) and pair each
+          unpaired entrant with the next one it has not met yet; fall back
+          to a rematch when no fresh opponent is left. Odd one out sits out.
+*/
+std::vector<std::pair<int, int>> Tournament::makePairings(int) const {
+    std::vector<std::pair<int, int>> pairs;
+    int count = static_cast<int>(standings.size());
+
+    if (!config.swiss) {
+        for (int a = 0; a < count; ++a)
+            for (int b = a + 1; b < count; ++b)
+                pairs.push_back(std::make_pair(a, b));
+        return pairs;
+    }
+
+    std::set<std::pair<int, int>> met;
+    for (const MatchResult& r : results)
+        met.insert(std::make_pair(std::min(r.left, r.right), std::max(r.left, r.right)));
+
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (standings[a].points != standings[b].points)
+            return standings[a].points > standings[b].points;
+        if (standings[a].glicko != standings[b].glicko)
+            return standings[a].glicko > standings[b].glicko;
+        return a < b;
+    });
+
+    std::vector<bool> paired(count, false);
+    for (int i = 0; i < count; ++i) {
+        int a = order[i];
+        if (paired[a])
+            continue;
+
+        int opponent = -1;
+        for (int j = i + 1; j < count && opponent < 0; ++j) {
+            int b = order[j];
+            if (!paired[b] && !met.count(std::make_pair(std::min(a, b), std::max(a, b))))
+                opponent = b;
+        }
+        for (int j = i + 1; j < count && opponent < 0; ++j) {
+            if (!paired[order[j]])
+                opponent = order[j];
+        }
+
+        if (opponent >= 0) {
+            paired[a] = paired[opponent] = true;
+            pairs.push_back(std::make_pair(a, opponent));
+        }
+    }
+    return pairs;
+}
+
+
+/*
+    Function: void Tournament::playRound(std::vector<MatchResult>& slots)
+
+    Objective:
+        Play a round's matches on all worker threads.
+
+    Input Parameters:
+        - std::vector<MatchResult>& slots: Matches to play (entrants + seeds set).
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Fills scores and ticks of every slot; adds to totalTicks and
+          to the entrants' statistics tallies.
+
+    Approach:
+        - Workers claim match indices from an atomic counter; each writes
+          only its own slot, so no locking is needed.
+        - Each worker tallies statistics in its own controllers and adds
+          them to the shared tallies once, under a mutex, when it is done.
+*/
+void Tournament::playRound(std::vector<MatchResult>& slots) {
+    std::atomic<std::size_t> next(0);
+    std::atomic<long long> ticks(0);
+    std::mutex talliesMutex;
+
+    auto worker = [&]() {
+        long long localTicks = 0;
+        std::vector<std::unique_ptr<PaddleController>> localTallies;
+        for (const EntrantStanding& standing : standings)
+            localTallies.push_back(createController(standing.name, true));
+
+        for (std::size_t i = next++; i < slots.size(); i = next++) {
+            MatchResult& slot = slots[i];
+            MatchResult played = playMatch(standings[slot.left].name, standings[slot.right].name,
+                                           slot.seed, config.maxMatchTicks, nullptr,
+                                           localTallies[slot.left].get(), localTallies[slot.right].get());
+            slot.leftScore = played.leftScore;
+            slot.rightScore = played.rightScore;
+            slot.ticks = played.ticks;
+            localTicks += played.ticks;
+        }
+        ticks += localTicks;
+
+        std::lock_guard<std::mutex> lock(talliesMutex);
+        for (std::size_t e = 0; e < tallies.size(); ++e)
+            tallies[e]->addStatistics(*localTallies[e]);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threadsUsed; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& t : workers)
+        t.join();
+
+    totalTicks += ticks;
+}
+
+
+/*
+    Function: void Tournament::rateRound(const std::vector<MatchResult>& round)
+
+    Objective:
+        Update records, Glicko ratings and Elo after a round.
+
+    Input Parameters:
+        - const std::vector<MatchResult>& round: The round's played matches.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Modifies standings.
+
+    Approach:
+        - Glicko-1: the round is one rating period; every entrant is
+          updated from pre-round ratings of its opponents.
+        - Elo: sequential K=4 updates in match-index order (deterministic).
+*/
+void Tournament::rateRound(const std::vector<MatchResult>& round) {
+    std::size_t count = standings.size();
+    std::vector<double> sumVariance(count, 0.0);   // Σ g² E (1 - E)
+    std::vector<double> sumSurprise(count, 0.0);   // Σ g (s - E)
+
+    for (const MatchResult& r : round) {
+        double s = leftPoints(r);
+        int players[2] = { r.left, r.right };
+        double scores[2] = { s, 1.0 - s };
+
+        for (int k = 0; k < 2; ++k) {
+            const EntrantStanding& me = standings[players[k]];
+            const EntrantStanding& them = standings[players[1 - k]];
+            double g = glickoG(them.deviation);
+            double e = expectedScore(me.glicko, them.glicko, g);
+            sumVariance[players[k]] += g * g * e * (1.0 - e);
+            sumSurprise[players[k]] += g * (scores[k] - e);
+        }
+
+        EntrantStanding& left = standings[r.left];
+        EntrantStanding& right = standings[r.right];
+        double eloExpected = expectedScore(left.elo, right.elo, 1.0);
+        left.elo  += ELO_K * (s - eloExpected);
+        right.elo -= ELO_K * (s - eloExpected);
+
+        if (s == 1.0) { left.wins++; right.losses++; }
+        else if (s == 0.0) { left.losses++; right.wins++; }
+        else { left.draws++; right.draws++; }
+        left.points += s;
+        right.points += 1.0 - s;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (sumVariance[i] <= 0.0)
+            continue;
+
+        EntrantStanding& me = standings[i];
+        double inverseD2 = GLICKO_Q * GLICKO_Q * sumVariance[i];
+        double precision = 1.0 / (me.deviation * me.deviation) + inverseD2;
+
+        me.glicko += GLICKO_Q / precision * sumSurprise[i];
+        me.deviation = std::max(MIN_DEVIATION, std::sqrt(1.0 / precision));
+    }
+}
+
+
+/*
+    Function: int runTournamentCommand(int argc, char** argv)
+
+    Objective:
+        Parse the tournament command line and run it.
+
+    Input Parameters:
+        - int argc, char** argv: Program arguments (argv[1] is the command).
+
+    Return Value:
+        - int: 0 on success, 1 on bad arguments.
+
+    Side Effects:
+        - Prints to stdout; may write a CSV log.
+
+    Approach:
+        - --list-controllers: print the registry.
+        - --match L R SEED: replay one match with a point-by-point log.
+        - --tournament: parse options, validate entrants, run, report.
+*/
+int runTournamentCommand(int argc, char** argv) {
+    std::string command = argv[1];
+
+    if (command == "--list-controllers") {
+        for (const ControllerInfo& info : getControllerRegistry())
+            std::printf("  %-10s %s\n", info.name, info.description);
+        return 0;
+    }
+
+    if (command == "--match") {
+        if (argc < 5 || !createController(argv[2]) || !createController(argv[3])) {
+            printUsage();
+            return 1;
+        }
+        std::uint64_t seed = std::strtoull(argv[4], nullptr, 10);
+        std::cout << argv[2] << " vs " << argv[3] << ", seed " << seed << "\n";
+
+        MatchResult r = Tournament::playMatch(argv[2], argv[3], seed, TournamentConfig().maxMatchTicks, &std::cout);
+        std::cout << "Final: " << r.leftScore << " : " << r.rightScore
+                  << " after " << r.ticks << " steps\n";
+        return 0;
+    }
+
+    TournamentConfig config;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--swiss")
+            config.swiss = true;
+        else if (arg == "--rounds" && hasValue)
+            config.rounds = std::atoi(argv[++i]);
+        else if (arg == "--games" && hasValue)
+            config.gamesPerPair = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && hasValue)
+            config.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--entrants" && hasValue)
+            config.entrants = splitList(argv[++i]);
+        else if (arg == "--max-seconds" && hasValue)
+            config.maxMatchTicks = static_cast<long>(std::atof(argv[++i]) / MATCH_DT);
+        else if (arg == "--log" && hasValue)
+            config.logPath = argv[++i];
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (config.entrants.empty()) {
+        for (const ControllerInfo& info : getControllerRegistry())
+            config.entrants.push_back(info.name);
+    }
+
+    for (const std::string& name : config.entrants) {
+        if (!createController(name)) {
+            std::cout << "Unknown controller: " << name << "\n";
+            return 1;
+        }
+    }
+
+    if (config.entrants.size() < 2 || config.rounds < 1 || config.gamesPerPair < 1) {
+        printUsage();
+        return 1;
+    }
+
+    Tournament tournament(config);
+    tournament.run();
+    tournament.printReport(std::cout);
+    return 0;
+}
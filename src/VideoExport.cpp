@@ -0,0 +1,635 @@
+#include "VideoExport.h"
+#include "Checksum.h"
+#include "EntityStore.h"
+#include "Game.h"
+#include "Match.h"
+#include "PaddleController.h"
+#include "SimState.h"
+#include "Tournament.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    // Glyph atlas of the UI font (as the game loads it)
+    const char* FONT_ATLAS_PATH = "assets/font.sdf";
+
+    // The PvP score line as Game::updateHud() lays it out (UI coordinates)
+    const unsigned SCORE_TEXT_SIZE = 28;
+    const float SCORE_TEXT_X = 640.f / 2.f - 40.f;
+    const float SCORE_TEXT_Y = 20.f;
+
+    // Effects pool: far more than a match ever has alive at once
+    const std::size_t EFFECT_PARTICLES = 8192;
+
+    // Simulation steps per second (the game's frame rate)
+    const int STEPS_PER_SECOND = 60;
+    const float MATCH_DT = 1.f / STEPS_PER_SECOND;
+
+    // Frames rendered ahead of the writer, per thread
+    const std::size_t FRAMES_AHEAD_PER_THREAD = 2;
+
+    // State of one video frame, recorded by the simulation pass
+    struct VideoFrame {
+        SimState rally;
+        MatchProgress progress;
+        std::size_t firstSprite;     // Into the shared sprite array
+        std::size_t spriteCount;
+    };
+
+    // A rendered frame waiting for the writer
+    struct FrameSlot {
+        std::vector<std::uint8_t> yuv;
+        std::uint32_t crc = 0;       // CRC-32 of yuv
+        long frame = -1;             // Frame held, -1 if none yet
+    };
+
+    // Sub-pixel precision of the rasterizer (1/256 pixel, 8 bits as GPUs snap)
+    const std::int64_t SUBPIXEL = 256;
+
+    // A vertex snapped to the sub-pixel grid
+    struct FixedPoint {
+        std::int64_t x;
+        std::int64_t y;
+    };
+
+    // Edge function: twice the signed area of (a, b, p), exact
+    inline std::int64_t edge(const FixedPoint& a, const FixedPoint& b, std::int64_t px, std::int64_t py) {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    }
+
+    /*
+        Top-left rule for an edge a → b of a triangle with positive
+        area: pixels exactly on a top or left edge belong to it, those
+        on a bottom or right edge to the neighbour. Ties are exact
+        because the edge functions are integers.
+    */
+    inline bool isTopLeft(const FixedPoint& a, const FixedPoint& b) {
+        std::int64_t dx = b.x - a.x, dy = b.y - a.y;
+        return dy < 0 || (dy == 0 && dx > 0);
+    }
+
+    // Bilinear distance (0..1) at atlas pixel coordinates, as the smooth texture samples it
+    float sampleDistance(const SdfFont& font, float u, float v) {
+        const std::uint8_t* atlas = font.getDistances();
+        int height = static_cast<int>(font.getAtlasHeight());
+        int width = static_cast<int>(SDF_ATLAS_WIDTH);
+
+        float x = u - 0.5f, y = v - 0.5f;
+        int x0 = static_cast<int>(std::floor(x)), y0 = static_cast<int>(std::floor(y));
+        float fx = x - x0, fy = y - y0;
+
+        int xa = std::min(std::max(x0, 0), width - 1), xb = std::min(std::max(x0 + 1, 0), width - 1);
+        int ya = std::min(std::max(y0, 0), height - 1), yb = std::min(std::max(y0 + 1, 0), height - 1);
+
+        float top = atlas[ya * width + xa] + (atlas[ya * width + xb] - atlas[ya * width + xa]) * fx;
+        float bottom = atlas[yb * width + xa] + (atlas[yb * width + xb] - atlas[yb * width + xa]) * fx;
+        return (top + (bottom - top) * fy) / 255.f;
+    }
+
+    float smoothstep(float edge0, float edge1, float x) {
+        float t = std::min(std::max((x - edge0) / (edge1 - edge0), 0.f), 1.f);
+        return t * t * (3.f - 2.f * t);
+    }
+}
+
+
+/*
+    Constructor: SoftwareCanvas::SoftwareCanvas(unsigned width, unsigned height)
+
+    Objective:
+        Allocate a black frame with an identity mapping.
+*/
+SoftwareCanvas::SoftwareCanvas(unsigned width, unsigned height)
+    : width(width),
+      height(height),
+      rgb(std::size_t(width) * height * 3, 0),
+      scale(1.f, 1.f),
+      offset(0.f, 0.f)
+{
+}
+
+
+void SoftwareCanvas::clear(sf::Color color) {
+    if (color.r == color.g && color.g == color.b) {
+        std::memset(rgb.data(), color.r, rgb.size());
+        return;
+    }
+
+    // One row by pixel, the others copied from it
+    std::size_t stride = std::size_t(width) * 3;
+    for (std::size_t i = 0; i < stride; i += 3) {
+        rgb[i] = color.r;
+        rgb[i + 1] = color.g;
+        rgb[i + 2] = color.b;
+    }
+    for (std::size_t y = 1; y < height; ++y)
+        std::memcpy(&rgb[y * stride], rgb.data(), stride);
+}
+
+
+void SoftwareCanvas::setMapping(const sf::FloatRect& source, const sf::FloatRect& pixels) {
+    scale = sf::Vector2f(pixels.width / source.width, pixels.height / source.height);
+    offset = sf::Vector2f(pixels.left - source.left * scale.x, pixels.top - source.top * scale.y);
+}
+
+
+void SoftwareCanvas::fillTriangles(const sf::Vertex* vertices, std::size_t count) {
+    rasterize<false>(vertices, count, sf::Transform::Identity, nullptr);
+}
+
+
+void SoftwareCanvas::drawText(const SdfText& text, const SdfFont& font) {
+    const std::vector<sf::Vertex>& vertices = text.getVertices();
+    if (!vertices.empty() && font.getDistances())
+        rasterize<true>(vertices.data(), vertices.size(), text.getTransform(), &font);
+}
+
+
+/*
+    Function: void SoftwareCanvas::rasterize<Textured>(const sf::Vertex* vertices, std::size_t count,
+                                                       const sf::Transform& transform, const SdfFont* font)
+
+    Objective:
+        Scan-convert triangles into the frame.
+
+    Input Parameters:
+        - vertices, count: sf::Triangles geometry.
+        - transform: Applied before the view mapping (text position).
+        - font: Distance atlas of textured (text) triangles.
+
+    Return Value:
+        - void
+
+    Side Effects:
+        - Writes the covered pixels.
+
+    Approach:
+        - Map the corners to pixels, snapped to 1/256 pixel, and orient
+          the triangle counter-clockwise; walk the bounding box of pixel
+          centers with the three edge functions stepped incrementally in
+          integers, so a center on an edge shared by two triangles is an
+          exact tie the top-left rule gives to exactly one of them.
+        - Opaque solid colour: store. Otherwise blend by alpha.
+        - Text: the barycentric weights interpolate the atlas
+          coordinates; the distance's change to the neighbouring pixels
+          (right and below) stands in for the shader's fwidth().
+*/
+template <bool Textured>
+void SoftwareCanvas::rasterize(const sf::Vertex* vertices, std::size_t count, const sf::Transform& transform,
+                               const SdfFont* font) {
+    for (std::size_t t = 0; t + 2 < count; t += 3) {
+        const sf::Vertex* v[3] = { &vertices[t], &vertices[t + 1], &vertices[t + 2] };
+        FixedPoint p[3];
+        for (int k = 0; k < 3; ++k) {
+            sf::Vector2f q = transform.transformPoint(v[k]->position.x, v[k]->position.y);
+            p[k].x = std::llround((offset.x + q.x * scale.x) * SUBPIXEL);
+            p[k].y = std::llround((offset.y + q.y * scale.y) * SUBPIXEL);
+        }
+
+        std::int64_t area = edge(p[0], p[1], p[2].x, p[2].y);
+        if (area == 0)
+            continue;
+        if (area < 0) {
+            std::swap(p[1], p[2]);
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+
+        std::int64_t lowX = std::min({ p[0].x, p[1].x, p[2].x }), highX = std::max({ p[0].x, p[1].x, p[2].x });
+        std::int64_t lowY = std::min({ p[0].y, p[1].y, p[2].y }), highY = std::max({ p[0].y, p[1].y, p[2].y });
+        int minX = static_cast<int>(std::max<std::int64_t>(0, lowX / SUBPIXEL - 1));
+        int minY = static_cast<int>(std::max<std::int64_t>(0, lowY / SUBPIXEL - 1));
+        int maxX = static_cast<int>(std::min<std::int64_t>(width - 1, highX / SUBPIXEL + 1));
+        int maxY = static_cast<int>(std::min<std::int64_t>(height - 1, highY / SUBPIXEL + 1));
+        if (minX > maxX || minY > maxY)
+            continue;
+
+        // w0 weighs vertex 0 (edge 1 → 2), w1 vertex 1, w2 vertex 2
+        const FixedPoint* a[3] = { &p[1], &p[2], &p[0] };
+        const FixedPoint* b[3] = { &p[2], &p[0], &p[1] };
+        std::int64_t stepX[3], stepY[3], row[3];
+        bool inclusive[3];
+        for (int k = 0; k < 3; ++k) {
+            stepX[k] = -(b[k]->y - a[k]->y) * SUBPIXEL;
+            stepY[k] = (b[k]->x - a[k]->x) * SUBPIXEL;
+            row[k] = edge(*a[k], *b[k], minX * SUBPIXEL + SUBPIXEL / 2, minY * SUBPIXEL + SUBPIXEL / 2);
+            inclusive[k] = isTopLeft(*a[k], *b[k]);
+        }
+
+        sf::Color color = v[0]->color;
+        bool opaque = !Textured && color.a == 255;
+
+        for (int y = minY; y <= maxY; ++y) {
+            std::int64_t w[3] = { row[0], row[1], row[2] };
+            std::uint8_t* pixel = &rgb[(std::size_t(y) * width + minX) * 3];
+
+            for (int x = minX; x <= maxX; ++x, pixel += 3) {
+                bool inside = true;
+                for (int k = 0; k < 3; ++k)
+                    inside = inside && (w[k] > 0 || (w[k] == 0 && inclusive[k]));
+
+                if (inside) {
+                    if (opaque) {
+                        pixel[0] = color.r;
+                        pixel[1] = color.g;
+                        pixel[2] = color.b;
+                    }
+                    else if (!Textured) {
+                        blend(pixel, color, color.a);
+                    }
+                    else {
+                        float total = static_cast<float>(area);
+                        float b0 = w[0] / total, b1 = w[1] / total, b2 = w[2] / total;
+                        float u = b0 * v[0]->texCoords.x + b1 * v[1]->texCoords.x + b2 * v[2]->texCoords.x;
+                        float tv = b0 * v[0]->texCoords.y + b1 * v[1]->texCoords.y + b2 * v[2]->texCoords.y;
+
+                        // Atlas pixels per frame pixel along x and y
+                        float dux = (stepX[0] * v[0]->texCoords.x + stepX[1] * v[1]->texCoords.x +
+                                     stepX[2] * v[2]->texCoords.x) / total;
+                        float dvy = (stepY[0] * v[0]->texCoords.y + stepY[1] * v[1]->texCoords.y +
+                                     stepY[2] * v[2]->texCoords.y) / total;
+
+                        float distance = sampleDistance(*font, u, tv);
+                        float change = std::fabs(sampleDistance(*font, u + dux, tv) - distance) +
+                                       std::fabs(sampleDistance(*font, u, tv + dvy) - distance);
+                        float spread = std::max(change * 0.7f, 0.001f);
+                        float alpha = smoothstep(0.5f - spread, 0.5f + spread, distance);
+
+                        unsigned a8 = static_cast<unsigned>(alpha * color.a + 0.5f);
+                        if (a8 > 0)
+                            blend(pixel, color, a8);
+                    }
+                }
+
+                for (int k = 0; k < 3; ++k)
+                    w[k] += stepX[k];
+            }
+
+            for (int k = 0; k < 3; ++k)
+                row[k] += stepY[k];
+        }
+    }
+}
+
+
+/*
+    Function: void SoftwareCanvas::fillParticles(const ParticleSprite* sprites, std::size_t count)
+
+    Objective:
+        Draw particle squares as ParticleSystem::draw() does.
+
+    Approach:
+        - Each square is axis-aligned: the pixels whose centers fall in
+          [left, right) x [top, bottom) (the triangle rule for a box),
+          blended with the particle's alpha.
+*/
+void SoftwareCanvas::fillParticles(const ParticleSprite* sprites, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const ParticleSprite& sprite = sprites[i];
+        float left = offset.x + (sprite.x - PARTICLE_HALF_SIZE) * scale.x;
+        float right = offset.x + (sprite.x + PARTICLE_HALF_SIZE) * scale.x;
+        float top = offset.y + (sprite.y - PARTICLE_HALF_SIZE) * scale.y;
+        float bottom = offset.y + (sprite.y + PARTICLE_HALF_SIZE) * scale.y;
+
+        int x0 = std::max(0, static_cast<int>(std::ceil(left - 0.5f)));
+        int x1 = std::min(static_cast<int>(width), static_cast<int>(std::ceil(right - 0.5f)));
+        int y0 = std::max(0, static_cast<int>(std::ceil(top - 0.5f)));
+        int y1 = std::min(static_cast<int>(height), static_cast<int>(std::ceil(bottom - 0.5f)));
+
+        for (int y = y0; y < y1; ++y)
+            for (int x = x0; x < x1; ++x)
+                blend(&rgb[(std::size_t(y) * width + x) * 3], sprite.color, sprite.color.a);
+    }
+}
+
+
+// Source-over blending of one pixel (alpha 0..255)
+void SoftwareCanvas::blend(std::uint8_t* pixel, sf::Color color, unsigned alpha) {
+    unsigned keep = 255 - alpha;
+    pixel[0] = static_cast<std::uint8_t>((color.r * alpha + pixel[0] * keep + 127) / 255);
+    pixel[1] = static_cast<std::uint8_t>((color.g * alpha + pixel[1] * keep + 127) / 255);
+    pixel[2] = static_cast<std::uint8_t>((color.b * alpha + pixel[2] * keep + 127) / 255);
+}
+
+
+/*
+    Function: void SoftwareCanvas::toYuv420(std::uint8_t* out) const
+
+    Objective:
+        Convert the frame for a Y4M "C420jpeg" stream.
+
+    Input Parameters:
+        - std::uint8_t* out: width * height * 3 / 2 bytes.
+
+    Return Value:
+        - void
+
+    Approach:
+        - BT.601 video-range integer coefficients; chroma from the mean
+          of each 2x2 block (centered siting, as C420jpeg declares).
+        - One pass over pairs of rows: each 2x2 block is read once for
+          its four luma samples and its chroma.
+*/
+void SoftwareCanvas::toYuv420(std::uint8_t* out) const {
+    const unsigned halfWidth = width / 2;
+    std::uint8_t* lumaPlane = out;
+    std::uint8_t* uPlane = out + std::size_t(width) * height;
+    std::uint8_t* vPlane = uPlane + std::size_t(halfWidth) * (height / 2);
+
+    for (unsigned y = 0; y < height; y += 2) {
+        const std::uint8_t* top = &rgb[std::size_t(y) * width * 3];
+        const std::uint8_t* bottom = top + std::size_t(width) * 3;
+        std::uint8_t* lumaTop = lumaPlane + std::size_t(y) * width;
+        std::uint8_t* lumaBottom = lumaTop + width;
+        std::uint8_t* u = uPlane + std::size_t(y / 2) * halfWidth;
+        std::uint8_t* v = vPlane + std::size_t(y / 2) * halfWidth;
+
+        for (unsigned x = 0; x < halfWidth; ++x, top += 6, bottom += 6) {
+            // Read the block first: the planes are bytes too, so the
+            // compiler could not otherwise keep the inputs in registers
+            int r0 = top[0], g0 = top[1], b0 = top[2], r1 = top[3], g1 = top[4], b1 = top[5];
+            int r2 = bottom[0], g2 = bottom[1], b2 = bottom[2], r3 = bottom[3], g3 = bottom[4], b3 = bottom[5];
+
+            lumaTop[2 * x]        = static_cast<std::uint8_t>(((66 * r0 + 129 * g0 + 25 * b0 + 128) >> 8) + 16);
+            lumaTop[2 * x + 1]    = static_cast<std::uint8_t>(((66 * r1 + 129 * g1 + 25 * b1 + 128) >> 8) + 16);
+            lumaBottom[2 * x]     = static_cast<std::uint8_t>(((66 * r2 + 129 * g2 + 25 * b2 + 128) >> 8) + 16);
+            lumaBottom[2 * x + 1] = static_cast<std::uint8_t>(((66 * r3 + 129 * g3 + 25 * b3 + 128) >> 8) + 16);
+
+            int r = (r0 + r1 + r2 + r3 + 2) >> 2;
+            int g = (g0 + g1 + g2 + g3 + 2) >> 2;
+            int b = (b0 + b1 + b2 + b3 + 2) >> 2;
+            u[x] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v[x] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+
+unsigned SoftwareCanvas::getWidth() const {
+    return width;
+}
+
+unsigned SoftwareCanvas::getHeight() const {
+    return height;
+}
+
+const std::uint8_t* SoftwareCanvas::getPixels() const {
+    return rgb.data();
+}
+
+
+/*
+    Function: int runVideoCommand(int argc, char** argv)
+
+    Objective:
+        Export a replayed AI match as a Y4M video.
+
+    Input Parameters:
+        - int argc, char** argv: --render-video LEFT RIGHT SEED OUT.y4m
+          [--fps N] [--scale S] [--threads N]
+
+    Return Value:
+        - int: Exit code.
+
+    Side Effects:
+        - Writes the video; prints timings and a CRC of the frames.
+
+    Approach:
+        - Simulation (one thread): the loop of Tournament::playMatch()
+          (reproducible controllers seeded with mixSeed(seed, 1/2), same
+          step limit)
+          plus the game's effects: particles age, the match steps,
+          emitMatchEffects() – Game::update()'s order. Every kept frame
+          records the rally, the progress and the live particles.
+        - Rendering (all cores): each worker owns a Match it restores
+          to the frame's state (Match::restore(), as time travel does),
+          an EntityRenderer batch, the score text and a canvas, so
+          workers share nothing but the frame counter. A worker claims
+          the next frame only while it is within the reorder window of
+          the writer, renders it, converts it to YUV into its slot and
+          checksums it.
+        - Writing (main thread): waits for each frame in turn, writes
+          it and frees its slot for the frame one window ahead. The
+          printed CRC chains the frames' CRCs, so checksumming stays
+          off the one serial thread.
+*/
+int runVideoCommand(int argc, char** argv) {
+    const char* usage =
+        "Usage:\n  pong --render-video LEFT RIGHT SEED OUT.y4m [--fps N] [--scale S] [--threads N]\n"
+        "  (controllers: see --list-controllers; N divides 60; S in 0.25..4)\n";
+
+    if (argc < 6 || !createController(argv[2]) || !createController(argv[3])) {
+        std::cout << usage;
+        return 1;
+    }
+
+    std::string left = argv[2], right = argv[3], path = argv[5];
+    std::uint64_t seed = std::strtoull(argv[4], nullptr, 10);
+    int fps = STEPS_PER_SECOND;
+    float scale = 1.f;
+    unsigned threads = 0;
+
+    for (int i = 6; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--fps" && i + 1 < argc)
+            fps = std::atoi(argv[++i]);
+        else if (option == "--scale" && i + 1 < argc)
+            scale = static_cast<float>(std::atof(argv[++i]));
+        else if (option == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else {
+            std::cout << usage;
+            return 1;
+        }
+    }
+    if (fps <= 0 || fps > STEPS_PER_SECOND || STEPS_PER_SECOND % fps != 0 || !(scale >= 0.25f && scale <= 4.f)) {
+        std::cout << usage;
+        return 1;
+    }
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const long stride = STEPS_PER_SECOND / fps;
+    const Arena& arena = CLASSIC_ARENA;
+
+    // ---------- Simulation: record every kept frame ----------
+    Clock::time_point start = Clock::now();
+
+    std::unique_ptr<PaddleController> leftController = createController(left, true);
+    std::unique_ptr<PaddleController> rightController = createController(right, true);
+    leftController->reset(mixSeed(seed, 1));
+    rightController->reset(mixSeed(seed, 2));
+
+    Match match(GameMode::PLAYER_VS_PLAYER, seed, arena);
+    ParticleSystem particles(EFFECT_PARTICLES);
+    std::vector<VideoFrame> frames;
+    std::vector<ParticleSprite> sprites;
+    const long maxTicks = TournamentConfig().maxMatchTicks;
+
+    while (!match.isFinished() && match.getTick() < maxTicks) {
+        MatchInput input;
+        input.left  = leftController->decide(match, Side::LEFT, MATCH_DT);
+        input.right = rightController->decide(match, Side::RIGHT, MATCH_DT);
+
+        particles.update(MATCH_DT);
+
+        sf::FloatRect before = match.getBallBounds();
+        unsigned events = match.step(MATCH_DT, input);
+        emitMatchEffects(particles, events, before.top + before.height / 2.f,
+                         match.getBallBounds(), arena.width);
+
+        if (match.getTick() % stride == 0) {
+            VideoFrame frame = { captureState(match), match.getProgress(), sprites.size(), 0 };
+            particles.getSprites(sprites);
+            frame.spriteCount = sprites.size() - frame.firstSprite;
+            frames.push_back(frame);
+        }
+    }
+    double simulateSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // ---------- Output geometry ----------
+    sf::Vector2u window = gameWindowSize(arena);
+    unsigned width = std::max(2u, static_cast<unsigned>(window.x * scale / 2.f + 0.5f) * 2);
+    unsigned height = std::max(2u, static_cast<unsigned>(window.y * scale / 2.f + 0.5f) * 2);
+    sf::FloatRect fieldPixels(0.f, 0.f, static_cast<float>(width), static_cast<float>(height));
+    sf::FloatRect ui = gameUiRect(window);
+    float sx = width / static_cast<float>(window.x), sy = height / static_cast<float>(window.y);
+    sf::FloatRect uiPixels(ui.left * sx, ui.top * sy, ui.width * sx, ui.height * sy);
+
+    SdfFont font;
+    if (!font.loadFromFile(FONT_ATLAS_PATH, false))
+        std::cout << "Failed to load font atlas " << FONT_ATLAS_PATH << ": the score is not drawn\n";
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cout << "Failed to write " << path << "\n";
+        return 1;
+    }
+    std::vector<char> fileBuffer(1 << 20);
+    std::setvbuf(file, fileBuffer.data(), _IOFBF, fileBuffer.size());
+    std::fprintf(file, "YUV4MPEG2 W%u H%u F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+
+    // ---------- Rendering (workers) and writing (this thread) ----------
+    start = Clock::now();
+    const std::size_t frameBytes = std::size_t(width) * height * 3 / 2;
+    const long total = static_cast<long>(frames.size());
+    const std::size_t window_ = FRAMES_AHEAD_PER_THREAD * threads;
+
+    std::vector<FrameSlot> slots(window_);
+    for (FrameSlot& slot : slots)
+        slot.yuv.resize(frameBytes);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    long claimed = 0, written = 0;
+    bool failed = false;
+
+    auto worker = [&]() {
+        Match view(GameMode::PLAYER_VS_PLAYER, seed, arena);
+        EntityRenderer entities;
+        SdfText score;
+        score.setFont(font);
+        score.setCharacterSize(SCORE_TEXT_SIZE);
+        score.setFillColor(sf::Color::White);
+        score.setPosition(SCORE_TEXT_X, SCORE_TEXT_Y);
+        SoftwareCanvas canvas(width, height);
+        char text[32];
+
+        for (;;) {
+            long index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() {
+                    return failed || claimed >= total || claimed < written + static_cast<long>(window_);
+                });
+                if (failed || claimed >= total)
+                    return;
+                index = claimed++;
+            }
+
+            const VideoFrame& frame = frames[index];
+            view.restore(frame.rally, frame.progress);
+
+            canvas.clear(sf::Color::Black);
+            canvas.setMapping(sf::FloatRect(0.f, 0.f, arena.width, arena.height), fieldPixels);
+            entities.begin();
+            entities.add(view.getEntities(), sf::Vector2f(0.f, 0.f), 1.f);
+            canvas.fillTriangles(entities.getVertices(), entities.getVertexCount());
+            canvas.fillParticles(sprites.data() + frame.firstSprite, frame.spriteCount);
+
+            std::snprintf(text, sizeof(text), "%d : %d", view.getLeftScore(), view.getRightScore());
+            score.setString(text);
+            canvas.setMapping(sf::FloatRect(0.f, 0.f, 640.f, 600.f), uiPixels);
+            canvas.drawText(score, font);
+
+            FrameSlot& slot = slots[index % window_];
+            canvas.toYuv420(slot.yuv.data());
+            slot.crc = crc32(slot.yuv.data(), frameBytes);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot.frame = index;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i)
+        pool.emplace_back(worker);
+
+    std::uint32_t crc = 0;
+    for (long index = 0; index < total && !failed; ++index) {
+        FrameSlot& slot = slots[index % window_];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return slot.frame == index; });
+        }
+
+        crc = crc32(&slot.crc, sizeof(slot.crc), crc);
+        bool ok = std::fputs("FRAME\n", file) >= 0 &&
+                  std::fwrite(slot.yuv.data(), 1, frameBytes, file) == frameBytes;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written = index + 1;
+            failed = !ok;
+        }
+        changed.notify_all();
+    }
+
+    for (std::thread& thread : pool)
+        thread.join();
+    bool ok = !failed && std::fclose(file) == 0;
+    double renderSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (!ok) {
+        std::cout << "Failed to write " << path << "\n";
+        return 1;
+    }
+
+    char line[300];
+    std::cout << left << " vs " << right << ", seed " << seed << ": " << match.getLeftScore()
+              << " : " << match.getRightScore() << " after " << match.getTick() << " steps\n";
+    std::snprintf(line, sizeof(line),
+                  "Simulated in %.1f ms (%zu particle sprites recorded)\n"
+                  "Rendered %ld frames of %ux%u at %d fps (%.1f s of video) on %u threads in %.2f s = %.0f frames/s\n"
+                  "Wrote %s: %.1f MB, frames crc32 %08x\n",
+                  simulateSeconds * 1000.0, sprites.size(),
+                  total, width, height, fps, double(total) / fps, threads, renderSeconds,
+                  renderSeconds > 0.0 ? total / renderSeconds : 0.0,
+                  path.c_str(), total * double(frameBytes + 6) / (1024.0 * 1024.0), crc);
+    std::cout << line;
+    return 0;
+}
@@ -7,7 +7,40 @@
 ///     by calling game.run().
 ///
 /// Input Parameters:
-///     None (program starts without any command-line arguments)
+///     argc, argv -> Optional command. Without one the game
+///                   window opens; headless commands:
+///                     --tournament ...     AI tournament
+///                     --match L R SEED     replay one AI match
+///                     --list-controllers   list AI entrants
+///                     --train-policy ...   train the neural AI
+///                     --policy-check ...   int8 accuracy/throughput
+///                     --snapshot-check ... network snapshot round trips
+///                     --render-audio L R SEED OUT.wav
+///                                          a replayed match's sound
+///                     --render-video L R SEED OUT.y4m ...
+///                                          the same match as a video
+///                     --alloc-check ...    heap allocations per frame
+///                     --golden-check ...   gameplay regression suite
+///                     --golden-update ...  (and --golden-trace INDEX)
+///                     --stats-query ...    aggregate the match stats
+///                     --stats-generate N   synthetic stats for queries
+///                     --verify-scores ...  replay and rank score
+///                                          submissions
+///                     --submissions-generate N ...
+///                                          synthetic submissions
+///                   Game options:
+///                     --ai NAME            AI opponent (e.g. search)
+///                     --arena NAME|WxH     arena preset (classic, wide,
+///                                          tiny, tournament) or size
+///                     --metrics-port PORT  serve Prometheus metrics on
+///                                          127.0.0.1:PORT/metrics
+///                     --observatory N      open with N AI-vs-AI matches
+///                                          (16..256) in one window
+///                     --vs NAME            observatory: left paddles'
+///                                          AI (default: as --ai)
+///                     --bot left|right     that paddle is played by an
+///                                          external bot (pong-bot)
+///                     --bot-link NAME      its shared memory (/pong-bot)
 ///
 /// Return Values:
 ///     int -> Returns 0 on successful execution.
@@ -20,16 +53,139 @@
 ///       the application may terminate early.
 ///
 /// Approach:
-///     - Instantiate a Game object.
+///     - Dispatch headless commands to their runners.
+///     - Otherwise parse the game options, start the metrics
+///       endpoint if asked, and instantiate a Game object
+///       (opening the observatory or the bot link if asked).
 ///     - Call the run() function to start the main game loop.
 ///     - Return 0 after the game loop ends.
 ///
 //////////////////////////////////////////////////////////////
 
+#include "AudioEngine.h"
+#include "BotController.h"
+#include "FrameArena.h"
 #include "Game.h"
+#include "GoldenCheck.h"
+#include "Metrics.h"
+#include "PaddleController.h"
+#include "PolicyTraining.h"
+#include "ScoreVerifier.h"
+#include "SnapshotCheck.h"
+#include "StatsQuery.h"
+#include "Tournament.h"
+#include "VideoExport.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
 
-int main() {
-    Game game;
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        std::string command = argv[1];
+        if (command == "--tournament" || command == "--match" || command == "--list-controllers")
+            return runTournamentCommand(argc, argv);
+        if (command == "--train-policy" || command == "--policy-check")
+            return runPolicyCommand(argc, argv);
+        if (command == "--snapshot-check")
+            return runSnapshotCommand(argc, argv);
+        if (command == "--render-audio")
+            return runAudioCommand(argc, argv);
+        if (command == "--render-video")
+            return runVideoCommand(argc, argv);
+        if (command == "--alloc-check")
+            return runAllocationCommand(argc, argv);
+        if (command == "--golden-check" || command == "--golden-update" || command == "--golden-trace")
+            return runGoldenCommand(argc, argv);
+        if (command == "--stats-query" || command == "--stats-generate")
+            return runStatsCommand(argc, argv);
+        if (command == "--verify-scores" || command == "--submissions-generate")
+            return runScoreCommand(argc, argv);
+    }
+
+    std::string aiName = "chase";
+    std::string opponentName;
+    long observatoryMatches = 0;
+    Arena arena = CLASSIC_ARENA;
+    std::unique_ptr<MetricsExporter> metrics;
+    std::string botSide;
+    std::string botLinkName = BOT_LINK_DEFAULT_NAME;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+
+        if (option == "--ai" && i + 1 < argc) {
+            aiName = argv[++i];
+            if (!createController(aiName)) {
+                std::cout << "Unknown AI '" << aiName << "' (see --list-controllers)\n";
+                return 1;
+            }
+        }
+        else if (option == "--arena" && i + 1 < argc) {
+            std::string error;
+            if (!parseArena(argv[++i], arena, error)) {
+                std::cout << "Invalid arena: " << error << "\n";
+                return 1;
+            }
+        }
+        else if (option == "--observatory" && i + 1 < argc) {
+            observatoryMatches = std::strtol(argv[++i], nullptr, 10);
+            if (observatoryMatches < static_cast<long>(OBSERVATORY_MIN_MATCHES) ||
+                observatoryMatches > static_cast<long>(OBSERVATORY_MAX_MATCHES)) {
+                std::cout << "Observatory matches must be " << OBSERVATORY_MIN_MATCHES
+                          << ".." << OBSERVATORY_MAX_MATCHES << "\n";
+                return 1;
+            }
+        }
+        else if (option == "--vs" && i + 1 < argc) {
+            opponentName = argv[++i];
+            if (!createController(opponentName)) {
+                std::cout << "Unknown AI '" << opponentName << "' (see --list-controllers)\n";
+                return 1;
+            }
+        }
+        else if (option == "--bot" && i + 1 < argc) {
+            botSide = argv[++i];
+            if (botSide != "left" && botSide != "right") {
+                std::cout << "--bot takes 'left' or 'right'\n";
+                return 1;
+            }
+        }
+        else if (option == "--bot-link" && i + 1 < argc) {
+            botLinkName = argv[++i];
+        }
+        else if (option == "--metrics-port" && i + 1 < argc) {
+            long port = std::strtol(argv[++i], nullptr, 10);
+            if (port <= 0 || port > 65535) {
+                std::cout << "Invalid metrics port '" << argv[i] << "'\n";
+                return 1;
+            }
+
+            std::string error;
+            metrics.reset(new MetricsExporter(static_cast<std::uint16_t>(port)));
+            if (!metrics->start(error)) {
+                std::cout << "Metrics endpoint: " << error << "\n";
+                return 1;
+            }
+        }
+        else {
+            std::cout << "Unknown option '" << option << "'\n";
+            return 1;
+        }
+    }
+
+    Game game(false, aiName, arena);
+    if (!botSide.empty()) {
+        std::unique_ptr<BotLink> link(new BotLink(botLinkName, BotLinkMode::CREATE));
+        if (!link->isOpen())
+            return 1;
+        std::cout << "Bot link " << botLinkName << " open for the " << botSide << " paddle\n";
+        game.attachBot(botSide == "left" ? Side::LEFT : Side::RIGHT,
+                       std::unique_ptr<PaddleController>(new BotController(std::move(link))));
+    }
+    if (observatoryMatches > 0)
+        game.openObservatory(static_cast<std::size_t>(observatoryMatches),
+                             opponentName.empty() ? aiName : opponentName, aiName);
     game.run();
     return 0;
 }
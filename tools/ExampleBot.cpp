@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////
+/// File: tools/ExampleBot.cpp
+/// ---------------------------------------------------------
+/// Objective:
+///     Example of an external paddle controller: a separate
+///     process that plays one paddle of a running game through
+///     the shared-memory bot link (see BotLink.h).
+///
+/// Input Parameters:
+///     argc, argv -> pong-bot [--link NAME] [--queries N]
+///                   NAME: shm name of the game's link
+///                         (default /pong-bot)
+///                   N:    stop after N answers (default:
+///                         until the game exits)
+///
+/// Return Values:
+///     int -> 0 when done, 1 if the link cannot be opened.
+///
+/// Side Effects:
+///     - Maps the link; prints how many queries it answered.
+///
+/// Approach:
+///     - Start the game with ./pong --bot left (or right),
+///       then run ./pong-bot.
+///     - Poll the state ring until a new query appears, read
+///       it, publish the answer: the hot loop is loads,
+///       stores and pause hints only.
+///     - Strategy: while the ball comes toward us, go to
+///       where it will cross our paddle's column (walls
+///       unfolded); otherwise return to the center.
+///     - When no query has come for a while, check that the
+///       game still has the link open and exit if not.
+///
+//////////////////////////////////////////////////////////////
+
+#include "BotLink.h"
+#include "GameTypes.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    // Silence after which the bot checks whether the game is still there
+    const std::chrono::seconds IDLE_CHECK(2);
+
+    // Steps per second of the game: half a step of movement is "close enough"
+    const float STEP_DT = 1.f / 60.f;
+
+    // Height at which the ball will cross the column x (walls unfolded)
+    float interceptY(const BotState& state, float x) {
+        float t = (x - state.ballX) / state.ballVX;
+        float y = state.ballY + state.ballVY * t;
+
+        float span = state.arenaHeight;
+        float folded = std::fmod(std::fabs(y), 2.f * span);
+        return folded > span ? 2.f * span - folded : folded;
+    }
+
+    PaddleAction play(const BotState& state) {
+        float column = state.side == 0 ? 0.f : state.arenaWidth;
+        bool approaching = state.side == 0 ? state.ballVX < 0.f : state.ballVX > 0.f;
+        float target = approaching ? interceptY(state, column) : state.arenaHeight / 2.f;
+
+        float margin = state.paddleSpeed * STEP_DT / 2.f;
+        if (target < state.paddleY - margin)
+            return PaddleAction::UP;
+        if (target > state.paddleY + margin)
+            return PaddleAction::DOWN;
+        return PaddleAction::STAY;
+    }
+
+    // Whether the game still has the link (it removes the name on exit)
+    bool linkExists(const std::string& name) {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            return false;
+        ::close(fd);
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string name = BOT_LINK_DEFAULT_NAME;
+    unsigned long long limit = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--link" && i + 1 < argc) {
+            name = argv[++i];
+        }
+        else if (option == "--queries" && i + 1 < argc) {
+            limit = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            std::cout << "Usage: pong-bot [--link NAME] [--queries N]\n";
+            return 1;
+        }
+    }
+
+    BotLink link(name, BotLinkMode::ATTACH);
+    if (!link.isOpen())
+        return 1;
+    std::cout << "Playing through " << name << "\n";
+
+    std::uint64_t seen = link.getStatesPublished();
+    unsigned long long answered = 0;
+    Clock::time_point lastQuery = Clock::now();
+    unsigned spins = 0;
+
+    while (limit == 0 || answered < limit) {
+        std::uint64_t published = link.getStatesPublished();
+        if (published == seen) {
+            spinPause(spins);
+            if (spins % 4096 == 0 && Clock::now() - lastQuery > IDLE_CHECK) {
+                if (!linkExists(name))
+                    break;
+                lastQuery = Clock::now();
+            }
+            continue;
+        }
+
+        BotState state;
+        if (!link.readState(state))
+            continue;
+        seen = published;
+        spins = 0;
+
+        BotCommand command = {};
+        command.query = state.query;
+        command.action = static_cast<std::int32_t>(play(state));
+        link.publishCommand(command);
+
+        ++answered;
+        lastQuery = Clock::now();
+    }
+
+    std::cout << "Answered " << answered << " queries\n";
+    return 0;
+}
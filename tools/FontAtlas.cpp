@@ -0,0 +1,304 @@
+//////////////////////////////////////////////////////////////
+/// File: tools/FontAtlas.cpp
+/// ---------------------------------------------------------
+/// Objective:
+///     Build step that turns the UI TrueType font into the
+///     signed-distance-field glyph atlas loaded by SdfFont
+///     (see SdfFont.h for the SDF1 format).
+///
+/// Input Parameters:
+///     argc, argv -> font-atlas FONT.ttf OUT.sdf
+///
+/// Return Values:
+///     int -> 0 on success, 1 on bad arguments, an unreadable
+///            font or an unwritable output.
+///
+/// Side Effects:
+///     - Creates/overwrites OUT.sdf and prints its size.
+///
+/// Approach:
+///     - Rasterize each character with FreeType at
+///       SDF_EM_SIZE * SDF_RENDER_SCALE pixels per em (no
+///       display or GL context needed, unlike sf::Font).
+///     - Exact Euclidean distance transform of the bitmap and
+///       of its complement (Felzenszwalb & Huttenlocher), on a
+///       grid covering the glyph plus the cell margin.
+///     - Average the signed distance over each
+///       SDF_RENDER_SCALE² block to get one atlas texel, and
+///       encode ±SDF_SPREAD pixels as 0..255.
+///     - Pack the cells in shelves, tallest first.
+///
+//////////////////////////////////////////////////////////////
+
+#include "SdfFont.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+    const int SCALE = SDF_RENDER_SCALE;
+    const int SPREAD = SDF_SPREAD;
+    const float FAR = 1e20f;
+
+    struct Cell {
+        SdfGlyph glyph;
+        std::vector<std::uint8_t> distances;    // width × height
+    };
+
+    int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    int ceilDiv(int value, int divisor) {
+        return -floorDiv(-value, divisor);
+    }
+
+    /*
+        1D squared distance transform of the sampled function f
+        (0 at feature pixels, FAR elsewhere): lower envelope of the
+        parabolas rooted at each pixel.
+    */
+    void distance1d(const float* f, int n, float* d, int* v, float* z) {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -FAR;
+        z[1] = FAR;
+        for (int q = 1; q < n; ++q) {
+            // f values are at most FAR, so s never drops below z[0]
+            float s;
+            for (;;) {
+                int p = v[k];
+                s = ((f[q] + float(q) * q) - (f[p] + float(p) * p)) / (2.f * (q - p));
+                if (s > z[k])
+                    break;
+                --k;
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = FAR;
+        }
+
+        k = 0;
+        for (int q = 0; q < n; ++q) {
+            while (z[k + 1] < q)
+                ++k;
+            float offset = float(q - v[k]);
+            d[q] = offset * offset + f[v[k]];
+        }
+    }
+
+    /*
+        Squared distance from every pixel to the nearest pixel whose
+        'feature' flag is set (columns, then rows).
+    */
+    std::vector<float> distance2d(const std::vector<bool>& feature, int width, int height) {
+        std::vector<float> grid(feature.size());
+        for (std::size_t i = 0; i < feature.size(); ++i)
+            grid[i] = feature[i] ? 0.f : FAR;
+
+        int n = std::max(width, height);
+        std::vector<float> f(n), d(n), z(n + 1);
+        std::vector<int> v(n);
+
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < height; ++y)
+                f[y] = grid[std::size_t(y) * width + x];
+            distance1d(f.data(), height, d.data(), v.data(), z.data());
+            for (int y = 0; y < height; ++y)
+                grid[std::size_t(y) * width + x] = d[y];
+        }
+        for (int y = 0; y < height; ++y) {
+            float* row = &grid[std::size_t(y) * width];
+            std::copy(row, row + width, f.begin());
+            distance1d(f.data(), width, d.data(), v.data(), z.data());
+            std::copy(d.begin(), d.begin() + width, row);
+        }
+        return grid;
+    }
+
+    /*
+        One character → atlas cell. The grid spans the cell in
+        render pixels: the bitmap rounded out to whole texels plus
+        SPREAD texels of margin on every side.
+    */
+    bool buildCell(FT_Face face, char32_t character, Cell& cell) {
+        if (FT_Load_Char(face, character, FT_LOAD_RENDER) != 0)
+            return false;
+
+        const FT_GlyphSlot slot = face->glyph;
+        const FT_Bitmap& bitmap = slot->bitmap;
+        std::memset(&cell.glyph, 0, sizeof(cell.glyph));
+        cell.glyph.advance = float(slot->advance.x) / 64.f / SCALE;
+        cell.distances.clear();
+
+        int bitmapWidth = static_cast<int>(bitmap.width);
+        int bitmapHeight = static_cast<int>(bitmap.rows);
+        if (bitmapWidth == 0 || bitmapHeight == 0)
+            return true;
+
+        // Bitmap rectangle relative to the pen (render pixels, y down)
+        int bitmapLeft = slot->bitmap_left;
+        int bitmapTop = -slot->bitmap_top;
+
+        int left = floorDiv(bitmapLeft, SCALE) - SPREAD;
+        int top = floorDiv(bitmapTop, SCALE) - SPREAD;
+        int right = ceilDiv(bitmapLeft + bitmapWidth, SCALE) + SPREAD;
+        int bottom = ceilDiv(bitmapTop + bitmapHeight, SCALE) + SPREAD;
+
+        int gridWidth = (right - left) * SCALE;
+        int gridHeight = (bottom - top) * SCALE;
+        int offsetX = bitmapLeft - left * SCALE;
+        int offsetY = bitmapTop - top * SCALE;
+
+        std::vector<bool> inside(std::size_t(gridWidth) * gridHeight, false);
+        for (int y = 0; y < bitmapHeight; ++y) {
+            const unsigned char* row = bitmap.buffer + y * bitmap.pitch;
+            for (int x = 0; x < bitmapWidth; ++x)
+                inside[std::size_t(y + offsetY) * gridWidth + x + offsetX] = row[x] >= 128;
+        }
+
+        std::vector<bool> outside(inside.size());
+        for (std::size_t i = 0; i < inside.size(); ++i)
+            outside[i] = !inside[i];
+
+        std::vector<float> toInside = distance2d(inside, gridWidth, gridHeight);
+        std::vector<float> toOutside = distance2d(outside, gridWidth, gridHeight);
+
+        cell.glyph.left = static_cast<std::int16_t>(left);
+        cell.glyph.top = static_cast<std::int16_t>(top);
+        cell.glyph.width = static_cast<std::uint16_t>(right - left);
+        cell.glyph.height = static_cast<std::uint16_t>(bottom - top);
+        cell.distances.resize(std::size_t(cell.glyph.width) * cell.glyph.height);
+
+        // Signed distance in render pixels: + inside, - outside, 0 on
+        // the boundary between the two pixel sets
+        for (int ty = 0; ty < cell.glyph.height; ++ty) {
+            for (int tx = 0; tx < cell.glyph.width; ++tx) {
+                float sum = 0.f;
+                for (int y = ty * SCALE; y < (ty + 1) * SCALE; ++y) {
+                    for (int x = tx * SCALE; x < (tx + 1) * SCALE; ++x) {
+                        std::size_t i = std::size_t(y) * gridWidth + x;
+                        sum += inside[i] ? std::sqrt(toOutside[i]) - 0.5f
+                                         : 0.5f - std::sqrt(toInside[i]);
+                    }
+                }
+
+                float texels = sum / (SCALE * SCALE) / SCALE;
+                float value = 128.f + texels * 127.f / SPREAD;
+                value = std::min(std::max(value, 0.f), 255.f);
+                cell.distances[std::size_t(ty) * cell.glyph.width + tx] =
+                    static_cast<std::uint8_t>(std::lround(value));
+            }
+        }
+        return true;
+    }
+
+    /*
+        Shelf packing, tallest cells first, one texel apart. Returns
+        the atlas height.
+    */
+    unsigned pack(std::vector<Cell>& cells) {
+        std::vector<std::size_t> order(cells.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return cells[a].glyph.height > cells[b].glyph.height;
+        });
+
+        unsigned x = 0, y = 0, shelf = 0;
+        for (std::size_t i : order) {
+            SdfGlyph& glyph = cells[i].glyph;
+            if (glyph.width == 0)
+                continue;
+            if (x + glyph.width > SDF_ATLAS_WIDTH) {
+                x = 0;
+                y += shelf + 1;
+                shelf = 0;
+            }
+            glyph.x = static_cast<std::uint16_t>(x);
+            glyph.y = static_cast<std::uint16_t>(y);
+            x += glyph.width + 1u;
+            shelf = std::max<unsigned>(shelf, glyph.height);
+        }
+        return y + shelf;
+    }
+
+    template <typename T>
+    bool writeValue(std::FILE* file, const T& value) {
+        return std::fwrite(&value, sizeof value, 1, file) == 1;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::printf("Usage: font-atlas FONT.ttf OUT.sdf\n");
+        return 1;
+    }
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library) != 0)
+        return 1;
+    if (FT_New_Face(library, argv[1], 0, &face) != 0 ||
+        FT_Set_Pixel_Sizes(face, 0, SDF_EM_SIZE * SCALE) != 0) {
+        std::printf("Failed to load %s\n", argv[1]);
+        FT_Done_FreeType(library);
+        return 1;
+    }
+
+    std::vector<Cell> cells(SDF_LAST_CHAR - SDF_FIRST_CHAR + 1);
+    bool ok = true;
+    for (char32_t c = SDF_FIRST_CHAR; ok && c <= SDF_LAST_CHAR; ++c)
+        ok = buildCell(face, c, cells[c - SDF_FIRST_CHAR]);
+
+    float lineSpacing = float(face->size->metrics.height) / 64.f / SCALE;
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    if (!ok) {
+        std::printf("Failed to rasterize %s\n", argv[1]);
+        return 1;
+    }
+
+    unsigned height = pack(cells);
+    std::vector<std::uint8_t> atlas(std::size_t(SDF_ATLAS_WIDTH) * height, 0);
+    for (const Cell& cell : cells) {
+        const SdfGlyph& glyph = cell.glyph;
+        for (unsigned y = 0; y < glyph.height; ++y)
+            std::memcpy(&atlas[std::size_t(glyph.y + y) * SDF_ATLAS_WIDTH + glyph.x],
+                        &cell.distances[std::size_t(y) * glyph.width], glyph.width);
+    }
+
+    std::FILE* file = std::fopen(argv[2], "wb");
+    if (!file) {
+        std::printf("Failed to write %s\n", argv[2]);
+        return 1;
+    }
+
+    ok = std::fwrite(SDF_FILE_MAGIC, 1, 4, file) == 4 &&
+         writeValue(file, std::uint32_t(SDF_EM_SIZE)) &&
+         writeValue(file, std::uint32_t(SDF_SPREAD)) &&
+         writeValue(file, std::uint32_t(SDF_ATLAS_WIDTH)) &&
+         writeValue(file, std::uint32_t(height)) &&
+         writeValue(file, std::uint32_t(cells.size())) &&
+         writeValue(file, lineSpacing);
+    for (std::size_t i = 0; ok && i < cells.size(); ++i)
+        ok = writeValue(file, cells[i].glyph);
+    ok = ok && std::fwrite(atlas.data(), 1, atlas.size(), file) == atlas.size();
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok) {
+        std::printf("Failed to write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("%s: %zu glyphs, %ux%u atlas (%zu KB as RGBA)\n",
+                argv[2], cells.size(), SDF_ATLAS_WIDTH, height,
+                atlas.size() * 4 / 1024);
+    return 0;
+}